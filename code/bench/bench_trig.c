@@ -0,0 +1,723 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/trig.h"
+#include <float.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Accuracy and throughput sweep of every trig.h function against a long
+// double reference, with libm measured the same way as a baseline. Each
+// (function, implementation, tier, input set, path) gives one record of
+// max/mean ULP, max absolute and relative error and ns per element, written
+// as JSON lines or CSV. The exit status is 1 when a documented error bound
+// from trig.h is exceeded.
+
+#define BENCH_PI_L 3.141592653589793238462643383279502884L
+
+// ======================================================
+// Error bounds
+// ======================================================
+
+typedef enum {
+    BOUND_NONE = 0,
+    BOUND_ULP,
+    BOUND_ABS,
+    BOUND_REL
+} bench_bound_kind;
+
+typedef struct {
+    bench_bound_kind kind;
+    double limit;
+} bench_bound;
+
+#define NO_BOUND    {BOUND_NONE, 0.0}
+#define ULP(v)      {BOUND_ULP, v}
+#define ABS(v)      {BOUND_ABS, v}
+#define REL(v)      {BOUND_REL, v}
+
+// Bounds per tier: precise, balanced, fast.
+#define TIER_BOUNDS(p, b, f) {p, b, f}
+
+// ======================================================
+// Input sets
+// ======================================================
+
+typedef struct {
+    const char* name;
+    double lo;
+    double hi;
+    int log_scale;      // |x| log-uniform in [lo, hi] with random sign
+} bench_domain;
+
+static const double bench_specials[] = {
+    0.0, -0.0, 4.9406564584124654e-324, -4.9406564584124654e-324, 2.2250738585072014e-308,
+    1e-300, 7.450580596923828125e-09, -7.450580596923828125e-09, 0.4375, 0.5, -0.5, 0.6744,
+    0.975, 1.0, -1.0, 1.5, 2.4375, 0.78539816339744831, 1.5707963267948966, -1.5707963267948966,
+    3.1415926535897931, 6.2831853071795862, 30.0, 45.0, 60.0, 90.0, -90.0, 180.0, 270.0, 360.0,
+    -720.0, 22.0, 710.0, -710.0, 823549.0, 823550.0, 1e22, -1e22, 1e300, 1.7976931348623157e308,
+    INFINITY, -INFINITY, NAN,
+};
+
+#define BENCH_SPECIALS (sizeof(bench_specials) / sizeof(bench_specials[0]))
+
+// xorshift64, so every run and platform sees the same inputs.
+static uint64_t bench_rng = 88172645463325252ULL;
+
+static double bench_uniform(void) {
+    bench_rng ^= bench_rng << 13;
+    bench_rng ^= bench_rng >> 7;
+    bench_rng ^= bench_rng << 17;
+    return (double)(bench_rng >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double bench_sample(const bench_domain* d) {
+    double u = bench_uniform();
+    if (!d->log_scale) return d->lo + u * (d->hi - d->lo);
+    double x = exp(log(d->lo) + u * (log(d->hi) - log(d->lo)));
+    return (bench_uniform() < 0.5) ? -x : x;
+}
+
+// ======================================================
+// Functions under test
+// ======================================================
+//
+// Every function is wrapped to the same two-argument shape so scalar loops
+// for the library and for libm pay the same indirect call.
+
+typedef double (*bench_scalar_fn)(double a, double b, fossil_math_trig_accuracy accuracy);
+typedef void (*bench_array_fn)(const double* a, const double* b, double* out, size_t n,
+                               fossil_math_trig_accuracy accuracy);
+typedef long double (*bench_ref_fn)(long double a, long double b);
+typedef double (*bench_libm_fn)(double a, double b, fossil_math_trig_accuracy accuracy);
+
+// Second output of sincos / tanh_deriv, discarded.
+static double* bench_scratch;
+
+#define WRAP_TIERED(f)                                                                        \
+    static double s_##f(double a, double b, fossil_math_trig_accuracy t) {                    \
+        (void)b;                                                                              \
+        return fossil_math_trig_##f##_ex(a, t);                                               \
+    }                                                                                         \
+    static void v_##f(const double* a, const double* b, double* out, size_t n,                \
+                      fossil_math_trig_accuracy t) {                                          \
+        (void)b;                                                                              \
+        fossil_math_trig_##f##_array_ex(a, out, n, t);                                        \
+    }
+
+#define WRAP_SCALAR(f)                                                                        \
+    static double s_##f(double a, double b, fossil_math_trig_accuracy t) {                    \
+        (void)b;                                                                              \
+        (void)t;                                                                              \
+        return fossil_math_trig_##f(a);                                                       \
+    }
+
+#define WRAP_ARRAY_EX(f)                                                                      \
+    static void v_##f(const double* a, const double* b, double* out, size_t n,                \
+                      fossil_math_trig_accuracy t) {                                          \
+        (void)b;                                                                              \
+        fossil_math_trig_##f##_array_ex(a, out, n, t);                                        \
+    }
+
+#define WRAP_LIBM(f)                                                                          \
+    static double m_##f(double a, double b, fossil_math_trig_accuracy t) {                    \
+        (void)b;                                                                              \
+        (void)t;                                                                              \
+        return f(a);                                                                          \
+    }
+
+#define WRAP_REF(f)                                                                           \
+    static long double r_##f(long double a, long double b) {                                  \
+        (void)b;                                                                              \
+        return f##l(a);                                                                       \
+    }
+
+WRAP_TIERED(sin)
+WRAP_TIERED(cos)
+WRAP_TIERED(tan)
+WRAP_TIERED(asin)
+WRAP_TIERED(acos)
+WRAP_TIERED(atan)
+WRAP_SCALAR(sinh)
+WRAP_SCALAR(cosh)
+WRAP_SCALAR(tanh)
+WRAP_SCALAR(asinh)
+WRAP_SCALAR(acosh)
+WRAP_SCALAR(atanh)
+WRAP_SCALAR(sind)
+WRAP_SCALAR(cosd)
+WRAP_SCALAR(tand)
+WRAP_SCALAR(deg_to_rad)
+WRAP_SCALAR(rad_to_deg)
+WRAP_ARRAY_EX(sinh)
+WRAP_ARRAY_EX(cosh)
+WRAP_ARRAY_EX(tanh)
+WRAP_ARRAY_EX(asinh)
+WRAP_ARRAY_EX(acosh)
+WRAP_ARRAY_EX(atanh)
+
+WRAP_LIBM(sin)
+WRAP_LIBM(cos)
+WRAP_LIBM(tan)
+WRAP_LIBM(asin)
+WRAP_LIBM(acos)
+WRAP_LIBM(atan)
+WRAP_LIBM(sinh)
+WRAP_LIBM(cosh)
+WRAP_LIBM(tanh)
+WRAP_LIBM(asinh)
+WRAP_LIBM(acosh)
+WRAP_LIBM(atanh)
+
+WRAP_REF(sin)
+WRAP_REF(cos)
+WRAP_REF(tan)
+WRAP_REF(asin)
+WRAP_REF(acos)
+WRAP_REF(atan)
+WRAP_REF(sinh)
+WRAP_REF(cosh)
+WRAP_REF(tanh)
+WRAP_REF(asinh)
+WRAP_REF(acosh)
+WRAP_REF(atanh)
+
+static double s_sincos_sin(double a, double b, fossil_math_trig_accuracy t) {
+    double s, c;
+    (void)b;
+    fossil_math_trig_sincos_ex(a, &s, &c, t);
+    return s;
+}
+
+static double s_sincos_cos(double a, double b, fossil_math_trig_accuracy t) {
+    double s, c;
+    (void)b;
+    fossil_math_trig_sincos_ex(a, &s, &c, t);
+    return c;
+}
+
+static void v_sincos_sin(const double* a, const double* b, double* out, size_t n, fossil_math_trig_accuracy t) {
+    (void)b;
+    fossil_math_trig_sincos_array_ex(a, out, bench_scratch, n, t);
+}
+
+static void v_sincos_cos(const double* a, const double* b, double* out, size_t n, fossil_math_trig_accuracy t) {
+    (void)b;
+    fossil_math_trig_sincos_array_ex(a, bench_scratch, out, n, t);
+}
+
+static double s_sincosd_sin(double a, double b, fossil_math_trig_accuracy t) {
+    double s, c;
+    (void)b;
+    (void)t;
+    fossil_math_trig_sincosd(a, &s, &c);
+    return s;
+}
+
+static double s_sincosd_cos(double a, double b, fossil_math_trig_accuracy t) {
+    double s, c;
+    (void)b;
+    (void)t;
+    fossil_math_trig_sincosd(a, &s, &c);
+    return c;
+}
+
+static double s_atan2(double a, double b, fossil_math_trig_accuracy t) {
+    (void)t;
+    return fossil_math_trig_atan2(a, b);
+}
+
+static void v_atan2(const double* a, const double* b, double* out, size_t n, fossil_math_trig_accuracy t) {
+    fossil_math_trig_atan2_array_ex(a, b, out, n, t);
+}
+
+static double m_atan2(double a, double b, fossil_math_trig_accuracy t) {
+    (void)t;
+    return atan2(a, b);
+}
+
+static long double r_atan2(long double a, long double b) {
+    return atan2l(a, b);
+}
+
+static void v_tanh_deriv_y(const double* a, const double* b, double* out, size_t n, fossil_math_trig_accuracy t) {
+    (void)b;
+    fossil_math_trig_tanh_deriv_array_ex(a, out, bench_scratch, n, t);
+}
+
+static void v_tanh_deriv_dy(const double* a, const double* b, double* out, size_t n, fossil_math_trig_accuracy t) {
+    (void)b;
+    fossil_math_trig_tanh_deriv_array_ex(a, bench_scratch, out, n, t);
+}
+
+// 1 - tanh^2 cancels for large x; sech^2 does not.
+static long double r_tanh_deriv(long double a, long double b) {
+    long double c = coshl(a);
+    (void)b;
+    return 1.0L / (c * c);
+}
+
+static void v_deg_to_rad(const double* a, const double* b, double* out, size_t n, fossil_math_trig_accuracy t) {
+    (void)b;
+    (void)t;
+    fossil_math_trig_deg_to_rad_array(a, out, n);
+}
+
+static void v_rad_to_deg(const double* a, const double* b, double* out, size_t n, fossil_math_trig_accuracy t) {
+    (void)b;
+    (void)t;
+    fossil_math_trig_rad_to_deg_array(a, out, n);
+}
+
+// Degrees are reduced exactly to [-45, 45] plus a quadrant before scaling,
+// so the reference keeps its precision for large arguments and multiples of
+// 90 give exact zeros with the signs trig.h documents.
+static long double bench_deg_quadrant(long double a, int shift) {
+    long double r = fmodl(a, 360.0L);
+    long double n = floorl(r / 90.0L + 0.5L);
+    long double d = (r - 90.0L * n) * (BENCH_PI_L / 180.0L);
+    switch (((int)n + shift) & 3) {
+    case 0:  return sinl(d);
+    case 1:  return cosl(d);
+    case 2:  return -sinl(d);
+    default: return -cosl(d);
+    }
+}
+
+static long double r_sind(long double a, long double b) {
+    long double s = bench_deg_quadrant(a, 0);
+    (void)b;
+    return (s == 0.0L) ? copysignl(0.0L, a) : s;
+}
+
+static long double r_cosd(long double a, long double b) {
+    long double c = bench_deg_quadrant(a, 1);
+    (void)b;
+    return (c == 0.0L) ? 0.0L : c;
+}
+
+static long double r_tand(long double a, long double b) {
+    return r_sind(a, b) / r_cosd(a, b);
+}
+
+static long double r_deg_to_rad(long double a, long double b) {
+    (void)b;
+    return a * (BENCH_PI_L / 180.0L);
+}
+
+static long double r_rad_to_deg(long double a, long double b) {
+    (void)b;
+    return a * (180.0L / BENCH_PI_L);
+}
+
+typedef struct {
+    const char* name;
+    int arity;
+    int scalar_tiered;          // 0: the scalar form ignores the tier
+    int array_tiered;           // 0: the array form ignores the tier
+    bench_scalar_fn scalar;     // NULL when there is no scalar form
+    bench_array_fn array;       // NULL when there is no array form
+    bench_libm_fn libm;         // NULL when libm has no counterpart
+    bench_ref_fn ref;
+    bench_bound scalar_bound[3];
+    bench_bound array_bound[3];
+    bench_domain domain[2];
+} bench_function;
+
+#define DOMAIN_TRIG     {{"dense[-10,10]", -10.0, 10.0, 0}, {"log[1e-300,8e5]", 1e-300, 8e5, 1}}
+#define DOMAIN_UNIT     {{"dense[-1,1]", -1.0, 1.0, 0}, {"log[1e-300,1]", 1e-300, 1.0, 1}}
+#define DOMAIN_LINE     {{"dense[-10,10]", -10.0, 10.0, 0}, {"log[1e-300,1e300]", 1e-300, 1e300, 1}}
+#define DOMAIN_HYP      {{"dense[-20,20]", -20.0, 20.0, 0}, {"log[1e-300,710]", 1e-300, 710.0, 1}}
+#define DOMAIN_ACOSH    {{"dense[1,20]", 1.0, 20.0, 0}, {"log[1,1e300]", 1.0, 1e300, 1}}
+#define DOMAIN_DEG      {{"dense[-720,720]", -720.0, 720.0, 0}, {"log[1e-300,1e15]", 1e-300, 1e15, 1}}
+
+#define SCALAR_PRECISE_BOUNDS TIER_BOUNDS(ULP(1.0), ULP(4.0), ABS(1e-7))
+#define HYP_ARRAY_BOUNDS      TIER_BOUNDS(ULP(3.0), ULP(3.0), REL(1e-7))
+#define INV_HYP_ARRAY_BOUNDS  TIER_BOUNDS(ULP(3.0), ULP(3.0), ULP(3.0))
+#define UNBOUNDED             TIER_BOUNDS(NO_BOUND, NO_BOUND, NO_BOUND)
+#define ONE_ULP               TIER_BOUNDS(ULP(1.0), ULP(1.0), ULP(1.0))
+
+static const bench_function bench_functions[] = {
+    {"sin", 1, 1, 1, s_sin, v_sin, m_sin, r_sin, SCALAR_PRECISE_BOUNDS, SCALAR_PRECISE_BOUNDS, DOMAIN_TRIG},
+    {"cos", 1, 1, 1, s_cos, v_cos, m_cos, r_cos, SCALAR_PRECISE_BOUNDS, SCALAR_PRECISE_BOUNDS, DOMAIN_TRIG},
+    {"tan", 1, 1, 1, s_tan, v_tan, m_tan, r_tan, TIER_BOUNDS(ULP(1.0), ULP(4.0), REL(1e-7)),
+     TIER_BOUNDS(ULP(1.0), ULP(4.0), REL(1e-7)), DOMAIN_TRIG},
+    {"sincos.sin", 1, 1, 1, s_sincos_sin, v_sincos_sin, m_sin, r_sin, SCALAR_PRECISE_BOUNDS, SCALAR_PRECISE_BOUNDS,
+     DOMAIN_TRIG},
+    {"sincos.cos", 1, 1, 1, s_sincos_cos, v_sincos_cos, m_cos, r_cos, SCALAR_PRECISE_BOUNDS, SCALAR_PRECISE_BOUNDS,
+     DOMAIN_TRIG},
+    {"asin", 1, 1, 1, s_asin, v_asin, m_asin, r_asin, SCALAR_PRECISE_BOUNDS, SCALAR_PRECISE_BOUNDS, DOMAIN_UNIT},
+    {"acos", 1, 1, 1, s_acos, v_acos, m_acos, r_acos, SCALAR_PRECISE_BOUNDS, SCALAR_PRECISE_BOUNDS, DOMAIN_UNIT},
+    {"atan", 1, 1, 1, s_atan, v_atan, m_atan, r_atan, SCALAR_PRECISE_BOUNDS, SCALAR_PRECISE_BOUNDS, DOMAIN_LINE},
+    {"atan2", 2, 0, 1, s_atan2, v_atan2, m_atan2, r_atan2, UNBOUNDED, TIER_BOUNDS(ULP(2.0), ULP(2.0), ABS(1e-7)),
+     DOMAIN_LINE},
+    {"sind", 1, 0, 0, s_sind, NULL, NULL, r_sind, ONE_ULP, UNBOUNDED, DOMAIN_DEG},
+    {"cosd", 1, 0, 0, s_cosd, NULL, NULL, r_cosd, ONE_ULP, UNBOUNDED, DOMAIN_DEG},
+    {"tand", 1, 0, 0, s_tand, NULL, NULL, r_tand, ONE_ULP, UNBOUNDED, DOMAIN_DEG},
+    {"sincosd.sin", 1, 0, 0, s_sincosd_sin, NULL, NULL, r_sind, ONE_ULP, UNBOUNDED, DOMAIN_DEG},
+    {"sincosd.cos", 1, 0, 0, s_sincosd_cos, NULL, NULL, r_cosd, ONE_ULP, UNBOUNDED, DOMAIN_DEG},
+    {"sinh", 1, 0, 1, s_sinh, v_sinh, m_sinh, r_sinh, UNBOUNDED, HYP_ARRAY_BOUNDS, DOMAIN_HYP},
+    {"cosh", 1, 0, 1, s_cosh, v_cosh, m_cosh, r_cosh, UNBOUNDED, HYP_ARRAY_BOUNDS, DOMAIN_HYP},
+    {"tanh", 1, 0, 1, s_tanh, v_tanh, m_tanh, r_tanh, UNBOUNDED, HYP_ARRAY_BOUNDS, DOMAIN_HYP},
+    {"tanh_deriv.y", 1, 0, 1, NULL, v_tanh_deriv_y, NULL, r_tanh, UNBOUNDED, HYP_ARRAY_BOUNDS, DOMAIN_HYP},
+    {"tanh_deriv.dy", 1, 0, 1, NULL, v_tanh_deriv_dy, NULL, r_tanh_deriv, UNBOUNDED, HYP_ARRAY_BOUNDS, DOMAIN_HYP},
+    {"asinh", 1, 0, 1, s_asinh, v_asinh, m_asinh, r_asinh, UNBOUNDED, INV_HYP_ARRAY_BOUNDS, DOMAIN_LINE},
+    {"acosh", 1, 0, 1, s_acosh, v_acosh, m_acosh, r_acosh, UNBOUNDED, INV_HYP_ARRAY_BOUNDS, DOMAIN_ACOSH},
+    {"atanh", 1, 0, 1, s_atanh, v_atanh, m_atanh, r_atanh, UNBOUNDED, INV_HYP_ARRAY_BOUNDS, DOMAIN_UNIT},
+    {"deg_to_rad", 1, 0, 0, s_deg_to_rad, v_deg_to_rad, NULL, r_deg_to_rad, UNBOUNDED, UNBOUNDED, DOMAIN_LINE},
+    {"rad_to_deg", 1, 0, 0, s_rad_to_deg, v_rad_to_deg, NULL, r_rad_to_deg, UNBOUNDED, UNBOUNDED, DOMAIN_LINE},
+};
+
+#define BENCH_FUNCTIONS (sizeof(bench_functions) / sizeof(bench_functions[0]))
+
+// ======================================================
+// Measurement
+// ======================================================
+
+typedef struct {
+    size_t samples;
+    double min_time;
+    const char* filter;
+    int csv;
+} bench_options;
+
+typedef struct {
+    double max_ulp;
+    double sum_ulp;
+    double max_abs;
+    double max_rel;
+    double worst_a;
+    double worst_b;
+    size_t special_mismatch;
+    size_t count;
+} bench_error;
+
+// Error of got in units of the last place of the correctly rounded result.
+static double bench_ulp(double got, long double ref) {
+    double r = (double)ref;
+    if (isnan(r) || isnan(got)) return (isnan(r) && isnan(got)) ? 0.0 : INFINITY;
+    if (isinf(r) || isinf(got)) return (got == r) ? 0.0 : INFINITY;
+    if ((long double)got == ref) return 0.0;
+    int e;
+    frexpl(ref, &e);
+    long double ulp = ldexpl(1.0L, (e - 53 < -1074) ? -1074 : e - 53);
+    return (double)(fabsl((long double)got - ref) / ulp);
+}
+
+// NaN, infinities and signed zeros must match the reference exactly.
+static int bench_class_mismatch(double got, long double ref) {
+    double r = (double)ref;
+    if (isnan(r) || isnan(got)) return isnan(r) != isnan(got);
+    if (isinf(r) || isinf(got)) return got != r;
+    if (r == 0.0 && got == 0.0) return signbit(r) != signbit(got);
+    return 0;
+}
+
+static void bench_account(bench_error* err, double got, long double ref, double a, double b) {
+    double u = bench_ulp(got, ref);
+    err->count++;
+    err->special_mismatch += (size_t)bench_class_mismatch(got, ref);
+    if (isnan(got) || isnan((double)ref) || isinf(got) || isinf((double)ref)) return;
+    long double d = fabsl((long double)got - ref);
+    // Relative to DBL_MIN at least, so results that underflow in double
+    // are not charged for the reference's extra exponent range.
+    double rel = (double)(d / fmaxl(fabsl(ref), DBL_MIN));
+    err->sum_ulp += u;
+    if (u > err->max_ulp) {
+        err->max_ulp = u;
+        err->worst_a = a;
+        err->worst_b = b;
+    }
+    if ((double)d > err->max_abs) err->max_abs = (double)d;
+    if (rel > err->max_rel) err->max_rel = rel;
+}
+
+static int bench_within(const bench_error* err, bench_bound bound) {
+    if (err->special_mismatch) return 0;
+    switch (bound.kind) {
+    case BOUND_ULP: return err->max_ulp < bound.limit;
+    case BOUND_ABS: return err->max_abs <= bound.limit;
+    case BOUND_REL: return err->max_rel <= bound.limit;
+    default:        return 1;
+    }
+}
+
+static double bench_now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static volatile double bench_sink;
+
+static double bench_time_scalar(bench_scalar_fn f, const double* a, const double* b, size_t n,
+                                fossil_math_trig_accuracy tier, double min_time) {
+    size_t reps = 0;
+    double acc = 0.0;
+    double start = bench_now(), elapsed;
+    do {
+        for (size_t i = 0; i < n; i++)
+            acc += f(a[i], b[i], tier);
+        reps++;
+        elapsed = bench_now() - start;
+    } while (elapsed < min_time);
+    bench_sink = acc;
+    return 1e9 * elapsed / ((double)reps * (double)n);
+}
+
+static double bench_time_array(bench_array_fn f, const double* a, const double* b, double* out, size_t n,
+                               fossil_math_trig_accuracy tier, double min_time) {
+    size_t reps = 0;
+    double start = bench_now(), elapsed;
+    do {
+        f(a, b, out, n, tier);
+        reps++;
+        elapsed = bench_now() - start;
+    } while (elapsed < min_time);
+    bench_sink = out[n / 2];
+    return 1e9 * elapsed / ((double)reps * (double)n);
+}
+
+// ======================================================
+// Output
+// ======================================================
+
+static const char* const bench_tier_names[] = {"precise", "balanced", "fast"};
+
+static const char* bench_bound_text(bench_bound bound, char* buf, size_t size) {
+    static const char* const kinds[] = {"none", "ulp", "abs", "rel"};
+    if (bound.kind == BOUND_NONE) return "none";
+    snprintf(buf, size, "%s<%s%g", kinds[bound.kind], bound.kind == BOUND_ULP ? "" : "=", bound.limit);
+    return buf;
+}
+
+// JSON has no inf or NaN.
+static void bench_json_number(double v) {
+    if (isfinite(v)) printf("%.17g", v);
+    else printf("null");
+}
+
+static void bench_emit(const bench_options* opt, const bench_function* fn, const char* impl, const char* tier,
+                       const char* domain, const char* path, const bench_error* err, double ns,
+                       bench_bound bound, int pass) {
+    char bound_buf[32];
+    const char* bound_text = bench_bound_text(bound, bound_buf, sizeof(bound_buf));
+    double mean = err->count ? err->sum_ulp / (double)err->count : 0.0;
+    if (opt->csv) {
+        printf("%s,%s,%s,%s,%s,%zu,%.4g,%.4g,%.4g,%.4g,%.17g,%.17g,%zu,%.3f,%s,%d\n", fn->name, impl, tier, domain,
+               path, err->count, err->max_ulp, mean, err->max_abs, err->max_rel, err->worst_a, err->worst_b,
+               err->special_mismatch, ns, bound_text, pass);
+        return;
+    }
+    printf("{\"func\":\"%s\",\"impl\":\"%s\",\"tier\":\"%s\",\"domain\":\"%s\",\"path\":\"%s\",\"n\":%zu,",
+           fn->name, impl, tier, domain, path, err->count);
+    printf("\"max_ulp\":");
+    bench_json_number(err->max_ulp);
+    printf(",\"mean_ulp\":");
+    bench_json_number(mean);
+    printf(",\"max_abs\":");
+    bench_json_number(err->max_abs);
+    printf(",\"max_rel\":");
+    bench_json_number(err->max_rel);
+    printf(",\"worst_a\":");
+    bench_json_number(err->worst_a);
+    printf(",\"worst_b\":");
+    bench_json_number(err->worst_b);
+    printf(",\"special_mismatch\":%zu,\"ns_per_elem\":", err->special_mismatch);
+    bench_json_number(ns);
+    printf(",\"bound\":\"%s\",\"pass\":%s}\n", bound_text, pass ? "true" : "false");
+}
+
+// ======================================================
+// Sweep
+// ======================================================
+
+typedef struct {
+    const char* name;
+    double* a;
+    double* b;
+    long double* ref;
+    size_t n;
+    int timed;          // special values are too few to time
+} bench_inputs;
+
+static void bench_fill(const bench_function* fn, const bench_domain* d, bench_inputs* in, size_t samples) {
+    for (size_t i = 0; i < samples; i++) {
+        in->a[i] = bench_sample(d);
+        in->b[i] = (fn->arity == 2) ? bench_sample(d) : 0.0;
+    }
+    in->name = d->name;
+    in->n = samples;
+    in->timed = 1;
+}
+
+static void bench_fill_specials(const bench_function* fn, bench_inputs* in) {
+    size_t n = 0;
+    if (fn->arity == 2) {
+        for (size_t i = 0; i < BENCH_SPECIALS; i++) {
+            for (size_t j = 0; j < BENCH_SPECIALS; j++) {
+                in->a[n] = bench_specials[i];
+                in->b[n++] = bench_specials[j];
+            }
+        }
+    } else {
+        for (size_t i = 0; i < BENCH_SPECIALS; i++) {
+            in->a[n] = bench_specials[i];
+            in->b[n++] = 0.0;
+        }
+    }
+    in->name = "special";
+    in->n = n;
+    in->timed = 0;
+}
+
+// Returns the number of records that exceeded their bound.
+static int bench_run_inputs(const bench_options* opt, const bench_function* fn, const bench_inputs* in,
+                            double* out) {
+    int failures = 0;
+    for (size_t i = 0; i < in->n; i++)
+        in->ref[i] = fn->ref(in->a[i], in->b[i]);
+
+    int tiers = (fn->scalar_tiered || fn->array_tiered) ? 3 : 1;
+    for (int t = 0; t < tiers; t++) {
+        fossil_math_trig_accuracy tier = (fossil_math_trig_accuracy)t;
+        if (fn->scalar && (t == 0 || fn->scalar_tiered)) {
+            bench_error err = {0};
+            for (size_t i = 0; i < in->n; i++)
+                bench_account(&err, fn->scalar(in->a[i], in->b[i], tier), in->ref[i], in->a[i], in->b[i]);
+            double ns = in->timed ? bench_time_scalar(fn->scalar, in->a, in->b, in->n, tier, opt->min_time) : NAN;
+            int pass = bench_within(&err, fn->scalar_bound[t]);
+            failures += !pass;
+            bench_emit(opt, fn, "fossil", fn->scalar_tiered ? bench_tier_names[t] : "none", in->name, "scalar", &err,
+                       ns, fn->scalar_bound[t], pass);
+        }
+        if (fn->array && (t == 0 || fn->array_tiered)) {
+            bench_error err = {0};
+            fn->array(in->a, in->b, out, in->n, tier);
+            for (size_t i = 0; i < in->n; i++)
+                bench_account(&err, out[i], in->ref[i], in->a[i], in->b[i]);
+            double ns = in->timed ? bench_time_array(fn->array, in->a, in->b, out, in->n, tier, opt->min_time) : NAN;
+            int pass = bench_within(&err, fn->array_bound[t]);
+            failures += !pass;
+            bench_emit(opt, fn, "fossil", fn->array_tiered ? bench_tier_names[t] : "none", in->name, "array", &err,
+                       ns, fn->array_bound[t], pass);
+        }
+    }
+
+    if (fn->libm) {
+        bench_error err = {0};
+        for (size_t i = 0; i < in->n; i++)
+            bench_account(&err, fn->libm(in->a[i], in->b[i], FOSSIL_MATH_TRIG_PRECISE), in->ref[i], in->a[i],
+                          in->b[i]);
+        double ns = in->timed ? bench_time_scalar(fn->libm, in->a, in->b, in->n, FOSSIL_MATH_TRIG_PRECISE,
+                                                  opt->min_time) : NAN;
+        bench_bound none = NO_BOUND;
+        bench_emit(opt, fn, "libm", "none", in->name, "scalar", &err, ns, none, 1);
+    }
+    return failures;
+}
+
+static void bench_usage(const char* prog) {
+    fprintf(stderr,
+            "usage: %s [--samples N] [--time SECONDS] [--threads N] [--filter NAME] [--csv] [--help]\n"
+            "  --samples N     inputs per dense set (default 131072)\n"
+            "  --time SECONDS  minimum timing per measurement (default 0.02)\n"
+            "  --threads N     fossil_math_set_threads() for the array paths (default 1)\n"
+            "  --filter NAME   only functions whose name contains NAME\n"
+            "  --csv           CSV instead of JSON lines\n",
+            prog);
+}
+
+int main(int argc, char** argv) {
+    bench_options opt = {131072, 0.02, NULL, 0};
+    size_t threads = 1;
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--samples") && i + 1 < argc) {
+            opt.samples = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--time") && i + 1 < argc) {
+            opt.min_time = strtod(argv[++i], NULL);
+        } else if (!strcmp(argv[i], "--threads") && i + 1 < argc) {
+            threads = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (!strcmp(argv[i], "--filter") && i + 1 < argc) {
+            opt.filter = argv[++i];
+        } else if (!strcmp(argv[i], "--csv")) {
+            opt.csv = 1;
+        } else if (!strcmp(argv[i], "--help")) {
+            bench_usage(argv[0]);
+            return 0;
+        } else {
+            bench_usage(argv[0]);
+            return 2;
+        }
+    }
+    if (opt.samples == 0 || fossil_math_set_threads(threads) != 0) {
+        bench_usage(argv[0]);
+        return 2;
+    }
+
+    size_t cap = opt.samples > BENCH_SPECIALS * BENCH_SPECIALS ? opt.samples : BENCH_SPECIALS * BENCH_SPECIALS;
+    bench_inputs in = {NULL, NULL, NULL, NULL, 0, 0};
+    in.a = (double*)malloc(cap * sizeof(double));
+    in.b = (double*)malloc(cap * sizeof(double));
+    in.ref = (long double*)malloc(cap * sizeof(long double));
+    double* out = (double*)malloc(cap * sizeof(double));
+    bench_scratch = (double*)malloc(cap * sizeof(double));
+    if (!in.a || !in.b || !in.ref || !out || !bench_scratch) {
+        fprintf(stderr, "out of memory\n");
+        return 2;
+    }
+
+    if (opt.csv) {
+        printf("func,impl,tier,domain,path,n,max_ulp,mean_ulp,max_abs,max_rel,worst_a,worst_b,special_mismatch,"
+               "ns_per_elem,bound,pass\n");
+    } else {
+        printf("{\"bench\":\"trig\",\"reference_bits\":%d,\"samples\":%zu,\"threads\":%zu,\"min_time\":%g}\n",
+               LDBL_MANT_DIG, opt.samples, fossil_math_get_threads(), opt.min_time);
+    }
+    if (LDBL_MANT_DIG <= DBL_MANT_DIG)
+        fprintf(stderr, "warning: long double is no wider than double; ULP figures are not meaningful\n");
+
+    int failures = 0;
+    for (size_t f = 0; f < BENCH_FUNCTIONS; f++) {
+        const bench_function* fn = &bench_functions[f];
+        if (opt.filter && !strstr(fn->name, opt.filter)) continue;
+        for (int d = 0; d < 2; d++) {
+            bench_fill(fn, &fn->domain[d], &in, opt.samples);
+            failures += bench_run_inputs(&opt, fn, &in, out);
+        }
+        bench_fill_specials(fn, &in);
+        failures += bench_run_inputs(&opt, fn, &in, out);
+    }
+
+    free(in.a);
+    free(in.b);
+    free(in.ref);
+    free(out);
+    free(bench_scratch);
+    if (failures) fprintf(stderr, "%d measurement(s) exceeded their documented bound\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,426 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/cheb.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Smallest number of nodes tried per piece.
+#define CHEB_MIN_NODES 16
+
+// Number of lanes evaluated together by the array kernel.
+#define CHEB_LANES 8
+
+// Blob layout: "FMCB", u32 version, u64 piece count, then per piece
+// f64 a, f64 b, u64 coefficient count and the coefficients.
+#define CHEB_MAGIC "FMCB"
+#define CHEB_VERSION 1u
+#define CHEB_HEADER_SIZE 16
+#define CHEB_PIECE_HEADER_SIZE 24
+
+struct fossil_math_cheb {
+    size_t pieces;
+    double* breaks;   // pieces + 1 breakpoints
+    size_t* offsets;  // pieces + 1 offsets into coeffs
+    double* coeffs;   // aligned pool; c[0] is stored already halved
+};
+
+// Growable list of fitted pieces used while fitting.
+typedef struct {
+    size_t count;
+    size_t cap;
+    double* a;
+    double* b;
+    size_t* n;
+    double** c;
+} cheb_builder;
+
+// ======================================================
+// Fitting
+// ======================================================
+
+static int _builder_push(cheb_builder* bld, double a, double b, double* c, size_t n) {
+    if (bld->count == bld->cap) {
+        size_t cap = bld->cap ? bld->cap * 2 : 8;
+        double* na = realloc(bld->a, cap * sizeof(double));
+        if (na) bld->a = na;
+        double* nb = realloc(bld->b, cap * sizeof(double));
+        if (nb) bld->b = nb;
+        size_t* nn = realloc(bld->n, cap * sizeof(size_t));
+        if (nn) bld->n = nn;
+        double** nc = realloc(bld->c, cap * sizeof(double*));
+        if (nc) bld->c = nc;
+        if (!na || !nb || !nn || !nc) return -1;
+        bld->cap = cap;
+    }
+    bld->a[bld->count] = a;
+    bld->b[bld->count] = b;
+    bld->n[bld->count] = n;
+    bld->c[bld->count] = c;
+    bld->count++;
+    return 0;
+}
+
+static void _builder_free(cheb_builder* bld) {
+    for (size_t i = 0; i < bld->count; i++)
+        free(bld->c[i]);
+    free(bld->a);
+    free(bld->b);
+    free(bld->n);
+    free(bld->c);
+}
+
+static double _clenshaw(const double* c, size_t n, double t) {
+    double b1 = 0.0, b2 = 0.0;
+    double t2 = 2.0 * t;
+    for (size_t j = n; j-- > 1;) {
+        double b0 = t2 * b1 - b2 + c[j];
+        b2 = b1;
+        b1 = b0;
+    }
+    return t * b1 - b2 + c[0];
+}
+
+// Fits one interval. Returns the coefficient count (c[0] halved) or 0 when
+// the tolerance is not met with at most max_degree + 1 nodes.
+static size_t _fit_piece(fossil_math_cheb_func f, void* ctx, double a, double b,
+                         double tol, size_t max_degree, double** out) {
+    double mid = 0.5 * (a + b);
+    double half = 0.5 * (b - a);
+    size_t max_nodes = max_degree + 1;
+    size_t nodes = (max_nodes < CHEB_MIN_NODES) ? max_nodes : CHEB_MIN_NODES;
+
+    for (;;) {
+        double* fx = malloc(nodes * sizeof(double));
+        double* c = malloc(nodes * sizeof(double));
+        if (!fx || !c) {
+            free(fx);
+            free(c);
+            return 0;
+        }
+        for (size_t k = 0; k < nodes; k++) {
+            double t = cos(FOSSIL_MATH_PI * ((double)k + 0.5) / (double)nodes);
+            fx[k] = f(mid + half * t, ctx);
+        }
+        for (size_t j = 0; j < nodes; j++) {
+            double sum = 0.0;
+            for (size_t k = 0; k < nodes; k++)
+                sum += fx[k] * cos(FOSSIL_MATH_PI * (double)j * ((double)k + 0.5) / (double)nodes);
+            c[j] = 2.0 * sum / (double)nodes;
+        }
+        c[0] *= 0.5;
+        free(fx);
+
+        // Drop trailing coefficients while their total stays under tol / 2.
+        size_t keep = nodes;
+        double dropped = 0.0;
+        while (keep > 1 && dropped + fabs(c[keep - 1]) <= 0.5 * tol) {
+            dropped += fabs(c[keep - 1]);
+            keep--;
+        }
+
+        // Converged when the tail was cut, then confirmed between the nodes.
+        int ok = keep + 2 <= nodes || nodes == 1;
+        for (size_t k = 0; ok && k < 2 * nodes; k++) {
+            double t = cos(FOSSIL_MATH_PI * (double)k / (double)(2 * nodes - 1));
+            double err = fabs(_clenshaw(c, keep, t) - f(mid + half * t, ctx));
+            if (!(err <= tol)) ok = 0;
+        }
+        if (ok) {
+            *out = c;
+            return keep;
+        }
+        free(c);
+
+        if (nodes >= max_nodes) return 0;
+        nodes = (nodes * 2 > max_nodes) ? max_nodes : nodes * 2;
+    }
+}
+
+static int _fit_range(cheb_builder* bld, fossil_math_cheb_func f, void* ctx,
+                      double a, double b, double tol, size_t max_degree, size_t depth) {
+    double* c = NULL;
+    size_t n = _fit_piece(f, ctx, a, b, tol, max_degree, &c);
+    if (n > 0) {
+        if (_builder_push(bld, a, b, c, n) != 0) {
+            free(c);
+            return -1;
+        }
+        return 0;
+    }
+    double mid = 0.5 * (a + b);
+    if (depth == 0 || !(mid > a && mid < b)) return -1;
+    if (_fit_range(bld, f, ctx, a, mid, tol, max_degree, depth - 1) != 0) return -1;
+    return _fit_range(bld, f, ctx, mid, b, tol, max_degree, depth - 1);
+}
+
+static fossil_math_cheb* _alloc_cheb(size_t pieces, size_t total) {
+    fossil_math_cheb* cheb = calloc(1, sizeof(*cheb));
+    if (!cheb) return NULL;
+    cheb->pieces = pieces;
+    cheb->breaks = malloc((pieces + 1) * sizeof(double));
+    cheb->offsets = malloc((pieces + 1) * sizeof(size_t));
+    cheb->coeffs = fossil_math_aligned_alloc(total * sizeof(double));
+    if (!cheb->breaks || !cheb->offsets || !cheb->coeffs) {
+        fossil_math_cheb_destroy(cheb);
+        return NULL;
+    }
+    return cheb;
+}
+
+fossil_math_cheb* fossil_math_cheb_fit(fossil_math_cheb_func f, void* ctx,
+                                       double a, double b, double tol,
+                                       size_t max_degree, size_t max_pieces) {
+    if (!f || !(a < b) || !(tol > 0.0) || max_pieces == 0) return NULL;
+
+    size_t depth = 0;
+    while (depth < 30 && ((size_t)2 << depth) <= max_pieces)
+        depth++;
+
+    cheb_builder bld;
+    memset(&bld, 0, sizeof(bld));
+    if (_fit_range(&bld, f, ctx, a, b, tol, max_degree, depth) != 0) {
+        _builder_free(&bld);
+        return NULL;
+    }
+
+    size_t total = 0;
+    for (size_t i = 0; i < bld.count; i++)
+        total += bld.n[i];
+
+    fossil_math_cheb* cheb = _alloc_cheb(bld.count, total);
+    if (cheb) {
+        size_t off = 0;
+        for (size_t i = 0; i < bld.count; i++) {
+            cheb->breaks[i] = bld.a[i];
+            cheb->offsets[i] = off;
+            memcpy(cheb->coeffs + off, bld.c[i], bld.n[i] * sizeof(double));
+            off += bld.n[i];
+        }
+        cheb->breaks[bld.count] = bld.b[bld.count - 1];
+        cheb->offsets[bld.count] = off;
+    }
+    _builder_free(&bld);
+    return cheb;
+}
+
+void fossil_math_cheb_destroy(fossil_math_cheb* cheb) {
+    if (!cheb) return;
+    free(cheb->breaks);
+    free(cheb->offsets);
+    fossil_math_aligned_free(cheb->coeffs);
+    free(cheb);
+}
+
+// ======================================================
+// Queries
+// ======================================================
+
+size_t fossil_math_cheb_pieces(const fossil_math_cheb* cheb) {
+    return cheb ? cheb->pieces : 0;
+}
+
+size_t fossil_math_cheb_degree(const fossil_math_cheb* cheb, size_t piece) {
+    if (!cheb || piece >= cheb->pieces) return 0;
+    return cheb->offsets[piece + 1] - cheb->offsets[piece] - 1;
+}
+
+void fossil_math_cheb_domain(const fossil_math_cheb* cheb, double* a, double* b) {
+    if (a) *a = cheb->breaks[0];
+    if (b) *b = cheb->breaks[cheb->pieces];
+}
+
+// ======================================================
+// Evaluation
+// ======================================================
+
+static size_t _find_piece(const fossil_math_cheb* cheb, double x) {
+    size_t lo = 0, hi = cheb->pieces;
+    while (hi - lo > 1) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (x >= cheb->breaks[mid]) lo = mid;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static double _eval_piece(const fossil_math_cheb* cheb, size_t p, double x) {
+    double a = cheb->breaks[p];
+    double b = cheb->breaks[p + 1];
+    double t = (x - 0.5 * (a + b)) * (2.0 / (b - a));
+    return _clenshaw(cheb->coeffs + cheb->offsets[p],
+                     cheb->offsets[p + 1] - cheb->offsets[p], t);
+}
+
+double fossil_math_cheb_eval(const fossil_math_cheb* cheb, double x) {
+    return _eval_piece(cheb, _find_piece(cheb, x), x);
+}
+
+void fossil_math_cheb_eval_array(const fossil_math_cheb* cheb, const double* x, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + CHEB_LANES <= n; i += CHEB_LANES) {
+        size_t p = _find_piece(cheb, x[i]);
+        double lo = cheb->breaks[p];
+        double hi = cheb->breaks[p + 1];
+        int same = 1;
+        for (size_t l = 1; l < CHEB_LANES; l++) {
+            size_t q = _find_piece(cheb, x[i + l]);
+            if (q != p) same = 0;
+        }
+        if (!same) {
+            for (size_t l = 0; l < CHEB_LANES; l++)
+                out[i + l] = fossil_math_cheb_eval(cheb, x[i + l]);
+            continue;
+        }
+
+        // All lanes share one piece: run Clenshaw across the lanes together.
+        const double* c = cheb->coeffs + cheb->offsets[p];
+        size_t m = cheb->offsets[p + 1] - cheb->offsets[p];
+        double mid = 0.5 * (lo + hi);
+        double scale = 2.0 / (hi - lo);
+        double t[CHEB_LANES], t2[CHEB_LANES], b1[CHEB_LANES], b2[CHEB_LANES];
+        for (size_t l = 0; l < CHEB_LANES; l++) {
+            t[l] = (x[i + l] - mid) * scale;
+            t2[l] = 2.0 * t[l];
+            b1[l] = 0.0;
+            b2[l] = 0.0;
+        }
+        for (size_t j = m; j-- > 1;) {
+            for (size_t l = 0; l < CHEB_LANES; l++) {
+                double b0 = t2[l] * b1[l] - b2[l] + c[j];
+                b2[l] = b1[l];
+                b1[l] = b0;
+            }
+        }
+        for (size_t l = 0; l < CHEB_LANES; l++)
+            out[i + l] = t[l] * b1[l] - b2[l] + c[0];
+    }
+    for (; i < n; i++)
+        out[i] = fossil_math_cheb_eval(cheb, x[i]);
+}
+
+// ======================================================
+// Serialization
+// ======================================================
+
+static void _put_u64(unsigned char* p, uint64_t v) {
+    for (int i = 0; i < 8; i++)
+        p[i] = (unsigned char)(v >> (8 * i));
+}
+
+static uint64_t _get_u64(const unsigned char* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++)
+        v |= (uint64_t)p[i] << (8 * i);
+    return v;
+}
+
+static void _put_f64(unsigned char* p, double d) {
+    uint64_t v;
+    memcpy(&v, &d, sizeof(v));
+    _put_u64(p, v);
+}
+
+static double _get_f64(const unsigned char* p) {
+    uint64_t v = _get_u64(p);
+    double d;
+    memcpy(&d, &v, sizeof(d));
+    return d;
+}
+
+size_t fossil_math_cheb_serialize(const fossil_math_cheb* cheb, void* buf, size_t cap) {
+    if (!cheb) return 0;
+    size_t need = CHEB_HEADER_SIZE + cheb->pieces * CHEB_PIECE_HEADER_SIZE
+                + cheb->offsets[cheb->pieces] * sizeof(double);
+    if (!buf || cap < need) return need;
+
+    unsigned char* p = buf;
+    memcpy(p, CHEB_MAGIC, 4);
+    for (int i = 0; i < 4; i++)
+        p[4 + i] = (unsigned char)(CHEB_VERSION >> (8 * i));
+    _put_u64(p + 8, (uint64_t)cheb->pieces);
+    p += CHEB_HEADER_SIZE;
+
+    for (size_t i = 0; i < cheb->pieces; i++) {
+        size_t count = cheb->offsets[i + 1] - cheb->offsets[i];
+        _put_f64(p, cheb->breaks[i]);
+        _put_f64(p + 8, cheb->breaks[i + 1]);
+        _put_u64(p + 16, (uint64_t)count);
+        p += CHEB_PIECE_HEADER_SIZE;
+        for (size_t j = 0; j < count; j++, p += 8)
+            _put_f64(p, cheb->coeffs[cheb->offsets[i] + j]);
+    }
+    return need;
+}
+
+fossil_math_cheb* fossil_math_cheb_deserialize(const void* buf, size_t size) {
+    const unsigned char* p = buf;
+    if (!p || size < CHEB_HEADER_SIZE || memcmp(p, CHEB_MAGIC, 4) != 0) return NULL;
+
+    uint32_t version = 0;
+    for (int i = 0; i < 4; i++)
+        version |= (uint32_t)p[4 + i] << (8 * i);
+    uint64_t pieces = _get_u64(p + 8);
+    if (version != CHEB_VERSION || pieces == 0
+        || pieces > (size - CHEB_HEADER_SIZE) / CHEB_PIECE_HEADER_SIZE)
+        return NULL;
+
+    // First pass validates the layout and sizes the coefficient pool.
+    size_t total = 0;
+    size_t pos = CHEB_HEADER_SIZE;
+    double prev_b = 0.0;
+    for (uint64_t i = 0; i < pieces; i++) {
+        if (size - pos < CHEB_PIECE_HEADER_SIZE) return NULL;
+        double a = _get_f64(p + pos);
+        double b = _get_f64(p + pos + 8);
+        uint64_t count = _get_u64(p + pos + 16);
+        pos += CHEB_PIECE_HEADER_SIZE;
+        if (!(a < b) || count == 0 || (i > 0 && a != prev_b)
+            || count > (size - pos) / sizeof(double))
+            return NULL;
+        pos += (size_t)count * sizeof(double);
+        total += (size_t)count;
+        prev_b = b;
+    }
+    if (pos != size) return NULL;
+
+    fossil_math_cheb* cheb = _alloc_cheb((size_t)pieces, total);
+    if (!cheb) return NULL;
+
+    pos = CHEB_HEADER_SIZE;
+    size_t off = 0;
+    for (size_t i = 0; i < cheb->pieces; i++) {
+        size_t count = (size_t)_get_u64(p + pos + 16);
+        cheb->breaks[i] = _get_f64(p + pos);
+        cheb->breaks[i + 1] = _get_f64(p + pos + 8);
+        cheb->offsets[i] = off;
+        pos += CHEB_PIECE_HEADER_SIZE;
+        for (size_t j = 0; j < count; j++, pos += 8)
+            cheb->coeffs[off + j] = _get_f64(p + pos);
+        off += count;
+    }
+    cheb->offsets[cheb->pieces] = off;
+    return cheb;
+}
@@ -0,0 +1,278 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_CHEB_H
+#define FOSSIL_MATH_CHEB_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ======================================================
+// Structures
+// ======================================================
+
+/**
+ * Function to approximate. Receives the abscissa and the user context.
+ */
+typedef double (*fossil_math_cheb_func)(double x, void* ctx);
+
+/**
+ * Opaque piecewise Chebyshev approximation.
+ *
+ * The domain is split into contiguous pieces, each holding its own
+ * truncated Chebyshev series.
+ */
+typedef struct fossil_math_cheb fossil_math_cheb;
+
+// *****************************************************************************
+// Function prototypes
+// *****************************************************************************
+
+/**
+ * @brief Fits a function on [a, b] to a (piecewise) Chebyshev series.
+ *
+ * Each piece is sampled at Chebyshev nodes with a doubling number of points
+ * until the coefficient tail drops below the tolerance, then truncated. A
+ * piece that does not converge within max_degree is bisected.
+ *
+ * @param f Function to approximate.
+ * @param ctx User context passed to f.
+ * @param a Lower bound of the domain.
+ * @param b Upper bound of the domain (must be greater than a).
+ * @param tol Target absolute error.
+ * @param max_degree Largest series degree allowed per piece.
+ * @param max_pieces Largest number of pieces (rounded down to a power of two).
+ * @return New approximation, or NULL if the tolerance could not be met or on
+ *         failure. Release with fossil_math_cheb_destroy().
+ */
+fossil_math_cheb* fossil_math_cheb_fit(fossil_math_cheb_func f, void* ctx,
+                                       double a, double b, double tol,
+                                       size_t max_degree, size_t max_pieces);
+
+/**
+ * @brief Destroys an approximation.
+ *
+ * @param cheb Approximation to destroy (NULL is ignored).
+ */
+void fossil_math_cheb_destroy(fossil_math_cheb* cheb);
+
+/**
+ * @brief Returns the number of pieces in an approximation.
+ *
+ * @param cheb Approximation.
+ * @return Number of pieces.
+ */
+size_t fossil_math_cheb_pieces(const fossil_math_cheb* cheb);
+
+/**
+ * @brief Returns the series degree of a piece.
+ *
+ * @param cheb Approximation.
+ * @param piece Piece index.
+ * @return Degree of the piece's series (0 for an invalid index).
+ */
+size_t fossil_math_cheb_degree(const fossil_math_cheb* cheb, size_t piece);
+
+/**
+ * @brief Returns the domain of an approximation.
+ *
+ * @param cheb Approximation.
+ * @param a Pointer to store the lower bound.
+ * @param b Pointer to store the upper bound.
+ */
+void fossil_math_cheb_domain(const fossil_math_cheb* cheb, double* a, double* b);
+
+/**
+ * @brief Evaluates the approximation at x with the Clenshaw recurrence.
+ *
+ * Values outside the domain are extrapolated from the first or last piece.
+ *
+ * @param cheb Approximation.
+ * @param x Value at which to evaluate.
+ * @return Approximated value.
+ */
+double fossil_math_cheb_eval(const fossil_math_cheb* cheb, double x);
+
+/**
+ * @brief Evaluates the approximation over an array.
+ *
+ * Runs of inputs falling in the same piece are evaluated several lanes at a
+ * time.
+ *
+ * @param cheb Approximation.
+ * @param x Pointer to the input values.
+ * @param out Pointer to the output values (may alias x).
+ * @param n Number of elements.
+ */
+void fossil_math_cheb_eval_array(const fossil_math_cheb* cheb, const double* x, double* out, size_t n);
+
+/**
+ * @brief Serializes an approximation into a portable little-endian blob.
+ *
+ * @param cheb Approximation.
+ * @param buf Destination buffer (may be NULL to query the size).
+ * @param cap Capacity of buf in bytes.
+ * @return Number of bytes the blob needs; nothing is written when cap is smaller.
+ */
+size_t fossil_math_cheb_serialize(const fossil_math_cheb* cheb, void* buf, size_t cap);
+
+/**
+ * @brief Rebuilds an approximation from a blob made by fossil_math_cheb_serialize().
+ *
+ * @param buf Pointer to the blob.
+ * @param size Size of the blob in bytes.
+ * @return New approximation, or NULL if the blob is malformed.
+ */
+fossil_math_cheb* fossil_math_cheb_deserialize(const void* buf, size_t size);
+
+#ifdef __cplusplus
+}
+#include <stdexcept>
+#include <vector>
+#include <string>
+#include <functional>
+
+namespace fossil {
+
+namespace math {
+
+    /**
+     * @class Chebyshev
+     * @brief RAII owner of a fossil_math_cheb approximation.
+     *
+     * The wrapper is move-only; the underlying object is destroyed with the wrapper.
+     */
+    class Chebyshev {
+    public:
+        /**
+         * Fits a callable on [a, b].
+         * @param f Function to approximate.
+         * @param a Lower bound of the domain.
+         * @param b Upper bound of the domain.
+         * @param tol Target absolute error.
+         * @param max_degree Largest series degree per piece.
+         * @param max_pieces Largest number of pieces.
+         * @return Fitted approximation.
+         * @throws std::runtime_error if the tolerance could not be met.
+         */
+        static Chebyshev fit(const std::function<double(double)>& f, double a, double b,
+                             double tol, size_t max_degree = 128, size_t max_pieces = 64) {
+            fossil_math_cheb* c = fossil_math_cheb_fit(&Chebyshev::trampoline,
+                                                       const_cast<std::function<double(double)>*>(&f),
+                                                       a, b, tol, max_degree, max_pieces);
+            if (!c)
+                throw std::runtime_error("Chebyshev fit did not reach the requested tolerance");
+            return Chebyshev(c);
+        }
+
+        /**
+         * Rebuilds an approximation from a serialized blob.
+         * @param blob Bytes produced by serialize().
+         * @return Loaded approximation.
+         * @throws std::invalid_argument if the blob is malformed.
+         */
+        static Chebyshev deserialize(const std::vector<unsigned char>& blob) {
+            fossil_math_cheb* c = fossil_math_cheb_deserialize(blob.data(), blob.size());
+            if (!c)
+                throw std::invalid_argument("Malformed Chebyshev blob");
+            return Chebyshev(c);
+        }
+
+        ~Chebyshev() { fossil_math_cheb_destroy(cheb_); }
+
+        Chebyshev(const Chebyshev&) = delete;
+        Chebyshev& operator=(const Chebyshev&) = delete;
+
+        Chebyshev(Chebyshev&& other) noexcept : cheb_(other.cheb_) { other.cheb_ = nullptr; }
+
+        Chebyshev& operator=(Chebyshev&& other) noexcept {
+            if (this != &other) {
+                fossil_math_cheb_destroy(cheb_);
+                cheb_ = other.cheb_;
+                other.cheb_ = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * Evaluates the approximation.
+         * @param x Value at which to evaluate.
+         * @return Approximated value.
+         */
+        double operator()(double x) const { return fossil_math_cheb_eval(cheb_, x); }
+
+        /**
+         * Evaluates the approximation over a vector of values.
+         * @param x Input values.
+         * @return Approximated values.
+         */
+        std::vector<double> eval(const std::vector<double>& x) const {
+            std::vector<double> out(x.size());
+            fossil_math_cheb_eval_array(cheb_, x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * Returns the number of pieces.
+         * @return Number of pieces.
+         */
+        size_t pieces() const { return fossil_math_cheb_pieces(cheb_); }
+
+        /**
+         * Serializes the approximation.
+         * @return Portable blob that deserialize() accepts.
+         */
+        std::vector<unsigned char> serialize() const {
+            std::vector<unsigned char> blob(fossil_math_cheb_serialize(cheb_, nullptr, 0));
+            fossil_math_cheb_serialize(cheb_, blob.data(), blob.size());
+            return blob;
+        }
+
+        /**
+         * Returns the underlying C handle.
+         * @return Approximation handle.
+         */
+        fossil_math_cheb* handle() const { return cheb_; }
+
+    private:
+        explicit Chebyshev(fossil_math_cheb* c) : cheb_(c) {}
+
+        static double trampoline(double x, void* ctx) {
+            return (*static_cast<std::function<double(double)>*>(ctx))(x);
+        }
+
+        fossil_math_cheb* cheb_ = nullptr;
+    };
+
+} // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_CHEB_H */
@@ -29,5 +29,9 @@
 #include "algebra.h"
 #include "geom.h"
 #include "trig.h"
+#include "poly.h"
+#include "cheb.h"
+#include "trig_lut.h"
+#include "spatial.h"
 
 #endif /* FOSSIL_MATH_FRAMEWORK_H */
@@ -56,6 +56,77 @@ typedef struct {
     double d; // plane equation: normal·p + d = 0
 } fossil_math_geom_plane;
 
+// Plane with a unit normal, from fossil_math_geom_plane_prepare(). The signed
+// distance of p is normal·p + d, positive on the side the normal points to.
+typedef struct {
+    fossil_math_geom_point3d normal;
+    double d;
+} fossil_math_geom_prepared_plane;
+
+// Axis-aligned boxes holding the points with lo <= p <= hi componentwise.
+// A box with lo > hi on some axis is empty.
+typedef struct {
+    fossil_math_geom_point2d lo;
+    fossil_math_geom_point2d hi;
+} fossil_math_geom_aabb2d;
+
+typedef struct {
+    fossil_math_geom_point3d lo;
+    fossil_math_geom_point3d hi;
+} fossil_math_geom_aabb3d;
+
+// Structure-of-arrays point clouds: one array per component, each aligned to
+// FOSSIL_MATH_ALIGNMENT. The arrays are owned by the cloud; fill them in place.
+typedef struct {
+    double* x;
+    double* y;
+    size_t size;
+} fossil_math_geom_cloud2d;
+
+typedef struct {
+    double* x;
+    double* y;
+    double* z;
+    size_t size;
+} fossil_math_geom_cloud3d;
+
+// Structure-of-arrays box sets, laid out like the clouds.
+typedef struct {
+    double* lo_x;
+    double* lo_y;
+    double* hi_x;
+    double* hi_y;
+    size_t size;
+} fossil_math_geom_boxes2d;
+
+typedef struct {
+    double* lo_x;
+    double* lo_y;
+    double* lo_z;
+    double* hi_x;
+    double* hi_y;
+    double* hi_z;
+    size_t size;
+} fossil_math_geom_boxes3d;
+
+// Affine transforms as row-major homogeneous matrices acting on column
+// vectors. The last row is always (0, ..., 0, 1) and is never read.
+typedef struct {
+    double m[3][3];
+} fossil_math_geom_affine2d;
+
+typedef struct {
+    double m[4][4];
+} fossil_math_geom_affine3d;
+
+// Quaternion w + xi + yj + zk; rotations use unit quaternions.
+typedef struct {
+    double w;
+    double x;
+    double y;
+    double z;
+} fossil_math_geom_quat;
+
 // *****************************************************************************
 // Function prototypes
 // *****************************************************************************
@@ -148,6 +219,228 @@ double fossil_math_geom_triangle_perimeter(fossil_math_geom_point2d a,
                                            fossil_math_geom_point2d b,
                                            fossil_math_geom_point2d c);
 
+/**
+ * @brief Computes the convex hull of a 2D point array.
+ *
+ * Points strictly inside the polygon of the extreme points are discarded
+ * first (Akl-Toussaint), then the rest go through Andrew's monotone chain.
+ * Both steps use fossil_math_geom_orient2d(), so nearly collinear points are
+ * classified exactly.
+ * Arrays of at least 65536 points are split across the
+ * fossil_math_set_threads() threads; the result does not depend on the
+ * thread count. Non-finite points are ignored.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @param hull Pointer to room for n indices; receives the hull vertices
+ *             counterclockwise, starting from the lowest-x (then lowest-y)
+ *             point. Collinear boundary points are left out, and repeated
+ *             points are reported by their lowest index.
+ * @return Number of hull vertices, or SIZE_MAX on allocation failure.
+ */
+size_t fossil_math_geom_convex_hull2d(const fossil_math_geom_point2d* points, size_t n, size_t* hull);
+
+/** 
+ * ======================================================
+ * Robust predicates
+ * ======================================================
+ *
+ * Adaptive-precision orientation and in-circle tests. The determinant is
+ * first evaluated in plain doubles with an error bound, which settles the
+ * sign in nearly every case; near-degenerate inputs escalate through
+ * progressively more precise stages up to exact expansion arithmetic. The
+ * returned value approximates the determinant, and its sign (or zero) is
+ * exact as long as no intermediate value overflows or underflows.
+ */
+
+/**
+ * @brief Orientation of three 2D points.
+ *
+ * @param a First point.
+ * @param b Second point.
+ * @param c Third point.
+ * @return Positive if a, b, c turn counterclockwise, negative if they turn
+ *         clockwise, zero if they are collinear. The magnitude approximates
+ *         twice the signed triangle area.
+ */
+double fossil_math_geom_orient2d(fossil_math_geom_point2d a, fossil_math_geom_point2d b,
+                                 fossil_math_geom_point2d c);
+
+/**
+ * @brief Orientation of a 3D point relative to the plane through three others.
+ *
+ * @param a First plane point.
+ * @param b Second plane point.
+ * @param c Third plane point.
+ * @param d Query point.
+ * @return Positive if d lies below the plane, where "below" is the side from
+ *         which a, b, c appear clockwise; negative above; zero if the four
+ *         points are coplanar. The magnitude approximates six times the
+ *         signed tetrahedron volume.
+ */
+double fossil_math_geom_orient3d(fossil_math_geom_point3d a, fossil_math_geom_point3d b,
+                                 fossil_math_geom_point3d c, fossil_math_geom_point3d d);
+
+/**
+ * @brief Tests a 2D point against the circle through three others.
+ *
+ * @param a First circle point.
+ * @param b Second circle point.
+ * @param c Third circle point; a, b, c must be counterclockwise
+ *          (the sign flips otherwise).
+ * @param d Query point.
+ * @return Positive if d lies inside the circle, negative outside, zero on it.
+ */
+double fossil_math_geom_incircle(fossil_math_geom_point2d a, fossil_math_geom_point2d b,
+                                 fossil_math_geom_point2d c, fossil_math_geom_point2d d);
+
+/**
+ * @brief Tests a 3D point against the sphere through four others.
+ *
+ * @param a First sphere point.
+ * @param b Second sphere point.
+ * @param c Third sphere point.
+ * @param d Fourth sphere point; fossil_math_geom_orient3d(a, b, c, d) must be
+ *          positive (the sign flips otherwise).
+ * @param e Query point.
+ * @return Positive if e lies inside the sphere, negative outside, zero on it.
+ */
+double fossil_math_geom_insphere(fossil_math_geom_point3d a, fossil_math_geom_point3d b,
+                                 fossil_math_geom_point3d c, fossil_math_geom_point3d d,
+                                 fossil_math_geom_point3d e);
+
+/**
+ * @brief Evaluates fossil_math_geom_orient2d(a, b, p) for every point p of a 2D cloud.
+ *
+ * The floating-point filter runs SIMD-wide; only points it cannot settle take
+ * the adaptive path. Clouds of at least 65536 points are split across the
+ * fossil_math_set_threads() threads.
+ *
+ * @param cloud The query points.
+ * @param a First point of the directed line.
+ * @param b Second point of the directed line.
+ * @param out Pointer to room for cloud->size results.
+ */
+void fossil_math_geom_cloud2d_orient2d(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d a,
+                                       fossil_math_geom_point2d b, double* out);
+
+/**
+ * @brief Evaluates fossil_math_geom_incircle(a, b, c, p) for every point p of a 2D cloud.
+ *
+ * Batched like fossil_math_geom_cloud2d_orient2d().
+ *
+ * @param cloud The query points.
+ * @param a First circle point.
+ * @param b Second circle point.
+ * @param c Third circle point.
+ * @param out Pointer to room for cloud->size results.
+ */
+void fossil_math_geom_cloud2d_incircle(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d a,
+                                       fossil_math_geom_point2d b, fossil_math_geom_point2d c, double* out);
+
+/**
+ * @brief Evaluates fossil_math_geom_orient3d(a, b, c, p) for every point p of a 3D cloud.
+ *
+ * Batched like fossil_math_geom_cloud2d_orient2d().
+ *
+ * @param cloud The query points.
+ * @param a First plane point.
+ * @param b Second plane point.
+ * @param c Third plane point.
+ * @param out Pointer to room for cloud->size results.
+ */
+void fossil_math_geom_cloud3d_orient3d(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d a,
+                                       fossil_math_geom_point3d b, fossil_math_geom_point3d c, double* out);
+
+/**
+ * @brief Evaluates fossil_math_geom_insphere(a, b, c, d, p) for every point p of a 3D cloud.
+ *
+ * Batched like fossil_math_geom_cloud2d_orient2d().
+ *
+ * @param cloud The query points.
+ * @param a First sphere point.
+ * @param b Second sphere point.
+ * @param c Third sphere point.
+ * @param d Fourth sphere point.
+ * @param out Pointer to room for cloud->size results.
+ */
+void fossil_math_geom_cloud3d_insphere(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d a,
+                                       fossil_math_geom_point3d b, fossil_math_geom_point3d c,
+                                       fossil_math_geom_point3d d, double* out);
+
+/** 
+ * ======================================================
+ * Mesh and polygon measures
+ * ======================================================
+ *
+ * These kernels read vertices through an optional index buffer. Sums are
+ * accumulated in fixed blocks and combined in block order, so large inputs
+ * are split across the fossil_math_set_threads() threads without the result
+ * depending on the thread count.
+ */
+
+/**
+ * @brief Computes the areas of a 2D triangle mesh.
+ *
+ * @param vertices Pointer to the vertices.
+ * @param vertex_count Number of vertices.
+ * @param indices Pointer to 3 * triangle_count vertex indices, or NULL to
+ *                read triangle i from vertices 3i, 3i + 1 and 3i + 2.
+ * @param triangle_count Number of triangles.
+ * @param areas Pointer to room for triangle_count areas, or NULL.
+ * @param total Pointer that receives the summed area, or NULL.
+ * @return 0 on success, -1 on an out-of-range vertex index (areas may then
+ *         be partially written).
+ */
+int fossil_math_geom_mesh_area2d(const fossil_math_geom_point2d* vertices, size_t vertex_count,
+                                 const size_t* indices, size_t triangle_count, double* areas, double* total);
+
+/**
+ * @brief Computes the areas of a 3D triangle mesh.
+ *
+ * @param vertices Pointer to the vertices.
+ * @param vertex_count Number of vertices.
+ * @param indices Pointer to 3 * triangle_count vertex indices, or NULL to
+ *                read triangle i from vertices 3i, 3i + 1 and 3i + 2.
+ * @param triangle_count Number of triangles.
+ * @param areas Pointer to room for triangle_count areas, or NULL.
+ * @param total Pointer that receives the surface area, or NULL.
+ * @return 0 on success, -1 on an out-of-range vertex index (areas may then
+ *         be partially written).
+ */
+int fossil_math_geom_mesh_area3d(const fossil_math_geom_point3d* vertices, size_t vertex_count,
+                                 const size_t* indices, size_t triangle_count, double* areas, double* total);
+
+/**
+ * @brief Computes the signed area of a simple polygon (shoelace formula).
+ *
+ * @param vertices Pointer to the vertices.
+ * @param vertex_count Number of vertices.
+ * @param indices Pointer to n vertex indices in boundary order, or NULL to
+ *                use vertices 0 to n - 1.
+ * @param n Number of polygon vertices.
+ * @param area Pointer that receives the area: positive for a
+ *             counterclockwise boundary, negative for a clockwise one.
+ * @return 0 on success, -1 on an out-of-range vertex index.
+ */
+int fossil_math_geom_polygon_area(const fossil_math_geom_point2d* vertices, size_t vertex_count,
+                                  const size_t* indices, size_t n, double* area);
+
+/**
+ * @brief Computes the perimeter of a closed polygon.
+ *
+ * @param vertices Pointer to the vertices.
+ * @param vertex_count Number of vertices.
+ * @param indices Pointer to n vertex indices in boundary order, or NULL to
+ *                use vertices 0 to n - 1.
+ * @param n Number of polygon vertices.
+ * @param perimeter Pointer that receives the perimeter, including the
+ *                  closing edge.
+ * @return 0 on success, -1 on an out-of-range vertex index.
+ */
+int fossil_math_geom_polygon_perimeter(const fossil_math_geom_point2d* vertices, size_t vertex_count,
+                                       const size_t* indices, size_t n, double* perimeter);
+
 /** 
  * ======================================================
  * Transformations (2D)
@@ -183,152 +476,2365 @@ fossil_math_geom_point2d fossil_math_geom_scale2d(fossil_math_geom_point2d p, do
  */
 fossil_math_geom_point2d fossil_math_geom_rotate2d(fossil_math_geom_point2d p, double angle_rad);
 
+/**
+ * @brief Rotates each 2D point around the origin by its own angle (in radians).
+ *
+ * The sines and cosines are computed together with the vectorized sincos.
+ *
+ * @param in Pointer to the points to rotate.
+ * @param angles_rad Pointer to one angle per point.
+ * @param out Pointer to the rotated points (may alias in).
+ * @param n Number of points.
+ */
+void fossil_math_geom_rotate2d_array(const fossil_math_geom_point2d* in, const double* angles_rad,
+                                     fossil_math_geom_point2d* out, size_t n);
+
 /** 
  * ======================================================
- * Plane geometry (3D)
+ * Polar and spherical coordinates
  * ======================================================
  */
 
+// theta is the azimuth from +x toward +y in [-pi, pi] (atan2(y, x)) and phi
+// the polar angle from +z in [0, pi]. The SoA forms take one array per
+// component; the point-array forms store (r, theta) in (x, y) and
+// (r, theta, phi) in (x, y, z). Every output may alias an input.
+
 /**
- * @brief Calculates the shortest distance from a 3D point to a plane.
- * 
- * @param p The 3D point.
- * @param plane The plane structure.
- * @return Distance from the point to the plane.
+ * @brief Converts Cartesian coordinates to polar (r, theta).
+ *
+ * @param x Pointer to the x coordinates.
+ * @param y Pointer to the y coordinates.
+ * @param r Pointer to the output radii.
+ * @param theta Pointer to the output angles in radians.
+ * @param n Number of points.
  */
-double fossil_math_geom_point_plane_distance(fossil_math_geom_point3d p,
-                                             fossil_math_geom_plane plane);
+void fossil_math_geom_cart_to_polar_soa(const double* x, const double* y, double* r, double* theta, size_t n);
 
-#ifdef __cplusplus
-}
-#include <stdexcept>
-#include <vector>
-#include <string>
+/**
+ * @brief Converts polar coordinates (r, theta) to Cartesian.
+ *
+ * @param r Pointer to the radii.
+ * @param theta Pointer to the angles in radians.
+ * @param x Pointer to the output x coordinates.
+ * @param y Pointer to the output y coordinates.
+ * @param n Number of points.
+ */
+void fossil_math_geom_polar_to_cart_soa(const double* r, const double* theta, double* x, double* y, size_t n);
 
-namespace fossil {
+/**
+ * @brief Converts Cartesian coordinates to spherical (r, theta, phi).
+ *
+ * @param x Pointer to the x coordinates.
+ * @param y Pointer to the y coordinates.
+ * @param z Pointer to the z coordinates.
+ * @param r Pointer to the output radii.
+ * @param theta Pointer to the output azimuths in radians.
+ * @param phi Pointer to the output polar angles in radians.
+ * @param n Number of points.
+ */
+void fossil_math_geom_cart_to_spherical_soa(const double* x, const double* y, const double* z,
+                                            double* r, double* theta, double* phi, size_t n);
 
-namespace math {
+/**
+ * @brief Converts spherical coordinates (r, theta, phi) to Cartesian.
+ *
+ * @param r Pointer to the radii.
+ * @param theta Pointer to the azimuths in radians.
+ * @param phi Pointer to the polar angles in radians.
+ * @param x Pointer to the output x coordinates.
+ * @param y Pointer to the output y coordinates.
+ * @param z Pointer to the output z coordinates.
+ * @param n Number of points.
+ */
+void fossil_math_geom_spherical_to_cart_soa(const double* r, const double* theta, const double* phi,
+                                            double* x, double* y, double* z, size_t n);
 
-    /**
-     * @brief Geometry utility class providing static methods for common geometric operations.
-     *
-     * This class wraps the C geometry functions in a C++-friendly interface,
-     * allowing for easier use in C++ codebases. All methods are static and
-     * operate directly on the provided structures.
-     */
-    class Geometry {
-    public:
-        /**
-         * @brief Calculates the Euclidean distance between two 2D points.
-         * @param a First 2D point.
-         * @param b Second 2D point.
-         * @return Distance between points a and b.
-         */
-        static double distance_2d(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b) {
-            return fossil_math_geom_distance2d(a, b);
-        }
+/**
+ * @brief Converts 2D points to polar form, stored as (r, theta).
+ *
+ * @param in Pointer to the Cartesian points.
+ * @param out Pointer to the polar points (may alias in).
+ * @param n Number of points.
+ */
+void fossil_math_geom_cart_to_polar_array(const fossil_math_geom_point2d* in, fossil_math_geom_point2d* out, size_t n);
 
-        /**
-         * @brief Calculates the Euclidean distance between two 3D points.
-         * @param a First 3D point.
-         * @param b Second 3D point.
-         * @return Distance between points a and b.
-         */
-        static double distance_3d(const fossil_math_geom_point3d& a, const fossil_math_geom_point3d& b) {
-            return fossil_math_geom_distance3d(a, b);
-        }
+/**
+ * @brief Converts polar points stored as (r, theta) back to Cartesian.
+ *
+ * @param in Pointer to the polar points.
+ * @param out Pointer to the Cartesian points (may alias in).
+ * @param n Number of points.
+ */
+void fossil_math_geom_polar_to_cart_array(const fossil_math_geom_point2d* in, fossil_math_geom_point2d* out, size_t n);
 
-        /**
-         * @brief Calculates the area of a circle.
-         * @param c Circle structure.
-         * @return Area of the circle.
-         */
-        static double circle_area(const fossil_math_geom_circle& c) {
-            return fossil_math_geom_circle_area(c);
-        }
+/**
+ * @brief Converts 3D points to spherical form, stored as (r, theta, phi).
+ *
+ * @param in Pointer to the Cartesian points.
+ * @param out Pointer to the spherical points (may alias in).
+ * @param n Number of points.
+ */
+void fossil_math_geom_cart_to_spherical_array(const fossil_math_geom_point3d* in, fossil_math_geom_point3d* out, size_t n);
 
-        /**
-         * @brief Calculates the circumference of a circle.
-         * @param c Circle structure.
-         * @return Circumference of the circle.
-         */
-        static double circle_circumference(const fossil_math_geom_circle& c) {
-            return fossil_math_geom_circle_circumference(c);
-        }
+/**
+ * @brief Converts spherical points stored as (r, theta, phi) back to Cartesian.
+ *
+ * @param in Pointer to the spherical points.
+ * @param out Pointer to the Cartesian points (may alias in).
+ * @param n Number of points.
+ */
+void fossil_math_geom_spherical_to_cart_array(const fossil_math_geom_point3d* in, fossil_math_geom_point3d* out, size_t n);
 
-        /**
-         * @brief Checks if a 2D point lies inside or on the boundary of a circle.
-         * @param p 2D point.
-         * @param c Circle structure.
-         * @return true if the point is inside or on the circle, false otherwise.
-         */
-        static bool point_in_circle(const fossil_math_geom_point2d& p, const fossil_math_geom_circle& c) {
-            return fossil_math_geom_point_in_circle(p, c) != 0;
-        }
+/** 
+ * ======================================================
+ * Point clouds (structure of arrays)
+ * ======================================================
+ */
 
-        /**
-         * @brief Calculates the area of a triangle given its three vertices.
-         * @param a First vertex of the triangle.
-         * @param b Second vertex of the triangle.
-         * @param c Third vertex of the triangle.
-         * @return Area of the triangle.
-         */
-        static double triangle_area(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b, const fossil_math_geom_point2d& c) {
-            return fossil_math_geom_triangle_area(a, b, c);
-        }
+// The batch distance kernels split clouds of at least 65536 points across the
+// fossil_math_set_threads() threads.
 
-        /**
-         * @brief Calculates the perimeter of a triangle given its three vertices.
-         * @param a First vertex of the triangle.
-         * @param b Second vertex of the triangle.
-         * @param c Third vertex of the triangle.
-         * @return Perimeter of the triangle.
-         */
-        static double triangle_perimeter(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b, const fossil_math_geom_point2d& c) {
-            return fossil_math_geom_triangle_perimeter(a, b, c);
-        }
+/**
+ * @brief Creates a 2D point cloud of n zeroed points.
+ *
+ * @param n Number of points.
+ * @return New cloud, or NULL on failure. Release with fossil_math_geom_cloud2d_destroy().
+ */
+fossil_math_geom_cloud2d* fossil_math_geom_cloud2d_create(size_t n);
 
-        /**
-         * @brief Translates a 2D point by given offsets.
-         * @param p The point to translate.
-         * @param dx Offset along the x-axis.
-         * @param dy Offset along the y-axis.
-         * @return Translated 2D point.
-         */
-        static fossil_math_geom_point2d translate_2d(const fossil_math_geom_point2d& p, double dx, double dy) {
-            return fossil_math_geom_translate2d(p, dx, dy);
-        }
+/**
+ * @brief Creates a 2D point cloud from an array of points.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @return New cloud, or NULL on failure. Release with fossil_math_geom_cloud2d_destroy().
+ */
+fossil_math_geom_cloud2d* fossil_math_geom_cloud2d_from_points(const fossil_math_geom_point2d* points, size_t n);
 
-        /**
-         * @brief Scales a 2D point by given scale factors.
-         * @param p The point to scale.
-         * @param sx Scale factor along the x-axis.
-         * @param sy Scale factor along the y-axis.
-         * @return Scaled 2D point.
-         */
-        static fossil_math_geom_point2d scale_2d(const fossil_math_geom_point2d& p, double sx, double sy) {
-            return fossil_math_geom_scale2d(p, sx, sy);
-        }
+/**
+ * @brief Releases a 2D point cloud.
+ *
+ * @param cloud Cloud to release (NULL is ignored).
+ */
+void fossil_math_geom_cloud2d_destroy(fossil_math_geom_cloud2d* cloud);
 
-        /**
-         * @brief Rotates a 2D point around the origin by a given angle (in radians).
-         * @param p The point to rotate.
-         * @param angle_rad Angle in radians.
-         * @return Rotated 2D point.
-         */
-        static fossil_math_geom_point2d rotate_2d(const fossil_math_geom_point2d& p, double angle_rad) {
-            return fossil_math_geom_rotate2d(p, angle_rad);
-        }
+/**
+ * @brief Copies a 2D point cloud back into an array of points.
+ *
+ * @param cloud The cloud.
+ * @param out Pointer to cloud->size output points.
+ */
+void fossil_math_geom_cloud2d_to_points(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d* out);
 
-        /**
-         * @brief Calculates the shortest distance from a 3D point to a plane.
-         * @param p The 3D point.
+/**
+ * @brief Computes the distance from a query point to every point of a 2D cloud.
+ *
+ * @param cloud The cloud.
+ * @param q The query point.
+ * @param out Pointer to cloud->size output distances.
+ */
+void fossil_math_geom_cloud2d_distance(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d q, double* out);
+
+/**
+ * @brief Computes the squared distance from a query point to every point of a 2D cloud.
+ *
+ * @param cloud The cloud.
+ * @param q The query point.
+ * @param out Pointer to cloud->size output squared distances.
+ */
+void fossil_math_geom_cloud2d_distance_sq(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d q, double* out);
+
+// Containment compares squared distances: a point is inside when
+// dx^2 + dy^2 <= r^2, and nothing is inside a circle with a negative or NaN
+// radius. Masks pack point i into bit i % 64 of word i / 64; bits past the
+// last point are cleared.
+
+/** Number of 64-bit mask words covering n points. */
+#define FOSSIL_MATH_GEOM_MASK_WORDS(n) (((n) + 63) / 64)
+
+/**
+ * @brief Tests every point of a 2D cloud against one circle.
+ *
+ * @param cloud The cloud.
+ * @param c The circle.
+ * @param mask Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size) output words.
+ * @return Number of points inside or on the circle.
+ */
+size_t fossil_math_geom_cloud2d_in_circle_mask(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_circle c,
+                                               uint64_t* mask);
+
+/**
+ * @brief Lists the points of a 2D cloud that lie inside or on one circle.
+ *
+ * @param cloud The cloud.
+ * @param c The circle.
+ * @param indices Pointer to room for cloud->size indices; receives the
+ *                matching indices in increasing order.
+ * @return Number of indices written.
+ */
+size_t fossil_math_geom_cloud2d_in_circle_indices(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_circle c,
+                                                  size_t* indices);
+
+/**
+ * @brief Tests every point of a 2D cloud against several circles.
+ *
+ * Each point is loaded once and tested against all circles, so this is
+ * faster than one fossil_math_geom_cloud2d_in_circle_mask() call per circle.
+ *
+ * @param cloud The cloud.
+ * @param circles Pointer to the circles.
+ * @param m Number of circles.
+ * @param mask Pointer to m rows of FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size)
+ *             output words; row j holds the points inside circles[j].
+ * @return Number of (point, circle) pairs with the point inside the circle.
+ */
+size_t fossil_math_geom_cloud2d_in_circles_mask(const fossil_math_geom_cloud2d* cloud,
+                                                const fossil_math_geom_circle* circles, size_t m, uint64_t* mask);
+
+/**
+ * @brief Creates a 3D point cloud of n zeroed points.
+ *
+ * @param n Number of points.
+ * @return New cloud, or NULL on failure. Release with fossil_math_geom_cloud3d_destroy().
+ */
+fossil_math_geom_cloud3d* fossil_math_geom_cloud3d_create(size_t n);
+
+/**
+ * @brief Creates a 3D point cloud from an array of points.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @return New cloud, or NULL on failure. Release with fossil_math_geom_cloud3d_destroy().
+ */
+fossil_math_geom_cloud3d* fossil_math_geom_cloud3d_from_points(const fossil_math_geom_point3d* points, size_t n);
+
+/**
+ * @brief Releases a 3D point cloud.
+ *
+ * @param cloud Cloud to release (NULL is ignored).
+ */
+void fossil_math_geom_cloud3d_destroy(fossil_math_geom_cloud3d* cloud);
+
+/**
+ * @brief Copies a 3D point cloud back into an array of points.
+ *
+ * @param cloud The cloud.
+ * @param out Pointer to cloud->size output points.
+ */
+void fossil_math_geom_cloud3d_to_points(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d* out);
+
+/**
+ * @brief Computes the distance from a query point to every point of a 3D cloud.
+ *
+ * @param cloud The cloud.
+ * @param q The query point.
+ * @param out Pointer to cloud->size output distances.
+ */
+void fossil_math_geom_cloud3d_distance(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d q, double* out);
+
+/**
+ * @brief Computes the squared distance from a query point to every point of a 3D cloud.
+ *
+ * @param cloud The cloud.
+ * @param q The query point.
+ * @param out Pointer to cloud->size output squared distances.
+ */
+void fossil_math_geom_cloud3d_distance_sq(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d q, double* out);
+
+// Pairwise distance matrices are row-major: entry (i, j) at out[i * b->size + j]
+// holds the distance from point i of a to point j of b. They are computed in
+// cache-sized tiles, like a blocked matrix product, with rows split across
+// the fossil_math_set_threads() threads.
+
+/**
+ * @brief Computes the distance from every point of a to every point of b.
+ *
+ * @param a The row cloud.
+ * @param b The column cloud.
+ * @param out Pointer to a->size * b->size output distances.
+ * @return 0 on success, -1 if the output size overflows size_t.
+ */
+int fossil_math_geom_cloud2d_cdist(const fossil_math_geom_cloud2d* a, const fossil_math_geom_cloud2d* b, double* out);
+
+/**
+ * @brief Computes the squared distance from every point of a to every point of b.
+ *
+ * @param a The row cloud.
+ * @param b The column cloud.
+ * @param out Pointer to a->size * b->size output squared distances.
+ * @return 0 on success, -1 if the output size overflows size_t.
+ */
+int fossil_math_geom_cloud2d_cdist_sq(const fossil_math_geom_cloud2d* a, const fossil_math_geom_cloud2d* b, double* out);
+
+/**
+ * @brief Finds the k points of b closest to each point of a without storing
+ *        the full distance matrix.
+ *
+ * @param a The query cloud.
+ * @param b The searched cloud.
+ * @param k Number of neighbours per query.
+ * @param indices Pointer to a->size * k output indices into b; row i lists
+ *                the neighbours of point i by increasing distance, ties by
+ *                index. Rows with fewer than k candidates (points with NaN
+ *                coordinates never match) are padded with SIZE_MAX.
+ * @param distances Pointer to a->size * k output distances, padded with
+ *                  INFINITY.
+ * @return 0 on success, -1 if the output size overflows size_t.
+ */
+int fossil_math_geom_cloud2d_cdist_topk(const fossil_math_geom_cloud2d* a, const fossil_math_geom_cloud2d* b, size_t k,
+                                        size_t* indices, double* distances);
+
+/**
+ * @brief Computes the distance from every point of a to every point of b.
+ *
+ * @param a The row cloud.
+ * @param b The column cloud.
+ * @param out Pointer to a->size * b->size output distances.
+ * @return 0 on success, -1 if the output size overflows size_t.
+ */
+int fossil_math_geom_cloud3d_cdist(const fossil_math_geom_cloud3d* a, const fossil_math_geom_cloud3d* b, double* out);
+
+/**
+ * @brief Computes the squared distance from every point of a to every point of b.
+ *
+ * @param a The row cloud.
+ * @param b The column cloud.
+ * @param out Pointer to a->size * b->size output squared distances.
+ * @return 0 on success, -1 if the output size overflows size_t.
+ */
+int fossil_math_geom_cloud3d_cdist_sq(const fossil_math_geom_cloud3d* a, const fossil_math_geom_cloud3d* b, double* out);
+
+/**
+ * @brief Finds the k points of b closest to each point of a without storing
+ *        the full distance matrix.
+ *
+ * @param a The query cloud.
+ * @param b The searched cloud.
+ * @param k Number of neighbours per query.
+ * @param indices Pointer to a->size * k output indices into b, laid out as
+ *                for fossil_math_geom_cloud2d_cdist_topk().
+ * @param distances Pointer to a->size * k output distances.
+ * @return 0 on success, -1 if the output size overflows size_t.
+ */
+int fossil_math_geom_cloud3d_cdist_topk(const fossil_math_geom_cloud3d* a, const fossil_math_geom_cloud3d* b, size_t k,
+                                        size_t* indices, double* distances);
+
+/** 
+ * ======================================================
+ * Axis-aligned boxes
+ * ======================================================
+ */
+
+// Bounds ignore NaN coordinates, and the bounds of nothing are the empty box
+// lo = +inf, hi = -inf. Box tests are closed: touching boxes overlap. Masks
+// are laid out as for fossil_math_geom_cloud2d_in_circle_mask(), and boxes
+// or points with a NaN coordinate never match.
+
+/**
+ * @brief Returns the smallest 2D box containing two boxes.
+ *
+ * @param a First box.
+ * @param b Second box.
+ * @return Merged box.
+ */
+fossil_math_geom_aabb2d fossil_math_geom_aabb2d_merge(fossil_math_geom_aabb2d a, fossil_math_geom_aabb2d b);
+
+/**
+ * @brief Returns the smallest 3D box containing two boxes.
+ *
+ * @param a First box.
+ * @param b Second box.
+ * @return Merged box.
+ */
+fossil_math_geom_aabb3d fossil_math_geom_aabb3d_merge(fossil_math_geom_aabb3d a, fossil_math_geom_aabb3d b);
+
+/**
+ * @brief Computes the bounding box of an array of 2D points.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @return Bounding box.
+ */
+fossil_math_geom_aabb2d fossil_math_geom_aabb2d_from_points(const fossil_math_geom_point2d* points, size_t n);
+
+/**
+ * @brief Computes the bounding box of an array of 3D points.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @return Bounding box.
+ */
+fossil_math_geom_aabb3d fossil_math_geom_aabb3d_from_points(const fossil_math_geom_point3d* points, size_t n);
+
+/**
+ * @brief Computes the bounding box of a 2D cloud.
+ *
+ * @param cloud The cloud.
+ * @return Bounding box.
+ */
+fossil_math_geom_aabb2d fossil_math_geom_cloud2d_bounds(const fossil_math_geom_cloud2d* cloud);
+
+/**
+ * @brief Computes the bounding box of a 3D cloud.
+ *
+ * @param cloud The cloud.
+ * @return Bounding box.
+ */
+fossil_math_geom_aabb3d fossil_math_geom_cloud3d_bounds(const fossil_math_geom_cloud3d* cloud);
+
+/**
+ * @brief Tests every point of a 2D cloud against one box.
+ *
+ * @param cloud The cloud.
+ * @param box The box.
+ * @param mask Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size) output words.
+ * @return Number of points inside or on the box.
+ */
+size_t fossil_math_geom_cloud2d_in_box_mask(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_aabb2d box,
+                                            uint64_t* mask);
+
+/**
+ * @brief Tests every point of a 3D cloud against one box.
+ *
+ * @param cloud The cloud.
+ * @param box The box.
+ * @param mask Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size) output words.
+ * @return Number of points inside or on the box.
+ */
+size_t fossil_math_geom_cloud3d_in_box_mask(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_aabb3d box,
+                                            uint64_t* mask);
+
+/**
+ * @brief Creates a set of n empty 2D boxes.
+ *
+ * @param n Number of boxes.
+ * @return New box set, or NULL on failure. Release with fossil_math_geom_boxes2d_destroy().
+ */
+fossil_math_geom_boxes2d* fossil_math_geom_boxes2d_create(size_t n);
+
+/**
+ * @brief Creates a 2D box set from an array of boxes.
+ *
+ * @param aabbs Pointer to the boxes.
+ * @param n Number of boxes.
+ * @return New box set, or NULL on failure. Release with fossil_math_geom_boxes2d_destroy().
+ */
+fossil_math_geom_boxes2d* fossil_math_geom_boxes2d_from_aabbs(const fossil_math_geom_aabb2d* aabbs, size_t n);
+
+/**
+ * @brief Releases a 2D box set.
+ *
+ * @param boxes Box set to release (NULL is ignored).
+ */
+void fossil_math_geom_boxes2d_destroy(fossil_math_geom_boxes2d* boxes);
+
+/**
+ * @brief Copies a 2D box set back into an array of boxes.
+ *
+ * @param boxes The box set.
+ * @param out Pointer to boxes->size output boxes.
+ */
+void fossil_math_geom_boxes2d_to_aabbs(const fossil_math_geom_boxes2d* boxes, fossil_math_geom_aabb2d* out);
+
+/**
+ * @brief Sets each box of a 2D box set to the bounds of a range of cloud points.
+ *
+ * Box i bounds points [offsets[i], offsets[i + 1]); an empty range gives an
+ * empty box.
+ *
+ * @param boxes The box set.
+ * @param cloud The cloud.
+ * @param offsets Pointer to boxes->size + 1 nondecreasing point offsets.
+ * @return 0 on success, -1 if the offsets decrease or run past the cloud.
+ */
+int fossil_math_geom_boxes2d_from_ranges(fossil_math_geom_boxes2d* boxes, const fossil_math_geom_cloud2d* cloud,
+                                         const size_t* offsets);
+
+/**
+ * @brief Computes the bounding box of a 2D box set.
+ *
+ * @param boxes The box set.
+ * @return Box containing every box of the set.
+ */
+fossil_math_geom_aabb2d fossil_math_geom_boxes2d_bounds(const fossil_math_geom_boxes2d* boxes);
+
+/**
+ * @brief Merges two 2D box sets box by box.
+ *
+ * @param a First box set.
+ * @param b Second box set.
+ * @param out Output box set; may be a or b.
+ * @return 0 on success, -1 if the sizes differ.
+ */
+int fossil_math_geom_boxes2d_merge(const fossil_math_geom_boxes2d* a, const fossil_math_geom_boxes2d* b,
+                                   fossil_math_geom_boxes2d* out);
+
+/**
+ * @brief Tests every box of a 2D box set for overlap with one box.
+ *
+ * @param boxes The box set.
+ * @param box The query box.
+ * @param mask Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(boxes->size) output words.
+ * @return Number of overlapping boxes.
+ */
+size_t fossil_math_geom_boxes2d_overlap_mask(const fossil_math_geom_boxes2d* boxes, fossil_math_geom_aabb2d box,
+                                             uint64_t* mask);
+
+/**
+ * @brief Tests which boxes of a 2D box set contain a point.
+ *
+ * @param boxes The box set.
+ * @param p The point.
+ * @param mask Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(boxes->size) output words.
+ * @return Number of boxes containing p.
+ */
+size_t fossil_math_geom_boxes2d_contains_mask(const fossil_math_geom_boxes2d* boxes, fossil_math_geom_point2d p,
+                                              uint64_t* mask);
+
+/**
+ * @brief Tests every box of a 2D box set for overlap with a circle.
+ *
+ * A box overlaps when its closest point to the center is inside or on the
+ * circle, so nothing overlaps a circle with a negative or NaN radius.
+ *
+ * @param boxes The box set.
+ * @param c The circle.
+ * @param mask Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(boxes->size) output words.
+ * @return Number of overlapping boxes.
+ */
+size_t fossil_math_geom_boxes2d_circle_mask(const fossil_math_geom_boxes2d* boxes, fossil_math_geom_circle c,
+                                            uint64_t* mask);
+
+/**
+ * @brief Creates a set of n empty 3D boxes.
+ *
+ * @param n Number of boxes.
+ * @return New box set, or NULL on failure. Release with fossil_math_geom_boxes3d_destroy().
+ */
+fossil_math_geom_boxes3d* fossil_math_geom_boxes3d_create(size_t n);
+
+/**
+ * @brief Creates a 3D box set from an array of boxes.
+ *
+ * @param aabbs Pointer to the boxes.
+ * @param n Number of boxes.
+ * @return New box set, or NULL on failure. Release with fossil_math_geom_boxes3d_destroy().
+ */
+fossil_math_geom_boxes3d* fossil_math_geom_boxes3d_from_aabbs(const fossil_math_geom_aabb3d* aabbs, size_t n);
+
+/**
+ * @brief Releases a 3D box set.
+ *
+ * @param boxes Box set to release (NULL is ignored).
+ */
+void fossil_math_geom_boxes3d_destroy(fossil_math_geom_boxes3d* boxes);
+
+/**
+ * @brief Copies a 3D box set back into an array of boxes.
+ *
+ * @param boxes The box set.
+ * @param out Pointer to boxes->size output boxes.
+ */
+void fossil_math_geom_boxes3d_to_aabbs(const fossil_math_geom_boxes3d* boxes, fossil_math_geom_aabb3d* out);
+
+/**
+ * @brief Sets each box of a 3D box set to the bounds of a range of cloud points.
+ *
+ * @param boxes The box set.
+ * @param cloud The cloud.
+ * @param offsets Pointer to boxes->size + 1 nondecreasing point offsets, as
+ *                for fossil_math_geom_boxes2d_from_ranges().
+ * @return 0 on success, -1 if the offsets decrease or run past the cloud.
+ */
+int fossil_math_geom_boxes3d_from_ranges(fossil_math_geom_boxes3d* boxes, const fossil_math_geom_cloud3d* cloud,
+                                         const size_t* offsets);
+
+/**
+ * @brief Computes the bounding box of a 3D box set.
+ *
+ * @param boxes The box set.
+ * @return Box containing every box of the set.
+ */
+fossil_math_geom_aabb3d fossil_math_geom_boxes3d_bounds(const fossil_math_geom_boxes3d* boxes);
+
+/**
+ * @brief Merges two 3D box sets box by box.
+ *
+ * @param a First box set.
+ * @param b Second box set.
+ * @param out Output box set; may be a or b.
+ * @return 0 on success, -1 if the sizes differ.
+ */
+int fossil_math_geom_boxes3d_merge(const fossil_math_geom_boxes3d* a, const fossil_math_geom_boxes3d* b,
+                                   fossil_math_geom_boxes3d* out);
+
+/**
+ * @brief Tests every box of a 3D box set for overlap with one box.
+ *
+ * @param boxes The box set.
+ * @param box The query box.
+ * @param mask Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(boxes->size) output words.
+ * @return Number of overlapping boxes.
+ */
+size_t fossil_math_geom_boxes3d_overlap_mask(const fossil_math_geom_boxes3d* boxes, fossil_math_geom_aabb3d box,
+                                             uint64_t* mask);
+
+/**
+ * @brief Tests which boxes of a 3D box set contain a point.
+ *
+ * @param boxes The box set.
+ * @param p The point.
+ * @param mask Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(boxes->size) output words.
+ * @return Number of boxes containing p.
+ */
+size_t fossil_math_geom_boxes3d_contains_mask(const fossil_math_geom_boxes3d* boxes, fossil_math_geom_point3d p,
+                                              uint64_t* mask);
+
+/** 
+ * ======================================================
+ * Affine transforms
+ * ======================================================
+ */
+
+// Build a transform once with the constructors and compose(), then apply it
+// to whole arrays or clouds in one pass. compose(a, b) applies b first.
+
+/**
+ * @brief Returns the 2D identity transform.
+ *
+ * @return Identity transform.
+ */
+fossil_math_geom_affine2d fossil_math_geom_affine2d_identity(void);
+
+/**
+ * @brief Returns a 2D translation.
+ *
+ * @param dx Offset along the x-axis.
+ * @param dy Offset along the y-axis.
+ * @return Translation transform.
+ */
+fossil_math_geom_affine2d fossil_math_geom_affine2d_translate(double dx, double dy);
+
+/**
+ * @brief Returns a 2D scale about the origin.
+ *
+ * @param sx Scale factor along the x-axis.
+ * @param sy Scale factor along the y-axis.
+ * @return Scale transform.
+ */
+fossil_math_geom_affine2d fossil_math_geom_affine2d_scale(double sx, double sy);
+
+/**
+ * @brief Returns a 2D rotation about the origin.
+ *
+ * @param angle_rad Counterclockwise angle in radians.
+ * @return Rotation transform.
+ */
+fossil_math_geom_affine2d fossil_math_geom_affine2d_rotate(double angle_rad);
+
+/**
+ * @brief Returns a 2D shear: x' = x + shx * y, y' = y + shy * x.
+ *
+ * @param shx Shear of x along y.
+ * @param shy Shear of y along x.
+ * @return Shear transform.
+ */
+fossil_math_geom_affine2d fossil_math_geom_affine2d_shear(double shx, double shy);
+
+/**
+ * @brief Composes two 2D transforms.
+ *
+ * @param a Transform applied second.
+ * @param b Transform applied first.
+ * @return The product a * b.
+ */
+fossil_math_geom_affine2d fossil_math_geom_affine2d_compose(const fossil_math_geom_affine2d* a, const fossil_math_geom_affine2d* b);
+
+/**
+ * @brief Inverts a 2D transform.
+ *
+ * @param a Transform to invert.
+ * @param out Pointer to the inverse (may alias a).
+ * @return 0 on success, -1 if the transform is singular or not finite.
+ */
+int fossil_math_geom_affine2d_invert(const fossil_math_geom_affine2d* a, fossil_math_geom_affine2d* out);
+
+/**
+ * @brief Applies a 2D transform to one point.
+ *
+ * @param a The transform.
+ * @param p The point.
+ * @return Transformed point.
+ */
+fossil_math_geom_point2d fossil_math_geom_affine2d_apply(const fossil_math_geom_affine2d* a, fossil_math_geom_point2d p);
+
+/**
+ * @brief Applies a 2D transform to an array of points.
+ *
+ * @param a The transform.
+ * @param in Pointer to the points.
+ * @param out Pointer to the transformed points (may alias in).
+ * @param n Number of points.
+ */
+void fossil_math_geom_affine2d_apply_array(const fossil_math_geom_affine2d* a, const fossil_math_geom_point2d* in,
+                                           fossil_math_geom_point2d* out, size_t n);
+
+/**
+ * @brief Applies a 2D transform to every point of a cloud in place.
+ *
+ * @param a The transform.
+ * @param cloud The cloud.
+ */
+void fossil_math_geom_affine2d_apply_cloud(const fossil_math_geom_affine2d* a, fossil_math_geom_cloud2d* cloud);
+
+/**
+ * @brief Returns the 3D identity transform.
+ *
+ * @return Identity transform.
+ */
+fossil_math_geom_affine3d fossil_math_geom_affine3d_identity(void);
+
+/**
+ * @brief Returns a 3D translation.
+ *
+ * @param dx Offset along the x-axis.
+ * @param dy Offset along the y-axis.
+ * @param dz Offset along the z-axis.
+ * @return Translation transform.
+ */
+fossil_math_geom_affine3d fossil_math_geom_affine3d_translate(double dx, double dy, double dz);
+
+/**
+ * @brief Returns a 3D scale about the origin.
+ *
+ * @param sx Scale factor along the x-axis.
+ * @param sy Scale factor along the y-axis.
+ * @param sz Scale factor along the z-axis.
+ * @return Scale transform.
+ */
+fossil_math_geom_affine3d fossil_math_geom_affine3d_scale(double sx, double sy, double sz);
+
+/**
+ * @brief Returns a right-handed 3D rotation about an axis through the origin.
+ *
+ * @param axis Rotation axis (need not be unit length).
+ * @param angle_rad Angle in radians.
+ * @return Rotation transform, or the identity if the axis is zero.
+ */
+fossil_math_geom_affine3d fossil_math_geom_affine3d_rotate(fossil_math_geom_point3d axis, double angle_rad);
+
+/**
+ * @brief Returns a 3D shear; each coordinate gains multiples of the other two.
+ *
+ * x' = x + xy * y + xz * z, y' = y + yx * x + yz * z, z' = z + zx * x + zy * y.
+ *
+ * @param xy Shear of x along y.
+ * @param xz Shear of x along z.
+ * @param yx Shear of y along x.
+ * @param yz Shear of y along z.
+ * @param zx Shear of z along x.
+ * @param zy Shear of z along y.
+ * @return Shear transform.
+ */
+fossil_math_geom_affine3d fossil_math_geom_affine3d_shear(double xy, double xz, double yx, double yz, double zx, double zy);
+
+/**
+ * @brief Composes two 3D transforms.
+ *
+ * @param a Transform applied second.
+ * @param b Transform applied first.
+ * @return The product a * b.
+ */
+fossil_math_geom_affine3d fossil_math_geom_affine3d_compose(const fossil_math_geom_affine3d* a, const fossil_math_geom_affine3d* b);
+
+/**
+ * @brief Inverts a 3D transform.
+ *
+ * @param a Transform to invert.
+ * @param out Pointer to the inverse (may alias a).
+ * @return 0 on success, -1 if the transform is singular or not finite.
+ */
+int fossil_math_geom_affine3d_invert(const fossil_math_geom_affine3d* a, fossil_math_geom_affine3d* out);
+
+/**
+ * @brief Applies a 3D transform to one point.
+ *
+ * @param a The transform.
+ * @param p The point.
+ * @return Transformed point.
+ */
+fossil_math_geom_point3d fossil_math_geom_affine3d_apply(const fossil_math_geom_affine3d* a, fossil_math_geom_point3d p);
+
+/**
+ * @brief Applies a 3D transform to an array of points.
+ *
+ * @param a The transform.
+ * @param in Pointer to the points.
+ * @param out Pointer to the transformed points (may alias in).
+ * @param n Number of points.
+ */
+void fossil_math_geom_affine3d_apply_array(const fossil_math_geom_affine3d* a, const fossil_math_geom_point3d* in,
+                                           fossil_math_geom_point3d* out, size_t n);
+
+/**
+ * @brief Applies a 3D transform to every point of a cloud in place.
+ *
+ * @param a The transform.
+ * @param cloud The cloud.
+ */
+void fossil_math_geom_affine3d_apply_cloud(const fossil_math_geom_affine3d* a, fossil_math_geom_cloud3d* cloud);
+
+/** 
+ * ======================================================
+ * Quaternions
+ * ======================================================
+ */
+
+// mul(a, b) rotates by b first, like compose(). The rotation functions expect
+// unit quaternions; normalize after accumulating many products.
+
+/**
+ * @brief Returns the identity quaternion (1, 0, 0, 0).
+ *
+ * @return Identity rotation.
+ */
+fossil_math_geom_quat fossil_math_geom_quat_identity(void);
+
+/**
+ * @brief Returns the rotation about an axis through the origin.
+ *
+ * @param axis Rotation axis (need not be unit length).
+ * @param angle_rad Right-handed angle in radians.
+ * @return Unit quaternion, or the identity if the axis is zero.
+ */
+fossil_math_geom_quat fossil_math_geom_quat_from_axis_angle(fossil_math_geom_point3d axis, double angle_rad);
+
+/**
+ * @brief Multiplies two quaternions (Hamilton product).
+ *
+ * @param a Rotation applied second.
+ * @param b Rotation applied first.
+ * @return The product a * b.
+ */
+fossil_math_geom_quat fossil_math_geom_quat_mul(fossil_math_geom_quat a, fossil_math_geom_quat b);
+
+/**
+ * @brief Returns the conjugate, which is the inverse rotation of a unit quaternion.
+ *
+ * @param q The quaternion.
+ * @return Conjugate (w, -x, -y, -z).
+ */
+fossil_math_geom_quat fossil_math_geom_quat_conjugate(fossil_math_geom_quat q);
+
+/**
+ * @brief Scales a quaternion to unit length.
+ *
+ * @param q The quaternion.
+ * @return Unit quaternion, or the identity if q is zero.
+ */
+fossil_math_geom_quat fossil_math_geom_quat_normalize(fossil_math_geom_quat q);
+
+/**
+ * @brief Converts a quaternion to a rotation transform.
+ *
+ * @param q The quaternion (normalized internally).
+ * @return Rotation transform with no translation.
+ */
+fossil_math_geom_affine3d fossil_math_geom_quat_to_affine3d(fossil_math_geom_quat q);
+
+/**
+ * @brief Extracts the rotation of a transform as a quaternion.
+ *
+ * The upper-left 3x3 block must be a rotation; scale, shear and
+ * translation are not supported.
+ *
+ * @param a The transform.
+ * @return Unit quaternion with w >= 0.
+ */
+fossil_math_geom_quat fossil_math_geom_quat_from_affine3d(const fossil_math_geom_affine3d* a);
+
+/**
+ * @brief Rotates one point.
+ *
+ * @param q Unit quaternion.
+ * @param p The point.
+ * @return Rotated point.
+ */
+fossil_math_geom_point3d fossil_math_geom_quat_rotate(fossil_math_geom_quat q, fossil_math_geom_point3d p);
+
+/**
+ * @brief Rotates an array of points by one quaternion.
+ *
+ * The quaternion is converted to a matrix once and applied with the affine
+ * SIMD kernel.
+ *
+ * @param q Unit quaternion.
+ * @param in Pointer to the points.
+ * @param out Pointer to the rotated points (may alias in).
+ * @param n Number of points.
+ */
+void fossil_math_geom_quat_rotate_array(fossil_math_geom_quat q, const fossil_math_geom_point3d* in,
+                                        fossil_math_geom_point3d* out, size_t n);
+
+/**
+ * @brief Rotates every point of a cloud in place.
+ *
+ * @param q Unit quaternion.
+ * @param cloud The cloud.
+ */
+void fossil_math_geom_quat_rotate_cloud(fossil_math_geom_quat q, fossil_math_geom_cloud3d* cloud);
+
+/**
+ * @brief Spherical linear interpolation along the shorter arc.
+ *
+ * Nearly parallel inputs fall back to normalized linear interpolation.
+ *
+ * @param a Start rotation (unit).
+ * @param b End rotation (unit).
+ * @param t Interpolation parameter, 0 gives a and 1 gives b.
+ * @return Interpolated unit quaternion.
+ */
+fossil_math_geom_quat fossil_math_geom_quat_slerp(fossil_math_geom_quat a, fossil_math_geom_quat b, double t);
+
+/**
+ * @brief Spherical linear interpolation of n quaternion pairs.
+ *
+ * @param a Pointer to the start rotations.
+ * @param b Pointer to the end rotations.
+ * @param t Pointer to one parameter per pair.
+ * @param out Pointer to the results (may alias a or b).
+ * @param n Number of pairs.
+ */
+void fossil_math_geom_quat_slerp_array(const fossil_math_geom_quat* a, const fossil_math_geom_quat* b,
+                                       const double* t, fossil_math_geom_quat* out, size_t n);
+
+/**
+ * @brief Normalized linear interpolation along the shorter arc.
+ *
+ * Cheaper than slerp; the angular speed is not constant.
+ *
+ * @param a Start rotation (unit).
+ * @param b End rotation (unit).
+ * @param t Interpolation parameter, 0 gives a and 1 gives b.
+ * @return Interpolated unit quaternion.
+ */
+fossil_math_geom_quat fossil_math_geom_quat_nlerp(fossil_math_geom_quat a, fossil_math_geom_quat b, double t);
+
+/**
+ * @brief Normalized linear interpolation of n quaternion pairs.
+ *
+ * @param a Pointer to the start rotations.
+ * @param b Pointer to the end rotations.
+ * @param t Pointer to one parameter per pair.
+ * @param out Pointer to the results (may alias a or b).
+ * @param n Number of pairs.
+ */
+void fossil_math_geom_quat_nlerp_array(const fossil_math_geom_quat* a, const fossil_math_geom_quat* b,
+                                       const double* t, fossil_math_geom_quat* out, size_t n);
+
+/** 
+ * ======================================================
+ * Plane geometry (3D)
+ * ======================================================
+ */
+
+/**
+ * @brief Calculates the shortest distance from a 3D point to a plane.
+ * 
+ * @param p The 3D point.
+ * @param plane The plane structure.
+ * @return Distance from the point to the plane.
+ */
+double fossil_math_geom_point_plane_distance(fossil_math_geom_point3d p,
+                                             fossil_math_geom_plane plane);
+
+/**
+ * @brief Normalizes a plane so distances need no square root.
+ *
+ * @param plane The plane.
+ * @param out Pointer that receives the plane scaled to a unit normal.
+ * @return 0 on success, -1 if the normal is zero or not finite.
+ */
+int fossil_math_geom_plane_prepare(fossil_math_geom_plane plane, fossil_math_geom_prepared_plane* out);
+
+/**
+ * @brief Calculates the signed distance from a 3D point to a prepared plane.
+ *
+ * @param plane The prepared plane.
+ * @param p The 3D point.
+ * @return Distance, positive on the side the normal points to.
+ */
+double fossil_math_geom_prepared_plane_distance(const fossil_math_geom_prepared_plane* plane,
+                                                fossil_math_geom_point3d p);
+
+/**
+ * @brief Computes the signed distance of every point of a 3D cloud to
+ *        several prepared planes.
+ *
+ * @param cloud The cloud.
+ * @param planes Pointer to the prepared planes.
+ * @param m Number of planes.
+ * @param out Pointer to m rows of cloud->size output distances; row j holds
+ *            the distances to planes[j].
+ */
+void fossil_math_geom_cloud3d_plane_distance(const fossil_math_geom_cloud3d* cloud,
+                                             const fossil_math_geom_prepared_plane* planes, size_t m, double* out);
+
+/**
+ * @brief Classifies the points (or spheres) of a 3D cloud against a set of
+ *        prepared planes, such as the six planes of a view frustum.
+ *
+ * Normals point into the kept region. A sphere of radius r around point i
+ * is inside when it lies entirely on the positive side of every plane,
+ * outside when it lies entirely on the negative side of some plane, and
+ * intersecting otherwise. Points with NaN coordinates are outside.
+ *
+ * @param cloud The sphere centers.
+ * @param radii Pointer to cloud->size radii, or NULL to classify points
+ *              (which are never intersecting).
+ * @param planes Pointer to the prepared planes.
+ * @param m Number of planes.
+ * @param inside Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size) output
+ *               words marking inside spheres, or NULL.
+ * @param intersecting Pointer to FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size)
+ *                     output words marking intersecting spheres, or NULL.
+ * @return Number of spheres that are not outside.
+ */
+size_t fossil_math_geom_cloud3d_classify_planes(const fossil_math_geom_cloud3d* cloud, const double* radii,
+                                                const fossil_math_geom_prepared_plane* planes, size_t m,
+                                                uint64_t* inside, uint64_t* intersecting);
+
+#ifdef __cplusplus
+}
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+namespace math {
+
+    /**
+     * @brief Geometry utility class providing static methods for common geometric operations.
+     *
+     * This class wraps the C geometry functions in a C++-friendly interface,
+     * allowing for easier use in C++ codebases. All methods are static and
+     * operate directly on the provided structures.
+     */
+    class Geometry {
+    public:
+        /**
+         * @brief Calculates the Euclidean distance between two 2D points.
+         * @param a First 2D point.
+         * @param b Second 2D point.
+         * @return Distance between points a and b.
+         */
+        static double distance_2d(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b) {
+            return fossil_math_geom_distance2d(a, b);
+        }
+
+        /**
+         * @brief Calculates the Euclidean distance between two 3D points.
+         * @param a First 3D point.
+         * @param b Second 3D point.
+         * @return Distance between points a and b.
+         */
+        static double distance_3d(const fossil_math_geom_point3d& a, const fossil_math_geom_point3d& b) {
+            return fossil_math_geom_distance3d(a, b);
+        }
+
+        /**
+         * @brief Calculates the area of a circle.
+         * @param c Circle structure.
+         * @return Area of the circle.
+         */
+        static double circle_area(const fossil_math_geom_circle& c) {
+            return fossil_math_geom_circle_area(c);
+        }
+
+        /**
+         * @brief Calculates the circumference of a circle.
+         * @param c Circle structure.
+         * @return Circumference of the circle.
+         */
+        static double circle_circumference(const fossil_math_geom_circle& c) {
+            return fossil_math_geom_circle_circumference(c);
+        }
+
+        /**
+         * @brief Checks if a 2D point lies inside or on the boundary of a circle.
+         * @param p 2D point.
+         * @param c Circle structure.
+         * @return true if the point is inside or on the circle, false otherwise.
+         */
+        static bool point_in_circle(const fossil_math_geom_point2d& p, const fossil_math_geom_circle& c) {
+            return fossil_math_geom_point_in_circle(p, c) != 0;
+        }
+
+        /**
+         * @brief Calculates the area of a triangle given its three vertices.
+         * @param a First vertex of the triangle.
+         * @param b Second vertex of the triangle.
+         * @param c Third vertex of the triangle.
+         * @return Area of the triangle.
+         */
+        static double triangle_area(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b, const fossil_math_geom_point2d& c) {
+            return fossil_math_geom_triangle_area(a, b, c);
+        }
+
+        /**
+         * @brief Calculates the perimeter of a triangle given its three vertices.
+         * @param a First vertex of the triangle.
+         * @param b Second vertex of the triangle.
+         * @param c Third vertex of the triangle.
+         * @return Perimeter of the triangle.
+         */
+        static double triangle_perimeter(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b, const fossil_math_geom_point2d& c) {
+            return fossil_math_geom_triangle_perimeter(a, b, c);
+        }
+
+        /**
+         * @brief Robust orientation of three 2D points.
+         * @param a First point.
+         * @param b Second point.
+         * @param c Third point.
+         * @return Positive if counterclockwise, negative if clockwise, zero if collinear.
+         */
+        static double orient2d(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b, const fossil_math_geom_point2d& c) {
+            return fossil_math_geom_orient2d(a, b, c);
+        }
+
+        /**
+         * @brief Robust orientation of a 3D point relative to the plane through three others.
+         * @param a First plane point.
+         * @param b Second plane point.
+         * @param c Third plane point.
+         * @param d Query point.
+         * @return Positive if d is on the side from which a, b, c appear clockwise,
+         *         negative on the other side, zero if coplanar.
+         */
+        static double orient3d(const fossil_math_geom_point3d& a, const fossil_math_geom_point3d& b,
+                               const fossil_math_geom_point3d& c, const fossil_math_geom_point3d& d) {
+            return fossil_math_geom_orient3d(a, b, c, d);
+        }
+
+        /**
+         * @brief Robust test of a 2D point against the circle through three counterclockwise points.
+         * @param a First circle point.
+         * @param b Second circle point.
+         * @param c Third circle point.
+         * @param d Query point.
+         * @return Positive inside, negative outside, zero on the circle.
+         */
+        static double incircle(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b,
+                               const fossil_math_geom_point2d& c, const fossil_math_geom_point2d& d) {
+            return fossil_math_geom_incircle(a, b, c, d);
+        }
+
+        /**
+         * @brief Robust test of a 3D point against the sphere through four positively oriented points.
+         * @param a First sphere point.
+         * @param b Second sphere point.
+         * @param c Third sphere point.
+         * @param d Fourth sphere point.
+         * @param e Query point.
+         * @return Positive inside, negative outside, zero on the sphere.
+         */
+        static double insphere(const fossil_math_geom_point3d& a, const fossil_math_geom_point3d& b,
+                               const fossil_math_geom_point3d& c, const fossil_math_geom_point3d& d,
+                               const fossil_math_geom_point3d& e) {
+            return fossil_math_geom_insphere(a, b, c, d, e);
+        }
+
+        /**
+         * @brief Computes the convex hull of a point array.
+         * @param points The points.
+         * @return Indices of the hull vertices, counterclockwise from the lowest-x point.
+         * @throws std::runtime_error if allocation fails.
+         */
+        static std::vector<size_t> convex_hull(const std::vector<fossil_math_geom_point2d>& points) {
+            std::vector<size_t> hull(points.size());
+            size_t count = fossil_math_geom_convex_hull2d(points.data(), points.size(), hull.data());
+            if (count == SIZE_MAX)
+                throw std::runtime_error("Convex hull allocation failed");
+            hull.resize(count);
+            return hull;
+        }
+
+        /**
+         * @brief Computes the per-triangle areas of a 3D mesh.
+         * @param vertices The vertices.
+         * @param indices Three vertex indices per triangle; empty to use consecutive vertex triples.
+         * @return Area of each triangle.
+         * @throws std::invalid_argument on a bad index buffer.
+         */
+        static std::vector<double> triangle_areas(const std::vector<fossil_math_geom_point3d>& vertices,
+                                                  const std::vector<size_t>& indices = {}) {
+            std::vector<double> areas(mesh_triangles(vertices.size(), indices));
+            if (fossil_math_geom_mesh_area3d(vertices.data(), vertices.size(), indices.empty() ? nullptr : indices.data(),
+                                             areas.size(), areas.data(), nullptr) != 0)
+                throw std::invalid_argument("Mesh vertex index out of range");
+            return areas;
+        }
+
+        /**
+         * @brief Computes the surface area of a 3D mesh.
+         * @param vertices The vertices.
+         * @param indices Three vertex indices per triangle; empty to use consecutive vertex triples.
+         * @return Total area.
+         * @throws std::invalid_argument on a bad index buffer.
+         */
+        static double mesh_area(const std::vector<fossil_math_geom_point3d>& vertices,
+                                const std::vector<size_t>& indices = {}) {
+            double total = 0.0;
+            if (fossil_math_geom_mesh_area3d(vertices.data(), vertices.size(), indices.empty() ? nullptr : indices.data(),
+                                             mesh_triangles(vertices.size(), indices), nullptr, &total) != 0)
+                throw std::invalid_argument("Mesh vertex index out of range");
+            return total;
+        }
+
+        /**
+         * @brief Computes the area of a 2D mesh.
+         * @param vertices The vertices.
+         * @param indices Three vertex indices per triangle; empty to use consecutive vertex triples.
+         * @return Total area.
+         * @throws std::invalid_argument on a bad index buffer.
+         */
+        static double mesh_area(const std::vector<fossil_math_geom_point2d>& vertices,
+                                const std::vector<size_t>& indices = {}) {
+            double total = 0.0;
+            if (fossil_math_geom_mesh_area2d(vertices.data(), vertices.size(), indices.empty() ? nullptr : indices.data(),
+                                             mesh_triangles(vertices.size(), indices), nullptr, &total) != 0)
+                throw std::invalid_argument("Mesh vertex index out of range");
+            return total;
+        }
+
+        /**
+         * @brief Computes the signed area of a polygon given in boundary order.
+         * @param vertices The polygon vertices.
+         * @return Area, positive for a counterclockwise boundary.
+         */
+        static double polygon_area(const std::vector<fossil_math_geom_point2d>& vertices) {
+            double area = 0.0;
+            fossil_math_geom_polygon_area(vertices.data(), vertices.size(), nullptr, vertices.size(), &area);
+            return area;
+        }
+
+        /**
+         * @brief Computes the perimeter of a closed polygon given in boundary order.
+         * @param vertices The polygon vertices.
+         * @return Perimeter, including the closing edge.
+         */
+        static double polygon_perimeter(const std::vector<fossil_math_geom_point2d>& vertices) {
+            double perimeter = 0.0;
+            fossil_math_geom_polygon_perimeter(vertices.data(), vertices.size(), nullptr, vertices.size(), &perimeter);
+            return perimeter;
+        }
+
+        /**
+         * @brief Translates a 2D point by given offsets.
+         * @param p The point to translate.
+         * @param dx Offset along the x-axis.
+         * @param dy Offset along the y-axis.
+         * @return Translated 2D point.
+         */
+        static fossil_math_geom_point2d translate_2d(const fossil_math_geom_point2d& p, double dx, double dy) {
+            return fossil_math_geom_translate2d(p, dx, dy);
+        }
+
+        /**
+         * @brief Scales a 2D point by given scale factors.
+         * @param p The point to scale.
+         * @param sx Scale factor along the x-axis.
+         * @param sy Scale factor along the y-axis.
+         * @return Scaled 2D point.
+         */
+        static fossil_math_geom_point2d scale_2d(const fossil_math_geom_point2d& p, double sx, double sy) {
+            return fossil_math_geom_scale2d(p, sx, sy);
+        }
+
+        /**
+         * @brief Rotates a 2D point around the origin by a given angle (in radians).
+         * @param p The point to rotate.
+         * @param angle_rad Angle in radians.
+         * @return Rotated 2D point.
+         */
+        static fossil_math_geom_point2d rotate_2d(const fossil_math_geom_point2d& p, double angle_rad) {
+            return fossil_math_geom_rotate2d(p, angle_rad);
+        }
+
+        /**
+         * @brief Rotates each 2D point around the origin by its own angle (in radians).
+         * @param points The points to rotate.
+         * @param angles_rad One angle per point.
+         * @return Rotated 2D points.
+         * @throws std::invalid_argument if the sizes differ.
+         */
+        static std::vector<fossil_math_geom_point2d> rotate_2d(const std::vector<fossil_math_geom_point2d>& points,
+                                                               const std::vector<double>& angles_rad) {
+            if (points.size() != angles_rad.size())
+                throw std::invalid_argument("Points and angles must have the same size");
+            std::vector<fossil_math_geom_point2d> out(points.size());
+            fossil_math_geom_rotate2d_array(points.data(), angles_rad.data(), out.data(), points.size());
+            return out;
+        }
+
+        /**
+         * @brief Converts 2D points to polar form, stored as (r, theta).
+         * @param points Cartesian points.
+         * @return Polar points.
+         */
+        static std::vector<fossil_math_geom_point2d> to_polar(const std::vector<fossil_math_geom_point2d>& points) {
+            std::vector<fossil_math_geom_point2d> out(points.size());
+            fossil_math_geom_cart_to_polar_array(points.data(), out.data(), points.size());
+            return out;
+        }
+
+        /**
+         * @brief Converts polar points stored as (r, theta) back to Cartesian.
+         * @param points Polar points.
+         * @return Cartesian points.
+         */
+        static std::vector<fossil_math_geom_point2d> from_polar(const std::vector<fossil_math_geom_point2d>& points) {
+            std::vector<fossil_math_geom_point2d> out(points.size());
+            fossil_math_geom_polar_to_cart_array(points.data(), out.data(), points.size());
+            return out;
+        }
+
+        /**
+         * @brief Converts 3D points to spherical form, stored as (r, theta, phi).
+         * @param points Cartesian points.
+         * @return Spherical points.
+         */
+        static std::vector<fossil_math_geom_point3d> to_spherical(const std::vector<fossil_math_geom_point3d>& points) {
+            std::vector<fossil_math_geom_point3d> out(points.size());
+            fossil_math_geom_cart_to_spherical_array(points.data(), out.data(), points.size());
+            return out;
+        }
+
+        /**
+         * @brief Converts spherical points stored as (r, theta, phi) back to Cartesian.
+         * @param points Spherical points.
+         * @return Cartesian points.
+         */
+        static std::vector<fossil_math_geom_point3d> from_spherical(const std::vector<fossil_math_geom_point3d>& points) {
+            std::vector<fossil_math_geom_point3d> out(points.size());
+            fossil_math_geom_spherical_to_cart_array(points.data(), out.data(), points.size());
+            return out;
+        }
+
+        /**
+         * @brief Calculates the shortest distance from a 3D point to a plane.
+         * @param p The 3D point.
          * @param plane The plane structure.
          * @return Distance from the point to the plane.
          */
-        static double point_plane_distance(const fossil_math_geom_point3d& p, const fossil_math_geom_plane& plane) {
-            return fossil_math_geom_point_plane_distance(p, plane);
+        static double point_plane_distance(const fossil_math_geom_point3d& p, const fossil_math_geom_plane& plane) {
+            return fossil_math_geom_point_plane_distance(p, plane);
+        }
+
+        /**
+         * @brief Normalizes a plane so distances need no square root.
+         * @param plane The plane.
+         * @return The plane scaled to a unit normal.
+         * @throws std::invalid_argument if the normal is zero or not finite.
+         */
+        static fossil_math_geom_prepared_plane prepare_plane(const fossil_math_geom_plane& plane) {
+            fossil_math_geom_prepared_plane out;
+            if (fossil_math_geom_plane_prepare(plane, &out) != 0)
+                throw std::invalid_argument("Plane normal must be finite and nonzero");
+            return out;
+        }
+
+        /**
+         * @brief Calculates the signed distance from a 3D point to a prepared plane.
+         * @param p The 3D point.
+         * @param plane The prepared plane.
+         * @return Distance, positive on the side the normal points to.
+         */
+        static double point_plane_distance(const fossil_math_geom_point3d& p, const fossil_math_geom_prepared_plane& plane) {
+            return fossil_math_geom_prepared_plane_distance(&plane, p);
+        }
+
+        /**
+         * @brief Computes the bounding box of a 2D point array.
+         * @param points The points.
+         * @return Bounding box; empty (lo > hi) for no points.
+         */
+        static fossil_math_geom_aabb2d bounds(const std::vector<fossil_math_geom_point2d>& points) {
+            return fossil_math_geom_aabb2d_from_points(points.data(), points.size());
+        }
+
+        /**
+         * @brief Computes the bounding box of a 3D point array.
+         * @param points The points.
+         * @return Bounding box; empty (lo > hi) for no points.
+         */
+        static fossil_math_geom_aabb3d bounds(const std::vector<fossil_math_geom_point3d>& points) {
+            return fossil_math_geom_aabb3d_from_points(points.data(), points.size());
+        }
+
+        /**
+         * @brief Returns the smallest 2D box containing two boxes.
+         * @param a First box.
+         * @param b Second box.
+         * @return Merged box.
+         */
+        static fossil_math_geom_aabb2d merge(const fossil_math_geom_aabb2d& a, const fossil_math_geom_aabb2d& b) {
+            return fossil_math_geom_aabb2d_merge(a, b);
+        }
+
+        /**
+         * @brief Returns the smallest 3D box containing two boxes.
+         * @param a First box.
+         * @param b Second box.
+         * @return Merged box.
+         */
+        static fossil_math_geom_aabb3d merge(const fossil_math_geom_aabb3d& a, const fossil_math_geom_aabb3d& b) {
+            return fossil_math_geom_aabb3d_merge(a, b);
+        }
+
+    private:
+        static size_t mesh_triangles(size_t vertex_count, const std::vector<size_t>& indices) {
+            size_t corners = indices.empty() ? vertex_count : indices.size();
+            if (corners % 3 != 0)
+                throw std::invalid_argument("Mesh corner count must be a multiple of 3");
+            return corners / 3;
+        }
+    };
+
+    /**
+     * @class PointCloud2D
+     * @brief RAII owner of a fossil_math_geom_cloud2d structure-of-arrays buffer.
+     *
+     * The wrapper is move-only; the coordinates are released with the wrapper.
+     */
+    class PointCloud2D {
+    public:
+        /**
+         * Creates a cloud of n points at the origin.
+         * @param n Number of points.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit PointCloud2D(size_t n) : cloud_(fossil_math_geom_cloud2d_create(n)) {
+            if (!cloud_)
+                throw std::runtime_error("PointCloud2D allocation failed");
+        }
+
+        /**
+         * Creates a cloud from a vector of points.
+         * @param points Points to copy.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit PointCloud2D(const std::vector<fossil_math_geom_point2d>& points)
+            : cloud_(fossil_math_geom_cloud2d_from_points(points.data(), points.size())) {
+            if (!cloud_)
+                throw std::runtime_error("PointCloud2D allocation failed");
+        }
+
+        ~PointCloud2D() { fossil_math_geom_cloud2d_destroy(cloud_); }
+
+        PointCloud2D(const PointCloud2D&) = delete;
+        PointCloud2D& operator=(const PointCloud2D&) = delete;
+
+        PointCloud2D(PointCloud2D&& other) noexcept : cloud_(other.cloud_) { other.cloud_ = nullptr; }
+
+        PointCloud2D& operator=(PointCloud2D&& other) noexcept {
+            if (this != &other) {
+                fossil_math_geom_cloud2d_destroy(cloud_);
+                cloud_ = other.cloud_;
+                other.cloud_ = nullptr;
+            }
+            return *this;
+        }
+
+        /** @return Number of points. */
+        size_t size() const { return cloud_->size; }
+
+        /** @return The x coordinates. */
+        double* x() { return cloud_->x; }
+        const double* x() const { return cloud_->x; }
+
+        /** @return The y coordinates. */
+        double* y() { return cloud_->y; }
+        const double* y() const { return cloud_->y; }
+
+        /** @return The underlying C cloud. */
+        fossil_math_geom_cloud2d* get() { return cloud_; }
+        const fossil_math_geom_cloud2d* get() const { return cloud_; }
+
+        /**
+         * Copies the cloud back into a vector of points.
+         * @return Points.
+         */
+        std::vector<fossil_math_geom_point2d> points() const {
+            std::vector<fossil_math_geom_point2d> out(cloud_->size);
+            fossil_math_geom_cloud2d_to_points(cloud_, out.data());
+            return out;
+        }
+
+        /**
+         * Computes the distance from a query point to every point.
+         * @param q Query point.
+         * @return One distance per point.
+         */
+        std::vector<double> distance(const fossil_math_geom_point2d& q) const {
+            std::vector<double> out(cloud_->size);
+            fossil_math_geom_cloud2d_distance(cloud_, q, out.data());
+            return out;
+        }
+
+        /**
+         * Computes the squared distance from a query point to every point.
+         * @param q Query point.
+         * @return One squared distance per point.
+         */
+        std::vector<double> distance_sq(const fossil_math_geom_point2d& q) const {
+            std::vector<double> out(cloud_->size);
+            fossil_math_geom_cloud2d_distance_sq(cloud_, q, out.data());
+            return out;
+        }
+
+        /**
+         * Computes the robust orientation of (a, b, p) for every point p.
+         * @param a First point of the directed line.
+         * @param b Second point of the directed line.
+         * @return One orientation per point, positive left of the line.
+         */
+        std::vector<double> orient2d(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b) const {
+            std::vector<double> out(cloud_->size);
+            fossil_math_geom_cloud2d_orient2d(cloud_, a, b, out.data());
+            return out;
+        }
+
+        /**
+         * Tests every point against the circle through three counterclockwise points.
+         * @param a First circle point.
+         * @param b Second circle point.
+         * @param c Third circle point.
+         * @return One result per point, positive inside the circle.
+         */
+        std::vector<double> incircle(const fossil_math_geom_point2d& a, const fossil_math_geom_point2d& b,
+                                     const fossil_math_geom_point2d& c) const {
+            std::vector<double> out(cloud_->size);
+            fossil_math_geom_cloud2d_incircle(cloud_, a, b, c, out.data());
+            return out;
+        }
+
+        /**
+         * Computes the distance from every point to every point of another cloud.
+         * @param other Column cloud.
+         * @param squared Return squared distances.
+         * @return size() rows of other.size() distances.
+         * @throws std::runtime_error if the output size overflows.
+         */
+        std::vector<double> cdist(const PointCloud2D& other, bool squared = false) const {
+            std::vector<double> out(cloud_->size * other.size());
+            int status = squared ? fossil_math_geom_cloud2d_cdist_sq(cloud_, other.get(), out.data())
+                                 : fossil_math_geom_cloud2d_cdist(cloud_, other.get(), out.data());
+            if (status != 0)
+                throw std::runtime_error("Distance matrix too large");
+            return out;
+        }
+
+        /**
+         * Finds the k nearest points of another cloud for every point.
+         * @param other Searched cloud.
+         * @param k Neighbours per point.
+         * @param indices Receives size() rows of k indices, padded with SIZE_MAX.
+         * @param distances Receives size() rows of k distances, padded with infinity.
+         * @throws std::runtime_error if the output size overflows.
+         */
+        void cdist_topk(const PointCloud2D& other, size_t k, std::vector<size_t>& indices, std::vector<double>& distances) const {
+            indices.resize(cloud_->size * k);
+            distances.resize(cloud_->size * k);
+            if (fossil_math_geom_cloud2d_cdist_topk(cloud_, other.get(), k, indices.data(), distances.data()) != 0)
+                throw std::runtime_error("Distance matrix too large");
+        }
+
+        /**
+         * Tests every point against a circle.
+         * @param c Circle.
+         * @return Packed mask, bit i % 64 of word i / 64 set when point i is inside.
+         */
+        std::vector<uint64_t> in_circle_mask(const fossil_math_geom_circle& c) const {
+            std::vector<uint64_t> mask(FOSSIL_MATH_GEOM_MASK_WORDS(cloud_->size));
+            fossil_math_geom_cloud2d_in_circle_mask(cloud_, c, mask.data());
+            return mask;
+        }
+
+        /**
+         * Lists the points inside or on a circle.
+         * @param c Circle.
+         * @return Indices of the points inside, in increasing order.
+         */
+        std::vector<size_t> in_circle(const fossil_math_geom_circle& c) const {
+            std::vector<size_t> indices(cloud_->size);
+            indices.resize(fossil_math_geom_cloud2d_in_circle_indices(cloud_, c, indices.data()));
+            return indices;
+        }
+
+        /**
+         * Tests every point against several circles.
+         * @param circles Circles.
+         * @return One mask row of FOSSIL_MATH_GEOM_MASK_WORDS(size()) words per circle.
+         */
+        std::vector<uint64_t> in_circles_mask(const std::vector<fossil_math_geom_circle>& circles) const {
+            std::vector<uint64_t> mask(circles.size() * FOSSIL_MATH_GEOM_MASK_WORDS(cloud_->size));
+            fossil_math_geom_cloud2d_in_circles_mask(cloud_, circles.data(), circles.size(), mask.data());
+            return mask;
+        }
+
+        /**
+         * Computes the bounding box of the points.
+         * @return Bounding box; empty (lo > hi) for an empty cloud.
+         */
+        fossil_math_geom_aabb2d bounds() const { return fossil_math_geom_cloud2d_bounds(cloud_); }
+
+        /**
+         * Tests every point against a box.
+         * @param box Box.
+         * @return Packed mask, bit i % 64 of word i / 64 set when point i is inside.
+         */
+        std::vector<uint64_t> in_box_mask(const fossil_math_geom_aabb2d& box) const {
+            std::vector<uint64_t> mask(FOSSIL_MATH_GEOM_MASK_WORDS(cloud_->size));
+            fossil_math_geom_cloud2d_in_box_mask(cloud_, box, mask.data());
+            return mask;
+        }
+
+    private:
+        fossil_math_geom_cloud2d* cloud_;
+    };
+
+    /**
+     * @class PointCloud3D
+     * @brief RAII owner of a fossil_math_geom_cloud3d structure-of-arrays buffer.
+     *
+     * The wrapper is move-only; the coordinates are released with the wrapper.
+     */
+    class PointCloud3D {
+    public:
+        /**
+         * Creates a cloud of n points at the origin.
+         * @param n Number of points.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit PointCloud3D(size_t n) : cloud_(fossil_math_geom_cloud3d_create(n)) {
+            if (!cloud_)
+                throw std::runtime_error("PointCloud3D allocation failed");
+        }
+
+        /**
+         * Creates a cloud from a vector of points.
+         * @param points Points to copy.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit PointCloud3D(const std::vector<fossil_math_geom_point3d>& points)
+            : cloud_(fossil_math_geom_cloud3d_from_points(points.data(), points.size())) {
+            if (!cloud_)
+                throw std::runtime_error("PointCloud3D allocation failed");
+        }
+
+        ~PointCloud3D() { fossil_math_geom_cloud3d_destroy(cloud_); }
+
+        PointCloud3D(const PointCloud3D&) = delete;
+        PointCloud3D& operator=(const PointCloud3D&) = delete;
+
+        PointCloud3D(PointCloud3D&& other) noexcept : cloud_(other.cloud_) { other.cloud_ = nullptr; }
+
+        PointCloud3D& operator=(PointCloud3D&& other) noexcept {
+            if (this != &other) {
+                fossil_math_geom_cloud3d_destroy(cloud_);
+                cloud_ = other.cloud_;
+                other.cloud_ = nullptr;
+            }
+            return *this;
+        }
+
+        /** @return Number of points. */
+        size_t size() const { return cloud_->size; }
+
+        /** @return The x coordinates. */
+        double* x() { return cloud_->x; }
+        const double* x() const { return cloud_->x; }
+
+        /** @return The y coordinates. */
+        double* y() { return cloud_->y; }
+        const double* y() const { return cloud_->y; }
+
+        /** @return The z coordinates. */
+        double* z() { return cloud_->z; }
+        const double* z() const { return cloud_->z; }
+
+        /** @return The underlying C cloud. */
+        fossil_math_geom_cloud3d* get() { return cloud_; }
+        const fossil_math_geom_cloud3d* get() const { return cloud_; }
+
+        /**
+         * Copies the cloud back into a vector of points.
+         * @return Points.
+         */
+        std::vector<fossil_math_geom_point3d> points() const {
+            std::vector<fossil_math_geom_point3d> out(cloud_->size);
+            fossil_math_geom_cloud3d_to_points(cloud_, out.data());
+            return out;
+        }
+
+        /**
+         * Computes the distance from a query point to every point.
+         * @param q Query point.
+         * @return One distance per point.
+         */
+        std::vector<double> distance(const fossil_math_geom_point3d& q) const {
+            std::vector<double> out(cloud_->size);
+            fossil_math_geom_cloud3d_distance(cloud_, q, out.data());
+            return out;
+        }
+
+        /**
+         * Computes the squared distance from a query point to every point.
+         * @param q Query point.
+         * @return One squared distance per point.
+         */
+        std::vector<double> distance_sq(const fossil_math_geom_point3d& q) const {
+            std::vector<double> out(cloud_->size);
+            fossil_math_geom_cloud3d_distance_sq(cloud_, q, out.data());
+            return out;
+        }
+
+        /**
+         * Computes the robust orientation of every point against the plane through a, b, c.
+         * @param a First plane point.
+         * @param b Second plane point.
+         * @param c Third plane point.
+         * @return One orientation per point, as Geometry::orient3d().
+         */
+        std::vector<double> orient3d(const fossil_math_geom_point3d& a, const fossil_math_geom_point3d& b,
+                                     const fossil_math_geom_point3d& c) const {
+            std::vector<double> out(cloud_->size);
+            fossil_math_geom_cloud3d_orient3d(cloud_, a, b, c, out.data());
+            return out;
+        }
+
+        /**
+         * Tests every point against the sphere through four positively oriented points.
+         * @param a First sphere point.
+         * @param b Second sphere point.
+         * @param c Third sphere point.
+         * @param d Fourth sphere point.
+         * @return One result per point, positive inside the sphere.
+         */
+        std::vector<double> insphere(const fossil_math_geom_point3d& a, const fossil_math_geom_point3d& b,
+                                     const fossil_math_geom_point3d& c, const fossil_math_geom_point3d& d) const {
+            std::vector<double> out(cloud_->size);
+            fossil_math_geom_cloud3d_insphere(cloud_, a, b, c, d, out.data());
+            return out;
+        }
+
+        /**
+         * Computes the distance from every point to every point of another cloud.
+         * @param other Column cloud.
+         * @param squared Return squared distances.
+         * @return size() rows of other.size() distances.
+         * @throws std::runtime_error if the output size overflows.
+         */
+        std::vector<double> cdist(const PointCloud3D& other, bool squared = false) const {
+            std::vector<double> out(cloud_->size * other.size());
+            int status = squared ? fossil_math_geom_cloud3d_cdist_sq(cloud_, other.get(), out.data())
+                                 : fossil_math_geom_cloud3d_cdist(cloud_, other.get(), out.data());
+            if (status != 0)
+                throw std::runtime_error("Distance matrix too large");
+            return out;
+        }
+
+        /**
+         * Finds the k nearest points of another cloud for every point.
+         * @param other Searched cloud.
+         * @param k Neighbours per point.
+         * @param indices Receives size() rows of k indices, padded with SIZE_MAX.
+         * @param distances Receives size() rows of k distances, padded with infinity.
+         * @throws std::runtime_error if the output size overflows.
+         */
+        void cdist_topk(const PointCloud3D& other, size_t k, std::vector<size_t>& indices, std::vector<double>& distances) const {
+            indices.resize(cloud_->size * k);
+            distances.resize(cloud_->size * k);
+            if (fossil_math_geom_cloud3d_cdist_topk(cloud_, other.get(), k, indices.data(), distances.data()) != 0)
+                throw std::runtime_error("Distance matrix too large");
+        }
+
+        /**
+         * Computes the signed distance of every point to several prepared planes.
+         * @param planes The prepared planes.
+         * @return planes.size() rows of size() distances.
+         */
+        std::vector<double> plane_distance(const std::vector<fossil_math_geom_prepared_plane>& planes) const {
+            std::vector<double> out(planes.size() * cloud_->size);
+            fossil_math_geom_cloud3d_plane_distance(cloud_, planes.data(), planes.size(), out.data());
+            return out;
+        }
+
+        /**
+         * Classifies the points, or spheres around them, against a set of prepared planes.
+         * @param planes The prepared planes, normals pointing inward.
+         * @param radii One radius per point, or empty to classify points.
+         * @param inside Receives the mask of inside spheres.
+         * @param intersecting Receives the mask of intersecting spheres.
+         * @return Number of spheres that are not outside.
+         * @throws std::invalid_argument if radii has the wrong size.
+         */
+        size_t classify_planes(const std::vector<fossil_math_geom_prepared_plane>& planes, const std::vector<double>& radii,
+                               std::vector<uint64_t>& inside, std::vector<uint64_t>& intersecting) const {
+            if (!radii.empty() && radii.size() != cloud_->size)
+                throw std::invalid_argument("Expected one radius per point");
+            inside.assign(FOSSIL_MATH_GEOM_MASK_WORDS(cloud_->size), 0);
+            intersecting.assign(inside.size(), 0);
+            return fossil_math_geom_cloud3d_classify_planes(cloud_, radii.empty() ? nullptr : radii.data(), planes.data(),
+                                                            planes.size(), inside.data(), intersecting.data());
+        }
+
+        /**
+         * Computes the bounding box of the points.
+         * @return Bounding box; empty (lo > hi) for an empty cloud.
+         */
+        fossil_math_geom_aabb3d bounds() const { return fossil_math_geom_cloud3d_bounds(cloud_); }
+
+        /**
+         * Tests every point against a box.
+         * @param box Box.
+         * @return Packed mask, bit i % 64 of word i / 64 set when point i is inside.
+         */
+        std::vector<uint64_t> in_box_mask(const fossil_math_geom_aabb3d& box) const {
+            std::vector<uint64_t> mask(FOSSIL_MATH_GEOM_MASK_WORDS(cloud_->size));
+            fossil_math_geom_cloud3d_in_box_mask(cloud_, box, mask.data());
+            return mask;
+        }
+
+    private:
+        fossil_math_geom_cloud3d* cloud_;
+    };
+
+    /**
+     * @class Boxes2D
+     * @brief RAII owner of a fossil_math_geom_boxes2d structure-of-arrays buffer.
+     *
+     * The wrapper is move-only; the bounds are released with the wrapper.
+     */
+    class Boxes2D {
+    public:
+        /**
+         * Creates n empty boxes.
+         * @param n Number of boxes.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit Boxes2D(size_t n) : boxes_(fossil_math_geom_boxes2d_create(n)) {
+            if (!boxes_)
+                throw std::runtime_error("Boxes2D allocation failed");
+        }
+
+        /**
+         * Creates a box set from a vector of boxes.
+         * @param aabbs Boxes to copy.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit Boxes2D(const std::vector<fossil_math_geom_aabb2d>& aabbs)
+            : boxes_(fossil_math_geom_boxes2d_from_aabbs(aabbs.data(), aabbs.size())) {
+            if (!boxes_)
+                throw std::runtime_error("Boxes2D allocation failed");
+        }
+
+        ~Boxes2D() { fossil_math_geom_boxes2d_destroy(boxes_); }
+
+        Boxes2D(const Boxes2D&) = delete;
+        Boxes2D& operator=(const Boxes2D&) = delete;
+
+        Boxes2D(Boxes2D&& other) noexcept : boxes_(other.boxes_) { other.boxes_ = nullptr; }
+
+        Boxes2D& operator=(Boxes2D&& other) noexcept {
+            if (this != &other) {
+                fossil_math_geom_boxes2d_destroy(boxes_);
+                boxes_ = other.boxes_;
+                other.boxes_ = nullptr;
+            }
+            return *this;
+        }
+
+        /** @return Number of boxes. */
+        size_t size() const { return boxes_->size; }
+
+        /** @return The lo x bounds. */
+        double* lo_x() { return boxes_->lo_x; }
+        const double* lo_x() const { return boxes_->lo_x; }
+
+        /** @return The lo y bounds. */
+        double* lo_y() { return boxes_->lo_y; }
+        const double* lo_y() const { return boxes_->lo_y; }
+
+        /** @return The hi x bounds. */
+        double* hi_x() { return boxes_->hi_x; }
+        const double* hi_x() const { return boxes_->hi_x; }
+
+        /** @return The hi y bounds. */
+        double* hi_y() { return boxes_->hi_y; }
+        const double* hi_y() const { return boxes_->hi_y; }
+
+        /** @return The underlying C box set. */
+        fossil_math_geom_boxes2d* get() { return boxes_; }
+        const fossil_math_geom_boxes2d* get() const { return boxes_; }
+
+        /**
+         * Copies the box set back into a vector of boxes.
+         * @return Boxes.
+         */
+        std::vector<fossil_math_geom_aabb2d> aabbs() const {
+            std::vector<fossil_math_geom_aabb2d> out(boxes_->size);
+            fossil_math_geom_boxes2d_to_aabbs(boxes_, out.data());
+            return out;
+        }
+
+        /**
+         * Sets each box to the bounds of a range of cloud points.
+         * @param cloud The cloud.
+         * @param offsets size() + 1 nondecreasing offsets; box i bounds points [offsets[i], offsets[i + 1]).
+         * @throws std::invalid_argument if the offsets are invalid.
+         */
+        void from_ranges(const PointCloud2D& cloud, const std::vector<size_t>& offsets) {
+            if (offsets.size() != boxes_->size + 1 ||
+                fossil_math_geom_boxes2d_from_ranges(boxes_, cloud.get(), offsets.data()) != 0)
+                throw std::invalid_argument("Expected size() + 1 nondecreasing offsets within the cloud");
+        }
+
+        /**
+         * Computes the box containing every box.
+         * @return Bounding box; empty (lo > hi) for an empty set.
+         */
+        fossil_math_geom_aabb2d bounds() const { return fossil_math_geom_boxes2d_bounds(boxes_); }
+
+        /**
+         * Grows each box to also contain the matching box of another set.
+         * @param other Box set of the same size.
+         * @throws std::invalid_argument if the sizes differ.
+         */
+        void merge(const Boxes2D& other) {
+            if (fossil_math_geom_boxes2d_merge(boxes_, other.get(), boxes_) != 0)
+                throw std::invalid_argument("Box sets must have the same size");
+        }
+
+        /**
+         * Tests every box for overlap with a query box.
+         * @param box Query box.
+         * @return Packed mask, bit i % 64 of word i / 64 set when box i overlaps.
+         */
+        std::vector<uint64_t> overlap_mask(const fossil_math_geom_aabb2d& box) const {
+            std::vector<uint64_t> mask(FOSSIL_MATH_GEOM_MASK_WORDS(boxes_->size));
+            fossil_math_geom_boxes2d_overlap_mask(boxes_, box, mask.data());
+            return mask;
+        }
+
+        /**
+         * Tests which boxes contain a point.
+         * @param p Point.
+         * @return Packed mask, bit i % 64 of word i / 64 set when box i contains p.
+         */
+        std::vector<uint64_t> contains_mask(const fossil_math_geom_point2d& p) const {
+            std::vector<uint64_t> mask(FOSSIL_MATH_GEOM_MASK_WORDS(boxes_->size));
+            fossil_math_geom_boxes2d_contains_mask(boxes_, p, mask.data());
+            return mask;
+        }
+
+        /**
+         * Tests every box for overlap with a circle.
+         * @param c Circle.
+         * @return Packed mask, bit i % 64 of word i / 64 set when box i overlaps.
+         */
+        std::vector<uint64_t> circle_mask(const fossil_math_geom_circle& c) const {
+            std::vector<uint64_t> mask(FOSSIL_MATH_GEOM_MASK_WORDS(boxes_->size));
+            fossil_math_geom_boxes2d_circle_mask(boxes_, c, mask.data());
+            return mask;
+        }
+
+    private:
+        fossil_math_geom_boxes2d* boxes_;
+    };
+
+    /**
+     * @class Boxes3D
+     * @brief RAII owner of a fossil_math_geom_boxes3d structure-of-arrays buffer.
+     *
+     * The wrapper is move-only; the bounds are released with the wrapper.
+     */
+    class Boxes3D {
+    public:
+        /**
+         * Creates n empty boxes.
+         * @param n Number of boxes.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit Boxes3D(size_t n) : boxes_(fossil_math_geom_boxes3d_create(n)) {
+            if (!boxes_)
+                throw std::runtime_error("Boxes3D allocation failed");
+        }
+
+        /**
+         * Creates a box set from a vector of boxes.
+         * @param aabbs Boxes to copy.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit Boxes3D(const std::vector<fossil_math_geom_aabb3d>& aabbs)
+            : boxes_(fossil_math_geom_boxes3d_from_aabbs(aabbs.data(), aabbs.size())) {
+            if (!boxes_)
+                throw std::runtime_error("Boxes3D allocation failed");
+        }
+
+        ~Boxes3D() { fossil_math_geom_boxes3d_destroy(boxes_); }
+
+        Boxes3D(const Boxes3D&) = delete;
+        Boxes3D& operator=(const Boxes3D&) = delete;
+
+        Boxes3D(Boxes3D&& other) noexcept : boxes_(other.boxes_) { other.boxes_ = nullptr; }
+
+        Boxes3D& operator=(Boxes3D&& other) noexcept {
+            if (this != &other) {
+                fossil_math_geom_boxes3d_destroy(boxes_);
+                boxes_ = other.boxes_;
+                other.boxes_ = nullptr;
+            }
+            return *this;
+        }
+
+        /** @return Number of boxes. */
+        size_t size() const { return boxes_->size; }
+
+        /** @return The lo x bounds. */
+        double* lo_x() { return boxes_->lo_x; }
+        const double* lo_x() const { return boxes_->lo_x; }
+
+        /** @return The lo y bounds. */
+        double* lo_y() { return boxes_->lo_y; }
+        const double* lo_y() const { return boxes_->lo_y; }
+
+        /** @return The lo z bounds. */
+        double* lo_z() { return boxes_->lo_z; }
+        const double* lo_z() const { return boxes_->lo_z; }
+
+        /** @return The hi x bounds. */
+        double* hi_x() { return boxes_->hi_x; }
+        const double* hi_x() const { return boxes_->hi_x; }
+
+        /** @return The hi y bounds. */
+        double* hi_y() { return boxes_->hi_y; }
+        const double* hi_y() const { return boxes_->hi_y; }
+
+        /** @return The hi z bounds. */
+        double* hi_z() { return boxes_->hi_z; }
+        const double* hi_z() const { return boxes_->hi_z; }
+
+        /** @return The underlying C box set. */
+        fossil_math_geom_boxes3d* get() { return boxes_; }
+        const fossil_math_geom_boxes3d* get() const { return boxes_; }
+
+        /**
+         * Copies the box set back into a vector of boxes.
+         * @return Boxes.
+         */
+        std::vector<fossil_math_geom_aabb3d> aabbs() const {
+            std::vector<fossil_math_geom_aabb3d> out(boxes_->size);
+            fossil_math_geom_boxes3d_to_aabbs(boxes_, out.data());
+            return out;
+        }
+
+        /**
+         * Sets each box to the bounds of a range of cloud points.
+         * @param cloud The cloud.
+         * @param offsets size() + 1 nondecreasing offsets; box i bounds points [offsets[i], offsets[i + 1]).
+         * @throws std::invalid_argument if the offsets are invalid.
+         */
+        void from_ranges(const PointCloud3D& cloud, const std::vector<size_t>& offsets) {
+            if (offsets.size() != boxes_->size + 1 ||
+                fossil_math_geom_boxes3d_from_ranges(boxes_, cloud.get(), offsets.data()) != 0)
+                throw std::invalid_argument("Expected size() + 1 nondecreasing offsets within the cloud");
+        }
+
+        /**
+         * Computes the box containing every box.
+         * @return Bounding box; empty (lo > hi) for an empty set.
+         */
+        fossil_math_geom_aabb3d bounds() const { return fossil_math_geom_boxes3d_bounds(boxes_); }
+
+        /**
+         * Grows each box to also contain the matching box of another set.
+         * @param other Box set of the same size.
+         * @throws std::invalid_argument if the sizes differ.
+         */
+        void merge(const Boxes3D& other) {
+            if (fossil_math_geom_boxes3d_merge(boxes_, other.get(), boxes_) != 0)
+                throw std::invalid_argument("Box sets must have the same size");
+        }
+
+        /**
+         * Tests every box for overlap with a query box.
+         * @param box Query box.
+         * @return Packed mask, bit i % 64 of word i / 64 set when box i overlaps.
+         */
+        std::vector<uint64_t> overlap_mask(const fossil_math_geom_aabb3d& box) const {
+            std::vector<uint64_t> mask(FOSSIL_MATH_GEOM_MASK_WORDS(boxes_->size));
+            fossil_math_geom_boxes3d_overlap_mask(boxes_, box, mask.data());
+            return mask;
+        }
+
+        /**
+         * Tests which boxes contain a point.
+         * @param p Point.
+         * @return Packed mask, bit i % 64 of word i / 64 set when box i contains p.
+         */
+        std::vector<uint64_t> contains_mask(const fossil_math_geom_point3d& p) const {
+            std::vector<uint64_t> mask(FOSSIL_MATH_GEOM_MASK_WORDS(boxes_->size));
+            fossil_math_geom_boxes3d_contains_mask(boxes_, p, mask.data());
+            return mask;
+        }
+
+    private:
+        fossil_math_geom_boxes3d* boxes_;
+    };
+
+    /**
+     * @class Affine2D
+     * @brief Value wrapper around fossil_math_geom_affine2d.
+     *
+     * Products compose right to left: (a * b).apply(p) applies b first.
+     */
+    class Affine2D {
+    public:
+        Affine2D() : m_(fossil_math_geom_affine2d_identity()) {}
+        explicit Affine2D(const fossil_math_geom_affine2d& m) : m_(m) {}
+
+        /** @return Translation by (dx, dy). */
+        static Affine2D translate(double dx, double dy) { return Affine2D(fossil_math_geom_affine2d_translate(dx, dy)); }
+
+        /** @return Scale by (sx, sy) about the origin. */
+        static Affine2D scale(double sx, double sy) { return Affine2D(fossil_math_geom_affine2d_scale(sx, sy)); }
+
+        /** @return Counterclockwise rotation by angle_rad about the origin. */
+        static Affine2D rotate(double angle_rad) { return Affine2D(fossil_math_geom_affine2d_rotate(angle_rad)); }
+
+        /** @return Shear x' = x + shx * y, y' = y + shy * x. */
+        static Affine2D shear(double shx, double shy) { return Affine2D(fossil_math_geom_affine2d_shear(shx, shy)); }
+
+        /** @return The composition that applies other first, then this. */
+        Affine2D operator*(const Affine2D& other) const {
+            return Affine2D(fossil_math_geom_affine2d_compose(&m_, &other.m_));
+        }
+
+        /**
+         * Returns the inverse transform.
+         * @return Inverse.
+         * @throws std::runtime_error if the transform is singular.
+         */
+        Affine2D inverse() const {
+            Affine2D r;
+            if (fossil_math_geom_affine2d_invert(&m_, &r.m_) != 0)
+                throw std::runtime_error("Affine2D is singular");
+            return r;
+        }
+
+        /** @return The transformed point. */
+        fossil_math_geom_point2d apply(const fossil_math_geom_point2d& p) const {
+            return fossil_math_geom_affine2d_apply(&m_, p);
+        }
+
+        /** @return The transformed points. */
+        std::vector<fossil_math_geom_point2d> apply(const std::vector<fossil_math_geom_point2d>& points) const {
+            std::vector<fossil_math_geom_point2d> out(points.size());
+            fossil_math_geom_affine2d_apply_array(&m_, points.data(), out.data(), points.size());
+            return out;
+        }
+
+        /** Transforms every point of a cloud in place. */
+        void apply(PointCloud2D& cloud) const {
+            fossil_math_geom_affine2d_apply_cloud(&m_, cloud.get());
         }
+
+        /** @return The underlying C matrix. */
+        const fossil_math_geom_affine2d& get() const { return m_; }
+
+    private:
+        fossil_math_geom_affine2d m_;
+    };
+
+    /**
+     * @class Affine3D
+     * @brief Value wrapper around fossil_math_geom_affine3d.
+     *
+     * Products compose right to left: (a * b).apply(p) applies b first.
+     */
+    class Affine3D {
+    public:
+        Affine3D() : m_(fossil_math_geom_affine3d_identity()) {}
+        explicit Affine3D(const fossil_math_geom_affine3d& m) : m_(m) {}
+
+        /** @return Translation by (dx, dy, dz). */
+        static Affine3D translate(double dx, double dy, double dz) {
+            return Affine3D(fossil_math_geom_affine3d_translate(dx, dy, dz));
+        }
+
+        /** @return Scale by (sx, sy, sz) about the origin. */
+        static Affine3D scale(double sx, double sy, double sz) {
+            return Affine3D(fossil_math_geom_affine3d_scale(sx, sy, sz));
+        }
+
+        /** @return Right-handed rotation by angle_rad about axis. */
+        static Affine3D rotate(const fossil_math_geom_point3d& axis, double angle_rad) {
+            return Affine3D(fossil_math_geom_affine3d_rotate(axis, angle_rad));
+        }
+
+        /** @return Shear; see fossil_math_geom_affine3d_shear(). */
+        static Affine3D shear(double xy, double xz, double yx, double yz, double zx, double zy) {
+            return Affine3D(fossil_math_geom_affine3d_shear(xy, xz, yx, yz, zx, zy));
+        }
+
+        /** @return The composition that applies other first, then this. */
+        Affine3D operator*(const Affine3D& other) const {
+            return Affine3D(fossil_math_geom_affine3d_compose(&m_, &other.m_));
+        }
+
+        /**
+         * Returns the inverse transform.
+         * @return Inverse.
+         * @throws std::runtime_error if the transform is singular.
+         */
+        Affine3D inverse() const {
+            Affine3D r;
+            if (fossil_math_geom_affine3d_invert(&m_, &r.m_) != 0)
+                throw std::runtime_error("Affine3D is singular");
+            return r;
+        }
+
+        /** @return The transformed point. */
+        fossil_math_geom_point3d apply(const fossil_math_geom_point3d& p) const {
+            return fossil_math_geom_affine3d_apply(&m_, p);
+        }
+
+        /** @return The transformed points. */
+        std::vector<fossil_math_geom_point3d> apply(const std::vector<fossil_math_geom_point3d>& points) const {
+            std::vector<fossil_math_geom_point3d> out(points.size());
+            fossil_math_geom_affine3d_apply_array(&m_, points.data(), out.data(), points.size());
+            return out;
+        }
+
+        /** Transforms every point of a cloud in place. */
+        void apply(PointCloud3D& cloud) const {
+            fossil_math_geom_affine3d_apply_cloud(&m_, cloud.get());
+        }
+
+        /** @return The underlying C matrix. */
+        const fossil_math_geom_affine3d& get() const { return m_; }
+
+    private:
+        fossil_math_geom_affine3d m_;
+    };
+
+    /**
+     * @class Quaternion
+     * @brief Value wrapper around fossil_math_geom_quat.
+     *
+     * Products compose right to left: (a * b).rotate(p) rotates by b first.
+     */
+    class Quaternion {
+    public:
+        Quaternion() : q_(fossil_math_geom_quat_identity()) {}
+        explicit Quaternion(const fossil_math_geom_quat& q) : q_(q) {}
+        Quaternion(double w, double x, double y, double z) : q_{w, x, y, z} {}
+
+        /** @return Rotation by angle_rad about axis. */
+        static Quaternion from_axis_angle(const fossil_math_geom_point3d& axis, double angle_rad) {
+            return Quaternion(fossil_math_geom_quat_from_axis_angle(axis, angle_rad));
+        }
+
+        /** @return The rotation part of a transform. */
+        static Quaternion from_affine(const Affine3D& a) {
+            return Quaternion(fossil_math_geom_quat_from_affine3d(&a.get()));
+        }
+
+        /** @return The rotation that applies other first, then this. */
+        Quaternion operator*(const Quaternion& other) const {
+            return Quaternion(fossil_math_geom_quat_mul(q_, other.q_));
+        }
+
+        /** @return The conjugate (inverse rotation for unit quaternions). */
+        Quaternion conjugate() const { return Quaternion(fossil_math_geom_quat_conjugate(q_)); }
+
+        /** @return This quaternion scaled to unit length. */
+        Quaternion normalized() const { return Quaternion(fossil_math_geom_quat_normalize(q_)); }
+
+        /** @return The equivalent rotation transform. */
+        Affine3D to_affine() const { return Affine3D(fossil_math_geom_quat_to_affine3d(q_)); }
+
+        /** @return The rotated point. */
+        fossil_math_geom_point3d rotate(const fossil_math_geom_point3d& p) const {
+            return fossil_math_geom_quat_rotate(q_, p);
+        }
+
+        /** @return The rotated points. */
+        std::vector<fossil_math_geom_point3d> rotate(const std::vector<fossil_math_geom_point3d>& points) const {
+            std::vector<fossil_math_geom_point3d> out(points.size());
+            fossil_math_geom_quat_rotate_array(q_, points.data(), out.data(), points.size());
+            return out;
+        }
+
+        /** Rotates every point of a cloud in place. */
+        void rotate(PointCloud3D& cloud) const { fossil_math_geom_quat_rotate_cloud(q_, cloud.get()); }
+
+        /** @return Spherical interpolation from a (t = 0) to b (t = 1). */
+        static Quaternion slerp(const Quaternion& a, const Quaternion& b, double t) {
+            return Quaternion(fossil_math_geom_quat_slerp(a.q_, b.q_, t));
+        }
+
+        /** @return Normalized linear interpolation from a (t = 0) to b (t = 1). */
+        static Quaternion nlerp(const Quaternion& a, const Quaternion& b, double t) {
+            return Quaternion(fossil_math_geom_quat_nlerp(a.q_, b.q_, t));
+        }
+
+        /**
+         * Spherically interpolates pairs of rotations.
+         * @param a Start rotations.
+         * @param b End rotations.
+         * @param t One parameter per pair.
+         * @return Interpolated rotations.
+         * @throws std::invalid_argument if the sizes differ.
+         */
+        static std::vector<fossil_math_geom_quat> slerp(const std::vector<fossil_math_geom_quat>& a,
+                                                        const std::vector<fossil_math_geom_quat>& b,
+                                                        const std::vector<double>& t) {
+            if (a.size() != b.size() || a.size() != t.size())
+                throw std::invalid_argument("Rotations and parameters must have the same size");
+            std::vector<fossil_math_geom_quat> out(a.size());
+            fossil_math_geom_quat_slerp_array(a.data(), b.data(), t.data(), out.data(), a.size());
+            return out;
+        }
+
+        /**
+         * Linearly interpolates and normalizes pairs of rotations.
+         * @param a Start rotations.
+         * @param b End rotations.
+         * @param t One parameter per pair.
+         * @return Interpolated rotations.
+         * @throws std::invalid_argument if the sizes differ.
+         */
+        static std::vector<fossil_math_geom_quat> nlerp(const std::vector<fossil_math_geom_quat>& a,
+                                                        const std::vector<fossil_math_geom_quat>& b,
+                                                        const std::vector<double>& t) {
+            if (a.size() != b.size() || a.size() != t.size())
+                throw std::invalid_argument("Rotations and parameters must have the same size");
+            std::vector<fossil_math_geom_quat> out(a.size());
+            fossil_math_geom_quat_nlerp_array(a.data(), b.data(), t.data(), out.data(), a.size());
+            return out;
+        }
+
+        /** @return The underlying C quaternion. */
+        const fossil_math_geom_quat& get() const { return q_; }
+
+    private:
+        fossil_math_geom_quat q_;
     };
 
 } // namespace math
@@ -40,10 +40,76 @@ extern "C"
 #define FOSSIL_MATH_TWO_PI (2.0 * FOSSIL_MATH_PI)
 #define FOSSIL_MATH_HALF_PI (0.5 * FOSSIL_MATH_PI)
 
+// ======================================================
+// Memory
+// ======================================================
+
+/** Alignment (in bytes) used for buffers handed to the vectorized kernels. */
+#define FOSSIL_MATH_ALIGNMENT 64
+
+// ======================================================
+// Threads
+// ======================================================
+
+/**
+ * Work callback for fossil_math_parallel_for(): processes items [begin, end).
+ */
+typedef void (*fossil_math_range_fn)(void* ctx, size_t begin, size_t end);
+
 // *****************************************************************************
 // Function prototypes
 // *****************************************************************************
 
+/**
+ * @brief Allocates a block of memory aligned to FOSSIL_MATH_ALIGNMENT bytes.
+ *
+ * @param size Number of bytes to allocate.
+ * @return Pointer to the aligned block, or NULL on failure or when size is 0.
+ *         Release it with fossil_math_aligned_free().
+ */
+void* fossil_math_aligned_alloc(size_t size);
+
+/**
+ * @brief Releases a block obtained from fossil_math_aligned_alloc().
+ *
+ * @param ptr Pointer to release (NULL is ignored).
+ */
+void fossil_math_aligned_free(void* ptr);
+
+/**
+ * @brief Sets how many threads the batch kernels may use.
+ *
+ * The default is 1, so the library never starts threads unless asked to.
+ * The setting is process-wide and not synchronized; set it before starting
+ * threads that call into the library.
+ *
+ * @param count Number of threads; 0 selects one per online processor.
+ * @return 0 on success.
+ */
+int fossil_math_set_threads(size_t count);
+
+/**
+ * @brief Returns how many threads the batch kernels may use.
+ *
+ * @return Thread count (at least 1).
+ */
+size_t fossil_math_get_threads(void);
+
+/**
+ * @brief Splits [0, n) into contiguous chunks and runs them on threads.
+ *
+ * At most fossil_math_get_threads() chunks of at least grain items are
+ * made; the caller runs the first one and threads are started for the rest,
+ * so small ranges run inline. A chunk whose thread cannot be started also
+ * runs inline. Returns once every chunk is done.
+ *
+ * @param n Number of items.
+ * @param grain Smallest number of items worth a thread of its own.
+ * @param fn Callback run once per chunk.
+ * @param ctx User context passed to fn.
+ */
+void fossil_math_parallel_for(size_t n, size_t grain, fossil_math_range_fn fn, void* ctx);
+
 // draft hash algorithm
 
 #ifdef __cplusplus
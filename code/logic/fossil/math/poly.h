@@ -0,0 +1,305 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_POLY_H
+#define FOSSIL_MATH_POLY_H
+
+#include "math.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ======================================================
+// Structures
+// ======================================================
+
+/**
+ * Opaque precompiled polynomial.
+ *
+ * Coefficients are copied into aligned, zero-padded storage at creation and
+ * the evaluation scheme is chosen once from the degree. Derivative
+ * coefficients are built lazily and cached inside the object.
+ */
+typedef struct fossil_math_poly fossil_math_poly;
+
+/** Evaluation scheme picked by fossil_math_poly_create(). */
+typedef enum {
+    FOSSIL_MATH_POLY_HORNER = 0, /**< Plain Horner, used for low degrees. */
+    FOSSIL_MATH_POLY_ESTRIN = 1  /**< Blocked Estrin, used for high degrees. */
+} fossil_math_poly_scheme;
+
+// *****************************************************************************
+// Function prototypes
+// *****************************************************************************
+
+/**
+ * @brief Creates a polynomial object from its coefficients.
+ *
+ * @param coeffs Pointer to the coefficients (coeffs[0] is constant term).
+ * @param degree Degree of the polynomial.
+ * @return New polynomial, or NULL on failure. Release with fossil_math_poly_destroy().
+ */
+fossil_math_poly* fossil_math_poly_create(const double* coeffs, size_t degree);
+
+/**
+ * @brief Destroys a polynomial object and its cached derivatives.
+ *
+ * @param poly Polynomial to destroy (NULL is ignored).
+ */
+void fossil_math_poly_destroy(fossil_math_poly* poly);
+
+/**
+ * @brief Returns the degree of the polynomial.
+ *
+ * @param poly Polynomial object.
+ * @return Degree given at creation.
+ */
+size_t fossil_math_poly_degree(const fossil_math_poly* poly);
+
+/**
+ * @brief Returns the evaluation scheme selected for the polynomial.
+ *
+ * @param poly Polynomial object.
+ * @return FOSSIL_MATH_POLY_HORNER or FOSSIL_MATH_POLY_ESTRIN.
+ */
+fossil_math_poly_scheme fossil_math_poly_get_scheme(const fossil_math_poly* poly);
+
+/**
+ * @brief Returns the aligned coefficient storage of the polynomial.
+ *
+ * @param poly Polynomial object.
+ * @return Pointer to degree + 1 coefficients (constant term first).
+ */
+const double* fossil_math_poly_coeffs(const fossil_math_poly* poly);
+
+/**
+ * @brief Builds and caches the derivative chain up to a given order.
+ *
+ * Derivatives are otherwise built on first use, which mutates the object.
+ * Call this once before sharing the polynomial between threads.
+ *
+ * @param poly Polynomial object.
+ * @param order Highest derivative order to build.
+ * @return 0 on success, non-zero on failure.
+ */
+int fossil_math_poly_prepare(fossil_math_poly* poly, size_t order);
+
+/**
+ * @brief Returns the cached coefficients of a derivative, building it if needed.
+ *
+ * @param poly Polynomial object.
+ * @param order Derivative order (0 returns the polynomial itself).
+ * @param degree Optional pointer to store the degree of the derivative.
+ * @return Pointer to the derivative coefficients, or NULL on failure.
+ */
+const double* fossil_math_poly_derivative(fossil_math_poly* poly, size_t order, size_t* degree);
+
+/**
+ * @brief Evaluates the polynomial at x.
+ *
+ * @param poly Polynomial object.
+ * @param x Value at which to evaluate.
+ * @return The evaluated value.
+ */
+double fossil_math_poly_eval(const fossil_math_poly* poly, double x);
+
+/**
+ * @brief Evaluates a derivative of the polynomial at x using the cached chain.
+ *
+ * @param poly Polynomial object.
+ * @param order Derivative order.
+ * @param x Value at which to evaluate.
+ * @return The evaluated derivative (NaN if the derivative could not be built).
+ */
+double fossil_math_poly_eval_derivative(fossil_math_poly* poly, size_t order, double x);
+
+/**
+ * @brief Evaluates the value and the first k derivatives at x in a single pass.
+ *
+ * @param poly Polynomial object.
+ * @param x Value at which to evaluate.
+ * @param k Number of derivatives to compute.
+ * @param out Array of k + 1 values; out[i] receives the i-th derivative.
+ * @return 0 on success, non-zero on failure.
+ */
+int fossil_math_poly_eval_derivs(const fossil_math_poly* poly, double x, size_t k, double* out);
+
+/**
+ * @brief Evaluates the polynomial at every element of an array.
+ *
+ * @param poly Polynomial object.
+ * @param x Pointer to the input values.
+ * @param out Pointer to the output values (may alias x).
+ * @param n Number of elements.
+ */
+void fossil_math_poly_eval_array(const fossil_math_poly* poly, const double* x, double* out, size_t n);
+
+/**
+ * @brief Finds a root with Newton's method, one fused evaluation per step.
+ *
+ * @param poly Polynomial object.
+ * @param x0 Initial guess.
+ * @param tol Convergence tolerance on the step size.
+ * @param max_iter Maximum number of iterations.
+ * @param root Pointer to store the last iterate.
+ * @return 0 on convergence, -1 on invalid input, -2 on a zero derivative,
+ *         -3 if max_iter was reached.
+ */
+int fossil_math_poly_newton(const fossil_math_poly* poly, double x0, double tol,
+                            size_t max_iter, double* root);
+
+#ifdef __cplusplus
+}
+#include <stdexcept>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+namespace math {
+
+    /**
+     * @class Polynomial
+     * @brief RAII owner of a precompiled fossil_math_poly object.
+     *
+     * The wrapper is move-only; the underlying object is destroyed with the wrapper.
+     */
+    class Polynomial {
+    public:
+        /**
+         * Creates a polynomial from a coefficient vector.
+         * @param coeffs Coefficient vector (coeffs[0] is constant term).
+         * @throws std::invalid_argument if the vector is empty.
+         * @throws std::runtime_error if allocation fails.
+         */
+        explicit Polynomial(const std::vector<double>& coeffs) {
+            if (coeffs.empty())
+                throw std::invalid_argument("Polynomial needs at least one coefficient");
+            poly_ = fossil_math_poly_create(coeffs.data(), coeffs.size() - 1);
+            if (!poly_)
+                throw std::runtime_error("Polynomial creation failed");
+        }
+
+        ~Polynomial() { fossil_math_poly_destroy(poly_); }
+
+        Polynomial(const Polynomial&) = delete;
+        Polynomial& operator=(const Polynomial&) = delete;
+
+        Polynomial(Polynomial&& other) noexcept : poly_(other.poly_) { other.poly_ = nullptr; }
+
+        Polynomial& operator=(Polynomial&& other) noexcept {
+            if (this != &other) {
+                fossil_math_poly_destroy(poly_);
+                poly_ = other.poly_;
+                other.poly_ = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * Returns the degree of the polynomial.
+         * @return Degree.
+         */
+        size_t degree() const { return fossil_math_poly_degree(poly_); }
+
+        /**
+         * Evaluates the polynomial.
+         * @param x Value at which to evaluate.
+         * @return Evaluated value.
+         */
+        double operator()(double x) const { return fossil_math_poly_eval(poly_, x); }
+
+        /**
+         * Evaluates the polynomial over a vector of values.
+         * @param x Input values.
+         * @return Evaluated values.
+         */
+        std::vector<double> eval(const std::vector<double>& x) const {
+            std::vector<double> out(x.size());
+            fossil_math_poly_eval_array(poly_, x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * Evaluates the value and the first k derivatives in a single pass.
+         * @param x Value at which to evaluate.
+         * @param k Number of derivatives.
+         * @return Vector of k + 1 values, derivative order as index.
+         * @throws std::runtime_error if evaluation fails.
+         */
+        std::vector<double> derivs(double x, size_t k) const {
+            std::vector<double> out(k + 1);
+            if (fossil_math_poly_eval_derivs(poly_, x, k, out.data()) != 0)
+                throw std::runtime_error("Polynomial derivative evaluation failed");
+            return out;
+        }
+
+        /**
+         * Returns the coefficients of a derivative from the cached chain.
+         * @param order Derivative order.
+         * @return Coefficient vector of the derivative.
+         * @throws std::runtime_error if the derivative could not be built.
+         */
+        std::vector<double> derivative(size_t order) {
+            size_t deg = 0;
+            const double* d = fossil_math_poly_derivative(poly_, order, &deg);
+            if (!d)
+                throw std::runtime_error("Polynomial derivative failed");
+            return std::vector<double>(d, d + deg + 1);
+        }
+
+        /**
+         * Finds a root with Newton's method.
+         * @param x0 Initial guess.
+         * @param tol Convergence tolerance.
+         * @param max_iter Maximum number of iterations.
+         * @return The root.
+         * @throws std::runtime_error if the iteration does not converge.
+         */
+        double newton(double x0, double tol = 1e-12, size_t max_iter = 64) const {
+            double root = 0.0;
+            if (fossil_math_poly_newton(poly_, x0, tol, max_iter, &root) != 0)
+                throw std::runtime_error("Newton iteration did not converge");
+            return root;
+        }
+
+        /**
+         * Returns the underlying C handle.
+         * @return Polynomial handle.
+         */
+        fossil_math_poly* handle() const { return poly_; }
+
+    private:
+        fossil_math_poly* poly_ = nullptr;
+    };
+
+} // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_POLY_H */
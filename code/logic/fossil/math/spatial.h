@@ -0,0 +1,1245 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_SPATIAL_H
+#define FOSSIL_MATH_SPATIAL_H
+
+#include "geom.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+// ======================================================
+// Structures
+// ======================================================
+
+/**
+ * Opaque k-d tree over a fixed set of 2D or 3D points.
+ *
+ * The points are copied in at creation, so the input array may be released
+ * afterwards. The tree is read-only after creation and may be queried from
+ * many threads at once.
+ */
+typedef struct fossil_math_spatial_kdtree fossil_math_spatial_kdtree;
+
+/**
+ * Opaque uniform grid (spatial hash) over a changing set of 2D or 3D points.
+ *
+ * Points are keyed by caller ids in [0, capacity). Cells are cubes of a
+ * fixed edge length hashed into a table, so the grid is unbounded. Updates
+ * must not run concurrently with anything else; queries may run in parallel.
+ */
+typedef struct fossil_math_spatial_grid fossil_math_spatial_grid;
+
+/**
+ * Opaque bounding-volume hierarchy over 3D triangles.
+ */
+typedef struct fossil_math_spatial_bvh fossil_math_spatial_bvh;
+
+// Ray origin + t * dir for t >= 0; dir need not be normalized.
+typedef struct {
+    fossil_math_geom_point3d origin;
+    fossil_math_geom_point3d dir;
+} fossil_math_spatial_ray;
+
+// Ray hit at origin + t * dir = (1 - u - v) * v0 + u * v1 + v * v2 of the
+// given triangle. Misses have t = INFINITY and triangle = SIZE_MAX.
+typedef struct {
+    double t;
+    double u;
+    double v;
+    size_t triangle;
+} fossil_math_spatial_hit;
+
+// Closest mesh point to a query.
+typedef struct {
+    fossil_math_geom_point3d point;
+    double dist_sq;
+    size_t triangle;
+} fossil_math_spatial_nearest;
+
+/**
+ * Space-filling curve used to order points.
+ */
+typedef enum {
+    FOSSIL_MATH_SPATIAL_MORTON = 0,
+    FOSSIL_MATH_SPATIAL_HILBERT = 1
+} fossil_math_spatial_curve;
+
+// *****************************************************************************
+// Function prototypes
+// *****************************************************************************
+
+/** 
+ * ======================================================
+ * k-d tree
+ * ======================================================
+ */
+
+// Queries report squared distances and the index of each point in the array
+// the tree was built from. Distances compare with <=, so points exactly on a
+// query radius are included. k-NN results are the k smallest
+// (distance, index) pairs in ascending order, so ties resolve to the lower
+// index and the answer matches a brute-force scan exactly.
+
+/**
+ * @brief Builds a k-d tree over 2D points.
+ *
+ * Nodes are split at the median of their widest axis and stored in a flat
+ * array; leaves hold up to 16 points whose coordinates are contiguous. Large
+ * builds use the fossil_math_set_threads() threads.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @return New tree, or NULL on failure. Release with fossil_math_spatial_kdtree_destroy().
+ */
+fossil_math_spatial_kdtree* fossil_math_spatial_kdtree_create2d(const fossil_math_geom_point2d* points, size_t n);
+
+/**
+ * @brief Builds a k-d tree over 3D points.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @return New tree, or NULL on failure. Release with fossil_math_spatial_kdtree_destroy().
+ */
+fossil_math_spatial_kdtree* fossil_math_spatial_kdtree_create3d(const fossil_math_geom_point3d* points, size_t n);
+
+/**
+ * @brief Destroys a k-d tree.
+ *
+ * @param tree Tree to destroy (NULL is ignored).
+ */
+void fossil_math_spatial_kdtree_destroy(fossil_math_spatial_kdtree* tree);
+
+/**
+ * @brief Returns the number of points in a tree.
+ *
+ * @param tree The tree.
+ * @return Number of points.
+ */
+size_t fossil_math_spatial_kdtree_size(const fossil_math_spatial_kdtree* tree);
+
+/**
+ * @brief Returns the dimension of a tree.
+ *
+ * @param tree The tree.
+ * @return 2 or 3.
+ */
+size_t fossil_math_spatial_kdtree_dims(const fossil_math_spatial_kdtree* tree);
+
+/**
+ * @brief Finds the k nearest points to a 2D query.
+ *
+ * @param tree A 2D tree.
+ * @param q The query point.
+ * @param k Number of neighbours wanted.
+ * @param indices Pointer to k output indices, nearest first.
+ * @param dist_sq Pointer to k output squared distances.
+ * @return Number of neighbours found, min(k, size); slots past it hold
+ *         SIZE_MAX and infinity.
+ */
+size_t fossil_math_spatial_kdtree_knn2d(const fossil_math_spatial_kdtree* tree, fossil_math_geom_point2d q,
+                                        size_t k, size_t* indices, double* dist_sq);
+
+/**
+ * @brief Finds the k nearest points to a 3D query.
+ *
+ * @param tree A 3D tree.
+ * @param q The query point.
+ * @param k Number of neighbours wanted.
+ * @param indices Pointer to k output indices, nearest first.
+ * @param dist_sq Pointer to k output squared distances.
+ * @return Number of neighbours found, min(k, size); slots past it hold
+ *         SIZE_MAX and infinity.
+ */
+size_t fossil_math_spatial_kdtree_knn3d(const fossil_math_spatial_kdtree* tree, fossil_math_geom_point3d q,
+                                        size_t k, size_t* indices, double* dist_sq);
+
+/**
+ * @brief Finds every point within a radius of a 2D query.
+ *
+ * @param tree A 2D tree.
+ * @param q The query point.
+ * @param radius Search radius.
+ * @param indices Pointer to room for max indices, written in no particular order.
+ * @param max Capacity of indices.
+ * @return Total number of points in range, which may exceed max.
+ */
+size_t fossil_math_spatial_kdtree_radius2d(const fossil_math_spatial_kdtree* tree, fossil_math_geom_point2d q,
+                                           double radius, size_t* indices, size_t max);
+
+/**
+ * @brief Finds every point within a radius of a 3D query.
+ *
+ * @param tree A 3D tree.
+ * @param q The query point.
+ * @param radius Search radius.
+ * @param indices Pointer to room for max indices, written in no particular order.
+ * @param max Capacity of indices.
+ * @return Total number of points in range, which may exceed max.
+ */
+size_t fossil_math_spatial_kdtree_radius3d(const fossil_math_spatial_kdtree* tree, fossil_math_geom_point3d q,
+                                           double radius, size_t* indices, size_t max);
+
+/**
+ * @brief Runs k-NN for many 2D queries across the fossil_math_set_threads() threads.
+ *
+ * @param tree A 2D tree.
+ * @param queries Pointer to the query points.
+ * @param m Number of queries.
+ * @param k Number of neighbours per query.
+ * @param indices Pointer to m rows of k output indices.
+ * @param dist_sq Pointer to m rows of k output squared distances.
+ */
+void fossil_math_spatial_kdtree_knn2d_batch(const fossil_math_spatial_kdtree* tree, const fossil_math_geom_point2d* queries,
+                                            size_t m, size_t k, size_t* indices, double* dist_sq);
+
+/**
+ * @brief Runs k-NN for many 3D queries across the fossil_math_set_threads() threads.
+ *
+ * @param tree A 3D tree.
+ * @param queries Pointer to the query points.
+ * @param m Number of queries.
+ * @param k Number of neighbours per query.
+ * @param indices Pointer to m rows of k output indices.
+ * @param dist_sq Pointer to m rows of k output squared distances.
+ */
+void fossil_math_spatial_kdtree_knn3d_batch(const fossil_math_spatial_kdtree* tree, const fossil_math_geom_point3d* queries,
+                                            size_t m, size_t k, size_t* indices, double* dist_sq);
+
+/**
+ * @brief Counts the points within a radius of many 2D queries across threads.
+ *
+ * @param tree A 2D tree.
+ * @param queries Pointer to the query points.
+ * @param m Number of queries.
+ * @param radius Search radius.
+ * @param counts Pointer to m output counts.
+ */
+void fossil_math_spatial_kdtree_radius_count2d_batch(const fossil_math_spatial_kdtree* tree,
+                                                     const fossil_math_geom_point2d* queries, size_t m,
+                                                     double radius, size_t* counts);
+
+/**
+ * @brief Counts the points within a radius of many 3D queries across threads.
+ *
+ * @param tree A 3D tree.
+ * @param queries Pointer to the query points.
+ * @param m Number of queries.
+ * @param radius Search radius.
+ * @param counts Pointer to m output counts.
+ */
+void fossil_math_spatial_kdtree_radius_count3d_batch(const fossil_math_spatial_kdtree* tree,
+                                                     const fossil_math_geom_point3d* queries, size_t m,
+                                                     double radius, size_t* counts);
+
+/** 
+ * ======================================================
+ * Uniform grid
+ * ======================================================
+ */
+
+// Insert, remove and move are O(1): points live in a dense slot array linked
+// into per-cell lists. Updates scatter the lists over memory; rebuild()
+// counting-sorts the slots by cell so each cell is contiguous again. Radius
+// queries visit every cell the query box touches, so a cell edge near the
+// typical query radius works best. Radius comparisons use <=.
+
+/**
+ * @brief Creates an empty grid.
+ *
+ * @param dims 2 or 3.
+ * @param cell_size Cell edge length (positive and finite).
+ * @param capacity Largest number of points; ids range over [0, capacity).
+ * @return New grid, or NULL on invalid arguments or allocation failure.
+ *         Release with fossil_math_spatial_grid_destroy().
+ */
+fossil_math_spatial_grid* fossil_math_spatial_grid_create(size_t dims, double cell_size, size_t capacity);
+
+/**
+ * @brief Destroys a grid.
+ *
+ * @param grid Grid to destroy (NULL is ignored).
+ */
+void fossil_math_spatial_grid_destroy(fossil_math_spatial_grid* grid);
+
+/**
+ * @brief Returns the number of points in a grid.
+ *
+ * @param grid The grid.
+ * @return Number of points.
+ */
+size_t fossil_math_spatial_grid_size(const fossil_math_spatial_grid* grid);
+
+/**
+ * @brief Replaces the contents of a 2D grid with points 0 .. n-1 and rebuilds it.
+ *
+ * @param grid A 2D grid.
+ * @param points Pointer to the points; point i gets id i.
+ * @param n Number of points (at most the capacity).
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_math_spatial_grid_assign2d(fossil_math_spatial_grid* grid, const fossil_math_geom_point2d* points, size_t n);
+
+/**
+ * @brief Replaces the contents of a 3D grid with points 0 .. n-1 and rebuilds it.
+ *
+ * @param grid A 3D grid.
+ * @param points Pointer to the points; point i gets id i.
+ * @param n Number of points (at most the capacity).
+ * @return 0 on success, -1 on invalid arguments.
+ */
+int fossil_math_spatial_grid_assign3d(fossil_math_spatial_grid* grid, const fossil_math_geom_point3d* points, size_t n);
+
+/**
+ * @brief Sorts the points by cell so every cell is contiguous in memory.
+ *
+ * A parallel counting sort over the fossil_math_set_threads() threads.
+ *
+ * @param grid The grid.
+ * @return 0 on success, -1 on allocation failure (the grid is unchanged).
+ */
+int fossil_math_spatial_grid_rebuild(fossil_math_spatial_grid* grid);
+
+/**
+ * @brief Inserts a 2D point.
+ *
+ * @param grid A 2D grid.
+ * @param id Point id, below the capacity and not already present.
+ * @param p The point.
+ * @return 0 on success, -1 on an invalid or present id.
+ */
+int fossil_math_spatial_grid_insert2d(fossil_math_spatial_grid* grid, size_t id, fossil_math_geom_point2d p);
+
+/**
+ * @brief Inserts a 3D point.
+ *
+ * @param grid A 3D grid.
+ * @param id Point id, below the capacity and not already present.
+ * @param p The point.
+ * @return 0 on success, -1 on an invalid or present id.
+ */
+int fossil_math_spatial_grid_insert3d(fossil_math_spatial_grid* grid, size_t id, fossil_math_geom_point3d p);
+
+/**
+ * @brief Moves a 2D point to a new position.
+ *
+ * @param grid A 2D grid.
+ * @param id Id of a present point.
+ * @param p The new position.
+ * @return 0 on success, -1 if the id is not present.
+ */
+int fossil_math_spatial_grid_move2d(fossil_math_spatial_grid* grid, size_t id, fossil_math_geom_point2d p);
+
+/**
+ * @brief Moves a 3D point to a new position.
+ *
+ * @param grid A 3D grid.
+ * @param id Id of a present point.
+ * @param p The new position.
+ * @return 0 on success, -1 if the id is not present.
+ */
+int fossil_math_spatial_grid_move3d(fossil_math_spatial_grid* grid, size_t id, fossil_math_geom_point3d p);
+
+/**
+ * @brief Removes a point.
+ *
+ * @param grid The grid.
+ * @param id Id of a present point.
+ * @return 0 on success, -1 if the id is not present.
+ */
+int fossil_math_spatial_grid_remove(fossil_math_spatial_grid* grid, size_t id);
+
+/**
+ * @brief Tests whether an id is present.
+ *
+ * @param grid The grid.
+ * @param id Point id.
+ * @return 1 if present, 0 otherwise.
+ */
+int fossil_math_spatial_grid_contains(const fossil_math_spatial_grid* grid, size_t id);
+
+/**
+ * @brief Finds the ids of every point within a radius of a 2D query.
+ *
+ * @param grid A 2D grid.
+ * @param q The query point.
+ * @param radius Search radius.
+ * @param ids Pointer to room for max ids, written in no particular order.
+ * @param max Capacity of ids.
+ * @return Total number of points in range, which may exceed max.
+ */
+size_t fossil_math_spatial_grid_radius2d(const fossil_math_spatial_grid* grid, fossil_math_geom_point2d q,
+                                         double radius, size_t* ids, size_t max);
+
+/**
+ * @brief Finds the ids of every point within a radius of a 3D query.
+ *
+ * @param grid A 3D grid.
+ * @param q The query point.
+ * @param radius Search radius.
+ * @param ids Pointer to room for max ids, written in no particular order.
+ * @param max Capacity of ids.
+ * @return Total number of points in range, which may exceed max.
+ */
+size_t fossil_math_spatial_grid_radius3d(const fossil_math_spatial_grid* grid, fossil_math_geom_point3d q,
+                                         double radius, size_t* ids, size_t max);
+
+/**
+ * @brief Counts the points within a radius of many 2D queries across threads.
+ *
+ * @param grid A 2D grid.
+ * @param queries Pointer to the query points.
+ * @param m Number of queries.
+ * @param radius Search radius.
+ * @param counts Pointer to m output counts.
+ */
+void fossil_math_spatial_grid_radius_count2d_batch(const fossil_math_spatial_grid* grid,
+                                                   const fossil_math_geom_point2d* queries, size_t m,
+                                                   double radius, size_t* counts);
+
+/**
+ * @brief Counts the points within a radius of many 3D queries across threads.
+ *
+ * @param grid A 3D grid.
+ * @param queries Pointer to the query points.
+ * @param m Number of queries.
+ * @param radius Search radius.
+ * @param counts Pointer to m output counts.
+ */
+void fossil_math_spatial_grid_radius_count3d_batch(const fossil_math_spatial_grid* grid,
+                                                   const fossil_math_geom_point3d* queries, size_t m,
+                                                   double radius, size_t* counts);
+
+/** 
+ * ======================================================
+ * Triangle BVH
+ * ======================================================
+ */
+
+// Nodes are binned-SAH splits stored depth-first, with the left child right
+// after its parent. Ray hits are closest-first, two-sided, and include
+// t = t_max; equal t go to the lowest triangle index, so single and batched
+// queries agree exactly.
+
+/**
+ * @brief Builds a BVH over a triangle mesh.
+ *
+ * Large meshes are built across the fossil_math_set_threads() threads.
+ *
+ * @param vertices Pointer to the vertices.
+ * @param vertex_count Number of vertices.
+ * @param indices Pointer to 3 * triangle_count vertex indices, or NULL to
+ *                read triangle i from vertices 3i, 3i + 1 and 3i + 2.
+ * @param triangle_count Number of triangles (0 builds an empty BVH).
+ * @return New BVH, or NULL on an out-of-range index or allocation failure.
+ *         Release with fossil_math_spatial_bvh_destroy().
+ */
+fossil_math_spatial_bvh* fossil_math_spatial_bvh_create(const fossil_math_geom_point3d* vertices, size_t vertex_count,
+                                                        const size_t* indices, size_t triangle_count);
+
+/**
+ * @brief Destroys a BVH.
+ *
+ * @param bvh BVH to destroy (NULL is ignored).
+ */
+void fossil_math_spatial_bvh_destroy(fossil_math_spatial_bvh* bvh);
+
+/**
+ * @brief Returns the number of triangles in a BVH.
+ *
+ * @param bvh The BVH.
+ * @return Number of triangles.
+ */
+size_t fossil_math_spatial_bvh_size(const fossil_math_spatial_bvh* bvh);
+
+/**
+ * @brief Finds the closest triangle hit by a ray.
+ *
+ * @param bvh The BVH.
+ * @param ray The ray.
+ * @param t_max Largest accepted t (INFINITY for no limit).
+ * @param hit Receives the hit, or a miss.
+ * @return 1 on a hit, 0 on a miss.
+ */
+int fossil_math_spatial_bvh_intersect(const fossil_math_spatial_bvh* bvh, fossil_math_spatial_ray ray, double t_max,
+                                      fossil_math_spatial_hit* hit);
+
+/**
+ * @brief Traces many rays, packets of neighbours together, across threads.
+ *
+ * Consecutive rays travel as one packet, so coherent rays (such as the rays
+ * of one image tile) should be adjacent.
+ *
+ * @param bvh The BVH.
+ * @param rays Pointer to the rays.
+ * @param m Number of rays.
+ * @param t_max Largest accepted t for every ray.
+ * @param hits Pointer to m output hits.
+ * @return Number of rays that hit.
+ */
+size_t fossil_math_spatial_bvh_intersect_batch(const fossil_math_spatial_bvh* bvh, const fossil_math_spatial_ray* rays,
+                                               size_t m, double t_max, fossil_math_spatial_hit* hits);
+
+/**
+ * @brief Finds the closest point of the mesh to a query point.
+ *
+ * Equal distances go to the lowest triangle index.
+ *
+ * @param bvh The BVH.
+ * @param p The query point.
+ * @param out Receives the closest point, its squared distance and triangle.
+ * @return 0 on success, -1 if the BVH is empty.
+ */
+int fossil_math_spatial_bvh_closest(const fossil_math_spatial_bvh* bvh, fossil_math_geom_point3d p,
+                                    fossil_math_spatial_nearest* out);
+
+/**
+ * @brief Finds the triangles that intersect a closed box.
+ *
+ * @param bvh The BVH.
+ * @param box The box.
+ * @param triangles Pointer to room for max triangle indices, in no particular order.
+ * @param max Capacity of triangles.
+ * @return Total number of intersecting triangles, which may exceed max.
+ */
+size_t fossil_math_spatial_bvh_overlap(const fossil_math_spatial_bvh* bvh, fossil_math_geom_aabb3d box,
+                                       size_t* triangles, size_t max);
+
+/** 
+ * ======================================================
+ * Space-filling curves
+ * ======================================================
+ */
+
+// Sorting points by their position along a Morton (Z-order) or Hilbert curve
+// puts points that are close in space close in memory. Keys interleave 32
+// bits per axis in 2D and 21 bits per axis in 3D; x is the least significant
+// axis of a Morton key. Hilbert keys cost more to compute but never jump
+// between distant cells, which gives slightly better locality.
+
+/**
+ * @brief Interleaves two 32-bit coordinates into a 2D Morton key.
+ *
+ * @param x Cell x coordinate.
+ * @param y Cell y coordinate.
+ * @return Key with bit i of x at bit 2i and bit i of y at bit 2i + 1.
+ */
+uint64_t fossil_math_spatial_morton2d(uint32_t x, uint32_t y);
+
+/**
+ * @brief Interleaves three 21-bit coordinates into a 3D Morton key.
+ *
+ * @param x Cell x coordinate (bits above 21 are ignored).
+ * @param y Cell y coordinate (bits above 21 are ignored).
+ * @param z Cell z coordinate (bits above 21 are ignored).
+ * @return Key with bit i of x, y, z at bits 3i, 3i + 1, 3i + 2.
+ */
+uint64_t fossil_math_spatial_morton3d(uint32_t x, uint32_t y, uint32_t z);
+
+/**
+ * @brief Returns the position of a cell along the 2D Hilbert curve over a
+ *        2^32 x 2^32 grid, starting at cell (0, 0).
+ *
+ * @param x Cell x coordinate.
+ * @param y Cell y coordinate.
+ * @return Hilbert index.
+ */
+uint64_t fossil_math_spatial_hilbert2d(uint32_t x, uint32_t y);
+
+/**
+ * @brief Returns the position of a cell along the 3D Hilbert curve over a
+ *        2^21 x 2^21 x 2^21 grid, starting at cell (0, 0, 0).
+ *
+ * @param x Cell x coordinate (bits above 21 are ignored).
+ * @param y Cell y coordinate (bits above 21 are ignored).
+ * @param z Cell z coordinate (bits above 21 are ignored).
+ * @return Hilbert index.
+ */
+uint64_t fossil_math_spatial_hilbert3d(uint32_t x, uint32_t y, uint32_t z);
+
+/**
+ * @brief Computes curve keys for an array of 2D points.
+ *
+ * The box is divided into 2^32 cells per axis. Points outside the box fall
+ * into the nearest border cell, NaN coordinates into cell 0, and a flat or
+ * unbounded axis puts every point in cell 0 of that axis.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @param box Box to quantize over, usually fossil_math_geom_aabb2d_from_points().
+ * @param curve Curve to follow.
+ * @param keys Pointer to n output keys.
+ */
+void fossil_math_spatial_curve_keys2d(const fossil_math_geom_point2d* points, size_t n, fossil_math_geom_aabb2d box,
+                                      fossil_math_spatial_curve curve, uint64_t* keys);
+
+/**
+ * @brief Computes curve keys for an array of 3D points.
+ *
+ * The box is divided into 2^21 cells per axis, otherwise as for
+ * fossil_math_spatial_curve_keys2d().
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @param box Box to quantize over, usually fossil_math_geom_aabb3d_from_points().
+ * @param curve Curve to follow.
+ * @param keys Pointer to n output keys.
+ */
+void fossil_math_spatial_curve_keys3d(const fossil_math_geom_point3d* points, size_t n, fossil_math_geom_aabb3d box,
+                                      fossil_math_spatial_curve curve, uint64_t* keys);
+
+/**
+ * @brief Sorts 64-bit keys in ascending order and records the permutation.
+ *
+ * A stable LSD radix sort; large arrays use the fossil_math_set_threads()
+ * threads. Byte positions where all keys agree are skipped.
+ *
+ * @param keys Pointer to the n keys, sorted in place.
+ * @param order Pointer to n outputs; order[i] receives the original position
+ *              of the i-th sorted key.
+ * @param n Number of keys.
+ * @return 0 on success, -1 on allocation failure (keys are left unchanged).
+ */
+int fossil_math_spatial_radix_sort(uint64_t* keys, size_t* order, size_t n);
+
+/**
+ * @brief Reorders an array of fixed-size elements: dst[i] = src[order[i]].
+ *
+ * Use it to carry payload arrays along with points sorted by
+ * fossil_math_spatial_curve_sort2d() or fossil_math_spatial_radix_sort().
+ *
+ * @param src Pointer to the source elements.
+ * @param size Size of one element in bytes.
+ * @param order Pointer to n source positions.
+ * @param n Number of elements written.
+ * @param dst Pointer to n output elements; must not overlap src.
+ */
+void fossil_math_spatial_gather(const void* src, size_t size, const size_t* order, size_t n, void* dst);
+
+/**
+ * @brief Sorts 2D points in place along a curve over their bounding box.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @param curve Curve to follow.
+ * @param order Pointer to n outputs receiving the original position of each
+ *              sorted point (for fossil_math_spatial_gather()), or NULL.
+ * @return 0 on success, -1 on allocation failure (points are left unchanged).
+ */
+int fossil_math_spatial_curve_sort2d(fossil_math_geom_point2d* points, size_t n, fossil_math_spatial_curve curve,
+                                     size_t* order);
+
+/**
+ * @brief Sorts 3D points in place along a curve over their bounding box.
+ *
+ * @param points Pointer to the points.
+ * @param n Number of points.
+ * @param curve Curve to follow.
+ * @param order Pointer to n outputs receiving the original position of each
+ *              sorted point, or NULL.
+ * @return 0 on success, -1 on allocation failure (points are left unchanged).
+ */
+int fossil_math_spatial_curve_sort3d(fossil_math_geom_point3d* points, size_t n, fossil_math_spatial_curve curve,
+                                     size_t* order);
+
+#ifdef __cplusplus
+}
+#include <stdexcept>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#include <string>
+
+namespace fossil {
+
+namespace math {
+
+    /**
+     * @class KdTree
+     * @brief RAII owner of a fossil_math_spatial_kdtree.
+     *
+     * The wrapper is move-only; the underlying tree is destroyed with the wrapper.
+     */
+    class KdTree {
+    public:
+        /** Neighbours of one query, nearest first. */
+        struct Neighbors {
+            std::vector<size_t> indices;
+            std::vector<double> dist_sq;
+        };
+
+        /**
+         * Builds a tree over 2D points.
+         * @param points Points to index.
+         * @throws std::runtime_error if the build fails.
+         */
+        explicit KdTree(const std::vector<fossil_math_geom_point2d>& points)
+            : tree_(fossil_math_spatial_kdtree_create2d(points.data(), points.size())) {
+            if (!tree_)
+                throw std::runtime_error("KdTree build failed");
+        }
+
+        /**
+         * Builds a tree over 3D points.
+         * @param points Points to index.
+         * @throws std::runtime_error if the build fails.
+         */
+        explicit KdTree(const std::vector<fossil_math_geom_point3d>& points)
+            : tree_(fossil_math_spatial_kdtree_create3d(points.data(), points.size())) {
+            if (!tree_)
+                throw std::runtime_error("KdTree build failed");
+        }
+
+        ~KdTree() { fossil_math_spatial_kdtree_destroy(tree_); }
+
+        KdTree(const KdTree&) = delete;
+        KdTree& operator=(const KdTree&) = delete;
+
+        KdTree(KdTree&& other) noexcept : tree_(other.tree_) { other.tree_ = nullptr; }
+
+        KdTree& operator=(KdTree&& other) noexcept {
+            if (this != &other) {
+                fossil_math_spatial_kdtree_destroy(tree_);
+                tree_ = other.tree_;
+                other.tree_ = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * Returns the number of points.
+         * @return Number of points.
+         */
+        size_t size() const { return fossil_math_spatial_kdtree_size(tree_); }
+
+        /**
+         * Returns the dimension of the tree.
+         * @return 2 or 3.
+         */
+        size_t dims() const { return fossil_math_spatial_kdtree_dims(tree_); }
+
+        /**
+         * Finds the k nearest points to a 2D query.
+         * @param q Query point.
+         * @param k Number of neighbours.
+         * @return Up to k neighbours, nearest first.
+         * @throws std::invalid_argument if the tree is not 2D.
+         */
+        Neighbors knn(const fossil_math_geom_point2d& q, size_t k) const {
+            require(2);
+            Neighbors out{std::vector<size_t>(k), std::vector<double>(k)};
+            size_t found = fossil_math_spatial_kdtree_knn2d(tree_, q, k, out.indices.data(), out.dist_sq.data());
+            out.indices.resize(found);
+            out.dist_sq.resize(found);
+            return out;
+        }
+
+        /**
+         * Finds the k nearest points to a 3D query.
+         * @param q Query point.
+         * @param k Number of neighbours.
+         * @return Up to k neighbours, nearest first.
+         * @throws std::invalid_argument if the tree is not 3D.
+         */
+        Neighbors knn(const fossil_math_geom_point3d& q, size_t k) const {
+            require(3);
+            Neighbors out{std::vector<size_t>(k), std::vector<double>(k)};
+            size_t found = fossil_math_spatial_kdtree_knn3d(tree_, q, k, out.indices.data(), out.dist_sq.data());
+            out.indices.resize(found);
+            out.dist_sq.resize(found);
+            return out;
+        }
+
+        /**
+         * Finds every point within a radius of a 2D query.
+         * @param q Query point.
+         * @param radius Search radius.
+         * @return Indices of the points in range, in no particular order.
+         * @throws std::invalid_argument if the tree is not 2D.
+         */
+        std::vector<size_t> radius(const fossil_math_geom_point2d& q, double radius) const {
+            require(2);
+            std::vector<size_t> out(64);
+            size_t found;
+            while ((found = fossil_math_spatial_kdtree_radius2d(tree_, q, radius, out.data(), out.size())) > out.size())
+                out.resize(found);
+            out.resize(found);
+            return out;
+        }
+
+        /**
+         * Finds every point within a radius of a 3D query.
+         * @param q Query point.
+         * @param radius Search radius.
+         * @return Indices of the points in range, in no particular order.
+         * @throws std::invalid_argument if the tree is not 3D.
+         */
+        std::vector<size_t> radius(const fossil_math_geom_point3d& q, double radius) const {
+            require(3);
+            std::vector<size_t> out(64);
+            size_t found;
+            while ((found = fossil_math_spatial_kdtree_radius3d(tree_, q, radius, out.data(), out.size())) > out.size())
+                out.resize(found);
+            out.resize(found);
+            return out;
+        }
+
+        /**
+         * Runs k-NN for many 2D queries across threads.
+         * @param queries Query points.
+         * @param k Number of neighbours per query.
+         * @return Row-major indices, k per query; missing neighbours are SIZE_MAX.
+         * @throws std::invalid_argument if the tree is not 2D.
+         */
+        std::vector<size_t> knn(const std::vector<fossil_math_geom_point2d>& queries, size_t k) const {
+            require(2);
+            std::vector<size_t> indices(queries.size() * k);
+            std::vector<double> dist_sq(queries.size() * k);
+            fossil_math_spatial_kdtree_knn2d_batch(tree_, queries.data(), queries.size(), k, indices.data(), dist_sq.data());
+            return indices;
+        }
+
+        /**
+         * Runs k-NN for many 3D queries across threads.
+         * @param queries Query points.
+         * @param k Number of neighbours per query.
+         * @return Row-major indices, k per query; missing neighbours are SIZE_MAX.
+         * @throws std::invalid_argument if the tree is not 3D.
+         */
+        std::vector<size_t> knn(const std::vector<fossil_math_geom_point3d>& queries, size_t k) const {
+            require(3);
+            std::vector<size_t> indices(queries.size() * k);
+            std::vector<double> dist_sq(queries.size() * k);
+            fossil_math_spatial_kdtree_knn3d_batch(tree_, queries.data(), queries.size(), k, indices.data(), dist_sq.data());
+            return indices;
+        }
+
+        /**
+         * Returns the underlying C handle.
+         * @return Tree handle.
+         */
+        fossil_math_spatial_kdtree* handle() const { return tree_; }
+
+    private:
+        void require(size_t dims) const {
+            if (fossil_math_spatial_kdtree_dims(tree_) != dims)
+                throw std::invalid_argument("Query dimension does not match the KdTree");
+        }
+
+        fossil_math_spatial_kdtree* tree_ = nullptr;
+    };
+
+    /**
+     * @class SpatialGrid
+     * @brief RAII owner of a fossil_math_spatial_grid.
+     *
+     * The wrapper is move-only; the underlying grid is destroyed with the wrapper.
+     */
+    class SpatialGrid {
+    public:
+        /**
+         * Creates an empty grid.
+         * @param dims 2 or 3.
+         * @param cell_size Cell edge length.
+         * @param capacity Largest number of points; ids range over [0, capacity).
+         * @throws std::invalid_argument if the arguments are invalid.
+         */
+        SpatialGrid(size_t dims, double cell_size, size_t capacity)
+            : grid_(fossil_math_spatial_grid_create(dims, cell_size, capacity)) {
+            if (!grid_)
+                throw std::invalid_argument("Invalid SpatialGrid dimension, cell size or capacity");
+        }
+
+        ~SpatialGrid() { fossil_math_spatial_grid_destroy(grid_); }
+
+        SpatialGrid(const SpatialGrid&) = delete;
+        SpatialGrid& operator=(const SpatialGrid&) = delete;
+
+        SpatialGrid(SpatialGrid&& other) noexcept : grid_(other.grid_) { other.grid_ = nullptr; }
+
+        SpatialGrid& operator=(SpatialGrid&& other) noexcept {
+            if (this != &other) {
+                fossil_math_spatial_grid_destroy(grid_);
+                grid_ = other.grid_;
+                other.grid_ = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * Returns the number of points.
+         * @return Number of points.
+         */
+        size_t size() const { return fossil_math_spatial_grid_size(grid_); }
+
+        /**
+         * Replaces the contents with points 0 .. n-1 and rebuilds.
+         * @param points Points; point i gets id i.
+         * @throws std::invalid_argument if the points do not fit or the dimension differs.
+         */
+        void assign(const std::vector<fossil_math_geom_point2d>& points) {
+            if (fossil_math_spatial_grid_assign2d(grid_, points.data(), points.size()) != 0)
+                throw std::invalid_argument("SpatialGrid assign failed");
+        }
+
+        /**
+         * Replaces the contents with points 0 .. n-1 and rebuilds.
+         * @param points Points; point i gets id i.
+         * @throws std::invalid_argument if the points do not fit or the dimension differs.
+         */
+        void assign(const std::vector<fossil_math_geom_point3d>& points) {
+            if (fossil_math_spatial_grid_assign3d(grid_, points.data(), points.size()) != 0)
+                throw std::invalid_argument("SpatialGrid assign failed");
+        }
+
+        /**
+         * Sorts the points by cell.
+         * @throws std::runtime_error if allocation fails.
+         */
+        void rebuild() {
+            if (fossil_math_spatial_grid_rebuild(grid_) != 0)
+                throw std::runtime_error("SpatialGrid rebuild failed");
+        }
+
+        /**
+         * Inserts a point.
+         * @param id Point id.
+         * @param p Position.
+         * @throws std::invalid_argument if the id is invalid or present.
+         */
+        void insert(size_t id, const fossil_math_geom_point2d& p) {
+            if (fossil_math_spatial_grid_insert2d(grid_, id, p) != 0)
+                throw std::invalid_argument("SpatialGrid insert failed");
+        }
+
+        /**
+         * Inserts a point.
+         * @param id Point id.
+         * @param p Position.
+         * @throws std::invalid_argument if the id is invalid or present.
+         */
+        void insert(size_t id, const fossil_math_geom_point3d& p) {
+            if (fossil_math_spatial_grid_insert3d(grid_, id, p) != 0)
+                throw std::invalid_argument("SpatialGrid insert failed");
+        }
+
+        /**
+         * Moves a point.
+         * @param id Point id.
+         * @param p New position.
+         * @throws std::invalid_argument if the id is not present.
+         */
+        void move(size_t id, const fossil_math_geom_point2d& p) {
+            if (fossil_math_spatial_grid_move2d(grid_, id, p) != 0)
+                throw std::invalid_argument("SpatialGrid move failed");
+        }
+
+        /**
+         * Moves a point.
+         * @param id Point id.
+         * @param p New position.
+         * @throws std::invalid_argument if the id is not present.
+         */
+        void move(size_t id, const fossil_math_geom_point3d& p) {
+            if (fossil_math_spatial_grid_move3d(grid_, id, p) != 0)
+                throw std::invalid_argument("SpatialGrid move failed");
+        }
+
+        /**
+         * Removes a point.
+         * @param id Point id.
+         * @throws std::invalid_argument if the id is not present.
+         */
+        void remove(size_t id) {
+            if (fossil_math_spatial_grid_remove(grid_, id) != 0)
+                throw std::invalid_argument("SpatialGrid remove failed");
+        }
+
+        /**
+         * Tests whether an id is present.
+         * @param id Point id.
+         * @return true if present.
+         */
+        bool contains(size_t id) const { return fossil_math_spatial_grid_contains(grid_, id) != 0; }
+
+        /**
+         * Finds the ids of every point within a radius.
+         * @param q Query point.
+         * @param radius Search radius.
+         * @return Ids in no particular order.
+         */
+        std::vector<size_t> radius(const fossil_math_geom_point2d& q, double radius) const {
+            std::vector<size_t> out(64);
+            size_t found;
+            while ((found = fossil_math_spatial_grid_radius2d(grid_, q, radius, out.data(), out.size())) > out.size())
+                out.resize(found);
+            out.resize(found);
+            return out;
+        }
+
+        /**
+         * Finds the ids of every point within a radius.
+         * @param q Query point.
+         * @param radius Search radius.
+         * @return Ids in no particular order.
+         */
+        std::vector<size_t> radius(const fossil_math_geom_point3d& q, double radius) const {
+            std::vector<size_t> out(64);
+            size_t found;
+            while ((found = fossil_math_spatial_grid_radius3d(grid_, q, radius, out.data(), out.size())) > out.size())
+                out.resize(found);
+            out.resize(found);
+            return out;
+        }
+
+        /**
+         * Returns the underlying C handle.
+         * @return Grid handle.
+         */
+        fossil_math_spatial_grid* handle() const { return grid_; }
+
+    private:
+        fossil_math_spatial_grid* grid_ = nullptr;
+    };
+
+    /**
+     * @class TriangleBvh
+     * @brief RAII owner of a fossil_math_spatial_bvh.
+     *
+     * The wrapper is move-only; the underlying BVH is destroyed with the wrapper.
+     */
+    class TriangleBvh {
+    public:
+        /**
+         * Builds a BVH over a mesh.
+         * @param vertices Vertex buffer.
+         * @param indices Three vertex indices per triangle, or empty to read
+         *                consecutive vertex triples.
+         * @throws std::invalid_argument if an index is out of range.
+         */
+        explicit TriangleBvh(const std::vector<fossil_math_geom_point3d>& vertices,
+                             const std::vector<size_t>& indices = {}) {
+            if (indices.size() % 3 != 0 || (indices.empty() && vertices.size() % 3 != 0))
+                throw std::invalid_argument("TriangleBvh needs whole triangles");
+            size_t count = indices.empty() ? vertices.size() / 3 : indices.size() / 3;
+            bvh_ = fossil_math_spatial_bvh_create(vertices.data(), vertices.size(),
+                                                  indices.empty() ? nullptr : indices.data(), count);
+            if (!bvh_)
+                throw std::invalid_argument("Failed to build TriangleBvh");
+        }
+
+        ~TriangleBvh() { fossil_math_spatial_bvh_destroy(bvh_); }
+
+        TriangleBvh(const TriangleBvh&) = delete;
+        TriangleBvh& operator=(const TriangleBvh&) = delete;
+
+        TriangleBvh(TriangleBvh&& other) noexcept : bvh_(other.bvh_) { other.bvh_ = nullptr; }
+
+        TriangleBvh& operator=(TriangleBvh&& other) noexcept {
+            if (this != &other) {
+                fossil_math_spatial_bvh_destroy(bvh_);
+                bvh_ = other.bvh_;
+                other.bvh_ = nullptr;
+            }
+            return *this;
+        }
+
+        /**
+         * Returns the number of triangles.
+         * @return Number of triangles.
+         */
+        size_t size() const { return fossil_math_spatial_bvh_size(bvh_); }
+
+        /**
+         * Finds the closest triangle hit by a ray.
+         * @param ray The ray.
+         * @param t_max Largest accepted t.
+         * @return The hit; triangle is SIZE_MAX on a miss.
+         */
+        fossil_math_spatial_hit intersect(const fossil_math_spatial_ray& ray, double t_max = INFINITY) const {
+            fossil_math_spatial_hit hit;
+            fossil_math_spatial_bvh_intersect(bvh_, ray, t_max, &hit);
+            return hit;
+        }
+
+        /**
+         * Traces many rays in packets.
+         * @param rays The rays; keep coherent rays adjacent.
+         * @param t_max Largest accepted t.
+         * @return One hit per ray.
+         */
+        std::vector<fossil_math_spatial_hit> intersect(const std::vector<fossil_math_spatial_ray>& rays,
+                                                       double t_max = INFINITY) const {
+            std::vector<fossil_math_spatial_hit> hits(rays.size());
+            fossil_math_spatial_bvh_intersect_batch(bvh_, rays.data(), rays.size(), t_max, hits.data());
+            return hits;
+        }
+
+        /**
+         * Finds the closest mesh point.
+         * @param p Query point.
+         * @return Closest point, squared distance and triangle.
+         * @throws std::runtime_error if the mesh is empty.
+         */
+        fossil_math_spatial_nearest closest(const fossil_math_geom_point3d& p) const {
+            fossil_math_spatial_nearest out;
+            if (fossil_math_spatial_bvh_closest(bvh_, p, &out) != 0)
+                throw std::runtime_error("TriangleBvh is empty");
+            return out;
+        }
+
+        /**
+         * Finds the triangles that intersect a box.
+         * @param box Closed box.
+         * @return Triangle indices in no particular order.
+         */
+        std::vector<size_t> overlap(const fossil_math_geom_aabb3d& box) const {
+            std::vector<size_t> out(64);
+            size_t found;
+            while ((found = fossil_math_spatial_bvh_overlap(bvh_, box, out.data(), out.size())) > out.size())
+                out.resize(found);
+            out.resize(found);
+            return out;
+        }
+
+        /**
+         * Returns the underlying C handle.
+         * @return BVH handle.
+         */
+        fossil_math_spatial_bvh* handle() const { return bvh_; }
+
+    private:
+        fossil_math_spatial_bvh* bvh_ = nullptr;
+    };
+
+    /**
+     * @class SpaceFillingCurve
+     * @brief Morton and Hilbert ordering of point arrays.
+     *
+     * All methods are static wrappers around the fossil_math_spatial curve functions.
+     */
+    class SpaceFillingCurve {
+    public:
+        /**
+         * Computes curve keys for 2D points over their bounding box.
+         * @param points Points.
+         * @param curve Curve to follow.
+         * @return One key per point.
+         */
+        static std::vector<uint64_t> keys(const std::vector<fossil_math_geom_point2d>& points,
+                                          fossil_math_spatial_curve curve = FOSSIL_MATH_SPATIAL_HILBERT) {
+            std::vector<uint64_t> out(points.size());
+            fossil_math_spatial_curve_keys2d(points.data(), points.size(),
+                                             fossil_math_geom_aabb2d_from_points(points.data(), points.size()), curve,
+                                             out.data());
+            return out;
+        }
+
+        /**
+         * Computes curve keys for 3D points over their bounding box.
+         * @param points Points.
+         * @param curve Curve to follow.
+         * @return One key per point.
+         */
+        static std::vector<uint64_t> keys(const std::vector<fossil_math_geom_point3d>& points,
+                                          fossil_math_spatial_curve curve = FOSSIL_MATH_SPATIAL_HILBERT) {
+            std::vector<uint64_t> out(points.size());
+            fossil_math_spatial_curve_keys3d(points.data(), points.size(),
+                                             fossil_math_geom_aabb3d_from_points(points.data(), points.size()), curve,
+                                             out.data());
+            return out;
+        }
+
+        /**
+         * Sorts keys in place.
+         * @param keys Keys to sort.
+         * @return Original position of each sorted key.
+         * @throws std::runtime_error if allocation fails.
+         */
+        static std::vector<size_t> sort_keys(std::vector<uint64_t>& keys) {
+            std::vector<size_t> order(keys.size());
+            if (fossil_math_spatial_radix_sort(keys.data(), order.data(), keys.size()) != 0)
+                throw std::runtime_error("Radix sort allocation failed");
+            return order;
+        }
+
+        /**
+         * Sorts 2D points in place along a curve.
+         * @param points Points to sort.
+         * @param curve Curve to follow.
+         * @return Original position of each sorted point.
+         * @throws std::runtime_error if allocation fails.
+         */
+        static std::vector<size_t> sort(std::vector<fossil_math_geom_point2d>& points,
+                                        fossil_math_spatial_curve curve = FOSSIL_MATH_SPATIAL_HILBERT) {
+            std::vector<size_t> order(points.size());
+            if (fossil_math_spatial_curve_sort2d(points.data(), points.size(), curve, order.data()) != 0)
+                throw std::runtime_error("Curve sort allocation failed");
+            return order;
+        }
+
+        /**
+         * Sorts 3D points in place along a curve.
+         * @param points Points to sort.
+         * @param curve Curve to follow.
+         * @return Original position of each sorted point.
+         * @throws std::runtime_error if allocation fails.
+         */
+        static std::vector<size_t> sort(std::vector<fossil_math_geom_point3d>& points,
+                                        fossil_math_spatial_curve curve = FOSSIL_MATH_SPATIAL_HILBERT) {
+            std::vector<size_t> order(points.size());
+            if (fossil_math_spatial_curve_sort3d(points.data(), points.size(), curve, order.data()) != 0)
+                throw std::runtime_error("Curve sort allocation failed");
+            return order;
+        }
+
+        /**
+         * Reorders a payload array to follow a sort.
+         * @param src Elements in the original order; T must be trivially copyable.
+         * @param order Permutation returned by sort() or sort_keys().
+         * @return Elements with out[i] = src[order[i]].
+         * @throws std::invalid_argument if an order entry is out of range.
+         */
+        template <typename T>
+        static std::vector<T> gather(const std::vector<T>& src, const std::vector<size_t>& order) {
+            static_assert(std::is_trivially_copyable<T>::value, "gather() needs trivially copyable elements");
+            for (size_t i : order)
+                if (i >= src.size())
+                    throw std::invalid_argument("Order index out of range");
+            std::vector<T> out(order.size());
+            fossil_math_spatial_gather(src.data(), sizeof(T), order.data(), order.size(), out.data());
+            return out;
+        }
+    };
+
+} // namespace math
+
+} // namespace fossil
+
+#endif
+
+#endif /* FOSSIL_MATH_SPATIAL_H */
@@ -32,10 +32,54 @@ extern "C"
 {
 #endif
 
+// ======================================================
+// Structures
+// ======================================================
+
+/**
+ * Accuracy tiers for the sin, cos, tan, sincos, asin, acos and atan families.
+ *
+ * Bounds were measured against a long double reference and are checked by
+ * the test suite:
+ *  - PRECISE:  below 1 ULP (libm for scalars, fdlibm SIMD kernels for arrays).
+ *  - BALANCED: at most 4 ULP.
+ *  - FAST:     absolute error at most 1e-7 (relative for tan).
+ *
+ * Arguments with |x| > 823549 (and inf/NaN) use libm in every tier. The
+ * hyperbolic arrays take the same tiers; their bounds are listed with them.
+ */
+typedef enum {
+    FOSSIL_MATH_TRIG_PRECISE = 0,
+    FOSSIL_MATH_TRIG_BALANCED = 1,
+    FOSSIL_MATH_TRIG_FAST = 2
+} fossil_math_trig_accuracy;
+
 // *****************************************************************************
 // Function prototypes
 // *****************************************************************************
 
+// ======================================================
+// Accuracy tiers
+// ======================================================
+
+/**
+ * @brief Sets the tier used by the functions without an _ex suffix.
+ *
+ * The default is FOSSIL_MATH_TRIG_PRECISE. The setting is process-wide and
+ * not synchronized; set it before starting threads that call into trig.
+ *
+ * @param accuracy Tier to use.
+ * @return 0 on success, -1 if the tier is invalid.
+ */
+int fossil_math_trig_set_accuracy(fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Returns the tier used by the functions without an _ex suffix.
+ *
+ * @return Current default tier.
+ */
+fossil_math_trig_accuracy fossil_math_trig_get_accuracy(void);
+
 // ======================================================
 // Conversion
 // ======================================================
@@ -84,6 +128,17 @@ double fossil_math_trig_cos(double x);
  */
 double fossil_math_trig_tan(double x);
 
+/**
+ * @brief Computes the sine and cosine of an angle with one range reduction.
+ *
+ * Error below 1 ULP for both outputs.
+ *
+ * @param x Angle in radians.
+ * @param s Pointer to store the sine.
+ * @param c Pointer to store the cosine.
+ */
+void fossil_math_trig_sincos(double x, double* s, double* c);
+
 // Inverse
 
 /**
@@ -119,6 +174,118 @@ double fossil_math_trig_atan(double x);
  */
 double fossil_math_trig_atan2(double y, double x);
 
+// Explicit tier
+
+/**
+ * @brief Computes the sine of an angle (in radians) with the given tier.
+ *
+ * @param x Angle in radians.
+ * @param accuracy Accuracy tier.
+ * @return Sine of the angle.
+ */
+double fossil_math_trig_sin_ex(double x, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the cosine of an angle (in radians) with the given tier.
+ *
+ * @param x Angle in radians.
+ * @param accuracy Accuracy tier.
+ * @return Cosine of the angle.
+ */
+double fossil_math_trig_cos_ex(double x, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the tangent of an angle (in radians) with the given tier.
+ *
+ * @param x Angle in radians.
+ * @param accuracy Accuracy tier.
+ * @return Tangent of the angle.
+ */
+double fossil_math_trig_tan_ex(double x, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the sine and cosine of an angle with the given tier.
+ *
+ * @param x Angle in radians.
+ * @param s Pointer to store the sine.
+ * @param c Pointer to store the cosine.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_sincos_ex(double x, double* s, double* c, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the arcsine of a value with the given tier.
+ *
+ * @param x Value whose arcsine is to be computed.
+ * @param accuracy Accuracy tier.
+ * @return Angle in radians.
+ */
+double fossil_math_trig_asin_ex(double x, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the arccosine of a value with the given tier.
+ *
+ * @param x Value whose arccosine is to be computed.
+ * @param accuracy Accuracy tier.
+ * @return Angle in radians.
+ */
+double fossil_math_trig_acos_ex(double x, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the arctangent of a value with the given tier.
+ *
+ * The balanced tier shares the precise kernel.
+ *
+ * @param x Value whose arctangent is to be computed.
+ * @param accuracy Accuracy tier.
+ * @return Angle in radians.
+ */
+double fossil_math_trig_atan_ex(double x, fossil_math_trig_accuracy accuracy);
+
+// Degrees
+
+/**
+ * @brief Computes the sine of an angle given in degrees.
+ *
+ * The angle is reduced exactly modulo 360 before evaluation, so multiples
+ * of 30 and 90 degrees give the exact results (sind(180) is 0, sind(30) is
+ * 0.5). Error below 1 ULP.
+ *
+ * @param x Angle in degrees.
+ * @return Sine of the angle.
+ */
+double fossil_math_trig_sind(double x);
+
+/**
+ * @brief Computes the cosine of an angle given in degrees.
+ *
+ * Exact at multiples of 90 and 60 degrees (cosd(90) is +0). Error below 1 ULP.
+ *
+ * @param x Angle in degrees.
+ * @return Cosine of the angle.
+ */
+double fossil_math_trig_cosd(double x);
+
+/**
+ * @brief Computes the tangent of an angle given in degrees.
+ *
+ * Exact at multiples of 45 degrees; tand(90) is +inf and tand(270) is -inf.
+ * Error below 1 ULP.
+ *
+ * @param x Angle in degrees.
+ * @return Tangent of the angle.
+ */
+double fossil_math_trig_tand(double x);
+
+/**
+ * @brief Computes the sine and cosine of an angle given in degrees.
+ *
+ * @param x Angle in degrees.
+ * @param s Pointer to store the sine.
+ * @param c Pointer to store the cosine.
+ */
+void fossil_math_trig_sincosd(double x, double* s, double* c);
+
 // ======================================================
 // Hyperbolic
 // ======================================================
@@ -173,9 +340,378 @@ double fossil_math_trig_acosh(double x);
  */
 double fossil_math_trig_atanh(double x);
 
+// ======================================================
+// Array functions
+// ======================================================
+//
+// The array forms evaluate several elements per instruction with SIMD
+// polynomial kernels (AVX2 when the build targets it, SSE2 on x86-64, NEON
+// on AArch64, one lane elsewhere). The functions without an _ex suffix use
+// the default tier; the bounds quoted below are for the precise tier.
+// Measured against a correctly rounded reference, the maximum error of every
+// precise kernel is below 1 ULP; arguments outside |x| <= 823549 (and
+// inf/NaN) fall back to libm. out may alias in.
+
+/**
+ * @brief Computes the sine of every element of an array (radians).
+ *
+ * Error below 1 ULP.
+ *
+ * @param in Pointer to the input angles.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_sin_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the cosine of every element of an array (radians).
+ *
+ * Error below 1 ULP.
+ *
+ * @param in Pointer to the input angles.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_cos_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the tangent of every element of an array (radians).
+ *
+ * Error below 1 ULP.
+ *
+ * @param in Pointer to the input angles.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_tan_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the sine and cosine of every element with one range reduction.
+ *
+ * Error below 1 ULP. Either output may alias in.
+ *
+ * @param in Pointer to the input angles.
+ * @param s Pointer to the output sines.
+ * @param c Pointer to the output cosines.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_sincos_array(const double* in, double* s, double* c, size_t n);
+
+/**
+ * @brief Computes the arcsine of every element of an array.
+ *
+ * Error below 1 ULP; inputs outside [-1, 1] give NaN.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output angles in radians.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_asin_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the arccosine of every element of an array.
+ *
+ * Error below 1 ULP; inputs outside [-1, 1] give NaN.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output angles in radians.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_acos_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the arctangent of every element of an array.
+ *
+ * Error below 1 ULP.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output angles in radians.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_atan_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes atan2(y[i], x[i]) for every pair of elements.
+ *
+ * Error below 2 ULP; signed zeros, infinities and NaN follow C99 atan2.
+ *
+ * @param y Pointer to the y coordinates.
+ * @param x Pointer to the x coordinates.
+ * @param out Pointer to the output angles in radians, in [-pi, pi] (may alias y or x).
+ * @param n Number of elements.
+ */
+void fossil_math_trig_atan2_array(const double* y, const double* x, double* out, size_t n);
+
+/**
+ * @brief Computes the sine of every element with the given tier.
+ *
+ * @param in Pointer to the input angles in radians.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_sin_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the cosine of every element with the given tier.
+ *
+ * @param in Pointer to the input angles in radians.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_cos_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the tangent of every element with the given tier.
+ *
+ * @param in Pointer to the input angles in radians.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_tan_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the sine and cosine of every element with the given tier.
+ *
+ * @param in Pointer to the input angles.
+ * @param s Pointer to the output sines.
+ * @param c Pointer to the output cosines.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_sincos_array_ex(const double* in, double* s, double* c, size_t n,
+                                      fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the arcsine of every element with the given tier.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output angles in radians.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_asin_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the arccosine of every element with the given tier.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output angles in radians.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_acos_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the arctangent of every element with the given tier.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output angles in radians.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_atan_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes atan2(y[i], x[i]) for every pair with the given tier.
+ *
+ * @param y Pointer to the y coordinates.
+ * @param x Pointer to the x coordinates.
+ * @param out Pointer to the output angles in radians.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_atan2_array_ex(const double* y, const double* x, double* out, size_t n,
+                                     fossil_math_trig_accuracy accuracy);
+
+// Hyperbolic arrays use vector expm1 and log1p kernels with the fdlibm
+// reductions; the precise and balanced tiers share them (maximum error below
+// 3 ULP). The fast tier evaluates sinh, cosh, tanh and the tanh derivative
+// from short exp and sinh polynomials, with a relative error below 1e-7; the
+// inverse hyperbolics are the same in every tier. Buffers of 65536 or more
+// elements are split across fossil_math_set_threads() threads. out may
+// alias in.
+
+/**
+ * @brief Computes the hyperbolic sine of every element of an array.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_sinh_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the hyperbolic cosine of every element of an array.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_cosh_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the hyperbolic tangent of every element of an array.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_tanh_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes tanh and its derivative 1 - tanh^2 in one pass.
+ *
+ * The derivative is formed without cancellation, so it keeps full relative
+ * accuracy where tanh saturates, down through the subnormal range. y and dy
+ * may alias in, but not each other.
+ *
+ * @param in Pointer to the input values.
+ * @param y Pointer to the output tanh values.
+ * @param dy Pointer to the output derivatives.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_tanh_deriv_array(const double* in, double* y, double* dy, size_t n);
+
+/**
+ * @brief Computes the inverse hyperbolic sine of every element of an array.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_asinh_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the inverse hyperbolic cosine of every element of an array.
+ *
+ * Elements below 1 produce NaN.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_acosh_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the inverse hyperbolic tangent of every element of an array.
+ *
+ * Elements of magnitude 1 produce infinities and larger ones NaN.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ */
+void fossil_math_trig_atanh_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Computes the hyperbolic sine of every element with the given tier.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_sinh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the hyperbolic cosine of every element with the given tier.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_cosh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the hyperbolic tangent of every element with the given tier.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_tanh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes tanh and its derivative with the given tier.
+ *
+ * @param in Pointer to the input values.
+ * @param y Pointer to the output tanh values.
+ * @param dy Pointer to the output derivatives.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_tanh_deriv_array_ex(const double* in, double* y, double* dy, size_t n,
+                                          fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the inverse hyperbolic sine of every element with the given tier.
+ *
+ * The tier is accepted for symmetry; every tier uses the same kernel.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_asinh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the inverse hyperbolic cosine of every element with the given tier.
+ *
+ * The tier is accepted for symmetry; every tier uses the same kernel.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_acosh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Computes the inverse hyperbolic tangent of every element with the given tier.
+ *
+ * The tier is accepted for symmetry; every tier uses the same kernel.
+ *
+ * @param in Pointer to the input values.
+ * @param out Pointer to the output values.
+ * @param n Number of elements.
+ * @param accuracy Accuracy tier.
+ */
+void fossil_math_trig_atanh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy);
+
+/**
+ * @brief Converts every element of an array from degrees to radians.
+ *
+ * Gives the same values as fossil_math_trig_deg_to_rad().
+ *
+ * @param in Pointer to the input angles in degrees.
+ * @param out Pointer to the output angles in radians (may alias in).
+ * @param n Number of elements.
+ */
+void fossil_math_trig_deg_to_rad_array(const double* in, double* out, size_t n);
+
+/**
+ * @brief Converts every element of an array from radians to degrees.
+ *
+ * Gives the same values as fossil_math_trig_rad_to_deg().
+ *
+ * @param in Pointer to the input angles in radians.
+ * @param out Pointer to the output angles in degrees (may alias in).
+ * @param n Number of elements.
+ */
+void fossil_math_trig_rad_to_deg_array(const double* in, double* out, size_t n);
+
 #ifdef __cplusplus
 }
+#include <bit>
+#include <limits>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
 #include <string>
 
@@ -183,12 +719,414 @@ namespace fossil {
 
 namespace math {
 
+    namespace detail {
+
+        // Compile-time kernels behind the constexpr Trigonometry methods. They
+        // follow the fdlibm reduction and polynomials used by trig.c and are
+        // only selected during constant evaluation; runtime calls still go
+        // through the C functions and their accuracy tier.
+
+        constexpr double trig_nan = std::numeric_limits<double>::quiet_NaN();
+        constexpr double trig_reduce_max = 823549.0;
+
+        constexpr bool trig_signbit(double x) {
+            return (std::bit_cast<uint64_t>(x) >> 63) != 0;
+        }
+
+        constexpr double trig_fabs(double x) {
+            return std::bit_cast<double>(std::bit_cast<uint64_t>(x) & 0x7fffffffffffffffULL);
+        }
+
+        constexpr double trig_copysign(double x, double s) {
+            return trig_signbit(x) == trig_signbit(s) ? x : -x;
+        }
+
+        constexpr bool trig_finite(double x) {
+            return (std::bit_cast<uint64_t>(x) & 0x7ff0000000000000ULL) != 0x7ff0000000000000ULL;
+        }
+
+        constexpr double trig_clear_low(double x) {
+            return std::bit_cast<double>(std::bit_cast<uint64_t>(x) & 0xffffffff00000000ULL);
+        }
+
+        // Correctly rounded square root, one result bit per step on the
+        // integer significand.
+        constexpr double trig_sqrt(double x) {
+            if (x != x || x == 0.0 || x == std::numeric_limits<double>::infinity()) return x;
+            if (x < 0.0) return trig_nan;
+            uint64_t bits = std::bit_cast<uint64_t>(x);
+            int e = (int)(bits >> 52);
+            uint64_t m = bits & 0x000fffffffffffffULL;
+            if (e == 0) {
+                e = 1;
+                while (!(m & 0x0010000000000000ULL)) {
+                    m <<= 1;
+                    e--;
+                }
+            } else {
+                m |= 0x0010000000000000ULL;
+            }
+            e -= 1075;                              // x = m * 2^e
+            if (e & 1) {
+                m <<= 1;
+                e--;
+            }
+            // 54 root bits of m * 2^54, then round to nearest on the last.
+            uint64_t q = 0, rem = 0;
+            for (int i = 53; i >= 0; i--) {
+                uint64_t pair = (i >= 27) ? (m >> (2 * (i - 27))) & 3 : 0;
+                rem = (rem << 2) | pair;
+                uint64_t t = (q << 2) | 1;
+                q <<= 1;
+                if (rem >= t) {
+                    rem -= t;
+                    q |= 1;
+                }
+            }
+            bool half = (q & 1) != 0;
+            q >>= 1;
+            if (half && (rem != 0 || (q & 1))) q++;
+            uint64_t exp = (uint64_t)((e - 54) / 2 + 53 + 1023);
+            return std::bit_cast<double>((exp << 52) + (q - 0x0010000000000000ULL));
+        }
+
+        constexpr double trig_sin_poly(double x, double y) {
+            double z = x * x;
+            double w = z * z;
+            double r = 8.33333333332248946124e-03 + z * (-1.98412698298579493134e-04 + z * 2.75573137070700676789e-06) +
+                       z * w * (-2.50507602534068634195e-08 + z * 1.58969099521155010221e-10);
+            double v = z * x;
+            return x - ((z * (0.5 * y - v * r) - y) - v * -1.66666666666666324348e-01);
+        }
+
+        constexpr double trig_cos_poly(double x, double y) {
+            double z = x * x;
+            double w = z * z;
+            double r = z * (4.16666666666666019037e-02 + z * (-1.38888888888741095749e-03 + z * 2.48015872894767294178e-05)) +
+                       w * w * (-2.75573143513906633035e-07 + z * (2.08757232129817482790e-09 + z * -1.13596475577881948265e-11));
+            double hz = 0.5 * z;
+            w = 1.0 - hz;
+            return w + (((1.0 - w) - hz) + (z * r - x * y));
+        }
+
+        // tan(x + y) for |x| <= pi/4, or -1/tan(x + y) when odd is set.
+        constexpr double trig_tan_poly(double x, double y, bool odd) {
+            constexpr double T[] = {
+                 3.33333333333334091986e-01,  1.33333333333201242699e-01,  5.39682539762260521377e-02,
+                 2.18694882948595424599e-02,  8.86323982359930005737e-03,  3.59207910759131235356e-03,
+                 1.45620945432529025516e-03,  5.88041240820264096874e-04,  2.46463134818469906812e-04,
+                 7.81794442939557092300e-05,  7.14072491382608190305e-05, -1.85586374855275456654e-05,
+                 2.59073051863633712884e-05,
+            };
+            bool neg = trig_signbit(x);
+            bool big = trig_fabs(x) >= 0.6744;
+            if (big) {
+                if (neg) {
+                    x = -x;
+                    y = -y;
+                }
+                x = (7.85398163397448278999e-01 - x) + (3.06161699786838301793e-17 - y);
+                y = 0.0;
+            }
+            double z = x * x;
+            double w = z * z;
+            double r = T[1] + w * (T[3] + w * (T[5] + w * (T[7] + w * (T[9] + w * T[11]))));
+            double v = z * (T[2] + w * (T[4] + w * (T[6] + w * (T[8] + w * (T[10] + w * T[12])))));
+            double s = z * x;
+            r = y + z * (s * (r + v) + y);
+            r += T[0] * s;
+            w = x + r;
+            if (big) {
+                double iy = odd ? -1.0 : 1.0;
+                double t = iy - 2.0 * (x - (w * w / (w + iy) - r));
+                return neg ? -t : t;
+            }
+            if (!odd) return w;
+            // -1 / (x + r) with the rounding error of w folded back in.
+            double zh = trig_clear_low(w);
+            v = r - (zh - x);
+            double a = -1.0 / w;
+            double t = trig_clear_low(a);
+            s = 1.0 + t * zh;
+            return t + a * (s + t * v);
+        }
+
+        // x = n * pi/2 + (hi + lo) with |hi| <= pi/4, for |x| <= trig_reduce_max.
+        constexpr int trig_reduce(double x, double& hi, double& lo) {
+            double fn = x * 6.36619772367581382433e-01;
+            fn = (fn + 6755399441055744.0) - 6755399441055744.0;
+            double xpow = std::bit_cast<double>(std::bit_cast<uint64_t>(x) & 0x7ff0000000000000ULL);
+
+            double r = x - fn * 1.57079632673412561417e+00;
+            double w = fn * 6.07710050650619224932e-11;
+            double y = r - w;
+            if (trig_fabs(y) < xpow * 1.52587890625e-05) {
+                double t = r;
+                w = fn * 6.07710050630396597660e-11;
+                r = t - w;
+                w = fn * 2.02226624879595063154e-21 - ((t - r) - w);
+                y = r - w;
+                if (trig_fabs(y) < xpow * 1.7763568394002505e-15) {
+                    t = r;
+                    w = fn * 2.02226624871116645580e-21;
+                    r = t - w;
+                    w = fn * 8.47842766036889956997e-32 - ((t - r) - w);
+                    y = r - w;
+                }
+            }
+            hi = y;
+            lo = (r - y) - w;
+            return (int)((long long)fn & 3);
+        }
+
+        // sin of hi + lo shifted by q quarter turns.
+        constexpr double trig_quadrant(int q, double hi, double lo) {
+            switch (q & 3) {
+            case 0:  return trig_sin_poly(hi, lo);
+            case 1:  return trig_cos_poly(hi, lo);
+            case 2:  return -trig_sin_poly(hi, lo);
+            default: return -trig_cos_poly(hi, lo);
+            }
+        }
+
+        constexpr void trig_check_range(double x) {
+            if (trig_finite(x) && !(trig_fabs(x) <= trig_reduce_max))
+                throw std::domain_error("compile-time trig argument exceeds 823549 radians");
+        }
+
+        constexpr double trig_sin(double x) {
+            if (!trig_finite(x)) return trig_nan;
+            trig_check_range(x);
+            if (trig_fabs(x) < 7.450580596923828125e-09) return x;
+            double hi = 0.0, lo = 0.0;
+            int q = trig_reduce(x, hi, lo);
+            return trig_quadrant(q, hi, lo);
+        }
+
+        constexpr double trig_cos(double x) {
+            if (!trig_finite(x)) return trig_nan;
+            trig_check_range(x);
+            if (trig_fabs(x) < 7.450580596923828125e-09) return 1.0;
+            double hi = 0.0, lo = 0.0;
+            int q = trig_reduce(x, hi, lo);
+            return trig_quadrant(q + 1, hi, lo);
+        }
+
+        constexpr double trig_tan(double x) {
+            if (!trig_finite(x)) return trig_nan;
+            trig_check_range(x);
+            if (trig_fabs(x) < 7.450580596923828125e-09) return x;
+            double hi = 0.0, lo = 0.0;
+            int q = trig_reduce(x, hi, lo);
+            return trig_tan_poly(hi, lo, (q & 1) != 0);
+        }
+
+        // Rational approximation of (asin(sqrt(t)) - sqrt(t)) / sqrt(t)^3.
+        constexpr double trig_asin_ratio(double t) {
+            double p = t * (1.66666666666666657415e-01 + t * (-3.25565818622400915405e-01 + t * (2.01212532134862925881e-01 +
+                       t * (-4.00555345006794114027e-02 + t * (7.91534994289814532176e-04 + t * 3.47933107596021167570e-05)))));
+            double q = 1.0 + t * (-2.40339491173441421878e+00 + t * (2.02094576023350569471e+00 +
+                       t * (-6.88283971605453293030e-01 + t * 7.70381505559019352791e-02)));
+            return p / q;
+        }
+
+        constexpr double pio2_hi = 1.57079632679489655800e+00;
+        constexpr double pio2_lo = 6.12323399573676603587e-17;
+        constexpr double pio4_hi = 7.85398163397448278999e-01;
+        constexpr double pi_hi   = 3.14159265358979311600e+00;
+
+        constexpr double trig_asin(double x) {
+            double ax = trig_fabs(x);
+            if (!(ax <= 1.0)) return trig_nan;
+            if (ax == 1.0) return x * pio2_hi + x * pio2_lo;
+            if (ax < 0.5) {
+                if (ax < 7.450580596923828125e-09) return x;
+                return x + x * trig_asin_ratio(x * x);
+            }
+            double t = (1.0 - ax) * 0.5;
+            double r = trig_asin_ratio(t);
+            double s = trig_sqrt(t);
+            if (ax >= 0.975) {
+                t = pio2_hi - (2.0 * (s + s * r) - pio2_lo);
+            } else {
+                double w = trig_clear_low(s);
+                double c = (t - w * w) / (s + w);
+                double p = 2.0 * s * r - (pio2_lo - 2.0 * c);
+                double q = pio4_hi - 2.0 * w;
+                t = pio4_hi - (p - q);
+            }
+            return trig_signbit(x) ? -t : t;
+        }
+
+        constexpr double trig_acos(double x) {
+            double ax = trig_fabs(x);
+            if (!(ax <= 1.0)) return trig_nan;
+            if (ax == 1.0) return x > 0.0 ? 0.0 : pi_hi + 2.0 * pio2_lo;
+            if (ax < 0.5) {
+                if (ax <= 6.93889390390722837765e-18) return pio2_hi + pio2_lo;
+                return pio2_hi - (x - (pio2_lo - x * trig_asin_ratio(x * x)));
+            }
+            if (x < 0.0) {
+                double z = (1.0 + x) * 0.5;
+                double s = trig_sqrt(z);
+                double w = trig_asin_ratio(z) * s - pio2_lo;
+                return pi_hi - 2.0 * (s + w);
+            }
+            double z = (1.0 - x) * 0.5;
+            double s = trig_sqrt(z);
+            double df = trig_clear_low(s);
+            double c = (z - df * df) / (s + df);
+            double w = trig_asin_ratio(z) * s + c;
+            return 2.0 * (df + w);
+        }
+
+        constexpr double trig_atan(double x) {
+            constexpr double atanhi[] = {
+                4.63647609000806093515e-01, 7.85398163397448278999e-01,
+                9.82793723247329054082e-01, 1.57079632679489655800e+00,
+            };
+            constexpr double atanlo[] = {
+                2.26987774529616870924e-17, 3.06161699786838301793e-17,
+                1.39033110312309984516e-17, 6.12323399573676603587e-17,
+            };
+            constexpr double aT[] = {
+                 3.33333333333329318027e-01, -1.99999999998764832476e-01,  1.42857142725034663711e-01,
+                -1.11111104054623557880e-01,  9.09088713343650656196e-02, -7.69187620504482999495e-02,
+                 6.66107313738753120669e-02, -5.83357013379057348645e-02,  4.97687799461593236017e-02,
+                -3.65315727442169155270e-02,  1.62858201153657823623e-02,
+            };
+            if (x != x) return x;
+            bool neg = trig_signbit(x);
+            double ax = trig_fabs(x);
+            if (ax >= 7.37869762948382064640e+19) return neg ? -(atanhi[3] + atanlo[3]) : atanhi[3] + atanlo[3];
+            int id = -1;
+            if (ax < 0.4375) {
+                if (ax < 7.450580596923828125e-09) return x;
+            } else if (ax < 0.6875) {
+                id = 0;
+                x = (2.0 * ax - 1.0) / (2.0 + ax);
+            } else if (ax < 1.1875) {
+                id = 1;
+                x = (ax - 1.0) / (ax + 1.0);
+            } else if (ax < 2.4375) {
+                id = 2;
+                x = (ax - 1.5) / (1.0 + 1.5 * ax);
+            } else {
+                id = 3;
+                x = -1.0 / ax;
+            }
+            double z = x * x;
+            double w = z * z;
+            double s1 = z * (aT[0] + w * (aT[2] + w * (aT[4] + w * (aT[6] + w * (aT[8] + w * aT[10])))));
+            double s2 = w * (aT[1] + w * (aT[3] + w * (aT[5] + w * (aT[7] + w * aT[9]))));
+            if (id < 0) return x - x * (s1 + s2);
+            double r = atanhi[id] - ((x * (s1 + s2) - atanlo[id]) - x);
+            return neg ? -r : r;
+        }
+
+        constexpr double trig_atan2(double y, double x) {
+            constexpr double pi_lo = 1.2246467991473531772e-16;
+            if (x != x || y != y) return trig_nan;
+            if (x == 1.0) return trig_atan(y);
+            int m = (trig_signbit(y) ? 1 : 0) | (trig_signbit(x) ? 2 : 0);
+            if (y == 0.0) return (m & 2) ? trig_copysign(pi_hi, y) : y;
+            if (x == 0.0) return trig_copysign(pio2_hi, y);
+            if (!trig_finite(x)) {
+                if (!trig_finite(y)) return trig_copysign((m & 2) ? 3.0 * pio4_hi : pio4_hi, y);
+                return trig_copysign((m & 2) ? pi_hi : 0.0, y);
+            }
+            if (!trig_finite(y)) return trig_copysign(pio2_hi, y);
+
+            int k = (int)((std::bit_cast<uint64_t>(y) >> 52) & 0x7ff) - (int)((std::bit_cast<uint64_t>(x) >> 52) & 0x7ff);
+            double z = 0.0;
+            if (k > 60) {
+                z = pio2_hi + 0.5 * pi_lo;
+                m &= 1;
+            } else if (!((m & 2) && k < -60)) {
+                z = trig_atan(trig_fabs(y / x));
+            }
+            switch (m) {
+            case 0:  return z;
+            case 1:  return -z;
+            case 2:  return pi_hi - (z - pi_lo);
+            default: return (z - pi_lo) - pi_hi;
+            }
+        }
+
+        // |x| mod m for finite x and m > 0, exact: each step subtracts the
+        // largest m * 2^k that fits, which Sterbenz makes exact.
+        constexpr double trig_fmod(double x, double m) {
+            double r = trig_fabs(x);
+            if (r < m) return x;
+            double d = m;
+            while (d <= r * 0.5) d *= 2.0;
+            while (d >= m) {
+                if (r >= d) r -= d;
+                d *= 0.5;
+            }
+            return trig_signbit(x) ? -r : r;
+        }
+
+        // Reduces finite degrees exactly to y in [-45, 45] plus a quadrant and
+        // returns y in radians as hi + lo, as trig.c does.
+        constexpr int trig_deg_reduce(double x, double& y, double& hi, double& lo) {
+            double r = trig_fmod(x, 360.0);
+            double n = r / 90.0 + 0.5;
+            long long k = (long long)n;
+            if ((double)k > n) k--;
+            double d = r - 90.0 * (double)k;
+            double t = d * 134217729.0;
+            double dh = t - (t - d);
+            double dl = d - dh;
+            double a = dh * 0.01745329238474369;
+            double b = dh * 1.3519960527851425e-10 + dl * 0.01745329238474369 + dl * 1.3519960527851425e-10;
+            y = d;
+            hi = a + b;
+            lo = b - (hi - a);
+            return (int)(k & 3);
+        }
+
+        constexpr double trig_sind(double x) {
+            if (!trig_finite(x)) return trig_nan;
+            double y = 0.0, hi = 0.0, lo = 0.0;
+            int q = trig_deg_reduce(x, y, hi, lo);
+            double r = trig_quadrant(q, hi, lo);
+            return (r == 0.0) ? trig_copysign(0.0, x) : r;
+        }
+
+        constexpr double trig_cosd(double x) {
+            if (!trig_finite(x)) return trig_nan;
+            double y = 0.0, hi = 0.0, lo = 0.0;
+            int q = trig_deg_reduce(x, y, hi, lo);
+            double r = trig_quadrant(q + 1, hi, lo);
+            return (r == 0.0) ? 0.0 : r;
+        }
+
+        constexpr double trig_tand(double x) {
+            if (!trig_finite(x)) return trig_nan;
+            double y = 0.0, hi = 0.0, lo = 0.0;
+            int q = trig_deg_reduce(x, y, hi, lo);
+            if (y == 0.0) {
+                double c = trig_cosd(x);
+                if (c == 0.0) return trig_copysign(std::numeric_limits<double>::infinity(), trig_sind(x));
+                return trig_sind(x) / c;
+            }
+            if (trig_fabs(y) == 45.0) return ((q & 1) ? -1.0 : 1.0) * trig_copysign(1.0, y);
+            double r = trig_tan_poly(hi, lo, (q & 1) != 0);
+            return (r == 0.0) ? trig_copysign(0.0, y) : r;
+        }
+    } // namespace detail
+
     /**
      * @class Trigonometry
      * @brief Provides static methods for trigonometric and hyperbolic operations.
      *
      * This class offers a C++ interface to the underlying Fossil Logic C trigonometric API.
-     * All methods are static and directly wrap the corresponding C functions.
+     * All methods are static and directly wrap the corresponding C functions. The
+     * conversions and the scalar circular functions are constexpr: conversions are
+     * inlined, and the trig functions compute their result at compile time in
+     * constant expressions (within 1 ULP, 2 for atan2; |x| <= 823549 radians) while runtime
+     * calls still use the C functions and the current accuracy tier.
      */
     class Trigonometry {
     public:
@@ -201,8 +1139,8 @@ namespace math {
          * @param degrees Angle in degrees.
          * @return Angle in radians.
          */
-        static double deg_to_rad(double degrees) {
-            return fossil_math_trig_deg_to_rad(degrees);
+        static constexpr double deg_to_rad(double degrees) {
+            return degrees * (FOSSIL_MATH_PI / 180.0);
         }
 
         /**
@@ -210,8 +1148,30 @@ namespace math {
          * @param radians Angle in radians.
          * @return Angle in degrees.
          */
-        static double rad_to_deg(double radians) {
-            return fossil_math_trig_rad_to_deg(radians);
+        static constexpr double rad_to_deg(double radians) {
+            return radians * (180.0 / FOSSIL_MATH_PI);
+        }
+
+        /**
+         * @brief Converts every element from degrees to radians.
+         * @param degrees Angles in degrees.
+         * @return Angles in radians.
+         */
+        static std::vector<double> deg_to_rad(const std::vector<double>& degrees) {
+            std::vector<double> out(degrees.size());
+            fossil_math_trig_deg_to_rad_array(degrees.data(), out.data(), degrees.size());
+            return out;
+        }
+
+        /**
+         * @brief Converts every element from radians to degrees.
+         * @param radians Angles in radians.
+         * @return Angles in degrees.
+         */
+        static std::vector<double> rad_to_deg(const std::vector<double>& radians) {
+            std::vector<double> out(radians.size());
+            fossil_math_trig_rad_to_deg_array(radians.data(), out.data(), radians.size());
+            return out;
         }
 
         // ======================================================
@@ -223,7 +1183,8 @@ namespace math {
          * @param x Angle in radians.
          * @return Sine of the angle.
          */
-        static double sin(double x) {
+        static constexpr double sin(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_sin(x);
             return fossil_math_trig_sin(x);
         }
 
@@ -232,7 +1193,8 @@ namespace math {
          * @param x Angle in radians.
          * @return Cosine of the angle.
          */
-        static double cos(double x) {
+        static constexpr double cos(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_cos(x);
             return fossil_math_trig_cos(x);
         }
 
@@ -241,10 +1203,71 @@ namespace math {
          * @param x Angle in radians.
          * @return Tangent of the angle.
          */
-        static double tan(double x) {
+        static constexpr double tan(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_tan(x);
             return fossil_math_trig_tan(x);
         }
 
+        /**
+         * @brief Computes the sine and cosine of an angle together.
+         * @param x Angle in radians.
+         * @param s Receives the sine.
+         * @param c Receives the cosine.
+         */
+        static constexpr void sincos(double x, double& s, double& c) {
+            if (std::is_constant_evaluated()) {
+                s = detail::trig_sin(x);
+                c = detail::trig_cos(x);
+                return;
+            }
+            fossil_math_trig_sincos(x, &s, &c);
+        }
+
+        /**
+         * @brief Computes the sine of an angle given in degrees.
+         * @param x Angle in degrees.
+         * @return Sine of the angle.
+         */
+        static constexpr double sind(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_sind(x);
+            return fossil_math_trig_sind(x);
+        }
+
+        /**
+         * @brief Computes the cosine of an angle given in degrees.
+         * @param x Angle in degrees.
+         * @return Cosine of the angle.
+         */
+        static constexpr double cosd(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_cosd(x);
+            return fossil_math_trig_cosd(x);
+        }
+
+        /**
+         * @brief Computes the tangent of an angle given in degrees.
+         * @param x Angle in degrees.
+         * @return Tangent of the angle.
+         */
+        static constexpr double tand(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_tand(x);
+            return fossil_math_trig_tand(x);
+        }
+
+        /**
+         * @brief Computes the sine and cosine of an angle given in degrees.
+         * @param x Angle in degrees.
+         * @param s Receives the sine.
+         * @param c Receives the cosine.
+         */
+        static constexpr void sincosd(double x, double& s, double& c) {
+            if (std::is_constant_evaluated()) {
+                s = detail::trig_sind(x);
+                c = detail::trig_cosd(x);
+                return;
+            }
+            fossil_math_trig_sincosd(x, &s, &c);
+        }
+
         // Inverse
 
         /**
@@ -252,7 +1275,8 @@ namespace math {
          * @param x Value whose arcsine is to be computed.
          * @return Angle in radians.
          */
-        static double asin(double x) {
+        static constexpr double asin(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_asin(x);
             return fossil_math_trig_asin(x);
         }
 
@@ -261,7 +1285,8 @@ namespace math {
          * @param x Value whose arccosine is to be computed.
          * @return Angle in radians.
          */
-        static double acos(double x) {
+        static constexpr double acos(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_acos(x);
             return fossil_math_trig_acos(x);
         }
 
@@ -270,7 +1295,8 @@ namespace math {
          * @param x Value whose arctangent is to be computed.
          * @return Angle in radians.
          */
-        static double atan(double x) {
+        static constexpr double atan(double x) {
+            if (std::is_constant_evaluated()) return detail::trig_atan(x);
             return fossil_math_trig_atan(x);
         }
 
@@ -280,7 +1306,8 @@ namespace math {
          * @param x Abscissa value.
          * @return Angle in radians.
          */
-        static double atan2(double y, double x) {
+        static constexpr double atan2(double y, double x) {
+            if (std::is_constant_evaluated()) return detail::trig_atan2(y, x);
             return fossil_math_trig_atan2(y, x);
         }
 
@@ -343,6 +1370,463 @@ namespace math {
         static double atanh(double x) {
             return fossil_math_trig_atanh(x);
         }
+
+        // ======================================================
+        // Array functions
+        // ======================================================
+
+        /**
+         * @brief Computes the sine of every element (radians).
+         * @param x Angles in radians.
+         * @return Sines of the angles.
+         */
+        static std::vector<double> sin(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_sin_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the cosine of every element (radians).
+         * @param x Angles in radians.
+         * @return Cosines of the angles.
+         */
+        static std::vector<double> cos(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_cos_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the tangent of every element (radians).
+         * @param x Angles in radians.
+         * @return Tangents of the angles.
+         */
+        static std::vector<double> tan(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_tan_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the sine and cosine of every element together.
+         * @param x Angles in radians.
+         * @param s Receives the sines.
+         * @param c Receives the cosines.
+         */
+        static void sincos(const std::vector<double>& x, std::vector<double>& s, std::vector<double>& c) {
+            s.resize(x.size());
+            c.resize(x.size());
+            fossil_math_trig_sincos_array(x.data(), s.data(), c.data(), x.size());
+        }
+
+        /**
+         * @brief Computes the arcsine of every element.
+         * @param x Values whose arcsines are to be computed.
+         * @return Angles in radians.
+         */
+        static std::vector<double> asin(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_asin_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the arccosine of every element.
+         * @param x Values whose arccosines are to be computed.
+         * @return Angles in radians.
+         */
+        static std::vector<double> acos(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_acos_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the arctangent of every element.
+         * @param x Values whose arctangents are to be computed.
+         * @return Angles in radians.
+         */
+        static std::vector<double> atan(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_atan_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes atan2 for every pair of elements.
+         * @param y The y coordinates.
+         * @param x The x coordinates.
+         * @return Angles in radians.
+         * @throws std::invalid_argument if the sizes differ.
+         */
+        static std::vector<double> atan2(const std::vector<double>& y, const std::vector<double>& x) {
+            if (y.size() != x.size())
+                throw std::invalid_argument("y and x must have the same size");
+            std::vector<double> out(x.size());
+            fossil_math_trig_atan2_array(y.data(), x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the hyperbolic sine of every element.
+         * @param x Values.
+         * @return Hyperbolic sines.
+         */
+        static std::vector<double> sinh(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_sinh_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the hyperbolic cosine of every element.
+         * @param x Values.
+         * @return Hyperbolic cosines.
+         */
+        static std::vector<double> cosh(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_cosh_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the hyperbolic tangent of every element.
+         * @param x Values.
+         * @return Hyperbolic tangents.
+         */
+        static std::vector<double> tanh(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_tanh_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes tanh and its derivative for every element in one pass.
+         * @param x Values.
+         * @param y Receives the hyperbolic tangents.
+         * @param dy Receives the derivatives 1 - tanh^2.
+         */
+        static void tanh_deriv(const std::vector<double>& x, std::vector<double>& y, std::vector<double>& dy) {
+            y.resize(x.size());
+            dy.resize(x.size());
+            fossil_math_trig_tanh_deriv_array(x.data(), y.data(), dy.data(), x.size());
+        }
+
+        /**
+         * @brief Computes the inverse hyperbolic sine of every element.
+         * @param x Values.
+         * @return Inverse hyperbolic sines.
+         */
+        static std::vector<double> asinh(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_asinh_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the inverse hyperbolic cosine of every element.
+         * @param x Values (at least 1).
+         * @return Inverse hyperbolic cosines.
+         */
+        static std::vector<double> acosh(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_acosh_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        /**
+         * @brief Computes the inverse hyperbolic tangent of every element.
+         * @param x Values in (-1, 1).
+         * @return Inverse hyperbolic tangents.
+         */
+        static std::vector<double> atanh(const std::vector<double>& x) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_atanh_array(x.data(), out.data(), x.size());
+            return out;
+        }
+
+        // ======================================================
+        // Accuracy tiers
+        // ======================================================
+
+        /**
+         * @brief Sets the process-wide default tier.
+         * @param accuracy Tier to use.
+         * @throws std::invalid_argument if the tier is invalid.
+         */
+        static void set_accuracy(fossil_math_trig_accuracy accuracy) {
+            if (fossil_math_trig_set_accuracy(accuracy) != 0)
+                throw std::invalid_argument("Invalid trig accuracy tier");
+        }
+
+        /**
+         * @brief Returns the process-wide default tier.
+         * @return Current default tier.
+         */
+        static fossil_math_trig_accuracy accuracy() {
+            return fossil_math_trig_get_accuracy();
+        }
+
+        /**
+         * @brief Computes the sine of an angle with the given tier.
+         * @param x Angle in radians.
+         * @param accuracy Accuracy tier.
+         * @return Sine of the angle.
+         */
+        static double sin(double x, fossil_math_trig_accuracy accuracy) {
+            return fossil_math_trig_sin_ex(x, accuracy);
+        }
+
+        /**
+         * @brief Computes the cosine of an angle with the given tier.
+         * @param x Angle in radians.
+         * @param accuracy Accuracy tier.
+         * @return Cosine of the angle.
+         */
+        static double cos(double x, fossil_math_trig_accuracy accuracy) {
+            return fossil_math_trig_cos_ex(x, accuracy);
+        }
+
+        /**
+         * @brief Computes the tangent of an angle with the given tier.
+         * @param x Angle in radians.
+         * @param accuracy Accuracy tier.
+         * @return Tangent of the angle.
+         */
+        static double tan(double x, fossil_math_trig_accuracy accuracy) {
+            return fossil_math_trig_tan_ex(x, accuracy);
+        }
+
+        /**
+         * @brief Computes the sine and cosine of an angle with the given tier.
+         * @param x Angle in radians.
+         * @param s Receives the sine.
+         * @param c Receives the cosine.
+         * @param accuracy Accuracy tier.
+         */
+        static void sincos(double x, double& s, double& c, fossil_math_trig_accuracy accuracy) {
+            fossil_math_trig_sincos_ex(x, &s, &c, accuracy);
+        }
+
+        /**
+         * @brief Computes the arcsine of a value with the given tier.
+         * @param x Value whose arcsine is to be computed.
+         * @param accuracy Accuracy tier.
+         * @return Angle in radians.
+         */
+        static double asin(double x, fossil_math_trig_accuracy accuracy) {
+            return fossil_math_trig_asin_ex(x, accuracy);
+        }
+
+        /**
+         * @brief Computes the arccosine of a value with the given tier.
+         * @param x Value whose arccosine is to be computed.
+         * @param accuracy Accuracy tier.
+         * @return Angle in radians.
+         */
+        static double acos(double x, fossil_math_trig_accuracy accuracy) {
+            return fossil_math_trig_acos_ex(x, accuracy);
+        }
+
+        /**
+         * @brief Computes the arctangent of a value with the given tier.
+         * @param x Value whose arctangent is to be computed.
+         * @param accuracy Accuracy tier.
+         * @return Angle in radians.
+         */
+        static double atan(double x, fossil_math_trig_accuracy accuracy) {
+            return fossil_math_trig_atan_ex(x, accuracy);
+        }
+
+        /**
+         * @brief Computes the sine of every element with the given tier.
+         * @param x Angles in radians.
+         * @param accuracy Accuracy tier.
+         * @return Sines of the angles.
+         */
+        static std::vector<double> sin(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_sin_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the cosine of every element with the given tier.
+         * @param x Angles in radians.
+         * @param accuracy Accuracy tier.
+         * @return Cosines of the angles.
+         */
+        static std::vector<double> cos(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_cos_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the tangent of every element with the given tier.
+         * @param x Angles in radians.
+         * @param accuracy Accuracy tier.
+         * @return Tangents of the angles.
+         */
+        static std::vector<double> tan(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_tan_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the sine and cosine of every element with the given tier.
+         * @param x Angles in radians.
+         * @param s Receives the sines.
+         * @param c Receives the cosines.
+         * @param accuracy Accuracy tier.
+         */
+        static void sincos(const std::vector<double>& x, std::vector<double>& s, std::vector<double>& c,
+                           fossil_math_trig_accuracy accuracy) {
+            s.resize(x.size());
+            c.resize(x.size());
+            fossil_math_trig_sincos_array_ex(x.data(), s.data(), c.data(), x.size(), accuracy);
+        }
+
+        /**
+         * @brief Computes the arcsine of every element with the given tier.
+         * @param x Values whose arcsines are to be computed.
+         * @param accuracy Accuracy tier.
+         * @return Angles in radians.
+         */
+        static std::vector<double> asin(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_asin_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the arccosine of every element with the given tier.
+         * @param x Values whose arccosines are to be computed.
+         * @param accuracy Accuracy tier.
+         * @return Angles in radians.
+         */
+        static std::vector<double> acos(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_acos_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the arctangent of every element with the given tier.
+         * @param x Values whose arctangents are to be computed.
+         * @param accuracy Accuracy tier.
+         * @return Angles in radians.
+         */
+        static std::vector<double> atan(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_atan_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes atan2 for every pair of elements with the given tier.
+         * @param y The y coordinates.
+         * @param x The x coordinates.
+         * @param accuracy Accuracy tier.
+         * @return Angles in radians.
+         * @throws std::invalid_argument if the sizes differ.
+         */
+        static std::vector<double> atan2(const std::vector<double>& y, const std::vector<double>& x,
+                                         fossil_math_trig_accuracy accuracy) {
+            if (y.size() != x.size())
+                throw std::invalid_argument("y and x must have the same size");
+            std::vector<double> out(x.size());
+            fossil_math_trig_atan2_array_ex(y.data(), x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the hyperbolic sine of every element with the given tier.
+         * @param x Values.
+         * @param accuracy Accuracy tier.
+         * @return Hyperbolic sines.
+         */
+        static std::vector<double> sinh(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_sinh_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the hyperbolic cosine of every element with the given tier.
+         * @param x Values.
+         * @param accuracy Accuracy tier.
+         * @return Hyperbolic cosines.
+         */
+        static std::vector<double> cosh(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_cosh_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the hyperbolic tangent of every element with the given tier.
+         * @param x Values.
+         * @param accuracy Accuracy tier.
+         * @return Hyperbolic tangents.
+         */
+        static std::vector<double> tanh(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_tanh_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes tanh and its derivative for every element with the given tier.
+         * @param x Values.
+         * @param y Receives the hyperbolic tangents.
+         * @param dy Receives the derivatives 1 - tanh^2.
+         * @param accuracy Accuracy tier.
+         */
+        static void tanh_deriv(const std::vector<double>& x, std::vector<double>& y, std::vector<double>& dy,
+                               fossil_math_trig_accuracy accuracy) {
+            y.resize(x.size());
+            dy.resize(x.size());
+            fossil_math_trig_tanh_deriv_array_ex(x.data(), y.data(), dy.data(), x.size(), accuracy);
+        }
+
+        /**
+         * @brief Computes the inverse hyperbolic sine of every element with the given tier.
+         * @param x Values.
+         * @param accuracy Accuracy tier.
+         * @return Inverse hyperbolic sines.
+         */
+        static std::vector<double> asinh(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_asinh_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the inverse hyperbolic cosine of every element with the given tier.
+         * @param x Values (at least 1).
+         * @param accuracy Accuracy tier.
+         * @return Inverse hyperbolic cosines.
+         */
+        static std::vector<double> acosh(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_acosh_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
+
+        /**
+         * @brief Computes the inverse hyperbolic tangent of every element with the given tier.
+         * @param x Values in (-1, 1).
+         * @param accuracy Accuracy tier.
+         * @return Inverse hyperbolic tangents.
+         */
+        static std::vector<double> atanh(const std::vector<double>& x, fossil_math_trig_accuracy accuracy) {
+            std::vector<double> out(x.size());
+            fossil_math_trig_atanh_array_ex(x.data(), out.data(), x.size(), accuracy);
+            return out;
+        }
     };
 
 } // namespace math
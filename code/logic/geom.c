@@ -23,7 +23,13 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/math/geom.h"
+#include "fossil/math/trig.h"
+#include "simd.h"
+#include <float.h>
 #include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
 
 // ======================================================
 // Distance
@@ -54,18 +60,33 @@ double fossil_math_geom_circle_circumference(fossil_math_geom_circle c) {
     return 2.0 * FOSSIL_MATH_PI * c.radius;
 }
 
+// Squared radius used by the containment tests; -1 rejects every point for a
+// negative or NaN radius.
+static double _circle_r2(fossil_math_geom_circle c) {
+    return (c.radius >= 0.0) ? c.radius * c.radius : -1.0;
+}
+
 int fossil_math_geom_point_in_circle(fossil_math_geom_point2d p,
                                      fossil_math_geom_circle c) {
-    return fossil_math_geom_distance2d(p, c.center) <= c.radius;
+    double dx = p.x - c.center.x;
+    double dy = p.y - c.center.y;
+    return dx*dx + dy*dy <= _circle_r2(c);
 }
 
 // ======================================================
 // Triangle
 // ======================================================
+// Twice the signed area of abc: positive when a, b, c turn counterclockwise.
+static double _geom_orient2d(fossil_math_geom_point2d a,
+                             fossil_math_geom_point2d b,
+                             fossil_math_geom_point2d c) {
+    return a.x*(b.y-c.y) + b.x*(c.y-a.y) + c.x*(a.y-b.y);
+}
+
 double fossil_math_geom_triangle_area(fossil_math_geom_point2d a,
                                       fossil_math_geom_point2d b,
                                       fossil_math_geom_point2d c) {
-    return fabs(0.5 * (a.x*(b.y-c.y) + b.x*(c.y-a.y) + c.x*(a.y-b.y)));
+    return fabs(0.5 * _geom_orient2d(a, b, c));
 }
 
 double fossil_math_geom_triangle_perimeter(fossil_math_geom_point2d a,
@@ -76,6 +97,506 @@ double fossil_math_geom_triangle_perimeter(fossil_math_geom_point2d a,
          + fossil_math_geom_distance2d(c, a);
 }
 
+// ======================================================
+// Convex hull
+// ======================================================
+
+// Hulls of at least this many points are split across threads.
+#define GEOM_HULL_PARALLEL_MIN ((size_t)1 << 16)
+
+// Most slices in a parallel hull, and index slots per slice: each slice owns
+// one slot of this many so fossil_math_parallel_for() hands it to one chunk.
+#define GEOM_HULL_MAX_TASKS 64
+#define GEOM_HULL_TASK_SPAN 64
+
+// Directions of the Akl-Toussaint extreme points, counterclockwise from -y.
+#define GEOM_HULL_DIRS 8
+
+typedef struct {
+    fossil_math_geom_point2d p;
+    size_t index;
+} geom_hull_point;
+
+// Akl-Toussaint filter, then Andrew's monotone chain. Every slice keeps the
+// points outside the polygon of the eight extreme points and reduces them to
+// their own hull; the hull of the slice hulls is the answer. Slice j keeps
+// its points from pts + lo and its chain from stack + 2 * lo.
+typedef struct {
+    const fossil_math_geom_point2d* points;
+    size_t n;
+    size_t tasks;
+    size_t extreme[GEOM_HULL_MAX_TASKS][GEOM_HULL_DIRS];
+    fossil_math_geom_point2d poly[GEOM_HULL_DIRS];
+    size_t poly_size;
+    geom_hull_point* pts;
+    size_t* stack;
+    size_t count[GEOM_HULL_MAX_TASKS];
+} geom_hull;
+
+static void _geom_hull_slice(const geom_hull* job, size_t j, size_t* lo, size_t* hi) {
+    size_t base = job->n / job->tasks, extra = job->n % job->tasks;
+    *lo = j * base + (j < extra ? j : extra);
+    *hi = *lo + base + (j < extra ? 1 : 0);
+}
+
+static int _geom_hull_finite(fossil_math_geom_point2d p) {
+    return isfinite(p.x) && isfinite(p.y);
+}
+
+static void _geom_hull_extremes(void* ctx, size_t begin, size_t end) {
+    geom_hull* job = (geom_hull*)ctx;
+    for (size_t j = (begin + GEOM_HULL_TASK_SPAN - 1) / GEOM_HULL_TASK_SPAN;
+         j < job->tasks && j * GEOM_HULL_TASK_SPAN < end; j++) {
+        size_t lo, hi;
+        double best[GEOM_HULL_DIRS];
+        size_t* ext = job->extreme[j];
+        _geom_hull_slice(job, j, &lo, &hi);
+        for (size_t k = 0; k < GEOM_HULL_DIRS; k++) {
+            best[k] = -INFINITY;
+            ext[k] = SIZE_MAX;
+        }
+        for (size_t i = lo; i < hi; i++) {
+            fossil_math_geom_point2d p = job->points[i];
+            if (!_geom_hull_finite(p))
+                continue;
+            double s = p.x + p.y, d = p.x - p.y;
+            double key[GEOM_HULL_DIRS] = {-p.y, d, p.x, s, p.y, -d, -p.x, -s};
+            for (size_t k = 0; k < GEOM_HULL_DIRS; k++) {
+                if (key[k] > best[k] || ext[k] == SIZE_MAX) {
+                    best[k] = key[k];
+                    ext[k] = i;
+                }
+            }
+        }
+    }
+}
+
+static int _geom_hull_cmp(const void* a, const void* b) {
+    const geom_hull_point* p = (const geom_hull_point*)a;
+    const geom_hull_point* q = (const geom_hull_point*)b;
+    if (p->p.x != q->p.x)
+        return (p->p.x < q->p.x) ? -1 : 1;
+    if (p->p.y != q->p.y)
+        return (p->p.y < q->p.y) ? -1 : 1;
+    return (p->index > q->index) - (p->index < q->index);
+}
+
+// Sorts p[0, k) by (x, y, index), drops repeated points (keeping the lowest
+// index) and writes the positions of the hull vertices into h, counterclockwise
+// from the lowest-x point. Collinear boundary points are left out; turns use
+// the exact sign of fossil_math_geom_orient2d(). h needs room for 2k
+// positions; returns the hull size.
+static size_t _geom_hull_chain(geom_hull_point* p, size_t k, size_t* h) {
+    if (k == 0)
+        return 0;
+    qsort(p, k, sizeof(geom_hull_point), _geom_hull_cmp);
+    size_t u = 1;
+    for (size_t i = 1; i < k; i++)
+        if (p[i].p.x != p[u - 1].p.x || p[i].p.y != p[u - 1].p.y)
+            p[u++] = p[i];
+    size_t m = 0;
+    for (size_t i = 0; i < u; i++) {
+        while (m >= 2 && fossil_math_geom_orient2d(p[h[m - 2]].p, p[h[m - 1]].p, p[i].p) <= 0.0)
+            m--;
+        h[m++] = i;
+    }
+    for (size_t i = u - 1, t = m + 1; i-- > 0;) {
+        while (m >= t && fossil_math_geom_orient2d(p[h[m - 2]].p, p[h[m - 1]].p, p[i].p) <= 0.0)
+            m--;
+        h[m++] = i;
+    }
+    return (m > 1) ? m - 1 : m;
+}
+
+static int _geom_size_cmp(const void* a, const void* b) {
+    size_t x = *(const size_t*)a, y = *(const size_t*)b;
+    return (x > y) - (x < y);
+}
+
+static void _geom_hull_slices(void* ctx, size_t begin, size_t end) {
+    geom_hull* job = (geom_hull*)ctx;
+    for (size_t j = (begin + GEOM_HULL_TASK_SPAN - 1) / GEOM_HULL_TASK_SPAN;
+         j < job->tasks && j * GEOM_HULL_TASK_SPAN < end; j++) {
+        size_t lo, hi, k = 0;
+        _geom_hull_slice(job, j, &lo, &hi);
+        geom_hull_point* pts = job->pts + lo;
+        for (size_t i = lo; i < hi; i++) {
+            fossil_math_geom_point2d p = job->points[i];
+            int inside = job->poly_size > 0;
+            for (size_t e = 0; inside && e < job->poly_size; e++)
+                inside = fossil_math_geom_orient2d(job->poly[e], job->poly[(e + 1) % job->poly_size], p) > 0.0;
+            if (inside || !_geom_hull_finite(p))
+                continue;
+            pts[k].p = p;
+            pts[k].index = i;
+            k++;
+        }
+        // Keep only the slice hull, in position order so it compacts in place.
+        size_t* h = job->stack + 2 * lo;
+        size_t m = _geom_hull_chain(pts, k, h);
+        qsort(h, m, sizeof(size_t), _geom_size_cmp);
+        for (size_t i = 0; i < m; i++)
+            pts[i] = pts[h[i]];
+        job->count[j] = m;
+    }
+}
+
+size_t fossil_math_geom_convex_hull2d(const fossil_math_geom_point2d* points, size_t n, size_t* hull) {
+    if (n == 0)
+        return 0;
+    if (n > SIZE_MAX / (2 * sizeof(geom_hull_point)))
+        return SIZE_MAX;
+    geom_hull job;
+    job.points = points;
+    job.n = n;
+    job.tasks = 1;
+    if (n >= GEOM_HULL_PARALLEL_MIN) {
+        job.tasks = fossil_math_get_threads();
+        if (job.tasks > GEOM_HULL_MAX_TASKS)
+            job.tasks = GEOM_HULL_MAX_TASKS;
+    }
+    job.pts = (geom_hull_point*)malloc(n * sizeof(geom_hull_point));
+    job.stack = (size_t*)malloc(2 * n * sizeof(size_t));
+    if (!job.pts || !job.stack) {
+        free(job.pts);
+        free(job.stack);
+        return SIZE_MAX;
+    }
+    fossil_math_parallel_for(job.tasks * GEOM_HULL_TASK_SPAN, GEOM_HULL_TASK_SPAN, _geom_hull_extremes, &job);
+
+    // Combine the slices in order so ties keep the lowest index, then drop
+    // repeated corners; fewer than three corners filter nothing.
+    size_t ext[GEOM_HULL_DIRS];
+    for (size_t k = 0; k < GEOM_HULL_DIRS; k++) {
+        ext[k] = SIZE_MAX;
+        double best = -INFINITY;
+        for (size_t j = 0; j < job.tasks; j++) {
+            size_t i = job.extreme[j][k];
+            if (i == SIZE_MAX)
+                continue;
+            fossil_math_geom_point2d p = points[i];
+            double s = p.x + p.y, d = p.x - p.y;
+            double key[GEOM_HULL_DIRS] = {-p.y, d, p.x, s, p.y, -d, -p.x, -s};
+            if (ext[k] == SIZE_MAX || key[k] > best) {
+                best = key[k];
+                ext[k] = i;
+            }
+        }
+    }
+    job.poly_size = 0;
+    for (size_t k = 0; k < GEOM_HULL_DIRS && ext[k] != SIZE_MAX; k++) {
+        fossil_math_geom_point2d p = points[ext[k]];
+        if (job.poly_size > 0 && p.x == job.poly[job.poly_size - 1].x && p.y == job.poly[job.poly_size - 1].y)
+            continue;
+        job.poly[job.poly_size++] = p;
+    }
+    while (job.poly_size > 1 && job.poly[0].x == job.poly[job.poly_size - 1].x &&
+           job.poly[0].y == job.poly[job.poly_size - 1].y)
+        job.poly_size--;
+    if (job.poly_size < 3)
+        job.poly_size = 0;
+
+    fossil_math_parallel_for(job.tasks * GEOM_HULL_TASK_SPAN, GEOM_HULL_TASK_SPAN, _geom_hull_slices, &job);
+
+    size_t total = 0;
+    for (size_t j = 0; j < job.tasks; j++) {
+        size_t lo, hi;
+        _geom_hull_slice(&job, j, &lo, &hi);
+        memmove(job.pts + total, job.pts + lo, job.count[j] * sizeof(geom_hull_point));
+        total += job.count[j];
+    }
+    size_t m = _geom_hull_chain(job.pts, total, job.stack);
+    for (size_t i = 0; i < m; i++)
+        hull[i] = job.pts[job.stack[i]].index;
+    free(job.pts);
+    free(job.stack);
+    return m;
+}
+
+// ======================================================
+// Mesh and polygon measures
+// ======================================================
+
+// Sums are split into fixed blocks whose partial sums are added in block
+// order, so the result depends only on the input and never on how the blocks
+// were spread over threads. Blocks grow past GEOM_MEASURE_BLOCK items once
+// there would be more than GEOM_MEASURE_PARTIALS of them.
+#define GEOM_MEASURE_BLOCK 4096
+#define GEOM_MEASURE_PARTIALS 1024
+
+// Block slots per block (see GEOM_HULL_TASK_SPAN), and how many items make
+// splitting across threads worthwhile.
+#define GEOM_MEASURE_SPAN 64
+#define GEOM_MEASURE_GRAIN ((size_t)1 << 16)
+
+typedef struct measure_job measure_job;
+
+// Measures items [lo, hi), storing per-item values in job->out when it is
+// set; returns -1 on an out-of-range vertex index.
+typedef int (*measure_fn)(const measure_job* job, size_t lo, size_t hi, double* sum);
+
+struct measure_job {
+    measure_fn fn;
+    const fossil_math_geom_point2d* p2;
+    const fossil_math_geom_point3d* p3;
+    size_t vertex_count;
+    const size_t* indices;
+    size_t n;
+    fossil_math_geom_point2d origin;
+    double* out;
+    size_t block;
+    double partial[GEOM_MEASURE_PARTIALS];
+    int status[GEOM_MEASURE_PARTIALS];
+};
+
+static size_t _measure_vertex(const measure_job* job, size_t i) {
+    return job->indices ? job->indices[i] : i;
+}
+
+static double _measure_fold(simd_vd acc) {
+    double lanes[SIMD_LANES];
+    double sum = 0.0;
+    simd_store(lanes, acc);
+    for (size_t l = 0; l < SIMD_LANES; l++)
+        sum += lanes[l];
+    return sum;
+}
+
+// Lanes past the end load as zero and so measure zero.
+static simd_vd _measure_load(const double* p, size_t len) {
+    return (len == SIMD_LANES) ? simd_load(p) : simd_load_partial(p, len, 0.0);
+}
+
+static void _measure_emit(const measure_job* job, size_t i, size_t len, simd_vd v) {
+    if (!job->out)
+        return;
+    if (len == SIMD_LANES)
+        simd_store(job->out + i, v);
+    else
+        simd_store_partial(job->out + i, len, v);
+}
+
+// Vertices are gathered a tile at a time into component arrays before the
+// SIMD pass; loading lanes right after writing them one by one would stall
+// on store forwarding.
+#define GEOM_MEASURE_TILE 64
+
+// Gathers the three corners of triangles [t, t + len) into c: corner k of
+// triangle l lands in c[dims * k + d][l].
+static int _measure_corners(const measure_job* job, size_t t, size_t len, size_t dims,
+                            double c[][GEOM_MEASURE_TILE]) {
+    for (size_t l = 0; l < len; l++) {
+        for (size_t k = 0; k < 3; k++) {
+            size_t v = _measure_vertex(job, 3 * (t + l) + k);
+            if (v >= job->vertex_count)
+                return -1;
+            if (dims == 2) {
+                c[2 * k][l] = job->p2[v].x;
+                c[2 * k + 1][l] = job->p2[v].y;
+            } else {
+                c[3 * k][l] = job->p3[v].x;
+                c[3 * k + 1][l] = job->p3[v].y;
+                c[3 * k + 2][l] = job->p3[v].z;
+            }
+        }
+    }
+    return 0;
+}
+
+static int _measure_tri2d(const measure_job* job, size_t lo, size_t hi, double* sum) {
+    simd_vd acc = simd_set1(0.0);
+    double c[6][GEOM_MEASURE_TILE];
+    for (size_t t = lo; t < hi; t += GEOM_MEASURE_TILE) {
+        size_t tile = (hi - t < GEOM_MEASURE_TILE) ? hi - t : GEOM_MEASURE_TILE;
+        if (_measure_corners(job, t, tile, 2, c) != 0)
+            return -1;
+        for (size_t l = 0; l < tile; l += SIMD_LANES) {
+            size_t len = (tile - l < SIMD_LANES) ? tile - l : SIMD_LANES;
+            simd_vd ax = _measure_load(c[0] + l, len), ay = _measure_load(c[1] + l, len);
+            simd_vd bx = _measure_load(c[2] + l, len), by = _measure_load(c[3] + l, len);
+            simd_vd cx = _measure_load(c[4] + l, len), cy = _measure_load(c[5] + l, len);
+            // Same expression as _geom_orient2d().
+            simd_vd o = simd_add(simd_add(simd_mul(ax, simd_sub(by, cy)), simd_mul(bx, simd_sub(cy, ay))),
+                                 simd_mul(cx, simd_sub(ay, by)));
+            simd_vd area = simd_abs(simd_mul(simd_set1(0.5), o));
+            _measure_emit(job, t + l, len, area);
+            acc = simd_add(acc, area);
+        }
+    }
+    *sum = _measure_fold(acc);
+    return 0;
+}
+
+static int _measure_tri3d(const measure_job* job, size_t lo, size_t hi, double* sum) {
+    simd_vd acc = simd_set1(0.0);
+    double c[9][GEOM_MEASURE_TILE];
+    for (size_t t = lo; t < hi; t += GEOM_MEASURE_TILE) {
+        size_t tile = (hi - t < GEOM_MEASURE_TILE) ? hi - t : GEOM_MEASURE_TILE;
+        if (_measure_corners(job, t, tile, 3, c) != 0)
+            return -1;
+        for (size_t l = 0; l < tile; l += SIMD_LANES) {
+            size_t len = (tile - l < SIMD_LANES) ? tile - l : SIMD_LANES;
+            simd_vd ax = _measure_load(c[0] + l, len), ay = _measure_load(c[1] + l, len);
+            simd_vd az = _measure_load(c[2] + l, len);
+            simd_vd ux = simd_sub(_measure_load(c[3] + l, len), ax), uy = simd_sub(_measure_load(c[4] + l, len), ay);
+            simd_vd uz = simd_sub(_measure_load(c[5] + l, len), az);
+            simd_vd vx = simd_sub(_measure_load(c[6] + l, len), ax), vy = simd_sub(_measure_load(c[7] + l, len), ay);
+            simd_vd vz = simd_sub(_measure_load(c[8] + l, len), az);
+            simd_vd nx = simd_sub(simd_mul(uy, vz), simd_mul(uz, vy));
+            simd_vd ny = simd_sub(simd_mul(uz, vx), simd_mul(ux, vz));
+            simd_vd nz = simd_sub(simd_mul(ux, vy), simd_mul(uy, vx));
+            simd_vd n2 = simd_add(simd_add(simd_mul(nx, nx), simd_mul(ny, ny)), simd_mul(nz, nz));
+            simd_vd area = simd_mul(simd_set1(0.5), simd_sqrt(n2));
+            _measure_emit(job, t + l, len, area);
+            acc = simd_add(acc, area);
+        }
+    }
+    *sum = _measure_fold(acc);
+    return 0;
+}
+
+// Gathers polygon vertices [i, i + len], wrapping vertex n to vertex 0, so
+// edge l runs from (x[l], y[l]) to (x[l + 1], y[l + 1]). Coordinates are
+// taken relative to job->origin so far-from-zero polygons keep their digits.
+static int _measure_ring(const measure_job* job, size_t i, size_t len,
+                         double* x, double* y) {
+    for (size_t l = 0; l <= len; l++) {
+        size_t v = _measure_vertex(job, (i + l == job->n) ? 0 : i + l);
+        if (v >= job->vertex_count)
+            return -1;
+        x[l] = job->p2[v].x - job->origin.x;
+        y[l] = job->p2[v].y - job->origin.y;
+    }
+    return 0;
+}
+
+static int _measure_shoelace(const measure_job* job, size_t lo, size_t hi, double* sum) {
+    simd_vd acc = simd_set1(0.0);
+    double x[GEOM_MEASURE_TILE + 1], y[GEOM_MEASURE_TILE + 1];
+    for (size_t i = lo; i < hi; i += GEOM_MEASURE_TILE) {
+        size_t tile = (hi - i < GEOM_MEASURE_TILE) ? hi - i : GEOM_MEASURE_TILE;
+        if (_measure_ring(job, i, tile, x, y) != 0)
+            return -1;
+        for (size_t l = 0; l < tile; l += SIMD_LANES) {
+            size_t len = (tile - l < SIMD_LANES) ? tile - l : SIMD_LANES;
+            simd_vd cross = simd_sub(simd_mul(_measure_load(x + l, len), _measure_load(y + l + 1, len)),
+                                     simd_mul(_measure_load(x + l + 1, len), _measure_load(y + l, len)));
+            acc = simd_add(acc, cross);
+        }
+    }
+    *sum = 0.5 * _measure_fold(acc);
+    return 0;
+}
+
+static int _measure_perimeter(const measure_job* job, size_t lo, size_t hi, double* sum) {
+    simd_vd acc = simd_set1(0.0);
+    double x[GEOM_MEASURE_TILE + 1], y[GEOM_MEASURE_TILE + 1];
+    for (size_t i = lo; i < hi; i += GEOM_MEASURE_TILE) {
+        size_t tile = (hi - i < GEOM_MEASURE_TILE) ? hi - i : GEOM_MEASURE_TILE;
+        if (_measure_ring(job, i, tile, x, y) != 0)
+            return -1;
+        for (size_t l = 0; l < tile; l += SIMD_LANES) {
+            size_t len = (tile - l < SIMD_LANES) ? tile - l : SIMD_LANES;
+            simd_vd dx = simd_sub(_measure_load(x + l + 1, len), _measure_load(x + l, len));
+            simd_vd dy = simd_sub(_measure_load(y + l + 1, len), _measure_load(y + l, len));
+            acc = simd_add(acc, simd_sqrt(simd_add(simd_mul(dx, dx), simd_mul(dy, dy))));
+        }
+    }
+    *sum = _measure_fold(acc);
+    return 0;
+}
+
+static void _measure_blocks(void* ctx, size_t begin, size_t end) {
+    measure_job* job = (measure_job*)ctx;
+    size_t blocks = (job->n + job->block - 1) / job->block;
+    for (size_t j = (begin + GEOM_MEASURE_SPAN - 1) / GEOM_MEASURE_SPAN;
+         j < blocks && j * GEOM_MEASURE_SPAN < end; j++) {
+        size_t lo = j * job->block;
+        size_t hi = (job->n - lo < job->block) ? job->n : lo + job->block;
+        job->status[j] = job->fn(job, lo, hi, &job->partial[j]);
+    }
+}
+
+static int _measure_run(measure_job* job, double* total) {
+    double sum = 0.0;
+    if (job->n > 0) {
+        size_t block = (job->n + GEOM_MEASURE_PARTIALS - 1) / GEOM_MEASURE_PARTIALS;
+        block = (block < GEOM_MEASURE_BLOCK) ? GEOM_MEASURE_BLOCK
+                                             : (block + GEOM_MEASURE_SPAN - 1) / GEOM_MEASURE_SPAN * GEOM_MEASURE_SPAN;
+        size_t blocks = (job->n + block - 1) / block;
+        job->block = block;
+        fossil_math_parallel_for(blocks * GEOM_MEASURE_SPAN, GEOM_MEASURE_GRAIN / GEOM_MEASURE_BLOCK * GEOM_MEASURE_SPAN,
+                                 _measure_blocks, job);
+        for (size_t j = 0; j < blocks; j++) {
+            if (job->status[j] != 0)
+                return -1;
+            sum += job->partial[j];
+        }
+    }
+    if (total)
+        *total = sum;
+    return 0;
+}
+
+int fossil_math_geom_mesh_area2d(const fossil_math_geom_point2d* vertices, size_t vertex_count,
+                                 const size_t* indices, size_t triangle_count, double* areas, double* total) {
+    if (triangle_count > SIZE_MAX / 3)
+        return -1;
+    measure_job job;
+    job.fn = _measure_tri2d;
+    job.p2 = vertices;
+    job.p3 = NULL;
+    job.vertex_count = vertex_count;
+    job.indices = indices;
+    job.n = triangle_count;
+    job.out = areas;
+    return _measure_run(&job, total);
+}
+
+int fossil_math_geom_mesh_area3d(const fossil_math_geom_point3d* vertices, size_t vertex_count,
+                                 const size_t* indices, size_t triangle_count, double* areas, double* total) {
+    if (triangle_count > SIZE_MAX / 3)
+        return -1;
+    measure_job job;
+    job.fn = _measure_tri3d;
+    job.p2 = NULL;
+    job.p3 = vertices;
+    job.vertex_count = vertex_count;
+    job.indices = indices;
+    job.n = triangle_count;
+    job.out = areas;
+    return _measure_run(&job, total);
+}
+
+static int _measure_polygon(measure_fn fn, const fossil_math_geom_point2d* vertices, size_t vertex_count,
+                            const size_t* indices, size_t n, double* out) {
+    measure_job job;
+    job.fn = fn;
+    job.p2 = vertices;
+    job.p3 = NULL;
+    job.vertex_count = vertex_count;
+    job.indices = indices;
+    job.n = n;
+    job.out = NULL;
+    if (n > 0) {
+        size_t first = _measure_vertex(&job, 0);
+        if (first >= vertex_count)
+            return -1;
+        job.origin = vertices[first];
+    }
+    return _measure_run(&job, out);
+}
+
+int fossil_math_geom_polygon_area(const fossil_math_geom_point2d* vertices, size_t vertex_count,
+                                  const size_t* indices, size_t n, double* area) {
+    return _measure_polygon(_measure_shoelace, vertices, vertex_count, indices, n, area);
+}
+
+int fossil_math_geom_polygon_perimeter(const fossil_math_geom_point2d* vertices, size_t vertex_count,
+                                       const size_t* indices, size_t n, double* perimeter) {
+    return _measure_polygon(_measure_perimeter, vertices, vertex_count, indices, n, perimeter);
+}
+
 // ======================================================
 // 2D Transformations
 // ======================================================
@@ -92,14 +613,1728 @@ fossil_math_geom_point2d fossil_math_geom_scale2d(fossil_math_geom_point2d p, do
 }
 
 fossil_math_geom_point2d fossil_math_geom_rotate2d(fossil_math_geom_point2d p, double angle_rad) {
-    double cos_a = cos(angle_rad);
-    double sin_a = sin(angle_rad);
+    double sin_a, cos_a;
+    fossil_math_trig_sincos(angle_rad, &sin_a, &cos_a);
     fossil_math_geom_point2d result;
     result.x = p.x * cos_a - p.y * sin_a;
     result.y = p.x * sin_a + p.y * cos_a;
     return result;
 }
 
+// Angles are processed in stack-sized chunks through the array sincos.
+#define GEOM_ROTATE_CHUNK 256
+
+void fossil_math_geom_rotate2d_array(const fossil_math_geom_point2d* in, const double* angles_rad,
+                                     fossil_math_geom_point2d* out, size_t n) {
+    double sin_a[GEOM_ROTATE_CHUNK];
+    double cos_a[GEOM_ROTATE_CHUNK];
+    for (size_t i = 0; i < n; i += GEOM_ROTATE_CHUNK) {
+        size_t len = (n - i < GEOM_ROTATE_CHUNK) ? n - i : GEOM_ROTATE_CHUNK;
+        fossil_math_trig_sincos_array(angles_rad + i, sin_a, cos_a, len);
+        for (size_t j = 0; j < len; j++) {
+            fossil_math_geom_point2d p = in[i + j];
+            out[i + j].x = p.x * cos_a[j] - p.y * sin_a[j];
+            out[i + j].y = p.x * sin_a[j] + p.y * cos_a[j];
+        }
+    }
+}
+
+// ======================================================
+// Polar and spherical coordinates
+// ======================================================
+
+// Coordinates are converted in stack-sized chunks: the angles go through
+// the array atan2/sincos and the lengths through SIMD below. Every chunk
+// reads its inputs before writing, so outputs may alias inputs.
+#define GEOM_COORD_CHUNK 256
+
+// out[i] = sqrt(a[i]^2 + b[i]^2).
+static void _geom_norm2(const double* a, const double* b, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + SIMD_LANES <= n; i += SIMD_LANES) {
+        simd_vd va = simd_load(a + i);
+        simd_vd vb = simd_load(b + i);
+        simd_store(out + i, simd_sqrt(simd_add(simd_mul(va, va), simd_mul(vb, vb))));
+    }
+    for (; i < n; i++)
+        out[i] = sqrt(a[i] * a[i] + b[i] * b[i]);
+}
+
+// out[i] = r[i] * c[i].
+static void _geom_scale(const double* r, const double* c, double* out, size_t n) {
+    size_t i = 0;
+    for (; i + SIMD_LANES <= n; i += SIMD_LANES)
+        simd_store(out + i, simd_mul(simd_load(r + i), simd_load(c + i)));
+    for (; i < n; i++)
+        out[i] = r[i] * c[i];
+}
+
+static void _polar_chunk(const double* x, const double* y, double* r, double* theta, size_t n) {
+    double t[GEOM_COORD_CHUNK];
+    fossil_math_trig_atan2_array(y, x, t, n);
+    _geom_norm2(x, y, r, n);
+    memcpy(theta, t, n * sizeof(double));
+}
+
+static void _cartesian_chunk(const double* r, const double* theta, double* x, double* y, size_t n) {
+    double s[GEOM_COORD_CHUNK], c[GEOM_COORD_CHUNK];
+    fossil_math_trig_sincos_array(theta, s, c, n);
+    _geom_scale(r, s, s, n);
+    _geom_scale(r, c, x, n);
+    memcpy(y, s, n * sizeof(double));
+}
+
+static void _spherical_chunk(const double* x, const double* y, const double* z,
+                             double* r, double* theta, double* phi, size_t n) {
+    double rho[GEOM_COORD_CHUNK], t[GEOM_COORD_CHUNK], p[GEOM_COORD_CHUNK];
+    fossil_math_trig_atan2_array(y, x, t, n);
+    _geom_norm2(x, y, rho, n);
+    // The polar angle from atan2 stays accurate near the poles, unlike acos(z / r).
+    fossil_math_trig_atan2_array(rho, z, p, n);
+    _geom_norm2(rho, z, r, n);
+    memcpy(theta, t, n * sizeof(double));
+    memcpy(phi, p, n * sizeof(double));
+}
+
+static void _cartesian3_chunk(const double* r, const double* theta, const double* phi,
+                              double* x, double* y, double* z, size_t n) {
+    double st[GEOM_COORD_CHUNK], ct[GEOM_COORD_CHUNK], sp[GEOM_COORD_CHUNK], cp[GEOM_COORD_CHUNK];
+    fossil_math_trig_sincos_array(theta, st, ct, n);
+    fossil_math_trig_sincos_array(phi, sp, cp, n);
+    _geom_scale(r, sp, sp, n);
+    _geom_scale(r, cp, z, n);
+    _geom_scale(sp, ct, x, n);
+    _geom_scale(sp, st, y, n);
+}
+
+void fossil_math_geom_cart_to_polar_soa(const double* x, const double* y, double* r, double* theta, size_t n) {
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        _polar_chunk(x + i, y + i, r + i, theta + i, len);
+    }
+}
+
+void fossil_math_geom_polar_to_cart_soa(const double* r, const double* theta, double* x, double* y, size_t n) {
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        _cartesian_chunk(r + i, theta + i, x + i, y + i, len);
+    }
+}
+
+void fossil_math_geom_cart_to_spherical_soa(const double* x, const double* y, const double* z,
+                                            double* r, double* theta, double* phi, size_t n) {
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        _spherical_chunk(x + i, y + i, z + i, r + i, theta + i, phi + i, len);
+    }
+}
+
+void fossil_math_geom_spherical_to_cart_soa(const double* r, const double* theta, const double* phi,
+                                            double* x, double* y, double* z, size_t n) {
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        _cartesian3_chunk(r + i, theta + i, phi + i, x + i, y + i, z + i, len);
+    }
+}
+
+// The point-array forms split each chunk into components, convert it with
+// the SoA kernels and interleave the result back.
+void fossil_math_geom_cart_to_polar_array(const fossil_math_geom_point2d* in, fossil_math_geom_point2d* out, size_t n) {
+    double a[GEOM_COORD_CHUNK], b[GEOM_COORD_CHUNK];
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        for (size_t j = 0; j < len; j++) {
+            a[j] = in[i + j].x;
+            b[j] = in[i + j].y;
+        }
+        _polar_chunk(a, b, a, b, len);
+        for (size_t j = 0; j < len; j++) {
+            out[i + j].x = a[j];
+            out[i + j].y = b[j];
+        }
+    }
+}
+
+void fossil_math_geom_polar_to_cart_array(const fossil_math_geom_point2d* in, fossil_math_geom_point2d* out, size_t n) {
+    double a[GEOM_COORD_CHUNK], b[GEOM_COORD_CHUNK];
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        for (size_t j = 0; j < len; j++) {
+            a[j] = in[i + j].x;
+            b[j] = in[i + j].y;
+        }
+        _cartesian_chunk(a, b, a, b, len);
+        for (size_t j = 0; j < len; j++) {
+            out[i + j].x = a[j];
+            out[i + j].y = b[j];
+        }
+    }
+}
+
+void fossil_math_geom_cart_to_spherical_array(const fossil_math_geom_point3d* in, fossil_math_geom_point3d* out, size_t n) {
+    double a[GEOM_COORD_CHUNK], b[GEOM_COORD_CHUNK], c[GEOM_COORD_CHUNK];
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        for (size_t j = 0; j < len; j++) {
+            a[j] = in[i + j].x;
+            b[j] = in[i + j].y;
+            c[j] = in[i + j].z;
+        }
+        _spherical_chunk(a, b, c, a, b, c, len);
+        for (size_t j = 0; j < len; j++) {
+            out[i + j].x = a[j];
+            out[i + j].y = b[j];
+            out[i + j].z = c[j];
+        }
+    }
+}
+
+void fossil_math_geom_spherical_to_cart_array(const fossil_math_geom_point3d* in, fossil_math_geom_point3d* out, size_t n) {
+    double a[GEOM_COORD_CHUNK], b[GEOM_COORD_CHUNK], c[GEOM_COORD_CHUNK];
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        for (size_t j = 0; j < len; j++) {
+            a[j] = in[i + j].x;
+            b[j] = in[i + j].y;
+            c[j] = in[i + j].z;
+        }
+        _cartesian3_chunk(a, b, c, a, b, c, len);
+        for (size_t j = 0; j < len; j++) {
+            out[i + j].x = a[j];
+            out[i + j].y = b[j];
+            out[i + j].z = c[j];
+        }
+    }
+}
+
+// ======================================================
+// Point clouds (SoA)
+// ======================================================
+
+// A cloud is one aligned block: the header rounded up to a cache line, then
+// each component array padded to a whole number of cache lines.
+#define GEOM_CLOUD_LINE (FOSSIL_MATH_ALIGNMENT / sizeof(double))
+
+// Clouds at least this large are split across the fossil_math_set_threads()
+// threads; every point is independent of the others.
+#define GEOM_CLOUD_GRAIN ((size_t)1 << 16)
+
+static void* _cloud_alloc(size_t header, size_t n, size_t dims, double** comps) {
+    size_t head = (header + FOSSIL_MATH_ALIGNMENT - 1) & ~(size_t)(FOSSIL_MATH_ALIGNMENT - 1);
+    if (n > SIZE_MAX / sizeof(double) / dims - GEOM_CLOUD_LINE)
+        return NULL;
+    size_t stride = (n + GEOM_CLOUD_LINE - 1) / GEOM_CLOUD_LINE * GEOM_CLOUD_LINE;
+    size_t bytes = stride * dims * sizeof(double);
+    if (bytes > SIZE_MAX - head)
+        return NULL;
+    unsigned char* block = (unsigned char*)fossil_math_aligned_alloc(head + bytes);
+    if (!block)
+        return NULL;
+    memset(block, 0, head + bytes);
+    for (size_t d = 0; d < dims; d++)
+        comps[d] = (double*)(block + head) + d * stride;
+    return block;
+}
+
+typedef struct {
+    const double* c[3];
+    double q[3];
+    size_t dims;
+    int root;
+    double* out;
+} cloud_job;
+
+static void _cloud_range(void* ctx, size_t begin, size_t end) {
+    const cloud_job* job = (const cloud_job*)ctx;
+    simd_vd q[3];
+    for (size_t d = 0; d < job->dims; d++)
+        q[d] = simd_set1(job->q[d]);
+    for (size_t i = begin; i < end; i += SIMD_LANES) {
+        size_t len = (end - i < SIMD_LANES) ? end - i : SIMD_LANES;
+        simd_vd acc = simd_set1(0.0);
+        for (size_t d = 0; d < job->dims; d++) {
+            simd_vd v = (len == SIMD_LANES) ? simd_load(job->c[d] + i)
+                                            : simd_load_partial(job->c[d] + i, len, 0.0);
+            simd_vd t = simd_sub(v, q[d]);
+            acc = simd_add(acc, simd_mul(t, t));
+        }
+        if (job->root)
+            acc = simd_sqrt(acc);
+        if (len == SIMD_LANES)
+            simd_store(job->out + i, acc);
+        else
+            simd_store_partial(job->out + i, len, acc);
+    }
+}
+
+static void _cloud_distance(const double* const* comps, const double* q, size_t dims, size_t n,
+                            int root, double* out) {
+    cloud_job job = {{comps[0], comps[1], dims > 2 ? comps[2] : NULL}, {q[0], q[1], dims > 2 ? q[2] : 0.0},
+                     dims, root, out};
+    fossil_math_parallel_for(n, GEOM_CLOUD_GRAIN, _cloud_range, &job);
+}
+
+fossil_math_geom_cloud2d* fossil_math_geom_cloud2d_create(size_t n) {
+    double* comps[2];
+    fossil_math_geom_cloud2d* cloud =
+        (fossil_math_geom_cloud2d*)_cloud_alloc(sizeof(fossil_math_geom_cloud2d), n, 2, comps);
+    if (!cloud)
+        return NULL;
+    cloud->x = comps[0];
+    cloud->y = comps[1];
+    cloud->size = n;
+    return cloud;
+}
+
+fossil_math_geom_cloud2d* fossil_math_geom_cloud2d_from_points(const fossil_math_geom_point2d* points, size_t n) {
+    if (!points && n)
+        return NULL;
+    fossil_math_geom_cloud2d* cloud = fossil_math_geom_cloud2d_create(n);
+    if (!cloud)
+        return NULL;
+    for (size_t i = 0; i < n; i++) {
+        cloud->x[i] = points[i].x;
+        cloud->y[i] = points[i].y;
+    }
+    return cloud;
+}
+
+void fossil_math_geom_cloud2d_destroy(fossil_math_geom_cloud2d* cloud) {
+    fossil_math_aligned_free(cloud);
+}
+
+void fossil_math_geom_cloud2d_to_points(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d* out) {
+    for (size_t i = 0; i < cloud->size; i++) {
+        out[i].x = cloud->x[i];
+        out[i].y = cloud->y[i];
+    }
+}
+
+void fossil_math_geom_cloud2d_distance(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d q, double* out) {
+    const double* comps[2] = {cloud->x, cloud->y};
+    double qv[2] = {q.x, q.y};
+    _cloud_distance(comps, qv, 2, cloud->size, 1, out);
+}
+
+void fossil_math_geom_cloud2d_distance_sq(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d q, double* out) {
+    const double* comps[2] = {cloud->x, cloud->y};
+    double qv[2] = {q.x, q.y};
+    _cloud_distance(comps, qv, 2, cloud->size, 0, out);
+}
+
+// Containment masks are built one 64-point word at a time; threads split the
+// cloud on word boundaries so each word has a single writer.
+typedef struct {
+    const double* x;
+    const double* y;
+    size_t n;
+    const fossil_math_geom_circle* circles;
+    size_t m;
+    uint64_t* mask;
+    size_t words;
+    size_t first;
+} circle_job;
+
+static void _circle_words(void* ctx, size_t begin, size_t end) {
+    const circle_job* job = (const circle_job*)ctx;
+    for (size_t w = begin; w < end; w++) {
+        size_t base = w * 64;
+        size_t stop = (job->n - base < 64) ? job->n : base + 64;
+        uint64_t* row = job->mask + (w - job->first);
+        for (size_t j = 0; j < job->m; j++)
+            row[j * job->words] = 0;
+        for (size_t i = base; i < stop; i += SIMD_LANES) {
+            size_t len = (stop - i < SIMD_LANES) ? stop - i : SIMD_LANES;
+            simd_vd x, y;
+            if (len == SIMD_LANES) {
+                x = simd_load(job->x + i);
+                y = simd_load(job->y + i);
+            } else {
+                x = simd_load_partial(job->x + i, len, 0.0);
+                y = simd_load_partial(job->y + i, len, 0.0);
+            }
+            int live = (int)(((unsigned)1 << len) - 1);
+            for (size_t j = 0; j < job->m; j++) {
+                fossil_math_geom_circle c = job->circles[j];
+                simd_vd dx = simd_sub(x, simd_set1(c.center.x));
+                simd_vd dy = simd_sub(y, simd_set1(c.center.y));
+                simd_vd d2 = simd_add(simd_mul(dx, dx), simd_mul(dy, dy));
+                int bits = simd_mask_bits(simd_le(d2, simd_set1(_circle_r2(c)))) & live;
+                row[j * job->words] |= (uint64_t)bits << (i - base);
+            }
+        }
+    }
+}
+
+static size_t _popcount64(uint64_t v) {
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (size_t)((v * 0x0101010101010101ULL) >> 56);
+}
+
+size_t fossil_math_geom_cloud2d_in_circles_mask(const fossil_math_geom_cloud2d* cloud,
+                                                const fossil_math_geom_circle* circles, size_t m, uint64_t* mask) {
+    size_t words = FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size);
+    if (m == 0 || words == 0)
+        return 0;
+    circle_job job = {cloud->x, cloud->y, cloud->size, circles, m, mask, words, 0};
+    fossil_math_parallel_for(words, GEOM_CLOUD_GRAIN / 64, _circle_words, &job);
+    size_t count = 0;
+    for (size_t k = 0; k < m * words; k++)
+        count += _popcount64(mask[k]);
+    return count;
+}
+
+size_t fossil_math_geom_cloud2d_in_circle_mask(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_circle c,
+                                               uint64_t* mask) {
+    return fossil_math_geom_cloud2d_in_circles_mask(cloud, &c, 1, mask);
+}
+
+// Matches are compacted a mask chunk at a time so the index list stays in order.
+#define GEOM_INDEX_WORDS 8
+
+size_t fossil_math_geom_cloud2d_in_circle_indices(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_circle c,
+                                                  size_t* indices) {
+    uint64_t mask[GEOM_INDEX_WORDS];
+    size_t words = FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size);
+    size_t count = 0;
+    circle_job job = {cloud->x, cloud->y, cloud->size, &c, 1, mask, GEOM_INDEX_WORDS, 0};
+    for (size_t w = 0; w < words; w += GEOM_INDEX_WORDS) {
+        size_t len = (words - w < GEOM_INDEX_WORDS) ? words - w : GEOM_INDEX_WORDS;
+        job.first = w;
+        _circle_words(&job, w, w + len);
+        for (size_t k = 0; k < len; k++) {
+            size_t base = (w + k) * 64;
+            for (uint64_t bits = mask[k]; bits; bits >>= 1, base++)
+                if (bits & 1)
+                    indices[count++] = base;
+        }
+    }
+    return count;
+}
+
+fossil_math_geom_cloud3d* fossil_math_geom_cloud3d_create(size_t n) {
+    double* comps[3];
+    fossil_math_geom_cloud3d* cloud =
+        (fossil_math_geom_cloud3d*)_cloud_alloc(sizeof(fossil_math_geom_cloud3d), n, 3, comps);
+    if (!cloud)
+        return NULL;
+    cloud->x = comps[0];
+    cloud->y = comps[1];
+    cloud->z = comps[2];
+    cloud->size = n;
+    return cloud;
+}
+
+fossil_math_geom_cloud3d* fossil_math_geom_cloud3d_from_points(const fossil_math_geom_point3d* points, size_t n) {
+    if (!points && n)
+        return NULL;
+    fossil_math_geom_cloud3d* cloud = fossil_math_geom_cloud3d_create(n);
+    if (!cloud)
+        return NULL;
+    for (size_t i = 0; i < n; i++) {
+        cloud->x[i] = points[i].x;
+        cloud->y[i] = points[i].y;
+        cloud->z[i] = points[i].z;
+    }
+    return cloud;
+}
+
+void fossil_math_geom_cloud3d_destroy(fossil_math_geom_cloud3d* cloud) {
+    fossil_math_aligned_free(cloud);
+}
+
+void fossil_math_geom_cloud3d_to_points(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d* out) {
+    for (size_t i = 0; i < cloud->size; i++) {
+        out[i].x = cloud->x[i];
+        out[i].y = cloud->y[i];
+        out[i].z = cloud->z[i];
+    }
+}
+
+void fossil_math_geom_cloud3d_distance(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d q, double* out) {
+    const double* comps[3] = {cloud->x, cloud->y, cloud->z};
+    double qv[3] = {q.x, q.y, q.z};
+    _cloud_distance(comps, qv, 3, cloud->size, 1, out);
+}
+
+void fossil_math_geom_cloud3d_distance_sq(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d q, double* out) {
+    const double* comps[3] = {cloud->x, cloud->y, cloud->z};
+    double qv[3] = {q.x, q.y, q.z};
+    _cloud_distance(comps, qv, 3, cloud->size, 0, out);
+}
+
+// Pairwise distances are computed like a blocked matrix product: tiles of
+// rows x columns small enough to stay in L1, and GEOM_CDIST_ROWS rows at a
+// time so each load of b feeds several rows. With only two or three
+// coordinates the |a|^2 + |b|^2 - 2 a.b expansion saves no arithmetic over the
+// differences and cancels for nearby points, so the kernel subtracts directly.
+#define GEOM_CDIST_ROWS 4
+#define GEOM_CDIST_TILE_ROWS 16
+#define GEOM_CDIST_TILE_COLS 256
+
+typedef struct {
+    const double* a[3];
+    size_t n;
+    const double* b[3];
+    size_t m;
+    size_t dims;
+    int root;
+    double* out;
+    size_t k;
+    size_t* idx;
+    double* dist;
+} cdist_job;
+
+// Writes the squared (or, with root, plain) distances from rows
+// [i0, i0 + rows) of a to columns [j0, j0 + cols) of b into dst, whose rows
+// are ld apart. Short row groups repeat their last row in the unused slots.
+static void _cdist_tile(const cdist_job* job, size_t i0, size_t rows, size_t j0, size_t cols,
+                        double* dst, size_t ld, int root) {
+    for (size_t r = 0; r < rows; r += GEOM_CDIST_ROWS) {
+        size_t live = (rows - r < GEOM_CDIST_ROWS) ? rows - r : GEOM_CDIST_ROWS;
+        simd_vd ax[GEOM_CDIST_ROWS], ay[GEOM_CDIST_ROWS], az[GEOM_CDIST_ROWS];
+        for (size_t q = 0; q < GEOM_CDIST_ROWS; q++) {
+            size_t i = i0 + r + ((q < live) ? q : live - 1);
+            ax[q] = simd_set1(job->a[0][i]);
+            ay[q] = simd_set1(job->a[1][i]);
+            az[q] = simd_set1((job->dims > 2) ? job->a[2][i] : 0.0);
+        }
+        for (size_t c = 0; c < cols; c += SIMD_LANES) {
+            size_t len = (cols - c < SIMD_LANES) ? cols - c : SIMD_LANES;
+            size_t j = j0 + c;
+            simd_vd bx, by, bz;
+            if (len == SIMD_LANES) {
+                bx = simd_load(job->b[0] + j);
+                by = simd_load(job->b[1] + j);
+                bz = (job->dims > 2) ? simd_load(job->b[2] + j) : simd_set1(0.0);
+            } else {
+                bx = simd_load_partial(job->b[0] + j, len, 0.0);
+                by = simd_load_partial(job->b[1] + j, len, 0.0);
+                bz = (job->dims > 2) ? simd_load_partial(job->b[2] + j, len, 0.0) : simd_set1(0.0);
+            }
+            for (size_t q = 0; q < live; q++) {
+                simd_vd dx = simd_sub(ax[q], bx), dy = simd_sub(ay[q], by), dz = simd_sub(az[q], bz);
+                simd_vd d2 = simd_add(simd_add(simd_mul(dx, dx), simd_mul(dy, dy)), simd_mul(dz, dz));
+                if (root)
+                    d2 = simd_sqrt(d2);
+                double* row = dst + (r + q) * ld + c;
+                if (len == SIMD_LANES)
+                    simd_store(row, d2);
+                else
+                    simd_store_partial(row, len, d2);
+            }
+        }
+    }
+}
+
+static void _cdist_rows(void* ctx, size_t begin, size_t end) {
+    const cdist_job* job = (const cdist_job*)ctx;
+    for (size_t i0 = begin; i0 < end; i0 += GEOM_CDIST_TILE_ROWS) {
+        size_t rows = (end - i0 < GEOM_CDIST_TILE_ROWS) ? end - i0 : GEOM_CDIST_TILE_ROWS;
+        for (size_t j0 = 0; j0 < job->m; j0 += GEOM_CDIST_TILE_COLS) {
+            size_t cols = (job->m - j0 < GEOM_CDIST_TILE_COLS) ? job->m - j0 : GEOM_CDIST_TILE_COLS;
+            _cdist_tile(job, i0, rows, j0, cols, job->out + i0 * job->m + j0, job->m, job->root);
+        }
+    }
+}
+
+// Top-k rows are max-heaps on (squared distance, index) kept in the output
+// arrays themselves; columns arrive in increasing index order, so a new
+// column only displaces the root when it is strictly closer.
+static int _cdist_worse(const double* d, const size_t* ix, size_t a, size_t b) {
+    return d[a] > d[b] || (d[a] == d[b] && ix[a] > ix[b]);
+}
+
+static void _cdist_swap(double* d, size_t* ix, size_t a, size_t b) {
+    double td = d[a];
+    size_t ti = ix[a];
+    d[a] = d[b];
+    ix[a] = ix[b];
+    d[b] = td;
+    ix[b] = ti;
+}
+
+static void _cdist_sift_down(double* d, size_t* ix, size_t size, size_t p) {
+    for (;;) {
+        size_t c = 2 * p + 1;
+        if (c >= size)
+            return;
+        if (c + 1 < size && _cdist_worse(d, ix, c + 1, c))
+            c++;
+        if (!_cdist_worse(d, ix, c, p))
+            return;
+        _cdist_swap(d, ix, c, p);
+        p = c;
+    }
+}
+
+static void _cdist_topk_rows(void* ctx, size_t begin, size_t end) {
+    const cdist_job* job = (const cdist_job*)ctx;
+    double tile[GEOM_CDIST_TILE_ROWS * GEOM_CDIST_TILE_COLS];
+    size_t fill[GEOM_CDIST_TILE_ROWS];
+    size_t k = job->k;
+    for (size_t i0 = begin; i0 < end; i0 += GEOM_CDIST_TILE_ROWS) {
+        size_t rows = (end - i0 < GEOM_CDIST_TILE_ROWS) ? end - i0 : GEOM_CDIST_TILE_ROWS;
+        memset(fill, 0, sizeof(fill));
+        for (size_t j0 = 0; j0 < job->m; j0 += GEOM_CDIST_TILE_COLS) {
+            size_t cols = (job->m - j0 < GEOM_CDIST_TILE_COLS) ? job->m - j0 : GEOM_CDIST_TILE_COLS;
+            _cdist_tile(job, i0, rows, j0, cols, tile, GEOM_CDIST_TILE_COLS, 0);
+            for (size_t r = 0; r < rows; r++) {
+                double* hd = job->dist + (i0 + r) * k;
+                size_t* hi = job->idx + (i0 + r) * k;
+                const double* t = tile + r * GEOM_CDIST_TILE_COLS;
+                for (size_t c = 0; c < cols; c++) {
+                    double d = t[c];
+                    if (fill[r] == k) {
+                        if (d < hd[0]) {
+                            hd[0] = d;
+                            hi[0] = j0 + c;
+                            _cdist_sift_down(hd, hi, k, 0);
+                        }
+                    } else if (d == d) {
+                        // Sift the new entry up from the end.
+                        size_t p = fill[r]++;
+                        hd[p] = d;
+                        hi[p] = j0 + c;
+                        while (p > 0 && _cdist_worse(hd, hi, p, (p - 1) / 2)) {
+                            _cdist_swap(hd, hi, p, (p - 1) / 2);
+                            p = (p - 1) / 2;
+                        }
+                    }
+                }
+            }
+        }
+        // Heap-sort each row into increasing order and pad short rows.
+        for (size_t r = 0; r < rows; r++) {
+            double* hd = job->dist + (i0 + r) * k;
+            size_t* hi = job->idx + (i0 + r) * k;
+            for (size_t size = fill[r]; size > 1; size--) {
+                _cdist_swap(hd, hi, 0, size - 1);
+                _cdist_sift_down(hd, hi, size - 1, 0);
+            }
+            for (size_t c = 0; c < fill[r]; c++)
+                hd[c] = sqrt(hd[c]);
+            for (size_t c = fill[r]; c < k; c++) {
+                hd[c] = INFINITY;
+                hi[c] = SIZE_MAX;
+            }
+        }
+    }
+}
+
+static int _cdist_run(cdist_job* job, fossil_math_range_fn fn) {
+    size_t width = job->out ? job->m : job->k;
+    if (job->n == 0 || width == 0)
+        return 0;
+    if (job->n > SIZE_MAX / sizeof(double) / width)
+        return -1;
+    size_t grain = (job->m >= GEOM_CLOUD_GRAIN || job->m == 0) ? 1 : GEOM_CLOUD_GRAIN / job->m;
+    fossil_math_parallel_for(job->n, grain, fn, job);
+    return 0;
+}
+
+static int _cdist(const double* const* a, size_t n, const double* const* b, size_t m, size_t dims,
+                  int root, double* out, size_t k, size_t* indices, double* distances) {
+    cdist_job job;
+    memset(&job, 0, sizeof(job));
+    for (size_t d = 0; d < dims; d++) {
+        job.a[d] = a[d];
+        job.b[d] = b[d];
+    }
+    job.n = n;
+    job.m = m;
+    job.dims = dims;
+    job.root = root;
+    job.out = out;
+    job.k = k;
+    job.idx = indices;
+    job.dist = distances;
+    return _cdist_run(&job, out ? _cdist_rows : _cdist_topk_rows);
+}
+
+int fossil_math_geom_cloud2d_cdist(const fossil_math_geom_cloud2d* a, const fossil_math_geom_cloud2d* b, double* out) {
+    const double* ca[2] = {a->x, a->y};
+    const double* cb[2] = {b->x, b->y};
+    return _cdist(ca, a->size, cb, b->size, 2, 1, out, 0, NULL, NULL);
+}
+
+int fossil_math_geom_cloud2d_cdist_sq(const fossil_math_geom_cloud2d* a, const fossil_math_geom_cloud2d* b, double* out) {
+    const double* ca[2] = {a->x, a->y};
+    const double* cb[2] = {b->x, b->y};
+    return _cdist(ca, a->size, cb, b->size, 2, 0, out, 0, NULL, NULL);
+}
+
+int fossil_math_geom_cloud2d_cdist_topk(const fossil_math_geom_cloud2d* a, const fossil_math_geom_cloud2d* b, size_t k,
+                                        size_t* indices, double* distances) {
+    const double* ca[2] = {a->x, a->y};
+    const double* cb[2] = {b->x, b->y};
+    return _cdist(ca, a->size, cb, b->size, 2, 1, NULL, k, indices, distances);
+}
+
+int fossil_math_geom_cloud3d_cdist(const fossil_math_geom_cloud3d* a, const fossil_math_geom_cloud3d* b, double* out) {
+    const double* ca[3] = {a->x, a->y, a->z};
+    const double* cb[3] = {b->x, b->y, b->z};
+    return _cdist(ca, a->size, cb, b->size, 3, 1, out, 0, NULL, NULL);
+}
+
+int fossil_math_geom_cloud3d_cdist_sq(const fossil_math_geom_cloud3d* a, const fossil_math_geom_cloud3d* b, double* out) {
+    const double* ca[3] = {a->x, a->y, a->z};
+    const double* cb[3] = {b->x, b->y, b->z};
+    return _cdist(ca, a->size, cb, b->size, 3, 0, out, 0, NULL, NULL);
+}
+
+int fossil_math_geom_cloud3d_cdist_topk(const fossil_math_geom_cloud3d* a, const fossil_math_geom_cloud3d* b, size_t k,
+                                        size_t* indices, double* distances) {
+    const double* ca[3] = {a->x, a->y, a->z};
+    const double* cb[3] = {b->x, b->y, b->z};
+    return _cdist(ca, a->size, cb, b->size, 3, 1, NULL, k, indices, distances);
+}
+
+// ======================================================
+// Axis-aligned boxes
+// ======================================================
+
+// Bounds skip NaN coordinates: the running bound is never NaN, and
+// simd_min(v, acc) keeps acc where v is NaN.
+static simd_vd _bounds_min(simd_vd acc, simd_vd v) {
+    return simd_min(v, acc);
+}
+
+static simd_vd _bounds_max(simd_vd acc, simd_vd v) {
+    return simd_max(v, acc);
+}
+
+// Reductions split into at most GEOM_BOUNDS_MAX_TASKS slices, one per slot of
+// GEOM_BOUNDS_TASK_SPAN indices (see GEOM_HULL_TASK_SPAN).
+#define GEOM_BOUNDS_MAX_TASKS 64
+#define GEOM_BOUNDS_TASK_SPAN 64
+
+// Bounds of lo[d][i] (minimum) and hi[d][i] (maximum) over i, or of the
+// interleaved coordinates in flat when it is set.
+typedef struct {
+    const double* lo[3];
+    const double* hi[3];
+    const double* flat;
+    size_t dims;
+    size_t n;
+    size_t tasks;
+    double out_lo[GEOM_BOUNDS_MAX_TASKS][3];
+    double out_hi[GEOM_BOUNDS_MAX_TASKS][3];
+} bounds_job;
+
+// The kernels take dims as a separate argument so that calls with a
+// constant unroll the component loops and keep the accumulators in registers.
+// Each keeps two sets of accumulators so consecutive min/max operations do
+// not wait on each other.
+static inline void _bounds_soa(const bounds_job* job, size_t dims, size_t begin, size_t end, double* lo,
+                               double* hi) {
+    simd_vd vlo[6], vhi[6];
+    double lanes[SIMD_LANES];
+    size_t i = begin;
+    for (size_t k = 0; k < 2 * dims; k++) {
+        vlo[k] = simd_set1(INFINITY);
+        vhi[k] = simd_set1(-INFINITY);
+    }
+    for (; end - i >= 2 * SIMD_LANES; i += 2 * SIMD_LANES) {
+        for (size_t d = 0; d < dims; d++) {
+            vlo[d] = _bounds_min(vlo[d], simd_load(job->lo[d] + i));
+            vhi[d] = _bounds_max(vhi[d], simd_load(job->hi[d] + i));
+            vlo[dims + d] = _bounds_min(vlo[dims + d], simd_load(job->lo[d] + i + SIMD_LANES));
+            vhi[dims + d] = _bounds_max(vhi[dims + d], simd_load(job->hi[d] + i + SIMD_LANES));
+        }
+    }
+    for (size_t k = 0; k < 2 * dims; k++) {
+        size_t d = k % dims;
+        simd_store(lanes, vlo[k]);
+        for (size_t l = 0; l < SIMD_LANES; l++)
+            lo[d] = (lanes[l] < lo[d]) ? lanes[l] : lo[d];
+        simd_store(lanes, vhi[k]);
+        for (size_t l = 0; l < SIMD_LANES; l++)
+            hi[d] = (lanes[l] > hi[d]) ? lanes[l] : hi[d];
+    }
+    for (size_t d = 0; d < dims; d++) {
+        for (size_t t = i; t < end; t++) {
+            lo[d] = (job->lo[d][t] < lo[d]) ? job->lo[d][t] : lo[d];
+            hi[d] = (job->hi[d][t] > hi[d]) ? job->hi[d][t] : hi[d];
+        }
+    }
+}
+
+// Interleaved points are read 2 * dims vectors at a time, so lane l of
+// vector k always holds component (k * SIMD_LANES + l) % dims.
+static inline void _bounds_aos(const bounds_job* job, size_t dims, size_t begin, size_t end, double* lo,
+                               double* hi) {
+    simd_vd vlo[6], vhi[6];
+    double lanes[SIMD_LANES];
+    size_t i = begin;
+    for (size_t k = 0; k < 2 * dims; k++) {
+        vlo[k] = simd_set1(INFINITY);
+        vhi[k] = simd_set1(-INFINITY);
+    }
+    for (; end - i >= 2 * SIMD_LANES; i += 2 * SIMD_LANES) {
+        const double* p = job->flat + i * dims;
+        for (size_t k = 0; k < 2 * dims; k++) {
+            simd_vd v = simd_load(p + k * SIMD_LANES);
+            vlo[k] = _bounds_min(vlo[k], v);
+            vhi[k] = _bounds_max(vhi[k], v);
+        }
+    }
+    for (size_t k = 0; k < 2 * dims; k++) {
+        simd_store(lanes, vlo[k]);
+        for (size_t l = 0; l < SIMD_LANES; l++) {
+            size_t d = (k * SIMD_LANES + l) % dims;
+            lo[d] = (lanes[l] < lo[d]) ? lanes[l] : lo[d];
+        }
+        simd_store(lanes, vhi[k]);
+        for (size_t l = 0; l < SIMD_LANES; l++) {
+            size_t d = (k * SIMD_LANES + l) % dims;
+            hi[d] = (lanes[l] > hi[d]) ? lanes[l] : hi[d];
+        }
+    }
+    for (size_t t = i * dims; t < end * dims; t++) {
+        size_t d = t % dims;
+        lo[d] = (job->flat[t] < lo[d]) ? job->flat[t] : lo[d];
+        hi[d] = (job->flat[t] > hi[d]) ? job->flat[t] : hi[d];
+    }
+}
+
+static void _bounds_slices(void* ctx, size_t begin, size_t end) {
+    bounds_job* job = (bounds_job*)ctx;
+    for (size_t j = (begin + GEOM_BOUNDS_TASK_SPAN - 1) / GEOM_BOUNDS_TASK_SPAN;
+         j < job->tasks && j * GEOM_BOUNDS_TASK_SPAN < end; j++) {
+        size_t lo = job->n / job->tasks * j, hi = (j + 1 == job->tasks) ? job->n : lo + job->n / job->tasks;
+        for (size_t d = 0; d < 3; d++) {
+            job->out_lo[j][d] = INFINITY;
+            job->out_hi[j][d] = -INFINITY;
+        }
+        double* out_lo = job->out_lo[j];
+        double* out_hi = job->out_hi[j];
+        if (job->flat && job->dims == 2)
+            _bounds_aos(job, 2, lo, hi, out_lo, out_hi);
+        else if (job->flat)
+            _bounds_aos(job, 3, lo, hi, out_lo, out_hi);
+        else if (job->dims == 2)
+            _bounds_soa(job, 2, lo, hi, out_lo, out_hi);
+        else
+            _bounds_soa(job, 3, lo, hi, out_lo, out_hi);
+    }
+}
+
+// Runs a bounds job and leaves the result in slot 0; an empty input gives
+// the empty box lo = +inf, hi = -inf.
+static void _bounds_run(bounds_job* job) {
+    job->tasks = 1;
+    if (job->n >= 2 * GEOM_CLOUD_GRAIN) {
+        job->tasks = fossil_math_get_threads();
+        if (job->tasks > job->n / GEOM_CLOUD_GRAIN)
+            job->tasks = job->n / GEOM_CLOUD_GRAIN;
+        if (job->tasks > GEOM_BOUNDS_MAX_TASKS)
+            job->tasks = GEOM_BOUNDS_MAX_TASKS;
+    }
+    fossil_math_parallel_for(job->tasks * GEOM_BOUNDS_TASK_SPAN, GEOM_BOUNDS_TASK_SPAN, _bounds_slices, job);
+    for (size_t j = 1; j < job->tasks; j++) {
+        for (size_t d = 0; d < job->dims; d++) {
+            if (job->out_lo[j][d] < job->out_lo[0][d])
+                job->out_lo[0][d] = job->out_lo[j][d];
+            if (job->out_hi[j][d] > job->out_hi[0][d])
+                job->out_hi[0][d] = job->out_hi[j][d];
+        }
+    }
+}
+
+static fossil_math_geom_aabb2d _bounds2d(bounds_job* job) {
+    fossil_math_geom_aabb2d box;
+    _bounds_run(job);
+    box.lo.x = job->out_lo[0][0];
+    box.lo.y = job->out_lo[0][1];
+    box.hi.x = job->out_hi[0][0];
+    box.hi.y = job->out_hi[0][1];
+    return box;
+}
+
+static fossil_math_geom_aabb3d _bounds3d(bounds_job* job) {
+    fossil_math_geom_aabb3d box;
+    _bounds_run(job);
+    box.lo.x = job->out_lo[0][0];
+    box.lo.y = job->out_lo[0][1];
+    box.lo.z = job->out_lo[0][2];
+    box.hi.x = job->out_hi[0][0];
+    box.hi.y = job->out_hi[0][1];
+    box.hi.z = job->out_hi[0][2];
+    return box;
+}
+
+static void _bounds_init(bounds_job* job, size_t dims, size_t n) {
+    memset(job, 0, sizeof(*job));
+    job->dims = dims;
+    job->n = n;
+}
+
+fossil_math_geom_aabb2d fossil_math_geom_aabb2d_merge(fossil_math_geom_aabb2d a, fossil_math_geom_aabb2d b) {
+    fossil_math_geom_aabb2d box;
+    box.lo.x = (b.lo.x < a.lo.x) ? b.lo.x : a.lo.x;
+    box.lo.y = (b.lo.y < a.lo.y) ? b.lo.y : a.lo.y;
+    box.hi.x = (b.hi.x > a.hi.x) ? b.hi.x : a.hi.x;
+    box.hi.y = (b.hi.y > a.hi.y) ? b.hi.y : a.hi.y;
+    return box;
+}
+
+fossil_math_geom_aabb3d fossil_math_geom_aabb3d_merge(fossil_math_geom_aabb3d a, fossil_math_geom_aabb3d b) {
+    fossil_math_geom_aabb3d box;
+    box.lo.x = (b.lo.x < a.lo.x) ? b.lo.x : a.lo.x;
+    box.lo.y = (b.lo.y < a.lo.y) ? b.lo.y : a.lo.y;
+    box.lo.z = (b.lo.z < a.lo.z) ? b.lo.z : a.lo.z;
+    box.hi.x = (b.hi.x > a.hi.x) ? b.hi.x : a.hi.x;
+    box.hi.y = (b.hi.y > a.hi.y) ? b.hi.y : a.hi.y;
+    box.hi.z = (b.hi.z > a.hi.z) ? b.hi.z : a.hi.z;
+    return box;
+}
+
+fossil_math_geom_aabb2d fossil_math_geom_aabb2d_from_points(const fossil_math_geom_point2d* points, size_t n) {
+    bounds_job job;
+    _bounds_init(&job, 2, n);
+    job.flat = n ? &points[0].x : NULL;
+    return _bounds2d(&job);
+}
+
+fossil_math_geom_aabb3d fossil_math_geom_aabb3d_from_points(const fossil_math_geom_point3d* points, size_t n) {
+    bounds_job job;
+    _bounds_init(&job, 3, n);
+    job.flat = n ? &points[0].x : NULL;
+    return _bounds3d(&job);
+}
+
+fossil_math_geom_aabb2d fossil_math_geom_cloud2d_bounds(const fossil_math_geom_cloud2d* cloud) {
+    bounds_job job;
+    _bounds_init(&job, 2, cloud->size);
+    job.lo[0] = job.hi[0] = cloud->x;
+    job.lo[1] = job.hi[1] = cloud->y;
+    return _bounds2d(&job);
+}
+
+fossil_math_geom_aabb3d fossil_math_geom_cloud3d_bounds(const fossil_math_geom_cloud3d* cloud) {
+    bounds_job job;
+    _bounds_init(&job, 3, cloud->size);
+    job.lo[0] = job.hi[0] = cloud->x;
+    job.lo[1] = job.hi[1] = cloud->y;
+    job.lo[2] = job.hi[2] = cloud->z;
+    return _bounds3d(&job);
+}
+
+fossil_math_geom_boxes2d* fossil_math_geom_boxes2d_create(size_t n) {
+    double* comps[4];
+    fossil_math_geom_boxes2d* boxes =
+        (fossil_math_geom_boxes2d*)_cloud_alloc(sizeof(fossil_math_geom_boxes2d), n, 4, comps);
+    if (!boxes)
+        return NULL;
+    boxes->lo_x = comps[0];
+    boxes->lo_y = comps[1];
+    boxes->hi_x = comps[2];
+    boxes->hi_y = comps[3];
+    boxes->size = n;
+    for (size_t i = 0; i < n; i++) {
+        boxes->lo_x[i] = boxes->lo_y[i] = INFINITY;
+        boxes->hi_x[i] = boxes->hi_y[i] = -INFINITY;
+    }
+    return boxes;
+}
+
+fossil_math_geom_boxes2d* fossil_math_geom_boxes2d_from_aabbs(const fossil_math_geom_aabb2d* aabbs, size_t n) {
+    if (!aabbs && n)
+        return NULL;
+    fossil_math_geom_boxes2d* boxes = fossil_math_geom_boxes2d_create(n);
+    if (!boxes)
+        return NULL;
+    for (size_t i = 0; i < n; i++) {
+        boxes->lo_x[i] = aabbs[i].lo.x;
+        boxes->lo_y[i] = aabbs[i].lo.y;
+        boxes->hi_x[i] = aabbs[i].hi.x;
+        boxes->hi_y[i] = aabbs[i].hi.y;
+    }
+    return boxes;
+}
+
+void fossil_math_geom_boxes2d_destroy(fossil_math_geom_boxes2d* boxes) {
+    fossil_math_aligned_free(boxes);
+}
+
+void fossil_math_geom_boxes2d_to_aabbs(const fossil_math_geom_boxes2d* boxes, fossil_math_geom_aabb2d* out) {
+    for (size_t i = 0; i < boxes->size; i++) {
+        out[i].lo.x = boxes->lo_x[i];
+        out[i].lo.y = boxes->lo_y[i];
+        out[i].hi.x = boxes->hi_x[i];
+        out[i].hi.y = boxes->hi_y[i];
+    }
+}
+
+fossil_math_geom_boxes3d* fossil_math_geom_boxes3d_create(size_t n) {
+    double* comps[6];
+    fossil_math_geom_boxes3d* boxes =
+        (fossil_math_geom_boxes3d*)_cloud_alloc(sizeof(fossil_math_geom_boxes3d), n, 6, comps);
+    if (!boxes)
+        return NULL;
+    boxes->lo_x = comps[0];
+    boxes->lo_y = comps[1];
+    boxes->lo_z = comps[2];
+    boxes->hi_x = comps[3];
+    boxes->hi_y = comps[4];
+    boxes->hi_z = comps[5];
+    boxes->size = n;
+    for (size_t i = 0; i < n; i++) {
+        boxes->lo_x[i] = boxes->lo_y[i] = boxes->lo_z[i] = INFINITY;
+        boxes->hi_x[i] = boxes->hi_y[i] = boxes->hi_z[i] = -INFINITY;
+    }
+    return boxes;
+}
+
+fossil_math_geom_boxes3d* fossil_math_geom_boxes3d_from_aabbs(const fossil_math_geom_aabb3d* aabbs, size_t n) {
+    if (!aabbs && n)
+        return NULL;
+    fossil_math_geom_boxes3d* boxes = fossil_math_geom_boxes3d_create(n);
+    if (!boxes)
+        return NULL;
+    for (size_t i = 0; i < n; i++) {
+        boxes->lo_x[i] = aabbs[i].lo.x;
+        boxes->lo_y[i] = aabbs[i].lo.y;
+        boxes->lo_z[i] = aabbs[i].lo.z;
+        boxes->hi_x[i] = aabbs[i].hi.x;
+        boxes->hi_y[i] = aabbs[i].hi.y;
+        boxes->hi_z[i] = aabbs[i].hi.z;
+    }
+    return boxes;
+}
+
+void fossil_math_geom_boxes3d_destroy(fossil_math_geom_boxes3d* boxes) {
+    fossil_math_aligned_free(boxes);
+}
+
+void fossil_math_geom_boxes3d_to_aabbs(const fossil_math_geom_boxes3d* boxes, fossil_math_geom_aabb3d* out) {
+    for (size_t i = 0; i < boxes->size; i++) {
+        out[i].lo.x = boxes->lo_x[i];
+        out[i].lo.y = boxes->lo_y[i];
+        out[i].lo.z = boxes->lo_z[i];
+        out[i].hi.x = boxes->hi_x[i];
+        out[i].hi.y = boxes->hi_y[i];
+        out[i].hi.z = boxes->hi_z[i];
+    }
+}
+
+fossil_math_geom_aabb2d fossil_math_geom_boxes2d_bounds(const fossil_math_geom_boxes2d* boxes) {
+    bounds_job job;
+    _bounds_init(&job, 2, boxes->size);
+    job.lo[0] = boxes->lo_x;
+    job.lo[1] = boxes->lo_y;
+    job.hi[0] = boxes->hi_x;
+    job.hi[1] = boxes->hi_y;
+    return _bounds2d(&job);
+}
+
+fossil_math_geom_aabb3d fossil_math_geom_boxes3d_bounds(const fossil_math_geom_boxes3d* boxes) {
+    bounds_job job;
+    _bounds_init(&job, 3, boxes->size);
+    job.lo[0] = boxes->lo_x;
+    job.lo[1] = boxes->lo_y;
+    job.lo[2] = boxes->lo_z;
+    job.hi[0] = boxes->hi_x;
+    job.hi[1] = boxes->hi_y;
+    job.hi[2] = boxes->hi_z;
+    return _bounds3d(&job);
+}
+
+// Per-box work over a box set: range bounds (cloud set) or elementwise merge
+// (other set). Box components are listed lo x, y[, z] then hi x, y[, z].
+typedef struct {
+    double* out[6];
+    const double* a[6];
+    const double* b[6];
+    const double* cloud[3];
+    const size_t* offsets;
+    size_t dims;
+} boxes_job;
+
+static void _boxes_merge_range(void* ctx, size_t begin, size_t end) {
+    const boxes_job* job = (const boxes_job*)ctx;
+    for (size_t i = begin; i < end; i += SIMD_LANES) {
+        size_t len = (end - i < SIMD_LANES) ? end - i : SIMD_LANES;
+        for (size_t c = 0; c < 2 * job->dims; c++) {
+            simd_vd a, b, r;
+            if (len == SIMD_LANES) {
+                a = simd_load(job->a[c] + i);
+                b = simd_load(job->b[c] + i);
+            } else {
+                a = simd_load_partial(job->a[c] + i, len, 0.0);
+                b = simd_load_partial(job->b[c] + i, len, 0.0);
+            }
+            r = (c < job->dims) ? _bounds_min(a, b) : _bounds_max(a, b);
+            if (len == SIMD_LANES)
+                simd_store(job->out[c] + i, r);
+            else
+                simd_store_partial(job->out[c] + i, len, r);
+        }
+    }
+}
+
+static void _boxes_ranges(void* ctx, size_t begin, size_t end) {
+    const boxes_job* job = (const boxes_job*)ctx;
+    bounds_job range;
+    _bounds_init(&range, job->dims, 0);
+    for (size_t d = 0; d < job->dims; d++)
+        range.lo[d] = range.hi[d] = job->cloud[d];
+    for (size_t i = begin; i < end; i++) {
+        double lo[3] = {INFINITY, INFINITY, INFINITY}, hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+        _bounds_soa(&range, job->dims, job->offsets[i], job->offsets[i + 1], lo, hi);
+        for (size_t d = 0; d < job->dims; d++) {
+            job->out[d][i] = lo[d];
+            job->out[job->dims + d][i] = hi[d];
+        }
+    }
+}
+
+static int _boxes_check_offsets(const size_t* offsets, size_t boxes, size_t points) {
+    for (size_t i = 0; i < boxes; i++)
+        if (offsets[i] > offsets[i + 1])
+            return -1;
+    return (offsets[boxes] <= points) ? 0 : -1;
+}
+
+int fossil_math_geom_boxes2d_from_ranges(fossil_math_geom_boxes2d* boxes, const fossil_math_geom_cloud2d* cloud,
+                                         const size_t* offsets) {
+    if (_boxes_check_offsets(offsets, boxes->size, cloud->size) != 0)
+        return -1;
+    boxes_job job = {{boxes->lo_x, boxes->lo_y, boxes->hi_x, boxes->hi_y}, {NULL}, {NULL},
+                     {cloud->x, cloud->y}, offsets, 2};
+    fossil_math_parallel_for(boxes->size, GEOM_CLOUD_GRAIN / 64, _boxes_ranges, &job);
+    return 0;
+}
+
+int fossil_math_geom_boxes3d_from_ranges(fossil_math_geom_boxes3d* boxes, const fossil_math_geom_cloud3d* cloud,
+                                         const size_t* offsets) {
+    if (_boxes_check_offsets(offsets, boxes->size, cloud->size) != 0)
+        return -1;
+    boxes_job job = {{boxes->lo_x, boxes->lo_y, boxes->lo_z, boxes->hi_x, boxes->hi_y, boxes->hi_z}, {NULL}, {NULL},
+                     {cloud->x, cloud->y, cloud->z}, offsets, 3};
+    fossil_math_parallel_for(boxes->size, GEOM_CLOUD_GRAIN / 64, _boxes_ranges, &job);
+    return 0;
+}
+
+int fossil_math_geom_boxes2d_merge(const fossil_math_geom_boxes2d* a, const fossil_math_geom_boxes2d* b,
+                                   fossil_math_geom_boxes2d* out) {
+    if (a->size != b->size || a->size != out->size)
+        return -1;
+    boxes_job job = {{out->lo_x, out->lo_y, out->hi_x, out->hi_y},
+                     {a->lo_x, a->lo_y, a->hi_x, a->hi_y},
+                     {b->lo_x, b->lo_y, b->hi_x, b->hi_y}, {NULL}, NULL, 2};
+    fossil_math_parallel_for(out->size, GEOM_CLOUD_GRAIN, _boxes_merge_range, &job);
+    return 0;
+}
+
+int fossil_math_geom_boxes3d_merge(const fossil_math_geom_boxes3d* a, const fossil_math_geom_boxes3d* b,
+                                   fossil_math_geom_boxes3d* out) {
+    if (a->size != b->size || a->size != out->size)
+        return -1;
+    boxes_job job = {{out->lo_x, out->lo_y, out->lo_z, out->hi_x, out->hi_y, out->hi_z},
+                     {a->lo_x, a->lo_y, a->lo_z, a->hi_x, a->hi_y, a->hi_z},
+                     {b->lo_x, b->lo_y, b->lo_z, b->hi_x, b->hi_y, b->hi_z}, {NULL}, NULL, 3};
+    fossil_math_parallel_for(out->size, GEOM_CLOUD_GRAIN, _boxes_merge_range, &job);
+    return 0;
+}
+
+// Overlap masks test closed intervals lo[d][i] <= qhi[d] and qlo[d] <= hi[d][i]
+// on every axis, which covers box-box, box-contains-point (qlo = qhi) and
+// point-in-box (lo = hi) at once. Circle tests instead compare the squared
+// distance from qlo to the box with r2. Words are filled as for the circle
+// masks, one writer per word.
+typedef struct {
+    const double* lo[3];
+    const double* hi[3];
+    size_t dims;
+    size_t n;
+    double qlo[3];
+    double qhi[3];
+    int circle;
+    double r2;
+    uint64_t* mask;
+} box_mask_job;
+
+static void _box_words(void* ctx, size_t begin, size_t end) {
+    const box_mask_job* job = (const box_mask_job*)ctx;
+    simd_vd zero = simd_set1(0.0);
+    for (size_t w = begin; w < end; w++) {
+        size_t base = w * 64;
+        size_t stop = (job->n - base < 64) ? job->n : base + 64;
+        uint64_t word = 0;
+        for (size_t i = base; i < stop; i += SIMD_LANES) {
+            size_t len = (stop - i < SIMD_LANES) ? stop - i : SIMD_LANES;
+            simd_vd hit = simd_eq(zero, zero), d2 = zero;
+            for (size_t d = 0; d < job->dims; d++) {
+                simd_vd lo, hi;
+                if (len == SIMD_LANES) {
+                    lo = simd_load(job->lo[d] + i);
+                    hi = simd_load(job->hi[d] + i);
+                } else {
+                    lo = simd_load_partial(job->lo[d] + i, len, 0.0);
+                    hi = simd_load_partial(job->hi[d] + i, len, 0.0);
+                }
+                if (job->circle) {
+                    // Gap along this axis, NaN when any input is NaN.
+                    simd_vd c = simd_set1(job->qlo[d]);
+                    simd_vd below = simd_sub(lo, c), above = simd_sub(c, hi);
+                    simd_vd gap = simd_select(simd_lt(below, above), above, below);
+                    gap = simd_select(simd_lt(gap, zero), zero, gap);
+                    hit = simd_and(hit, simd_and(simd_eq(lo, lo), simd_eq(hi, hi)));
+                    d2 = simd_add(d2, simd_mul(gap, gap));
+                } else {
+                    hit = simd_and(hit, simd_and(simd_le(lo, simd_set1(job->qhi[d])),
+                                                 simd_le(simd_set1(job->qlo[d]), hi)));
+                }
+            }
+            if (job->circle)
+                hit = simd_and(hit, simd_le(d2, simd_set1(job->r2)));
+            int live = (int)(((unsigned)1 << len) - 1);
+            word |= (uint64_t)(simd_mask_bits(hit) & live) << (i - base);
+        }
+        job->mask[w] = word;
+    }
+}
+
+static size_t _box_mask(box_mask_job* job) {
+    size_t words = FOSSIL_MATH_GEOM_MASK_WORDS(job->n);
+    fossil_math_parallel_for(words, GEOM_CLOUD_GRAIN / 64, _box_words, job);
+    size_t count = 0;
+    for (size_t w = 0; w < words; w++)
+        count += _popcount64(job->mask[w]);
+    return count;
+}
+
+size_t fossil_math_geom_boxes2d_overlap_mask(const fossil_math_geom_boxes2d* boxes, fossil_math_geom_aabb2d box,
+                                             uint64_t* mask) {
+    box_mask_job job = {{boxes->lo_x, boxes->lo_y}, {boxes->hi_x, boxes->hi_y}, 2, boxes->size,
+                        {box.lo.x, box.lo.y}, {box.hi.x, box.hi.y}, 0, 0.0, mask};
+    return _box_mask(&job);
+}
+
+size_t fossil_math_geom_boxes2d_contains_mask(const fossil_math_geom_boxes2d* boxes, fossil_math_geom_point2d p,
+                                              uint64_t* mask) {
+    box_mask_job job = {{boxes->lo_x, boxes->lo_y}, {boxes->hi_x, boxes->hi_y}, 2, boxes->size,
+                        {p.x, p.y}, {p.x, p.y}, 0, 0.0, mask};
+    return _box_mask(&job);
+}
+
+size_t fossil_math_geom_boxes2d_circle_mask(const fossil_math_geom_boxes2d* boxes, fossil_math_geom_circle c,
+                                            uint64_t* mask) {
+    box_mask_job job = {{boxes->lo_x, boxes->lo_y}, {boxes->hi_x, boxes->hi_y}, 2, boxes->size,
+                        {c.center.x, c.center.y}, {c.center.x, c.center.y}, 1, _circle_r2(c), mask};
+    return _box_mask(&job);
+}
+
+size_t fossil_math_geom_cloud2d_in_box_mask(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_aabb2d box,
+                                            uint64_t* mask) {
+    box_mask_job job = {{cloud->x, cloud->y}, {cloud->x, cloud->y}, 2, cloud->size,
+                        {box.lo.x, box.lo.y}, {box.hi.x, box.hi.y}, 0, 0.0, mask};
+    return _box_mask(&job);
+}
+
+size_t fossil_math_geom_boxes3d_overlap_mask(const fossil_math_geom_boxes3d* boxes, fossil_math_geom_aabb3d box,
+                                             uint64_t* mask) {
+    box_mask_job job = {{boxes->lo_x, boxes->lo_y, boxes->lo_z}, {boxes->hi_x, boxes->hi_y, boxes->hi_z}, 3,
+                        boxes->size, {box.lo.x, box.lo.y, box.lo.z}, {box.hi.x, box.hi.y, box.hi.z}, 0, 0.0, mask};
+    return _box_mask(&job);
+}
+
+size_t fossil_math_geom_boxes3d_contains_mask(const fossil_math_geom_boxes3d* boxes, fossil_math_geom_point3d p,
+                                              uint64_t* mask) {
+    box_mask_job job = {{boxes->lo_x, boxes->lo_y, boxes->lo_z}, {boxes->hi_x, boxes->hi_y, boxes->hi_z}, 3,
+                        boxes->size, {p.x, p.y, p.z}, {p.x, p.y, p.z}, 0, 0.0, mask};
+    return _box_mask(&job);
+}
+
+size_t fossil_math_geom_cloud3d_in_box_mask(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_aabb3d box,
+                                            uint64_t* mask) {
+    box_mask_job job = {{cloud->x, cloud->y, cloud->z}, {cloud->x, cloud->y, cloud->z}, 3, cloud->size,
+                        {box.lo.x, box.lo.y, box.lo.z}, {box.hi.x, box.hi.y, box.hi.z}, 0, 0.0, mask};
+    return _box_mask(&job);
+}
+
+// ======================================================
+// Affine transforms
+// ======================================================
+fossil_math_geom_affine2d fossil_math_geom_affine2d_identity(void) {
+    fossil_math_geom_affine2d a = {{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
+    return a;
+}
+
+fossil_math_geom_affine2d fossil_math_geom_affine2d_translate(double dx, double dy) {
+    fossil_math_geom_affine2d a = fossil_math_geom_affine2d_identity();
+    a.m[0][2] = dx;
+    a.m[1][2] = dy;
+    return a;
+}
+
+fossil_math_geom_affine2d fossil_math_geom_affine2d_scale(double sx, double sy) {
+    fossil_math_geom_affine2d a = fossil_math_geom_affine2d_identity();
+    a.m[0][0] = sx;
+    a.m[1][1] = sy;
+    return a;
+}
+
+fossil_math_geom_affine2d fossil_math_geom_affine2d_rotate(double angle_rad) {
+    double s, c;
+    fossil_math_trig_sincos(angle_rad, &s, &c);
+    fossil_math_geom_affine2d a = fossil_math_geom_affine2d_identity();
+    a.m[0][0] = c;
+    a.m[0][1] = -s;
+    a.m[1][0] = s;
+    a.m[1][1] = c;
+    return a;
+}
+
+fossil_math_geom_affine2d fossil_math_geom_affine2d_shear(double shx, double shy) {
+    fossil_math_geom_affine2d a = fossil_math_geom_affine2d_identity();
+    a.m[0][1] = shx;
+    a.m[1][0] = shy;
+    return a;
+}
+
+fossil_math_geom_affine2d fossil_math_geom_affine2d_compose(const fossil_math_geom_affine2d* a, const fossil_math_geom_affine2d* b) {
+    fossil_math_geom_affine2d r = fossil_math_geom_affine2d_identity();
+    for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < 3; j++)
+            r.m[i][j] = a->m[i][0] * b->m[0][j] + a->m[i][1] * b->m[1][j];
+        r.m[i][2] += a->m[i][2];
+    }
+    return r;
+}
+
+int fossil_math_geom_affine2d_invert(const fossil_math_geom_affine2d* a, fossil_math_geom_affine2d* out) {
+    double det = a->m[0][0] * a->m[1][1] - a->m[0][1] * a->m[1][0];
+    if (det == 0.0 || !isfinite(det) || !isfinite(a->m[0][2]) || !isfinite(a->m[1][2]))
+        return -1;
+    double inv = 1.0 / det;
+    fossil_math_geom_affine2d r = fossil_math_geom_affine2d_identity();
+    r.m[0][0] = a->m[1][1] * inv;
+    r.m[0][1] = -a->m[0][1] * inv;
+    r.m[1][0] = -a->m[1][0] * inv;
+    r.m[1][1] = a->m[0][0] * inv;
+    r.m[0][2] = -(r.m[0][0] * a->m[0][2] + r.m[0][1] * a->m[1][2]);
+    r.m[1][2] = -(r.m[1][0] * a->m[0][2] + r.m[1][1] * a->m[1][2]);
+    *out = r;
+    return 0;
+}
+
+fossil_math_geom_point2d fossil_math_geom_affine2d_apply(const fossil_math_geom_affine2d* a, fossil_math_geom_point2d p) {
+    fossil_math_geom_point2d r;
+    r.x = a->m[0][0] * p.x + a->m[0][1] * p.y + a->m[0][2];
+    r.y = a->m[1][0] * p.x + a->m[1][1] * p.y + a->m[1][2];
+    return r;
+}
+
+fossil_math_geom_affine3d fossil_math_geom_affine3d_identity(void) {
+    fossil_math_geom_affine3d a = {{{1.0, 0.0, 0.0, 0.0}, {0.0, 1.0, 0.0, 0.0},
+                                    {0.0, 0.0, 1.0, 0.0}, {0.0, 0.0, 0.0, 1.0}}};
+    return a;
+}
+
+fossil_math_geom_affine3d fossil_math_geom_affine3d_translate(double dx, double dy, double dz) {
+    fossil_math_geom_affine3d a = fossil_math_geom_affine3d_identity();
+    a.m[0][3] = dx;
+    a.m[1][3] = dy;
+    a.m[2][3] = dz;
+    return a;
+}
+
+fossil_math_geom_affine3d fossil_math_geom_affine3d_scale(double sx, double sy, double sz) {
+    fossil_math_geom_affine3d a = fossil_math_geom_affine3d_identity();
+    a.m[0][0] = sx;
+    a.m[1][1] = sy;
+    a.m[2][2] = sz;
+    return a;
+}
+
+// Rodrigues' formula about the normalized axis.
+fossil_math_geom_affine3d fossil_math_geom_affine3d_rotate(fossil_math_geom_point3d axis, double angle_rad) {
+    fossil_math_geom_affine3d a = fossil_math_geom_affine3d_identity();
+    double len = sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    if (len == 0.0)
+        return a;
+    double x = axis.x / len, y = axis.y / len, z = axis.z / len;
+    double s, c;
+    fossil_math_trig_sincos(angle_rad, &s, &c);
+    double t = 1.0 - c;
+    a.m[0][0] = t * x * x + c;
+    a.m[0][1] = t * x * y - s * z;
+    a.m[0][2] = t * x * z + s * y;
+    a.m[1][0] = t * x * y + s * z;
+    a.m[1][1] = t * y * y + c;
+    a.m[1][2] = t * y * z - s * x;
+    a.m[2][0] = t * x * z - s * y;
+    a.m[2][1] = t * y * z + s * x;
+    a.m[2][2] = t * z * z + c;
+    return a;
+}
+
+fossil_math_geom_affine3d fossil_math_geom_affine3d_shear(double xy, double xz, double yx, double yz, double zx, double zy) {
+    fossil_math_geom_affine3d a = fossil_math_geom_affine3d_identity();
+    a.m[0][1] = xy;
+    a.m[0][2] = xz;
+    a.m[1][0] = yx;
+    a.m[1][2] = yz;
+    a.m[2][0] = zx;
+    a.m[2][1] = zy;
+    return a;
+}
+
+fossil_math_geom_affine3d fossil_math_geom_affine3d_compose(const fossil_math_geom_affine3d* a, const fossil_math_geom_affine3d* b) {
+    fossil_math_geom_affine3d r = fossil_math_geom_affine3d_identity();
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++)
+            r.m[i][j] = a->m[i][0] * b->m[0][j] + a->m[i][1] * b->m[1][j] + a->m[i][2] * b->m[2][j];
+        r.m[i][3] += a->m[i][3];
+    }
+    return r;
+}
+
+// The linear part is inverted through its adjugate; the translation is
+// carried back through the inverse.
+int fossil_math_geom_affine3d_invert(const fossil_math_geom_affine3d* a, fossil_math_geom_affine3d* out) {
+    const double (*m)[4] = a->m;
+    double c00 = m[1][1] * m[2][2] - m[1][2] * m[2][1];
+    double c01 = m[1][2] * m[2][0] - m[1][0] * m[2][2];
+    double c02 = m[1][0] * m[2][1] - m[1][1] * m[2][0];
+    double det = m[0][0] * c00 + m[0][1] * c01 + m[0][2] * c02;
+    if (det == 0.0 || !isfinite(det) || !isfinite(m[0][3]) || !isfinite(m[1][3]) || !isfinite(m[2][3]))
+        return -1;
+    double inv = 1.0 / det;
+    fossil_math_geom_affine3d r = fossil_math_geom_affine3d_identity();
+    r.m[0][0] = c00 * inv;
+    r.m[1][0] = c01 * inv;
+    r.m[2][0] = c02 * inv;
+    r.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * inv;
+    r.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * inv;
+    r.m[2][1] = (m[0][1] * m[2][0] - m[0][0] * m[2][1]) * inv;
+    r.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * inv;
+    r.m[1][2] = (m[0][2] * m[1][0] - m[0][0] * m[1][2]) * inv;
+    r.m[2][2] = (m[0][0] * m[1][1] - m[0][1] * m[1][0]) * inv;
+    for (int i = 0; i < 3; i++)
+        r.m[i][3] = -(r.m[i][0] * m[0][3] + r.m[i][1] * m[1][3] + r.m[i][2] * m[2][3]);
+    *out = r;
+    return 0;
+}
+
+fossil_math_geom_point3d fossil_math_geom_affine3d_apply(const fossil_math_geom_affine3d* a, fossil_math_geom_point3d p) {
+    fossil_math_geom_point3d r;
+    r.x = a->m[0][0] * p.x + a->m[0][1] * p.y + a->m[0][2] * p.z + a->m[0][3];
+    r.y = a->m[1][0] * p.x + a->m[1][1] * p.y + a->m[1][2] * p.z + a->m[1][3];
+    r.z = a->m[2][0] * p.x + a->m[2][1] * p.y + a->m[2][2] * p.z + a->m[2][3];
+    return r;
+}
+
+// The batch forms run one SIMD kernel over component arrays in place, in the
+// same operation order as the single-point forms.
+typedef struct {
+    double rows[3][4];
+    double* c[3];
+    size_t dims;
+} affine_job;
+
+static void _affine_range(void* ctx, size_t begin, size_t end) {
+    const affine_job* job = (const affine_job*)ctx;
+    size_t dims = job->dims;
+    simd_vd k[3][4];
+    for (size_t r = 0; r < dims; r++)
+        for (size_t j = 0; j <= dims; j++)
+            k[r][j] = simd_set1(job->rows[r][j]);
+    for (size_t i = begin; i < end; i += SIMD_LANES) {
+        size_t len = (end - i < SIMD_LANES) ? end - i : SIMD_LANES;
+        simd_vd v[3], o[3];
+        for (size_t d = 0; d < dims; d++)
+            v[d] = (len == SIMD_LANES) ? simd_load(job->c[d] + i) : simd_load_partial(job->c[d] + i, len, 0.0);
+        for (size_t r = 0; r < dims; r++) {
+            simd_vd acc = simd_mul(k[r][0], v[0]);
+            for (size_t d = 1; d < dims; d++)
+                acc = simd_add(acc, simd_mul(k[r][d], v[d]));
+            o[r] = simd_add(acc, k[r][dims]);
+        }
+        for (size_t d = 0; d < dims; d++) {
+            if (len == SIMD_LANES)
+                simd_store(job->c[d] + i, o[d]);
+            else
+                simd_store_partial(job->c[d] + i, len, o[d]);
+        }
+    }
+}
+
+static void _affine2d_job(affine_job* job, const fossil_math_geom_affine2d* a, double* x, double* y) {
+    for (int r = 0; r < 2; r++)
+        for (int j = 0; j < 3; j++)
+            job->rows[r][j] = a->m[r][j];
+    job->c[0] = x;
+    job->c[1] = y;
+    job->c[2] = NULL;
+    job->dims = 2;
+}
+
+static void _affine3d_job(affine_job* job, const fossil_math_geom_affine3d* a, double* x, double* y, double* z) {
+    for (int r = 0; r < 3; r++)
+        for (int j = 0; j < 4; j++)
+            job->rows[r][j] = a->m[r][j];
+    job->c[0] = x;
+    job->c[1] = y;
+    job->c[2] = z;
+    job->dims = 3;
+}
+
+void fossil_math_geom_affine2d_apply_array(const fossil_math_geom_affine2d* a, const fossil_math_geom_point2d* in,
+                                           fossil_math_geom_point2d* out, size_t n) {
+    double x[GEOM_COORD_CHUNK], y[GEOM_COORD_CHUNK];
+    affine_job job;
+    _affine2d_job(&job, a, x, y);
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        for (size_t j = 0; j < len; j++) {
+            x[j] = in[i + j].x;
+            y[j] = in[i + j].y;
+        }
+        _affine_range(&job, 0, len);
+        for (size_t j = 0; j < len; j++) {
+            out[i + j].x = x[j];
+            out[i + j].y = y[j];
+        }
+    }
+}
+
+void fossil_math_geom_affine2d_apply_cloud(const fossil_math_geom_affine2d* a, fossil_math_geom_cloud2d* cloud) {
+    affine_job job;
+    _affine2d_job(&job, a, cloud->x, cloud->y);
+    fossil_math_parallel_for(cloud->size, GEOM_CLOUD_GRAIN, _affine_range, &job);
+}
+
+void fossil_math_geom_affine3d_apply_array(const fossil_math_geom_affine3d* a, const fossil_math_geom_point3d* in,
+                                           fossil_math_geom_point3d* out, size_t n) {
+    double x[GEOM_COORD_CHUNK], y[GEOM_COORD_CHUNK], z[GEOM_COORD_CHUNK];
+    affine_job job;
+    _affine3d_job(&job, a, x, y, z);
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        for (size_t j = 0; j < len; j++) {
+            x[j] = in[i + j].x;
+            y[j] = in[i + j].y;
+            z[j] = in[i + j].z;
+        }
+        _affine_range(&job, 0, len);
+        for (size_t j = 0; j < len; j++) {
+            out[i + j].x = x[j];
+            out[i + j].y = y[j];
+            out[i + j].z = z[j];
+        }
+    }
+}
+
+void fossil_math_geom_affine3d_apply_cloud(const fossil_math_geom_affine3d* a, fossil_math_geom_cloud3d* cloud) {
+    affine_job job;
+    _affine3d_job(&job, a, cloud->x, cloud->y, cloud->z);
+    fossil_math_parallel_for(cloud->size, GEOM_CLOUD_GRAIN, _affine_range, &job);
+}
+
+// ======================================================
+// Quaternions
+// ======================================================
+fossil_math_geom_quat fossil_math_geom_quat_identity(void) {
+    fossil_math_geom_quat q = {1.0, 0.0, 0.0, 0.0};
+    return q;
+}
+
+fossil_math_geom_quat fossil_math_geom_quat_from_axis_angle(fossil_math_geom_point3d axis, double angle_rad) {
+    double len = sqrt(axis.x * axis.x + axis.y * axis.y + axis.z * axis.z);
+    if (len == 0.0)
+        return fossil_math_geom_quat_identity();
+    double s, c;
+    fossil_math_trig_sincos(0.5 * angle_rad, &s, &c);
+    s /= len;
+    fossil_math_geom_quat q = {c, axis.x * s, axis.y * s, axis.z * s};
+    return q;
+}
+
+fossil_math_geom_quat fossil_math_geom_quat_mul(fossil_math_geom_quat a, fossil_math_geom_quat b) {
+    fossil_math_geom_quat r;
+    r.w = a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z;
+    r.x = a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y;
+    r.y = a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x;
+    r.z = a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w;
+    return r;
+}
+
+fossil_math_geom_quat fossil_math_geom_quat_conjugate(fossil_math_geom_quat q) {
+    q.x = -q.x;
+    q.y = -q.y;
+    q.z = -q.z;
+    return q;
+}
+
+fossil_math_geom_quat fossil_math_geom_quat_normalize(fossil_math_geom_quat q) {
+    double len = sqrt(q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z);
+    if (len == 0.0)
+        return fossil_math_geom_quat_identity();
+    q.w /= len;
+    q.x /= len;
+    q.y /= len;
+    q.z /= len;
+    return q;
+}
+
+// Scaling by 2 / |q|^2 keeps the matrix a pure rotation for non-unit q.
+fossil_math_geom_affine3d fossil_math_geom_quat_to_affine3d(fossil_math_geom_quat q) {
+    fossil_math_geom_affine3d a = fossil_math_geom_affine3d_identity();
+    double n = q.w * q.w + q.x * q.x + q.y * q.y + q.z * q.z;
+    if (n == 0.0)
+        return a;
+    double s = 2.0 / n;
+    double xx = s * q.x * q.x, yy = s * q.y * q.y, zz = s * q.z * q.z;
+    double xy = s * q.x * q.y, xz = s * q.x * q.z, yz = s * q.y * q.z;
+    double wx = s * q.w * q.x, wy = s * q.w * q.y, wz = s * q.w * q.z;
+    a.m[0][0] = 1.0 - (yy + zz);
+    a.m[0][1] = xy - wz;
+    a.m[0][2] = xz + wy;
+    a.m[1][0] = xy + wz;
+    a.m[1][1] = 1.0 - (xx + zz);
+    a.m[1][2] = yz - wx;
+    a.m[2][0] = xz - wy;
+    a.m[2][1] = yz + wx;
+    a.m[2][2] = 1.0 - (xx + yy);
+    return a;
+}
+
+// Shepperd's method: solve for the largest component first so the division
+// never loses precision.
+fossil_math_geom_quat fossil_math_geom_quat_from_affine3d(const fossil_math_geom_affine3d* a) {
+    const double (*m)[4] = a->m;
+    double trace = m[0][0] + m[1][1] + m[2][2];
+    fossil_math_geom_quat q;
+    if (trace >= m[0][0] && trace >= m[1][1] && trace >= m[2][2]) {
+        double r = sqrt(1.0 + trace);
+        double s = 0.5 / r;
+        q.w = 0.5 * r;
+        q.x = (m[2][1] - m[1][2]) * s;
+        q.y = (m[0][2] - m[2][0]) * s;
+        q.z = (m[1][0] - m[0][1]) * s;
+    } else if (m[0][0] >= m[1][1] && m[0][0] >= m[2][2]) {
+        double r = sqrt(1.0 + m[0][0] - m[1][1] - m[2][2]);
+        double s = 0.5 / r;
+        q.w = (m[2][1] - m[1][2]) * s;
+        q.x = 0.5 * r;
+        q.y = (m[0][1] + m[1][0]) * s;
+        q.z = (m[0][2] + m[2][0]) * s;
+    } else if (m[1][1] >= m[2][2]) {
+        double r = sqrt(1.0 - m[0][0] + m[1][1] - m[2][2]);
+        double s = 0.5 / r;
+        q.w = (m[0][2] - m[2][0]) * s;
+        q.x = (m[0][1] + m[1][0]) * s;
+        q.y = 0.5 * r;
+        q.z = (m[1][2] + m[2][1]) * s;
+    } else {
+        double r = sqrt(1.0 - m[0][0] - m[1][1] + m[2][2]);
+        double s = 0.5 / r;
+        q.w = (m[1][0] - m[0][1]) * s;
+        q.x = (m[0][2] + m[2][0]) * s;
+        q.y = (m[1][2] + m[2][1]) * s;
+        q.z = 0.5 * r;
+    }
+    if (q.w < 0.0) {
+        q.w = -q.w;
+        q.x = -q.x;
+        q.y = -q.y;
+        q.z = -q.z;
+    }
+    return fossil_math_geom_quat_normalize(q);
+}
+
+// Rotations go through the matrix so single points, arrays and clouds agree.
+fossil_math_geom_point3d fossil_math_geom_quat_rotate(fossil_math_geom_quat q, fossil_math_geom_point3d p) {
+    fossil_math_geom_affine3d a = fossil_math_geom_quat_to_affine3d(q);
+    return fossil_math_geom_affine3d_apply(&a, p);
+}
+
+void fossil_math_geom_quat_rotate_array(fossil_math_geom_quat q, const fossil_math_geom_point3d* in,
+                                        fossil_math_geom_point3d* out, size_t n) {
+    fossil_math_geom_affine3d a = fossil_math_geom_quat_to_affine3d(q);
+    fossil_math_geom_affine3d_apply_array(&a, in, out, n);
+}
+
+void fossil_math_geom_quat_rotate_cloud(fossil_math_geom_quat q, fossil_math_geom_cloud3d* cloud) {
+    fossil_math_geom_affine3d a = fossil_math_geom_quat_to_affine3d(q);
+    fossil_math_geom_affine3d_apply_cloud(&a, cloud);
+}
+
+// Pairs with |a . b| above this interpolate linearly: sin(theta) is too small
+// to divide by and the arc is indistinguishable from the chord.
+#define GEOM_SLERP_LINEAR 0.9995
+
+// Interpolates a chunk of pairs. The acos and sines go through the array
+// kernels; each result reads its own inputs before writing, so out may alias.
+static void _quat_lerp_chunk(const fossil_math_geom_quat* a, const fossil_math_geom_quat* b, const double* t,
+                             fossil_math_geom_quat* out, size_t n, int spherical) {
+    double d[GEOM_COORD_CHUNK], sg[GEOM_COORD_CHUNK];
+    double th[GEOM_COORD_CHUNK], u[GEOM_COORD_CHUNK], v[GEOM_COORD_CHUNK];
+    if (n == 0)
+        return;
+    for (size_t i = 0; i < n; i++) {
+        double dot = a[i].w * b[i].w + a[i].x * b[i].x + a[i].y * b[i].y + a[i].z * b[i].z;
+        // q and -q are the same rotation; flip b onto a's hemisphere.
+        sg[i] = (dot < 0.0) ? -1.0 : 1.0;
+        d[i] = fmin(fabs(dot), 1.0);
+    }
+    if (spherical) {
+        fossil_math_trig_acos_array(d, th, n);
+        for (size_t i = 0; i < n; i++) {
+            u[i] = (1.0 - t[i]) * th[i];
+            v[i] = t[i] * th[i];
+        }
+        fossil_math_trig_sin_array(th, th, n);
+        fossil_math_trig_sin_array(u, u, n);
+        fossil_math_trig_sin_array(v, v, n);
+    }
+    for (size_t i = 0; i < n; i++) {
+        int linear = !spherical || d[i] > GEOM_SLERP_LINEAR;
+        double ka = linear ? 1.0 - t[i] : u[i] / th[i];
+        double kb = (linear ? t[i] : v[i] / th[i]) * sg[i];
+        fossil_math_geom_quat r;
+        r.w = ka * a[i].w + kb * b[i].w;
+        r.x = ka * a[i].x + kb * b[i].x;
+        r.y = ka * a[i].y + kb * b[i].y;
+        r.z = ka * a[i].z + kb * b[i].z;
+        out[i] = linear ? fossil_math_geom_quat_normalize(r) : r;
+    }
+}
+
+void fossil_math_geom_quat_slerp_array(const fossil_math_geom_quat* a, const fossil_math_geom_quat* b,
+                                       const double* t, fossil_math_geom_quat* out, size_t n) {
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        _quat_lerp_chunk(a + i, b + i, t + i, out + i, len, 1);
+    }
+}
+
+void fossil_math_geom_quat_nlerp_array(const fossil_math_geom_quat* a, const fossil_math_geom_quat* b,
+                                       const double* t, fossil_math_geom_quat* out, size_t n) {
+    for (size_t i = 0; i < n; i += GEOM_COORD_CHUNK) {
+        size_t len = (n - i < GEOM_COORD_CHUNK) ? n - i : GEOM_COORD_CHUNK;
+        _quat_lerp_chunk(a + i, b + i, t + i, out + i, len, 0);
+    }
+}
+
+fossil_math_geom_quat fossil_math_geom_quat_slerp(fossil_math_geom_quat a, fossil_math_geom_quat b, double t) {
+    fossil_math_geom_quat r;
+    _quat_lerp_chunk(&a, &b, &t, &r, 1, 1);
+    return r;
+}
+
+fossil_math_geom_quat fossil_math_geom_quat_nlerp(fossil_math_geom_quat a, fossil_math_geom_quat b, double t) {
+    fossil_math_geom_quat r;
+    _quat_lerp_chunk(&a, &b, &t, &r, 1, 0);
+    return r;
+}
+
 // ======================================================
 // Plane (3D)
 // ======================================================
@@ -113,3 +2348,893 @@ double fossil_math_geom_point_plane_distance(fossil_math_geom_point3d p,
                         plane.normal.z * plane.normal.z);
     return num / denom;
 }
+
+int fossil_math_geom_plane_prepare(fossil_math_geom_plane plane, fossil_math_geom_prepared_plane* out) {
+    double len = sqrt(plane.normal.x * plane.normal.x +
+                      plane.normal.y * plane.normal.y +
+                      plane.normal.z * plane.normal.z);
+    if (!(len > 0.0) || !isfinite(len) || !isfinite(plane.d))
+        return -1;
+    out->normal.x = plane.normal.x / len;
+    out->normal.y = plane.normal.y / len;
+    out->normal.z = plane.normal.z / len;
+    out->d = plane.d / len;
+    return 0;
+}
+
+double fossil_math_geom_prepared_plane_distance(const fossil_math_geom_prepared_plane* plane,
+                                                fossil_math_geom_point3d p) {
+    return plane->normal.x * p.x + plane->normal.y * p.y + plane->normal.z * p.z + plane->d;
+}
+
+// Classification splits the mask words into at most GEOM_PLANE_MAX_TASKS
+// slices, each counting its own visible points (see GEOM_HULL_TASK_SPAN).
+#define GEOM_PLANE_MAX_TASKS 64
+#define GEOM_PLANE_TASK_SPAN 64
+
+typedef struct {
+    const double* x;
+    const double* y;
+    const double* z;
+    const double* radii;
+    size_t n;
+    const fossil_math_geom_prepared_plane* planes;
+    size_t m;
+    double* out;
+    uint64_t* inside;
+    uint64_t* intersecting;
+    size_t words;
+    size_t tasks;
+    size_t visible[GEOM_PLANE_MAX_TASKS];
+} plane_job;
+
+static simd_vd _plane_distance(const fossil_math_geom_prepared_plane* p, simd_vd x, simd_vd y, simd_vd z) {
+    return simd_add(simd_add(simd_add(simd_mul(simd_set1(p->normal.x), x), simd_mul(simd_set1(p->normal.y), y)),
+                             simd_mul(simd_set1(p->normal.z), z)),
+                    simd_set1(p->d));
+}
+
+static void _plane_range(void* ctx, size_t begin, size_t end) {
+    const plane_job* job = (const plane_job*)ctx;
+    for (size_t i = begin; i < end; i += SIMD_LANES) {
+        size_t len = (end - i < SIMD_LANES) ? end - i : SIMD_LANES;
+        simd_vd x, y, z;
+        if (len == SIMD_LANES) {
+            x = simd_load(job->x + i);
+            y = simd_load(job->y + i);
+            z = simd_load(job->z + i);
+        } else {
+            x = simd_load_partial(job->x + i, len, 0.0);
+            y = simd_load_partial(job->y + i, len, 0.0);
+            z = simd_load_partial(job->z + i, len, 0.0);
+        }
+        for (size_t j = 0; j < job->m; j++) {
+            simd_vd d = _plane_distance(&job->planes[j], x, y, z);
+            if (len == SIMD_LANES)
+                simd_store(job->out + j * job->n + i, d);
+            else
+                simd_store_partial(job->out + j * job->n + i, len, d);
+        }
+    }
+}
+
+void fossil_math_geom_cloud3d_plane_distance(const fossil_math_geom_cloud3d* cloud,
+                                             const fossil_math_geom_prepared_plane* planes, size_t m, double* out) {
+    if (m == 0)
+        return;
+    plane_job job = {cloud->x, cloud->y, cloud->z, NULL, cloud->size, planes, m, out, NULL, NULL, 0, 0, {0}};
+    fossil_math_parallel_for(cloud->size, GEOM_CLOUD_GRAIN, _plane_range, &job);
+}
+
+// One 64-point word at a time, as for the circle masks. A lane stays visible
+// while d >= -r on every plane and inside while d >= r, so NaN distances end
+// up outside; once every lane of a group is outside the remaining planes are
+// skipped. Returns the number of visible points in words [begin, end).
+static size_t _plane_words(const plane_job* job, size_t begin, size_t end) {
+    size_t visible = 0;
+    for (size_t w = begin; w < end; w++) {
+        size_t base = w * 64;
+        size_t stop = (job->n - base < 64) ? job->n : base + 64;
+        uint64_t in_word = 0, vis_word = 0;
+        for (size_t i = base; i < stop; i += SIMD_LANES) {
+            size_t len = (stop - i < SIMD_LANES) ? stop - i : SIMD_LANES;
+            simd_vd x, y, z, r = simd_set1(0.0);
+            if (len == SIMD_LANES) {
+                x = simd_load(job->x + i);
+                y = simd_load(job->y + i);
+                z = simd_load(job->z + i);
+                if (job->radii)
+                    r = simd_load(job->radii + i);
+            } else {
+                x = simd_load_partial(job->x + i, len, 0.0);
+                y = simd_load_partial(job->y + i, len, 0.0);
+                z = simd_load_partial(job->z + i, len, 0.0);
+                if (job->radii)
+                    r = simd_load_partial(job->radii + i, len, 0.0);
+            }
+            simd_vd neg_r = simd_sub(simd_set1(0.0), r);
+            simd_vd vis = simd_eq(x, x), in = vis;
+            for (size_t j = 0; j < job->m; j++) {
+                simd_vd d = _plane_distance(&job->planes[j], x, y, z);
+                vis = simd_and(vis, simd_ge(d, neg_r));
+                in = simd_and(in, simd_ge(d, r));
+                if (simd_mask_bits(vis) == 0)
+                    break;
+            }
+            int live = (int)(((unsigned)1 << len) - 1);
+            vis_word |= (uint64_t)(simd_mask_bits(vis) & live) << (i - base);
+            in_word |= (uint64_t)(simd_mask_bits(simd_and(vis, in)) & live) << (i - base);
+        }
+        if (job->inside)
+            job->inside[w] = in_word;
+        if (job->intersecting)
+            job->intersecting[w] = vis_word & ~in_word;
+        visible += _popcount64(vis_word);
+    }
+    return visible;
+}
+
+static void _plane_slices(void* ctx, size_t begin, size_t end) {
+    plane_job* job = (plane_job*)ctx;
+    for (size_t j = (begin + GEOM_PLANE_TASK_SPAN - 1) / GEOM_PLANE_TASK_SPAN;
+         j < job->tasks && j * GEOM_PLANE_TASK_SPAN < end; j++)
+        job->visible[j] = _plane_words(job, job->words * j / job->tasks, job->words * (j + 1) / job->tasks);
+}
+
+size_t fossil_math_geom_cloud3d_classify_planes(const fossil_math_geom_cloud3d* cloud, const double* radii,
+                                                const fossil_math_geom_prepared_plane* planes, size_t m,
+                                                uint64_t* inside, uint64_t* intersecting) {
+    plane_job job = {cloud->x, cloud->y, cloud->z, radii, cloud->size, planes, m, NULL, inside, intersecting,
+                     FOSSIL_MATH_GEOM_MASK_WORDS(cloud->size), 1, {0}};
+    size_t per_task = GEOM_CLOUD_GRAIN / 64;
+    if (job.words >= 2 * per_task) {
+        job.tasks = fossil_math_get_threads();
+        if (job.tasks > job.words / per_task)
+            job.tasks = job.words / per_task;
+        if (job.tasks > GEOM_PLANE_MAX_TASKS)
+            job.tasks = GEOM_PLANE_MAX_TASKS;
+    }
+    fossil_math_parallel_for(job.tasks * GEOM_PLANE_TASK_SPAN, GEOM_PLANE_TASK_SPAN, _plane_slices, &job);
+    size_t visible = 0;
+    for (size_t j = 0; j < job.tasks; j++)
+        visible += job.visible[j];
+    return visible;
+}
+
+// ======================================================
+// Robust predicates
+// ======================================================
+// Adaptive-precision predicates after Shewchuk, "Adaptive Precision
+// Floating-Point Arithmetic and Fast Robust Geometric Predicates" (1997).
+// Each one evaluates its determinant in plain doubles together with a forward
+// error bound (stage A). Only when the bound cannot certify the sign does it
+// recompute the determinant exactly on the rounded coordinate differences
+// (stage B), add the first-order terms of the differences' roundoff
+// (stage C), and finally evaluate it exactly from the input coordinates.
+// Signs are exact as long as no intermediate value overflows or underflows.
+//
+// The expansion arithmetic needs every operation rounded on its own: a
+// contracted multiply-add breaks the Two-Sum and Dekker product identities.
+// GCC does not contract in ISO C mode (the build uses -std=c11); clang and
+// MSVC are told explicitly. This section is last in the file so the pragma
+// does not reach the kernels above.
+#if defined(__clang__)
+#pragma STDC FP_CONTRACT OFF
+#elif defined(_MSC_VER)
+#pragma fp_contract(off)
+#endif
+
+#define GEOM_PRED_EPS (DBL_EPSILON * 0.5)
+#define GEOM_PRED_SPLITTER 134217729.0 // 2^27 + 1
+#define GEOM_PRED_BOUND(k, m) (((k) + (m) * GEOM_PRED_EPS) * GEOM_PRED_EPS)
+#define GEOM_PRED_RESULT_ERR GEOM_PRED_BOUND(3.0, 8.0)
+#define GEOM_PRED_CCW_A GEOM_PRED_BOUND(3.0, 16.0)
+#define GEOM_PRED_CCW_B GEOM_PRED_BOUND(2.0, 12.0)
+#define GEOM_PRED_CCW_C (GEOM_PRED_BOUND(9.0, 64.0) * GEOM_PRED_EPS)
+#define GEOM_PRED_O3D_A GEOM_PRED_BOUND(7.0, 56.0)
+#define GEOM_PRED_O3D_B GEOM_PRED_BOUND(3.0, 28.0)
+#define GEOM_PRED_O3D_C (GEOM_PRED_BOUND(26.0, 288.0) * GEOM_PRED_EPS)
+#define GEOM_PRED_ICC_A GEOM_PRED_BOUND(10.0, 96.0)
+#define GEOM_PRED_ICC_B GEOM_PRED_BOUND(4.0, 48.0)
+#define GEOM_PRED_ICC_C (GEOM_PRED_BOUND(44.0, 576.0) * GEOM_PRED_EPS)
+#define GEOM_PRED_ISP_A GEOM_PRED_BOUND(16.0, 224.0)
+#define GEOM_PRED_ISP_B GEOM_PRED_BOUND(5.0, 72.0)
+#define GEOM_PRED_ISP_C (GEOM_PRED_BOUND(71.0, 1408.0) * GEOM_PRED_EPS)
+
+// Longest expansion passed to _pred_lift() (a 4x4 insphere minor).
+#define GEOM_PRED_LIFT_MAX 96
+
+// x + y == a + b exactly, with x the rounded sum.
+static void _pred_two_sum(double a, double b, double* x, double* y) {
+    double s = a + b;
+    double bv = s - a;
+    double av = s - bv;
+    *x = s;
+    *y = (a - av) + (b - bv);
+}
+
+// As _pred_two_sum() when |a| >= |b|.
+static void _pred_fast_two_sum(double a, double b, double* x, double* y) {
+    double s = a + b;
+    *x = s;
+    *y = b - (s - a);
+}
+
+// Roundoff of x = fl(a - b): a - b == x + tail exactly.
+static double _pred_diff_tail(double a, double b, double x) {
+    double bv = a - x;
+    double av = x + bv;
+    return (a - av) + (bv - b);
+}
+
+// x + y == a * b exactly, with x the rounded product.
+static void _pred_two_product(double a, double b, double* x, double* y) {
+    double p = a * b;
+    *x = p;
+#if defined(FP_FAST_FMA)
+    *y = fma(a, b, -p);
+#else
+    double c = GEOM_PRED_SPLITTER * a;
+    double ahi = c - (c - a), alo = a - ahi;
+    c = GEOM_PRED_SPLITTER * b;
+    double bhi = c - (c - b), blo = b - bhi;
+    *y = alo * blo - (((p - ahi * bhi) - alo * bhi) - ahi * blo);
+#endif
+}
+
+// Expansions are arrays of nonoverlapping doubles in increasing magnitude
+// whose exact sum is the represented value; zero components are dropped, so
+// the last component carries the sign.
+
+// h = e + f; h needs room for elen + flen components. Returns the length.
+static int _pred_sum(int elen, const double* e, int flen, const double* f, double* h) {
+    int ei = 0, fi = 0, hi = 0;
+    double enow = e[0], fnow = f[0], q, hh;
+    if ((fnow > enow) == (fnow > -enow)) {
+        q = enow;
+        enow = (++ei < elen) ? e[ei] : 0.0;
+    } else {
+        q = fnow;
+        fnow = (++fi < flen) ? f[fi] : 0.0;
+    }
+    if (ei < elen && fi < flen) {
+        if ((fnow > enow) == (fnow > -enow)) {
+            _pred_fast_two_sum(enow, q, &q, &hh);
+            enow = (++ei < elen) ? e[ei] : 0.0;
+        } else {
+            _pred_fast_two_sum(fnow, q, &q, &hh);
+            fnow = (++fi < flen) ? f[fi] : 0.0;
+        }
+        if (hh != 0.0)
+            h[hi++] = hh;
+        while (ei < elen && fi < flen) {
+            if ((fnow > enow) == (fnow > -enow)) {
+                _pred_two_sum(q, enow, &q, &hh);
+                enow = (++ei < elen) ? e[ei] : 0.0;
+            } else {
+                _pred_two_sum(q, fnow, &q, &hh);
+                fnow = (++fi < flen) ? f[fi] : 0.0;
+            }
+            if (hh != 0.0)
+                h[hi++] = hh;
+        }
+    }
+    for (; ei < elen; ei++) {
+        _pred_two_sum(q, e[ei], &q, &hh);
+        if (hh != 0.0)
+            h[hi++] = hh;
+    }
+    for (; fi < flen; fi++) {
+        _pred_two_sum(q, f[fi], &q, &hh);
+        if (hh != 0.0)
+            h[hi++] = hh;
+    }
+    if (q != 0.0 || hi == 0)
+        h[hi++] = q;
+    return hi;
+}
+
+// h = e * b; h needs room for 2 * elen components. Returns the length.
+static int _pred_scale(int elen, const double* e, double b, double* h) {
+    int hi = 0;
+    double q, hh, p1, p0, s;
+    _pred_two_product(e[0], b, &q, &hh);
+    if (hh != 0.0)
+        h[hi++] = hh;
+    for (int i = 1; i < elen; i++) {
+        _pred_two_product(e[i], b, &p1, &p0);
+        _pred_two_sum(q, p0, &s, &hh);
+        if (hh != 0.0)
+            h[hi++] = hh;
+        _pred_fast_two_sum(p1, s, &q, &hh);
+        if (hh != 0.0)
+            h[hi++] = hh;
+    }
+    if (q != 0.0 || hi == 0)
+        h[hi++] = q;
+    return hi;
+}
+
+static double _pred_estimate(int elen, const double* e) {
+    double q = e[0];
+    for (int i = 1; i < elen; i++)
+        q += e[i];
+    return q;
+}
+
+// h = a * b - c * d; at most 4 components.
+static int _pred_cross(double a, double b, double c, double d, double* h) {
+    double p[2], q[2];
+    _pred_two_product(a, b, &p[1], &p[0]);
+    _pred_two_product(-c, d, &q[1], &q[0]);
+    return _pred_sum(2, p, 2, q, h);
+}
+
+// h = e * (c[0]^2 + ... + c[dims - 1]^2); at most 4 * dims * elen components.
+static int _pred_lift(int elen, const double* e, const double* c, int dims, double* h) {
+    double t1[2 * GEOM_PRED_LIFT_MAX], t2[4 * GEOM_PRED_LIFT_MAX], acc[8 * GEOM_PRED_LIFT_MAX];
+    int len = 0;
+    for (int k = 0; k < dims; k++) {
+        int l1 = _pred_scale(elen, e, c[k], t1);
+        int l2 = _pred_scale(l1, t1, c[k], t2);
+        if (k == 0) {
+            memcpy(h, t2, (size_t)l2 * sizeof(double));
+            len = l2;
+        } else {
+            memcpy(acc, h, (size_t)len * sizeof(double));
+            len = _pred_sum(len, acc, l2, t2, h);
+        }
+    }
+    return len;
+}
+
+// det [p; q; r] with rows (x, y, 1); at most 12 components.
+static int _pred_det3_xy1(fossil_math_geom_point2d p, fossil_math_geom_point2d q,
+                          fossil_math_geom_point2d r, double* h) {
+    double pq[4], qr[4], rp[4], t[8];
+    int l1 = _pred_cross(p.x, q.y, q.x, p.y, pq);
+    int l2 = _pred_cross(q.x, r.y, r.x, q.y, qr);
+    int l3 = _pred_cross(r.x, p.y, p.x, r.y, rp);
+    int lt = _pred_sum(l1, pq, l2, qr, t);
+    return _pred_sum(lt, t, l3, rp, h);
+}
+
+// det [p; q; r] with rows (x, y, z); at most 24 components.
+static int _pred_det3_xyz(fossil_math_geom_point3d p, fossil_math_geom_point3d q,
+                          fossil_math_geom_point3d r, double* h) {
+    double m[4], t1[8], t2[8], t3[8], t12[16];
+    int len = _pred_cross(q.x, r.y, r.x, q.y, m);
+    int l1 = _pred_scale(len, m, p.z, t1);
+    len = _pred_cross(r.x, p.y, p.x, r.y, m);
+    int l2 = _pred_scale(len, m, q.z, t2);
+    len = _pred_cross(p.x, q.y, q.x, p.y, m);
+    int l3 = _pred_scale(len, m, r.z, t3);
+    int l12 = _pred_sum(l1, t1, l2, t2, t12);
+    return _pred_sum(l12, t12, l3, t3, h);
+}
+
+// det [p; q; r; s] with rows (x, y, z, 1), expanded along the last column as
+// [pqr] + [qps] + [prs] + [rqs]; at most 96 components.
+static int _pred_det4_xyz1(fossil_math_geom_point3d p, fossil_math_geom_point3d q,
+                           fossil_math_geom_point3d r, fossil_math_geom_point3d s, double* h) {
+    double t1[24], t2[24], u[48], v[48];
+    int l1 = _pred_det3_xyz(p, q, r, t1);
+    int l2 = _pred_det3_xyz(q, p, s, t2);
+    int lu = _pred_sum(l1, t1, l2, t2, u);
+    l1 = _pred_det3_xyz(p, r, s, t1);
+    l2 = _pred_det3_xyz(r, q, s, t2);
+    int lv = _pred_sum(l1, t1, l2, t2, v);
+    return _pred_sum(lu, u, lv, v, h);
+}
+
+static double _pred_orient2d_adapt(fossil_math_geom_point2d a, fossil_math_geom_point2d b,
+                                   fossil_math_geom_point2d c, double detsum) {
+    double acx = a.x - c.x, bcx = b.x - c.x;
+    double acy = a.y - c.y, bcy = b.y - c.y;
+    double bb[4], c1[8], c2[12], d[16], u[4];
+    int blen = _pred_cross(acx, bcy, acy, bcx, bb);
+    double det = _pred_estimate(blen, bb);
+    double errbound = GEOM_PRED_CCW_B * detsum;
+    if (det >= errbound || -det >= errbound)
+        return det;
+
+    double acxtail = _pred_diff_tail(a.x, c.x, acx), bcxtail = _pred_diff_tail(b.x, c.x, bcx);
+    double acytail = _pred_diff_tail(a.y, c.y, acy), bcytail = _pred_diff_tail(b.y, c.y, bcy);
+    if (acxtail == 0.0 && acytail == 0.0 && bcxtail == 0.0 && bcytail == 0.0)
+        return det;
+
+    errbound = GEOM_PRED_CCW_C * detsum + GEOM_PRED_RESULT_ERR * fabs(det);
+    det += (acx * bcytail + bcy * acxtail) - (acy * bcxtail + bcx * acytail);
+    if (det >= errbound || -det >= errbound)
+        return det;
+
+    int ulen = _pred_cross(acxtail, bcy, acytail, bcx, u);
+    int c1len = _pred_sum(blen, bb, ulen, u, c1);
+    ulen = _pred_cross(acx, bcytail, acy, bcxtail, u);
+    int c2len = _pred_sum(c1len, c1, ulen, u, c2);
+    ulen = _pred_cross(acxtail, bcytail, acytail, bcxtail, u);
+    int dlen = _pred_sum(c2len, c2, ulen, u, d);
+    return d[dlen - 1];
+}
+
+double fossil_math_geom_orient2d(fossil_math_geom_point2d a, fossil_math_geom_point2d b,
+                                 fossil_math_geom_point2d c) {
+    double detleft = (a.x - c.x) * (b.y - c.y);
+    double detright = (a.y - c.y) * (b.x - c.x);
+    double det = detleft - detright, detsum;
+    if (detleft > 0.0) {
+        if (detright <= 0.0)
+            return det;
+        detsum = detleft + detright;
+    } else if (detleft < 0.0) {
+        if (detright >= 0.0)
+            return det;
+        detsum = -detleft - detright;
+    } else {
+        return det;
+    }
+    double errbound = GEOM_PRED_CCW_A * detsum;
+    if (det >= errbound || -det >= errbound)
+        return det;
+    return _pred_orient2d_adapt(a, b, c, detsum);
+}
+
+static double _pred_orient3d_adapt(fossil_math_geom_point3d a, fossil_math_geom_point3d b,
+                                   fossil_math_geom_point3d c, fossil_math_geom_point3d d, double permanent) {
+    double adx = a.x - d.x, bdx = b.x - d.x, cdx = c.x - d.x;
+    double ady = a.y - d.y, bdy = b.y - d.y, cdy = c.y - d.y;
+    double adz = a.z - d.z, bdz = b.z - d.z, cdz = c.z - d.z;
+    fossil_math_geom_point3d ad = {adx, ady, adz}, bd = {bdx, bdy, bdz}, cd = {cdx, cdy, cdz};
+    double fin[24];
+    int len = _pred_det3_xyz(ad, bd, cd, fin);
+    double det = _pred_estimate(len, fin);
+    double errbound = GEOM_PRED_O3D_B * permanent;
+    if (det >= errbound || -det >= errbound)
+        return det;
+
+    double adxtail = _pred_diff_tail(a.x, d.x, adx), bdxtail = _pred_diff_tail(b.x, d.x, bdx);
+    double cdxtail = _pred_diff_tail(c.x, d.x, cdx), adytail = _pred_diff_tail(a.y, d.y, ady);
+    double bdytail = _pred_diff_tail(b.y, d.y, bdy), cdytail = _pred_diff_tail(c.y, d.y, cdy);
+    double adztail = _pred_diff_tail(a.z, d.z, adz), bdztail = _pred_diff_tail(b.z, d.z, bdz);
+    double cdztail = _pred_diff_tail(c.z, d.z, cdz);
+    if (adxtail == 0.0 && bdxtail == 0.0 && cdxtail == 0.0 && adytail == 0.0 && bdytail == 0.0
+        && cdytail == 0.0 && adztail == 0.0 && bdztail == 0.0 && cdztail == 0.0)
+        return det;
+
+    errbound = GEOM_PRED_O3D_C * permanent + GEOM_PRED_RESULT_ERR * fabs(det);
+    det += (adz * ((bdx * cdytail + cdy * bdxtail) - (bdy * cdxtail + cdx * bdytail))
+            + adztail * (bdx * cdy - bdy * cdx))
+         + (bdz * ((cdx * adytail + ady * cdxtail) - (cdy * adxtail + adx * cdytail))
+            + bdztail * (cdx * ady - cdy * adx))
+         + (cdz * ((adx * bdytail + bdy * adxtail) - (ady * bdxtail + bdx * adytail))
+            + cdztail * (adx * bdy - ady * bdx));
+    if (det >= errbound || -det >= errbound)
+        return det;
+
+    double exact[96];
+    len = _pred_det4_xyz1(a, b, c, d, exact);
+    return exact[len - 1];
+}
+
+double fossil_math_geom_orient3d(fossil_math_geom_point3d a, fossil_math_geom_point3d b,
+                                 fossil_math_geom_point3d c, fossil_math_geom_point3d d) {
+    double adx = a.x - d.x, bdx = b.x - d.x, cdx = c.x - d.x;
+    double ady = a.y - d.y, bdy = b.y - d.y, cdy = c.y - d.y;
+    double adz = a.z - d.z, bdz = b.z - d.z, cdz = c.z - d.z;
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady, adxcdy = adx * cdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady;
+    double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    double permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * fabs(adz) + (fabs(cdxady) + fabs(adxcdy)) * fabs(bdz)
+                     + (fabs(adxbdy) + fabs(bdxady)) * fabs(cdz);
+    double errbound = GEOM_PRED_O3D_A * permanent;
+    if (det > errbound || -det > errbound)
+        return det;
+    return _pred_orient3d_adapt(a, b, c, d, permanent);
+}
+
+// Exact in-circle determinant: det [p; ...] with rows (x, y, x^2 + y^2, 1),
+// expanded along the lifted column. The cofactor signs are folded into the
+// order of each row's triple.
+static double _pred_incircle_exact(const fossil_math_geom_point2d* p) {
+    static const unsigned char tri[4][3] = {{1, 2, 3}, {2, 0, 3}, {0, 1, 3}, {1, 0, 2}};
+    double m[12], row[96], acc[2][384];
+    int len = 0, cur = 0;
+    for (int i = 0; i < 4; i++) {
+        int mlen = _pred_det3_xy1(p[tri[i][0]], p[tri[i][1]], p[tri[i][2]], m);
+        double w[2] = {p[i].x, p[i].y};
+        int rlen = _pred_lift(mlen, m, w, 2, row);
+        if (i == 0) {
+            memcpy(acc[0], row, (size_t)rlen * sizeof(double));
+            len = rlen;
+        } else {
+            len = _pred_sum(len, acc[cur], rlen, row, acc[cur ^ 1]);
+            cur ^= 1;
+        }
+    }
+    return acc[cur][len - 1];
+}
+
+static double _pred_incircle_adapt(fossil_math_geom_point2d a, fossil_math_geom_point2d b,
+                                   fossil_math_geom_point2d c, fossil_math_geom_point2d d, double permanent) {
+    double adx = a.x - d.x, bdx = b.x - d.x, cdx = c.x - d.x;
+    double ady = a.y - d.y, bdy = b.y - d.y, cdy = c.y - d.y;
+    double m[4], adet[32], bdet[32], cdet[32], abdet[64], fin[96];
+    double aw[2] = {adx, ady}, bw[2] = {bdx, bdy}, cw[2] = {cdx, cdy};
+    int len = _pred_cross(bdx, cdy, cdx, bdy, m);
+    int alen = _pred_lift(len, m, aw, 2, adet);
+    len = _pred_cross(cdx, ady, adx, cdy, m);
+    int blen = _pred_lift(len, m, bw, 2, bdet);
+    len = _pred_cross(adx, bdy, bdx, ady, m);
+    int clen = _pred_lift(len, m, cw, 2, cdet);
+    int ablen = _pred_sum(alen, adet, blen, bdet, abdet);
+    len = _pred_sum(ablen, abdet, clen, cdet, fin);
+    double det = _pred_estimate(len, fin);
+    double errbound = GEOM_PRED_ICC_B * permanent;
+    if (det >= errbound || -det >= errbound)
+        return det;
+
+    double adxtail = _pred_diff_tail(a.x, d.x, adx), adytail = _pred_diff_tail(a.y, d.y, ady);
+    double bdxtail = _pred_diff_tail(b.x, d.x, bdx), bdytail = _pred_diff_tail(b.y, d.y, bdy);
+    double cdxtail = _pred_diff_tail(c.x, d.x, cdx), cdytail = _pred_diff_tail(c.y, d.y, cdy);
+    if (adxtail == 0.0 && bdxtail == 0.0 && cdxtail == 0.0 && adytail == 0.0 && bdytail == 0.0 && cdytail == 0.0)
+        return det;
+
+    errbound = GEOM_PRED_ICC_C * permanent + GEOM_PRED_RESULT_ERR * fabs(det);
+    det += ((adx * adx + ady * ady) * ((bdx * cdytail + cdy * bdxtail) - (bdy * cdxtail + cdx * bdytail))
+            + 2.0 * (adx * adxtail + ady * adytail) * (bdx * cdy - bdy * cdx))
+         + ((bdx * bdx + bdy * bdy) * ((cdx * adytail + ady * cdxtail) - (cdy * adxtail + adx * cdytail))
+            + 2.0 * (bdx * bdxtail + bdy * bdytail) * (cdx * ady - cdy * adx))
+         + ((cdx * cdx + cdy * cdy) * ((adx * bdytail + bdy * adxtail) - (ady * bdxtail + bdx * adytail))
+            + 2.0 * (cdx * cdxtail + cdy * cdytail) * (adx * bdy - ady * bdx));
+    if (det >= errbound || -det >= errbound)
+        return det;
+
+    fossil_math_geom_point2d p[4] = {a, b, c, d};
+    return _pred_incircle_exact(p);
+}
+
+double fossil_math_geom_incircle(fossil_math_geom_point2d a, fossil_math_geom_point2d b,
+                                 fossil_math_geom_point2d c, fossil_math_geom_point2d d) {
+    double adx = a.x - d.x, bdx = b.x - d.x, cdx = c.x - d.x;
+    double ady = a.y - d.y, bdy = b.y - d.y, cdy = c.y - d.y;
+    double bdxcdy = bdx * cdy, cdxbdy = cdx * bdy, alift = adx * adx + ady * ady;
+    double cdxady = cdx * ady, adxcdy = adx * cdy, blift = bdx * bdx + bdy * bdy;
+    double adxbdy = adx * bdy, bdxady = bdx * ady, clift = cdx * cdx + cdy * cdy;
+    double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+    double permanent = (fabs(bdxcdy) + fabs(cdxbdy)) * alift + (fabs(cdxady) + fabs(adxcdy)) * blift
+                     + (fabs(adxbdy) + fabs(bdxady)) * clift;
+    double errbound = GEOM_PRED_ICC_A * permanent;
+    if (det > errbound || -det > errbound)
+        return det;
+    return _pred_incircle_adapt(a, b, c, d, permanent);
+}
+
+// Exact in-sphere determinant: det [p; ...] with rows (x, y, z, |p|^2, 1),
+// expanded along the lifted column like _pred_incircle_exact().
+static double _pred_insphere_exact(const fossil_math_geom_point3d* p) {
+    static const unsigned char quad[5][4] = {{2, 1, 3, 4}, {0, 2, 3, 4}, {1, 0, 3, 4}, {0, 1, 2, 4}, {1, 0, 2, 3}};
+    double m[96], row[1152], acc[2][5760];
+    int len = 0, cur = 0;
+    for (int i = 0; i < 5; i++) {
+        int mlen = _pred_det4_xyz1(p[quad[i][0]], p[quad[i][1]], p[quad[i][2]], p[quad[i][3]], m);
+        double w[3] = {p[i].x, p[i].y, p[i].z};
+        int rlen = _pred_lift(mlen, m, w, 3, row);
+        if (i == 0) {
+            memcpy(acc[0], row, (size_t)rlen * sizeof(double));
+            len = rlen;
+        } else {
+            len = _pred_sum(len, acc[cur], rlen, row, acc[cur ^ 1]);
+            cur ^= 1;
+        }
+    }
+    return acc[cur][len - 1];
+}
+
+static double _pred_insphere_adapt(fossil_math_geom_point3d a, fossil_math_geom_point3d b,
+                                   fossil_math_geom_point3d c, fossil_math_geom_point3d d,
+                                   fossil_math_geom_point3d e, double permanent) {
+    double aex = a.x - e.x, bex = b.x - e.x, cex = c.x - e.x, dex = d.x - e.x;
+    double aey = a.y - e.y, bey = b.y - e.y, cey = c.y - e.y, dey = d.y - e.y;
+    double aez = a.z - e.z, bez = b.z - e.z, cez = c.z - e.z, dez = d.z - e.z;
+    fossil_math_geom_point3d ae = {aex, aey, aez}, be = {bex, bey, bez};
+    fossil_math_geom_point3d ce = {cex, cey, cez}, de = {dex, dey, dez};
+    double aw[3] = {aex, aey, aez}, bw[3] = {bex, bey, bez}, cw[3] = {cex, cey, cez}, dw[3] = {dex, dey, dez};
+    // det [ae; be; ce; de] with rows (x, y, z, lift), expanded along the lift
+    // column as -a[bcd] + b[cda] - c[dab] + d[abc].
+    double t[24], adet[288], bdet[288], cdet[288], ddet[288], abdet[576], cddet[576], fin[1152];
+    int len = _pred_det3_xyz(ce, be, de, t);
+    int alen = _pred_lift(len, t, aw, 3, adet);
+    len = _pred_det3_xyz(ce, de, ae, t);
+    int blen = _pred_lift(len, t, bw, 3, bdet);
+    len = _pred_det3_xyz(ae, de, be, t);
+    int clen = _pred_lift(len, t, cw, 3, cdet);
+    len = _pred_det3_xyz(ae, be, ce, t);
+    int dlen = _pred_lift(len, t, dw, 3, ddet);
+    int ablen = _pred_sum(alen, adet, blen, bdet, abdet);
+    int cdlen = _pred_sum(clen, cdet, dlen, ddet, cddet);
+    len = _pred_sum(ablen, abdet, cdlen, cddet, fin);
+    double det = _pred_estimate(len, fin);
+    double errbound = GEOM_PRED_ISP_B * permanent;
+    if (det >= errbound || -det >= errbound)
+        return det;
+
+    double aextail = _pred_diff_tail(a.x, e.x, aex), aeytail = _pred_diff_tail(a.y, e.y, aey);
+    double aeztail = _pred_diff_tail(a.z, e.z, aez), bextail = _pred_diff_tail(b.x, e.x, bex);
+    double beytail = _pred_diff_tail(b.y, e.y, bey), beztail = _pred_diff_tail(b.z, e.z, bez);
+    double cextail = _pred_diff_tail(c.x, e.x, cex), ceytail = _pred_diff_tail(c.y, e.y, cey);
+    double ceztail = _pred_diff_tail(c.z, e.z, cez), dextail = _pred_diff_tail(d.x, e.x, dex);
+    double deytail = _pred_diff_tail(d.y, e.y, dey), deztail = _pred_diff_tail(d.z, e.z, dez);
+    if (aextail == 0.0 && aeytail == 0.0 && aeztail == 0.0 && bextail == 0.0 && beytail == 0.0
+        && beztail == 0.0 && cextail == 0.0 && ceytail == 0.0 && ceztail == 0.0 && dextail == 0.0
+        && deytail == 0.0 && deztail == 0.0)
+        return det;
+
+    // Leading components of the exact 2x2 minors of the differences.
+    double m[4];
+    len = _pred_cross(aex, bey, bex, aey, m);
+    double ab3 = m[len - 1];
+    len = _pred_cross(bex, cey, cex, bey, m);
+    double bc3 = m[len - 1];
+    len = _pred_cross(cex, dey, dex, cey, m);
+    double cd3 = m[len - 1];
+    len = _pred_cross(dex, aey, aex, dey, m);
+    double da3 = m[len - 1];
+    len = _pred_cross(aex, cey, cex, aey, m);
+    double ac3 = m[len - 1];
+    len = _pred_cross(bex, dey, dex, bey, m);
+    double bd3 = m[len - 1];
+
+    errbound = GEOM_PRED_ISP_C * permanent + GEOM_PRED_RESULT_ERR * fabs(det);
+    double abeps = (aex * beytail + bey * aextail) - (aey * bextail + bex * aeytail);
+    double bceps = (bex * ceytail + cey * bextail) - (bey * cextail + cex * beytail);
+    double cdeps = (cex * deytail + dey * cextail) - (cey * dextail + dex * ceytail);
+    double daeps = (dex * aeytail + aey * dextail) - (dey * aextail + aex * deytail);
+    double aceps = (aex * ceytail + cey * aextail) - (aey * cextail + cex * aeytail);
+    double bdeps = (bex * deytail + dey * bextail) - (bey * dextail + dex * beytail);
+    det += (((bex * bex + bey * bey + bez * bez)
+             * ((cez * daeps + dez * aceps + aez * cdeps) + (ceztail * da3 + deztail * ac3 + aeztail * cd3))
+             + (dex * dex + dey * dey + dez * dez)
+             * ((aez * bceps - bez * aceps + cez * abeps) + (aeztail * bc3 - beztail * ac3 + ceztail * ab3)))
+            - ((aex * aex + aey * aey + aez * aez)
+             * ((bez * cdeps - cez * bdeps + dez * bceps) + (beztail * cd3 - ceztail * bd3 + deztail * bc3))
+             + (cex * cex + cey * cey + cez * cez)
+             * ((dez * abeps + aez * bdeps + bez * daeps) + (deztail * ab3 + aeztail * bd3 + beztail * da3))))
+         + 2.0 * (((bex * bextail + bey * beytail + bez * beztail) * (cez * da3 + dez * ac3 + aez * cd3)
+                   + (dex * dextail + dey * deytail + dez * deztail) * (aez * bc3 - bez * ac3 + cez * ab3))
+                  - ((aex * aextail + aey * aeytail + aez * aeztail) * (bez * cd3 - cez * bd3 + dez * bc3)
+                     + (cex * cextail + cey * ceytail + cez * ceztail) * (dez * ab3 + aez * bd3 + bez * da3)));
+    if (det >= errbound || -det >= errbound)
+        return det;
+
+    fossil_math_geom_point3d p[5] = {a, b, c, d, e};
+    return _pred_insphere_exact(p);
+}
+
+double fossil_math_geom_insphere(fossil_math_geom_point3d a, fossil_math_geom_point3d b,
+                                 fossil_math_geom_point3d c, fossil_math_geom_point3d d,
+                                 fossil_math_geom_point3d e) {
+    double aex = a.x - e.x, bex = b.x - e.x, cex = c.x - e.x, dex = d.x - e.x;
+    double aey = a.y - e.y, bey = b.y - e.y, cey = c.y - e.y, dey = d.y - e.y;
+    double aez = a.z - e.z, bez = b.z - e.z, cez = c.z - e.z, dez = d.z - e.z;
+    double aexbey = aex * bey, bexaey = bex * aey, ab = aexbey - bexaey;
+    double bexcey = bex * cey, cexbey = cex * bey, bc = bexcey - cexbey;
+    double cexdey = cex * dey, dexcey = dex * cey, cd = cexdey - dexcey;
+    double dexaey = dex * aey, aexdey = aex * dey, da = dexaey - aexdey;
+    double aexcey = aex * cey, cexaey = cex * aey, ac = aexcey - cexaey;
+    double bexdey = bex * dey, dexbey = dex * bey, bd = bexdey - dexbey;
+    double abc = aez * bc - bez * ac + cez * ab;
+    double bcd = bez * cd - cez * bd + dez * bc;
+    double cda = cez * da + dez * ac + aez * cd;
+    double dab = dez * ab + aez * bd + bez * da;
+    double alift = aex * aex + aey * aey + aez * aez;
+    double blift = bex * bex + bey * bey + bez * bez;
+    double clift = cex * cex + cey * cey + cez * cez;
+    double dlift = dex * dex + dey * dey + dez * dez;
+    double det = (dlift * abc - clift * dab) + (blift * cda - alift * bcd);
+
+    double aezplus = fabs(aez), bezplus = fabs(bez), cezplus = fabs(cez), dezplus = fabs(dez);
+    double aexbeyplus = fabs(aexbey), bexaeyplus = fabs(bexaey);
+    double bexceyplus = fabs(bexcey), cexbeyplus = fabs(cexbey);
+    double cexdeyplus = fabs(cexdey), dexceyplus = fabs(dexcey);
+    double dexaeyplus = fabs(dexaey), aexdeyplus = fabs(aexdey);
+    double aexceyplus = fabs(aexcey), cexaeyplus = fabs(cexaey);
+    double bexdeyplus = fabs(bexdey), dexbeyplus = fabs(dexbey);
+    double permanent = ((cexdeyplus + dexceyplus) * bezplus + (dexbeyplus + bexdeyplus) * cezplus
+                        + (bexceyplus + cexbeyplus) * dezplus) * alift
+                     + ((dexaeyplus + aexdeyplus) * cezplus + (aexceyplus + cexaeyplus) * dezplus
+                        + (cexdeyplus + dexceyplus) * aezplus) * blift
+                     + ((aexbeyplus + bexaeyplus) * dezplus + (bexdeyplus + dexbeyplus) * aezplus
+                        + (dexaeyplus + aexdeyplus) * bezplus) * clift
+                     + ((bexceyplus + cexbeyplus) * aezplus + (cexaeyplus + aexceyplus) * bezplus
+                        + (aexbeyplus + bexaeyplus) * cezplus) * dlift;
+    double errbound = GEOM_PRED_ISP_A * permanent;
+    if (det > errbound || -det > errbound)
+        return det;
+    return _pred_insphere_adapt(a, b, c, d, e, permanent);
+}
+
+// Batched predicates: the stage A filter runs SIMD-wide over the cloud with
+// the same operation order as the scalar predicate, and only lanes it cannot
+// certify go through the scalar path.
+typedef struct {
+    const double* x;
+    const double* y;
+    const double* z;
+    fossil_math_geom_point3d p[4];
+    double* out;
+} pred_job;
+
+static simd_vd _pred_load(const double* v, size_t len) {
+    return (len == SIMD_LANES) ? simd_load(v) : simd_load_partial(v, len, 0.0);
+}
+
+// Stores det for lanes [i, i + len) and returns the bits of the lanes whose
+// sign errbound does not certify. Strict selects the > test of the 3D and
+// in-circle filters over the >= test of orient2d.
+static int _pred_emit(const pred_job* job, size_t i, size_t len, simd_vd det, simd_vd errbound, int strict) {
+    simd_vd neg = simd_sub(simd_set1(0.0), det);
+    simd_vd ok = strict ? simd_or(simd_gt(det, errbound), simd_gt(neg, errbound))
+                        : simd_or(simd_ge(det, errbound), simd_ge(neg, errbound));
+    if (len == SIMD_LANES)
+        simd_store(job->out + i, det);
+    else
+        simd_store_partial(job->out + i, len, det);
+    return ~simd_mask_bits(ok) & (int)(((unsigned)1 << len) - 1);
+}
+
+static void _pred_orient2d_range(void* ctx, size_t begin, size_t end) {
+    const pred_job* job = (const pred_job*)ctx;
+    fossil_math_geom_point2d a = {job->p[0].x, job->p[0].y}, b = {job->p[1].x, job->p[1].y};
+    simd_vd ax = simd_set1(a.x), ay = simd_set1(a.y), bx = simd_set1(b.x), by = simd_set1(b.y);
+    for (size_t i = begin; i < end; i += SIMD_LANES) {
+        size_t len = (end - i < SIMD_LANES) ? end - i : SIMD_LANES;
+        simd_vd cx = _pred_load(job->x + i, len), cy = _pred_load(job->y + i, len);
+        simd_vd detleft = simd_mul(simd_sub(ax, cx), simd_sub(by, cy));
+        simd_vd detright = simd_mul(simd_sub(ay, cy), simd_sub(bx, cx));
+        simd_vd det = simd_sub(detleft, detright);
+        simd_vd detsum = simd_add(simd_abs(detleft), simd_abs(detright));
+        int redo = _pred_emit(job, i, len, det, simd_mul(simd_set1(GEOM_PRED_CCW_A), detsum), 0);
+        for (size_t l = 0; redo; l++, redo >>= 1)
+            if (redo & 1) {
+                fossil_math_geom_point2d c = {job->x[i + l], job->y[i + l]};
+                job->out[i + l] = fossil_math_geom_orient2d(a, b, c);
+            }
+    }
+}
+
+static void _pred_incircle_range(void* ctx, size_t begin, size_t end) {
+    const pred_job* job = (const pred_job*)ctx;
+    fossil_math_geom_point2d a = {job->p[0].x, job->p[0].y}, b = {job->p[1].x, job->p[1].y};
+    fossil_math_geom_point2d c = {job->p[2].x, job->p[2].y};
+    simd_vd ax = simd_set1(a.x), ay = simd_set1(a.y), bx = simd_set1(b.x), by = simd_set1(b.y);
+    simd_vd cx = simd_set1(c.x), cy = simd_set1(c.y);
+    for (size_t i = begin; i < end; i += SIMD_LANES) {
+        size_t len = (end - i < SIMD_LANES) ? end - i : SIMD_LANES;
+        simd_vd dx = _pred_load(job->x + i, len), dy = _pred_load(job->y + i, len);
+        simd_vd adx = simd_sub(ax, dx), bdx = simd_sub(bx, dx), cdx = simd_sub(cx, dx);
+        simd_vd ady = simd_sub(ay, dy), bdy = simd_sub(by, dy), cdy = simd_sub(cy, dy);
+        simd_vd bdxcdy = simd_mul(bdx, cdy), cdxbdy = simd_mul(cdx, bdy);
+        simd_vd alift = simd_add(simd_mul(adx, adx), simd_mul(ady, ady));
+        simd_vd cdxady = simd_mul(cdx, ady), adxcdy = simd_mul(adx, cdy);
+        simd_vd blift = simd_add(simd_mul(bdx, bdx), simd_mul(bdy, bdy));
+        simd_vd adxbdy = simd_mul(adx, bdy), bdxady = simd_mul(bdx, ady);
+        simd_vd clift = simd_add(simd_mul(cdx, cdx), simd_mul(cdy, cdy));
+        simd_vd det = simd_add(simd_add(simd_mul(alift, simd_sub(bdxcdy, cdxbdy)),
+                                        simd_mul(blift, simd_sub(cdxady, adxcdy))),
+                               simd_mul(clift, simd_sub(adxbdy, bdxady)));
+        simd_vd permanent = simd_add(simd_add(simd_mul(simd_add(simd_abs(bdxcdy), simd_abs(cdxbdy)), alift),
+                                              simd_mul(simd_add(simd_abs(cdxady), simd_abs(adxcdy)), blift)),
+                                     simd_mul(simd_add(simd_abs(adxbdy), simd_abs(bdxady)), clift));
+        int redo = _pred_emit(job, i, len, det, simd_mul(simd_set1(GEOM_PRED_ICC_A), permanent), 1);
+        for (size_t l = 0; redo; l++, redo >>= 1)
+            if (redo & 1) {
+                fossil_math_geom_point2d d = {job->x[i + l], job->y[i + l]};
+                job->out[i + l] = fossil_math_geom_incircle(a, b, c, d);
+            }
+    }
+}
+
+static void _pred_orient3d_range(void* ctx, size_t begin, size_t end) {
+    const pred_job* job = (const pred_job*)ctx;
+    fossil_math_geom_point3d a = job->p[0], b = job->p[1], c = job->p[2];
+    simd_vd ax = simd_set1(a.x), ay = simd_set1(a.y), az = simd_set1(a.z);
+    simd_vd bx = simd_set1(b.x), by = simd_set1(b.y), bz = simd_set1(b.z);
+    simd_vd cx = simd_set1(c.x), cy = simd_set1(c.y), cz = simd_set1(c.z);
+    for (size_t i = begin; i < end; i += SIMD_LANES) {
+        size_t len = (end - i < SIMD_LANES) ? end - i : SIMD_LANES;
+        simd_vd dx = _pred_load(job->x + i, len), dy = _pred_load(job->y + i, len), dz = _pred_load(job->z + i, len);
+        simd_vd adx = simd_sub(ax, dx), bdx = simd_sub(bx, dx), cdx = simd_sub(cx, dx);
+        simd_vd ady = simd_sub(ay, dy), bdy = simd_sub(by, dy), cdy = simd_sub(cy, dy);
+        simd_vd adz = simd_sub(az, dz), bdz = simd_sub(bz, dz), cdz = simd_sub(cz, dz);
+        simd_vd bdxcdy = simd_mul(bdx, cdy), cdxbdy = simd_mul(cdx, bdy);
+        simd_vd cdxady = simd_mul(cdx, ady), adxcdy = simd_mul(adx, cdy);
+        simd_vd adxbdy = simd_mul(adx, bdy), bdxady = simd_mul(bdx, ady);
+        simd_vd det = simd_add(simd_add(simd_mul(adz, simd_sub(bdxcdy, cdxbdy)), simd_mul(bdz, simd_sub(cdxady, adxcdy))),
+                               simd_mul(cdz, simd_sub(adxbdy, bdxady)));
+        simd_vd permanent = simd_add(simd_add(simd_mul(simd_add(simd_abs(bdxcdy), simd_abs(cdxbdy)), simd_abs(adz)),
+                                              simd_mul(simd_add(simd_abs(cdxady), simd_abs(adxcdy)), simd_abs(bdz))),
+                                     simd_mul(simd_add(simd_abs(adxbdy), simd_abs(bdxady)), simd_abs(cdz)));
+        int redo = _pred_emit(job, i, len, det, simd_mul(simd_set1(GEOM_PRED_O3D_A), permanent), 1);
+        for (size_t l = 0; redo; l++, redo >>= 1)
+            if (redo & 1) {
+                fossil_math_geom_point3d d = {job->x[i + l], job->y[i + l], job->z[i + l]};
+                job->out[i + l] = fossil_math_geom_orient3d(a, b, c, d);
+            }
+    }
+}
+
+static void _pred_insphere_range(void* ctx, size_t begin, size_t end) {
+    const pred_job* job = (const pred_job*)ctx;
+    fossil_math_geom_point3d a = job->p[0], b = job->p[1], c = job->p[2], d = job->p[3];
+    for (size_t i = begin; i < end; i += SIMD_LANES) {
+        size_t len = (end - i < SIMD_LANES) ? end - i : SIMD_LANES;
+        simd_vd ex = _pred_load(job->x + i, len), ey = _pred_load(job->y + i, len), ez = _pred_load(job->z + i, len);
+        simd_vd aex = simd_sub(simd_set1(a.x), ex), bex = simd_sub(simd_set1(b.x), ex);
+        simd_vd cex = simd_sub(simd_set1(c.x), ex), dex = simd_sub(simd_set1(d.x), ex);
+        simd_vd aey = simd_sub(simd_set1(a.y), ey), bey = simd_sub(simd_set1(b.y), ey);
+        simd_vd cey = simd_sub(simd_set1(c.y), ey), dey = simd_sub(simd_set1(d.y), ey);
+        simd_vd aez = simd_sub(simd_set1(a.z), ez), bez = simd_sub(simd_set1(b.z), ez);
+        simd_vd cez = simd_sub(simd_set1(c.z), ez), dez = simd_sub(simd_set1(d.z), ez);
+        simd_vd aexbey = simd_mul(aex, bey), bexaey = simd_mul(bex, aey), ab = simd_sub(aexbey, bexaey);
+        simd_vd bexcey = simd_mul(bex, cey), cexbey = simd_mul(cex, bey), bc = simd_sub(bexcey, cexbey);
+        simd_vd cexdey = simd_mul(cex, dey), dexcey = simd_mul(dex, cey), cd = simd_sub(cexdey, dexcey);
+        simd_vd dexaey = simd_mul(dex, aey), aexdey = simd_mul(aex, dey), da = simd_sub(dexaey, aexdey);
+        simd_vd aexcey = simd_mul(aex, cey), cexaey = simd_mul(cex, aey), ac = simd_sub(aexcey, cexaey);
+        simd_vd bexdey = simd_mul(bex, dey), dexbey = simd_mul(dex, bey), bd = simd_sub(bexdey, dexbey);
+        simd_vd abc = simd_add(simd_sub(simd_mul(aez, bc), simd_mul(bez, ac)), simd_mul(cez, ab));
+        simd_vd bcd = simd_add(simd_sub(simd_mul(bez, cd), simd_mul(cez, bd)), simd_mul(dez, bc));
+        simd_vd cda = simd_add(simd_add(simd_mul(cez, da), simd_mul(dez, ac)), simd_mul(aez, cd));
+        simd_vd dab = simd_add(simd_add(simd_mul(dez, ab), simd_mul(aez, bd)), simd_mul(bez, da));
+        simd_vd alift = simd_add(simd_add(simd_mul(aex, aex), simd_mul(aey, aey)), simd_mul(aez, aez));
+        simd_vd blift = simd_add(simd_add(simd_mul(bex, bex), simd_mul(bey, bey)), simd_mul(bez, bez));
+        simd_vd clift = simd_add(simd_add(simd_mul(cex, cex), simd_mul(cey, cey)), simd_mul(cez, cez));
+        simd_vd dlift = simd_add(simd_add(simd_mul(dex, dex), simd_mul(dey, dey)), simd_mul(dez, dez));
+        simd_vd det = simd_add(simd_sub(simd_mul(dlift, abc), simd_mul(clift, dab)),
+                               simd_sub(simd_mul(blift, cda), simd_mul(alift, bcd)));
+
+        simd_vd aezp = simd_abs(aez), bezp = simd_abs(bez), cezp = simd_abs(cez), dezp = simd_abs(dez);
+        simd_vd abp = simd_add(simd_abs(aexbey), simd_abs(bexaey));
+        simd_vd bcp = simd_add(simd_abs(bexcey), simd_abs(cexbey));
+        simd_vd cdp = simd_add(simd_abs(cexdey), simd_abs(dexcey));
+        simd_vd dap = simd_add(simd_abs(dexaey), simd_abs(aexdey));
+        simd_vd acp = simd_add(simd_abs(aexcey), simd_abs(cexaey));
+        simd_vd bdp = simd_add(simd_abs(bexdey), simd_abs(dexbey));
+        simd_vd pa = simd_mul(simd_add(simd_add(simd_mul(cdp, bezp), simd_mul(bdp, cezp)), simd_mul(bcp, dezp)), alift);
+        simd_vd pb = simd_mul(simd_add(simd_add(simd_mul(dap, cezp), simd_mul(acp, dezp)), simd_mul(cdp, aezp)), blift);
+        simd_vd pc = simd_mul(simd_add(simd_add(simd_mul(abp, dezp), simd_mul(bdp, aezp)), simd_mul(dap, bezp)), clift);
+        simd_vd pd = simd_mul(simd_add(simd_add(simd_mul(bcp, aezp), simd_mul(acp, bezp)), simd_mul(abp, cezp)), dlift);
+        simd_vd permanent = simd_add(simd_add(simd_add(pa, pb), pc), pd);
+        int redo = _pred_emit(job, i, len, det, simd_mul(simd_set1(GEOM_PRED_ISP_A), permanent), 1);
+        for (size_t l = 0; redo; l++, redo >>= 1)
+            if (redo & 1) {
+                fossil_math_geom_point3d e = {job->x[i + l], job->y[i + l], job->z[i + l]};
+                job->out[i + l] = fossil_math_geom_insphere(a, b, c, d, e);
+            }
+    }
+}
+
+void fossil_math_geom_cloud2d_orient2d(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d a,
+                                       fossil_math_geom_point2d b, double* out) {
+    pred_job job = {cloud->x, cloud->y, NULL, {{a.x, a.y, 0.0}, {b.x, b.y, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}}, out};
+    fossil_math_parallel_for(cloud->size, GEOM_CLOUD_GRAIN, _pred_orient2d_range, &job);
+}
+
+void fossil_math_geom_cloud2d_incircle(const fossil_math_geom_cloud2d* cloud, fossil_math_geom_point2d a,
+                                       fossil_math_geom_point2d b, fossil_math_geom_point2d c, double* out) {
+    pred_job job = {cloud->x, cloud->y, NULL, {{a.x, a.y, 0.0}, {b.x, b.y, 0.0}, {c.x, c.y, 0.0}, {0.0, 0.0, 0.0}}, out};
+    fossil_math_parallel_for(cloud->size, GEOM_CLOUD_GRAIN, _pred_incircle_range, &job);
+}
+
+void fossil_math_geom_cloud3d_orient3d(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d a,
+                                       fossil_math_geom_point3d b, fossil_math_geom_point3d c, double* out) {
+    pred_job job = {cloud->x, cloud->y, cloud->z, {a, b, c, {0.0, 0.0, 0.0}}, out};
+    fossil_math_parallel_for(cloud->size, GEOM_CLOUD_GRAIN, _pred_orient3d_range, &job);
+}
+
+void fossil_math_geom_cloud3d_insphere(const fossil_math_geom_cloud3d* cloud, fossil_math_geom_point3d a,
+                                       fossil_math_geom_point3d b, fossil_math_geom_point3d c,
+                                       fossil_math_geom_point3d d, double* out) {
+    pred_job job = {cloud->x, cloud->y, cloud->z, {a, b, c, d}, out};
+    fossil_math_parallel_for(cloud->size, GEOM_CLOUD_GRAIN, _pred_insphere_range, &job);
+}
@@ -23,5 +23,147 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/math/math.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+// Chunks are rounded to this many items so neighbouring threads do not
+// share cache lines of double outputs.
+#define MATH_CHUNK_ALIGN 64
+
+// Largest number of threads started by one parallel_for call.
+#define MATH_MAX_THREADS 64
+
+// ======================================================
+// Memory
+// ======================================================
+
+// The pointer returned by malloc is stashed just before the aligned block so
+// this works the same everywhere (C11 aligned_alloc is missing on MSVC).
+void* fossil_math_aligned_alloc(size_t size) {
+    if (size == 0 || size > SIZE_MAX - FOSSIL_MATH_ALIGNMENT - sizeof(void*))
+        return NULL;
+    unsigned char* raw = malloc(size + FOSSIL_MATH_ALIGNMENT + sizeof(void*));
+    if (!raw) return NULL;
+    uintptr_t addr = (uintptr_t)(raw + sizeof(void*));
+    addr = (addr + FOSSIL_MATH_ALIGNMENT - 1) & ~(uintptr_t)(FOSSIL_MATH_ALIGNMENT - 1);
+    void* aligned = (void*)addr;
+    ((void**)aligned)[-1] = raw;
+    return aligned;
+}
+
+void fossil_math_aligned_free(void* ptr) {
+    if (ptr) free(((void**)ptr)[-1]);
+}
+
+// ======================================================
+// Threads
+// ======================================================
+
+static size_t math_threads = 1;
+
+typedef struct {
+    fossil_math_range_fn fn;
+    void* ctx;
+    size_t begin;
+    size_t end;
+} math_chunk;
+
+#ifdef _WIN32
+static unsigned __stdcall _chunk_main(void* arg) {
+    math_chunk* c = arg;
+    c->fn(c->ctx, c->begin, c->end);
+    return 0;
+}
+#else
+static void* _chunk_main(void* arg) {
+    math_chunk* c = arg;
+    c->fn(c->ctx, c->begin, c->end);
+    return NULL;
+}
+#endif
+
+static size_t _online_processors(void) {
+#if defined(_WIN32)
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors ? (size_t)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? (size_t)n : 1;
+#else
+    return 1;
+#endif
+}
+
+int fossil_math_set_threads(size_t count) {
+    if (count == 0) count = _online_processors();
+    math_threads = (count > MATH_MAX_THREADS) ? MATH_MAX_THREADS : count;
+    return 0;
+}
+
+size_t fossil_math_get_threads(void) {
+    return math_threads;
+}
+
+void fossil_math_parallel_for(size_t n, size_t grain, fossil_math_range_fn fn, void* ctx) {
+    if (n == 0) return;
+    if (grain == 0) grain = 1;
+
+    size_t parts = n / grain;
+    if (parts > math_threads) parts = math_threads;
+    if (parts <= 1) {
+        fn(ctx, 0, n);
+        return;
+    }
+
+    size_t chunk = (n + parts - 1) / parts;
+    chunk = (chunk + MATH_CHUNK_ALIGN - 1) / MATH_CHUNK_ALIGN * MATH_CHUNK_ALIGN;
+
+    math_chunk chunks[MATH_MAX_THREADS];
+#ifdef _WIN32
+    HANDLE handles[MATH_MAX_THREADS];
+#else
+    pthread_t handles[MATH_MAX_THREADS];
+#endif
+    int started[MATH_MAX_THREADS] = {0};
+
+    size_t count = 0;
+    for (size_t begin = 0; begin < n; begin += chunk, count++) {
+        chunks[count].fn = fn;
+        chunks[count].ctx = ctx;
+        chunks[count].begin = begin;
+        chunks[count].end = (n - begin < chunk) ? n : begin + chunk;
+    }
+
+    for (size_t i = 1; i < count; i++) {
+#ifdef _WIN32
+        uintptr_t h = _beginthreadex(NULL, 0, _chunk_main, &chunks[i], 0, NULL);
+        handles[i] = (HANDLE)h;
+        started[i] = (h != 0);
+#else
+        started[i] = (pthread_create(&handles[i], NULL, _chunk_main, &chunks[i]) == 0);
+#endif
+        if (!started[i]) _chunk_main(&chunks[i]);
+    }
+
+    _chunk_main(&chunks[0]);
+
+    for (size_t i = 1; i < count; i++) {
+        if (!started[i]) continue;
+#ifdef _WIN32
+        WaitForSingleObject(handles[i], INFINITE);
+        CloseHandle(handles[i]);
+#else
+        pthread_join(handles[i], NULL);
+#endif
+    }
+}
 
 // TODO: Implement the draft hash algorithm when you wake up.
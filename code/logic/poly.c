@@ -0,0 +1,279 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/poly.h"
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// Coefficient arrays are padded to a multiple of this many zeros so the
+// Estrin blocks never read past the end.
+#define POLY_BLOCK 8
+
+// Degrees at or above this use blocked Estrin instead of Horner.
+#define POLY_ESTRIN_MIN_DEGREE 8
+
+// Number of lanes evaluated together by the array kernel.
+#define POLY_LANES 8
+
+struct fossil_math_poly {
+    size_t degree;
+    fossil_math_poly_scheme scheme;
+    // derivs[0] holds the coefficients, derivs[k] the k-th derivative and
+    // derivs[degree + 1] the zero polynomial; entries are built on demand.
+    double** derivs;
+};
+
+static size_t _padded_length(size_t degree) {
+    return (degree + POLY_BLOCK) / POLY_BLOCK * POLY_BLOCK;
+}
+
+static double* _alloc_coeffs(size_t degree) {
+    size_t len = _padded_length(degree);
+    double* c = fossil_math_aligned_alloc(len * sizeof(double));
+    if (c) memset(c, 0, len * sizeof(double));
+    return c;
+}
+
+static size_t _derivative_degree(size_t degree, size_t order) {
+    return (order >= degree) ? 0 : degree - order;
+}
+
+// ======================================================
+// Evaluation schemes
+// ======================================================
+
+static double _horner(const double* c, size_t degree, double x) {
+    double acc = c[degree];
+    for (size_t i = degree; i-- > 0;)
+        acc = acc * x + c[i];
+    return acc;
+}
+
+static double _estrin_block(const double* c, double x, double x2, double x4) {
+    double p01 = c[0] + c[1] * x;
+    double p23 = c[2] + c[3] * x;
+    double p45 = c[4] + c[5] * x;
+    double p67 = c[6] + c[7] * x;
+    return (p01 + p23 * x2) + (p45 + p67 * x2) * x4;
+}
+
+// Blocks of eight coefficients are evaluated with Estrin and chained with
+// Horner in x^8, which keeps the dependency chain short for high degrees.
+static double _estrin(const double* c, size_t degree, double x) {
+    size_t blocks = _padded_length(degree) / POLY_BLOCK;
+    double x2 = x * x;
+    double x4 = x2 * x2;
+    double x8 = x4 * x4;
+    double acc = _estrin_block(c + (blocks - 1) * POLY_BLOCK, x, x2, x4);
+    for (size_t b = blocks - 1; b-- > 0;)
+        acc = acc * x8 + _estrin_block(c + b * POLY_BLOCK, x, x2, x4);
+    return acc;
+}
+
+// ======================================================
+// Lifetime
+// ======================================================
+
+fossil_math_poly* fossil_math_poly_create(const double* coeffs, size_t degree) {
+    if (!coeffs || degree >= SIZE_MAX / sizeof(double*) - 2) return NULL;
+
+    fossil_math_poly* poly = malloc(sizeof(*poly));
+    if (!poly) return NULL;
+
+    poly->degree = degree;
+    poly->scheme = (degree >= POLY_ESTRIN_MIN_DEGREE) ? FOSSIL_MATH_POLY_ESTRIN
+                                                      : FOSSIL_MATH_POLY_HORNER;
+    poly->derivs = calloc(degree + 2, sizeof(double*));
+    if (!poly->derivs) {
+        free(poly);
+        return NULL;
+    }
+
+    poly->derivs[0] = _alloc_coeffs(degree);
+    poly->derivs[degree + 1] = _alloc_coeffs(0);
+    if (!poly->derivs[0] || !poly->derivs[degree + 1]) {
+        fossil_math_poly_destroy(poly);
+        return NULL;
+    }
+    memcpy(poly->derivs[0], coeffs, (degree + 1) * sizeof(double));
+    return poly;
+}
+
+void fossil_math_poly_destroy(fossil_math_poly* poly) {
+    if (!poly) return;
+    if (poly->derivs) {
+        for (size_t i = 0; i <= poly->degree + 1; i++)
+            fossil_math_aligned_free(poly->derivs[i]);
+        free(poly->derivs);
+    }
+    free(poly);
+}
+
+size_t fossil_math_poly_degree(const fossil_math_poly* poly) {
+    return poly ? poly->degree : 0;
+}
+
+fossil_math_poly_scheme fossil_math_poly_get_scheme(const fossil_math_poly* poly) {
+    return poly ? poly->scheme : FOSSIL_MATH_POLY_HORNER;
+}
+
+const double* fossil_math_poly_coeffs(const fossil_math_poly* poly) {
+    return poly ? poly->derivs[0] : NULL;
+}
+
+// ======================================================
+// Derivative chain
+// ======================================================
+
+int fossil_math_poly_prepare(fossil_math_poly* poly, size_t order) {
+    if (!poly) return -1;
+    if (order > poly->degree) order = poly->degree;
+
+    for (size_t k = 1; k <= order; k++) {
+        if (poly->derivs[k]) continue;
+        size_t deg = poly->degree - k;
+        double* d = _alloc_coeffs(deg);
+        if (!d) return -2;
+        const double* prev = poly->derivs[k - 1];
+        for (size_t i = 0; i <= deg; i++)
+            d[i] = prev[i + 1] * (double)(i + 1);
+        poly->derivs[k] = d;
+    }
+    return 0;
+}
+
+const double* fossil_math_poly_derivative(fossil_math_poly* poly, size_t order, size_t* degree) {
+    if (!poly) return NULL;
+    if (order > poly->degree) {
+        if (degree) *degree = 0;
+        return poly->derivs[poly->degree + 1];
+    }
+    if (fossil_math_poly_prepare(poly, order) != 0) return NULL;
+    if (degree) *degree = _derivative_degree(poly->degree, order);
+    return poly->derivs[order];
+}
+
+// ======================================================
+// Evaluation
+// ======================================================
+
+double fossil_math_poly_eval(const fossil_math_poly* poly, double x) {
+    if (poly->scheme == FOSSIL_MATH_POLY_ESTRIN)
+        return _estrin(poly->derivs[0], poly->degree, x);
+    return _horner(poly->derivs[0], poly->degree, x);
+}
+
+double fossil_math_poly_eval_derivative(fossil_math_poly* poly, size_t order, double x) {
+    size_t deg = 0;
+    const double* d = fossil_math_poly_derivative(poly, order, &deg);
+    if (!d) return NAN;
+    if (deg >= POLY_ESTRIN_MIN_DEGREE)
+        return _estrin(d, deg, x);
+    return _horner(d, deg, x);
+}
+
+// Horner carried through k+1 accumulators at once: acc[j] picks up the
+// j-th derivative divided by j!, which is rescaled at the end.
+int fossil_math_poly_eval_derivs(const fossil_math_poly* poly, double x, size_t k, double* out) {
+    if (!poly || !out) return -1;
+
+    const double* c = poly->derivs[0];
+    size_t n = poly->degree;
+    size_t kk = (k < n) ? k : n;
+
+    out[0] = c[n];
+    for (size_t j = 1; j <= k; j++)
+        out[j] = 0.0;
+
+    for (size_t i = n; i-- > 0;) {
+        size_t top = (kk < n - i) ? kk : n - i;
+        for (size_t j = top; j >= 1; j--)
+            out[j] = out[j] * x + out[j - 1];
+        out[0] = out[0] * x + c[i];
+    }
+
+    double fact = 1.0;
+    for (size_t j = 2; j <= kk; j++) {
+        fact *= (double)j;
+        out[j] *= fact;
+    }
+    return 0;
+}
+
+void fossil_math_poly_eval_array(const fossil_math_poly* poly, const double* x, double* out, size_t n) {
+    const double* c = poly->derivs[0];
+    size_t deg = poly->degree;
+    size_t i = 0;
+
+    // Lanes are interleaved inside the coefficient loop so the compiler can
+    // keep them in vector registers.
+    for (; i + POLY_LANES <= n; i += POLY_LANES) {
+        double xv[POLY_LANES];
+        double acc[POLY_LANES];
+        for (size_t l = 0; l < POLY_LANES; l++) {
+            xv[l] = x[i + l];
+            acc[l] = c[deg];
+        }
+        for (size_t j = deg; j-- > 0;) {
+            for (size_t l = 0; l < POLY_LANES; l++)
+                acc[l] = acc[l] * xv[l] + c[j];
+        }
+        for (size_t l = 0; l < POLY_LANES; l++)
+            out[i + l] = acc[l];
+    }
+    for (; i < n; i++)
+        out[i] = _horner(c, deg, x[i]);
+}
+
+// ======================================================
+// Root finding
+// ======================================================
+
+int fossil_math_poly_newton(const fossil_math_poly* poly, double x0, double tol,
+                            size_t max_iter, double* root) {
+    if (!poly || !root || !(tol >= 0.0)) return -1;
+
+    double x = x0;
+    double fd[2];
+    for (size_t it = 0; it < max_iter; it++) {
+        fossil_math_poly_eval_derivs(poly, x, 1, fd);
+        if (fd[0] == 0.0) {
+            *root = x;
+            return 0;
+        }
+        if (fd[1] == 0.0) {
+            *root = x;
+            return -2;
+        }
+        double step = fd[0] / fd[1];
+        x -= step;
+        if (fabs(step) <= tol) {
+            *root = x;
+            return 0;
+        }
+    }
+    *root = x;
+    return -3;
+}
@@ -0,0 +1,246 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#ifndef FOSSIL_MATH_SIMD_H
+#define FOSSIL_MATH_SIMD_H
+
+// Private helper for the library sources; not part of the public headers.
+//
+// Wraps the double-precision vector type of the target so kernels can be
+// written once. The backend is chosen at compile time: AVX2 (4 lanes) when
+// the compiler targets it, SSE2 (2 lanes) on x86-64, NEON (2 lanes) on
+// AArch64 and a one-lane scalar fallback everywhere else (or when
+// FOSSIL_MATH_NO_SIMD is defined). Masks are vectors
+// whose lanes are all-ones or all-zeros, as produced by the comparisons.
+// simd_min(a, b) and simd_max(a, b) return b in lanes where either input is
+// NaN (NEON returns the non-NaN input), so folding values v into a non-NaN
+// accumulator with simd_min(v, acc) skips NaN on every backend.
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(FOSSIL_MATH_NO_SIMD)
+#define SIMD_SCALAR 1
+#elif defined(__AVX2__)
+#define SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SIMD_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define SIMD_NEON 1
+#include <arm_neon.h>
+#else
+#define SIMD_SCALAR 1
+#endif
+
+static inline uint64_t simd_bits_of(double d) {
+    uint64_t u;
+    memcpy(&u, &d, sizeof(u));
+    return u;
+}
+
+static inline double simd_double_of(uint64_t u) {
+    double d;
+    memcpy(&d, &u, sizeof(d));
+    return d;
+}
+
+#if defined(SIMD_AVX2)
+
+#define SIMD_LANES 4
+typedef __m256d simd_vd;
+
+static inline simd_vd simd_set1(double x) { return _mm256_set1_pd(x); }
+static inline simd_vd simd_load(const double* p) { return _mm256_loadu_pd(p); }
+static inline void simd_store(double* p, simd_vd v) { _mm256_storeu_pd(p, v); }
+static inline simd_vd simd_add(simd_vd a, simd_vd b) { return _mm256_add_pd(a, b); }
+static inline simd_vd simd_sub(simd_vd a, simd_vd b) { return _mm256_sub_pd(a, b); }
+static inline simd_vd simd_mul(simd_vd a, simd_vd b) { return _mm256_mul_pd(a, b); }
+static inline simd_vd simd_div(simd_vd a, simd_vd b) { return _mm256_div_pd(a, b); }
+static inline simd_vd simd_sqrt(simd_vd a) { return _mm256_sqrt_pd(a); }
+static inline simd_vd simd_min(simd_vd a, simd_vd b) { return _mm256_min_pd(a, b); }
+static inline simd_vd simd_max(simd_vd a, simd_vd b) { return _mm256_max_pd(a, b); }
+static inline simd_vd simd_and(simd_vd a, simd_vd b) { return _mm256_and_pd(a, b); }
+static inline simd_vd simd_or(simd_vd a, simd_vd b) { return _mm256_or_pd(a, b); }
+static inline simd_vd simd_xor(simd_vd a, simd_vd b) { return _mm256_xor_pd(a, b); }
+static inline simd_vd simd_andnot(simd_vd a, simd_vd b) { return _mm256_andnot_pd(b, a); }
+static inline simd_vd simd_lt(simd_vd a, simd_vd b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+static inline simd_vd simd_le(simd_vd a, simd_vd b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+static inline simd_vd simd_eq(simd_vd a, simd_vd b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+static inline simd_vd simd_neq(simd_vd a, simd_vd b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); }
+static inline simd_vd simd_select(simd_vd m, simd_vd a, simd_vd b) { return _mm256_blendv_pd(b, a, m); }
+static inline int simd_mask_bits(simd_vd m) { return _mm256_movemask_pd(m); }
+static inline simd_vd simd_shl52(simd_vd a) { return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(a), 52)); }
+static inline simd_vd simd_shr52(simd_vd a) { return _mm256_castsi256_pd(_mm256_srli_epi64(_mm256_castpd_si256(a), 52)); }
+
+#elif defined(SIMD_SSE2)
+
+#define SIMD_LANES 2
+typedef __m128d simd_vd;
+
+static inline simd_vd simd_set1(double x) { return _mm_set1_pd(x); }
+static inline simd_vd simd_load(const double* p) { return _mm_loadu_pd(p); }
+static inline void simd_store(double* p, simd_vd v) { _mm_storeu_pd(p, v); }
+static inline simd_vd simd_add(simd_vd a, simd_vd b) { return _mm_add_pd(a, b); }
+static inline simd_vd simd_sub(simd_vd a, simd_vd b) { return _mm_sub_pd(a, b); }
+static inline simd_vd simd_mul(simd_vd a, simd_vd b) { return _mm_mul_pd(a, b); }
+static inline simd_vd simd_div(simd_vd a, simd_vd b) { return _mm_div_pd(a, b); }
+static inline simd_vd simd_sqrt(simd_vd a) { return _mm_sqrt_pd(a); }
+static inline simd_vd simd_min(simd_vd a, simd_vd b) { return _mm_min_pd(a, b); }
+static inline simd_vd simd_max(simd_vd a, simd_vd b) { return _mm_max_pd(a, b); }
+static inline simd_vd simd_and(simd_vd a, simd_vd b) { return _mm_and_pd(a, b); }
+static inline simd_vd simd_or(simd_vd a, simd_vd b) { return _mm_or_pd(a, b); }
+static inline simd_vd simd_xor(simd_vd a, simd_vd b) { return _mm_xor_pd(a, b); }
+static inline simd_vd simd_andnot(simd_vd a, simd_vd b) { return _mm_andnot_pd(b, a); }
+static inline simd_vd simd_lt(simd_vd a, simd_vd b) { return _mm_cmplt_pd(a, b); }
+static inline simd_vd simd_le(simd_vd a, simd_vd b) { return _mm_cmple_pd(a, b); }
+static inline simd_vd simd_eq(simd_vd a, simd_vd b) { return _mm_cmpeq_pd(a, b); }
+static inline simd_vd simd_neq(simd_vd a, simd_vd b) { return _mm_cmpneq_pd(a, b); }
+static inline simd_vd simd_select(simd_vd m, simd_vd a, simd_vd b) {
+    return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b));
+}
+static inline int simd_mask_bits(simd_vd m) { return _mm_movemask_pd(m); }
+static inline simd_vd simd_shl52(simd_vd a) { return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(a), 52)); }
+static inline simd_vd simd_shr52(simd_vd a) { return _mm_castsi128_pd(_mm_srli_epi64(_mm_castpd_si128(a), 52)); }
+
+#elif defined(SIMD_NEON)
+
+#define SIMD_LANES 2
+typedef float64x2_t simd_vd;
+
+static inline uint64x2_t simd_u(simd_vd a) { return vreinterpretq_u64_f64(a); }
+static inline simd_vd simd_f(uint64x2_t a) { return vreinterpretq_f64_u64(a); }
+
+static inline simd_vd simd_set1(double x) { return vdupq_n_f64(x); }
+static inline simd_vd simd_load(const double* p) { return vld1q_f64(p); }
+static inline void simd_store(double* p, simd_vd v) { vst1q_f64(p, v); }
+static inline simd_vd simd_add(simd_vd a, simd_vd b) { return vaddq_f64(a, b); }
+static inline simd_vd simd_sub(simd_vd a, simd_vd b) { return vsubq_f64(a, b); }
+static inline simd_vd simd_mul(simd_vd a, simd_vd b) { return vmulq_f64(a, b); }
+static inline simd_vd simd_div(simd_vd a, simd_vd b) { return vdivq_f64(a, b); }
+static inline simd_vd simd_sqrt(simd_vd a) { return vsqrtq_f64(a); }
+static inline simd_vd simd_min(simd_vd a, simd_vd b) { return vminnmq_f64(a, b); }
+static inline simd_vd simd_max(simd_vd a, simd_vd b) { return vmaxnmq_f64(a, b); }
+static inline simd_vd simd_and(simd_vd a, simd_vd b) { return simd_f(vandq_u64(simd_u(a), simd_u(b))); }
+static inline simd_vd simd_or(simd_vd a, simd_vd b) { return simd_f(vorrq_u64(simd_u(a), simd_u(b))); }
+static inline simd_vd simd_xor(simd_vd a, simd_vd b) { return simd_f(veorq_u64(simd_u(a), simd_u(b))); }
+static inline simd_vd simd_andnot(simd_vd a, simd_vd b) { return simd_f(vbicq_u64(simd_u(a), simd_u(b))); }
+static inline simd_vd simd_lt(simd_vd a, simd_vd b) { return simd_f(vcltq_f64(a, b)); }
+static inline simd_vd simd_le(simd_vd a, simd_vd b) { return simd_f(vcleq_f64(a, b)); }
+static inline simd_vd simd_eq(simd_vd a, simd_vd b) { return simd_f(vceqq_f64(a, b)); }
+static inline simd_vd simd_neq(simd_vd a, simd_vd b) {
+    return simd_f(veorq_u64(vceqq_f64(a, b), vdupq_n_u64(~(uint64_t)0)));
+}
+static inline simd_vd simd_select(simd_vd m, simd_vd a, simd_vd b) { return vbslq_f64(simd_u(m), a, b); }
+static inline int simd_mask_bits(simd_vd m) {
+    return (int)((vgetq_lane_u64(simd_u(m), 0) >> 63) | ((vgetq_lane_u64(simd_u(m), 1) >> 63) << 1));
+}
+static inline simd_vd simd_shl52(simd_vd a) { return simd_f(vshlq_n_u64(simd_u(a), 52)); }
+static inline simd_vd simd_shr52(simd_vd a) { return simd_f(vshrq_n_u64(simd_u(a), 52)); }
+
+#else /* SIMD_SCALAR */
+
+#define SIMD_LANES 1
+typedef double simd_vd;
+
+static inline simd_vd simd_mask_of(int c) { return simd_double_of(c ? ~(uint64_t)0 : 0); }
+
+static inline simd_vd simd_set1(double x) { return x; }
+static inline simd_vd simd_load(const double* p) { return *p; }
+static inline void simd_store(double* p, simd_vd v) { *p = v; }
+static inline simd_vd simd_add(simd_vd a, simd_vd b) { return a + b; }
+static inline simd_vd simd_sub(simd_vd a, simd_vd b) { return a - b; }
+static inline simd_vd simd_mul(simd_vd a, simd_vd b) { return a * b; }
+static inline simd_vd simd_div(simd_vd a, simd_vd b) { return a / b; }
+static inline simd_vd simd_sqrt(simd_vd a) { return sqrt(a); }
+static inline simd_vd simd_min(simd_vd a, simd_vd b) { return (a < b) ? a : b; }
+static inline simd_vd simd_max(simd_vd a, simd_vd b) { return (a > b) ? a : b; }
+static inline simd_vd simd_and(simd_vd a, simd_vd b) { return simd_double_of(simd_bits_of(a) & simd_bits_of(b)); }
+static inline simd_vd simd_or(simd_vd a, simd_vd b) { return simd_double_of(simd_bits_of(a) | simd_bits_of(b)); }
+static inline simd_vd simd_xor(simd_vd a, simd_vd b) { return simd_double_of(simd_bits_of(a) ^ simd_bits_of(b)); }
+static inline simd_vd simd_andnot(simd_vd a, simd_vd b) { return simd_double_of(simd_bits_of(a) & ~simd_bits_of(b)); }
+static inline simd_vd simd_lt(simd_vd a, simd_vd b) { return simd_mask_of(a < b); }
+static inline simd_vd simd_le(simd_vd a, simd_vd b) { return simd_mask_of(a <= b); }
+static inline simd_vd simd_eq(simd_vd a, simd_vd b) { return simd_mask_of(a == b); }
+static inline simd_vd simd_neq(simd_vd a, simd_vd b) { return simd_mask_of(!(a == b)); }
+static inline simd_vd simd_select(simd_vd m, simd_vd a, simd_vd b) { return simd_bits_of(m) ? a : b; }
+static inline int simd_mask_bits(simd_vd m) { return simd_bits_of(m) != 0; }
+static inline simd_vd simd_shl52(simd_vd a) { return simd_double_of(simd_bits_of(a) << 52); }
+static inline simd_vd simd_shr52(simd_vd a) { return simd_double_of(simd_bits_of(a) >> 52); }
+
+#endif
+
+// ======================================================
+// Backend-independent helpers
+// ======================================================
+
+#define SIMD_ALL_LANES ((1 << SIMD_LANES) - 1)
+
+static inline simd_vd simd_const_bits(uint64_t bits) { return simd_set1(simd_double_of(bits)); }
+static inline simd_vd simd_sign_mask(void) { return simd_set1(-0.0); }
+static inline simd_vd simd_abs(simd_vd a) { return simd_andnot(a, simd_sign_mask()); }
+static inline simd_vd simd_sign(simd_vd a) { return simd_and(a, simd_sign_mask()); }
+static inline simd_vd simd_ge(simd_vd a, simd_vd b) { return simd_le(b, a); }
+static inline simd_vd simd_gt(simd_vd a, simd_vd b) { return simd_lt(b, a); }
+static inline int simd_any(simd_vd m) { return simd_mask_bits(m) != 0; }
+static inline int simd_all(simd_vd m) { return simd_mask_bits(m) == SIMD_ALL_LANES; }
+
+// Rounds to the nearest integer (ties to even) for |a| < 2^51.
+static inline simd_vd simd_round(simd_vd a) {
+    simd_vd magic = simd_set1(6755399441055744.0); // 0x1.8p52
+    return simd_sub(simd_add(a, magic), magic);
+}
+
+// 2^k for integral k in [-1022, 1023]; the biased exponent lands in the
+// low bits of the magic sum and is shifted into place.
+static inline simd_vd simd_pow2i(simd_vd k) {
+    simd_vd magic = simd_set1(4503599627371519.0); // 2^52 + 1023
+    return simd_shl52(simd_add(k, magic));
+}
+
+// Biased exponent field of a (0 to 2047 for non-negative a) as a double.
+static inline simd_vd simd_exponent(simd_vd a) {
+    simd_vd two52 = simd_set1(4503599627370496.0);
+    return simd_sub(simd_or(simd_shr52(a), two52), two52);
+}
+
+// Loads up to SIMD_LANES values, padding the missing lanes with fill.
+static inline simd_vd simd_load_partial(const double* p, size_t n, double fill) {
+    double buf[SIMD_LANES];
+    for (size_t i = 0; i < SIMD_LANES; i++)
+        buf[i] = (i < n) ? p[i] : fill;
+    return simd_load(buf);
+}
+
+// Stores the first n lanes of v.
+static inline void simd_store_partial(double* p, size_t n, simd_vd v) {
+    double buf[SIMD_LANES];
+    simd_store(buf, v);
+    for (size_t i = 0; i < n; i++)
+        p[i] = buf[i];
+}
+
+#endif /* FOSSIL_MATH_SIMD_H */
@@ -0,0 +1,2351 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/spatial.h"
+#include "simd.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+// ======================================================
+// k-d tree
+// ======================================================
+
+// Largest number of points in a leaf. Leaf coordinates are contiguous, so a
+// leaf costs a few SIMD loads per axis.
+#define KD_LEAF 16
+
+// Builds of at least this many points hand their subtrees to threads.
+#define KD_PARALLEL_MIN ((size_t)1 << 16)
+
+// Most subtrees handed out by a parallel build (two per thread at most).
+#define KD_MAX_TASKS 128
+
+// Index slots per subtree in the parallel build; fossil_math_parallel_for()
+// splits a range of items, so each subtree owns one slot of this many.
+#define KD_TASK_SPAN 64
+
+// Queries per thread chunk in the batch APIs.
+#define KD_BATCH_GRAIN 64
+
+// The nodes form an implicit heap: node i covers [lo, hi) of the tree-ordered
+// points, splits at mid = lo + (hi - lo) / 2 and has children 2i + 1 over
+// [lo, mid) and 2i + 2 over [mid, hi). Ranges of at most KD_LEAF points are
+// leaves, so only the split axis and value are stored per node.
+struct fossil_math_spatial_kdtree {
+    size_t n;
+    size_t dims;
+    size_t nodes;
+    double* c[3];         // coordinates in tree order
+    size_t* index;        // input index of each point in tree order
+    double* split;        // split value per node
+    unsigned char* axis;  // split axis per node
+};
+
+static double _kd_median3(double a, double b, double c) {
+    if (a < b) {
+        if (b < c) return b;
+        return (a < c) ? c : a;
+    }
+    if (a < c) return a;
+    return (b < c) ? c : b;
+}
+
+// Reorders idx[lo, hi) so idx[k] has the k-th smallest key, with nothing
+// larger before it and nothing smaller after it. Three-way partitioning keeps
+// runs of equal keys from degrading to quadratic time.
+static void _kd_select(size_t* idx, const double* key, size_t lo, size_t hi, size_t k) {
+    while (hi - lo > 1) {
+        double pivot = _kd_median3(key[idx[lo]], key[idx[lo + (hi - lo) / 2]], key[idx[hi - 1]]);
+        size_t lt = lo, i = lo, gt = hi;
+        while (i < gt) {
+            double v = key[idx[i]];
+            size_t tmp = idx[i];
+            if (v < pivot) {
+                idx[i++] = idx[lt];
+                idx[lt++] = tmp;
+            } else if (v > pivot) {
+                idx[i] = idx[--gt];
+                idx[gt] = tmp;
+            } else {
+                i++;
+            }
+        }
+        if (k < lt)
+            hi = lt;
+        else if (k >= gt)
+            lo = gt;
+        else
+            return;
+    }
+}
+
+typedef struct {
+    fossil_math_spatial_kdtree* tree;
+    const double* src[3];  // input coordinates, indexed by input index
+} kd_build;
+
+// Splits one node at the median of its widest axis.
+static void _kd_split(const kd_build* b, size_t node, size_t lo, size_t hi) {
+    fossil_math_spatial_kdtree* t = b->tree;
+    size_t axis = 0;
+    double widest = -1.0;
+    for (size_t d = 0; d < t->dims; d++) {
+        const double* s = b->src[d];
+        double mn = s[t->index[lo]], mx = mn;
+        for (size_t i = lo + 1; i < hi; i++) {
+            double v = s[t->index[i]];
+            mn = (v < mn) ? v : mn;
+            mx = (v > mx) ? v : mx;
+        }
+        if (mx - mn > widest) {
+            widest = mx - mn;
+            axis = d;
+        }
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    _kd_select(t->index, b->src[axis], lo, hi, mid);
+    t->split[node] = b->src[axis][t->index[mid]];
+    t->axis[node] = (unsigned char)axis;
+}
+
+static void _kd_build_node(const kd_build* b, size_t node, size_t lo, size_t hi) {
+    while (hi - lo > KD_LEAF) {
+        size_t mid = lo + (hi - lo) / 2;
+        _kd_split(b, node, lo, hi);
+        _kd_build_node(b, 2 * node + 1, lo, mid);
+        node = 2 * node + 2;
+        lo = mid;
+    }
+}
+
+typedef struct {
+    const kd_build* build;
+    size_t count;
+    size_t node[KD_MAX_TASKS];
+    size_t lo[KD_MAX_TASKS];
+    size_t hi[KD_MAX_TASKS];
+} kd_tasks;
+
+// Subtree j owns slot j * KD_TASK_SPAN, so it is built by exactly one chunk.
+static void _kd_task_range(void* ctx, size_t begin, size_t end) {
+    const kd_tasks* tasks = (const kd_tasks*)ctx;
+    for (size_t j = (begin + KD_TASK_SPAN - 1) / KD_TASK_SPAN; j < tasks->count && j * KD_TASK_SPAN < end; j++)
+        _kd_build_node(tasks->build, tasks->node[j], tasks->lo[j], tasks->hi[j]);
+}
+
+// Splits the top levels on the calling thread until there are two subtrees
+// per thread, then builds the subtrees in parallel.
+static void _kd_build_parallel(const kd_build* b, size_t threads) {
+    kd_tasks tasks;
+    size_t want = 2 * threads;
+    if (want > KD_MAX_TASKS)
+        want = KD_MAX_TASKS;
+    tasks.build = b;
+    tasks.count = 1;
+    tasks.node[0] = 0;
+    tasks.lo[0] = 0;
+    tasks.hi[0] = b->tree->n;
+    while (tasks.count < want && 2 * tasks.count <= KD_MAX_TASKS) {
+        size_t count = tasks.count;
+        int split = 0;
+        for (size_t j = 0; j < count; j++) {
+            size_t node = tasks.node[j], lo = tasks.lo[j], hi = tasks.hi[j];
+            if (hi - lo <= KD_LEAF)
+                continue;
+            size_t mid = lo + (hi - lo) / 2;
+            _kd_split(b, node, lo, hi);
+            tasks.node[j] = 2 * node + 1;
+            tasks.hi[j] = mid;
+            tasks.node[tasks.count] = 2 * node + 2;
+            tasks.lo[tasks.count] = mid;
+            tasks.hi[tasks.count] = hi;
+            tasks.count++;
+            split = 1;
+        }
+        if (!split)
+            break;
+    }
+    fossil_math_parallel_for(tasks.count * KD_TASK_SPAN, KD_TASK_SPAN, _kd_task_range, &tasks);
+}
+
+void fossil_math_spatial_kdtree_destroy(fossil_math_spatial_kdtree* tree) {
+    if (!tree)
+        return;
+    fossil_math_aligned_free(tree->c[0]);
+    free(tree->index);
+    free(tree->split);
+    free(tree->axis);
+    free(tree);
+}
+
+// Takes ownership of src (dims arrays of n doubles in one malloc block).
+static fossil_math_spatial_kdtree* _kd_create(double* src, size_t n, size_t dims) {
+    fossil_math_spatial_kdtree* t = (fossil_math_spatial_kdtree*)calloc(1, sizeof(*t));
+    if (!t) {
+        free(src);
+        return NULL;
+    }
+    t->n = n;
+    t->dims = dims;
+    size_t depth = 0;
+    for (size_t s = n; s > KD_LEAF; s = s - s / 2)
+        depth++;
+    t->nodes = ((size_t)1 << depth) - 1;
+
+    size_t stride = (n + 7) & ~(size_t)7;
+    t->c[0] = (double*)fossil_math_aligned_alloc((stride ? stride : 8) * dims * sizeof(double));
+    t->index = (size_t*)malloc((n ? n : 1) * sizeof(size_t));
+    t->split = (double*)malloc((t->nodes ? t->nodes : 1) * sizeof(double));
+    t->axis = (unsigned char*)malloc(t->nodes ? t->nodes : 1);
+    if (!t->c[0] || !t->index || !t->split || !t->axis) {
+        free(src);
+        fossil_math_spatial_kdtree_destroy(t);
+        return NULL;
+    }
+    for (size_t d = 1; d < dims; d++)
+        t->c[d] = t->c[0] + d * stride;
+    for (size_t i = 0; i < n; i++)
+        t->index[i] = i;
+
+    kd_build b = {t, {src, src + n, dims > 2 ? src + 2 * n : NULL}};
+    size_t threads = fossil_math_get_threads();
+    if (threads > 1 && n >= KD_PARALLEL_MIN)
+        _kd_build_parallel(&b, threads);
+    else
+        _kd_build_node(&b, 0, 0, n);
+
+    for (size_t d = 0; d < dims; d++)
+        for (size_t i = 0; i < n; i++)
+            t->c[d][i] = b.src[d][t->index[i]];
+    free(src);
+    return t;
+}
+
+fossil_math_spatial_kdtree* fossil_math_spatial_kdtree_create2d(const fossil_math_geom_point2d* points, size_t n) {
+    if ((!points && n) || n > SIZE_MAX / (2 * sizeof(double)))
+        return NULL;
+    double* src = (double*)malloc((n ? n : 1) * 2 * sizeof(double));
+    if (!src)
+        return NULL;
+    for (size_t i = 0; i < n; i++) {
+        src[i] = points[i].x;
+        src[n + i] = points[i].y;
+    }
+    return _kd_create(src, n, 2);
+}
+
+fossil_math_spatial_kdtree* fossil_math_spatial_kdtree_create3d(const fossil_math_geom_point3d* points, size_t n) {
+    if ((!points && n) || n > SIZE_MAX / (3 * sizeof(double)))
+        return NULL;
+    double* src = (double*)malloc((n ? n : 1) * 3 * sizeof(double));
+    if (!src)
+        return NULL;
+    for (size_t i = 0; i < n; i++) {
+        src[i] = points[i].x;
+        src[n + i] = points[i].y;
+        src[2 * n + i] = points[i].z;
+    }
+    return _kd_create(src, n, 3);
+}
+
+size_t fossil_math_spatial_kdtree_size(const fossil_math_spatial_kdtree* tree) {
+    return tree->n;
+}
+
+size_t fossil_math_spatial_kdtree_dims(const fossil_math_spatial_kdtree* tree) {
+    return tree->dims;
+}
+
+// ======================================================
+// k-d tree queries
+// ======================================================
+
+// Squared distances from q to the SoA points [lo, hi) of c, summed in axis
+// order like a scalar dx*dx + dy*dy + dz*dz.
+static void _spatial_dist_sq(double* const* c, size_t dims, const double* q, size_t lo, size_t hi, double* d2) {
+    for (size_t i = lo; i < hi; i += SIMD_LANES) {
+        size_t len = (hi - i < SIMD_LANES) ? hi - i : SIMD_LANES;
+        simd_vd acc = simd_set1(0.0);
+        for (size_t d = 0; d < dims; d++) {
+            simd_vd v = (len == SIMD_LANES) ? simd_load(c[d] + i) : simd_load_partial(c[d] + i, len, 0.0);
+            simd_vd u = simd_sub(v, simd_set1(q[d]));
+            acc = simd_add(acc, simd_mul(u, u));
+        }
+        if (len == SIMD_LANES)
+            simd_store(d2 + (i - lo), acc);
+        else
+            simd_store_partial(d2 + (i - lo), len, acc);
+    }
+}
+
+// k-NN state: a max-heap of the best (distance, index) pairs found so far,
+// stored in the caller's output arrays.
+typedef struct {
+    const fossil_math_spatial_kdtree* tree;
+    double q[3];
+    size_t k;
+    size_t count;
+    size_t* idx;
+    double* d2;
+} kd_knn;
+
+static int _kd_after(double da, size_t ia, double db, size_t ib) {
+    return da > db || (da == db && ia > ib);
+}
+
+static void _kd_sift_down(double* d2, size_t* idx, size_t i, size_t n) {
+    for (;;) {
+        size_t l = 2 * i + 1, r = l + 1, top = i;
+        if (l < n && _kd_after(d2[l], idx[l], d2[top], idx[top])) top = l;
+        if (r < n && _kd_after(d2[r], idx[r], d2[top], idx[top])) top = r;
+        if (top == i)
+            return;
+        double td = d2[i];
+        size_t ti = idx[i];
+        d2[i] = d2[top];
+        idx[i] = idx[top];
+        d2[top] = td;
+        idx[top] = ti;
+        i = top;
+    }
+}
+
+static void _kd_offer(kd_knn* s, double d2, size_t index) {
+    if (d2 != d2)
+        return;
+    if (s->count < s->k) {
+        // Sift the new pair up from the end of the heap.
+        size_t i = s->count++;
+        while (i > 0) {
+            size_t p = (i - 1) / 2;
+            if (!_kd_after(d2, index, s->d2[p], s->idx[p]))
+                break;
+            s->d2[i] = s->d2[p];
+            s->idx[i] = s->idx[p];
+            i = p;
+        }
+        s->d2[i] = d2;
+        s->idx[i] = index;
+    } else if (_kd_after(s->d2[0], s->idx[0], d2, index)) {
+        s->d2[0] = d2;
+        s->idx[0] = index;
+        _kd_sift_down(s->d2, s->idx, 0, s->count);
+    }
+}
+
+static void _kd_knn_node(kd_knn* s, size_t node, size_t lo, size_t hi) {
+    const fossil_math_spatial_kdtree* t = s->tree;
+    if (hi - lo <= KD_LEAF) {
+        double d2[KD_LEAF];
+        _spatial_dist_sq(t->c, t->dims, s->q, lo, hi, d2);
+        for (size_t i = lo; i < hi; i++)
+            _kd_offer(s, d2[i - lo], t->index[i]);
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    double diff = s->q[t->axis[node]] - t->split[node];
+    if (diff < 0.0) {
+        _kd_knn_node(s, 2 * node + 1, lo, mid);
+        if (s->count < s->k || diff * diff <= s->d2[0])
+            _kd_knn_node(s, 2 * node + 2, mid, hi);
+    } else {
+        _kd_knn_node(s, 2 * node + 2, mid, hi);
+        if (s->count < s->k || diff * diff <= s->d2[0])
+            _kd_knn_node(s, 2 * node + 1, lo, mid);
+    }
+}
+
+static size_t _kd_knn_query(const fossil_math_spatial_kdtree* t, const double* q, size_t dims,
+                            size_t k, size_t* idx, double* d2) {
+    kd_knn s = {t, {q[0], q[1], q[2]}, k, 0, idx, d2};
+    if (k > 0 && t->n > 0 && t->dims == dims)
+        _kd_knn_node(&s, 0, 0, t->n);
+    // Heap sort the survivors into ascending order.
+    for (size_t m = s.count; m > 1; m--) {
+        double td = d2[0];
+        size_t ti = idx[0];
+        d2[0] = d2[m - 1];
+        idx[0] = idx[m - 1];
+        d2[m - 1] = td;
+        idx[m - 1] = ti;
+        _kd_sift_down(d2, idx, 0, m - 1);
+    }
+    for (size_t i = s.count; i < k; i++) {
+        idx[i] = SIZE_MAX;
+        d2[i] = INFINITY;
+    }
+    return s.count;
+}
+
+typedef struct {
+    const fossil_math_spatial_kdtree* tree;
+    double q[3];
+    double r2;
+    size_t* out;
+    size_t max;
+    size_t found;
+} kd_radius;
+
+static void _kd_radius_node(kd_radius* s, size_t node, size_t lo, size_t hi) {
+    const fossil_math_spatial_kdtree* t = s->tree;
+    if (hi - lo <= KD_LEAF) {
+        double d2[KD_LEAF];
+        _spatial_dist_sq(t->c, t->dims, s->q, lo, hi, d2);
+        for (size_t i = lo; i < hi; i++) {
+            if (d2[i - lo] <= s->r2) {
+                if (s->found < s->max)
+                    s->out[s->found] = t->index[i];
+                s->found++;
+            }
+        }
+        return;
+    }
+    size_t mid = lo + (hi - lo) / 2;
+    double diff = s->q[t->axis[node]] - t->split[node];
+    int far_ok = diff * diff <= s->r2;
+    if (diff < 0.0 || far_ok)
+        _kd_radius_node(s, 2 * node + 1, lo, mid);
+    if (diff >= 0.0 || far_ok)
+        _kd_radius_node(s, 2 * node + 2, mid, hi);
+}
+
+static size_t _kd_radius_query(const fossil_math_spatial_kdtree* t, const double* q, size_t dims,
+                               double radius, size_t* out, size_t max) {
+    kd_radius s = {t, {q[0], q[1], q[2]}, (radius >= 0.0) ? radius * radius : -1.0, out, max, 0};
+    if (t->n > 0 && t->dims == dims)
+        _kd_radius_node(&s, 0, 0, t->n);
+    return s.found;
+}
+
+size_t fossil_math_spatial_kdtree_knn2d(const fossil_math_spatial_kdtree* tree, fossil_math_geom_point2d q,
+                                        size_t k, size_t* indices, double* dist_sq) {
+    double v[3] = {q.x, q.y, 0.0};
+    return _kd_knn_query(tree, v, 2, k, indices, dist_sq);
+}
+
+size_t fossil_math_spatial_kdtree_knn3d(const fossil_math_spatial_kdtree* tree, fossil_math_geom_point3d q,
+                                        size_t k, size_t* indices, double* dist_sq) {
+    double v[3] = {q.x, q.y, q.z};
+    return _kd_knn_query(tree, v, 3, k, indices, dist_sq);
+}
+
+size_t fossil_math_spatial_kdtree_radius2d(const fossil_math_spatial_kdtree* tree, fossil_math_geom_point2d q,
+                                           double radius, size_t* indices, size_t max) {
+    double v[3] = {q.x, q.y, 0.0};
+    return _kd_radius_query(tree, v, 2, radius, indices, max);
+}
+
+size_t fossil_math_spatial_kdtree_radius3d(const fossil_math_spatial_kdtree* tree, fossil_math_geom_point3d q,
+                                           double radius, size_t* indices, size_t max) {
+    double v[3] = {q.x, q.y, q.z};
+    return _kd_radius_query(tree, v, 3, radius, indices, max);
+}
+
+// Batch queries are independent, so threads take contiguous runs of them.
+typedef struct {
+    const fossil_math_spatial_kdtree* tree;
+    const fossil_math_geom_point2d* q2;
+    const fossil_math_geom_point3d* q3;
+    size_t k;
+    double radius;
+    size_t* indices;
+    double* dist_sq;
+    size_t* counts;
+} kd_batch;
+
+static void _kd_batch_query(const kd_batch* job, size_t i, double* v) {
+    if (job->q2) {
+        v[0] = job->q2[i].x;
+        v[1] = job->q2[i].y;
+        v[2] = 0.0;
+    } else {
+        v[0] = job->q3[i].x;
+        v[1] = job->q3[i].y;
+        v[2] = job->q3[i].z;
+    }
+}
+
+static void _kd_knn_range(void* ctx, size_t begin, size_t end) {
+    const kd_batch* job = (const kd_batch*)ctx;
+    size_t dims = job->q2 ? 2 : 3;
+    for (size_t i = begin; i < end; i++) {
+        double v[3];
+        _kd_batch_query(job, i, v);
+        _kd_knn_query(job->tree, v, dims, job->k, job->indices + i * job->k, job->dist_sq + i * job->k);
+    }
+}
+
+static void _kd_count_range(void* ctx, size_t begin, size_t end) {
+    const kd_batch* job = (const kd_batch*)ctx;
+    size_t dims = job->q2 ? 2 : 3;
+    for (size_t i = begin; i < end; i++) {
+        double v[3];
+        _kd_batch_query(job, i, v);
+        job->counts[i] = _kd_radius_query(job->tree, v, dims, job->radius, NULL, 0);
+    }
+}
+
+void fossil_math_spatial_kdtree_knn2d_batch(const fossil_math_spatial_kdtree* tree, const fossil_math_geom_point2d* queries,
+                                            size_t m, size_t k, size_t* indices, double* dist_sq) {
+    kd_batch job = {tree, queries, NULL, k, 0.0, indices, dist_sq, NULL};
+    fossil_math_parallel_for(m, KD_BATCH_GRAIN, _kd_knn_range, &job);
+}
+
+void fossil_math_spatial_kdtree_knn3d_batch(const fossil_math_spatial_kdtree* tree, const fossil_math_geom_point3d* queries,
+                                            size_t m, size_t k, size_t* indices, double* dist_sq) {
+    kd_batch job = {tree, NULL, queries, k, 0.0, indices, dist_sq, NULL};
+    fossil_math_parallel_for(m, KD_BATCH_GRAIN, _kd_knn_range, &job);
+}
+
+void fossil_math_spatial_kdtree_radius_count2d_batch(const fossil_math_spatial_kdtree* tree,
+                                                     const fossil_math_geom_point2d* queries, size_t m,
+                                                     double radius, size_t* counts) {
+    kd_batch job = {tree, queries, NULL, 0, radius, NULL, NULL, counts};
+    fossil_math_parallel_for(m, KD_BATCH_GRAIN, _kd_count_range, &job);
+}
+
+void fossil_math_spatial_kdtree_radius_count3d_batch(const fossil_math_spatial_kdtree* tree,
+                                                     const fossil_math_geom_point3d* queries, size_t m,
+                                                     double radius, size_t* counts) {
+    kd_batch job = {tree, NULL, queries, 0, radius, NULL, NULL, counts};
+    fossil_math_parallel_for(m, KD_BATCH_GRAIN, _kd_count_range, &job);
+}
+
+// ======================================================
+// Uniform grid
+// ======================================================
+
+// Marks an empty list link, bucket head or id entry.
+#define GRID_NONE SIZE_MAX
+
+// Cell coordinates are clamped to +-2^61 so differences fit in int64_t.
+#define GRID_CELL_LIMIT 2305843009213693952.0
+
+// Queries touching more cells than this scan every point instead.
+#define GRID_QUERY_CELLS 512
+
+// Points per thread chunk when computing cells and relinking slots.
+#define GRID_GRAIN ((size_t)1 << 14)
+
+// Rebuilds of fewer points sort on the calling thread.
+#define GRID_PARALLEL_MIN ((size_t)1 << 16)
+
+// Most slices in a parallel rebuild; each keeps one count per bucket.
+#define GRID_MAX_TASKS 8
+
+// Index slots per slice in the parallel rebuild (see KD_TASK_SPAN).
+#define GRID_TASK_SPAN 64
+
+// Queries per thread chunk in the batch APIs.
+#define GRID_BATCH_GRAIN 64
+
+// Points per stack chunk when a query scans every point.
+#define GRID_SCAN_CHUNK 256
+
+// Points occupy the dense slots [0, count). Each bucket of the hash table
+// heads a doubly linked list of its slots, so updates touch O(1) links; a
+// rebuild reorders the slots bucket by bucket so every list runs forward
+// through consecutive slots.
+struct fossil_math_spatial_grid {
+    size_t dims;
+    double inv_cell;
+    size_t capacity;
+    size_t count;
+    size_t mask;       // buckets - 1
+    size_t stride;     // doubles per coordinate array
+    double* c[3];      // slot coordinates, one aligned block
+    double* spare;     // rebuild target, same shape as c[0]
+    size_t* id;        // id per slot
+    size_t* bucket;    // bucket per slot
+    size_t* next;      // next slot in the bucket, or GRID_NONE
+    size_t* prev;      // previous slot in the bucket, or GRID_NONE
+    size_t* slot;      // slot per id, or GRID_NONE
+    size_t* head;      // first slot per bucket, or GRID_NONE
+};
+
+static int64_t _grid_cell(const fossil_math_spatial_grid* g, double v) {
+    double c = floor(v * g->inv_cell);
+    if (!(c >= -GRID_CELL_LIMIT))
+        c = -GRID_CELL_LIMIT;
+    else if (c > GRID_CELL_LIMIT)
+        c = GRID_CELL_LIMIT;
+    return (int64_t)c;
+}
+
+static size_t _grid_hash(const fossil_math_spatial_grid* g, const int64_t* c) {
+    uint64_t h = (uint64_t)c[0] * 0x9E3779B97F4A7C15u ^ (uint64_t)c[1] * 0xC2B2AE3D27D4EB4Fu ^
+                 (uint64_t)c[2] * 0x165667B19E3779F9u;
+    h ^= h >> 31;
+    h *= 0xBF58476D1CE4E5B9u;
+    h ^= h >> 29;
+    return (size_t)(h & g->mask);
+}
+
+static size_t _grid_point_bucket(const fossil_math_spatial_grid* g, const double* p) {
+    int64_t c[3] = {0, 0, 0};
+    for (size_t d = 0; d < g->dims; d++)
+        c[d] = _grid_cell(g, p[d]);
+    return _grid_hash(g, c);
+}
+
+static void _grid_unlink(fossil_math_spatial_grid* g, size_t s) {
+    size_t p = g->prev[s], n = g->next[s];
+    if (p != GRID_NONE)
+        g->next[p] = n;
+    else
+        g->head[g->bucket[s]] = n;
+    if (n != GRID_NONE)
+        g->prev[n] = p;
+}
+
+static void _grid_push(fossil_math_spatial_grid* g, size_t s) {
+    size_t h = g->head[g->bucket[s]];
+    g->prev[s] = GRID_NONE;
+    g->next[s] = h;
+    if (h != GRID_NONE)
+        g->prev[h] = s;
+    g->head[g->bucket[s]] = s;
+}
+
+// Moves the linked slot from into the unlinked slot to.
+static void _grid_relocate(fossil_math_spatial_grid* g, size_t from, size_t to) {
+    for (size_t d = 0; d < g->dims; d++)
+        g->c[d][to] = g->c[d][from];
+    g->id[to] = g->id[from];
+    g->bucket[to] = g->bucket[from];
+    g->next[to] = g->next[from];
+    g->prev[to] = g->prev[from];
+    if (g->prev[to] != GRID_NONE)
+        g->next[g->prev[to]] = to;
+    else
+        g->head[g->bucket[to]] = to;
+    if (g->next[to] != GRID_NONE)
+        g->prev[g->next[to]] = to;
+    g->slot[g->id[to]] = to;
+}
+
+fossil_math_spatial_grid* fossil_math_spatial_grid_create(size_t dims, double cell_size, size_t capacity) {
+    if ((dims != 2 && dims != 3) || !(cell_size > 0.0) || !isfinite(cell_size) || capacity == 0 ||
+        capacity > SIZE_MAX / (8 * sizeof(double)))
+        return NULL;
+    fossil_math_spatial_grid* g = (fossil_math_spatial_grid*)calloc(1, sizeof(*g));
+    if (!g)
+        return NULL;
+    size_t buckets = 64;
+    while (buckets < capacity)
+        buckets <<= 1;
+    g->dims = dims;
+    g->inv_cell = 1.0 / cell_size;
+    g->capacity = capacity;
+    g->mask = buckets - 1;
+    g->stride = (capacity + 7) & ~(size_t)7;
+    g->c[0] = (double*)fossil_math_aligned_alloc(g->stride * dims * sizeof(double));
+    g->spare = (double*)fossil_math_aligned_alloc(g->stride * dims * sizeof(double));
+    g->id = (size_t*)malloc(capacity * sizeof(size_t));
+    g->bucket = (size_t*)malloc(capacity * sizeof(size_t));
+    g->next = (size_t*)malloc(capacity * sizeof(size_t));
+    g->prev = (size_t*)malloc(capacity * sizeof(size_t));
+    g->slot = (size_t*)malloc(capacity * sizeof(size_t));
+    g->head = (size_t*)malloc(buckets * sizeof(size_t));
+    if (!g->c[0] || !g->spare || !g->id || !g->bucket || !g->next || !g->prev || !g->slot || !g->head) {
+        fossil_math_spatial_grid_destroy(g);
+        return NULL;
+    }
+    for (size_t d = 1; d < dims; d++)
+        g->c[d] = g->c[0] + d * g->stride;
+    for (size_t i = 0; i < capacity; i++)
+        g->slot[i] = GRID_NONE;
+    for (size_t b = 0; b < buckets; b++)
+        g->head[b] = GRID_NONE;
+    return g;
+}
+
+void fossil_math_spatial_grid_destroy(fossil_math_spatial_grid* grid) {
+    if (!grid)
+        return;
+    fossil_math_aligned_free(grid->c[0]);
+    fossil_math_aligned_free(grid->spare);
+    free(grid->id);
+    free(grid->bucket);
+    free(grid->next);
+    free(grid->prev);
+    free(grid->slot);
+    free(grid->head);
+    free(grid);
+}
+
+size_t fossil_math_spatial_grid_size(const fossil_math_spatial_grid* grid) {
+    return grid->count;
+}
+
+// ======================================================
+// Uniform grid rebuild
+// ======================================================
+
+// Counting sort by bucket: every slice counts its buckets, a prefix sum over
+// (bucket, slice) turns the counts into write positions, and every slice
+// scatters its points in order, so the sort is stable. The new ids and
+// buckets are written into prev and next, which the relink pass rewrites.
+typedef struct {
+    fossil_math_spatial_grid* g;
+    size_t tasks;
+    size_t* offset;  // tasks rows of one entry per bucket
+    double* dst[3];
+} grid_sort;
+
+static void _grid_slice(const grid_sort* s, size_t j, size_t* lo, size_t* hi) {
+    size_t base = s->g->count / s->tasks, extra = s->g->count % s->tasks;
+    *lo = j * base + (j < extra ? j : extra);
+    *hi = *lo + base + (j < extra ? 1 : 0);
+}
+
+static void _grid_count_slices(void* ctx, size_t begin, size_t end) {
+    const grid_sort* s = (const grid_sort*)ctx;
+    for (size_t j = (begin + GRID_TASK_SPAN - 1) / GRID_TASK_SPAN; j < s->tasks && j * GRID_TASK_SPAN < end; j++) {
+        size_t lo, hi;
+        size_t* row = s->offset + j * (s->g->mask + 1);
+        _grid_slice(s, j, &lo, &hi);
+        for (size_t i = lo; i < hi; i++)
+            row[s->g->bucket[i]]++;
+    }
+}
+
+static void _grid_scatter_slices(void* ctx, size_t begin, size_t end) {
+    const grid_sort* s = (const grid_sort*)ctx;
+    fossil_math_spatial_grid* g = s->g;
+    for (size_t j = (begin + GRID_TASK_SPAN - 1) / GRID_TASK_SPAN; j < s->tasks && j * GRID_TASK_SPAN < end; j++) {
+        size_t lo, hi;
+        size_t* row = s->offset + j * (g->mask + 1);
+        _grid_slice(s, j, &lo, &hi);
+        for (size_t i = lo; i < hi; i++) {
+            size_t b = g->bucket[i], p = row[b]++;
+            for (size_t d = 0; d < g->dims; d++)
+                s->dst[d][p] = g->c[d][i];
+            g->prev[p] = g->id[i];
+            g->next[p] = b;
+        }
+    }
+}
+
+static void _grid_clear_range(void* ctx, size_t begin, size_t end) {
+    fossil_math_spatial_grid* g = (fossil_math_spatial_grid*)ctx;
+    for (size_t b = begin; b < end; b++)
+        g->head[b] = GRID_NONE;
+}
+
+static void _grid_link_range(void* ctx, size_t begin, size_t end) {
+    fossil_math_spatial_grid* g = (fossil_math_spatial_grid*)ctx;
+    for (size_t s = begin; s < end; s++) {
+        size_t b = g->bucket[s];
+        int first = s == 0 || g->bucket[s - 1] != b;
+        int last = s + 1 == g->count || g->bucket[s + 1] != b;
+        g->prev[s] = first ? GRID_NONE : s - 1;
+        g->next[s] = last ? GRID_NONE : s + 1;
+        if (first)
+            g->head[b] = s;
+        g->slot[g->id[s]] = s;
+    }
+}
+
+int fossil_math_spatial_grid_rebuild(fossil_math_spatial_grid* grid) {
+    fossil_math_spatial_grid* g = grid;
+    size_t buckets = g->mask + 1;
+    size_t tasks = fossil_math_get_threads();
+    if (tasks > GRID_MAX_TASKS)
+        tasks = GRID_MAX_TASKS;
+    if (g->count < GRID_PARALLEL_MIN)
+        tasks = 1;
+    grid_sort s = {g, tasks, (size_t*)calloc(tasks * buckets, sizeof(size_t)), {NULL, NULL, NULL}};
+    if (!s.offset)
+        return -1;
+    for (size_t d = 0; d < g->dims; d++)
+        s.dst[d] = g->spare + d * g->stride;
+
+    fossil_math_parallel_for(tasks * GRID_TASK_SPAN, GRID_TASK_SPAN, _grid_count_slices, &s);
+    size_t pos = 0;
+    for (size_t b = 0; b < buckets; b++) {
+        for (size_t j = 0; j < tasks; j++) {
+            size_t n = s.offset[j * buckets + b];
+            s.offset[j * buckets + b] = pos;
+            pos += n;
+        }
+    }
+    fossil_math_parallel_for(tasks * GRID_TASK_SPAN, GRID_TASK_SPAN, _grid_scatter_slices, &s);
+    free(s.offset);
+
+    double* c = g->c[0];
+    size_t* t = g->id;
+    g->c[0] = g->spare;
+    g->spare = c;
+    for (size_t d = 1; d < g->dims; d++)
+        g->c[d] = g->c[0] + d * g->stride;
+    g->id = g->prev;
+    g->prev = t;
+    t = g->bucket;
+    g->bucket = g->next;
+    g->next = t;
+
+    fossil_math_parallel_for(buckets, GRID_GRAIN, _grid_clear_range, g);
+    fossil_math_parallel_for(g->count, GRID_GRAIN, _grid_link_range, g);
+    return 0;
+}
+
+typedef struct {
+    fossil_math_spatial_grid* g;
+    const fossil_math_geom_point2d* p2;
+    const fossil_math_geom_point3d* p3;
+} grid_assign;
+
+static void _grid_assign_range(void* ctx, size_t begin, size_t end) {
+    const grid_assign* job = (const grid_assign*)ctx;
+    fossil_math_spatial_grid* g = job->g;
+    for (size_t i = begin; i < end; i++) {
+        double v[3];
+        if (job->p2) {
+            v[0] = job->p2[i].x;
+            v[1] = job->p2[i].y;
+        } else {
+            v[0] = job->p3[i].x;
+            v[1] = job->p3[i].y;
+            v[2] = job->p3[i].z;
+        }
+        for (size_t d = 0; d < g->dims; d++)
+            g->c[d][i] = v[d];
+        g->id[i] = i;
+        g->bucket[i] = _grid_point_bucket(g, v);
+    }
+}
+
+static int _grid_assign(fossil_math_spatial_grid* g, const grid_assign* job, size_t n) {
+    for (size_t i = 0; i < g->count; i++)
+        g->slot[g->id[i]] = GRID_NONE;
+    g->count = n;
+    fossil_math_parallel_for(n, GRID_GRAIN, _grid_assign_range, (void*)job);
+    if (fossil_math_spatial_grid_rebuild(g) != 0) {
+        // The sort could not allocate; link the points unsorted instead.
+        for (size_t b = 0; b <= g->mask; b++)
+            g->head[b] = GRID_NONE;
+        for (size_t i = 0; i < n; i++) {
+            g->slot[i] = i;
+            _grid_push(g, i);
+        }
+    }
+    return 0;
+}
+
+int fossil_math_spatial_grid_assign2d(fossil_math_spatial_grid* grid, const fossil_math_geom_point2d* points, size_t n) {
+    if (grid->dims != 2 || n > grid->capacity || (!points && n))
+        return -1;
+    grid_assign job = {grid, points, NULL};
+    return _grid_assign(grid, &job, n);
+}
+
+int fossil_math_spatial_grid_assign3d(fossil_math_spatial_grid* grid, const fossil_math_geom_point3d* points, size_t n) {
+    if (grid->dims != 3 || n > grid->capacity || (!points && n))
+        return -1;
+    grid_assign job = {grid, NULL, points};
+    return _grid_assign(grid, &job, n);
+}
+
+// ======================================================
+// Uniform grid updates
+// ======================================================
+
+static int _grid_insert(fossil_math_spatial_grid* g, size_t id, const double* p) {
+    if (id >= g->capacity || g->slot[id] != GRID_NONE)
+        return -1;
+    size_t s = g->count++;
+    for (size_t d = 0; d < g->dims; d++)
+        g->c[d][s] = p[d];
+    g->id[s] = id;
+    g->bucket[s] = _grid_point_bucket(g, p);
+    g->slot[id] = s;
+    _grid_push(g, s);
+    return 0;
+}
+
+static int _grid_move(fossil_math_spatial_grid* g, size_t id, const double* p) {
+    if (id >= g->capacity || g->slot[id] == GRID_NONE)
+        return -1;
+    size_t s = g->slot[id];
+    size_t b = _grid_point_bucket(g, p);
+    for (size_t d = 0; d < g->dims; d++)
+        g->c[d][s] = p[d];
+    if (b != g->bucket[s]) {
+        _grid_unlink(g, s);
+        g->bucket[s] = b;
+        _grid_push(g, s);
+    }
+    return 0;
+}
+
+int fossil_math_spatial_grid_insert2d(fossil_math_spatial_grid* grid, size_t id, fossil_math_geom_point2d p) {
+    double v[2] = {p.x, p.y};
+    return grid->dims == 2 ? _grid_insert(grid, id, v) : -1;
+}
+
+int fossil_math_spatial_grid_insert3d(fossil_math_spatial_grid* grid, size_t id, fossil_math_geom_point3d p) {
+    double v[3] = {p.x, p.y, p.z};
+    return grid->dims == 3 ? _grid_insert(grid, id, v) : -1;
+}
+
+int fossil_math_spatial_grid_move2d(fossil_math_spatial_grid* grid, size_t id, fossil_math_geom_point2d p) {
+    double v[2] = {p.x, p.y};
+    return grid->dims == 2 ? _grid_move(grid, id, v) : -1;
+}
+
+int fossil_math_spatial_grid_move3d(fossil_math_spatial_grid* grid, size_t id, fossil_math_geom_point3d p) {
+    double v[3] = {p.x, p.y, p.z};
+    return grid->dims == 3 ? _grid_move(grid, id, v) : -1;
+}
+
+// The last slot fills the hole, so the slots stay dense.
+int fossil_math_spatial_grid_remove(fossil_math_spatial_grid* grid, size_t id) {
+    if (id >= grid->capacity || grid->slot[id] == GRID_NONE)
+        return -1;
+    size_t s = grid->slot[id], last = grid->count - 1;
+    _grid_unlink(grid, s);
+    if (s != last)
+        _grid_relocate(grid, last, s);
+    grid->slot[id] = GRID_NONE;
+    grid->count--;
+    return 0;
+}
+
+int fossil_math_spatial_grid_contains(const fossil_math_spatial_grid* grid, size_t id) {
+    return id < grid->capacity && grid->slot[id] != GRID_NONE;
+}
+
+// ======================================================
+// Uniform grid queries
+// ======================================================
+
+static int _grid_cmp(const void* a, const void* b) {
+    size_t x = *(const size_t*)a, y = *(const size_t*)b;
+    return (x > y) - (x < y);
+}
+
+// Checks every point, for queries that cover more cells than it is worth visiting.
+static size_t _grid_scan(const fossil_math_spatial_grid* g, const double* q, double r2, size_t* ids, size_t max) {
+    double d2[GRID_SCAN_CHUNK];
+    size_t found = 0;
+    for (size_t i = 0; i < g->count; i += GRID_SCAN_CHUNK) {
+        size_t len = (g->count - i < GRID_SCAN_CHUNK) ? g->count - i : GRID_SCAN_CHUNK;
+        _spatial_dist_sq(g->c, g->dims, q, i, i + len, d2);
+        for (size_t j = 0; j < len; j++) {
+            if (d2[j] <= r2) {
+                if (found < max)
+                    ids[found] = g->id[i + j];
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+// Visits every bucket the query box touches once. Buckets may hold points of
+// other cells, but the distance test rejects them, and a point in range lies
+// in a touched cell, so each match is reported exactly once.
+static size_t _grid_query(const fossil_math_spatial_grid* g, const double* q, size_t dims, double radius,
+                          size_t* ids, size_t max) {
+    if (dims != g->dims || !(radius >= 0.0) || g->count == 0)
+        return 0;
+    double r2 = radius * radius;
+    int64_t lo[3] = {0, 0, 0}, hi[3] = {0, 0, 0};
+    double cells = 1.0;
+    for (size_t d = 0; d < dims; d++) {
+        lo[d] = _grid_cell(g, q[d] - radius);
+        hi[d] = _grid_cell(g, q[d] + radius);
+        cells *= (double)(hi[d] - lo[d]) + 1.0;
+    }
+    if (cells > GRID_QUERY_CELLS || cells > (double)g->count)
+        return _grid_scan(g, q, r2, ids, max);
+
+    size_t list[GRID_QUERY_CELLS];
+    size_t nb = 0;
+    int64_t c[3];
+    for (c[2] = lo[2]; c[2] <= hi[2]; c[2]++)
+        for (c[1] = lo[1]; c[1] <= hi[1]; c[1]++)
+            for (c[0] = lo[0]; c[0] <= hi[0]; c[0]++)
+                list[nb++] = _grid_hash(g, c);
+    qsort(list, nb, sizeof(size_t), _grid_cmp);
+
+    size_t found = 0;
+    for (size_t i = 0; i < nb; i++) {
+        if (i > 0 && list[i] == list[i - 1])
+            continue;
+        for (size_t s = g->head[list[i]]; s != GRID_NONE; s = g->next[s]) {
+            double d2 = 0.0;
+            for (size_t d = 0; d < dims; d++) {
+                double u = g->c[d][s] - q[d];
+                d2 += u * u;
+            }
+            if (d2 <= r2) {
+                if (found < max)
+                    ids[found] = g->id[s];
+                found++;
+            }
+        }
+    }
+    return found;
+}
+
+size_t fossil_math_spatial_grid_radius2d(const fossil_math_spatial_grid* grid, fossil_math_geom_point2d q,
+                                         double radius, size_t* ids, size_t max) {
+    double v[2] = {q.x, q.y};
+    return _grid_query(grid, v, 2, radius, ids, max);
+}
+
+size_t fossil_math_spatial_grid_radius3d(const fossil_math_spatial_grid* grid, fossil_math_geom_point3d q,
+                                         double radius, size_t* ids, size_t max) {
+    double v[3] = {q.x, q.y, q.z};
+    return _grid_query(grid, v, 3, radius, ids, max);
+}
+
+typedef struct {
+    const fossil_math_spatial_grid* grid;
+    const fossil_math_geom_point2d* q2;
+    const fossil_math_geom_point3d* q3;
+    double radius;
+    size_t* counts;
+} grid_batch;
+
+static void _grid_count_range(void* ctx, size_t begin, size_t end) {
+    const grid_batch* job = (const grid_batch*)ctx;
+    for (size_t i = begin; i < end; i++) {
+        if (job->q2) {
+            double v[2] = {job->q2[i].x, job->q2[i].y};
+            job->counts[i] = _grid_query(job->grid, v, 2, job->radius, NULL, 0);
+        } else {
+            double v[3] = {job->q3[i].x, job->q3[i].y, job->q3[i].z};
+            job->counts[i] = _grid_query(job->grid, v, 3, job->radius, NULL, 0);
+        }
+    }
+}
+
+void fossil_math_spatial_grid_radius_count2d_batch(const fossil_math_spatial_grid* grid,
+                                                   const fossil_math_geom_point2d* queries, size_t m,
+                                                   double radius, size_t* counts) {
+    grid_batch job = {grid, queries, NULL, radius, counts};
+    fossil_math_parallel_for(m, GRID_BATCH_GRAIN, _grid_count_range, &job);
+}
+
+void fossil_math_spatial_grid_radius_count3d_batch(const fossil_math_spatial_grid* grid,
+                                                   const fossil_math_geom_point3d* queries, size_t m,
+                                                   double radius, size_t* counts) {
+    grid_batch job = {grid, NULL, queries, radius, counts};
+    fossil_math_parallel_for(m, GRID_BATCH_GRAIN, _grid_count_range, &job);
+}
+
+// ======================================================
+// Triangle BVH
+// ======================================================
+
+// Largest number of triangles in a leaf.
+#define BVH_LEAF_MAX 8
+
+// Centroid bins per axis when pricing SAH splits.
+#define BVH_BINS 16
+
+// Nodes this deep split at the centroid median instead of the SAH, which
+// bounds the depth, and so the traversal stacks, for any input.
+#define BVH_SAH_DEPTH 48
+
+// Traversal stack entries; the depth stays below BVH_SAH_DEPTH + 64.
+#define BVH_STACK 128
+
+// Builds of at least this many triangles hand their subtrees to threads.
+#define BVH_PARALLEL_MIN ((size_t)1 << 14)
+
+// Most subtrees handed out by a parallel build, and the index slots per
+// subtree (see KD_TASK_SPAN).
+#define BVH_MAX_TASKS 128
+#define BVH_TASK_SPAN 64
+
+// Triangles per thread chunk when preparing the input.
+#define BVH_GRAIN ((size_t)1 << 14)
+
+// Rays traced together, and rays per thread chunk (a multiple of it).
+#define BVH_PACKET 8
+#define BVH_BATCH_GRAIN 64
+
+// One cache line per node. The left child of an inner node follows it.
+typedef struct {
+    double lo[3];
+    double hi[3];
+    size_t offset;       // leaf: first triangle; inner node: right child
+    unsigned int count;  // leaf: triangles; inner node: 0
+    unsigned int axis;   // inner node: split axis
+} bvh_node;
+
+struct fossil_math_spatial_bvh {
+    size_t n;
+    bvh_node* node;
+    double* tri;    // v0, v1, v2 per triangle in leaf order
+    size_t* index;  // input index per triangle in leaf order
+};
+
+// Build nodes use explicit children so subtrees can be built in separate
+// node ranges; they are flattened depth-first afterwards.
+typedef struct {
+    double lo[3];
+    double hi[3];
+    size_t first;
+    size_t count;
+    size_t left;  // 0 for a leaf (the root is no one's child)
+    size_t right;
+    unsigned int axis;
+} bvh_tmp;
+
+typedef struct {
+    const fossil_math_geom_point3d* vertices;
+    const size_t* indices;
+    double* lo[3];   // triangle bounds by input index
+    double* hi[3];
+    double* cen[3];  // lo + hi, twice the box centre
+    size_t* idx;
+    bvh_tmp* tmp;
+    fossil_math_spatial_bvh* bvh;
+} bvh_build;
+
+static const fossil_math_geom_point3d* _bvh_vertex(const bvh_build* b, size_t t, size_t k) {
+    return b->vertices + (b->indices ? b->indices[3 * t + k] : 3 * t + k);
+}
+
+static void _bvh_bounds_range(void* ctx, size_t begin, size_t end) {
+    const bvh_build* b = (const bvh_build*)ctx;
+    for (size_t t = begin; t < end; t++) {
+        for (size_t a = 0; a < 3; a++) {
+            b->lo[a][t] = INFINITY;
+            b->hi[a][t] = -INFINITY;
+        }
+        for (size_t k = 0; k < 3; k++) {
+            const fossil_math_geom_point3d* v = _bvh_vertex(b, t, k);
+            double c[3] = {v->x, v->y, v->z};
+            for (size_t a = 0; a < 3; a++) {
+                b->lo[a][t] = (c[a] < b->lo[a][t]) ? c[a] : b->lo[a][t];
+                b->hi[a][t] = (c[a] > b->hi[a][t]) ? c[a] : b->hi[a][t];
+            }
+        }
+        for (size_t a = 0; a < 3; a++)
+            b->cen[a][t] = b->lo[a][t] + b->hi[a][t];
+        b->idx[t] = t;
+    }
+}
+
+static void _bvh_gather_range(void* ctx, size_t begin, size_t end) {
+    const bvh_build* b = (const bvh_build*)ctx;
+    for (size_t i = begin; i < end; i++) {
+        double* out = b->bvh->tri + 9 * i;
+        for (size_t k = 0; k < 3; k++) {
+            const fossil_math_geom_point3d* v = _bvh_vertex(b, b->idx[i], k);
+            out[3 * k] = v->x;
+            out[3 * k + 1] = v->y;
+            out[3 * k + 2] = v->z;
+        }
+    }
+}
+
+static double _bvh_half_area(const double* lo, const double* hi) {
+    double dx = hi[0] - lo[0], dy = hi[1] - lo[1], dz = hi[2] - lo[2];
+    return dx * dy + dy * dz + dz * dx;
+}
+
+static void _bvh_grow(double* lo, double* hi, const double* plo, const double* phi) {
+    for (size_t a = 0; a < 3; a++) {
+        lo[a] = (plo[a] < lo[a]) ? plo[a] : lo[a];
+        hi[a] = (phi[a] > hi[a]) ? phi[a] : hi[a];
+    }
+}
+
+static size_t _bvh_bin(double c, double lo, double scale) {
+    double x = (c - lo) * scale;
+    return (x < BVH_BINS) ? (size_t)x : BVH_BINS - 1;
+}
+
+// Prices every bin boundary on every axis; returns the cheapest as axis * BVH_BINS
+// + bin with its cost (sum of child half areas times counts), or SIZE_MAX.
+static size_t _bvh_sah(const bvh_build* b, size_t first, size_t end, const double* clo, const double* chi,
+                       double* cost) {
+    size_t best = SIZE_MAX;
+    *cost = INFINITY;
+    for (size_t a = 0; a < 3; a++) {
+        double extent = chi[a] - clo[a];
+        if (!(extent > 0.0) || !isfinite(extent))
+            continue;
+        double scale = BVH_BINS / extent;
+        size_t count[BVH_BINS] = {0};
+        double lo[BVH_BINS][3], hi[BVH_BINS][3];
+        for (size_t k = 0; k < BVH_BINS; k++)
+            for (size_t d = 0; d < 3; d++) {
+                lo[k][d] = INFINITY;
+                hi[k][d] = -INFINITY;
+            }
+        for (size_t i = first; i < end; i++) {
+            size_t t = b->idx[i], k = _bvh_bin(b->cen[a][t], clo[a], scale);
+            double tlo[3] = {b->lo[0][t], b->lo[1][t], b->lo[2][t]};
+            double thi[3] = {b->hi[0][t], b->hi[1][t], b->hi[2][t]};
+            count[k]++;
+            _bvh_grow(lo[k], hi[k], tlo, thi);
+        }
+        double right_area[BVH_BINS];
+        size_t right_count[BVH_BINS];
+        double rlo[3] = {INFINITY, INFINITY, INFINITY}, rhi[3] = {-INFINITY, -INFINITY, -INFINITY};
+        size_t rc = 0;
+        for (size_t k = BVH_BINS - 1; k > 0; k--) {
+            _bvh_grow(rlo, rhi, lo[k], hi[k]);
+            rc += count[k];
+            right_area[k] = rc ? _bvh_half_area(rlo, rhi) : 0.0;
+            right_count[k] = rc;
+        }
+        double llo[3] = {INFINITY, INFINITY, INFINITY}, lhi[3] = {-INFINITY, -INFINITY, -INFINITY};
+        size_t lc = 0;
+        for (size_t k = 1; k < BVH_BINS; k++) {
+            _bvh_grow(llo, lhi, lo[k - 1], hi[k - 1]);
+            lc += count[k - 1];
+            if (!lc || !right_count[k])
+                continue;
+            double c = _bvh_half_area(llo, lhi) * (double)lc + right_area[k] * (double)right_count[k];
+            if (c < *cost) {
+                *cost = c;
+                best = a * BVH_BINS + k;
+            }
+        }
+    }
+    return best;
+}
+
+// Sets the bounds of a node and either leaves it a leaf (returns 0) or
+// partitions its triangles between two new children (returns 1).
+static int _bvh_split(const bvh_build* b, size_t node, size_t depth, size_t* next) {
+    bvh_tmp* t = b->tmp + node;
+    size_t first = t->first, end = t->first + t->count;
+    double clo[3] = {INFINITY, INFINITY, INFINITY}, chi[3] = {-INFINITY, -INFINITY, -INFINITY};
+    for (size_t a = 0; a < 3; a++) {
+        t->lo[a] = INFINITY;
+        t->hi[a] = -INFINITY;
+    }
+    for (size_t i = first; i < end; i++) {
+        size_t j = b->idx[i];
+        double tlo[3] = {b->lo[0][j], b->lo[1][j], b->lo[2][j]};
+        double thi[3] = {b->hi[0][j], b->hi[1][j], b->hi[2][j]};
+        double c[3] = {b->cen[0][j], b->cen[1][j], b->cen[2][j]};
+        _bvh_grow(t->lo, t->hi, tlo, thi);
+        _bvh_grow(clo, chi, c, c);
+    }
+    t->left = 0;
+    if (t->count <= 1)
+        return 0;
+
+    double cost = INFINITY;
+    size_t split = (depth < BVH_SAH_DEPTH) ? _bvh_sah(b, first, end, clo, chi, &cost) : SIZE_MAX;
+    if (t->count <= BVH_LEAF_MAX) {
+        // Leaf cost is one test per triangle; a split adds one node visit.
+        double area = _bvh_half_area(t->lo, t->hi);
+        if (split == SIZE_MAX || !(area > 0.0) || !(1.0 + cost / area < (double)t->count))
+            return 0;
+    }
+
+    size_t axis = 0, mid;
+    if (split != SIZE_MAX) {
+        axis = split / BVH_BINS;
+        size_t bin = split % BVH_BINS;
+        double scale = BVH_BINS / (chi[axis] - clo[axis]);
+        size_t i = first, j = end;
+        while (i < j) {
+            if (_bvh_bin(b->cen[axis][b->idx[i]], clo[axis], scale) < bin) {
+                i++;
+            } else {
+                size_t tmp = b->idx[i];
+                b->idx[i] = b->idx[--j];
+                b->idx[j] = tmp;
+            }
+        }
+        mid = i;
+    } else {
+        for (size_t a = 1; a < 3; a++)
+            if (chi[a] - clo[a] > chi[axis] - clo[axis])
+                axis = a;
+        mid = first + t->count / 2;
+        _kd_select(b->idx, b->cen[axis], first, end, mid);
+    }
+
+    bvh_tmp* l = b->tmp + (*next)++;
+    bvh_tmp* r = b->tmp + (*next)++;
+    l->first = first;
+    l->count = mid - first;
+    r->first = mid;
+    r->count = end - mid;
+    t->left = (size_t)(l - b->tmp);
+    t->right = (size_t)(r - b->tmp);
+    t->axis = (unsigned int)axis;
+    return 1;
+}
+
+static void _bvh_build_node(const bvh_build* b, size_t node, size_t depth, size_t* next) {
+    if (_bvh_split(b, node, depth, next)) {
+        _bvh_build_node(b, b->tmp[node].left, depth + 1, next);
+        _bvh_build_node(b, b->tmp[node].right, depth + 1, next);
+    }
+}
+
+// Subtree j grows into its own node range starting at next[j]; a subtree of
+// k triangles needs at most 2k - 2 nodes below its root.
+typedef struct {
+    const bvh_build* build;
+    size_t count;
+    size_t node[BVH_MAX_TASKS];
+    size_t depth[BVH_MAX_TASKS];
+    size_t next[BVH_MAX_TASKS];
+} bvh_tasks;
+
+static void _bvh_task_range(void* ctx, size_t begin, size_t end) {
+    const bvh_tasks* tasks = (const bvh_tasks*)ctx;
+    for (size_t j = (begin + BVH_TASK_SPAN - 1) / BVH_TASK_SPAN; j < tasks->count && j * BVH_TASK_SPAN < end; j++) {
+        size_t next = tasks->next[j];
+        _bvh_build_node(tasks->build, tasks->node[j], tasks->depth[j], &next);
+    }
+}
+
+// Splits the top levels on the calling thread until there are two subtrees
+// per thread, then builds the subtrees in parallel.
+static void _bvh_build_parallel(const bvh_build* b, size_t threads) {
+    bvh_tasks tasks;
+    size_t want = 2 * threads, next = 1;
+    if (want > BVH_MAX_TASKS)
+        want = BVH_MAX_TASKS;
+    tasks.build = b;
+    tasks.count = 1;
+    tasks.node[0] = 0;
+    tasks.depth[0] = 0;
+    while (tasks.count < want && 2 * tasks.count <= BVH_MAX_TASKS) {
+        size_t count = tasks.count;
+        int split = 0;
+        for (size_t j = 0; j < count; j++) {
+            size_t node = tasks.node[j];
+            if (!_bvh_split(b, node, tasks.depth[j], &next))
+                continue;
+            tasks.node[j] = b->tmp[node].left;
+            tasks.depth[j]++;
+            tasks.node[tasks.count] = b->tmp[node].right;
+            tasks.depth[tasks.count] = tasks.depth[j];
+            tasks.count++;
+            split = 1;
+        }
+        if (!split)
+            break;
+    }
+    for (size_t j = 0; j < tasks.count; j++) {
+        tasks.next[j] = next;
+        next += 2 * b->tmp[tasks.node[j]].count - 2;
+    }
+    fossil_math_parallel_for(tasks.count * BVH_TASK_SPAN, BVH_TASK_SPAN, _bvh_task_range, &tasks);
+}
+
+static size_t _bvh_flatten(bvh_node* out, const bvh_tmp* tmp, size_t node, size_t* count) {
+    size_t i = (*count)++;
+    const bvh_tmp* t = tmp + node;
+    for (size_t a = 0; a < 3; a++) {
+        out[i].lo[a] = t->lo[a];
+        out[i].hi[a] = t->hi[a];
+    }
+    out[i].axis = t->axis;
+    if (!t->left) {
+        out[i].offset = t->first;
+        out[i].count = (unsigned int)t->count;
+        out[i].axis = 0;
+    } else {
+        out[i].count = 0;
+        _bvh_flatten(out, tmp, t->left, count);
+        out[i].offset = _bvh_flatten(out, tmp, t->right, count);
+    }
+    return i;
+}
+
+void fossil_math_spatial_bvh_destroy(fossil_math_spatial_bvh* bvh) {
+    if (!bvh)
+        return;
+    fossil_math_aligned_free(bvh->node);
+    free(bvh->tri);
+    free(bvh->index);
+    free(bvh);
+}
+
+fossil_math_spatial_bvh* fossil_math_spatial_bvh_create(const fossil_math_geom_point3d* vertices, size_t vertex_count,
+                                                        const size_t* indices, size_t triangle_count) {
+    size_t n = triangle_count;
+    if (n > SIZE_MAX / (16 * sizeof(bvh_node)) || (n && !vertices))
+        return NULL;
+    if (indices) {
+        for (size_t i = 0; i < 3 * n; i++)
+            if (indices[i] >= vertex_count)
+                return NULL;
+    } else if (n > vertex_count / 3) {
+        return NULL;
+    }
+    fossil_math_spatial_bvh* bvh = (fossil_math_spatial_bvh*)calloc(1, sizeof(*bvh));
+    if (!bvh)
+        return NULL;
+    bvh->n = n;
+    if (n == 0)
+        return bvh;
+
+    bvh->node = (bvh_node*)fossil_math_aligned_alloc((2 * n - 1) * sizeof(bvh_node));
+    bvh->tri = (double*)malloc(9 * n * sizeof(double));
+    bvh->index = (size_t*)malloc(n * sizeof(size_t));
+    double* box = (double*)malloc(9 * n * sizeof(double));
+    bvh_tmp* tmp = (bvh_tmp*)malloc((2 * n - 1) * sizeof(bvh_tmp));
+    if (!bvh->node || !bvh->tri || !bvh->index || !box || !tmp) {
+        free(box);
+        free(tmp);
+        fossil_math_spatial_bvh_destroy(bvh);
+        return NULL;
+    }
+    bvh_build b;
+    b.vertices = vertices;
+    b.indices = indices;
+    for (size_t a = 0; a < 3; a++) {
+        b.lo[a] = box + a * n;
+        b.hi[a] = box + (3 + a) * n;
+        b.cen[a] = box + (6 + a) * n;
+    }
+    b.idx = bvh->index;
+    b.tmp = tmp;
+    b.bvh = bvh;
+    fossil_math_parallel_for(n, BVH_GRAIN, _bvh_bounds_range, &b);
+
+    tmp[0].first = 0;
+    tmp[0].count = n;
+    size_t threads = fossil_math_get_threads(), next = 1;
+    if (threads > 1 && n >= BVH_PARALLEL_MIN)
+        _bvh_build_parallel(&b, threads);
+    else
+        _bvh_build_node(&b, 0, 0, &next);
+
+    size_t count = 0;
+    _bvh_flatten(bvh->node, tmp, 0, &count);
+    fossil_math_parallel_for(n, BVH_GRAIN, _bvh_gather_range, &b);
+    free(box);
+    free(tmp);
+    return bvh;
+}
+
+size_t fossil_math_spatial_bvh_size(const fossil_math_spatial_bvh* bvh) {
+    return bvh->n;
+}
+
+// ======================================================
+// Triangle BVH queries
+// ======================================================
+
+// A packet holds up to BVH_PACKET rays in SIMD groups of SIMD_LANES. Unused
+// lanes have t = -INFINITY, which no box or triangle can beat.
+typedef struct {
+    size_t n;
+    double o[3][BVH_PACKET];
+    double d[3][BVH_PACKET];
+    double inv[3][BVH_PACKET];
+    double t[BVH_PACKET];
+    double u[BVH_PACKET];
+    double v[BVH_PACKET];
+    size_t tri[BVH_PACKET];
+} bvh_packet;
+
+static void _bvh_packet_load(bvh_packet* p, const fossil_math_spatial_ray* rays, size_t n, double t_max) {
+    p->n = n;
+    for (size_t r = 0; r < BVH_PACKET; r++) {
+        double o[3] = {0.0, 0.0, 0.0}, d[3] = {0.0, 0.0, 0.0};
+        if (r < n) {
+            o[0] = rays[r].origin.x;
+            o[1] = rays[r].origin.y;
+            o[2] = rays[r].origin.z;
+            d[0] = rays[r].dir.x;
+            d[1] = rays[r].dir.y;
+            d[2] = rays[r].dir.z;
+        }
+        for (size_t a = 0; a < 3; a++) {
+            p->o[a][r] = o[a];
+            p->d[a][r] = d[a];
+            p->inv[a][r] = (r < n) ? 1.0 / d[a] : 0.0;
+        }
+        p->t[r] = (r < n) ? t_max : -INFINITY;
+        p->u[r] = 0.0;
+        p->v[r] = 0.0;
+        p->tri[r] = SIZE_MAX;
+    }
+}
+
+static size_t _bvh_packet_store(const bvh_packet* p, fossil_math_spatial_hit* hits) {
+    size_t found = 0;
+    for (size_t r = 0; r < p->n; r++) {
+        if (p->tri[r] == SIZE_MAX) {
+            hits[r].t = INFINITY;
+            hits[r].u = 0.0;
+            hits[r].v = 0.0;
+            hits[r].triangle = SIZE_MAX;
+        } else {
+            hits[r].t = p->t[r];
+            hits[r].u = p->u[r];
+            hits[r].v = p->v[r];
+            hits[r].triangle = p->tri[r];
+            found++;
+        }
+    }
+    return found;
+}
+
+// Slab test of every group against a node; bit g is set if any ray of group
+// g may hit the box before its current best t.
+static unsigned int _bvh_packet_box(const bvh_packet* p, const bvh_node* node, size_t groups) {
+    unsigned int hit = 0;
+    for (size_t g = 0; g < groups; g++) {
+        size_t off = g * SIMD_LANES;
+        simd_vd near = simd_set1(0.0), far = simd_load(p->t + off);
+        for (size_t a = 0; a < 3; a++) {
+            simd_vd o = simd_load(p->o[a] + off), inv = simd_load(p->inv[a] + off);
+            simd_vd t1 = simd_mul(simd_sub(simd_set1(node->lo[a]), o), inv);
+            simd_vd t2 = simd_mul(simd_sub(simd_set1(node->hi[a]), o), inv);
+            // A ray parallel to a slab and on its face gives 0 * inf = NaN;
+            // it stays inside the slab, so that axis does not limit t.
+            simd_vd ok = simd_and(simd_eq(t1, t1), simd_eq(t2, t2));
+            near = simd_select(ok, simd_max(near, simd_min(t1, t2)), near);
+            far = simd_select(ok, simd_min(far, simd_max(t1, t2)), far);
+        }
+        if (simd_any(simd_le(near, far)))
+            hit |= 1u << g;
+    }
+    return hit;
+}
+
+// Two-sided Moller-Trumbore test of one triangle against one group. A zero
+// determinant turns u, v and t into NaN or infinities, which fail the tests.
+static void _bvh_packet_tri(bvh_packet* p, size_t g, const double* v, size_t tri) {
+    size_t off = g * SIMD_LANES;
+    double e1[3] = {v[3] - v[0], v[4] - v[1], v[5] - v[2]};
+    double e2[3] = {v[6] - v[0], v[7] - v[1], v[8] - v[2]};
+    simd_vd dx = simd_load(p->d[0] + off), dy = simd_load(p->d[1] + off), dz = simd_load(p->d[2] + off);
+    simd_vd px = simd_sub(simd_mul(dy, simd_set1(e2[2])), simd_mul(dz, simd_set1(e2[1])));
+    simd_vd py = simd_sub(simd_mul(dz, simd_set1(e2[0])), simd_mul(dx, simd_set1(e2[2])));
+    simd_vd pz = simd_sub(simd_mul(dx, simd_set1(e2[1])), simd_mul(dy, simd_set1(e2[0])));
+    simd_vd det = simd_add(simd_add(simd_mul(simd_set1(e1[0]), px), simd_mul(simd_set1(e1[1]), py)),
+                           simd_mul(simd_set1(e1[2]), pz));
+    simd_vd inv = simd_div(simd_set1(1.0), det);
+    simd_vd sx = simd_sub(simd_load(p->o[0] + off), simd_set1(v[0]));
+    simd_vd sy = simd_sub(simd_load(p->o[1] + off), simd_set1(v[1]));
+    simd_vd sz = simd_sub(simd_load(p->o[2] + off), simd_set1(v[2]));
+    simd_vd u = simd_mul(simd_add(simd_add(simd_mul(sx, px), simd_mul(sy, py)), simd_mul(sz, pz)), inv);
+    simd_vd qx = simd_sub(simd_mul(sy, simd_set1(e1[2])), simd_mul(sz, simd_set1(e1[1])));
+    simd_vd qy = simd_sub(simd_mul(sz, simd_set1(e1[0])), simd_mul(sx, simd_set1(e1[2])));
+    simd_vd qz = simd_sub(simd_mul(sx, simd_set1(e1[1])), simd_mul(sy, simd_set1(e1[0])));
+    simd_vd w = simd_mul(simd_add(simd_add(simd_mul(dx, qx), simd_mul(dy, qy)), simd_mul(dz, qz)), inv);
+    simd_vd t = simd_mul(simd_add(simd_add(simd_mul(simd_set1(e2[0]), qx), simd_mul(simd_set1(e2[1]), qy)),
+                                  simd_mul(simd_set1(e2[2]), qz)),
+                         inv);
+    simd_vd zero = simd_set1(0.0);
+    simd_vd m = simd_and(simd_and(simd_ge(u, zero), simd_ge(w, zero)),
+                         simd_and(simd_le(simd_add(u, w), simd_set1(1.0)),
+                                  simd_and(simd_ge(t, zero), simd_le(t, simd_load(p->t + off)))));
+    int bits = simd_mask_bits(m);
+    if (!bits)
+        return;
+    double tv[SIMD_LANES], uv[SIMD_LANES], wv[SIMD_LANES];
+    simd_store(tv, t);
+    simd_store(uv, u);
+    simd_store(wv, w);
+    for (size_t l = 0; l < SIMD_LANES; l++) {
+        size_t r = off + l;
+        if (!((bits >> l) & 1) || !(tv[l] < p->t[r] || tri < p->tri[r]))
+            continue;
+        p->t[r] = tv[l];
+        p->u[r] = uv[l];
+        p->v[r] = wv[l];
+        p->tri[r] = tri;
+    }
+}
+
+static void _bvh_trace(const fossil_math_spatial_bvh* bvh, bvh_packet* p) {
+    if (bvh->n == 0)
+        return;
+    size_t groups = (p->n + SIMD_LANES - 1) / SIMD_LANES;
+    size_t stack[BVH_STACK];
+    size_t top = 0;
+    stack[top++] = 0;
+    while (top) {
+        size_t i = stack[--top];
+        const bvh_node* node = bvh->node + i;
+        unsigned int hit = _bvh_packet_box(p, node, groups);
+        if (!hit)
+            continue;
+        if (node->count) {
+            for (size_t k = 0; k < node->count; k++) {
+                size_t s = node->offset + k;
+                for (size_t g = 0; g < groups; g++)
+                    if ((hit >> g) & 1)
+                        _bvh_packet_tri(p, g, bvh->tri + 9 * s, bvh->index[s]);
+            }
+        } else {
+            // Visit the child nearer along the split axis first, as seen by the first ray.
+            size_t near = i + 1, far = node->offset;
+            if (p->d[node->axis][0] < 0.0) {
+                near = node->offset;
+                far = i + 1;
+            }
+            stack[top++] = far;
+            stack[top++] = near;
+        }
+    }
+}
+
+int fossil_math_spatial_bvh_intersect(const fossil_math_spatial_bvh* bvh, fossil_math_spatial_ray ray, double t_max,
+                                      fossil_math_spatial_hit* hit) {
+    bvh_packet p;
+    _bvh_packet_load(&p, &ray, 1, t_max);
+    _bvh_trace(bvh, &p);
+    return (int)_bvh_packet_store(&p, hit);
+}
+
+typedef struct {
+    const fossil_math_spatial_bvh* bvh;
+    const fossil_math_spatial_ray* rays;
+    double t_max;
+    fossil_math_spatial_hit* hits;
+} bvh_batch;
+
+static void _bvh_trace_range(void* ctx, size_t begin, size_t end) {
+    const bvh_batch* job = (const bvh_batch*)ctx;
+    for (size_t i = begin; i < end; i += BVH_PACKET) {
+        size_t n = (end - i < BVH_PACKET) ? end - i : BVH_PACKET;
+        bvh_packet p;
+        _bvh_packet_load(&p, job->rays + i, n, job->t_max);
+        _bvh_trace(job->bvh, &p);
+        _bvh_packet_store(&p, job->hits + i);
+    }
+}
+
+size_t fossil_math_spatial_bvh_intersect_batch(const fossil_math_spatial_bvh* bvh, const fossil_math_spatial_ray* rays,
+                                               size_t m, double t_max, fossil_math_spatial_hit* hits) {
+    bvh_batch job = {bvh, rays, t_max, hits};
+    fossil_math_parallel_for(m, BVH_BATCH_GRAIN, _bvh_trace_range, &job);
+    size_t found = 0;
+    for (size_t i = 0; i < m; i++)
+        found += hits[i].triangle != SIZE_MAX;
+    return found;
+}
+
+static double _bvh_dot(const double* a, const double* b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+static void _bvh_segment_closest(const double* p, const double* a, const double* b, double* out) {
+    double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    double ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+    double len = _bvh_dot(ab, ab), s = (len > 0.0) ? _bvh_dot(ap, ab) / len : 0.0;
+    s = (s > 0.0) ? ((s < 1.0) ? s : 1.0) : 0.0;
+    for (size_t k = 0; k < 3; k++)
+        out[k] = a[k] + s * ab[k];
+}
+
+static double _bvh_dist_sq(const double* a, const double* b) {
+    double d[3] = {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+    return _bvh_dot(d, d);
+}
+
+// Closest point of triangle v to p by Voronoi region (Ericson, Real-Time
+// Collision Detection, 5.1.5). Degenerate triangles use their edges.
+static void _bvh_triangle_closest(const double* p, const double* v, double* out) {
+    const double *a = v, *b = v + 3, *c = v + 6;
+    double ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    double ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    double ap[3] = {p[0] - a[0], p[1] - a[1], p[2] - a[2]};
+    double bp[3] = {p[0] - b[0], p[1] - b[1], p[2] - b[2]};
+    double cp[3] = {p[0] - c[0], p[1] - c[1], p[2] - c[2]};
+    double d1 = _bvh_dot(ab, ap), d2 = _bvh_dot(ac, ap);
+    double d3 = _bvh_dot(ab, bp), d4 = _bvh_dot(ac, bp);
+    double d5 = _bvh_dot(ab, cp), d6 = _bvh_dot(ac, cp);
+    double va = d3 * d6 - d5 * d4, vb = d5 * d2 - d1 * d6, vc = d1 * d4 - d3 * d2;
+    if (!(va + vb + vc > 0.0)) {
+        double e[3][3];
+        _bvh_segment_closest(p, a, b, e[0]);
+        _bvh_segment_closest(p, b, c, e[1]);
+        _bvh_segment_closest(p, c, a, e[2]);
+        size_t k = 0;
+        for (size_t i = 1; i < 3; i++)
+            if (_bvh_dist_sq(e[i], p) < _bvh_dist_sq(e[k], p))
+                k = i;
+        for (size_t i = 0; i < 3; i++)
+            out[i] = e[k][i];
+        return;
+    }
+    double s, t;
+    if (d1 <= 0.0 && d2 <= 0.0) {
+        s = 0.0;
+        t = 0.0;
+    } else if (d3 >= 0.0 && d4 <= d3) {
+        s = 1.0;
+        t = 0.0;
+    } else if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+        s = d1 / (d1 - d3);
+        t = 0.0;
+    } else if (d6 >= 0.0 && d5 <= d6) {
+        s = 0.0;
+        t = 1.0;
+    } else if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+        s = 0.0;
+        t = d2 / (d2 - d6);
+    } else if (va <= 0.0 && d4 - d3 >= 0.0 && d5 - d6 >= 0.0) {
+        double w = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+        for (size_t i = 0; i < 3; i++)
+            out[i] = b[i] + w * (c[i] - b[i]);
+        return;
+    } else {
+        double inv = 1.0 / (va + vb + vc);
+        s = vb * inv;
+        t = vc * inv;
+    }
+    for (size_t i = 0; i < 3; i++)
+        out[i] = a[i] + s * ab[i] + t * ac[i];
+}
+
+static double _bvh_box_dist_sq(const bvh_node* node, const double* p) {
+    double d2 = 0.0;
+    for (size_t a = 0; a < 3; a++) {
+        double d = (p[a] < node->lo[a]) ? node->lo[a] - p[a] : ((p[a] > node->hi[a]) ? p[a] - node->hi[a] : 0.0);
+        d2 += d * d;
+    }
+    return d2;
+}
+
+int fossil_math_spatial_bvh_closest(const fossil_math_spatial_bvh* bvh, fossil_math_geom_point3d p,
+                                    fossil_math_spatial_nearest* out) {
+    if (bvh->n == 0)
+        return -1;
+    double q[3] = {p.x, p.y, p.z}, best_pt[3] = {NAN, NAN, NAN};
+    double best = INFINITY;
+    size_t best_tri = SIZE_MAX;
+    size_t stack[BVH_STACK];
+    double bound[BVH_STACK];
+    size_t top = 0;
+    stack[top] = 0;
+    bound[top++] = _bvh_box_dist_sq(bvh->node, q);
+    while (top) {
+        top--;
+        if (bound[top] > best)
+            continue;
+        const bvh_node* node = bvh->node + stack[top];
+        if (node->count) {
+            for (size_t k = 0; k < node->count; k++) {
+                size_t s = node->offset + k;
+                double c[3];
+                _bvh_triangle_closest(q, bvh->tri + 9 * s, c);
+                double d2 = _bvh_dist_sq(c, q);
+                if (d2 < best || (d2 == best && bvh->index[s] < best_tri)) {
+                    best = d2;
+                    best_tri = bvh->index[s];
+                    best_pt[0] = c[0];
+                    best_pt[1] = c[1];
+                    best_pt[2] = c[2];
+                }
+            }
+        } else {
+            size_t i = stack[top], near = i + 1, far = node->offset;
+            double dn = _bvh_box_dist_sq(bvh->node + near, q), df = _bvh_box_dist_sq(bvh->node + far, q);
+            if (df < dn) {
+                size_t s = near;
+                double d = dn;
+                near = far;
+                far = s;
+                dn = df;
+                df = d;
+            }
+            stack[top] = far;
+            bound[top++] = df;
+            stack[top] = near;
+            bound[top++] = dn;
+        }
+    }
+    out->point.x = best_pt[0];
+    out->point.y = best_pt[1];
+    out->point.z = best_pt[2];
+    out->dist_sq = best;
+    out->triangle = best_tri;
+    return 0;
+}
+
+// Separating-axis test along n: the triangle and box overlap on n if their
+// projections do. Box projections come from the corners, not a centre.
+static int _bvh_axis_overlap(const double* v, const double* n, const double* lo, const double* hi) {
+    double p0 = _bvh_dot(n, v), p1 = _bvh_dot(n, v + 3), p2 = _bvh_dot(n, v + 6);
+    double tmin = (p0 < p1) ? p0 : p1, tmax = (p0 < p1) ? p1 : p0;
+    tmin = (p2 < tmin) ? p2 : tmin;
+    tmax = (p2 > tmax) ? p2 : tmax;
+    double bmin = 0.0, bmax = 0.0;
+    for (size_t k = 0; k < 3; k++) {
+        double a = n[k] * lo[k], b = n[k] * hi[k];
+        bmin += (a < b) ? a : b;
+        bmax += (a < b) ? b : a;
+    }
+    return tmax >= bmin && tmin <= bmax;
+}
+
+// Triangle-box overlap by the 13 separating axes of Akenine-Moller: the box
+// axes, the triangle normal and the 9 edge-by-box-axis cross products.
+static int _bvh_triangle_box(const double* v, const double* lo, const double* hi) {
+    for (size_t k = 0; k < 3; k++) {
+        double axis[3] = {0.0, 0.0, 0.0};
+        axis[k] = 1.0;
+        if (!_bvh_axis_overlap(v, axis, lo, hi))
+            return 0;
+    }
+    double e[3][3];
+    for (size_t i = 0; i < 3; i++)
+        for (size_t k = 0; k < 3; k++)
+            e[i][k] = v[3 * ((i + 1) % 3) + k] - v[3 * i + k];
+    double normal[3] = {e[0][1] * e[1][2] - e[0][2] * e[1][1], e[0][2] * e[1][0] - e[0][0] * e[1][2],
+                        e[0][0] * e[1][1] - e[0][1] * e[1][0]};
+    if (!_bvh_axis_overlap(v, normal, lo, hi))
+        return 0;
+    for (size_t i = 0; i < 3; i++) {
+        double axes[3][3] = {{0.0, -e[i][2], e[i][1]}, {e[i][2], 0.0, -e[i][0]}, {-e[i][1], e[i][0], 0.0}};
+        for (size_t k = 0; k < 3; k++)
+            if (!_bvh_axis_overlap(v, axes[k], lo, hi))
+                return 0;
+    }
+    return 1;
+}
+
+size_t fossil_math_spatial_bvh_overlap(const fossil_math_spatial_bvh* bvh, fossil_math_geom_aabb3d box,
+                                       size_t* triangles, size_t max) {
+    if (bvh->n == 0)
+        return 0;
+    double lo[3] = {box.lo.x, box.lo.y, box.lo.z}, hi[3] = {box.hi.x, box.hi.y, box.hi.z};
+    size_t stack[BVH_STACK];
+    size_t top = 0, found = 0;
+    stack[top++] = 0;
+    while (top) {
+        size_t i = stack[--top];
+        const bvh_node* node = bvh->node + i;
+        int inside = 1;
+        for (size_t a = 0; a < 3; a++)
+            inside &= node->lo[a] <= hi[a] && node->hi[a] >= lo[a];
+        if (!inside)
+            continue;
+        if (node->count) {
+            for (size_t k = 0; k < node->count; k++) {
+                size_t s = node->offset + k;
+                if (_bvh_triangle_box(bvh->tri + 9 * s, lo, hi)) {
+                    if (found < max)
+                        triangles[found] = bvh->index[s];
+                    found++;
+                }
+            }
+        } else {
+            stack[top++] = node->offset;
+            stack[top++] = i + 1;
+        }
+    }
+    return found;
+}
+
+// ======================================================
+// Space-filling curves
+// ======================================================
+
+// Points per thread chunk when computing keys and gathering.
+#define CURVE_GRAIN ((size_t)1 << 14)
+
+// Points per stack chunk when quantizing coordinates.
+#define CURVE_CHUNK 256
+
+// Sorts of fewer keys run on the calling thread.
+#define CURVE_PARALLEL_MIN ((size_t)1 << 16)
+
+// Most slices in a parallel sort; each keeps one count per digit.
+#define CURVE_MAX_TASKS 64
+
+// Index slots per slice in the parallel sort (see KD_TASK_SPAN).
+#define CURVE_TASK_SPAN 64
+
+// Radix sort digit width; 8 bits keep the 256 scatter targets in cache.
+#define CURVE_RADIX_BITS 8
+#define CURVE_RADIX (1 << CURVE_RADIX_BITS)
+
+// Spreads the low 32 (21) bits of v so that bit i moves to bit 2i (3i).
+// With BMI2 this is one pdep; note that pdep is microcoded on AMD CPUs
+// before Zen 3, where the shift-and-mask form is faster.
+static uint64_t _curve_spread2(uint64_t v) {
+#if defined(__BMI2__)
+    return _pdep_u64(v, 0x5555555555555555u);
+#else
+    v &= 0xFFFFFFFFu;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFu;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FFu;
+    v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Fu;
+    v = (v | (v << 2)) & 0x3333333333333333u;
+    return (v | (v << 1)) & 0x5555555555555555u;
+#endif
+}
+
+static uint64_t _curve_spread3(uint64_t v) {
+#if defined(__BMI2__)
+    return _pdep_u64(v, 0x1249249249249249u);
+#else
+    v &= 0x1FFFFFu;
+    v = (v | (v << 32)) & 0x001F00000000FFFFu;
+    v = (v | (v << 16)) & 0x001F0000FF0000FFu;
+    v = (v | (v << 8)) & 0x100F00F00F00F00Fu;
+    v = (v | (v << 4)) & 0x10C30C30C30C30C3u;
+    return (v | (v << 2)) & 0x1249249249249249u;
+#endif
+}
+
+uint64_t fossil_math_spatial_morton2d(uint32_t x, uint32_t y) {
+    return _curve_spread2(x) | (_curve_spread2(y) << 1);
+}
+
+uint64_t fossil_math_spatial_morton3d(uint32_t x, uint32_t y, uint32_t z) {
+    return _curve_spread3(x & 0x1FFFFFu) | (_curve_spread3(y & 0x1FFFFFu) << 1) |
+           (_curve_spread3(z & 0x1FFFFFu) << 2);
+}
+
+// Branch-free 2D Hilbert index: the quadrant transforms of all levels are
+// combined with a parallel prefix scan over the bits (log2(32) rounds)
+// instead of a loop over the levels.
+uint64_t fossil_math_spatial_hilbert2d(uint32_t x, uint32_t y) {
+    const uint64_t ones = 0xFFFFFFFFu;
+    uint64_t X = x, Y = y;
+    uint64_t a = X ^ Y, b = ones ^ a, c = ones ^ (X | Y), d = X & (Y ^ ones);
+    uint64_t A = a | (b >> 1);
+    uint64_t B = (a >> 1) ^ a;
+    uint64_t C = ((c >> 1) ^ (b & (d >> 1))) ^ c;
+    uint64_t D = ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+    for (unsigned s = 2; s <= 16; s <<= 1) {
+        a = A;
+        b = B;
+        c = C;
+        d = D;
+        A = (a & (a >> s)) ^ (b & (b >> s));
+        B = (a & (b >> s)) ^ (b & ((a ^ b) >> s));
+        C ^= (a & (c >> s)) ^ (b & (d >> s));
+        D ^= (b & (c >> s)) ^ ((a ^ b) & (d >> s));
+    }
+    a = C ^ (C >> 1);
+    b = D ^ (D >> 1);
+    uint64_t i0 = X ^ Y;
+    uint64_t i1 = b | (ones ^ (i0 | a));
+    return (_curve_spread2(i1) << 1) | _curve_spread2(i0);
+}
+
+// 3D Hilbert state machine: the curve inside a cell is one of 24 rotated and
+// reflected copies of the base curve. Entry [state][octant], with the octant
+// taken from a Morton key (x + 2y + 4z), holds the child's 3-bit Hilbert digit
+// in bits 0-2 and the child's state in bits 3-7. The table was derived from
+// Skilling's transpose algorithm ("Programming the Hilbert curve", 2004) and
+// gives the same keys, one lookup per level.
+static const unsigned char CURVE_HILBERT3D[24][8] = {
+    { 48, 167,  11,  36, 177, 126,   2,   5},
+    { 30,  23,  13, 148,  97,  64,  10,   3},
+    {176, 127,  49, 166,  27,  44,  18,  21},
+    { 14,   7, 129, 184,  29,  84,  26,  19},
+    { 16,  41, 147,  34,  71,  62,   4,  37},
+    {  0,  33, 191,  78,  83,  42,  20,  45},
+    { 40, 139,  17,  50,  63, 180,  70,  53},
+    {108,  61,  67,  58, 151,  38, 168,  73},
+    {100,  59,  69,  66, 143, 152,  54, 161},
+    {172,  77,  87,  46, 187,  74, 104,  57},
+    { 94, 113, 183, 120,  85,  82,  28,  43},
+    { 86,  93,  47, 140, 105,  90,  56, 179},
+    { 98, 107, 101,  68,   9, 144, 134, 175},
+    {106, 109,  99,  60,  89, 118, 136, 159},
+    {114,  81, 155,  24, 117, 110, 124, 103},
+    {116,  15, 163, 128, 125,   6, 122, 185},
+    {130, 171,  25,  80, 133, 188, 102, 111},
+    {150, 141, 169, 138,  39,  92,  72,  51},
+    {142, 153, 149, 146,  55, 160,  12,  35},
+    {154, 145, 157, 174, 115,   8, 164, 135},
+    {156,  31, 165,  22, 123,  96, 162,  65},
+    {170, 173, 137, 158, 131,  76,  88, 119},
+    { 32,  91,  79,  52,   1, 178, 190, 181},
+    {132,  75,  95, 112, 189, 186, 182, 121},
+};
+
+// Converts Morton keys to Hilbert keys in place. Four keys walk the state
+// machine side by side so their table lookups overlap.
+static void _curve_hilbert3d_from_morton(uint64_t* keys, size_t n) {
+    size_t i = 0;
+    for (; n - i >= 4; i += 4) {
+        uint64_t m[4] = {keys[i], keys[i + 1], keys[i + 2], keys[i + 3]}, h[4] = {0, 0, 0, 0};
+        unsigned state[4] = {0, 0, 0, 0};
+        for (int level = 20; level >= 0; level--) {
+            for (size_t k = 0; k < 4; k++) {
+                unsigned e = CURVE_HILBERT3D[state[k]][(m[k] >> (3 * level)) & 7];
+                h[k] = (h[k] << 3) | (e & 7);
+                state[k] = e >> 3;
+            }
+        }
+        for (size_t k = 0; k < 4; k++)
+            keys[i + k] = h[k];
+    }
+    for (; i < n; i++) {
+        uint64_t m = keys[i], h = 0;
+        unsigned state = 0;
+        for (int level = 20; level >= 0; level--) {
+            unsigned e = CURVE_HILBERT3D[state][(m >> (3 * level)) & 7];
+            h = (h << 3) | (e & 7);
+            state = e >> 3;
+        }
+        keys[i] = h;
+    }
+}
+
+uint64_t fossil_math_spatial_hilbert3d(uint32_t x, uint32_t y, uint32_t z) {
+    uint64_t key = fossil_math_spatial_morton3d(x, y, z);
+    _curve_hilbert3d_from_morton(&key, 1);
+    return key;
+}
+
+// Keys quantize each coordinate to one of 2^bits cells spanning the box:
+// q = (p - lo) * 2^bits / (hi - lo), clamped to [0, 2^bits - 1], with NaN
+// mapped to cell 0. The interleaved coordinates are quantized a chunk at a
+// time with SIMD, so lane l of vector k covers component (k * SIMD_LANES + l)
+// % dims, and the integer interleave runs per point.
+typedef struct {
+    const double* flat;
+    size_t dims;
+    double lo[3];
+    double scale[3];
+    double top;
+    fossil_math_spatial_curve curve;
+    uint64_t* keys;
+} curve_keys;
+
+static void _curve_keys_range(void* ctx, size_t begin, size_t end) {
+    const curve_keys* job = (const curve_keys*)ctx;
+    size_t dims = job->dims;
+    double q[CURVE_CHUNK * 3];
+    simd_vd lo[3], scale[3];
+    simd_vd zero = simd_set1(0.0), top = simd_set1(job->top);
+    for (size_t k = 0; k < dims; k++) {
+        double l[SIMD_LANES], s[SIMD_LANES];
+        for (size_t j = 0; j < SIMD_LANES; j++) {
+            l[j] = job->lo[(k * SIMD_LANES + j) % dims];
+            s[j] = job->scale[(k * SIMD_LANES + j) % dims];
+        }
+        lo[k] = simd_load(l);
+        scale[k] = simd_load(s);
+    }
+    for (size_t i = begin; i < end; i += CURVE_CHUNK) {
+        size_t len = (end - i < CURVE_CHUNK) ? end - i : CURVE_CHUNK;
+        const double* src = job->flat + i * dims;
+        size_t m = len * dims;
+        for (size_t j = 0, k = 0; j < m; j += SIMD_LANES, k = (k + 1 == dims) ? 0 : k + 1) {
+            size_t left = m - j;
+            simd_vd v = (left >= SIMD_LANES) ? simd_load(src + j) : simd_load_partial(src + j, left, 0.0);
+            v = simd_mul(simd_sub(v, lo[k]), scale[k]);
+            v = simd_select(simd_ge(v, zero), v, zero);
+            v = simd_select(simd_lt(v, top), v, top);
+            if (left >= SIMD_LANES)
+                simd_store(q + j, v);
+            else
+                simd_store_partial(q + j, left, v);
+        }
+        uint64_t* keys = job->keys + i;
+        if (dims == 2 && job->curve == FOSSIL_MATH_SPATIAL_HILBERT) {
+            for (size_t p = 0; p < len; p++)
+                keys[p] = fossil_math_spatial_hilbert2d((uint32_t)q[2 * p], (uint32_t)q[2 * p + 1]);
+        } else if (dims == 2) {
+            for (size_t p = 0; p < len; p++)
+                keys[p] = fossil_math_spatial_morton2d((uint32_t)q[2 * p], (uint32_t)q[2 * p + 1]);
+        } else if (job->curve == FOSSIL_MATH_SPATIAL_HILBERT) {
+            for (size_t p = 0; p < len; p++)
+                keys[p] = fossil_math_spatial_morton3d((uint32_t)q[3 * p], (uint32_t)q[3 * p + 1],
+                                                       (uint32_t)q[3 * p + 2]);
+            _curve_hilbert3d_from_morton(keys, len);
+        } else {
+            for (size_t p = 0; p < len; p++)
+                keys[p] = fossil_math_spatial_morton3d((uint32_t)q[3 * p], (uint32_t)q[3 * p + 1],
+                                                       (uint32_t)q[3 * p + 2]);
+        }
+    }
+}
+
+static void _curve_keys(curve_keys* job, const double* lo, const double* hi, size_t n) {
+    double cells = (job->dims == 2) ? 4294967296.0 : 2097152.0;
+    job->top = cells - 1.0;
+    for (size_t d = 0; d < job->dims; d++) {
+        double extent = hi[d] - lo[d];
+        job->lo[d] = lo[d];
+        // Flat, empty or unbounded axes put every point in cell 0.
+        job->scale[d] = (extent > 0.0 && extent < INFINITY) ? cells / extent : 0.0;
+        if (!(job->scale[d] < INFINITY))
+            job->scale[d] = 0.0;
+    }
+    fossil_math_parallel_for(n, CURVE_GRAIN, _curve_keys_range, job);
+}
+
+void fossil_math_spatial_curve_keys2d(const fossil_math_geom_point2d* points, size_t n, fossil_math_geom_aabb2d box,
+                                      fossil_math_spatial_curve curve, uint64_t* keys) {
+    if (n == 0)
+        return;
+    double lo[2] = {box.lo.x, box.lo.y}, hi[2] = {box.hi.x, box.hi.y};
+    curve_keys job = {&points[0].x, 2, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 0.0, curve, keys};
+    _curve_keys(&job, lo, hi, n);
+}
+
+void fossil_math_spatial_curve_keys3d(const fossil_math_geom_point3d* points, size_t n, fossil_math_geom_aabb3d box,
+                                      fossil_math_spatial_curve curve, uint64_t* keys) {
+    if (n == 0)
+        return;
+    double lo[3] = {box.lo.x, box.lo.y, box.lo.z}, hi[3] = {box.hi.x, box.hi.y, box.hi.z};
+    curve_keys job = {&points[0].x, 3, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 0.0, curve, keys};
+    _curve_keys(&job, lo, hi, n);
+}
+
+// LSD radix sort of (key, index) pairs, one CURVE_RADIX_BITS digit per pass.
+// Each pass is the counting sort of the grid rebuild: every slice counts its
+// digits, a prefix sum over (digit, slice) gives the write positions and
+// every slice scatters in order, so each pass is stable. Keys and indices
+// travel together so a scatter writes one stream per digit rather than two.
+// Packing counts every digit of every slice at once; those counts serve the
+// first pass (and all passes when there is one slice) and show which passes
+// can be skipped because every key has the same digit.
+#define CURVE_PASSES (64 / CURVE_RADIX_BITS)
+
+typedef struct {
+    uint64_t key;
+    size_t index;
+} curve_pair;
+
+typedef struct {
+    size_t n;
+    size_t tasks;
+    unsigned pass;
+    const curve_pair* src;
+    curve_pair* dst;
+    uint64_t* keys;
+    size_t* order;
+    size_t* count;   // tasks blocks of CURVE_PASSES rows of CURVE_RADIX entries
+    size_t* offset;  // tasks rows of CURVE_RADIX entries
+} curve_sort;
+
+static void _curve_slice(const curve_sort* s, size_t j, size_t* lo, size_t* hi) {
+    size_t base = s->n / s->tasks, extra = s->n % s->tasks;
+    *lo = j * base + (j < extra ? j : extra);
+    *hi = *lo + base + (j < extra ? 1 : 0);
+}
+
+static void _curve_pack_slices(void* ctx, size_t begin, size_t end) {
+    const curve_sort* s = (const curve_sort*)ctx;
+    for (size_t j = (begin + CURVE_TASK_SPAN - 1) / CURVE_TASK_SPAN; j < s->tasks && j * CURVE_TASK_SPAN < end; j++) {
+        size_t lo, hi;
+        size_t* count = s->count + j * CURVE_PASSES * CURVE_RADIX;
+        _curve_slice(s, j, &lo, &hi);
+        for (size_t d = 0; d < CURVE_PASSES * CURVE_RADIX; d++)
+            count[d] = 0;
+        for (size_t i = lo; i < hi; i++) {
+            uint64_t key = s->keys[i];
+            s->dst[i].key = key;
+            s->dst[i].index = i;
+            for (size_t p = 0; p < CURVE_PASSES; p++)
+                count[p * CURVE_RADIX + ((key >> (p * CURVE_RADIX_BITS)) & (CURVE_RADIX - 1))]++;
+        }
+    }
+}
+
+static void _curve_count_slices(void* ctx, size_t begin, size_t end) {
+    const curve_sort* s = (const curve_sort*)ctx;
+    unsigned shift = s->pass * CURVE_RADIX_BITS;
+    for (size_t j = (begin + CURVE_TASK_SPAN - 1) / CURVE_TASK_SPAN; j < s->tasks && j * CURVE_TASK_SPAN < end; j++) {
+        size_t lo, hi;
+        size_t* row = s->offset + j * CURVE_RADIX;
+        _curve_slice(s, j, &lo, &hi);
+        for (size_t d = 0; d < CURVE_RADIX; d++)
+            row[d] = 0;
+        for (size_t i = lo; i < hi; i++)
+            row[(s->src[i].key >> shift) & (CURVE_RADIX - 1)]++;
+    }
+}
+
+static void _curve_scatter_slices(void* ctx, size_t begin, size_t end) {
+    const curve_sort* s = (const curve_sort*)ctx;
+    unsigned shift = s->pass * CURVE_RADIX_BITS;
+    for (size_t j = (begin + CURVE_TASK_SPAN - 1) / CURVE_TASK_SPAN; j < s->tasks && j * CURVE_TASK_SPAN < end; j++) {
+        size_t lo, hi;
+        size_t* row = s->offset + j * CURVE_RADIX;
+        _curve_slice(s, j, &lo, &hi);
+        for (size_t i = lo; i < hi; i++)
+            s->dst[row[(s->src[i].key >> shift) & (CURVE_RADIX - 1)]++] = s->src[i];
+    }
+}
+
+static void _curve_unpack_range(void* ctx, size_t begin, size_t end) {
+    const curve_sort* s = (const curve_sort*)ctx;
+    for (size_t i = begin; i < end; i++) {
+        s->keys[i] = s->src[i].key;
+        s->order[i] = s->src[i].index;
+    }
+}
+
+int fossil_math_spatial_radix_sort(uint64_t* keys, size_t* order, size_t n) {
+    if (n == 0)
+        return 0;
+    size_t tasks = fossil_math_get_threads();
+    if (tasks > CURVE_MAX_TASKS)
+        tasks = CURVE_MAX_TASKS;
+    if (n < CURVE_PARALLEL_MIN)
+        tasks = 1;
+    size_t counts = tasks * (CURVE_PASSES + 1) * CURVE_RADIX;
+    if (n > (SIZE_MAX - counts * sizeof(size_t)) / (2 * sizeof(curve_pair)))
+        return -1;
+    curve_pair* pairs = (curve_pair*)malloc(2 * n * sizeof(curve_pair) + counts * sizeof(size_t));
+    if (!pairs)
+        return -1;
+    size_t* count = (size_t*)(pairs + 2 * n);
+    curve_sort s = {n, tasks, 0, pairs, pairs, keys, order, count, count + tasks * CURVE_PASSES * CURVE_RADIX};
+
+    fossil_math_parallel_for(tasks * CURVE_TASK_SPAN, CURVE_TASK_SPAN, _curve_pack_slices, &s);
+    s.dst = pairs + n;
+    int first = 1;
+    for (s.pass = 0; s.pass < CURVE_PASSES; s.pass++) {
+        size_t used = 0;
+        for (size_t d = 0; d < CURVE_RADIX; d++) {
+            size_t total = 0;
+            for (size_t j = 0; j < tasks; j++)
+                total += count[(j * CURVE_PASSES + s.pass) * CURVE_RADIX + d];
+            used += total != 0;
+        }
+        if (used < 2)
+            continue;
+        if (first || tasks == 1) {
+            for (size_t j = 0; j < tasks; j++)
+                memcpy(s.offset + j * CURVE_RADIX, count + (j * CURVE_PASSES + s.pass) * CURVE_RADIX,
+                       CURVE_RADIX * sizeof(size_t));
+        } else {
+            fossil_math_parallel_for(tasks * CURVE_TASK_SPAN, CURVE_TASK_SPAN, _curve_count_slices, &s);
+        }
+        first = 0;
+        size_t pos = 0;
+        for (size_t d = 0; d < CURVE_RADIX; d++) {
+            for (size_t j = 0; j < tasks; j++) {
+                size_t c = s.offset[j * CURVE_RADIX + d];
+                s.offset[j * CURVE_RADIX + d] = pos;
+                pos += c;
+            }
+        }
+        fossil_math_parallel_for(tasks * CURVE_TASK_SPAN, CURVE_TASK_SPAN, _curve_scatter_slices, &s);
+        curve_pair* t = (curve_pair*)s.src;
+        s.src = s.dst;
+        s.dst = t;
+    }
+    fossil_math_parallel_for(n, CURVE_GRAIN, _curve_unpack_range, &s);
+    free(pairs);
+    return 0;
+}
+
+typedef struct {
+    const unsigned char* src;
+    size_t size;
+    const size_t* order;
+    unsigned char* dst;
+} curve_gather;
+
+static void _curve_gather_range(void* ctx, size_t begin, size_t end) {
+    const curve_gather* job = (const curve_gather*)ctx;
+    size_t size = job->size;
+    // Constant sizes let memcpy become plain loads and stores.
+    switch (size) {
+    case 8:
+        for (size_t i = begin; i < end; i++)
+            memcpy(job->dst + i * 8, job->src + job->order[i] * 8, 8);
+        break;
+    case 16:
+        for (size_t i = begin; i < end; i++)
+            memcpy(job->dst + i * 16, job->src + job->order[i] * 16, 16);
+        break;
+    case 24:
+        for (size_t i = begin; i < end; i++)
+            memcpy(job->dst + i * 24, job->src + job->order[i] * 24, 24);
+        break;
+    default:
+        for (size_t i = begin; i < end; i++)
+            memcpy(job->dst + i * size, job->src + job->order[i] * size, size);
+        break;
+    }
+}
+
+void fossil_math_spatial_gather(const void* src, size_t size, const size_t* order, size_t n, void* dst) {
+    curve_gather job = {(const unsigned char*)src, size, order, (unsigned char*)dst};
+    fossil_math_parallel_for(n, CURVE_GRAIN, _curve_gather_range, &job);
+}
+
+// Sorts points in place along a curve; order may be NULL. One block holds the
+// keys, the order if the caller passed none, and a copy of the points.
+static int _curve_sort(void* points, size_t size, size_t n, size_t dims, fossil_math_spatial_curve curve,
+                       size_t* order) {
+    if (n == 0)
+        return 0;
+    size_t per = sizeof(uint64_t) + (order ? 0 : sizeof(size_t)) + size;
+    if (n > SIZE_MAX / per)
+        return -1;
+    unsigned char* block = (unsigned char*)malloc(n * per);
+    if (!block)
+        return -1;
+    uint64_t* keys = (uint64_t*)block;
+    size_t* index = order ? order : (size_t*)(block + n * sizeof(uint64_t));
+    unsigned char* copy = block + n * (per - size);
+    if (dims == 2) {
+        const fossil_math_geom_point2d* p = (const fossil_math_geom_point2d*)points;
+        fossil_math_spatial_curve_keys2d(p, n, fossil_math_geom_aabb2d_from_points(p, n), curve, keys);
+    } else {
+        const fossil_math_geom_point3d* p = (const fossil_math_geom_point3d*)points;
+        fossil_math_spatial_curve_keys3d(p, n, fossil_math_geom_aabb3d_from_points(p, n), curve, keys);
+    }
+    // The top 32 key bits already resolve 65536^2 (2D) or about 1600^3 (3D)
+    // cells; dropping the rest lets the sort skip half of its passes.
+    for (size_t i = 0; i < n; i++)
+        keys[i] &= ~(uint64_t)0xFFFFFFFFu;
+    if (fossil_math_spatial_radix_sort(keys, index, n) != 0) {
+        free(block);
+        return -1;
+    }
+    memcpy(copy, points, n * size);
+    fossil_math_spatial_gather(copy, size, index, n, points);
+    free(block);
+    return 0;
+}
+
+int fossil_math_spatial_curve_sort2d(fossil_math_geom_point2d* points, size_t n, fossil_math_spatial_curve curve,
+                                     size_t* order) {
+    return _curve_sort(points, sizeof(fossil_math_geom_point2d), n, 2, curve, order);
+}
+
+int fossil_math_spatial_curve_sort3d(fossil_math_geom_point3d* points, size_t n, fossil_math_spatial_curve curve,
+                                     size_t* order) {
+    return _curve_sort(points, sizeof(fossil_math_geom_point3d), n, 3, curve, order);
+}
@@ -23,8 +23,12 @@
  * -----------------------------------------------------------------------------
  */
 #include "fossil/math/trig.h"
+#include "simd.h"
 #include <math.h>
 
+// Tier used by the functions without an _ex suffix.
+static fossil_math_trig_accuracy trig_accuracy = FOSSIL_MATH_TRIG_PRECISE;
+
 // ======================================================
 // Conversion
 // ======================================================
@@ -39,16 +43,35 @@ double fossil_math_trig_rad_to_deg(double radians) {
 // ======================================================
 // Basic trig
 // ======================================================
-double fossil_math_trig_sin(double x) { return sin(x); }
-double fossil_math_trig_cos(double x) { return cos(x); }
-double fossil_math_trig_tan(double x) { return tan(x); }
+double fossil_math_trig_sin(double x) { return fossil_math_trig_sin_ex(x, trig_accuracy); }
+double fossil_math_trig_cos(double x) { return fossil_math_trig_cos_ex(x, trig_accuracy); }
+double fossil_math_trig_tan(double x) { return fossil_math_trig_tan_ex(x, trig_accuracy); }
+
+void fossil_math_trig_sincos(double x, double* s, double* c) {
+    fossil_math_trig_sincos_ex(x, s, c, trig_accuracy);
+}
 
 // Inverse
-double fossil_math_trig_asin(double x) { return asin(x); }
-double fossil_math_trig_acos(double x) { return acos(x); }
-double fossil_math_trig_atan(double x) { return atan(x); }
+double fossil_math_trig_asin(double x) { return fossil_math_trig_asin_ex(x, trig_accuracy); }
+double fossil_math_trig_acos(double x) { return fossil_math_trig_acos_ex(x, trig_accuracy); }
+double fossil_math_trig_atan(double x) { return fossil_math_trig_atan_ex(x, trig_accuracy); }
 double fossil_math_trig_atan2(double y, double x) { return atan2(y, x); }
 
+// ======================================================
+// Accuracy tiers
+// ======================================================
+int fossil_math_trig_set_accuracy(fossil_math_trig_accuracy accuracy) {
+    if (accuracy != FOSSIL_MATH_TRIG_PRECISE && accuracy != FOSSIL_MATH_TRIG_BALANCED &&
+        accuracy != FOSSIL_MATH_TRIG_FAST)
+        return -1;
+    trig_accuracy = accuracy;
+    return 0;
+}
+
+fossil_math_trig_accuracy fossil_math_trig_get_accuracy(void) {
+    return trig_accuracy;
+}
+
 // ======================================================
 // Hyperbolic
 // ======================================================
@@ -60,3 +83,1401 @@ double fossil_math_trig_tanh(double x) { return tanh(x); }
 double fossil_math_trig_asinh(double x) { return asinh(x); }
 double fossil_math_trig_acosh(double x) { return acosh(x); }
 double fossil_math_trig_atanh(double x) { return atanh(x); }
+
+// ======================================================
+// Array kernels
+// ======================================================
+//
+// The vector kernels are adapted from the FreeBSD msun (fdlibm) sources,
+// which carry the following notice:
+//
+//   Copyright (C) 1993 by Sun Microsystems, Inc. All rights reserved.
+//
+//   Developed at SunPro, a Sun Microsystems, Inc. business.
+//   Permission to use, copy, modify, and distribute this
+//   software is freely granted, provided that this notice
+//   is preserved.
+//
+// Branches on the argument are replaced with lane selects so all lanes run
+// the same instructions. Arguments outside the medium-size reduction range
+// (and inf/NaN) are recomputed with libm.
+
+// Largest |x| handled by the three-step Cody-Waite reduction (about 2^19 * pi/2).
+#define TRIG_REDUCE_MAX 823549.0
+
+#define TRIG_EXP_MASK  0x7ff0000000000000ULL
+#define TRIG_HIGH_WORD 0xffffffff00000000ULL
+
+static const double
+invpio2 =  6.36619772367581382433e-01,
+pio2_1  =  1.57079632673412561417e+00,
+pio2_1t =  6.07710050650619224932e-11,
+pio2_2  =  6.07710050630396597660e-11,
+pio2_2t =  2.02226624879595063154e-21,
+pio2_3  =  2.02226624871116645580e-21,
+pio2_3t =  8.47842766036889956997e-32;
+
+static const double
+S1 = -1.66666666666666324348e-01,
+S2 =  8.33333333332248946124e-03,
+S3 = -1.98412698298579493134e-04,
+S4 =  2.75573137070700676789e-06,
+S5 = -2.50507602534068634195e-08,
+S6 =  1.58969099521155010221e-10;
+
+static const double
+C1 =  4.16666666666666019037e-02,
+C2 = -1.38888888888741095749e-03,
+C3 =  2.48015872894767294178e-05,
+C4 = -2.75573143513906633035e-07,
+C5 =  2.08757232129817482790e-09,
+C6 = -1.13596475577881948265e-11;
+
+static const double T[] = {
+     3.33333333333334091986e-01,
+     1.33333333333201242699e-01,
+     5.39682539762260521377e-02,
+     2.18694882948595424599e-02,
+     8.86323982359930005737e-03,
+     3.59207910759131235356e-03,
+     1.45620945432529025516e-03,
+     5.88041240820264096874e-04,
+     2.46463134818469906812e-04,
+     7.81794442939557092300e-05,
+     7.14072491382608190305e-05,
+    -1.85586374855275456654e-05,
+     2.59073051863633712884e-05,
+};
+
+static const double
+pio4   = 7.85398163397448278999e-01,
+pio4lo = 3.06161699786838301793e-17;
+
+static const double atanhi[] = {
+    4.63647609000806093515e-01,
+    7.85398163397448278999e-01,
+    9.82793723247329054082e-01,
+    1.57079632679489655800e+00,
+};
+
+static const double atanlo[] = {
+    2.26987774529616870924e-17,
+    3.06161699786838301793e-17,
+    1.39033110312309984516e-17,
+    6.12323399573676603587e-17,
+};
+
+static const double aT[] = {
+     3.33333333333329318027e-01,
+    -1.99999999998764832476e-01,
+     1.42857142725034663711e-01,
+    -1.11111104054623557880e-01,
+     9.09088713343650656196e-02,
+    -7.69187620504482999495e-02,
+     6.66107313738753120669e-02,
+    -5.83357013379057348645e-02,
+     4.97687799461593236017e-02,
+    -3.65315727442169155270e-02,
+     1.62858201153657823623e-02,
+};
+
+static const double
+pio2_hi =  1.57079632679489655800e+00,
+pio2_lo =  6.12323399573676603587e-17,
+pio4_hi =  7.85398163397448278999e-01,
+pi_hi   =  3.14159265358979311600e+00,
+pS0 =  1.66666666666666657415e-01,
+pS1 = -3.25565818622400915405e-01,
+pS2 =  2.01212532134862925881e-01,
+pS3 = -4.00555345006794114027e-02,
+pS4 =  7.91534994289814532176e-04,
+pS5 =  3.47933107596021167570e-05,
+qS1 = -2.40339491173441421878e+00,
+qS2 =  2.02094576023350569471e+00,
+qS3 = -6.88283971605453293030e-01,
+qS4 =  7.70381505559019352791e-02;
+
+static inline simd_vd _splat(double x) { return simd_set1(x); }
+
+static inline simd_vd _flip_sign(simd_vd v, simd_vd mask) {
+    return simd_xor(v, simd_and(mask, simd_sign_mask()));
+}
+
+// Lanes holding an odd integer.
+static inline simd_vd _odd(simd_vd n) {
+    simd_vd h = simd_mul(n, _splat(0.5));
+    return simd_neq(h, simd_round(h));
+}
+
+// floor(n / 2) for integer n.
+static inline simd_vd _half_floor(simd_vd n) {
+    return simd_round(simd_sub(simd_mul(n, _splat(0.5)), _splat(0.25)));
+}
+
+// x = fn * pi/2 + (y + *tail) with |y| <= pi/4; the second and third steps
+// only run when some lane lost too many bits to cancellation.
+static inline simd_vd _reduce(simd_vd x, simd_vd* tail, simd_vd* fn) {
+    simd_vd n = simd_round(simd_mul(x, _splat(invpio2)));
+    simd_vd xpow = simd_and(x, simd_const_bits(TRIG_EXP_MASK));
+
+    simd_vd r = simd_sub(x, simd_mul(n, _splat(pio2_1)));
+    simd_vd w = simd_mul(n, _splat(pio2_1t));
+    simd_vd y = simd_sub(r, w);
+
+    // More than 16 (then 49) bits cancelled: y < 2^-16 (2^-49) of x's binade.
+    simd_vd need2 = simd_lt(simd_abs(y), simd_mul(xpow, _splat(1.52587890625e-05)));
+    if (simd_any(need2)) {
+        simd_vd p = simd_mul(n, _splat(pio2_2));
+        simd_vd r2 = simd_sub(r, p);
+        simd_vd w2 = simd_sub(simd_mul(n, _splat(pio2_2t)), simd_sub(simd_sub(r, r2), p));
+        simd_vd y2 = simd_sub(r2, w2);
+
+        simd_vd need3 = simd_and(need2, simd_lt(simd_abs(y2), simd_mul(xpow, _splat(1.7763568394002505e-15))));
+        if (simd_any(need3)) {
+            p = simd_mul(n, _splat(pio2_3));
+            simd_vd r3 = simd_sub(r2, p);
+            simd_vd w3 = simd_sub(simd_mul(n, _splat(pio2_3t)), simd_sub(simd_sub(r2, r3), p));
+            simd_vd y3 = simd_sub(r3, w3);
+            r2 = simd_select(need3, r3, r2);
+            w2 = simd_select(need3, w3, w2);
+            y2 = simd_select(need3, y3, y2);
+        }
+        r = simd_select(need2, r2, r);
+        w = simd_select(need2, w2, w);
+        y = simd_select(need2, y2, y);
+    }
+    *tail = simd_sub(simd_sub(r, y), w);
+    *fn = n;
+    return y;
+}
+
+static inline simd_vd _kernel_sin(simd_vd x, simd_vd y) {
+    simd_vd z = simd_mul(x, x);
+    simd_vd w = simd_mul(z, z);
+    simd_vd r = simd_add(simd_add(_splat(S2), simd_mul(z, simd_add(_splat(S3), simd_mul(z, _splat(S4))))),
+                         simd_mul(simd_mul(z, w), simd_add(_splat(S5), simd_mul(z, _splat(S6)))));
+    simd_vd v = simd_mul(z, x);
+    simd_vd t = simd_sub(simd_mul(z, simd_sub(simd_mul(_splat(0.5), y), simd_mul(v, r))), y);
+    return simd_sub(x, simd_sub(t, simd_mul(v, _splat(S1))));
+}
+
+static inline simd_vd _kernel_cos(simd_vd x, simd_vd y) {
+    simd_vd z = simd_mul(x, x);
+    simd_vd w = simd_mul(z, z);
+    simd_vd r = simd_add(
+        simd_mul(z, simd_add(_splat(C1), simd_mul(z, simd_add(_splat(C2), simd_mul(z, _splat(C3)))))),
+        simd_mul(simd_mul(w, w), simd_add(_splat(C4), simd_mul(z, simd_add(_splat(C5), simd_mul(z, _splat(C6)))))));
+    simd_vd hz = simd_mul(_splat(0.5), z);
+    w = simd_sub(_splat(1.0), hz);
+    return simd_add(w, simd_add(simd_sub(simd_sub(_splat(1.0), w), hz),
+                                simd_sub(simd_mul(z, r), simd_mul(x, y))));
+}
+
+// Lanes with |x| < 2^-27, where sin, tan, asin and atan round to x. The
+// kernels run on zero for them instead so no subnormal intermediates appear.
+static inline simd_vd _tiny(simd_vd x) {
+    return simd_lt(simd_abs(x), _splat(7.450580596923828125e-09));
+}
+
+static inline void _vsincos(simd_vd x, simd_vd* s, simd_vd* c) {
+    simd_vd tiny = _tiny(x);
+    simd_vd tail, n;
+    simd_vd y = _reduce(simd_andnot(x, tiny), &tail, &n);
+    simd_vd ks = _kernel_sin(y, tail);
+    simd_vd kc = _kernel_cos(y, tail);
+    simd_vd odd = _odd(n);
+    *s = simd_select(tiny, x, _flip_sign(simd_select(odd, kc, ks), _odd(_half_floor(n))));
+    *c = _flip_sign(simd_select(odd, ks, kc), _odd(_half_floor(simd_add(n, _splat(1.0)))));
+}
+
+static inline simd_vd _vsin(simd_vd x) {
+    simd_vd s, c;
+    _vsincos(x, &s, &c);
+    return s;
+}
+
+static inline simd_vd _vcos(simd_vd x) {
+    simd_vd s, c;
+    _vsincos(x, &s, &c);
+    return c;
+}
+
+// tan(y + tail) for |y| <= pi/4, or -1/tan when odd is set. One division
+// serves both the |y| >= 0.6744 path and the -1/w path.
+static inline simd_vd _kernel_tan(simd_vd x, simd_vd y, simd_vd odd) {
+    simd_vd sign = simd_sign(x);
+    simd_vd big = simd_le(_splat(0.6744), simd_abs(x));
+    simd_vd xb = simd_add(simd_sub(_splat(pio4), simd_abs(x)), simd_sub(_splat(pio4lo), simd_xor(y, sign)));
+    x = simd_select(big, xb, x);
+    y = simd_andnot(y, big);
+
+    simd_vd z = simd_mul(x, x);
+    simd_vd w = simd_mul(z, z);
+    simd_vd r = simd_add(_splat(T[1]), simd_mul(w, simd_add(_splat(T[3]), simd_mul(w, simd_add(_splat(T[5]),
+                simd_mul(w, simd_add(_splat(T[7]), simd_mul(w, simd_add(_splat(T[9]), simd_mul(w, _splat(T[11])))))))))));
+    simd_vd v = simd_mul(z, simd_add(_splat(T[2]), simd_mul(w, simd_add(_splat(T[4]), simd_mul(w, simd_add(_splat(T[6]),
+                simd_mul(w, simd_add(_splat(T[8]), simd_mul(w, simd_add(_splat(T[10]), simd_mul(w, _splat(T[12]))))))))))));
+    simd_vd s = simd_mul(z, x);
+    r = simd_add(y, simd_mul(z, simd_add(simd_mul(s, simd_add(r, v)), y)));
+    r = simd_add(r, simd_mul(_splat(T[0]), s));
+    w = simd_add(x, r);
+
+    simd_vd iy = simd_select(odd, _splat(-1.0), _splat(1.0));
+    simd_vd q = simd_div(simd_select(big, simd_mul(w, w), _splat(-1.0)),
+                         simd_select(big, simd_add(w, iy), w));
+
+    simd_vd rbig = simd_sub(iy, simd_mul(_splat(2.0), simd_sub(x, simd_sub(q, r))));
+    rbig = simd_xor(rbig, sign);
+
+    simd_vd high = simd_const_bits(TRIG_HIGH_WORD);
+    simd_vd zh = simd_and(w, high);
+    simd_vd vv = simd_sub(r, simd_sub(zh, x));
+    simd_vd t = simd_and(q, high);
+    simd_vd s2 = simd_add(_splat(1.0), simd_mul(t, zh));
+    simd_vd rodd = simd_add(t, simd_mul(q, simd_add(s2, simd_mul(t, vv))));
+    return simd_select(big, rbig, simd_select(odd, rodd, w));
+}
+
+static inline simd_vd _vtan(simd_vd x) {
+    simd_vd tiny = _tiny(x);
+    simd_vd tail, n;
+    simd_vd y = _reduce(simd_andnot(x, tiny), &tail, &n);
+    return simd_select(tiny, x, _kernel_tan(y, tail, _odd(n)));
+}
+
+// atan(hi + lo) + atan(t) for a reduced argument t.
+static inline simd_vd _atan_poly(simd_vd t, simd_vd hi, simd_vd lo) {
+    simd_vd z = simd_mul(t, t);
+    simd_vd w = simd_mul(z, z);
+    simd_vd s1 = simd_mul(z, simd_add(_splat(aT[0]), simd_mul(w, simd_add(_splat(aT[2]), simd_mul(w, simd_add(_splat(aT[4]),
+                 simd_mul(w, simd_add(_splat(aT[6]), simd_mul(w, simd_add(_splat(aT[8]), simd_mul(w, _splat(aT[10]))))))))))));
+    simd_vd s2 = simd_mul(w, simd_add(_splat(aT[1]), simd_mul(w, simd_add(_splat(aT[3]), simd_mul(w, simd_add(_splat(aT[5]),
+                 simd_mul(w, simd_add(_splat(aT[7]), simd_mul(w, _splat(aT[9]))))))))));
+    return simd_sub(hi, simd_sub(simd_sub(simd_mul(t, simd_add(s1, s2)), lo), t));
+}
+
+static inline simd_vd _vatan(simd_vd x) {
+    simd_vd sign = simd_sign(x);
+    simd_vd tiny = _tiny(x);
+    // Beyond 2^66 the result rounds to pi/2.
+    simd_vd huge = simd_le(_splat(7.3786976294838206464e+19), simd_abs(x));
+    simd_vd ax = simd_andnot(simd_abs(x), simd_or(tiny, huge));
+    simd_vd m0 = simd_le(_splat(0.4375), ax);
+    simd_vd m1 = simd_le(_splat(0.6875), ax);
+    simd_vd m2 = simd_le(_splat(1.1875), ax);
+    simd_vd m3 = simd_le(_splat(2.4375), ax);
+
+    simd_vd num = simd_select(m3, _splat(-1.0),
+                  simd_select(m2, simd_sub(ax, _splat(1.5)),
+                  simd_select(m1, simd_sub(ax, _splat(1.0)),
+                  simd_select(m0, simd_sub(simd_mul(_splat(2.0), ax), _splat(1.0)), ax))));
+    simd_vd den = simd_select(m3, ax,
+                  simd_select(m2, simd_add(_splat(1.0), simd_mul(_splat(1.5), ax)),
+                  simd_select(m1, simd_add(ax, _splat(1.0)),
+                  simd_select(m0, simd_add(_splat(2.0), ax), _splat(1.0)))));
+    simd_vd hi = simd_select(m3, _splat(atanhi[3]), simd_select(m2, _splat(atanhi[2]),
+                 simd_select(m1, _splat(atanhi[1]), simd_select(m0, _splat(atanhi[0]), _splat(0.0)))));
+    simd_vd lo = simd_select(m3, _splat(atanlo[3]), simd_select(m2, _splat(atanlo[2]),
+                 simd_select(m1, _splat(atanlo[1]), simd_select(m0, _splat(atanlo[0]), _splat(0.0)))));
+
+    simd_vd r = _atan_poly(simd_div(num, den), hi, lo);
+    r = simd_select(huge, _splat(atanhi[3] + atanlo[3]), r);
+    return simd_select(tiny, x, simd_xor(r, sign));
+}
+
+// Rational approximation of (asin(sqrt(t)) - sqrt(t)) / sqrt(t)^3.
+static inline simd_vd _asin_r(simd_vd t) {
+    simd_vd p = simd_mul(t, simd_add(_splat(pS0), simd_mul(t, simd_add(_splat(pS1), simd_mul(t, simd_add(_splat(pS2),
+                simd_mul(t, simd_add(_splat(pS3), simd_mul(t, simd_add(_splat(pS4), simd_mul(t, _splat(pS5))))))))))));
+    simd_vd q = simd_add(_splat(1.0), simd_mul(t, simd_add(_splat(qS1), simd_mul(t, simd_add(_splat(qS2),
+                simd_mul(t, simd_add(_splat(qS3), simd_mul(t, _splat(qS4)))))))));
+    return simd_div(p, q);
+}
+
+static inline simd_vd _vasin(simd_vd x0) {
+    simd_vd tiny = _tiny(x0);
+    simd_vd x = simd_andnot(x0, tiny);
+    simd_vd sign = simd_sign(x);
+    simd_vd ax = simd_abs(x);
+    simd_vd small = simd_lt(ax, _splat(0.5));
+
+    if (simd_all(small)) {
+        simd_vd r = _asin_r(simd_mul(x, x));
+        return simd_select(tiny, x0, simd_xor(simd_add(ax, simd_mul(ax, r)), sign));
+    }
+
+    simd_vd near1 = simd_le(_splat(0.975), ax);
+    simd_vd t = simd_select(small, simd_mul(x, x), simd_mul(simd_sub(_splat(1.0), ax), _splat(0.5)));
+    simd_vd r = _asin_r(t);
+    simd_vd s = simd_sqrt(t);
+    simd_vd rsmall = simd_add(ax, simd_mul(ax, r));
+    simd_vd rnear = simd_sub(_splat(pio2_hi),
+                             simd_sub(simd_mul(_splat(2.0), simd_add(s, simd_mul(s, r))), _splat(pio2_lo)));
+    simd_vd f = simd_and(s, simd_const_bits(TRIG_HIGH_WORD));
+    simd_vd c = simd_div(simd_sub(t, simd_mul(f, f)), simd_add(s, f));
+    simd_vd rmid = simd_sub(_splat(pio4_hi),
+                            simd_sub(simd_sub(simd_mul(simd_mul(_splat(2.0), s), r),
+                                              simd_sub(_splat(pio2_lo), simd_mul(_splat(2.0), c))),
+                                     simd_sub(_splat(pio4_hi), simd_mul(_splat(2.0), f))));
+    simd_vd res = simd_select(small, rsmall, simd_select(near1, rnear, rmid));
+    return simd_select(tiny, x0, simd_xor(res, sign));
+}
+
+static inline simd_vd _vacos(simd_vd x0) {
+    // acos(x) rounds to pi/2 - x for tiny x.
+    simd_vd tiny = _tiny(x0);
+    simd_vd rtiny = simd_sub(_splat(pio2_hi), simd_sub(x0, _splat(pio2_lo)));
+    simd_vd x = simd_andnot(x0, tiny);
+    simd_vd ax = simd_abs(x);
+    simd_vd small = simd_lt(ax, _splat(0.5));
+
+    if (simd_all(small)) {
+        simd_vd r = _asin_r(simd_mul(x, x));
+        return simd_select(tiny, rtiny,
+                           simd_sub(_splat(pio2_hi), simd_sub(x, simd_sub(_splat(pio2_lo), simd_mul(x, r)))));
+    }
+
+    simd_vd neg = simd_lt(x, _splat(0.0));
+    simd_vd z = simd_select(small, simd_mul(x, x), simd_mul(simd_sub(_splat(1.0), ax), _splat(0.5)));
+    simd_vd r = _asin_r(z);
+    simd_vd s = simd_sqrt(z);
+    simd_vd rsmall = simd_sub(_splat(pio2_hi), simd_sub(x, simd_sub(_splat(pio2_lo), simd_mul(x, r))));
+    simd_vd rneg = simd_sub(_splat(pi_hi),
+                            simd_mul(_splat(2.0), simd_add(s, simd_sub(simd_mul(r, s), _splat(pio2_lo)))));
+    simd_vd df = simd_and(s, simd_const_bits(TRIG_HIGH_WORD));
+    simd_vd c = simd_div(simd_sub(z, simd_mul(df, df)), simd_add(s, df));
+    simd_vd rpos = simd_mul(_splat(2.0), simd_add(df, simd_add(simd_mul(r, s), c)));
+    rpos = simd_select(simd_eq(x, _splat(1.0)), _splat(0.0), rpos);
+    return simd_select(tiny, rtiny, simd_select(small, rsmall, simd_select(neg, rneg, rpos)));
+}
+
+// ======================================================
+// Balanced and fast kernels
+// ======================================================
+//
+// Both tiers reduce with three-part pi/2 and drop the reduction tail. sin
+// and cos reduce by pi (cos by an odd multiple of pi/2) so one odd
+// polynomial on [-pi/2, pi/2] serves every lane. The balanced tier keeps
+// minimax relative error near 1e-17 before rounding; the fast tier uses
+// shorter minimax fits for absolute error.
+
+// Minimax sin(r) = r + r^3 * P(r^2) on [-pi/2, pi/2], relative error 3.5e-17.
+static const double SB[] = {
+    -1.66666666666666796e-01,
+     8.33333333333381894e-03,
+    -1.98412698413183674e-04,
+     2.75573192198990729e-06,
+    -2.50521071458447725e-08,
+     1.60589358975717114e-10,
+    -7.64256235115639329e-13,
+     2.71397838597441861e-15,
+};
+
+// Minimax sin(r) on [-pi/2, pi/2], absolute error 4.7e-9.
+static const double SF[] = {
+    -1.66666570965047028e-01,
+     8.33301729156221867e-03,
+    -1.98066152013508468e-04,
+     2.60005476789044701e-06,
+};
+
+// Minimax sin(r) and cos(r) on [-pi/4, pi/4], relative error 3.8e-9 and 6.4e-11.
+static const double SQF[] = {
+    -1.66666546095511320e-01,
+     8.33216076198707578e-03,
+    -1.95152832065955393e-04,
+};
+
+static const double CQF[] = {
+    -4.99999996944763658e-01,
+     4.16666203571651739e-02,
+    -1.38866816488800973e-03,
+     2.43835673848139199e-05,
+};
+
+// Minimax asin(s) = s + s^3 * P(s^2) on [0, 0.5], absolute error 1.6e-9.
+static const double ASF[] = {
+    1.66668215289325516e-01,
+    7.49307720949857203e-02,
+    4.57077844670152542e-02,
+    2.31422980588855305e-02,
+    4.37630200353669382e-02,
+};
+
+// Minimax atan(t) = t + t^3 * P(t^2) on [0, tan(pi/8)], absolute error 5e-9.
+static const double ATF[] = {
+    -3.33327566681780763e-01,
+     1.99718792804458978e-01,
+    -1.38244535373077931e-01,
+     7.90259758030337073e-02,
+};
+
+static inline simd_vd _horner(simd_vd z, const double* c, size_t n) {
+    simd_vd acc = _splat(c[n - 1]);
+    for (size_t i = n - 1; i-- > 0;)
+        acc = simd_add(simd_mul(acc, z), _splat(c[i]));
+    return acc;
+}
+
+// r + r^3 * P(r^2).
+static inline simd_vd _odd_poly(simd_vd r, const double* c, size_t n) {
+    simd_vd z = simd_mul(r, r);
+    return simd_add(r, simd_mul(simd_mul(r, z), _horner(z, c, n)));
+}
+
+// x - q * pi/2 for integral |q| < 2^20; q * pio2_1 and q * pio2_2 are exact.
+static inline simd_vd _sub_pio2(simd_vd x, simd_vd q) {
+    simd_vd r = simd_sub(x, simd_mul(q, _splat(pio2_1)));
+    r = simd_sub(r, simd_mul(q, _splat(pio2_2)));
+    return simd_sub(r, simd_mul(q, _splat(pio2_2t)));
+}
+
+static inline simd_vd _vsin_tier(simd_vd x, const double* c, size_t n) {
+    simd_vd tiny = _tiny(x);
+    simd_vd xk = simd_andnot(x, tiny);
+    simd_vd k = simd_round(simd_mul(xk, _splat(0.5 * invpio2)));
+    simd_vd r = _sub_pio2(xk, simd_add(k, k));
+    return simd_select(tiny, x, _flip_sign(_odd_poly(r, c, n), _odd(k)));
+}
+
+// cos(x) = -sin(x - (2k+1) pi/2) for even k, +sin(...) for odd k.
+static inline simd_vd _vcos_tier(simd_vd x, const double* c, size_t n) {
+    simd_vd k = simd_round(simd_sub(simd_mul(x, _splat(0.5 * invpio2)), _splat(0.5)));
+    simd_vd r = _sub_pio2(x, simd_add(simd_add(k, k), _splat(1.0)));
+    simd_vd even = simd_andnot(simd_eq(k, k), _odd(k));
+    return _flip_sign(_odd_poly(r, c, n), even);
+}
+
+static inline simd_vd _vsin_balanced(simd_vd x) { return _vsin_tier(x, SB, 8); }
+static inline simd_vd _vcos_balanced(simd_vd x) { return _vcos_tier(x, SB, 8); }
+static inline simd_vd _vsin_fast(simd_vd x) { return _vsin_tier(x, SF, 4); }
+static inline simd_vd _vcos_fast(simd_vd x) { return _vcos_tier(x, SF, 4); }
+
+// Quarter-period sin and cos without the reduction tail; the balanced tier
+// reuses the precise fdlibm polynomials, the fast tier the short fits.
+static inline void _quarter_sincos(simd_vd y, int fast, simd_vd* ks, simd_vd* kc) {
+    if (fast) {
+        simd_vd z = simd_mul(y, y);
+        *ks = _odd_poly(y, SQF, 3);
+        *kc = simd_add(_splat(1.0), simd_mul(z, _horner(z, CQF, 4)));
+    } else {
+        *ks = _kernel_sin(y, _splat(0.0));
+        *kc = _kernel_cos(y, _splat(0.0));
+    }
+}
+
+static inline void _vsincos_tier(simd_vd x, int fast, simd_vd* s, simd_vd* c) {
+    simd_vd tiny = _tiny(x);
+    simd_vd xk = simd_andnot(x, tiny);
+    simd_vd q = simd_round(simd_mul(xk, _splat(invpio2)));
+    simd_vd ks, kc;
+    _quarter_sincos(_sub_pio2(xk, q), fast, &ks, &kc);
+    simd_vd odd = _odd(q);
+    *s = simd_select(tiny, x, _flip_sign(simd_select(odd, kc, ks), _odd(_half_floor(q))));
+    *c = _flip_sign(simd_select(odd, ks, kc), _odd(_half_floor(simd_add(q, _splat(1.0)))));
+}
+
+static inline void _vsincos_balanced(simd_vd x, simd_vd* s, simd_vd* c) { _vsincos_tier(x, 0, s, c); }
+static inline void _vsincos_fast(simd_vd x, simd_vd* s, simd_vd* c) { _vsincos_tier(x, 1, s, c); }
+
+// tan = sin / cos, or -cos / sin in odd quadrants, with a single division.
+static inline simd_vd _vtan_tier(simd_vd x, int fast) {
+    simd_vd tiny = _tiny(x);
+    simd_vd xk = simd_andnot(x, tiny);
+    simd_vd q = simd_round(simd_mul(xk, _splat(invpio2)));
+    simd_vd ks, kc;
+    _quarter_sincos(_sub_pio2(xk, q), fast, &ks, &kc);
+    simd_vd odd = _odd(q);
+    simd_vd t = simd_div(simd_select(odd, simd_xor(kc, simd_sign_mask()), ks), simd_select(odd, ks, kc));
+    return simd_select(tiny, x, t);
+}
+
+static inline simd_vd _vtan_balanced(simd_vd x) { return _vtan_tier(x, 0); }
+static inline simd_vd _vtan_fast(simd_vd x) { return _vtan_tier(x, 1); }
+
+// fdlibm asin/acos without the extra division that recovers the low bits
+// of sqrt in the upper range.
+static inline simd_vd _vasin_balanced(simd_vd x0) {
+    simd_vd tiny = _tiny(x0);
+    simd_vd x = simd_andnot(x0, tiny);
+    simd_vd sign = simd_sign(x);
+    simd_vd ax = simd_abs(x);
+    simd_vd small = simd_lt(ax, _splat(0.5));
+    simd_vd t = simd_select(small, simd_mul(x, x), simd_mul(simd_sub(_splat(1.0), ax), _splat(0.5)));
+    simd_vd r = _asin_r(t);
+    simd_vd s = simd_sqrt(t);
+    simd_vd rsmall = simd_add(ax, simd_mul(ax, r));
+    simd_vd rbig = simd_sub(_splat(pio2_hi),
+                            simd_sub(simd_mul(_splat(2.0), simd_add(s, simd_mul(s, r))), _splat(pio2_lo)));
+    return simd_select(tiny, x0, simd_xor(simd_select(small, rsmall, rbig), sign));
+}
+
+static inline simd_vd _vacos_balanced(simd_vd x0) {
+    simd_vd tiny = _tiny(x0);
+    simd_vd rtiny = simd_sub(_splat(pio2_hi), simd_sub(x0, _splat(pio2_lo)));
+    simd_vd x = simd_andnot(x0, tiny);
+    simd_vd ax = simd_abs(x);
+    simd_vd small = simd_lt(ax, _splat(0.5));
+    simd_vd neg = simd_lt(x, _splat(0.0));
+    simd_vd z = simd_select(small, simd_mul(x, x), simd_mul(simd_sub(_splat(1.0), ax), _splat(0.5)));
+    simd_vd r = _asin_r(z);
+    simd_vd s = simd_sqrt(z);
+    simd_vd rsmall = simd_sub(_splat(pio2_hi), simd_sub(x, simd_sub(_splat(pio2_lo), simd_mul(x, r))));
+    simd_vd rneg = simd_sub(_splat(pi_hi),
+                            simd_mul(_splat(2.0), simd_add(s, simd_sub(simd_mul(r, s), _splat(pio2_lo)))));
+    simd_vd rpos = simd_mul(_splat(2.0), simd_add(s, simd_mul(s, r)));
+    return simd_select(tiny, rtiny, simd_select(small, rsmall, simd_select(neg, rneg, rpos)));
+}
+
+// asin(x) = pi/2 - 2 asin(sqrt((1 - |x|) / 2)) above 0.5, so one short
+// polynomial and a square root cover the whole domain without a division.
+static inline simd_vd _vasin_fast(simd_vd x0) {
+    simd_vd tiny = _tiny(x0);
+    simd_vd x = simd_andnot(x0, tiny);
+    simd_vd ax = simd_abs(x);
+    simd_vd small = simd_lt(ax, _splat(0.5));
+    simd_vd s = simd_select(small, ax, simd_sqrt(simd_mul(simd_sub(_splat(1.0), ax), _splat(0.5))));
+    simd_vd p = _odd_poly(s, ASF, 5);
+    simd_vd r = simd_select(small, p, simd_sub(_splat(pio2_hi), simd_mul(_splat(2.0), p)));
+    return simd_select(tiny, x0, simd_xor(r, simd_sign(x)));
+}
+
+static inline simd_vd _vacos_fast(simd_vd x) {
+    simd_vd ax = simd_abs(x);
+    simd_vd small = simd_lt(ax, _splat(0.5));
+    simd_vd neg = simd_lt(x, _splat(0.0));
+    simd_vd s = simd_select(small, x, simd_sqrt(simd_mul(simd_sub(_splat(1.0), ax), _splat(0.5))));
+    simd_vd p = _odd_poly(s, ASF, 5);
+    simd_vd big = simd_mul(_splat(2.0), p);
+    return simd_select(small, simd_sub(_splat(pio2_hi), p),
+                       simd_select(neg, simd_sub(_splat(pi_hi), big), big));
+}
+
+// Three ranges split at tan(pi/8) and tan(3pi/8), one division for all lanes.
+static inline simd_vd _vatan_fast(simd_vd x) {
+    simd_vd tiny = _tiny(x);
+    simd_vd ax = simd_abs(simd_andnot(x, tiny));
+    simd_vd mid = simd_lt(_splat(0.41421356237309503), ax);
+    simd_vd far = simd_lt(_splat(2.414213562373095), ax);
+    simd_vd num = simd_select(far, _splat(-1.0), simd_select(mid, simd_sub(ax, _splat(1.0)), ax));
+    simd_vd den = simd_select(far, ax, simd_select(mid, simd_add(ax, _splat(1.0)), _splat(1.0)));
+    simd_vd hi = simd_select(far, _splat(pio2_hi), simd_select(mid, _splat(pio4_hi), _splat(0.0)));
+    simd_vd r = simd_add(hi, _odd_poly(simd_div(num, den), ATF, 4));
+    return simd_select(tiny, x, simd_xor(r, simd_sign(x)));
+}
+
+// atan(a / b) for 0 <= a <= b. The fdlibm reductions (t - c) / (1 + c*t)
+// are applied to a and b directly, so one division serves both the ratio
+// and the reduction; a - c*b is exact in the ranges where it is used.
+static inline simd_vd _atan_ratio(simd_vd a, simd_vd b) {
+    simd_vd m0 = simd_le(simd_mul(_splat(0.4375), b), a);
+    simd_vd m1 = simd_le(simd_mul(_splat(0.6875), b), a);
+    simd_vd num = simd_select(m1, simd_sub(a, b), simd_select(m0, simd_sub(simd_add(a, a), b), a));
+    simd_vd den = simd_select(m1, simd_add(b, a), simd_select(m0, simd_add(simd_add(b, b), a), b));
+    simd_vd hi = simd_select(m1, _splat(atanhi[1]), simd_and(m0, _splat(atanhi[0])));
+    simd_vd lo = simd_select(m1, _splat(atanlo[1]), simd_and(m0, _splat(atanlo[0])));
+    return _atan_poly(simd_div(num, den), hi, lo);
+}
+
+static inline simd_vd _atan_ratio_fast(simd_vd a, simd_vd b) {
+    simd_vd mid = simd_lt(simd_mul(_splat(0.41421356237309503), b), a);
+    simd_vd num = simd_select(mid, simd_sub(a, b), a);
+    simd_vd den = simd_select(mid, simd_add(a, b), b);
+    return simd_add(simd_and(mid, _splat(pio4_hi)), _odd_poly(simd_div(num, den), ATF, 4));
+}
+
+// atan2 from atan(min(|x|,|y|) / max(|x|,|y|)), folded into the right
+// quadrant with the two-part pi/2 and pi. The sign bit of x decides the
+// half-plane so signed zeros follow C99 atan2.
+static inline simd_vd _vatan2(simd_vd y, simd_vd x, int fast) {
+    simd_vd ax = simd_abs(x);
+    simd_vd ay = simd_abs(y);
+    simd_vd swap = simd_lt(ax, ay);
+    simd_vd b = simd_max(ax, ay);
+    // Keeps b + a and 2b + a finite, and lifts subnormal pairs to where the
+    // branch tests on 0.4375b and 0.6875b are exact; the ratio is unchanged.
+    simd_vd k = simd_select(simd_lt(_splat(8.98846567431158e+307), b), _splat(0.25), _splat(1.0));
+    k = simd_select(simd_lt(b, _splat(1e-290)), _splat(4.1495155688809929e+180), k);
+    simd_vd a = simd_mul(simd_min(ax, ay), k);
+    b = simd_mul(b, k);
+    simd_vd z = fast ? _atan_ratio_fast(a, b) : _atan_ratio(a, b);
+    z = simd_select(simd_eq(b, _splat(0.0)), _splat(0.0), z);
+    z = simd_select(simd_eq(a, _splat(INFINITY)), _splat(pio4_hi), z);
+
+    // Quadrant angle is pi/2 -+ z when |y| > |x|, pi - z or z otherwise.
+    simd_vd left = simd_lt(simd_or(simd_sign(x), _splat(1.0)), _splat(0.0));
+    simd_vd zs = simd_xor(z, simd_and(left, simd_sign_mask()));
+    simd_vd near = simd_select(left, simd_sub(_splat(pi_hi), simd_sub(z, _splat(2.0 * pio2_lo))), z);
+    z = simd_select(swap, simd_sub(_splat(pio2_hi), simd_sub(zs, _splat(pio2_lo))), near);
+    z = simd_xor(z, simd_sign(y));
+    return simd_select(simd_or(simd_neq(x, x), simd_neq(y, y)), simd_add(x, y), z);
+}
+
+// ======================================================
+// Hyperbolic kernels
+// ======================================================
+//
+// A vector expm1 (k*ln2 reduction and a Taylor polynomial) and the fdlibm
+// log1p with its branches turned into selects, and the fdlibm sinh/cosh/tanh
+// and asinh/acosh/atanh reductions built on them. The fast tier replaces
+// expm1 with a short exp polynomial for sinh, cosh and tanh.
+
+static const double
+ln2_hi = 6.93147180369123816490e-01,
+ln2_lo = 1.90821492927058770002e-10,
+invln2 = 1.44269504088896338700e+00,
+o_threshold = 7.09782712893383973096e+02,
+// log1p polynomial coefficients
+Lp1 = 6.666666666666735130e-01,
+Lp2 = 3.999999999940941908e-01,
+Lp3 = 2.857142874366239149e-01,
+Lp4 = 2.222219843214978396e-01,
+Lp5 = 1.818357216161805012e-01,
+Lp6 = 1.531383769920937332e-01,
+Lp7 = 1.479819860511658591e-01;
+
+// 1/2!, 1/3!, ..., 1/13!: expm1(r) = r + r^2 * (EXPM1_TAYLOR in r).
+static const double EXPM1_TAYLOR[] = {
+    5.00000000000000000000e-01,
+    1.66666666666666657415e-01,
+    4.16666666666666643537e-02,
+    8.33333333333333321769e-03,
+    1.38888888888888894189e-03,
+    1.98412698412698412526e-04,
+    2.48015873015873015658e-05,
+    2.75573192239858925110e-06,
+    2.75573192239858882758e-07,
+    2.50521083854417202239e-08,
+    2.08767569878681001866e-09,
+    1.60590438368216133409e-10,
+};
+
+// Lanes with |x| < 2^-28, where sinh, tanh, asinh and atanh round to x.
+static inline simd_vd _htiny(simd_vd x) {
+    return simd_lt(simd_abs(x), _splat(3.7252902984619140625e-09));
+}
+
+static inline simd_vd _vexpm1(simd_vd x) {
+    // x = k*ln2 + r with |r| <= ln2/2; k is clamped so 2^(k-1) stays a
+    // normal number, and the lanes it affects are replaced below.
+    simd_vd k = simd_round(simd_mul(x, _splat(invln2)));
+    k = simd_min(simd_max(k, _splat(-60.0)), _splat(1024.0));
+    simd_vd r = simd_sub(simd_sub(x, simd_mul(k, _splat(ln2_hi))), simd_mul(k, _splat(ln2_lo)));
+
+    // e^r - 1 from its Taylor series through r^13 (truncation below 1e-17
+    // relative), with the linear term added last.
+    simd_vd p = _horner(r, EXPM1_TAYLOR, sizeof(EXPM1_TAYLOR) / sizeof(EXPM1_TAYLOR[0]));
+    p = simd_add(r, simd_mul(simd_mul(r, r), p));
+
+    // e^x - 1 = 2 * (h*p + (h - 1/2)) with h = 2^(k-1): the scaling is exact
+    // and h - 1/2 is exact for every k where it matters, leaving one rounding.
+    simd_vd h = simd_pow2i(simd_sub(k, _splat(1.0)));
+    simd_vd res = simd_mul(simd_add(simd_mul(h, p), simd_sub(h, _splat(0.5))), _splat(2.0));
+    res = simd_select(simd_eq(k, _splat(0.0)), p, res);
+    res = simd_select(simd_lt(_splat(o_threshold), x), _splat(INFINITY), res);
+    return simd_select(simd_lt(x, _splat(-38.816242111356935)), _splat(-1.0), res);
+}
+
+static inline simd_vd _vlog1p(simd_vd x) {
+    // Near zero the argument is used directly; elsewhere 1 + x is split
+    // into 2^k * m with m in [sqrt(2)/2, sqrt(2)) and c corrects the
+    // rounding of 1 + x.
+    simd_vd near = simd_and(simd_lt(_splat(-0.2928932188134524), x), simd_lt(x, _splat(0.41421356237309503)));
+    simd_vd u = simd_add(_splat(1.0), x);
+    simd_vd k = simd_sub(simd_exponent(u), _splat(1023.0));
+    simd_vd c = simd_div(simd_select(simd_lt(_splat(0.0), k), simd_sub(_splat(1.0), simd_sub(u, x)),
+                                     simd_sub(x, simd_sub(u, _splat(1.0)))), u);
+    simd_vd m = simd_or(simd_and(u, simd_const_bits(0x000fffffffffffffULL)), _splat(1.0));
+    simd_vd high = simd_le(_splat(1.4142131805419921875), m);
+    m = simd_select(high, simd_mul(m, _splat(0.5)), m);
+    k = simd_select(high, simd_add(k, _splat(1.0)), k);
+
+    simd_vd f = simd_select(near, x, simd_sub(m, _splat(1.0)));
+    k = simd_andnot(k, near);
+    c = simd_andnot(c, near);
+
+    simd_vd hfsq = simd_mul(_splat(0.5), simd_mul(f, f));
+    simd_vd s = simd_div(f, simd_add(_splat(2.0), f));
+    simd_vd z = simd_mul(s, s);
+    simd_vd R = simd_mul(z, simd_add(_splat(Lp1), simd_mul(z, simd_add(_splat(Lp2), simd_mul(z, simd_add(_splat(Lp3),
+                simd_mul(z, simd_add(_splat(Lp4), simd_mul(z, simd_add(_splat(Lp5), simd_mul(z, simd_add(_splat(Lp6),
+                simd_mul(z, _splat(Lp7))))))))))))));
+    simd_vd res = simd_sub(simd_mul(k, _splat(ln2_hi)),
+                           simd_sub(simd_sub(hfsq, simd_add(simd_mul(s, simd_add(hfsq, R)),
+                                                            simd_add(simd_mul(k, _splat(ln2_lo)), c))), f));
+
+    res = simd_select(simd_eq(x, _splat(INFINITY)), x, res);
+    res = simd_select(simd_eq(x, _splat(-1.0)), _splat(-INFINITY), res);
+    res = simd_select(simd_lt(x, _splat(-1.0)), _splat(NAN), res);
+    return simd_select(simd_neq(x, x), x, res);
+}
+
+// exp(x) for x <= 709: degree-7 Taylor on |r| <= ln2/2, relative error 5.4e-9.
+static inline simd_vd _vexp_fast(simd_vd x) {
+    simd_vd k = simd_round(simd_mul(x, _splat(invln2)));
+    k = simd_max(k, _splat(-1022.0));
+    simd_vd r = simd_sub(simd_sub(x, simd_mul(k, _splat(ln2_hi))), simd_mul(k, _splat(ln2_lo)));
+    simd_vd p = _splat(1.0 / 5040.0);
+    p = simd_add(simd_mul(p, r), _splat(1.0 / 720.0));
+    p = simd_add(simd_mul(p, r), _splat(1.0 / 120.0));
+    p = simd_add(simd_mul(p, r), _splat(1.0 / 24.0));
+    p = simd_add(simd_mul(p, r), _splat(1.0 / 6.0));
+    p = simd_add(simd_mul(p, r), _splat(0.5));
+    p = simd_add(simd_mul(p, r), _splat(1.0));
+    p = simd_add(simd_mul(p, r), _splat(1.0));
+    return simd_mul(p, simd_pow2i(k));
+}
+
+// Above ~709.78 exp(|x|) overflows before sinh and cosh do, so the lanes
+// up to the overflow threshold are evaluated as (e^(|x|/2) / 2) * e^(|x|/2).
+#define HYP_HALF_ARG 709.0
+
+static inline simd_vd _vsinh(simd_vd x) {
+    simd_vd ax = simd_abs(x);
+    simd_vd huge = simd_lt(_splat(HYP_HALF_ARG), ax);
+    simd_vd h = simd_or(_splat(0.5), simd_sign(x));
+    simd_vd t = _vexpm1(simd_select(huge, simd_mul(_splat(0.5), ax), ax));
+    simd_vd w = simd_add(t, _splat(1.0));
+    simd_vd q = simd_div(t, w);
+    simd_vd rsmall = simd_mul(h, simd_sub(simd_add(t, t), simd_mul(t, q)));
+    simd_vd rmid = simd_mul(h, simd_add(t, q));
+    simd_vd rbig = simd_mul(h, w);
+    simd_vd res = simd_select(huge, simd_mul(simd_mul(h, w), w), rbig);
+    res = simd_select(simd_lt(ax, _splat(22.0)), rmid, res);
+    res = simd_select(simd_lt(ax, _splat(1.0)), rsmall, res);
+    return simd_select(_htiny(x), x, res);
+}
+
+static inline simd_vd _vcosh(simd_vd x) {
+    simd_vd ax = simd_abs(x);
+    simd_vd huge = simd_lt(_splat(HYP_HALF_ARG), ax);
+    simd_vd small = simd_lt(ax, _splat(0.34657359027997264));
+    simd_vd t = _vexpm1(simd_select(huge, simd_mul(_splat(0.5), ax), ax));
+    simd_vd w = simd_add(_splat(1.0), t);
+    simd_vd d = simd_div(simd_select(small, simd_mul(t, t), _splat(0.5)), simd_select(small, simd_add(w, w), w));
+    simd_vd hw = simd_mul(_splat(0.5), w);
+    simd_vd res = simd_select(huge, simd_mul(hw, w), hw);
+    res = simd_select(simd_lt(ax, _splat(22.0)), simd_add(hw, d), res);
+    return simd_select(small, simd_add(_splat(1.0), d), res);
+}
+
+// tanh and, through q = 1 - |tanh| for |x| >= 0.6, its derivative 1 - tanh^2
+// without cancellation (from 1 as fdlibm does, (1 - tanh) (1 + tanh) reaches
+// 6 ULP just below it). Past 354, where e^(2|x|) overflows, q is 2e^-|x|
+// instead and the derivative q^2 runs down through the subnormals.
+static inline simd_vd _vtanh_deriv(simd_vd x, simd_vd* dy) {
+    simd_vd ax = simd_abs(x);
+    simd_vd big = simd_le(_splat(0.6), ax);
+    simd_vd huge = simd_lt(_splat(354.0), ax);
+    simd_vd two_ax = simd_add(ax, ax);
+    simd_vd t = _vexpm1(simd_select(big, simd_select(huge, ax, two_ax), simd_xor(two_ax, simd_sign_mask())));
+    simd_vd q = simd_div(simd_select(big, _splat(2.0), simd_xor(t, simd_sign_mask())),
+                         simd_add(t, simd_select(huge, _splat(1.0), _splat(2.0))));
+    simd_vd z = simd_select(big, simd_sub(_splat(1.0), q), q);
+    z = simd_select(simd_le(_splat(22.0), ax), _splat(1.0), z);
+    simd_vd one_minus = simd_select(big, q, simd_sub(_splat(1.0), z));
+    simd_vd d = simd_select(huge, simd_mul(q, q), simd_mul(one_minus, simd_add(_splat(1.0), z)));
+    simd_vd tiny = _htiny(x);
+    *dy = simd_select(tiny, _splat(1.0), d);
+    return simd_select(tiny, x, simd_xor(z, simd_sign(x)));
+}
+
+static inline simd_vd _vtanh(simd_vd x) {
+    simd_vd dy;
+    return _vtanh_deriv(x, &dy);
+}
+
+// sinh(a) for 0 <= a <= 1 from its odd Taylor series, relative error 2.2e-8.
+static inline simd_vd _sinh_series(simd_vd a) {
+    simd_vd z = simd_mul(a, a);
+    simd_vd p = _splat(1.0 / 362880.0);
+    p = simd_add(simd_mul(p, z), _splat(1.0 / 5040.0));
+    p = simd_add(simd_mul(p, z), _splat(1.0 / 120.0));
+    p = simd_add(simd_mul(p, z), _splat(1.0 / 6.0));
+    return simd_add(a, simd_mul(simd_mul(a, z), p));
+}
+
+static inline simd_vd _vsinh_fast(simd_vd x) {
+    simd_vd ax = simd_abs(x);
+    simd_vd huge = simd_lt(_splat(HYP_HALF_ARG), ax);
+    simd_vd e = _vexp_fast(simd_select(huge, simd_mul(_splat(0.5), ax), simd_min(ax, _splat(HYP_HALF_ARG))));
+    simd_vd rbig = simd_select(huge, simd_mul(simd_mul(_splat(0.5), e), e),
+                               simd_mul(_splat(0.5), simd_sub(e, simd_div(_splat(1.0), e))));
+    simd_vd res = simd_select(simd_lt(ax, _splat(1.0)), _sinh_series(ax), rbig);
+    res = simd_select(simd_lt(_splat(o_threshold + 0.7), ax), _splat(INFINITY), res);
+    return simd_select(simd_neq(x, x), x, simd_xor(res, simd_sign(x)));
+}
+
+static inline simd_vd _vcosh_fast(simd_vd x) {
+    simd_vd ax = simd_abs(x);
+    simd_vd huge = simd_lt(_splat(HYP_HALF_ARG), ax);
+    simd_vd e = _vexp_fast(simd_select(huge, simd_mul(_splat(0.5), ax), ax));
+    simd_vd res = simd_select(huge, simd_mul(simd_mul(_splat(0.5), e), e),
+                              simd_mul(_splat(0.5), simd_add(e, simd_div(_splat(1.0), e))));
+    res = simd_select(simd_lt(_splat(o_threshold + 0.7), ax), _splat(INFINITY), res);
+    return simd_select(simd_neq(x, x), x, res);
+}
+
+static inline simd_vd _vtanh_deriv_fast(simd_vd x, simd_vd* dy) {
+    simd_vd ax = simd_abs(x);
+    simd_vd small = simd_lt(ax, _splat(1.0));
+    // Below 1: tanh = s / sqrt(1 + s^2) and 1 - tanh^2 = 1 / (1 + s^2)
+    // with s = sinh|x|, which keeps the relative error near zero.
+    simd_vd s = _sinh_series(ax);
+    simd_vd c2 = simd_add(_splat(1.0), simd_mul(s, s));
+    // Above: 1 - tanh|x| = 2m / (1 + m) with m = e^(-2|x|). Past 354 m is
+    // e^-|x| instead, kept normal, and the derivative is 4m^2.
+    simd_vd huge = simd_lt(_splat(354.0), ax);
+    simd_vd m = _vexp_fast(simd_mul(simd_select(huge, _splat(-1.0), _splat(-2.0)), simd_min(ax, _splat(400.0))));
+    simd_vd q = simd_div(simd_add(m, m), simd_add(_splat(1.0), m));
+    simd_vd t = simd_select(small, simd_div(s, simd_sqrt(c2)), simd_sub(_splat(1.0), q));
+    simd_vd d = simd_select(huge, simd_mul(_splat(4.0), simd_mul(m, m)), simd_mul(q, simd_sub(_splat(2.0), q)));
+    d = simd_select(small, simd_div(_splat(1.0), c2), d);
+    simd_vd nan = simd_neq(x, x);
+    *dy = simd_select(nan, x, d);
+    return simd_select(nan, x, simd_xor(t, simd_sign(x)));
+}
+
+static inline simd_vd _vtanh_fast(simd_vd x) {
+    simd_vd dy;
+    return _vtanh_deriv_fast(x, &dy);
+}
+
+static inline simd_vd _vasinh(simd_vd x) {
+    simd_vd ax = simd_abs(x);
+    simd_vd big = simd_lt(_splat(2.0), ax);
+    simd_vd huge = simd_lt(_splat(268435456.0), ax);
+    simd_vd t = simd_mul(ax, ax);
+    simd_vd sq = simd_sqrt(simd_add(_splat(1.0), t));
+    simd_vd q = simd_div(simd_select(big, _splat(1.0), t), simd_select(big, simd_add(sq, ax), simd_add(_splat(1.0), sq)));
+    simd_vd arg = simd_select(big, simd_sub(simd_add(simd_add(ax, ax), q), _splat(1.0)), simd_add(ax, q));
+    arg = simd_select(huge, simd_sub(ax, _splat(1.0)), arg);
+    simd_vd w = simd_add(_vlog1p(arg), simd_and(huge, _splat(ln2_hi + ln2_lo)));
+    return simd_select(_htiny(x), x, simd_xor(w, simd_sign(x)));
+}
+
+static inline simd_vd _vacosh(simd_vd x) {
+    simd_vd big = simd_lt(_splat(2.0), x);
+    simd_vd huge = simd_lt(_splat(268435456.0), x);
+    simd_vd t = simd_sub(x, _splat(1.0));
+    simd_vd q = simd_div(_splat(1.0), simd_add(x, simd_sqrt(simd_sub(simd_mul(x, x), _splat(1.0)))));
+    simd_vd arg = simd_select(big, simd_sub(simd_sub(simd_add(x, x), q), _splat(1.0)),
+                              simd_add(t, simd_sqrt(simd_add(simd_add(t, t), simd_mul(t, t)))));
+    arg = simd_select(huge, t, arg);
+    simd_vd w = simd_add(_vlog1p(arg), simd_and(huge, _splat(ln2_hi + ln2_lo)));
+    return simd_select(simd_lt(x, _splat(1.0)), _splat(NAN), w);
+}
+
+static inline simd_vd _vatanh(simd_vd x) {
+    simd_vd ax = simd_abs(x);
+    simd_vd small = simd_lt(ax, _splat(0.5));
+    simd_vd two_ax = simd_add(ax, ax);
+    simd_vd q = simd_div(simd_select(small, simd_mul(two_ax, ax), two_ax), simd_sub(_splat(1.0), ax));
+    simd_vd w = simd_mul(_splat(0.5), _vlog1p(simd_select(small, simd_add(two_ax, q), q)));
+    return simd_select(_htiny(x), x, simd_xor(w, simd_sign(x)));
+}
+
+// ======================================================
+// Tier dispatch
+// ======================================================
+
+// Runs a vector kernel over an array. Lanes with |x| > limit (or NaN) are
+// recomputed with the scalar fallback; pass INFINITY when the kernel covers
+// every input.
+static inline void _trig_array(const double* in, double* out, size_t n,
+                               simd_vd (*kernel)(simd_vd), double (*fallback)(double),
+                               double limit) {
+    for (size_t i = 0; i < n; i += SIMD_LANES) {
+        size_t len = (n - i < SIMD_LANES) ? n - i : SIMD_LANES;
+        simd_vd x = (len == SIMD_LANES) ? simd_load(in + i) : simd_load_partial(in + i, len, 0.0);
+        simd_vd r = kernel(x);
+        if (!simd_all(simd_le(simd_abs(x), _splat(limit)))) {
+            double xs[SIMD_LANES], rs[SIMD_LANES];
+            simd_store(xs, x);
+            simd_store(rs, r);
+            for (size_t l = 0; l < len; l++)
+                if (!(fabs(xs[l]) <= limit)) rs[l] = fallback(xs[l]);
+            r = simd_load(rs);
+        }
+        if (len == SIMD_LANES)
+            simd_store(out + i, r);
+        else
+            simd_store_partial(out + i, len, r);
+    }
+}
+
+static inline void _trig_sincos_array(const double* in, double* s, double* c, size_t n,
+                                      void (*kernel)(simd_vd, simd_vd*, simd_vd*)) {
+    for (size_t i = 0; i < n; i += SIMD_LANES) {
+        size_t len = (n - i < SIMD_LANES) ? n - i : SIMD_LANES;
+        simd_vd x = (len == SIMD_LANES) ? simd_load(in + i) : simd_load_partial(in + i, len, 0.0);
+        simd_vd vs, vc;
+        kernel(x, &vs, &vc);
+        if (!simd_all(simd_le(simd_abs(x), _splat(TRIG_REDUCE_MAX)))) {
+            double xs[SIMD_LANES], ss[SIMD_LANES], cs[SIMD_LANES];
+            simd_store(xs, x);
+            simd_store(ss, vs);
+            simd_store(cs, vc);
+            for (size_t l = 0; l < len; l++) {
+                if (!(fabs(xs[l]) <= TRIG_REDUCE_MAX)) {
+                    ss[l] = sin(xs[l]);
+                    cs[l] = cos(xs[l]);
+                }
+            }
+            vs = simd_load(ss);
+            vc = simd_load(cs);
+        }
+        // Both stores come after the load so either output may alias in.
+        if (len == SIMD_LANES) {
+            simd_store(s + i, vs);
+            simd_store(c + i, vc);
+        } else {
+            simd_store_partial(s + i, len, vs);
+            simd_store_partial(c + i, len, vc);
+        }
+    }
+}
+
+// Evaluates a kernel on a single value; used by the scalar balanced and
+// fast entry points.
+static inline double _lane0(simd_vd (*kernel)(simd_vd), double x) {
+    double r[SIMD_LANES];
+    simd_store(r, kernel(simd_set1(x)));
+    return r[0];
+}
+
+// Scalar forms of the precise sin/cos kernels for the single-value sincos.
+static double _sin_poly(double x, double y) {
+    double z = x * x;
+    double w = z * z;
+    double r = S2 + z * (S3 + z * S4) + z * w * (S5 + z * S6);
+    double v = z * x;
+    return x - ((z * (0.5 * y - v * r) - y) - v * S1);
+}
+
+static double _cos_poly(double x, double y) {
+    double z = x * x;
+    double w = z * z;
+    double r = z * (C1 + z * (C2 + z * C3)) + w * w * (C4 + z * (C5 + z * C6));
+    double hz = 0.5 * z;
+    w = 1.0 - hz;
+    return w + (((1.0 - w) - hz) + (z * r - x * y));
+}
+
+static void _sincos(double x, double* s, double* c) {
+    double ax = fabs(x);
+    if (ax <= pio4) {
+        if (ax < 7.450580596923828125e-09) {
+            *s = x;
+            *c = 1.0;
+        } else {
+            *s = _sin_poly(x, 0.0);
+            *c = _cos_poly(x, 0.0);
+        }
+        return;
+    }
+    if (!(ax <= TRIG_REDUCE_MAX)) {
+        *s = sin(x);
+        *c = cos(x);
+        return;
+    }
+
+    double fn = x * invpio2;
+    fn = (fn + 6755399441055744.0) - 6755399441055744.0;
+    double xpow = simd_double_of(simd_bits_of(x) & TRIG_EXP_MASK);
+
+    double r = x - fn * pio2_1;
+    double w = fn * pio2_1t;
+    double y = r - w;
+    if (fabs(y) < xpow * 1.52587890625e-05) {
+        double t = r;
+        w = fn * pio2_2;
+        r = t - w;
+        w = fn * pio2_2t - ((t - r) - w);
+        y = r - w;
+        if (fabs(y) < xpow * 1.7763568394002505e-15) {
+            t = r;
+            w = fn * pio2_3;
+            r = t - w;
+            w = fn * pio2_3t - ((t - r) - w);
+            y = r - w;
+        }
+    }
+    double tail = (r - y) - w;
+
+    double ks = _sin_poly(y, tail);
+    double kc = _cos_poly(y, tail);
+    switch ((long)fn & 3) {
+    case 0:  *s = ks;  *c = kc;  break;
+    case 1:  *s = kc;  *c = -ks; break;
+    case 2:  *s = -ks; *c = -kc; break;
+    default: *s = -kc; *c = ks;  break;
+    }
+}
+
+// ======================================================
+// Degree-native trig
+// ======================================================
+
+// pi/180 as a 26-bit head and a tail, so a 26-bit half of the argument
+// times the head is exact.
+static const double d2r_hi = 0.01745329238474369;
+static const double d2r_lo = 1.3519960527851425e-10;
+
+// Reduces finite degrees exactly to y in [-45, 45] plus a quadrant and
+// returns y in radians as hi + lo (about 100 bits).
+static int _deg_reduce(double x, double* y, double* hi, double* lo) {
+    double r = fmod(x, 360.0);              // exact
+    double n = floor(r / 90.0 + 0.5);
+    double d = r - 90.0 * n;                // exact, |d| <= 45
+    double t = d * 134217729.0;             // Veltkamp split, 2^27 + 1
+    double dh = t - (t - d);
+    double dl = d - dh;
+    double a = dh * d2r_hi;
+    double b = dh * d2r_lo + dl * d2r_hi + dl * d2r_lo;
+    *y = d;
+    *hi = a + b;
+    *lo = b - (*hi - a);
+    return (int)n & 3;
+}
+
+// sin in the given quadrant; cos(x) is the next quadrant of sin.
+static double _deg_quadrant(int q, double hi, double lo) {
+    switch (q & 3) {
+    case 0:  return _sin_poly(hi, lo);
+    case 1:  return _cos_poly(hi, lo);
+    case 2:  return -_sin_poly(hi, lo);
+    default: return -_cos_poly(hi, lo);
+    }
+}
+
+// Zeros follow sinPi/cosPi in IEEE 754: sin takes the sign of x and cos
+// is +0.
+double fossil_math_trig_sind(double x) {
+    if (!isfinite(x)) return x - x;
+    double y, hi, lo;
+    int q = _deg_reduce(x, &y, &hi, &lo);
+    double r = _deg_quadrant(q, hi, lo);
+    return (r == 0.0) ? copysign(0.0, x) : r;
+}
+
+double fossil_math_trig_cosd(double x) {
+    if (!isfinite(x)) return x - x;
+    double y, hi, lo;
+    int q = _deg_reduce(x, &y, &hi, &lo);
+    double r = _deg_quadrant(q + 1, hi, lo);
+    return (r == 0.0) ? 0.0 : r;
+}
+
+void fossil_math_trig_sincosd(double x, double* s, double* c) {
+    if (!isfinite(x)) {
+        *s = *c = x - x;
+        return;
+    }
+    double y, hi, lo;
+    int q = _deg_reduce(x, &y, &hi, &lo);
+    double sv = _deg_quadrant(q, hi, lo);
+    double cv = _deg_quadrant(q + 1, hi, lo);
+    *s = (sv == 0.0) ? copysign(0.0, x) : sv;
+    *c = (cv == 0.0) ? 0.0 : cv;
+}
+
+// Multiples of 90 give sind / cosd with the signed zeros above (+inf at
+// 90, -0 at 180 for positive x); odd multiples of 45 give exactly +-1.
+double fossil_math_trig_tand(double x) {
+    if (!isfinite(x)) return x - x;
+    double y, hi, lo;
+    int q = _deg_reduce(x, &y, &hi, &lo);
+    if (y == 0.0) {
+        double s = fossil_math_trig_sind(x);
+        return s / fossil_math_trig_cosd(x);
+    }
+    if (fabs(y) == 45.0) return ((q & 1) ? -1.0 : 1.0) * copysign(1.0, y);
+    simd_vd odd = (q & 1) ? simd_const_bits(~(uint64_t)0) : simd_set1(0.0);
+    double r[SIMD_LANES];
+    simd_store(r, _kernel_tan(simd_set1(hi), simd_set1(lo), odd));
+    // Subnormal y underflows to a zero that has lost its sign.
+    return (r[0] == 0.0) ? copysign(0.0, y) : r[0];
+}
+
+double fossil_math_trig_sin_ex(double x, fossil_math_trig_accuracy accuracy) {
+    if (accuracy == FOSSIL_MATH_TRIG_PRECISE || !(fabs(x) <= TRIG_REDUCE_MAX)) return sin(x);
+    return _lane0(accuracy == FOSSIL_MATH_TRIG_FAST ? _vsin_fast : _vsin_balanced, x);
+}
+
+double fossil_math_trig_cos_ex(double x, fossil_math_trig_accuracy accuracy) {
+    if (accuracy == FOSSIL_MATH_TRIG_PRECISE || !(fabs(x) <= TRIG_REDUCE_MAX)) return cos(x);
+    return _lane0(accuracy == FOSSIL_MATH_TRIG_FAST ? _vcos_fast : _vcos_balanced, x);
+}
+
+double fossil_math_trig_tan_ex(double x, fossil_math_trig_accuracy accuracy) {
+    if (accuracy == FOSSIL_MATH_TRIG_PRECISE || !(fabs(x) <= TRIG_REDUCE_MAX)) return tan(x);
+    return _lane0(accuracy == FOSSIL_MATH_TRIG_FAST ? _vtan_fast : _vtan_balanced, x);
+}
+
+void fossil_math_trig_sincos_ex(double x, double* s, double* c, fossil_math_trig_accuracy accuracy) {
+    if (accuracy == FOSSIL_MATH_TRIG_PRECISE || !(fabs(x) <= TRIG_REDUCE_MAX)) {
+        _sincos(x, s, c);
+        return;
+    }
+    double sv[SIMD_LANES], cv[SIMD_LANES];
+    simd_vd vs, vc;
+    if (accuracy == FOSSIL_MATH_TRIG_FAST)
+        _vsincos_fast(simd_set1(x), &vs, &vc);
+    else
+        _vsincos_balanced(simd_set1(x), &vs, &vc);
+    simd_store(sv, vs);
+    simd_store(cv, vc);
+    *s = sv[0];
+    *c = cv[0];
+}
+
+double fossil_math_trig_asin_ex(double x, fossil_math_trig_accuracy accuracy) {
+    if (accuracy == FOSSIL_MATH_TRIG_PRECISE || isnan(x)) return asin(x);
+    return _lane0(accuracy == FOSSIL_MATH_TRIG_FAST ? _vasin_fast : _vasin_balanced, x);
+}
+
+double fossil_math_trig_acos_ex(double x, fossil_math_trig_accuracy accuracy) {
+    if (accuracy == FOSSIL_MATH_TRIG_PRECISE || isnan(x)) return acos(x);
+    return _lane0(accuracy == FOSSIL_MATH_TRIG_FAST ? _vacos_fast : _vacos_balanced, x);
+}
+
+double fossil_math_trig_atan_ex(double x, fossil_math_trig_accuracy accuracy) {
+    // The balanced tier shares the precise kernel, which is already a
+    // single division and polynomial.
+    if (accuracy != FOSSIL_MATH_TRIG_FAST || isnan(x)) return atan(x);
+    return _lane0(_vatan_fast, x);
+}
+
+void fossil_math_trig_sin_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    switch (accuracy) {
+    case FOSSIL_MATH_TRIG_FAST:     _trig_array(in, out, n, _vsin_fast, sin, TRIG_REDUCE_MAX); break;
+    case FOSSIL_MATH_TRIG_BALANCED: _trig_array(in, out, n, _vsin_balanced, sin, TRIG_REDUCE_MAX); break;
+    default:                        _trig_array(in, out, n, _vsin, sin, TRIG_REDUCE_MAX); break;
+    }
+}
+
+void fossil_math_trig_cos_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    switch (accuracy) {
+    case FOSSIL_MATH_TRIG_FAST:     _trig_array(in, out, n, _vcos_fast, cos, TRIG_REDUCE_MAX); break;
+    case FOSSIL_MATH_TRIG_BALANCED: _trig_array(in, out, n, _vcos_balanced, cos, TRIG_REDUCE_MAX); break;
+    default:                        _trig_array(in, out, n, _vcos, cos, TRIG_REDUCE_MAX); break;
+    }
+}
+
+void fossil_math_trig_tan_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    switch (accuracy) {
+    case FOSSIL_MATH_TRIG_FAST:     _trig_array(in, out, n, _vtan_fast, tan, TRIG_REDUCE_MAX); break;
+    case FOSSIL_MATH_TRIG_BALANCED: _trig_array(in, out, n, _vtan_balanced, tan, TRIG_REDUCE_MAX); break;
+    default:                        _trig_array(in, out, n, _vtan, tan, TRIG_REDUCE_MAX); break;
+    }
+}
+
+void fossil_math_trig_sincos_array_ex(const double* in, double* s, double* c, size_t n,
+                                      fossil_math_trig_accuracy accuracy) {
+    switch (accuracy) {
+    case FOSSIL_MATH_TRIG_FAST:     _trig_sincos_array(in, s, c, n, _vsincos_fast); break;
+    case FOSSIL_MATH_TRIG_BALANCED: _trig_sincos_array(in, s, c, n, _vsincos_balanced); break;
+    default:                        _trig_sincos_array(in, s, c, n, _vsincos); break;
+    }
+}
+
+void fossil_math_trig_asin_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    switch (accuracy) {
+    case FOSSIL_MATH_TRIG_FAST:     _trig_array(in, out, n, _vasin_fast, asin, INFINITY); break;
+    case FOSSIL_MATH_TRIG_BALANCED: _trig_array(in, out, n, _vasin_balanced, asin, INFINITY); break;
+    default:                        _trig_array(in, out, n, _vasin, asin, INFINITY); break;
+    }
+}
+
+void fossil_math_trig_acos_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    switch (accuracy) {
+    case FOSSIL_MATH_TRIG_FAST:     _trig_array(in, out, n, _vacos_fast, acos, INFINITY); break;
+    case FOSSIL_MATH_TRIG_BALANCED: _trig_array(in, out, n, _vacos_balanced, acos, INFINITY); break;
+    default:                        _trig_array(in, out, n, _vacos, acos, INFINITY); break;
+    }
+}
+
+void fossil_math_trig_atan_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    if (accuracy == FOSSIL_MATH_TRIG_FAST)
+        _trig_array(in, out, n, _vatan_fast, atan, INFINITY);
+    else
+        _trig_array(in, out, n, _vatan, atan, INFINITY);
+}
+
+static inline void _atan2_array(const double* y, const double* x, double* out, size_t n, int fast) {
+    for (size_t i = 0; i < n; i += SIMD_LANES) {
+        size_t len = (n - i < SIMD_LANES) ? n - i : SIMD_LANES;
+        simd_vd vy = (len == SIMD_LANES) ? simd_load(y + i) : simd_load_partial(y + i, len, 0.0);
+        simd_vd vx = (len == SIMD_LANES) ? simd_load(x + i) : simd_load_partial(x + i, len, 1.0);
+        simd_vd r = _vatan2(vy, vx, fast);
+        if (len == SIMD_LANES)
+            simd_store(out + i, r);
+        else
+            simd_store_partial(out + i, len, r);
+    }
+}
+
+void fossil_math_trig_atan2_array_ex(const double* y, const double* x, double* out, size_t n,
+                                     fossil_math_trig_accuracy accuracy) {
+    if (accuracy == FOSSIL_MATH_TRIG_FAST)
+        _atan2_array(y, x, out, n, 1);
+    else
+        _atan2_array(y, x, out, n, 0);
+}
+
+void fossil_math_trig_sin_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_sin_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_cos_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_cos_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_tan_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_tan_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_sincos_array(const double* in, double* s, double* c, size_t n) {
+    fossil_math_trig_sincos_array_ex(in, s, c, n, trig_accuracy);
+}
+
+void fossil_math_trig_asin_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_asin_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_acos_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_acos_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_atan_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_atan_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_atan2_array(const double* y, const double* x, double* out, size_t n) {
+    fossil_math_trig_atan2_array_ex(y, x, out, n, trig_accuracy);
+}
+
+// Buffers at least this long are split across the fossil_math_set_threads()
+// threads; every hyperbolic kernel covers all inputs, so chunks are independent.
+#define HYP_GRAIN ((size_t)1 << 16)
+
+typedef struct {
+    const double* in;
+    double* out;
+    double* dy;
+    simd_vd (*kernel)(simd_vd);
+    simd_vd (*deriv)(simd_vd, simd_vd*);
+    double (*fallback)(double);
+} hyp_job;
+
+static inline void _deriv_array(const double* in, double* y, double* dy, size_t n,
+                                simd_vd (*kernel)(simd_vd, simd_vd*)) {
+    for (size_t i = 0; i < n; i += SIMD_LANES) {
+        size_t len = (n - i < SIMD_LANES) ? n - i : SIMD_LANES;
+        simd_vd x = (len == SIMD_LANES) ? simd_load(in + i) : simd_load_partial(in + i, len, 0.0);
+        simd_vd d;
+        simd_vd v = kernel(x, &d);
+        if (len == SIMD_LANES) {
+            simd_store(y + i, v);
+            simd_store(dy + i, d);
+        } else {
+            simd_store_partial(y + i, len, v);
+            simd_store_partial(dy + i, len, d);
+        }
+    }
+}
+
+static void _hyp_range(void* ctx, size_t begin, size_t end) {
+    const hyp_job* job = (const hyp_job*)ctx;
+    if (job->deriv)
+        _deriv_array(job->in + begin, job->out + begin, job->dy + begin, end - begin, job->deriv);
+    else
+        _trig_array(job->in + begin, job->out + begin, end - begin, job->kernel, job->fallback, INFINITY);
+}
+
+static void _hyp_array(const double* in, double* out, size_t n,
+                       simd_vd (*kernel)(simd_vd), double (*fallback)(double)) {
+    hyp_job job = {in, out, NULL, kernel, NULL, fallback};
+    fossil_math_parallel_for(n, HYP_GRAIN, _hyp_range, &job);
+}
+
+void fossil_math_trig_sinh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    _hyp_array(in, out, n, (accuracy == FOSSIL_MATH_TRIG_FAST) ? _vsinh_fast : _vsinh, sinh);
+}
+
+void fossil_math_trig_cosh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    _hyp_array(in, out, n, (accuracy == FOSSIL_MATH_TRIG_FAST) ? _vcosh_fast : _vcosh, cosh);
+}
+
+void fossil_math_trig_tanh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    _hyp_array(in, out, n, (accuracy == FOSSIL_MATH_TRIG_FAST) ? _vtanh_fast : _vtanh, tanh);
+}
+
+void fossil_math_trig_tanh_deriv_array_ex(const double* in, double* y, double* dy, size_t n,
+                                          fossil_math_trig_accuracy accuracy) {
+    hyp_job job = {in, y, dy, NULL, (accuracy == FOSSIL_MATH_TRIG_FAST) ? _vtanh_deriv_fast : _vtanh_deriv, NULL};
+    fossil_math_parallel_for(n, HYP_GRAIN, _hyp_range, &job);
+}
+
+// The inverse hyperbolics are a square root and a log1p in every tier.
+void fossil_math_trig_asinh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    (void)accuracy;
+    _hyp_array(in, out, n, _vasinh, asinh);
+}
+
+void fossil_math_trig_acosh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    (void)accuracy;
+    _hyp_array(in, out, n, _vacosh, acosh);
+}
+
+void fossil_math_trig_atanh_array_ex(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    (void)accuracy;
+    _hyp_array(in, out, n, _vatanh, atanh);
+}
+
+void fossil_math_trig_sinh_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_sinh_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_cosh_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_cosh_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_tanh_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_tanh_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_tanh_deriv_array(const double* in, double* y, double* dy, size_t n) {
+    fossil_math_trig_tanh_deriv_array_ex(in, y, dy, n, trig_accuracy);
+}
+
+void fossil_math_trig_asinh_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_asinh_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_acosh_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_acosh_array_ex(in, out, n, trig_accuracy);
+}
+
+void fossil_math_trig_atanh_array(const double* in, double* out, size_t n) {
+    fossil_math_trig_atanh_array_ex(in, out, n, trig_accuracy);
+}
+
+// Same multiply as the scalar conversions, so results match them bit for bit.
+static inline void _scale_array(const double* in, double* out, size_t n, double k) {
+    simd_vd vk = simd_set1(k);
+    size_t i = 0;
+    for (; i + SIMD_LANES <= n; i += SIMD_LANES)
+        simd_store(out + i, simd_mul(simd_load(in + i), vk));
+    for (; i < n; i++)
+        out[i] = in[i] * k;
+}
+
+void fossil_math_trig_deg_to_rad_array(const double* in, double* out, size_t n) {
+    _scale_array(in, out, n, FOSSIL_MATH_PI / 180.0);
+}
+
+void fossil_math_trig_rad_to_deg_array(const double* in, double* out, size_t n) {
+    _scale_array(in, out, n, 180.0 / FOSSIL_MATH_PI);
+}
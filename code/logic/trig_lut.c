@@ -0,0 +1,304 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include "fossil/math/trig_lut.h"
+#include "simd.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+
+#define LUT_TWO_PI 6.28318530717958647692
+
+// Smallest and largest number of entries per period.
+#define LUT_MIN_SIZE 4
+#define LUT_MAX_SIZE ((size_t)1 << 20)
+
+// Points per interval sampled for the error report.
+#define LUT_ERROR_SAMPLES 16
+
+// Phases from 2^51 table steps on are left to libm; below that the
+// fractional part is exact and simd_round() is valid.
+#define LUT_PHASE_MAX 2251799813685248.0
+
+// Outputs requested from the array driver.
+#define LUT_WANT_SIN 1
+#define LUT_WANT_COS 2
+
+struct fossil_math_trig_lut {
+    size_t size;
+    size_t mask;
+    size_t quarter;
+    fossil_math_trig_lut_interp interp;
+    double step;      // 2 pi / size
+    double inv_step;  // size / (2 pi)
+    double max_error;
+    // size + quarter + 1 samples of sin(j * step); the tail repeats the
+    // start so index i + 1 and the cosine at i + quarter never wrap.
+    double* table;
+};
+
+// ======================================================
+// Interpolation
+// ======================================================
+
+// Splits x into a table index and the fraction of a step past it. Returns
+// nonzero when x is beyond the table's reach (or NaN).
+static inline int _lut_phase(const fossil_math_trig_lut* lut, double x, size_t* i, double* t) {
+    double u = x * lut->inv_step;
+    if (!(fabs(u) < LUT_PHASE_MAX)) return 1;
+    // Truncate and step down for negative fractions; floor() is a library
+    // call on baseline x86-64.
+    int64_t k = (int64_t)u;
+    k -= (u < (double)k);
+    *t = u - (double)k;
+    *i = (size_t)k & lut->mask;
+    return 0;
+}
+
+static inline double _lut_linear(const double* s, size_t i, double t) {
+    return s[i] + t * (s[i + 1] - s[i]);
+}
+
+// Cubic Hermite on one step with end values f0, f1 and slopes d0, d1 (per
+// step).
+static inline double _lut_hermite(double f0, double f1, double d0, double d1, double t) {
+    double a = 3.0 * (f1 - f0) - 2.0 * d0 - d1;
+    double b = 2.0 * (f0 - f1) + d0 + d1;
+    return f0 + t * (d0 + t * (a + t * b));
+}
+
+static inline simd_vd _lut_hermite_v(simd_vd f0, simd_vd f1, simd_vd d0, simd_vd d1, simd_vd t) {
+    simd_vd three = simd_set1(3.0), two = simd_set1(2.0);
+    simd_vd a = simd_sub(simd_sub(simd_mul(three, simd_sub(f1, f0)), simd_mul(two, d0)), d1);
+    simd_vd b = simd_add(simd_add(simd_mul(two, simd_sub(f0, f1)), d0), d1);
+    return simd_add(f0, simd_mul(t, simd_add(d0, simd_mul(t, simd_add(a, simd_mul(t, b))))));
+}
+
+static inline void _lut_sincos(const fossil_math_trig_lut* lut, size_t i, double t, double* s, double* c) {
+    const double* tab = lut->table;
+    size_t q = lut->quarter;
+    if (lut->interp == FOSSIL_MATH_TRIG_LUT_LINEAR) {
+        *s = _lut_linear(tab, i, t);
+        *c = _lut_linear(tab, i + q, t);
+        return;
+    }
+    double s0 = tab[i], s1 = tab[i + 1];
+    double c0 = tab[i + q], c1 = tab[i + q + 1];
+    double h = lut->step;
+    *s = _lut_hermite(s0, s1, c0 * h, c1 * h, t);
+    *c = _lut_hermite(c0, c1, -s0 * h, -s1 * h, t);
+}
+
+static inline double _lut_sin(const fossil_math_trig_lut* lut, size_t i, double t) {
+    if (lut->interp == FOSSIL_MATH_TRIG_LUT_LINEAR) return _lut_linear(lut->table, i, t);
+    const double* tab = lut->table;
+    size_t q = lut->quarter;
+    return _lut_hermite(tab[i], tab[i + 1], tab[i + q] * lut->step, tab[i + q + 1] * lut->step, t);
+}
+
+// cos(x) = sin(x + pi/2): the samples a quarter table further on, with
+// -sin as the slope.
+static inline double _lut_cos(const fossil_math_trig_lut* lut, size_t i, double t) {
+    const double* tab = lut->table;
+    size_t q = lut->quarter;
+    if (lut->interp == FOSSIL_MATH_TRIG_LUT_LINEAR) return _lut_linear(tab, i + q, t);
+    return _lut_hermite(tab[i + q], tab[i + q + 1], -tab[i] * lut->step, -tab[i + 1] * lut->step, t);
+}
+
+// ======================================================
+// Lifetime
+// ======================================================
+
+// Fills the table from the first quarter so the cardinal samples are exact
+// and the table is exactly odd and periodic.
+static void _lut_fill(fossil_math_trig_lut* lut) {
+    double* s = lut->table;
+    size_t n = lut->size, q = lut->quarter, h = n / 2;
+    for (size_t j = 0; j <= q; j++) {
+        double v = (2 * j <= q) ? sin((double)j * lut->step) : cos((double)(q - j) * lut->step);
+        s[j] = v;
+        s[h - j] = v;
+        s[h + j] = -v;
+        s[n - j] = -v;
+    }
+    s[0] = 0.0;
+    for (size_t j = 0; j <= q; j++)
+        s[n + j] = s[j];
+}
+
+static double _lut_measure(const fossil_math_trig_lut* lut) {
+    double worst = 0.0;
+    for (size_t i = 0; i < lut->size; i++) {
+        for (size_t j = 0; j < LUT_ERROR_SAMPLES; j++) {
+            double t = ((double)j + 0.5) / LUT_ERROR_SAMPLES;
+            double x = ((double)i + t) * lut->step;
+            double e = fabs(_lut_sin(lut, i, t) - sin(x));
+            if (e > worst) worst = e;
+        }
+    }
+    return worst;
+}
+
+fossil_math_trig_lut* fossil_math_trig_lut_create(size_t size, fossil_math_trig_lut_interp interp) {
+    if (size < LUT_MIN_SIZE || size > LUT_MAX_SIZE || (size & (size - 1)) != 0) return NULL;
+    if (interp != FOSSIL_MATH_TRIG_LUT_LINEAR && interp != FOSSIL_MATH_TRIG_LUT_CUBIC) return NULL;
+
+    fossil_math_trig_lut* lut = malloc(sizeof(*lut));
+    if (!lut) return NULL;
+
+    lut->size = size;
+    lut->mask = size - 1;
+    lut->quarter = size / 4;
+    lut->interp = interp;
+    lut->step = LUT_TWO_PI / (double)size;
+    lut->inv_step = (double)size / LUT_TWO_PI;
+    lut->table = fossil_math_aligned_alloc(fossil_math_trig_lut_bytes(lut));
+    if (!lut->table) {
+        free(lut);
+        return NULL;
+    }
+    _lut_fill(lut);
+    lut->max_error = _lut_measure(lut);
+    return lut;
+}
+
+void fossil_math_trig_lut_destroy(fossil_math_trig_lut* lut) {
+    if (!lut) return;
+    fossil_math_aligned_free(lut->table);
+    free(lut);
+}
+
+size_t fossil_math_trig_lut_size(const fossil_math_trig_lut* lut) {
+    return lut ? lut->size : 0;
+}
+
+fossil_math_trig_lut_interp fossil_math_trig_lut_get_interp(const fossil_math_trig_lut* lut) {
+    return lut ? lut->interp : FOSSIL_MATH_TRIG_LUT_LINEAR;
+}
+
+size_t fossil_math_trig_lut_bytes(const fossil_math_trig_lut* lut) {
+    return lut ? (lut->size + lut->quarter + 1) * sizeof(double) : 0;
+}
+
+double fossil_math_trig_lut_max_error(const fossil_math_trig_lut* lut) {
+    return lut ? lut->max_error : NAN;
+}
+
+// ======================================================
+// Evaluation
+// ======================================================
+
+double fossil_math_trig_lut_sin(const fossil_math_trig_lut* lut, double x) {
+    size_t i;
+    double t;
+    if (_lut_phase(lut, x, &i, &t)) return sin(x);
+    return _lut_sin(lut, i, t);
+}
+
+double fossil_math_trig_lut_cos(const fossil_math_trig_lut* lut, double x) {
+    size_t i;
+    double t;
+    if (_lut_phase(lut, x, &i, &t)) return cos(x);
+    return _lut_cos(lut, i, t);
+}
+
+void fossil_math_trig_lut_sincos(const fossil_math_trig_lut* lut, double x, double* s, double* c) {
+    size_t i;
+    double t;
+    if (_lut_phase(lut, x, &i, &t)) {
+        *s = sin(x);
+        *c = cos(x);
+        return;
+    }
+    _lut_sincos(lut, i, t, s, c);
+}
+
+// Phase and interpolation run SIMD_LANES at a time; only the table reads
+// are per lane. Blocks holding an out-of-reach lane take the scalar path.
+static inline void _lut_array(const fossil_math_trig_lut* lut, const double* in, double* s, double* c,
+                       size_t n, int want) {
+    const double* tab = lut->table;
+    size_t q = lut->quarter;
+    int cubic = (lut->interp == FOSSIL_MATH_TRIG_LUT_CUBIC);
+    simd_vd h = simd_set1(lut->step);
+    for (size_t i = 0; i < n; i += SIMD_LANES) {
+        size_t len = (n - i < SIMD_LANES) ? n - i : SIMD_LANES;
+        simd_vd x = (len == SIMD_LANES) ? simd_load(in + i) : simd_load_partial(in + i, len, 0.0);
+        simd_vd u = simd_mul(x, simd_set1(lut->inv_step));
+        if (!simd_all(simd_lt(simd_abs(u), simd_set1(LUT_PHASE_MAX)))) {
+            for (size_t l = 0; l < len; l++) {
+                double sv, cv;
+                fossil_math_trig_lut_sincos(lut, in[i + l], &sv, &cv);
+                if (want & LUT_WANT_SIN) s[i + l] = sv;
+                if (want & LUT_WANT_COS) c[i + l] = cv;
+            }
+            continue;
+        }
+        simd_vd k = simd_round(u);
+        k = simd_sub(k, simd_and(simd_gt(k, u), simd_set1(1.0)));
+        simd_vd t = simd_sub(u, k);
+
+        double kd[SIMD_LANES], s0[SIMD_LANES], s1[SIMD_LANES], c0[SIMD_LANES], c1[SIMD_LANES];
+        simd_store(kd, k);
+        for (size_t l = 0; l < SIMD_LANES; l++) {
+            size_t j = (size_t)(int64_t)kd[l] & lut->mask;
+            s0[l] = tab[j];
+            s1[l] = tab[j + 1];
+            c0[l] = tab[j + q];
+            c1[l] = tab[j + q + 1];
+        }
+        simd_vd vs0 = simd_load(s0), vs1 = simd_load(s1);
+        simd_vd vc0 = simd_load(c0), vc1 = simd_load(c1);
+
+        simd_vd rs, rc;
+        if (cubic) {
+            rs = _lut_hermite_v(vs0, vs1, simd_mul(vc0, h), simd_mul(vc1, h), t);
+            rc = _lut_hermite_v(vc0, vc1, simd_mul(simd_xor(vs0, simd_sign_mask()), h),
+                                simd_mul(simd_xor(vs1, simd_sign_mask()), h), t);
+        } else {
+            rs = simd_add(vs0, simd_mul(t, simd_sub(vs1, vs0)));
+            rc = simd_add(vc0, simd_mul(t, simd_sub(vc1, vc0)));
+        }
+        if (len == SIMD_LANES) {
+            if (want & LUT_WANT_SIN) simd_store(s + i, rs);
+            if (want & LUT_WANT_COS) simd_store(c + i, rc);
+        } else {
+            if (want & LUT_WANT_SIN) simd_store_partial(s + i, len, rs);
+            if (want & LUT_WANT_COS) simd_store_partial(c + i, len, rc);
+        }
+    }
+}
+
+void fossil_math_trig_lut_sin_array(const fossil_math_trig_lut* lut, const double* in, double* out, size_t n) {
+    _lut_array(lut, in, out, NULL, n, LUT_WANT_SIN);
+}
+
+void fossil_math_trig_lut_cos_array(const fossil_math_trig_lut* lut, const double* in, double* out, size_t n) {
+    _lut_array(lut, in, NULL, out, n, LUT_WANT_COS);
+}
+
+void fossil_math_trig_lut_sincos_array(const fossil_math_trig_lut* lut, const double* in,
+                                       double* s, double* c, size_t n) {
+    _lut_array(lut, in, s, c, n, LUT_WANT_SIN | LUT_WANT_COS);
+}
@@ -0,0 +1,139 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+#include "fossil/math/framework.h"
+#include <stdlib.h>
+#include <math.h>
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_SUITE(c_cheb_fixture);
+
+FOSSIL_SETUP(c_cheb_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_cheb_fixture) {
+    // Teardown the test fixture
+}
+
+static double cheb_sample_sin_cosh(double x, void* ctx) {
+    (void)ctx;
+    return fossil_math_trig_sin(x) * fossil_math_trig_cosh(0.5 * x);
+}
+
+static double cheb_sample_steep_tanh(double x, void* ctx) {
+    double k = *(const double*)ctx;
+    return fossil_math_trig_tanh(k * x);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_CASE(c_math_test_cheb_fit_single_piece) {
+    fossil_math_cheb* c = fossil_math_cheb_fit(cheb_sample_sin_cosh, NULL, 0.0, 3.0, 1e-12, 64, 1);
+    ASSUME_ITS_TRUE(c != NULL);
+    ASSUME_ITS_TRUE(fossil_math_cheb_pieces(c) == 1);
+    for (int i = 0; i <= 30; i++) {
+        double x = 0.1 * i;
+        ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(c, x), cheb_sample_sin_cosh(x, NULL), 1e-12);
+    }
+    fossil_math_cheb_destroy(c);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cheb_fit_piecewise) {
+    double k = 40.0;
+    fossil_math_cheb* c = fossil_math_cheb_fit(cheb_sample_steep_tanh, &k, -4.0, 4.0, 1e-10, 32, 256);
+    ASSUME_ITS_TRUE(c != NULL);
+    ASSUME_ITS_TRUE(fossil_math_cheb_pieces(c) > 1);
+    for (int i = 0; i <= 80; i++) {
+        double x = -4.0 + 0.1 * i;
+        ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(c, x), cheb_sample_steep_tanh(x, &k), 1e-10);
+    }
+    fossil_math_cheb_destroy(c);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cheb_fit_unreachable_tolerance) {
+    double k = 40.0;
+    fossil_math_cheb* c = fossil_math_cheb_fit(cheb_sample_steep_tanh, &k, -4.0, 4.0, 1e-10, 8, 1);
+    ASSUME_ITS_TRUE(c == NULL);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cheb_eval_array) {
+    double k = 3.0;
+    fossil_math_cheb* c = fossil_math_cheb_fit(cheb_sample_steep_tanh, &k, -2.0, 2.0, 1e-12, 48, 16);
+    double x[37], out[37];
+    for (int i = 0; i < 37; i++)
+        x[i] = -2.0 + 4.0 * i / 36.0;
+    fossil_math_cheb_eval_array(c, x, out, 37);
+    for (int i = 0; i < 37; i++)
+        ASSUME_ITS_EQUAL_F64(out[i], fossil_math_cheb_eval(c, x[i]), 1e-15);
+    fossil_math_cheb_destroy(c);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cheb_serialize_roundtrip) {
+    double k = 10.0;
+    fossil_math_cheb* c = fossil_math_cheb_fit(cheb_sample_steep_tanh, &k, -1.0, 1.0, 1e-9, 24, 32);
+    size_t size = fossil_math_cheb_serialize(c, NULL, 0);
+    unsigned char* blob = (unsigned char*)malloc(size);
+    ASSUME_ITS_TRUE(fossil_math_cheb_serialize(c, blob, size) == size);
+
+    fossil_math_cheb* loaded = fossil_math_cheb_deserialize(blob, size);
+    ASSUME_ITS_TRUE(loaded != NULL);
+    ASSUME_ITS_TRUE(fossil_math_cheb_pieces(loaded) == fossil_math_cheb_pieces(c));
+    for (int i = 0; i <= 20; i++) {
+        double x = -1.0 + 0.1 * i;
+        ASSUME_ITS_EQUAL_F64(fossil_math_cheb_eval(loaded, x), fossil_math_cheb_eval(c, x), 0.0);
+    }
+    ASSUME_ITS_TRUE(fossil_math_cheb_deserialize(blob, size - 1) == NULL);
+
+    fossil_math_cheb_destroy(loaded);
+    fossil_math_cheb_destroy(c);
+    free(blob);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_cheb_tests) {
+    FOSSIL_TEST_ADD(c_cheb_fixture, c_math_test_cheb_fit_single_piece);
+    FOSSIL_TEST_ADD(c_cheb_fixture, c_math_test_cheb_fit_piecewise);
+    FOSSIL_TEST_ADD(c_cheb_fixture, c_math_test_cheb_fit_unreachable_tolerance);
+    FOSSIL_TEST_ADD(c_cheb_fixture, c_math_test_cheb_eval_array);
+    FOSSIL_TEST_ADD(c_cheb_fixture, c_math_test_cheb_serialize_roundtrip);
+
+    FOSSIL_TEST_REGISTER(c_cheb_fixture);
+} // end of tests
@@ -0,0 +1,80 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+#include "fossil/math/framework.h"
+#include <cmath>
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_SUITE(cpp_cheb_fixture);
+
+FOSSIL_SETUP(cpp_cheb_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_cheb_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_CASE(cpp_math_test_chebyshev_fit_lambda) {
+    auto f = [](double x) { return fossil::math::Trigonometry::atan(x) * fossil::math::Trigonometry::cosh(x); };
+    auto cheb = fossil::math::Chebyshev::fit(f, -1.0, 1.0, 1e-12);
+    ASSUME_ITS_EQUAL_F64(cheb(0.3), f(0.3), 1e-12);
+    auto values = cheb.eval({-0.5, 0.0, 0.5});
+    ASSUME_ITS_EQUAL_F64(values[0], f(-0.5), 1e-12);
+    ASSUME_ITS_EQUAL_F64(values[2], f(0.5), 1e-12);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_chebyshev_serialize) {
+    auto cheb = fossil::math::Chebyshev::fit([](double x) { return std::exp(x); }, 0.0, 8.0, 1e-9, 16, 64);
+    auto blob = cheb.serialize();
+    auto loaded = fossil::math::Chebyshev::deserialize(blob);
+    ASSUME_ITS_TRUE(loaded.pieces() == cheb.pieces());
+    ASSUME_ITS_EQUAL_F64(loaded(5.5), cheb(5.5), 0.0);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_cheb_tests) {
+    FOSSIL_TEST_ADD(cpp_cheb_fixture, cpp_math_test_chebyshev_fit_lambda);
+    FOSSIL_TEST_ADD(cpp_cheb_fixture, cpp_math_test_chebyshev_serialize);
+
+    FOSSIL_TEST_REGISTER(cpp_cheb_fixture);
+} // end of tests
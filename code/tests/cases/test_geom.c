@@ -24,6 +24,10 @@
  */
 #include <fossil/pizza/framework.h>
 #include "fossil/math/framework.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
 
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -43,6 +47,23 @@ FOSSIL_TEARDOWN(c_geom_fixture) {
     // Teardown the test fixture
 }
 
+// Checks that hull[0, m) is a strictly convex counterclockwise polygon that
+// contains every finite point.
+static int geom_check_hull(const fossil_math_geom_point2d* p, size_t n, const size_t* hull, size_t m) {
+    for (size_t i = 0; i < m; i++) {
+        fossil_math_geom_point2d a = p[hull[i]], b = p[hull[(i + 1) % m]], c = p[hull[(i + 2) % m]];
+        if (m >= 3 && fossil_math_geom_orient2d(a, b, c) <= 0.0)
+            return 0;
+        for (size_t j = 0; m >= 3 && j < n; j++) {
+            if (!isfinite(p[j].x) || !isfinite(p[j].y))
+                continue;
+            if (fossil_math_geom_orient2d(a, b, p[j]) < 0.0)
+                return 0;
+        }
+    }
+    return 1;
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Cases
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -84,6 +105,1083 @@ FOSSIL_TEST_CASE(c_math_test_point_in_circle_inside) {
     FOSSIL_TEST_ASSUME(inside == 1, "Point should be inside the circle");
 }
 
+FOSSIL_TEST_CASE(c_math_test_rotate2d) {
+    fossil_math_geom_point2d p = {1.0, 0.0};
+    fossil_math_geom_point2d r = fossil_math_geom_rotate2d(p, FOSSIL_MATH_PI / 2.0);
+    ASSUME_ITS_EQUAL_F64(r.x, 0.0, 1e-9);
+    ASSUME_ITS_EQUAL_F64(r.y, 1.0, 1e-9);
+
+    fossil_math_geom_point2d pts[5] = {{1.0, 0.0}, {0.0, 2.0}, {3.0, 4.0}, {-1.0, 1.0}, {2.0, -2.0}};
+    double angles[5] = {0.0, FOSSIL_MATH_PI / 2.0, FOSSIL_MATH_PI, -FOSSIL_MATH_PI / 4.0, 10.0};
+    fossil_math_geom_point2d out[5];
+    fossil_math_geom_rotate2d_array(pts, angles, out, 5);
+    for (size_t i = 0; i < 5; i++) {
+        r = fossil_math_geom_rotate2d(pts[i], angles[i]);
+        ASSUME_ITS_EQUAL_F64(out[i].x, r.x, 1e-9);
+        ASSUME_ITS_EQUAL_F64(out[i].y, r.y, 1e-9);
+    }
+}
+
+FOSSIL_TEST_CASE(c_math_test_polar_conversion) {
+    double x[301], y[301], r[301], t[301], bx[301], by[301];
+    for (size_t i = 0; i < 301; i++) {
+        x[i] = -15.0 + 0.1 * (double)i;
+        y[i] = 7.0 - 0.05 * (double)i;
+    }
+    fossil_math_geom_cart_to_polar_soa(x, y, r, t, 301);
+    for (size_t i = 0; i < 301; i++) {
+        fossil_math_geom_point2d p = {x[i], y[i]}, o = {0.0, 0.0};
+        ASSUME_ITS_EQUAL_F64(r[i], fossil_math_geom_distance2d(p, o), 1e-14 * r[i]);
+        ASSUME_ITS_EQUAL_F64(t[i], fossil_math_trig_atan2(y[i], x[i]), 1e-15);
+    }
+
+    fossil_math_geom_polar_to_cart_soa(r, t, bx, by, 301);
+    for (size_t i = 0; i < 301; i++) {
+        ASSUME_ITS_EQUAL_F64(bx[i], x[i], 1e-13);
+        ASSUME_ITS_EQUAL_F64(by[i], y[i], 1e-13);
+    }
+
+    // In place: r over x and theta over y.
+    fossil_math_geom_cart_to_polar_soa(x, y, x, y, 301);
+    ASSUME_ITS_TRUE(memcmp(x, r, sizeof(r)) == 0 && memcmp(y, t, sizeof(t)) == 0);
+}
+
+FOSSIL_TEST_CASE(c_math_test_polar_point_array) {
+    fossil_math_geom_point2d pts[5] = {{1.0, 0.0}, {0.0, 2.0}, {-3.0, 0.0}, {0.0, -4.0}, {1.0, 1.0}};
+    fossil_math_geom_point2d polar[5], back[5];
+    fossil_math_geom_cart_to_polar_array(pts, polar, 5);
+    ASSUME_ITS_EQUAL_F64(polar[1].x, 2.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(polar[1].y, FOSSIL_MATH_PI / 2.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(polar[2].y, FOSSIL_MATH_PI, 1e-15);
+    ASSUME_ITS_EQUAL_F64(polar[3].y, -FOSSIL_MATH_PI / 2.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(polar[4].x, sqrt(2.0), 1e-15);
+
+    fossil_math_geom_polar_to_cart_array(polar, back, 5);
+    fossil_math_geom_polar_to_cart_array(polar, polar, 5); // in place
+    for (size_t i = 0; i < 5; i++) {
+        ASSUME_ITS_EQUAL_F64(back[i].x, pts[i].x, 1e-15);
+        ASSUME_ITS_EQUAL_F64(back[i].y, pts[i].y, 1e-15);
+        ASSUME_ITS_TRUE(polar[i].x == back[i].x && polar[i].y == back[i].y);
+    }
+}
+
+FOSSIL_TEST_CASE(c_math_test_spherical_conversion) {
+    fossil_math_geom_point3d pts[300], sph[300], back[300];
+    for (size_t i = 0; i < 300; i++) {
+        pts[i].x = sin(0.37 * (double)i) * 5.0;
+        pts[i].y = cos(0.11 * (double)i) * 3.0;
+        pts[i].z = -2.0 + 0.013 * (double)i;
+    }
+    fossil_math_geom_cart_to_spherical_array(pts, sph, 300);
+    for (size_t i = 0; i < 300; i++) {
+        fossil_math_geom_point3d o = {0.0, 0.0, 0.0};
+        ASSUME_ITS_EQUAL_F64(sph[i].x, fossil_math_geom_distance3d(pts[i], o), 1e-14 * sph[i].x);
+        ASSUME_ITS_EQUAL_F64(sph[i].y, atan2(pts[i].y, pts[i].x), 1e-15);
+        ASSUME_ITS_EQUAL_F64(sph[i].z, acos(pts[i].z / sph[i].x), 1e-13);
+    }
+
+    fossil_math_geom_spherical_to_cart_array(sph, back, 300);
+    for (size_t i = 0; i < 300; i++) {
+        ASSUME_ITS_EQUAL_F64(back[i].x, pts[i].x, 1e-14);
+        ASSUME_ITS_EQUAL_F64(back[i].y, pts[i].y, 1e-14);
+        ASSUME_ITS_EQUAL_F64(back[i].z, pts[i].z, 1e-14);
+    }
+
+    // The polar angle of points on the axes.
+    double x[2] = {0.0, 0.0}, y[2] = {0.0, 0.0}, z[2] = {2.0, -2.0}, r[2], t[2], p[2];
+    fossil_math_geom_cart_to_spherical_soa(x, y, z, r, t, p, 2);
+    ASSUME_ITS_TRUE(r[0] == 2.0 && p[0] == 0.0 && t[0] == 0.0);
+    ASSUME_ITS_EQUAL_F64(p[1], FOSSIL_MATH_PI, 1e-15);
+
+    fossil_math_geom_spherical_to_cart_soa(r, t, p, x, y, z, 2);
+    ASSUME_ITS_EQUAL_F64(z[0], 2.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(z[1], -2.0, 0.0);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cloud2d_distance) {
+    fossil_math_geom_point2d pts[37];
+    for (int i = 0; i < 37; i++) {
+        pts[i].x = 0.25 * i - 3.0;
+        pts[i].y = 1.5 - 0.125 * i * i;
+    }
+    fossil_math_geom_cloud2d* cloud = fossil_math_geom_cloud2d_from_points(pts, 37);
+    ASSUME_ITS_TRUE(cloud != NULL);
+    ASSUME_ITS_TRUE(cloud->size == 37);
+    ASSUME_ITS_TRUE((uintptr_t)cloud->x % FOSSIL_MATH_ALIGNMENT == 0);
+    ASSUME_ITS_TRUE((uintptr_t)cloud->y % FOSSIL_MATH_ALIGNMENT == 0);
+
+    fossil_math_geom_point2d q = {0.5, -2.0};
+    double d[37], d2[37];
+    fossil_math_geom_cloud2d_distance(cloud, q, d);
+    fossil_math_geom_cloud2d_distance_sq(cloud, q, d2);
+    for (int i = 0; i < 37; i++) {
+        double ref = fossil_math_geom_distance2d(pts[i], q);
+        ASSUME_ITS_EQUAL_F64(d[i], ref, 1e-12);
+        ASSUME_ITS_EQUAL_F64(d2[i], ref * ref, 1e-9);
+    }
+
+    fossil_math_geom_point2d back[37];
+    fossil_math_geom_cloud2d_to_points(cloud, back);
+    ASSUME_ITS_TRUE(memcmp(back, pts, sizeof(pts)) == 0);
+    fossil_math_geom_cloud2d_destroy(cloud);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cloud3d_distance_threaded) {
+    size_t n = 200003;
+    fossil_math_geom_cloud3d* cloud = fossil_math_geom_cloud3d_create(n);
+    ASSUME_ITS_TRUE(cloud != NULL);
+    ASSUME_ITS_TRUE(cloud->z[n - 1] == 0.0);
+    for (size_t i = 0; i < n; i++) {
+        cloud->x[i] = (double)(i % 101) - 50.0;
+        cloud->y[i] = (double)(i % 7) * 0.5;
+        cloud->z[i] = (double)i * 1e-3;
+    }
+    double* d = (double*)malloc(n * sizeof(double));
+    fossil_math_geom_point3d q = {1.0, 2.0, 3.0};
+    fossil_math_set_threads(4);
+    fossil_math_geom_cloud3d_distance(cloud, q, d);
+    fossil_math_set_threads(1);
+    for (size_t i = 0; i < n; i += 997) {
+        fossil_math_geom_point3d p = {cloud->x[i], cloud->y[i], cloud->z[i]};
+        ASSUME_ITS_EQUAL_F64(d[i], fossil_math_geom_distance3d(p, q), 1e-12);
+    }
+    fossil_math_geom_point3d last = {cloud->x[n - 1], cloud->y[n - 1], cloud->z[n - 1]};
+    ASSUME_ITS_EQUAL_F64(d[n - 1], fossil_math_geom_distance3d(last, q), 1e-12);
+    free(d);
+    fossil_math_geom_cloud3d_destroy(cloud);
+
+    fossil_math_geom_cloud3d* empty = fossil_math_geom_cloud3d_create(0);
+    ASSUME_ITS_TRUE(empty != NULL && empty->size == 0);
+    fossil_math_geom_cloud3d_distance(empty, q, NULL);
+    fossil_math_geom_cloud3d_destroy(empty);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cloud2d_in_circle) {
+    size_t n = 131;
+    fossil_math_geom_cloud2d* cloud = fossil_math_geom_cloud2d_create(n);
+    for (size_t i = 0; i < n; i++) {
+        cloud->x[i] = (double)(i % 11) - 5.0;
+        cloud->y[i] = (double)(i / 11) - 5.0;
+    }
+    fossil_math_geom_circle c = {{1.0, -1.0}, 3.0};
+    uint64_t mask[FOSSIL_MATH_GEOM_MASK_WORDS(131)];
+    size_t indices[131];
+    size_t count = fossil_math_geom_cloud2d_in_circle_mask(cloud, c, mask);
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud2d_in_circle_indices(cloud, c, indices) == count);
+
+    size_t expected = 0;
+    for (size_t i = 0; i < n; i++) {
+        fossil_math_geom_point2d p = {cloud->x[i], cloud->y[i]};
+        int inside = fossil_math_geom_point_in_circle(p, c);
+        ASSUME_ITS_TRUE((int)((mask[i / 64] >> (i % 64)) & 1) == inside);
+        if (inside)
+            ASSUME_ITS_TRUE(indices[expected++] == i);
+    }
+    ASSUME_ITS_TRUE(count == expected);
+    ASSUME_ITS_TRUE(count == 29); // lattice points within radius 3, boundary included
+    ASSUME_ITS_TRUE((mask[2] >> 3) == 0);
+
+    fossil_math_geom_circle none = {{0.0, 0.0}, -1.0};
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud2d_in_circle_mask(cloud, none, mask) == 0);
+    fossil_math_geom_cloud2d_destroy(cloud);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cloud2d_in_circles_mask) {
+    size_t n = 150000;
+    fossil_math_geom_cloud2d* cloud = fossil_math_geom_cloud2d_create(n);
+    for (size_t i = 0; i < n; i++) {
+        cloud->x[i] = (double)(i % 1000) * 0.01;
+        cloud->y[i] = (double)(i / 1000) * 0.05;
+    }
+    fossil_math_geom_circle fences[3] = {{{2.0, 2.0}, 1.0}, {{5.0, 5.0}, 0.5}, {{9.0, 1.0}, 2.5}};
+    size_t words = FOSSIL_MATH_GEOM_MASK_WORDS(n);
+    uint64_t* mask = (uint64_t*)malloc(3 * words * sizeof(uint64_t));
+    fossil_math_set_threads(4);
+    size_t pairs = fossil_math_geom_cloud2d_in_circles_mask(cloud, fences, 3, mask);
+    fossil_math_set_threads(1);
+
+    size_t expected = 0;
+    for (size_t j = 0; j < 3; j++) {
+        for (size_t i = 0; i < n; i++) {
+            fossil_math_geom_point2d p = {cloud->x[i], cloud->y[i]};
+            int inside = fossil_math_geom_point_in_circle(p, fences[j]);
+            expected += (size_t)inside;
+            if ((int)((mask[j * words + i / 64] >> (i % 64)) & 1) != inside) {
+                ASSUME_ITS_TRUE(0);
+                break;
+            }
+        }
+    }
+    ASSUME_ITS_TRUE(pairs == expected);
+    ASSUME_ITS_TRUE(pairs > 0);
+    free(mask);
+    fossil_math_geom_cloud2d_destroy(cloud);
+}
+
+FOSSIL_TEST_CASE(c_math_test_affine2d_pipeline) {
+    // Scale, rotate a quarter turn, shear, then translate, as one matrix.
+    fossil_math_geom_affine2d s = fossil_math_geom_affine2d_scale(2.0, 3.0);
+    fossil_math_geom_affine2d r = fossil_math_geom_affine2d_rotate(FOSSIL_MATH_PI / 2.0);
+    fossil_math_geom_affine2d h = fossil_math_geom_affine2d_shear(0.5, 0.0);
+    fossil_math_geom_affine2d t = fossil_math_geom_affine2d_translate(1.0, -1.0);
+    fossil_math_geom_affine2d m = fossil_math_geom_affine2d_compose(&r, &s);
+    m = fossil_math_geom_affine2d_compose(&h, &m);
+    m = fossil_math_geom_affine2d_compose(&t, &m);
+
+    fossil_math_geom_point2d p = {1.0, 1.0};
+    fossil_math_geom_point2d q = fossil_math_geom_affine2d_apply(&m, p);
+    // (1, 1) -> (2, 3) -> (-3, 2) -> (-2, 2) -> (-1, 1)
+    ASSUME_ITS_EQUAL_F64(q.x, -1.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(q.y, 1.0, 1e-15);
+
+    fossil_math_geom_point2d pts[300], out[300];
+    for (int i = 0; i < 300; i++) {
+        pts[i].x = 0.01 * i;
+        pts[i].y = 1.0 - 0.02 * i;
+    }
+    fossil_math_geom_affine2d_apply_array(&m, pts, out, 300);
+    fossil_math_geom_cloud2d* cloud = fossil_math_geom_cloud2d_from_points(pts, 300);
+    fossil_math_geom_affine2d_apply_cloud(&m, cloud);
+    for (int i = 0; i < 300; i++) {
+        fossil_math_geom_point2d e = fossil_math_geom_affine2d_apply(&m, pts[i]);
+        ASSUME_ITS_EQUAL_F64(out[i].x, e.x, 1e-14);
+        ASSUME_ITS_EQUAL_F64(out[i].y, e.y, 1e-14);
+        ASSUME_ITS_EQUAL_F64(cloud->x[i], e.x, 1e-14);
+        ASSUME_ITS_EQUAL_F64(cloud->y[i], e.y, 1e-14);
+    }
+    fossil_math_geom_cloud2d_destroy(cloud);
+
+    fossil_math_geom_affine2d inv;
+    ASSUME_ITS_TRUE(fossil_math_geom_affine2d_invert(&m, &inv) == 0);
+    fossil_math_geom_point2d back = fossil_math_geom_affine2d_apply(&inv, q);
+    ASSUME_ITS_EQUAL_F64(back.x, 1.0, 1e-14);
+    ASSUME_ITS_EQUAL_F64(back.y, 1.0, 1e-14);
+    fossil_math_geom_affine2d flat = fossil_math_geom_affine2d_scale(1.0, 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_affine2d_invert(&flat, &inv) == -1);
+}
+
+FOSSIL_TEST_CASE(c_math_test_affine3d_rotate_invert) {
+    fossil_math_geom_point3d axis = {0.0, 0.0, 2.0};
+    fossil_math_geom_affine3d r = fossil_math_geom_affine3d_rotate(axis, FOSSIL_MATH_PI / 2.0);
+    fossil_math_geom_point3d p = {1.0, 0.0, 5.0};
+    fossil_math_geom_point3d q = fossil_math_geom_affine3d_apply(&r, p);
+    ASSUME_ITS_EQUAL_F64(q.x, 0.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(q.y, 1.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(q.z, 5.0, 1e-15);
+
+    fossil_math_geom_point3d diag = {1.0, 1.0, 1.0};
+    fossil_math_geom_affine3d a = fossil_math_geom_affine3d_rotate(diag, 2.0 * FOSSIL_MATH_PI / 3.0);
+    fossil_math_geom_affine3d h = fossil_math_geom_affine3d_shear(0.1, 0.2, 0.3, 0.0, -0.4, 0.5);
+    fossil_math_geom_affine3d t = fossil_math_geom_affine3d_translate(1.0, 2.0, 3.0);
+    fossil_math_geom_affine3d m = fossil_math_geom_affine3d_compose(&h, &a);
+    m = fossil_math_geom_affine3d_compose(&t, &m);
+    // A third turn about the diagonal cycles the axes.
+    fossil_math_geom_point3d e = fossil_math_geom_affine3d_apply(&a, p);
+    ASSUME_ITS_EQUAL_F64(e.x, 5.0, 1e-14);
+    ASSUME_ITS_EQUAL_F64(e.y, 1.0, 1e-14);
+    ASSUME_ITS_EQUAL_F64(e.z, 0.0, 1e-14);
+
+    fossil_math_geom_affine3d inv;
+    ASSUME_ITS_TRUE(fossil_math_geom_affine3d_invert(&m, &inv) == 0);
+    fossil_math_geom_affine3d id = fossil_math_geom_affine3d_compose(&inv, &m);
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 4; j++)
+            ASSUME_ITS_EQUAL_F64(id.m[i][j], (i == j) ? 1.0 : 0.0, 1e-14);
+
+    fossil_math_geom_point3d pts[5] = {{1, 2, 3}, {-1, 0, 4}, {0, 0, 0}, {2, 2, 2}, {7, -3, 1}};
+    fossil_math_geom_point3d out[5];
+    fossil_math_geom_affine3d_apply_array(&m, pts, out, 5);
+    for (int i = 0; i < 5; i++) {
+        fossil_math_geom_point3d x = fossil_math_geom_affine3d_apply(&m, pts[i]);
+        ASSUME_ITS_EQUAL_F64(out[i].x, x.x, 1e-14);
+        ASSUME_ITS_EQUAL_F64(out[i].z, x.z, 1e-14);
+    }
+    fossil_math_geom_affine3d flat = fossil_math_geom_affine3d_scale(1.0, 1.0, 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_affine3d_invert(&flat, &inv) == -1);
+}
+
+FOSSIL_TEST_CASE(c_math_test_quat_rotation) {
+    fossil_math_geom_point3d z = {0.0, 0.0, 1.0};
+    fossil_math_geom_point3d x = {1.0, 0.0, 0.0};
+    fossil_math_geom_quat qz = fossil_math_geom_quat_from_axis_angle(z, FOSSIL_MATH_PI / 2.0);
+    fossil_math_geom_quat qx = fossil_math_geom_quat_from_axis_angle(x, FOSSIL_MATH_PI / 2.0);
+    fossil_math_geom_point3d p = {1.0, 0.0, 0.0};
+    fossil_math_geom_point3d r = fossil_math_geom_quat_rotate(qz, p);
+    ASSUME_ITS_EQUAL_F64(r.x, 0.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(r.y, 1.0, 1e-15);
+
+    // qx * qz rotates about z first: (1, 0, 0) -> (0, 1, 0) -> (0, 0, 1).
+    fossil_math_geom_quat q = fossil_math_geom_quat_mul(qx, qz);
+    r = fossil_math_geom_quat_rotate(q, p);
+    ASSUME_ITS_EQUAL_F64(r.z, 1.0, 1e-15);
+    fossil_math_geom_point3d back = fossil_math_geom_quat_rotate(fossil_math_geom_quat_conjugate(q), r);
+    ASSUME_ITS_EQUAL_F64(back.x, 1.0, 1e-15);
+
+    // Round trip through the matrix, including the w ~ 0 branches.
+    fossil_math_geom_point3d axes[4] = {{1.0, 2.0, 3.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.1}, {0.2, 0.1, 1.0}};
+    for (int i = 0; i < 4; i++) {
+        fossil_math_geom_quat a = fossil_math_geom_quat_from_axis_angle(axes[i], 3.0);
+        fossil_math_geom_affine3d m = fossil_math_geom_quat_to_affine3d(a);
+        fossil_math_geom_quat b = fossil_math_geom_quat_from_affine3d(&m);
+        ASSUME_ITS_EQUAL_F64(b.w, a.w, 1e-14);
+        ASSUME_ITS_EQUAL_F64(b.x, a.x, 1e-14);
+        ASSUME_ITS_EQUAL_F64(b.y, a.y, 1e-14);
+        ASSUME_ITS_EQUAL_F64(b.z, a.z, 1e-14);
+    }
+
+    fossil_math_geom_point3d pts[9], out[9];
+    for (int i = 0; i < 9; i++) {
+        pts[i].x = i;
+        pts[i].y = 1.0 - i;
+        pts[i].z = 0.5 * i;
+    }
+    fossil_math_geom_quat_rotate_array(q, pts, out, 9);
+    fossil_math_geom_cloud3d* cloud = fossil_math_geom_cloud3d_from_points(pts, 9);
+    fossil_math_geom_quat_rotate_cloud(q, cloud);
+    for (int i = 0; i < 9; i++) {
+        fossil_math_geom_point3d e = fossil_math_geom_quat_rotate(q, pts[i]);
+        ASSUME_ITS_EQUAL_F64(out[i].x, e.x, 1e-14);
+        ASSUME_ITS_EQUAL_F64(out[i].y, e.y, 1e-14);
+        ASSUME_ITS_EQUAL_F64(cloud->z[i], e.z, 1e-14);
+    }
+    fossil_math_geom_cloud3d_destroy(cloud);
+}
+
+FOSSIL_TEST_CASE(c_math_test_quat_slerp) {
+    fossil_math_geom_point3d axis = {0.0, 1.0, 0.0};
+    fossil_math_geom_quat a = fossil_math_geom_quat_identity();
+    fossil_math_geom_quat b = fossil_math_geom_quat_from_axis_angle(axis, 2.0);
+    fossil_math_geom_quat m = fossil_math_geom_quat_slerp(a, b, 0.25);
+    fossil_math_geom_quat e = fossil_math_geom_quat_from_axis_angle(axis, 0.5);
+    ASSUME_ITS_EQUAL_F64(m.w, e.w, 1e-15);
+    ASSUME_ITS_EQUAL_F64(m.y, e.y, 1e-15);
+
+    // The negated end point is the same rotation; slerp takes the short arc.
+    fossil_math_geom_quat nb = {-b.w, -b.x, -b.y, -b.z};
+    m = fossil_math_geom_quat_slerp(a, nb, 0.25);
+    ASSUME_ITS_EQUAL_F64(m.w, e.w, 1e-15);
+
+    fossil_math_geom_quat qa[300], qb[300], out[300], lin[300];
+    double t[300];
+    for (int i = 0; i < 300; i++) {
+        qa[i] = fossil_math_geom_quat_from_axis_angle(axis, 0.01 * i);
+        qb[i] = fossil_math_geom_quat_from_axis_angle(axis, 0.01 * i + ((i % 3) ? 1.0 : 1e-6));
+        t[i] = (i % 7) / 6.0;
+    }
+    fossil_math_geom_quat_slerp_array(qa, qb, t, out, 300);
+    fossil_math_geom_quat_nlerp_array(qa, qb, t, lin, 300);
+    for (int i = 0; i < 300; i++) {
+        double angle = 0.01 * i + t[i] * ((i % 3) ? 1.0 : 1e-6);
+        fossil_math_geom_quat x = fossil_math_geom_quat_from_axis_angle(axis, angle);
+        ASSUME_ITS_EQUAL_F64(out[i].w, x.w, 1e-12);
+        ASSUME_ITS_EQUAL_F64(out[i].y, x.y, 1e-12);
+        double n = lin[i].w * lin[i].w + lin[i].y * lin[i].y;
+        ASSUME_ITS_EQUAL_F64(n, 1.0, 1e-15);
+    }
+    fossil_math_geom_quat end = fossil_math_geom_quat_nlerp(a, b, 1.0);
+    ASSUME_ITS_EQUAL_F64(end.y, b.y, 1e-15);
+}
+
+FOSSIL_TEST_CASE(c_math_test_convex_hull2d) {
+    // Unit square with interior points, edge midpoints and a repeated corner.
+    fossil_math_geom_point2d sq[9] = {{0.5, 0.5}, {1.0, 0.0}, {0.0, 0.0}, {1.0, 1.0}, {0.5, 0.0},
+                                      {0.0, 1.0}, {0.2, 0.7}, {1.0, 0.0}, {1.0, 0.5}};
+    size_t hull[9];
+    ASSUME_ITS_TRUE(fossil_math_geom_convex_hull2d(sq, 9, hull) == 4);
+    ASSUME_ITS_TRUE(hull[0] == 2 && hull[1] == 1 && hull[2] == 3 && hull[3] == 5);
+
+    // Degenerate inputs.
+    fossil_math_geom_point2d line[4] = {{2.0, 2.0}, {0.0, 0.0}, {1.0, 1.0}, {NAN, 0.0}};
+    ASSUME_ITS_TRUE(fossil_math_geom_convex_hull2d(line, 0, hull) == 0);
+    ASSUME_ITS_TRUE(fossil_math_geom_convex_hull2d(line, 1, hull) == 1 && hull[0] == 0);
+    ASSUME_ITS_TRUE(fossil_math_geom_convex_hull2d(line, 4, hull) == 2);
+    ASSUME_ITS_TRUE(hull[0] == 1 && hull[1] == 0);
+    ASSUME_ITS_TRUE(fossil_math_geom_convex_hull2d(line + 3, 1, hull) == 0);
+
+    // Random clouds against the hull invariants.
+    uint64_t state = 7;
+    fossil_math_geom_point2d pts[500];
+    size_t out[500];
+    for (int round = 0; round < 20; round++) {
+        size_t n = 3 + 20 * (size_t)round;
+        for (size_t i = 0; i < n; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            pts[i].x = (double)(state >> 40) / 16777216.0;
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            pts[i].y = (round % 2) ? (double)(state >> 54) : (double)(state >> 40) / 16777216.0;
+        }
+        size_t m = fossil_math_geom_convex_hull2d(pts, n, out);
+        ASSUME_ITS_TRUE(m >= 2 && m <= n);
+        ASSUME_ITS_TRUE(geom_check_hull(pts, n, out, m));
+    }
+}
+
+FOSSIL_TEST_CASE(c_math_test_convex_hull2d_parallel) {
+    size_t n = 200000;
+    fossil_math_geom_point2d* pts = (fossil_math_geom_point2d*)malloc(n * sizeof(fossil_math_geom_point2d));
+    size_t* serial = (size_t*)malloc(n * sizeof(size_t));
+    size_t* parallel = (size_t*)malloc(n * sizeof(size_t));
+    uint64_t state = 11;
+    for (size_t i = 0; i < n; i++) {
+        // Every 256th point lies on the unit circle so the hull is large.
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double a = (double)(state >> 11) / 9007199254740992.0 * 6.283185307179586;
+        double r = (i % 256) ? (double)(state >> 40) / 16777216.0 : 1.0;
+        pts[i].x = r * cos(a);
+        pts[i].y = r * sin(a);
+    }
+    size_t threads = fossil_math_get_threads();
+    fossil_math_set_threads(1);
+    size_t m1 = fossil_math_geom_convex_hull2d(pts, n, serial);
+    fossil_math_set_threads(4);
+    size_t m4 = fossil_math_geom_convex_hull2d(pts, n, parallel);
+    fossil_math_set_threads(threads);
+
+    ASSUME_ITS_TRUE(m1 == m4);
+    ASSUME_ITS_TRUE(m1 > 500);
+    ASSUME_ITS_TRUE(memcmp(serial, parallel, m1 * sizeof(size_t)) == 0);
+    ASSUME_ITS_TRUE(geom_check_hull(pts, 2000, serial, m1));
+    free(pts);
+    free(serial);
+    free(parallel);
+}
+
+FOSSIL_TEST_CASE(c_math_test_mesh_area) {
+    // Unit square split two ways, plus a stray triangle through the index buffer.
+    fossil_math_geom_point2d v2[5] = {{0.0, 0.0}, {1.0, 0.0}, {1.0, 1.0}, {0.0, 1.0}, {3.0, 5.0}};
+    size_t tris[9] = {0, 1, 2, 0, 2, 3, 4, 0, 1};
+    double areas[3], total = 0.0;
+    ASSUME_ITS_TRUE(fossil_math_geom_mesh_area2d(v2, 5, tris, 3, areas, &total) == 0);
+    ASSUME_ITS_EQUAL_F64(areas[0], 0.5, 1e-15);
+    ASSUME_ITS_EQUAL_F64(areas[1], 0.5, 1e-15);
+    ASSUME_ITS_EQUAL_F64(areas[2], fossil_math_geom_triangle_area(v2[4], v2[0], v2[1]), 1e-15);
+    ASSUME_ITS_EQUAL_F64(total, 3.5, 1e-15);
+    ASSUME_ITS_TRUE(fossil_math_geom_mesh_area2d(v2, 5, NULL, 1, NULL, &total) == 0);
+    ASSUME_ITS_EQUAL_F64(total, 0.5, 1e-15);
+    tris[7] = 5;
+    ASSUME_ITS_TRUE(fossil_math_geom_mesh_area2d(v2, 5, tris, 3, NULL, &total) == -1);
+    ASSUME_ITS_TRUE(fossil_math_geom_mesh_area2d(v2, 5, NULL, 2, NULL, &total) == -1);
+    ASSUME_ITS_TRUE(fossil_math_geom_mesh_area2d(v2, 5, NULL, 0, NULL, &total) == 0);
+    ASSUME_ITS_EQUAL_F64(total, 0.0, 0.0);
+
+    // Surface of a unit cube.
+    fossil_math_geom_point3d cube[8];
+    for (int i = 0; i < 8; i++) {
+        cube[i].x = i & 1;
+        cube[i].y = (i >> 1) & 1;
+        cube[i].z = (i >> 2) & 1;
+    }
+    size_t faces[36] = {0, 1, 3, 0, 3, 2, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+                        2, 3, 7, 2, 7, 6, 0, 2, 6, 0, 6, 4, 1, 3, 7, 1, 7, 5};
+    ASSUME_ITS_TRUE(fossil_math_geom_mesh_area3d(cube, 8, faces, 12, NULL, &total) == 0);
+    ASSUME_ITS_EQUAL_F64(total, 6.0, 1e-14);
+}
+
+FOSSIL_TEST_CASE(c_math_test_mesh_area_parallel) {
+    size_t nv = 100000, nt = 300000;
+    fossil_math_geom_point3d* v = (fossil_math_geom_point3d*)malloc(nv * sizeof(fossil_math_geom_point3d));
+    size_t* idx = (size_t*)malloc(3 * nt * sizeof(size_t));
+    double* serial = (double*)malloc(nt * sizeof(double));
+    double* parallel = (double*)malloc(nt * sizeof(double));
+    uint64_t state = 5;
+    for (size_t i = 0; i < nv; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        v[i].x = (double)(state >> 40) / 16777216.0;
+        v[i].y = (double)((state >> 16) & 0xFFFFFF) / 16777216.0;
+        v[i].z = (double)(i % 1000) / 1000.0;
+    }
+    for (size_t i = 0; i < 3 * nt; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        idx[i] = (size_t)(state >> 33) % nv;
+    }
+    double t1 = 0.0, t4 = 0.0, sum = 0.0;
+    size_t threads = fossil_math_get_threads();
+    fossil_math_set_threads(1);
+    ASSUME_ITS_TRUE(fossil_math_geom_mesh_area3d(v, nv, idx, nt, serial, &t1) == 0);
+    fossil_math_set_threads(4);
+    ASSUME_ITS_TRUE(fossil_math_geom_mesh_area3d(v, nv, idx, nt, parallel, &t4) == 0);
+    fossil_math_set_threads(threads);
+
+    // Bitwise identical regardless of the thread count.
+    ASSUME_ITS_TRUE(memcmp(&t1, &t4, sizeof(double)) == 0);
+    ASSUME_ITS_TRUE(memcmp(serial, parallel, nt * sizeof(double)) == 0);
+    for (size_t t = 0; t < nt; t++) {
+        fossil_math_geom_point3d a = v[idx[3 * t]], b = v[idx[3 * t + 1]], c = v[idx[3 * t + 2]];
+        double ux = b.x - a.x, uy = b.y - a.y, uz = b.z - a.z;
+        double wx = c.x - a.x, wy = c.y - a.y, wz = c.z - a.z;
+        double nx = uy * wz - uz * wy, ny = uz * wx - ux * wz, nz = ux * wy - uy * wx;
+        double area = 0.5 * sqrt(nx * nx + ny * ny + nz * nz);
+        ASSUME_ITS_EQUAL_F64(serial[t], area, 1e-15);
+        sum += area;
+    }
+    ASSUME_ITS_EQUAL_F64(t1, sum, 1e-9 * sum);
+    free(v);
+    free(idx);
+    free(serial);
+    free(parallel);
+}
+
+FOSSIL_TEST_CASE(c_math_test_polygon_area_perimeter) {
+    // A far-from-origin square keeps its exact area.
+    fossil_math_geom_point2d sq[4] = {{1e8, 1e8}, {1e8 + 1.0, 1e8}, {1e8 + 1.0, 1e8 + 1.0}, {1e8, 1e8 + 1.0}};
+    double area = 0.0, perimeter = 0.0;
+    ASSUME_ITS_TRUE(fossil_math_geom_polygon_area(sq, 4, NULL, 4, &area) == 0);
+    ASSUME_ITS_EQUAL_F64(area, 1.0, 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_polygon_perimeter(sq, 4, NULL, 4, &perimeter) == 0);
+    ASSUME_ITS_EQUAL_F64(perimeter, 4.0, 0.0);
+    size_t cw[4] = {0, 3, 2, 1};
+    ASSUME_ITS_TRUE(fossil_math_geom_polygon_area(sq, 4, cw, 4, &area) == 0);
+    ASSUME_ITS_EQUAL_F64(area, -1.0, 0.0);
+    cw[2] = 4;
+    ASSUME_ITS_TRUE(fossil_math_geom_polygon_area(sq, 4, cw, 4, &area) == -1);
+    ASSUME_ITS_TRUE(fossil_math_geom_polygon_perimeter(sq, 4, NULL, 5, &perimeter) == -1);
+    ASSUME_ITS_TRUE(fossil_math_geom_polygon_area(sq, 4, NULL, 0, &area) == 0);
+    ASSUME_ITS_EQUAL_F64(area, 0.0, 0.0);
+
+    // Regular polygon with enough vertices to span several blocks.
+    size_t n = 100000;
+    fossil_math_geom_point2d* ring = (fossil_math_geom_point2d*)malloc(n * sizeof(fossil_math_geom_point2d));
+    for (size_t i = 0; i < n; i++) {
+        double a = 6.283185307179586 * (double)i / (double)n;
+        ring[i].x = 2.0 * cos(a);
+        ring[i].y = 2.0 * sin(a);
+    }
+    ASSUME_ITS_TRUE(fossil_math_geom_polygon_area(ring, n, NULL, n, &area) == 0);
+    ASSUME_ITS_EQUAL_F64(area, 0.5 * (double)n * 4.0 * sin(6.283185307179586 / (double)n), 1e-9);
+    ASSUME_ITS_TRUE(fossil_math_geom_polygon_perimeter(ring, n, NULL, n, &perimeter) == 0);
+    ASSUME_ITS_EQUAL_F64(perimeter, (double)n * 4.0 * sin(3.141592653589793 / (double)n), 1e-9);
+    free(ring);
+}
+
+FOSSIL_TEST_CASE(c_math_test_prepared_plane) {
+    fossil_math_geom_plane plane = {{0.0, 3.0, 4.0}, -10.0};
+    fossil_math_geom_prepared_plane prep;
+    ASSUME_ITS_TRUE(fossil_math_geom_plane_prepare(plane, &prep) == 0);
+    ASSUME_ITS_EQUAL_F64(prep.normal.y, 0.6, 1e-15);
+    ASSUME_ITS_EQUAL_F64(prep.d, -2.0, 1e-15);
+    fossil_math_geom_point3d p = {7.0, 0.0, 0.0};
+    ASSUME_ITS_EQUAL_F64(fossil_math_geom_prepared_plane_distance(&prep, p), -2.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(fossil_math_geom_point_plane_distance(p, plane), 2.0, 1e-15);
+
+    fossil_math_geom_plane flat = {{0.0, 0.0, 0.0}, 1.0};
+    ASSUME_ITS_TRUE(fossil_math_geom_plane_prepare(flat, &prep) == -1);
+    flat.normal.x = NAN;
+    ASSUME_ITS_TRUE(fossil_math_geom_plane_prepare(flat, &prep) == -1);
+
+    fossil_math_geom_prepared_plane planes[2] = {{{1.0, 0.0, 0.0}, 0.0}, {{0.0, 0.0, -1.0}, 2.0}};
+    fossil_math_geom_point3d pts[11];
+    double out[22];
+    for (int i = 0; i < 11; i++) {
+        pts[i].x = i - 5.0;
+        pts[i].y = 1.0;
+        pts[i].z = 0.5 * i;
+    }
+    fossil_math_geom_cloud3d* cloud = fossil_math_geom_cloud3d_from_points(pts, 11);
+    fossil_math_geom_cloud3d_plane_distance(cloud, planes, 2, out);
+    for (int i = 0; i < 11; i++) {
+        ASSUME_ITS_EQUAL_F64(out[i], i - 5.0, 0.0);
+        ASSUME_ITS_EQUAL_F64(out[11 + i], 2.0 - 0.5 * i, 0.0);
+    }
+    fossil_math_geom_cloud3d_destroy(cloud);
+}
+
+FOSSIL_TEST_CASE(c_math_test_classify_planes) {
+    // Box frustum [-1, 1]^3 with inward normals; coordinates and radii are
+    // binary fractions so the brute-force sums below do not round.
+    fossil_math_geom_prepared_plane box[6] = {{{1.0, 0.0, 0.0}, 1.0}, {{-1.0, 0.0, 0.0}, 1.0},
+                                              {{0.0, 1.0, 0.0}, 1.0}, {{0.0, -1.0, 0.0}, 1.0},
+                                              {{0.0, 0.0, 1.0}, 1.0}, {{0.0, 0.0, -1.0}, 1.0}};
+    size_t n = 300000;
+    fossil_math_geom_cloud3d* cloud = fossil_math_geom_cloud3d_create(n);
+    double* radii = (double*)malloc(n * sizeof(double));
+    size_t words = FOSSIL_MATH_GEOM_MASK_WORDS(n);
+    uint64_t* in1 = (uint64_t*)malloc(words * sizeof(uint64_t));
+    uint64_t* cut1 = (uint64_t*)malloc(words * sizeof(uint64_t));
+    uint64_t* in4 = (uint64_t*)malloc(words * sizeof(uint64_t));
+    uint64_t* cut4 = (uint64_t*)malloc(words * sizeof(uint64_t));
+    uint64_t state = 3;
+    for (size_t i = 0; i < n; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        cloud->x[i] = (double)(state >> 40) / 4194304.0 - 2.0;
+        cloud->y[i] = (double)((state >> 16) & 0xFFFFFF) / 4194304.0 - 2.0;
+        cloud->z[i] = (double)(i % 401) / 128.0 - 2.0;
+        radii[i] = (double)(i % 5) * 0.125;
+    }
+    cloud->x[17] = NAN;
+
+    size_t threads = fossil_math_get_threads();
+    fossil_math_set_threads(1);
+    size_t v1 = fossil_math_geom_cloud3d_classify_planes(cloud, radii, box, 6, in1, cut1);
+    fossil_math_set_threads(4);
+    size_t v4 = fossil_math_geom_cloud3d_classify_planes(cloud, radii, box, 6, in4, cut4);
+    fossil_math_set_threads(threads);
+    ASSUME_ITS_TRUE(v1 == v4);
+    ASSUME_ITS_TRUE(memcmp(in1, in4, words * sizeof(uint64_t)) == 0);
+    ASSUME_ITS_TRUE(memcmp(cut1, cut4, words * sizeof(uint64_t)) == 0);
+
+    size_t visible = 0;
+    int ok = 1;
+    for (size_t i = 0; i < n; i++) {
+        double c[3] = {cloud->x[i], cloud->y[i], cloud->z[i]};
+        double far = 0.0;
+        for (int k = 0; k < 3; k++)
+            far = (fabs(c[k]) > far) ? fabs(c[k]) : far;
+        int in = far + radii[i] <= 1.0;
+        int out = !(far - radii[i] <= 1.0);
+        int got_in = (int)((in1[i / 64] >> (i % 64)) & 1);
+        int got_cut = (int)((cut1[i / 64] >> (i % 64)) & 1);
+        ok &= (got_in == in) && (got_cut == (!in && !out));
+        visible += !out;
+    }
+    ASSUME_ITS_TRUE(ok);
+    ASSUME_ITS_TRUE(visible == v1);
+    ASSUME_ITS_TRUE(((in1[0] | cut1[0]) & ((uint64_t)1 << 17)) == 0);
+
+    // Points alone are never intersecting.
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud3d_classify_planes(cloud, NULL, box, 6, NULL, cut1) > 0);
+    for (size_t w = 0; w < words; w++)
+        ok &= cut1[w] == 0;
+    ASSUME_ITS_TRUE(ok);
+
+    fossil_math_geom_cloud3d_destroy(cloud);
+    free(radii);
+    free(in1);
+    free(cut1);
+    free(in4);
+    free(cut4);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cloud_cdist) {
+    size_t n = 37, m = 301;
+    fossil_math_geom_cloud3d* a = fossil_math_geom_cloud3d_create(n);
+    fossil_math_geom_cloud3d* b = fossil_math_geom_cloud3d_create(m);
+    uint64_t state = 9;
+    for (size_t i = 0; i < n + m; i++) {
+        fossil_math_geom_cloud3d* c = (i < n) ? a : b;
+        size_t j = (i < n) ? i : i - n;
+        double v[3];
+        for (int d = 0; d < 3; d++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            v[d] = 1e6 + (double)(state >> 11) / 9007199254740992.0;
+        }
+        c->x[j] = v[0];
+        c->y[j] = v[1];
+        c->z[j] = v[2];
+    }
+    // Coincident and nearly coincident pairs far from the origin.
+    b->x[5] = a->x[3];
+    b->y[5] = a->y[3];
+    b->z[5] = a->z[3];
+    b->x[6] = a->x[4] + 1e-9;
+    b->y[6] = a->y[4];
+    b->z[6] = a->z[4];
+
+    double* out = (double*)malloc(n * m * sizeof(double));
+    double* sq = (double*)malloc(n * m * sizeof(double));
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud3d_cdist(a, b, out) == 0);
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud3d_cdist_sq(a, b, sq) == 0);
+    int ok = 1;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < m; j++) {
+            fossil_math_geom_point3d p = {a->x[i], a->y[i], a->z[i]}, q = {b->x[j], b->y[j], b->z[j]};
+            double e = fossil_math_geom_distance3d(p, q);
+            ok &= fabs(out[i * m + j] - e) <= 1e-12 * e;
+            ok &= fabs(sq[i * m + j] - e * e) <= 1e-12 * e * e;
+        }
+    }
+    ASSUME_ITS_TRUE(ok);
+    ASSUME_ITS_EQUAL_F64(out[3 * m + 5], 0.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(out[4 * m + 6], b->x[6] - a->x[4], 1e-15);
+
+    // 2D, including an empty column set.
+    fossil_math_geom_point2d pa[3] = {{0.0, 0.0}, {3.0, 4.0}, {-1.0, 2.0}};
+    fossil_math_geom_point2d pb[2] = {{3.0, 0.0}, {0.0, 0.0}};
+    fossil_math_geom_cloud2d* a2 = fossil_math_geom_cloud2d_from_points(pa, 3);
+    fossil_math_geom_cloud2d* b2 = fossil_math_geom_cloud2d_from_points(pb, 2);
+    fossil_math_geom_cloud2d* none = fossil_math_geom_cloud2d_create(0);
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud2d_cdist_sq(a2, b2, sq) == 0);
+    ASSUME_ITS_EQUAL_F64(sq[0], 9.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(sq[2], 16.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(sq[3], 25.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(sq[4], 20.0, 1e-14);
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud2d_cdist(a2, b2, out) == 0);
+    ASSUME_ITS_EQUAL_F64(out[3], 5.0, 1e-15);
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud2d_cdist(a2, none, out) == 0);
+
+    fossil_math_geom_cloud2d_destroy(a2);
+    fossil_math_geom_cloud2d_destroy(b2);
+    fossil_math_geom_cloud2d_destroy(none);
+    fossil_math_geom_cloud3d_destroy(a);
+    fossil_math_geom_cloud3d_destroy(b);
+    free(out);
+    free(sq);
+}
+
+FOSSIL_TEST_CASE(c_math_test_cloud_cdist_topk) {
+    size_t n = 300, m = 3000, k = 7;
+    fossil_math_geom_cloud3d* a = fossil_math_geom_cloud3d_create(n);
+    fossil_math_geom_cloud3d* b = fossil_math_geom_cloud3d_create(m);
+    uint64_t state = 21;
+    for (size_t i = 0; i < n + m; i++) {
+        fossil_math_geom_cloud3d* c = (i < n) ? a : b;
+        size_t j = (i < n) ? i : i - n;
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        c->x[j] = (double)(state >> 56);
+        c->y[j] = (double)((state >> 48) & 0xFF) / 16.0;
+        c->z[j] = (double)((state >> 40) & 0x3);
+    }
+    b->x[0] = NAN;
+    size_t* i1 = (size_t*)malloc(n * k * sizeof(size_t));
+    size_t* i4 = (size_t*)malloc(n * k * sizeof(size_t));
+    double* d1 = (double*)malloc(n * k * sizeof(double));
+    double* d4 = (double*)malloc(n * k * sizeof(double));
+    double* full = (double*)malloc(m * sizeof(double));
+
+    size_t threads = fossil_math_get_threads();
+    fossil_math_set_threads(1);
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud3d_cdist_topk(a, b, k, i1, d1) == 0);
+    fossil_math_set_threads(4);
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud3d_cdist_topk(a, b, k, i4, d4) == 0);
+    fossil_math_set_threads(threads);
+    ASSUME_ITS_TRUE(memcmp(i1, i4, n * k * sizeof(size_t)) == 0);
+    ASSUME_ITS_TRUE(memcmp(d1, d4, n * k * sizeof(double)) == 0);
+
+    // Coordinates on a 1/16 grid keep every squared distance exact, so ties
+    // are real and must resolve to the lower index.
+    int ok = 1;
+    for (size_t i = 0; i < n; i++) {
+        fossil_math_geom_point3d q = {a->x[i], a->y[i], a->z[i]};
+        fossil_math_geom_cloud3d_distance(b, q, full);
+        for (size_t r = 0; r < k; r++) {
+            size_t best = SIZE_MAX;
+            for (size_t j = 0; j < m; j++) {
+                if (full[j] != full[j])
+                    continue;
+                if (best == SIZE_MAX || full[j] < full[best])
+                    best = j;
+            }
+            ok &= i1[i * k + r] == best && d1[i * k + r] == full[best];
+            full[best] = NAN;
+        }
+    }
+    ASSUME_ITS_TRUE(ok);
+
+    // More neighbours than candidates pads the rows.
+    fossil_math_geom_cloud3d* few = fossil_math_geom_cloud3d_create(3);
+    few->x[1] = NAN;
+    ASSUME_ITS_TRUE(fossil_math_geom_cloud3d_cdist_topk(a, few, 4, i1, d1) == 0);
+    ASSUME_ITS_TRUE(i1[0] == 0 && i1[1] == 2 && i1[2] == SIZE_MAX && i1[3] == SIZE_MAX);
+    ASSUME_ITS_TRUE(isinf(d1[3]));
+
+    fossil_math_geom_cloud3d_destroy(few);
+    fossil_math_geom_cloud3d_destroy(a);
+    fossil_math_geom_cloud3d_destroy(b);
+    free(i1);
+    free(i4);
+    free(d1);
+    free(d4);
+    free(full);
+}
+
+FOSSIL_TEST_CASE(c_math_test_aabb_bounds) {
+    fossil_math_geom_point2d p2[7] = {{1.0, 2.0}, {-3.0, 5.0}, {NAN, -9.0}, {4.0, 0.5},
+                                      {0.0, -1.0}, {2.0, 2.0}, {-1.0, 7.0}};
+    fossil_math_geom_aabb2d b2 = fossil_math_geom_aabb2d_from_points(p2, 7);
+    ASSUME_ITS_TRUE(b2.lo.x == -3.0 && b2.lo.y == -9.0 && b2.hi.x == 4.0 && b2.hi.y == 7.0);
+    fossil_math_geom_point3d p3[5] = {{1.0, 2.0, 3.0}, {-1.0, 0.0, 8.0}, {5.0, -2.0, 0.0},
+                                      {0.0, 9.0, -4.0}, {2.0, 2.0, 2.0}};
+    fossil_math_geom_aabb3d b3 = fossil_math_geom_aabb3d_from_points(p3, 5);
+    ASSUME_ITS_TRUE(b3.lo.x == -1.0 && b3.lo.y == -2.0 && b3.lo.z == -4.0);
+    ASSUME_ITS_TRUE(b3.hi.x == 5.0 && b3.hi.y == 9.0 && b3.hi.z == 8.0);
+    b3 = fossil_math_geom_aabb3d_from_points(p3, 0);
+    ASSUME_ITS_TRUE(b3.lo.x == INFINITY && b3.hi.z == -INFINITY);
+    b3 = fossil_math_geom_aabb3d_merge(b3, fossil_math_geom_aabb3d_from_points(p3 + 4, 1));
+    ASSUME_ITS_TRUE(b3.lo.x == 2.0 && b3.hi.z == 2.0);
+
+    // Large clouds split across threads and must agree with a serial pass.
+    size_t n = 300001;
+    fossil_math_geom_cloud3d* cloud = fossil_math_geom_cloud3d_create(n);
+    uint64_t state = 5;
+    double lo[3] = {INFINITY, INFINITY, INFINITY}, hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+    for (size_t i = 0; i < n; i++) {
+        double* c[3] = {cloud->x, cloud->y, cloud->z};
+        for (size_t d = 0; d < 3; d++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            c[d][i] = (double)(state >> 11) / 9007199254740992.0 - 0.5;
+            lo[d] = (c[d][i] < lo[d]) ? c[d][i] : lo[d];
+            hi[d] = (c[d][i] > hi[d]) ? c[d][i] : hi[d];
+        }
+    }
+    size_t threads = fossil_math_get_threads();
+    fossil_math_set_threads(4);
+    b3 = fossil_math_geom_cloud3d_bounds(cloud);
+    fossil_math_set_threads(threads);
+    ASSUME_ITS_TRUE(b3.lo.x == lo[0] && b3.lo.y == lo[1] && b3.lo.z == lo[2]);
+    ASSUME_ITS_TRUE(b3.hi.x == hi[0] && b3.hi.y == hi[1] && b3.hi.z == hi[2]);
+
+    // Per-range boxes, their bounds and an elementwise merge.
+    size_t offsets[5] = {0, 1000, 1000, 250000, n};
+    fossil_math_geom_boxes3d* boxes = fossil_math_geom_boxes3d_create(4);
+    fossil_math_geom_boxes3d* first = fossil_math_geom_boxes3d_create(4);
+    ASSUME_ITS_TRUE(fossil_math_geom_boxes3d_from_ranges(boxes, cloud, offsets) == 0);
+    fossil_math_geom_aabb3d out[4];
+    fossil_math_geom_boxes3d_to_aabbs(boxes, out);
+    ASSUME_ITS_TRUE(out[1].lo.x == INFINITY && out[1].hi.x == -INFINITY);
+    fossil_math_geom_aabb3d range = fossil_math_geom_aabb3d_from_points(p3, 0);
+    for (size_t i = 250000; i < n; i++) {
+        fossil_math_geom_point3d q = {cloud->x[i], cloud->y[i], cloud->z[i]};
+        range = fossil_math_geom_aabb3d_merge(range, fossil_math_geom_aabb3d_from_points(&q, 1));
+    }
+    ASSUME_ITS_TRUE(memcmp(&out[3], &range, sizeof(range)) == 0);
+    fossil_math_geom_aabb3d all = fossil_math_geom_boxes3d_bounds(boxes);
+    ASSUME_ITS_TRUE(memcmp(&all, &b3, sizeof(all)) == 0);
+
+    offsets[0] = 0;
+    offsets[1] = 1;
+    offsets[2] = 2;
+    offsets[3] = 3;
+    offsets[4] = 4;
+    ASSUME_ITS_TRUE(fossil_math_geom_boxes3d_from_ranges(first, cloud, offsets) == 0);
+    ASSUME_ITS_TRUE(fossil_math_geom_boxes3d_merge(boxes, first, boxes) == 0);
+    fossil_math_geom_boxes3d_to_aabbs(boxes, out);
+    ASSUME_ITS_TRUE(out[1].lo.x == cloud->x[1] && out[1].hi.x == cloud->x[1]);
+    ASSUME_ITS_TRUE(out[0].lo.x <= cloud->x[0] && out[0].hi.x >= cloud->x[0]);
+    offsets[2] = 0;
+    ASSUME_ITS_TRUE(fossil_math_geom_boxes3d_from_ranges(first, cloud, offsets) == -1);
+    fossil_math_geom_boxes3d_destroy(first);
+    first = fossil_math_geom_boxes3d_create(3);
+    ASSUME_ITS_TRUE(fossil_math_geom_boxes3d_merge(boxes, first, boxes) == -1);
+
+    fossil_math_geom_boxes3d_destroy(first);
+    fossil_math_geom_boxes3d_destroy(boxes);
+    fossil_math_geom_cloud3d_destroy(cloud);
+}
+
+FOSSIL_TEST_CASE(c_math_test_boxes_masks) {
+    size_t n = 203;
+    fossil_math_geom_aabb2d* a2 = (fossil_math_geom_aabb2d*)malloc(n * sizeof(fossil_math_geom_aabb2d));
+    fossil_math_geom_aabb3d* a3 = (fossil_math_geom_aabb3d*)malloc(n * sizeof(fossil_math_geom_aabb3d));
+    fossil_math_geom_point2d* pts = (fossil_math_geom_point2d*)malloc(n * sizeof(fossil_math_geom_point2d));
+    uint64_t mask[FOSSIL_MATH_GEOM_MASK_WORDS(203)];
+    uint64_t state = 17;
+    // Coordinates on a 1/4 grid make touching boxes and exact circle
+    // tangencies common.
+    for (size_t i = 0; i < n; i++) {
+        double v[6];
+        for (size_t d = 0; d < 6; d++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            v[d] = (double)(state >> 59) / 4.0;
+        }
+        a2[i].lo.x = (v[0] < v[1]) ? v[0] : v[1];
+        a2[i].hi.x = (v[0] < v[1]) ? v[1] : v[0];
+        a2[i].lo.y = (v[2] < v[3]) ? v[2] : v[3];
+        a2[i].hi.y = (v[2] < v[3]) ? v[3] : v[2];
+        a3[i].lo.x = a2[i].lo.x;
+        a3[i].lo.y = a2[i].lo.y;
+        a3[i].hi.x = a2[i].hi.x;
+        a3[i].hi.y = a2[i].hi.y;
+        a3[i].lo.z = (v[4] < v[5]) ? v[4] : v[5];
+        a3[i].hi.z = (v[4] < v[5]) ? v[5] : v[4];
+        pts[i].x = v[0];
+        pts[i].y = v[3];
+    }
+    a2[7].lo.y = NAN;
+    a3[9].hi.z = NAN;
+    pts[11].x = NAN;
+    fossil_math_geom_boxes2d* boxes2 = fossil_math_geom_boxes2d_from_aabbs(a2, n);
+    fossil_math_geom_boxes3d* boxes3 = fossil_math_geom_boxes3d_from_aabbs(a3, n);
+    fossil_math_geom_cloud2d* cloud = fossil_math_geom_cloud2d_from_points(pts, n);
+
+    fossil_math_geom_aabb2d q2 = {{1.0, 2.0}, {3.0, 2.5}};
+    fossil_math_geom_aabb3d q3 = {{1.0, 2.0, 0.5}, {3.0, 2.5, 1.0}};
+    fossil_math_geom_point2d p2 = {2.0, 2.25};
+    fossil_math_geom_point3d p3 = {2.0, 2.25, 1.0};
+    fossil_math_geom_circle c = {{4.0, 1.0}, 1.25};
+    double r2 = c.radius * c.radius;
+
+    int ok = 1;
+    size_t count = fossil_math_geom_boxes2d_overlap_mask(boxes2, q2, mask), expect = 0;
+    for (size_t i = 0; i < n; i++) {
+        int hit = a2[i].lo.x <= q2.hi.x && q2.lo.x <= a2[i].hi.x && a2[i].lo.y <= q2.hi.y && q2.lo.y <= a2[i].hi.y;
+        ok &= (int)((mask[i / 64] >> (i % 64)) & 1) == hit;
+        expect += (size_t)hit;
+    }
+    ok &= count == expect;
+
+    count = fossil_math_geom_boxes3d_contains_mask(boxes3, p3, mask), expect = 0;
+    for (size_t i = 0; i < n; i++) {
+        int hit = a3[i].lo.x <= p3.x && p3.x <= a3[i].hi.x && a3[i].lo.y <= p3.y && p3.y <= a3[i].hi.y &&
+                  a3[i].lo.z <= p3.z && p3.z <= a3[i].hi.z;
+        ok &= (int)((mask[i / 64] >> (i % 64)) & 1) == hit;
+        expect += (size_t)hit;
+    }
+    ok &= count == expect;
+
+    count = fossil_math_geom_boxes3d_overlap_mask(boxes3, q3, mask), expect = 0;
+    for (size_t i = 0; i < n; i++) {
+        int hit = a3[i].lo.x <= q3.hi.x && q3.lo.x <= a3[i].hi.x && a3[i].lo.y <= q3.hi.y &&
+                  q3.lo.y <= a3[i].hi.y && a3[i].lo.z <= q3.hi.z && q3.lo.z <= a3[i].hi.z;
+        ok &= (int)((mask[i / 64] >> (i % 64)) & 1) == hit;
+        expect += (size_t)hit;
+    }
+    ok &= count == expect;
+
+    count = fossil_math_geom_boxes2d_contains_mask(boxes2, p2, mask), expect = 0;
+    for (size_t i = 0; i < n; i++) {
+        int hit = a2[i].lo.x <= p2.x && p2.x <= a2[i].hi.x && a2[i].lo.y <= p2.y && p2.y <= a2[i].hi.y;
+        ok &= (int)((mask[i / 64] >> (i % 64)) & 1) == hit;
+        expect += (size_t)hit;
+    }
+    ok &= count == expect;
+
+    count = fossil_math_geom_boxes2d_circle_mask(boxes2, c, mask), expect = 0;
+    for (size_t i = 0; i < n; i++) {
+        double cx = (c.center.x < a2[i].lo.x) ? a2[i].lo.x : (c.center.x > a2[i].hi.x) ? a2[i].hi.x : c.center.x;
+        double cy = (c.center.y < a2[i].lo.y) ? a2[i].lo.y : (c.center.y > a2[i].hi.y) ? a2[i].hi.y : c.center.y;
+        double dx = cx - c.center.x, dy = cy - c.center.y;
+        int hit = i != 7 && dx * dx + dy * dy <= r2;
+        ok &= (int)((mask[i / 64] >> (i % 64)) & 1) == hit;
+        expect += (size_t)hit;
+    }
+    ok &= count == expect && count > 0;
+
+    count = fossil_math_geom_cloud2d_in_box_mask(cloud, q2, mask), expect = 0;
+    for (size_t i = 0; i < n; i++) {
+        int hit = q2.lo.x <= pts[i].x && pts[i].x <= q2.hi.x && q2.lo.y <= pts[i].y && pts[i].y <= q2.hi.y;
+        ok &= (int)((mask[i / 64] >> (i % 64)) & 1) == hit;
+        expect += (size_t)hit;
+    }
+    ok &= count == expect;
+    ASSUME_ITS_TRUE(ok);
+    ASSUME_ITS_TRUE(mask[3] >> (n % 64) == 0);
+
+    c.radius = -1.0;
+    ASSUME_ITS_TRUE(fossil_math_geom_boxes2d_circle_mask(boxes2, c, mask) == 0);
+    fossil_math_geom_aabb2d all = fossil_math_geom_boxes2d_bounds(boxes2);
+    ASSUME_ITS_TRUE(all.lo.x == 0.0 && all.hi.x <= 7.75);
+
+    fossil_math_geom_boxes2d_destroy(boxes2);
+    fossil_math_geom_boxes3d_destroy(boxes3);
+    fossil_math_geom_cloud2d_destroy(cloud);
+    free(a2);
+    free(a3);
+    free(pts);
+}
+
+FOSSIL_TEST_CASE(c_math_test_robust_predicates) {
+    // Shewchuk's grid: p = (0.5 + i ulp, 0.5 + j ulp) against the line
+    // through (12, 12) and (24, 24) turns counterclockwise exactly when j > i.
+    fossil_math_geom_point2d q = {12.0, 12.0}, r = {24.0, 24.0};
+    double ulp = ldexp(1.0, -53);
+    int ok = 1;
+    for (int i = 0; i < 32; i++)
+        for (int j = 0; j < 32; j++) {
+            fossil_math_geom_point2d p = {0.5 + i * ulp, 0.5 + j * ulp};
+            double o = fossil_math_geom_orient2d(p, q, r);
+            ok &= (o > 0.0) == (j > i) && (o < 0.0) == (j < i);
+        }
+    ASSUME_ITS_TRUE(ok);
+
+    // Exactly degenerate inputs whose coordinate differences do not round
+    // exactly: the plane z = x + y, and the line y = x.
+    fossil_math_geom_point3d s[5] = {
+        {3.0 * 268435456.0 + ldexp(5.0, -20), -2.0 * 268435456.0, 268435456.0 + ldexp(5.0, -20)},
+        {ldexp(3.0, -30) + ldexp(1.0, -78), ldexp(7.0, -30), ldexp(10.0, -30) + ldexp(1.0, -78)},
+        {-5.0 + ldexp(3.0, -48), 6.0, 1.0 + ldexp(3.0, -48)},
+        {7.0 * 268435456.0, 268435456.0 + ldexp(1.0, -20), 8.0 * 268435456.0 + ldexp(1.0, -20)},
+        {-1.0, ldexp(-7.0, -30), -1.0 + ldexp(-7.0, -30)}};
+    ASSUME_ITS_TRUE(fossil_math_geom_orient3d(s[0], s[1], s[2], s[3]) == 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_orient3d(s[1], s[2], s[3], s[4]) == 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_insphere(s[0], s[1], s[2], s[3], s[4]) == 0.0);
+    fossil_math_geom_point2d l[4];
+    for (int i = 0; i < 4; i++) {
+        l[i].x = s[i].x;
+        l[i].y = s[i].x;
+    }
+    ASSUME_ITS_TRUE(fossil_math_geom_orient2d(l[0], l[1], l[2]) == 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_incircle(l[0], l[1], l[2], l[3]) == 0.0);
+    // One ulp off the line or plane flips the result to the right side.
+    l[3].y = nextafter(l[3].y, INFINITY);
+    ASSUME_ITS_TRUE(fossil_math_geom_orient2d(l[0], l[3], l[1]) != 0.0);
+    s[3].z = nextafter(s[3].z, INFINITY);
+    ASSUME_ITS_TRUE(fossil_math_geom_orient3d(s[0], s[1], s[2], s[3]) != 0.0);
+
+    // Plain cases and the sign conventions.
+    fossil_math_geom_point3d o = {0.0, 0.0, 0.0}, x = {1.0, 0.0, 0.0}, y = {0.0, 1.0, 0.0}, z = {0.0, 0.0, 1.0};
+    fossil_math_geom_point3d below = {0.2, 0.2, -1.0}, mid = {0.1, 0.1, 0.1}, far = {2.0, 2.0, 2.0};
+    ASSUME_ITS_TRUE(fossil_math_geom_orient3d(o, x, y, below) > 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_orient3d(o, x, y, z) < 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_insphere(o, y, x, z, mid) > 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_insphere(o, y, x, z, far) < 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_insphere(o, y, x, z, x) == 0.0);
+    fossil_math_geom_point2d a = {1.0, 0.0}, b = {0.0, 1.0}, c = {-1.0, 0.0};
+    fossil_math_geom_point2d in = {0.0, -0.5}, on = {0.0, -1.0}, out = {0.0, -1.5};
+    ASSUME_ITS_TRUE(fossil_math_geom_orient2d(a, b, c) > 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_incircle(a, b, c, in) > 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_incircle(a, b, c, on) == 0.0);
+    ASSUME_ITS_TRUE(fossil_math_geom_incircle(a, b, c, out) < 0.0);
+}
+
+FOSSIL_TEST_CASE(c_math_test_robust_predicates_batch) {
+    // Points scattered around the segment, circle and plane, many of them
+    // close enough that the SIMD filter has to hand them to the exact path.
+    size_t n = 301;
+    fossil_math_geom_point2d* p2 = (fossil_math_geom_point2d*)malloc(n * sizeof(fossil_math_geom_point2d));
+    fossil_math_geom_point3d* p3 = (fossil_math_geom_point3d*)malloc(n * sizeof(fossil_math_geom_point3d));
+    double* got = (double*)malloc(n * sizeof(double));
+    uint64_t state = 5;
+    for (size_t i = 0; i < n; i++) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        double t = (double)(state >> 11) * ldexp(1.0, -53);
+        int jitter = (int)(state >> 60) % 5 - 2;
+        double x = 0.1 + 3.0 * t, y = x;
+        for (int k = 0; k < jitter; k++)
+            y = nextafter(y, INFINITY);
+        for (int k = 0; k > jitter; k--)
+            y = nextafter(y, -INFINITY);
+        if (i % 3 == 1) {
+            x = cos(7.0 * t);
+            y = sin(7.0 * t);
+        }
+        p2[i].x = x;
+        p2[i].y = y;
+        p3[i].x = x;
+        p3[i].y = 1.0 - t;
+        p3[i].z = (i % 3 == 2) ? y + p3[i].y : y * t;
+    }
+    fossil_math_geom_cloud2d* c2 = fossil_math_geom_cloud2d_from_points(p2, n);
+    fossil_math_geom_cloud3d* c3 = fossil_math_geom_cloud3d_from_points(p3, n);
+    fossil_math_geom_point2d a = {0.1, 0.1}, b = {3.1, 3.1}, c = {-1.0, 0.0}, d = {0.0, -1.0};
+    fossil_math_geom_point2d e = {1.0, 0.0};
+    fossil_math_geom_point3d f = {0.0, 0.0, 0.0}, g = {1.0, 0.0, 1.0}, h = {0.0, 1.0, 1.0}, k = {0.5, 0.5, -0.25};
+
+    int ok = 1;
+    fossil_math_geom_cloud2d_orient2d(c2, a, b, got);
+    for (size_t i = 0; i < n; i++)
+        ok &= got[i] == fossil_math_geom_orient2d(a, b, p2[i]);
+    fossil_math_geom_cloud2d_incircle(c2, c, d, e, got);
+    for (size_t i = 0; i < n; i++)
+        ok &= got[i] == fossil_math_geom_incircle(c, d, e, p2[i]);
+    fossil_math_geom_cloud3d_orient3d(c3, f, g, h, got);
+    for (size_t i = 0; i < n; i++)
+        ok &= got[i] == fossil_math_geom_orient3d(f, g, h, p3[i]);
+    fossil_math_geom_cloud3d_insphere(c3, f, g, h, k, got);
+    for (size_t i = 0; i < n; i++)
+        ok &= got[i] == fossil_math_geom_insphere(f, g, h, k, p3[i]);
+    ASSUME_ITS_TRUE(ok);
+
+    // Nearly collinear points make the hull's turns hinge on the exact sign.
+    size_t hull[301];
+    size_t m = fossil_math_geom_convex_hull2d(p2, n, hull);
+    ASSUME_ITS_TRUE(m >= 3 && geom_check_hull(p2, n, hull, m));
+
+    fossil_math_geom_cloud2d_destroy(c2);
+    fossil_math_geom_cloud3d_destroy(c3);
+    free(p2);
+    free(p3);
+    free(got);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -93,6 +1191,31 @@ FOSSIL_TEST_GROUP(c_geom_tests) {
     FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_circle_area);
     FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_circle_circumference);
     FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_point_in_circle_inside);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_rotate2d);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_polar_conversion);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_polar_point_array);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_spherical_conversion);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_cloud2d_distance);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_cloud3d_distance_threaded);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_cloud2d_in_circle);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_cloud2d_in_circles_mask);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_affine2d_pipeline);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_affine3d_rotate_invert);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_quat_rotation);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_quat_slerp);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_convex_hull2d);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_convex_hull2d_parallel);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_mesh_area);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_mesh_area_parallel);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_polygon_area_perimeter);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_prepared_plane);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_classify_planes);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_cloud_cdist);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_cloud_cdist_topk);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_aabb_bounds);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_boxes_masks);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_robust_predicates);
+    FOSSIL_TEST_ADD(c_geom_fixture, c_math_test_robust_predicates_batch);
 
     FOSSIL_TEST_REGISTER(c_geom_fixture);
 } // end of tests
@@ -24,6 +24,7 @@
  */
 #include <fossil/pizza/framework.h>
 #include "fossil/math/framework.h"
+#include <cmath>
 
 
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -84,6 +85,242 @@ FOSSIL_TEST_CASE(cpp_math_test_point_in_circle_inside) {
     FOSSIL_TEST_ASSUME(inside, "Point should be inside the circle");
 }
 
+FOSSIL_TEST_CASE(cpp_math_test_rotate2d) {
+    std::vector<fossil_math_geom_point2d> pts = {{1.0, 0.0}, {0.0, 1.0}, {2.0, 2.0}};
+    std::vector<double> angles = {FOSSIL_MATH_PI / 2.0, FOSSIL_MATH_PI, 0.0};
+    std::vector<fossil_math_geom_point2d> out = fossil::math::Geometry::rotate_2d(pts, angles);
+    ASSUME_ITS_EQUAL_F64(out[0].x, 0.0, 1e-9);
+    ASSUME_ITS_EQUAL_F64(out[0].y, 1.0, 1e-9);
+    ASSUME_ITS_EQUAL_F64(out[1].y, -1.0, 1e-9);
+    ASSUME_ITS_EQUAL_F64(out[2].x, 2.0, 1e-9);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_polar_spherical) {
+    using fossil::math::Geometry;
+    std::vector<fossil_math_geom_point2d> pts = {{3.0, 4.0}, {-1.0, 0.0}, {0.0, -2.0}};
+    std::vector<fossil_math_geom_point2d> polar = Geometry::to_polar(pts);
+    ASSUME_ITS_EQUAL_F64(polar[0].x, 5.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(polar[1].y, FOSSIL_MATH_PI, 1e-15);
+    std::vector<fossil_math_geom_point2d> back = Geometry::from_polar(polar);
+    for (size_t i = 0; i < pts.size(); i++) {
+        ASSUME_ITS_EQUAL_F64(back[i].x, pts[i].x, 1e-15);
+        ASSUME_ITS_EQUAL_F64(back[i].y, pts[i].y, 1e-15);
+    }
+
+    std::vector<fossil_math_geom_point3d> p3 = {{1.0, 1.0, 1.0}, {0.0, 0.0, -3.0}};
+    std::vector<fossil_math_geom_point3d> sph = Geometry::to_spherical(p3);
+    ASSUME_ITS_EQUAL_F64(sph[0].x, std::sqrt(3.0), 1e-15);
+    ASSUME_ITS_EQUAL_F64(sph[0].y, FOSSIL_MATH_PI / 4.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(sph[1].z, FOSSIL_MATH_PI, 1e-15);
+    std::vector<fossil_math_geom_point3d> b3 = Geometry::from_spherical(sph);
+    ASSUME_ITS_EQUAL_F64(b3[0].z, 1.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(b3[1].z, -3.0, 1e-15);
+
+    std::vector<double> a = fossil::math::Trigonometry::atan2({1.0, -1.0}, {-1.0, -1.0});
+    ASSUME_ITS_EQUAL_F64(a[0], 3.0 * FOSSIL_MATH_PI / 4.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(a[1], -3.0 * FOSSIL_MATH_PI / 4.0, 1e-15);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_point_cloud) {
+    std::vector<fossil_math_geom_point3d> pts = {{1.0, 2.0, 2.0}, {0.0, 0.0, 0.0}, {-3.0, 0.0, 4.0}};
+    fossil::math::PointCloud3D cloud(pts);
+    ASSUME_ITS_TRUE(cloud.size() == 3);
+    std::vector<double> d = cloud.distance({0.0, 0.0, 0.0});
+    ASSUME_ITS_EQUAL_F64(d[0], 3.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(d[2], 5.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(cloud.distance_sq({1.0, 0.0, 0.0})[1], 1.0, 1e-15);
+
+    fossil::math::PointCloud2D plane(2);
+    plane.x()[1] = 3.0;
+    plane.y()[1] = 4.0;
+    fossil::math::PointCloud2D moved = std::move(plane);
+    ASSUME_ITS_EQUAL_F64(moved.distance({0.0, 0.0})[1], 5.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(moved.points()[1].y, 4.0, 0.0);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_point_cloud_in_circle) {
+    fossil::math::PointCloud2D cloud(std::vector<fossil_math_geom_point2d>{{0.0, 0.0}, {3.0, 4.0}, {5.1, 0.0}, {-1.0, 1.0}});
+    fossil_math_geom_circle c = {{0.0, 0.0}, 5.0};
+    std::vector<size_t> inside = cloud.in_circle(c);
+    ASSUME_ITS_TRUE(inside.size() == 3);
+    ASSUME_ITS_TRUE(inside[1] == 1 && inside[2] == 3);
+    ASSUME_ITS_TRUE(cloud.in_circle_mask(c)[0] == 0xBu);
+    std::vector<uint64_t> rows = cloud.in_circles_mask({c, {{5.0, 0.0}, 0.2}});
+    ASSUME_ITS_TRUE(rows.size() == 2 && rows[1] == 0x4u);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_affine_transforms) {
+    using fossil::math::Affine2D;
+    using fossil::math::Affine3D;
+    Affine2D m = Affine2D::translate(1.0, 0.0) * Affine2D::rotate(FOSSIL_MATH_PI) * Affine2D::scale(2.0, 2.0);
+    fossil_math_geom_point2d p = m.apply(fossil_math_geom_point2d{1.0, 1.0});
+    ASSUME_ITS_EQUAL_F64(p.x, -1.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(p.y, -2.0, 1e-15);
+    fossil_math_geom_point2d back = m.inverse().apply(p);
+    ASSUME_ITS_EQUAL_F64(back.x, 1.0, 1e-15);
+
+    fossil::math::PointCloud2D cloud(std::vector<fossil_math_geom_point2d>{{1.0, 1.0}, {0.0, 0.5}});
+    m.apply(cloud);
+    ASSUME_ITS_EQUAL_F64(cloud.x()[0], -1.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(cloud.y()[1], -1.0, 1e-15);
+
+    Affine3D r = Affine3D::rotate({1.0, 0.0, 0.0}, FOSSIL_MATH_PI / 2.0);
+    std::vector<fossil_math_geom_point3d> pts = r.apply(std::vector<fossil_math_geom_point3d>{{0.0, 1.0, 0.0}});
+    ASSUME_ITS_EQUAL_F64(pts[0].z, 1.0, 1e-15);
+
+    bool threw = false;
+    try {
+        Affine3D::scale(0.0, 1.0, 1.0).inverse();
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_quaternion) {
+    using fossil::math::Quaternion;
+    Quaternion q = Quaternion::from_axis_angle({0.0, 0.0, 1.0}, FOSSIL_MATH_PI);
+    fossil_math_geom_point3d p = q.rotate(fossil_math_geom_point3d{1.0, 2.0, 3.0});
+    ASSUME_ITS_EQUAL_F64(p.x, -1.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(p.y, -2.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(p.z, 3.0, 1e-15);
+
+    Quaternion back = Quaternion::from_affine(q.to_affine());
+    ASSUME_ITS_EQUAL_F64(back.get().z, 1.0, 1e-15);
+
+    Quaternion half = Quaternion::slerp(Quaternion(), q, 0.5);
+    ASSUME_ITS_EQUAL_F64(half.get().w, std::cos(FOSSIL_MATH_PI / 4.0), 1e-15);
+    std::vector<fossil_math_geom_quat> from = {Quaternion().get()}, to = {q.get()};
+    std::vector<fossil_math_geom_quat> many = Quaternion::nlerp(from, to, {0.5});
+    ASSUME_ITS_EQUAL_F64(many[0].z, std::sin(FOSSIL_MATH_PI / 4.0), 1e-15);
+
+    fossil::math::PointCloud3D cloud(std::vector<fossil_math_geom_point3d>{{0.0, 1.0, 0.0}});
+    (q * q).rotate(cloud);
+    ASSUME_ITS_EQUAL_F64(cloud.y()[0], 1.0, 1e-15);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_convex_hull) {
+    using fossil::math::Geometry;
+    std::vector<fossil_math_geom_point2d> pts = {{0.0, 0.0}, {2.0, 0.0}, {1.0, 0.5}, {2.0, 2.0}, {0.0, 2.0}, {1.0, 2.0}};
+    std::vector<size_t> hull = Geometry::convex_hull(pts);
+    ASSUME_ITS_TRUE(hull.size() == 4);
+    ASSUME_ITS_TRUE(hull[0] == 0 && hull[1] == 1 && hull[2] == 3 && hull[3] == 4);
+    ASSUME_ITS_TRUE(Geometry::convex_hull({}).empty());
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_mesh_polygon_measures) {
+    using fossil::math::Geometry;
+    std::vector<fossil_math_geom_point3d> v = {{0.0, 0.0, 0.0}, {2.0, 0.0, 0.0}, {0.0, 2.0, 0.0}, {0.0, 0.0, 2.0}};
+    std::vector<size_t> tet = {0, 1, 2, 0, 1, 3, 0, 2, 3, 1, 2, 3};
+    std::vector<double> areas = Geometry::triangle_areas(v, tet);
+    ASSUME_ITS_TRUE(areas.size() == 4);
+    ASSUME_ITS_EQUAL_F64(areas[0], 2.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(Geometry::mesh_area(v, tet), 6.0 + 2.0 * std::sqrt(3.0), 1e-14);
+
+    std::vector<fossil_math_geom_point2d> tri = {{0.0, 0.0}, {4.0, 0.0}, {0.0, 3.0}};
+    ASSUME_ITS_EQUAL_F64(Geometry::mesh_area(tri), 6.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(Geometry::polygon_area(tri), 6.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(Geometry::polygon_perimeter(tri), 12.0, 1e-15);
+
+    bool threw = false;
+    try {
+        Geometry::mesh_area(v, {0, 1, 4});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_plane_culling) {
+    using fossil::math::Geometry;
+    fossil_math_geom_prepared_plane floor = Geometry::prepare_plane({{0.0, 0.0, 2.0}, 2.0});
+    ASSUME_ITS_EQUAL_F64(Geometry::point_plane_distance(fossil_math_geom_point3d{0.0, 0.0, -3.0}, floor), -2.0, 1e-15);
+    bool threw = false;
+    try {
+        Geometry::prepare_plane({{0.0, 0.0, 0.0}, 1.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+
+    fossil::math::PointCloud3D cloud(std::vector<fossil_math_geom_point3d>{{0.0, 0.0, 1.0}, {0.0, 0.0, -0.5}, {0.0, 0.0, -3.0}});
+    std::vector<double> d = cloud.plane_distance({floor});
+    ASSUME_ITS_EQUAL_F64(d[2], -2.0, 1e-15);
+    std::vector<uint64_t> inside, intersecting;
+    ASSUME_ITS_TRUE(cloud.classify_planes({floor}, {1.0, 1.0, 1.0}, inside, intersecting) == 2);
+    ASSUME_ITS_TRUE(inside[0] == 1 && intersecting[0] == 2);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_cloud_cdist) {
+    fossil::math::PointCloud2D a(std::vector<fossil_math_geom_point2d>{{0.0, 0.0}, {10.0, 0.0}});
+    fossil::math::PointCloud2D b(std::vector<fossil_math_geom_point2d>{{3.0, 4.0}, {9.0, 0.0}, {0.0, 1.0}});
+    std::vector<double> d = a.cdist(b);
+    ASSUME_ITS_TRUE(d.size() == 6);
+    ASSUME_ITS_EQUAL_F64(d[0], 5.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(a.cdist(b, true)[4], 1.0, 1e-15);
+
+    std::vector<size_t> idx;
+    std::vector<double> dist;
+    a.cdist_topk(b, 2, idx, dist);
+    ASSUME_ITS_TRUE(idx[0] == 2 && idx[1] == 0);
+    ASSUME_ITS_TRUE(idx[2] == 1 && idx[3] == 0);
+    ASSUME_ITS_EQUAL_F64(dist[1], 5.0, 1e-15);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_boxes) {
+    std::vector<fossil_math_geom_point2d> pts{{0.0, 0.0}, {2.0, 1.0}, {5.0, 5.0}, {6.0, 4.0}};
+    fossil_math_geom_aabb2d b = fossil::math::Geometry::bounds(pts);
+    ASSUME_ITS_TRUE(b.lo.x == 0.0 && b.hi.y == 5.0);
+
+    fossil::math::PointCloud2D cloud(pts);
+    fossil::math::Boxes2D boxes(2);
+    boxes.from_ranges(cloud, {0, 2, 4});
+    ASSUME_ITS_TRUE(boxes.hi_x()[0] == 2.0 && boxes.lo_y()[1] == 4.0);
+    ASSUME_ITS_TRUE(boxes.overlap_mask({{1.0, 1.0}, {5.0, 2.0}})[0] == 1);
+    ASSUME_ITS_TRUE(boxes.contains_mask({5.5, 4.5})[0] == 2);
+    ASSUME_ITS_TRUE(boxes.circle_mask({{3.0, 3.0}, 2.25})[0] == 3);
+    ASSUME_ITS_TRUE(cloud.in_box_mask({{1.0, 0.0}, {6.0, 4.5}})[0] == 10);
+
+    bool thrown = false;
+    try {
+        boxes.from_ranges(cloud, {0, 3, 2});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    ASSUME_ITS_TRUE(thrown);
+
+    fossil::math::Boxes3D boxes3(std::vector<fossil_math_geom_aabb3d>{{{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}}});
+    boxes3.merge(fossil::math::Boxes3D(std::vector<fossil_math_geom_aabb3d>{{{2.0, -1.0, 0.5}, {3.0, 0.0, 0.5}}}));
+    fossil_math_geom_aabb3d merged = boxes3.aabbs()[0];
+    ASSUME_ITS_TRUE(merged.lo.y == -1.0 && merged.hi.x == 3.0 && merged.hi.z == 1.0);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_robust_predicates) {
+    using fossil::math::Geometry;
+    fossil_math_geom_point2d a{1.0, 0.0}, b{0.0, 1.0}, c{-1.0, 0.0};
+    ASSUME_ITS_TRUE(Geometry::orient2d(a, b, c) > 0.0);
+    ASSUME_ITS_TRUE(Geometry::orient2d(a, c, b) < 0.0);
+    ASSUME_ITS_TRUE(Geometry::incircle(a, b, c, {0.0, -1.0}) == 0.0);
+    // The plain double expression rounds this turn to zero.
+    ASSUME_ITS_TRUE(Geometry::orient2d({0.5, 0.5 + std::ldexp(1.0, -53)}, {12.0, 12.0}, {24.0, 24.0}) > 0.0);
+
+    fossil_math_geom_point3d o{0.0, 0.0, 0.0}, x{1.0, 0.0, 0.0}, y{0.0, 1.0, 0.0}, z{0.0, 0.0, 1.0};
+    ASSUME_ITS_TRUE(Geometry::orient3d(o, y, x, z) > 0.0);
+    ASSUME_ITS_TRUE(Geometry::insphere(o, y, x, z, {0.5, 0.5, 0.5}) > 0.0);
+
+    fossil::math::PointCloud2D cloud(std::vector<fossil_math_geom_point2d>{{0.0, 2.0}, {0.3, 0.3}, {2.0, 0.0}, {0.0, 0.0}});
+    std::vector<double> side = cloud.orient2d({0.1, 0.1}, {0.2, 0.2});
+    ASSUME_ITS_TRUE(side[0] > 0.0 && side[1] == 0.0 && side[2] < 0.0 && side[3] == 0.0);
+    std::vector<double> circle = cloud.incircle(a, b, c);
+    ASSUME_ITS_TRUE(circle[0] < 0.0 && circle[3] > 0.0);
+
+    fossil::math::PointCloud3D cloud3(std::vector<fossil_math_geom_point3d>{{0.2, 0.2, -1.0}, {3.0, 4.0, 0.0}, {0.1, 0.1, 0.1}});
+    std::vector<double> below = cloud3.orient3d(o, x, y);
+    ASSUME_ITS_TRUE(below[0] > 0.0 && below[1] == 0.0 && below[2] < 0.0);
+    std::vector<double> inside = cloud3.insphere(o, y, x, z);
+    ASSUME_ITS_TRUE(inside[0] < 0.0 && inside[1] < 0.0 && inside[2] > 0.0);
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -93,6 +330,18 @@ FOSSIL_TEST_GROUP(cpp_geom_tests) {
     FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_circle_area);
     FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_circle_circumference);
     FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_point_in_circle_inside);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_rotate2d);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_polar_spherical);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_point_cloud);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_point_cloud_in_circle);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_affine_transforms);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_quaternion);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_convex_hull);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_mesh_polygon_measures);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_plane_culling);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_cloud_cdist);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_boxes);
+    FOSSIL_TEST_ADD(cpp_geom_fixture, cpp_math_test_robust_predicates);
 
     FOSSIL_TEST_REGISTER(cpp_geom_fixture);
 } // end of tests
@@ -0,0 +1,134 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_SUITE(c_poly_fixture);
+
+FOSSIL_SETUP(c_poly_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_poly_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_CASE(c_math_test_poly_object_eval) {
+    double coeffs[] = {1.0, 2.0, 3.0}; // 1 + 2x + 3x^2
+    fossil_math_poly* p = fossil_math_poly_create(coeffs, 2);
+    ASSUME_ITS_TRUE(p != NULL);
+    ASSUME_ITS_TRUE(fossil_math_poly_get_scheme(p) == FOSSIL_MATH_POLY_HORNER);
+    ASSUME_ITS_EQUAL_F64(fossil_math_poly_eval(p, 2.0), 17.0, FOSSIL_TEST_FLOAT_EPSILON);
+    fossil_math_poly_destroy(p);
+}
+
+FOSSIL_TEST_CASE(c_math_test_poly_object_estrin_matches_horner) {
+    double coeffs[13];
+    for (size_t i = 0; i < 13; i++)
+        coeffs[i] = 1.0 / (double)(i + 1);
+    fossil_math_poly* p = fossil_math_poly_create(coeffs, 12);
+    ASSUME_ITS_TRUE(fossil_math_poly_get_scheme(p) == FOSSIL_MATH_POLY_ESTRIN);
+    double x = 0.75;
+    double expected = fossil_math_algebra_poly_eval(coeffs, 12, x);
+    ASSUME_ITS_EQUAL_F64(fossil_math_poly_eval(p, x), expected, 1e-12);
+    fossil_math_poly_destroy(p);
+}
+
+FOSSIL_TEST_CASE(c_math_test_poly_object_derivs_single_pass) {
+    double coeffs[] = {1.0, 2.0, 3.0, 4.0}; // 1 + 2x + 3x^2 + 4x^3
+    fossil_math_poly* p = fossil_math_poly_create(coeffs, 3);
+    double out[5];
+    ASSUME_ITS_TRUE(fossil_math_poly_eval_derivs(p, 2.0, 4, out) == 0);
+    ASSUME_ITS_EQUAL_F64(out[0], 49.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(out[1], 62.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(out[2], 54.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(out[3], 24.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(out[4], 0.0, FOSSIL_TEST_FLOAT_EPSILON);
+    fossil_math_poly_destroy(p);
+}
+
+FOSSIL_TEST_CASE(c_math_test_poly_object_cached_derivative) {
+    double coeffs[] = {1.0, 2.0, 3.0, 4.0};
+    fossil_math_poly* p = fossil_math_poly_create(coeffs, 3);
+    size_t deg = 0;
+    const double* d2 = fossil_math_poly_derivative(p, 2, &deg);
+    ASSUME_ITS_TRUE(d2 != NULL && deg == 1);
+    ASSUME_ITS_EQUAL_F64(d2[0], 6.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(d2[1], 24.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_TRUE(fossil_math_poly_derivative(p, 2, NULL) == d2);
+    ASSUME_ITS_EQUAL_F64(fossil_math_poly_eval_derivative(p, 1, 2.0), 62.0, FOSSIL_TEST_FLOAT_EPSILON);
+    fossil_math_poly_destroy(p);
+}
+
+FOSSIL_TEST_CASE(c_math_test_poly_object_eval_array) {
+    double coeffs[] = {-1.0, 0.5, 0.25};
+    fossil_math_poly* p = fossil_math_poly_create(coeffs, 2);
+    double x[11], out[11];
+    for (size_t i = 0; i < 11; i++)
+        x[i] = (double)i - 5.0;
+    fossil_math_poly_eval_array(p, x, out, 11);
+    for (size_t i = 0; i < 11; i++)
+        ASSUME_ITS_EQUAL_F64(out[i], fossil_math_poly_eval(p, x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+    fossil_math_poly_destroy(p);
+}
+
+FOSSIL_TEST_CASE(c_math_test_poly_object_newton) {
+    double coeffs[] = {-2.0, 0.0, 1.0}; // x^2 - 2
+    fossil_math_poly* p = fossil_math_poly_create(coeffs, 2);
+    double root = 0.0;
+    ASSUME_ITS_TRUE(fossil_math_poly_newton(p, 1.0, 1e-14, 50, &root) == 0);
+    ASSUME_ITS_EQUAL_F64(root, 1.4142135623730951, 1e-12);
+    fossil_math_poly_destroy(p);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_poly_tests) {
+    FOSSIL_TEST_ADD(c_poly_fixture, c_math_test_poly_object_eval);
+    FOSSIL_TEST_ADD(c_poly_fixture, c_math_test_poly_object_estrin_matches_horner);
+    FOSSIL_TEST_ADD(c_poly_fixture, c_math_test_poly_object_derivs_single_pass);
+    FOSSIL_TEST_ADD(c_poly_fixture, c_math_test_poly_object_cached_derivative);
+    FOSSIL_TEST_ADD(c_poly_fixture, c_math_test_poly_object_eval_array);
+    FOSSIL_TEST_ADD(c_poly_fixture, c_math_test_poly_object_newton);
+
+    FOSSIL_TEST_REGISTER(c_poly_fixture);
+} // end of tests
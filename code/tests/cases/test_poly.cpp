@@ -0,0 +1,90 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+#include "fossil/math/framework.h"
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_SUITE(cpp_poly_fixture);
+
+FOSSIL_SETUP(cpp_poly_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_poly_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_CASE(cpp_math_test_polynomial_eval) {
+    fossil::math::Polynomial p({1.0, 2.0, 3.0}); // 1 + 2x + 3x^2
+    ASSUME_ITS_TRUE(p.degree() == 2);
+    ASSUME_ITS_EQUAL_F64(p(2.0), 17.0, FOSSIL_TEST_FLOAT_EPSILON);
+    auto values = p.eval({0.0, 1.0});
+    ASSUME_ITS_EQUAL_F64(values[0], 1.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(values[1], 6.0, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_polynomial_derivs) {
+    fossil::math::Polynomial p({1.0, 2.0, 3.0, 4.0});
+    auto d = p.derivs(2.0, 2);
+    ASSUME_ITS_EQUAL_F64(d[0], 49.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(d[1], 62.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(d[2], 54.0, FOSSIL_TEST_FLOAT_EPSILON);
+    auto c = p.derivative(1);
+    ASSUME_ITS_TRUE(c.size() == 3);
+    ASSUME_ITS_EQUAL_F64(c[2], 12.0, FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_polynomial_newton_and_move) {
+    fossil::math::Polynomial p({-2.0, 0.0, 1.0});
+    fossil::math::Polynomial q(std::move(p));
+    ASSUME_ITS_TRUE(p.handle() == nullptr);
+    ASSUME_ITS_EQUAL_F64(q.newton(1.0), 1.4142135623730951, 1e-12);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_poly_tests) {
+    FOSSIL_TEST_ADD(cpp_poly_fixture, cpp_math_test_polynomial_eval);
+    FOSSIL_TEST_ADD(cpp_poly_fixture, cpp_math_test_polynomial_derivs);
+    FOSSIL_TEST_ADD(cpp_poly_fixture, cpp_math_test_polynomial_newton_and_move);
+
+    FOSSIL_TEST_REGISTER(cpp_poly_fixture);
+} // end of tests
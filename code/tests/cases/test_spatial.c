@@ -0,0 +1,806 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+#include "fossil/math/framework.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_SUITE(c_spatial_fixture);
+
+FOSSIL_SETUP(c_spatial_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_spatial_fixture) {
+    // Teardown the test fixture
+}
+
+static uint64_t spatial_rng_state = 0x9E3779B97F4A7C15ULL;
+
+static double spatial_rand(void) {
+    spatial_rng_state ^= spatial_rng_state << 13;
+    spatial_rng_state ^= spatial_rng_state >> 7;
+    spatial_rng_state ^= spatial_rng_state << 17;
+    return (double)(spatial_rng_state >> 11) / 9007199254740992.0;
+}
+
+static double spatial_d2_2d(fossil_math_geom_point2d a, fossil_math_geom_point2d b) {
+    double dx = a.x - b.x, dy = a.y - b.y;
+    return dx * dx + dy * dy;
+}
+
+static double spatial_d2_3d(fossil_math_geom_point3d a, fossil_math_geom_point3d b) {
+    double dx = a.x - b.x, dy = a.y - b.y, dz = a.z - b.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// Rank of point i among all points by (distance, index): the k-NN answer
+// must hold exactly the points of rank 0 .. k-1, in rank order.
+static size_t spatial_rank_2d(const fossil_math_geom_point2d* pts, size_t n, fossil_math_geom_point2d q, size_t i) {
+    double di = spatial_d2_2d(pts[i], q);
+    size_t rank = 0;
+    for (size_t j = 0; j < n; j++) {
+        double dj = spatial_d2_2d(pts[j], q);
+        rank += (dj < di || (dj == di && j < i));
+    }
+    return rank;
+}
+
+// Checks one radius query against brute force over the live points: the
+// ids must be distinct, in range, and as many as the brute-force count.
+static int spatial_grid_check_2d(const fossil_math_spatial_grid* g, const fossil_math_geom_point2d* pts,
+                                 const unsigned char* live, size_t n, fossil_math_geom_point2d q, double r) {
+    size_t* ids = (size_t*)malloc(n * sizeof(size_t));
+    unsigned char* seen = (unsigned char*)calloc(n, 1);
+    size_t found = fossil_math_spatial_grid_radius2d(g, q, r, ids, n), expect = 0;
+    int ok = found <= n;
+    for (size_t i = 0; i < n; i++)
+        expect += live[i] && spatial_d2_2d(pts[i], q) <= r * r;
+    for (size_t i = 0; ok && i < found; i++) {
+        ok = ids[i] < n && live[ids[i]] && !seen[ids[i]] && spatial_d2_2d(pts[ids[i]], q) <= r * r;
+        if (ok)
+            seen[ids[i]] = 1;
+    }
+    free(ids);
+    free(seen);
+    return ok && found == expect;
+}
+
+// Brute-force two-sided Moller-Trumbore with the same operation order as the
+// BVH, so both agree bit for bit. Returns t, or INFINITY on a miss.
+static double spatial_ray_tri(fossil_math_spatial_ray ray, const fossil_math_geom_point3d* v) {
+    double e1x = v[1].x - v[0].x, e1y = v[1].y - v[0].y, e1z = v[1].z - v[0].z;
+    double e2x = v[2].x - v[0].x, e2y = v[2].y - v[0].y, e2z = v[2].z - v[0].z;
+    double dx = ray.dir.x, dy = ray.dir.y, dz = ray.dir.z;
+    double px = dy * e2z - dz * e2y, py = dz * e2x - dx * e2z, pz = dx * e2y - dy * e2x;
+    double inv = 1.0 / (e1x * px + e1y * py + e1z * pz);
+    double sx = ray.origin.x - v[0].x, sy = ray.origin.y - v[0].y, sz = ray.origin.z - v[0].z;
+    double u = (sx * px + sy * py + sz * pz) * inv;
+    double qx = sy * e1z - sz * e1y, qy = sz * e1x - sx * e1z, qz = sx * e1y - sy * e1x;
+    double w = (dx * qx + dy * qy + dz * qz) * inv;
+    double t = (e2x * qx + e2y * qy + e2z * qz) * inv;
+    return (u >= 0.0 && w >= 0.0 && u + w <= 1.0 && t >= 0.0) ? t : INFINITY;
+}
+
+static void spatial_brute_hit(fossil_math_spatial_ray ray, const fossil_math_geom_point3d* tris, size_t n,
+                              double* t, size_t* tri) {
+    *t = INFINITY;
+    *tri = SIZE_MAX;
+    for (size_t i = 0; i < n; i++) {
+        double ti = spatial_ray_tri(ray, tris + 3 * i);
+        if (ti < *t) {
+            *t = ti;
+            *tri = i;
+        }
+    }
+}
+
+static double spatial_seg_d2(fossil_math_geom_point3d p, fossil_math_geom_point3d a, fossil_math_geom_point3d b) {
+    double ab[3] = {b.x - a.x, b.y - a.y, b.z - a.z};
+    double len = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+    double s = len > 0.0 ? ((p.x - a.x) * ab[0] + (p.y - a.y) * ab[1] + (p.z - a.z) * ab[2]) / len : 0.0;
+    s = s < 0.0 ? 0.0 : (s > 1.0 ? 1.0 : s);
+    fossil_math_geom_point3d c = {a.x + s * ab[0], a.y + s * ab[1], a.z + s * ab[2]};
+    return spatial_d2_3d(p, c);
+}
+
+// Point-triangle squared distance: the plane projection when it falls
+// inside, otherwise the nearest edge.
+static double spatial_tri_d2(fossil_math_geom_point3d p, const fossil_math_geom_point3d* v) {
+    double e1[3] = {v[1].x - v[0].x, v[1].y - v[0].y, v[1].z - v[0].z};
+    double e2[3] = {v[2].x - v[0].x, v[2].y - v[0].y, v[2].z - v[0].z};
+    double n[3] = {e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+    double nn = n[0] * n[0] + n[1] * n[1] + n[2] * n[2];
+    double best = spatial_seg_d2(p, v[0], v[1]);
+    double d = spatial_seg_d2(p, v[1], v[2]);
+    best = d < best ? d : best;
+    d = spatial_seg_d2(p, v[2], v[0]);
+    best = d < best ? d : best;
+    if (nn > 0.0) {
+        double h = ((p.x - v[0].x) * n[0] + (p.y - v[0].y) * n[1] + (p.z - v[0].z) * n[2]) / nn;
+        fossil_math_geom_point3d f = {p.x - h * n[0], p.y - h * n[1], p.z - h * n[2]};
+        double inside = 1.0;
+        for (int k = 0; k < 3; k++) {
+            fossil_math_geom_point3d a = v[k], b = v[(k + 1) % 3];
+            double ab[3] = {b.x - a.x, b.y - a.y, b.z - a.z}, af[3] = {f.x - a.x, f.y - a.y, f.z - a.z};
+            double c[3] = {ab[1] * af[2] - ab[2] * af[1], ab[2] * af[0] - ab[0] * af[2], ab[0] * af[1] - ab[1] * af[0]};
+            inside = (c[0] * n[0] + c[1] * n[1] + c[2] * n[2] >= 0.0) ? inside : 0.0;
+        }
+        if (inside > 0.0)
+            best = spatial_d2_3d(p, f);
+    }
+    return best;
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_CASE(c_math_test_kdtree_knn_radius_2d) {
+    // A coarse grid guarantees many equal distances, so ties are exercised.
+    size_t n = 1500;
+    fossil_math_geom_point2d* pts = (fossil_math_geom_point2d*)malloc(n * sizeof(*pts));
+    for (size_t i = 0; i < n; i++) {
+        pts[i].x = (i < 1000) ? spatial_rand() * 10.0 : (double)(i % 7);
+        pts[i].y = (i < 1000) ? spatial_rand() * 10.0 : (double)(i % 5);
+    }
+    fossil_math_spatial_kdtree* tree = fossil_math_spatial_kdtree_create2d(pts, n);
+    ASSUME_ITS_TRUE(tree != NULL);
+    ASSUME_ITS_TRUE(fossil_math_spatial_kdtree_size(tree) == n);
+    ASSUME_ITS_TRUE(fossil_math_spatial_kdtree_dims(tree) == 2);
+
+    size_t idx[8], found[1500];
+    double d2[8];
+    for (int t = 0; t < 20; t++) {
+        fossil_math_geom_point2d q = {(t % 2) ? spatial_rand() * 10.0 : (double)(t % 7), (t % 2) ? spatial_rand() * 10.0 : 2.0};
+        ASSUME_ITS_TRUE(fossil_math_spatial_kdtree_knn2d(tree, q, 8, idx, d2) == 8);
+        for (size_t j = 0; j < 8; j++) {
+            ASSUME_ITS_TRUE(spatial_rank_2d(pts, n, q, idx[j]) == j);
+            ASSUME_ITS_TRUE(d2[j] == spatial_d2_2d(pts[idx[j]], q));
+        }
+
+        double r = 0.25 + 0.1 * t;
+        size_t count = fossil_math_spatial_kdtree_radius2d(tree, q, r, found, n);
+        size_t expected = 0;
+        for (size_t i = 0; i < n; i++)
+            expected += spatial_d2_2d(pts[i], q) <= r * r;
+        ASSUME_ITS_TRUE(count == expected);
+        for (size_t j = 0; j < count; j++)
+            ASSUME_ITS_TRUE(spatial_d2_2d(pts[found[j]], q) <= r * r);
+        ASSUME_ITS_TRUE(fossil_math_spatial_kdtree_radius2d(tree, q, r, found, 1) == expected);
+    }
+    fossil_math_spatial_kdtree_destroy(tree);
+    free(pts);
+}
+
+FOSSIL_TEST_CASE(c_math_test_kdtree_parallel_build_batch_3d) {
+    size_t n = 100000, m = 500;
+    fossil_math_geom_point3d* pts = (fossil_math_geom_point3d*)malloc(n * sizeof(*pts));
+    fossil_math_geom_point3d* qs = (fossil_math_geom_point3d*)malloc(m * sizeof(*qs));
+    for (size_t i = 0; i < n; i++) {
+        pts[i].x = spatial_rand();
+        pts[i].y = spatial_rand() * 2.0;
+        pts[i].z = spatial_rand() * 0.5;
+    }
+    for (size_t i = 0; i < m; i++) {
+        qs[i].x = spatial_rand();
+        qs[i].y = spatial_rand() * 2.0;
+        qs[i].z = spatial_rand() * 0.5;
+    }
+    fossil_math_set_threads(4);
+    fossil_math_spatial_kdtree* tree = fossil_math_spatial_kdtree_create3d(pts, n);
+    size_t* idx = (size_t*)malloc(m * 4 * sizeof(size_t));
+    double* d2 = (double*)malloc(m * 4 * sizeof(double));
+    size_t* counts = (size_t*)malloc(m * sizeof(size_t));
+    fossil_math_spatial_kdtree_knn3d_batch(tree, qs, m, 4, idx, d2);
+    fossil_math_spatial_kdtree_radius_count3d_batch(tree, qs, m, 0.05, counts);
+    fossil_math_set_threads(1);
+    ASSUME_ITS_TRUE(tree != NULL);
+
+    for (size_t i = 0; i < m; i += 25) {
+        // Brute-force nearest neighbour and radius count.
+        size_t best = 0, within = 0;
+        for (size_t j = 0; j < n; j++) {
+            double dj = spatial_d2_3d(pts[j], qs[i]);
+            if (dj < spatial_d2_3d(pts[best], qs[i]))
+                best = j;
+            within += dj <= 0.05 * 0.05;
+        }
+        ASSUME_ITS_TRUE(idx[i * 4] == best);
+        ASSUME_ITS_TRUE(counts[i] == within);
+    }
+    for (size_t i = 0; i < m; i++) {
+        size_t one[4];
+        double dd[4];
+        fossil_math_spatial_kdtree_knn3d(tree, qs[i], 4, one, dd);
+        for (size_t j = 0; j < 4; j++)
+            ASSUME_ITS_TRUE(one[j] == idx[i * 4 + j] && dd[j] == d2[i * 4 + j]);
+        ASSUME_ITS_TRUE(d2[i * 4] <= d2[i * 4 + 1] && d2[i * 4 + 2] <= d2[i * 4 + 3]);
+    }
+    free(counts);
+    free(d2);
+    free(idx);
+    fossil_math_spatial_kdtree_destroy(tree);
+    free(qs);
+    free(pts);
+}
+
+FOSSIL_TEST_CASE(c_math_test_kdtree_small_and_empty) {
+    fossil_math_geom_point2d pts[3] = {{0.0, 0.0}, {1.0, 0.0}, {0.0, 1.0}};
+    fossil_math_spatial_kdtree* tree = fossil_math_spatial_kdtree_create2d(pts, 3);
+    size_t idx[5];
+    double d2[5];
+    fossil_math_geom_point2d q = {0.9, 0.1};
+    ASSUME_ITS_TRUE(fossil_math_spatial_kdtree_knn2d(tree, q, 5, idx, d2) == 3);
+    ASSUME_ITS_TRUE(idx[0] == 1 && idx[1] == 0 && idx[2] == 2);
+    ASSUME_ITS_TRUE(idx[3] == SIZE_MAX && isinf(d2[4]));
+    fossil_math_geom_point3d q3 = {0.0, 0.0, 0.0};
+    ASSUME_ITS_TRUE(fossil_math_spatial_kdtree_knn3d(tree, q3, 2, idx, d2) == 0);
+    ASSUME_ITS_TRUE(fossil_math_spatial_kdtree_radius2d(tree, q, -1.0, idx, 5) == 0);
+    fossil_math_spatial_kdtree_destroy(tree);
+
+    fossil_math_spatial_kdtree* empty = fossil_math_spatial_kdtree_create3d(NULL, 0);
+    ASSUME_ITS_TRUE(empty != NULL);
+    ASSUME_ITS_TRUE(fossil_math_spatial_kdtree_knn3d(empty, q3, 1, idx, d2) == 0);
+    fossil_math_spatial_kdtree_destroy(empty);
+}
+
+FOSSIL_TEST_CASE(c_math_test_grid_updates_2d) {
+    enum { N = 400 };
+    fossil_math_geom_point2d pts[N];
+    unsigned char live[N] = {0};
+    fossil_math_spatial_grid* g = fossil_math_spatial_grid_create(2, 0.05, N);
+    ASSUME_ITS_TRUE(g != NULL);
+    for (size_t i = 0; i < 300; i++) {
+        pts[i].x = spatial_rand();
+        pts[i].y = spatial_rand();
+        ASSUME_ITS_TRUE(fossil_math_spatial_grid_insert2d(g, i, pts[i]) == 0);
+        live[i] = 1;
+    }
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_insert2d(g, 7, pts[7]) == -1);
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_insert2d(g, N, pts[7]) == -1);
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_size(g) == 300);
+
+    for (int round = 0; round < 4; round++) {
+        for (int op = 0; op < 200; op++) {
+            size_t id = (size_t)(spatial_rand() * N);
+            fossil_math_geom_point2d p = {spatial_rand() * 1.2 - 0.1, spatial_rand() * 1.2 - 0.1};
+            double pick = spatial_rand();
+            if (!live[id]) {
+                ASSUME_ITS_TRUE(fossil_math_spatial_grid_move2d(g, id, p) == -1);
+                ASSUME_ITS_TRUE(fossil_math_spatial_grid_remove(g, id) == -1);
+                ASSUME_ITS_TRUE(fossil_math_spatial_grid_insert2d(g, id, p) == 0);
+                pts[id] = p;
+                live[id] = 1;
+            } else if (pick < 0.3) {
+                ASSUME_ITS_TRUE(fossil_math_spatial_grid_remove(g, id) == 0);
+                live[id] = 0;
+            } else {
+                // Small moves mostly stay in their cell; large ones change it.
+                if (pick < 0.6) {
+                    p.x = pts[id].x + 0.01 * (spatial_rand() - 0.5);
+                    p.y = pts[id].y + 0.01 * (spatial_rand() - 0.5);
+                }
+                ASSUME_ITS_TRUE(fossil_math_spatial_grid_move2d(g, id, p) == 0);
+                pts[id] = p;
+            }
+        }
+        if (round == 2)
+            ASSUME_ITS_TRUE(fossil_math_spatial_grid_rebuild(g) == 0);
+
+        size_t alive = 0;
+        for (size_t i = 0; i < N; i++) {
+            alive += live[i];
+            ASSUME_ITS_TRUE(fossil_math_spatial_grid_contains(g, i) == live[i]);
+        }
+        ASSUME_ITS_TRUE(fossil_math_spatial_grid_size(g) == alive);
+        for (int k = 0; k < 20; k++) {
+            fossil_math_geom_point2d q = {spatial_rand(), spatial_rand()};
+            double r = (k < 18) ? 0.02 + 0.1 * spatial_rand() : 0.8;
+            ASSUME_ITS_TRUE(spatial_grid_check_2d(g, pts, live, N, q, r));
+        }
+    }
+
+    // A 3D query on a 2D grid finds nothing, and 3D updates are refused.
+    fossil_math_geom_point3d q3 = {0.5, 0.5, 0.0};
+    size_t id;
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_radius3d(g, q3, 10.0, &id, 1) == 0);
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_insert3d(g, 0, q3) == -1);
+    fossil_math_spatial_grid_destroy(g);
+
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_create(4, 1.0, 8) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_create(2, 0.0, 8) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_create(3, 1.0, 0) == NULL);
+}
+
+FOSSIL_TEST_CASE(c_math_test_grid_parallel_rebuild_3d) {
+    const size_t n = 100000, m = 24;
+    fossil_math_geom_point3d* pts = (fossil_math_geom_point3d*)malloc(n * sizeof(*pts));
+    fossil_math_geom_point3d q[24];
+    size_t counts[24];
+    for (size_t i = 0; i < n; i++) {
+        pts[i].x = spatial_rand() * 10.0;
+        pts[i].y = spatial_rand() * 10.0;
+        pts[i].z = spatial_rand();
+    }
+    for (size_t j = 0; j < m; j++) {
+        q[j].x = spatial_rand() * 10.0;
+        q[j].y = spatial_rand() * 10.0;
+        q[j].z = spatial_rand();
+    }
+
+    fossil_math_set_threads(4);
+    fossil_math_spatial_grid* g = fossil_math_spatial_grid_create(3, 0.25, n);
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_assign3d(g, pts, n) == 0);
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_size(g) == n);
+    for (int pass = 0; pass < 2; pass++) {
+        fossil_math_spatial_grid_radius_count3d_batch(g, q, m, 0.3, counts);
+        for (size_t j = 0; j < m; j++) {
+            size_t expect = 0;
+            for (size_t i = 0; i < n; i++)
+                expect += spatial_d2_3d(pts[i], q[j]) <= 0.09;
+            ASSUME_ITS_TRUE(counts[j] == expect);
+        }
+        // Drift every point, then sort again.
+        for (size_t i = 0; i < n; i++) {
+            pts[i].x += 0.2 * (spatial_rand() - 0.5);
+            ASSUME_ITS_TRUE(fossil_math_spatial_grid_move3d(g, i, pts[i]) == 0);
+        }
+        ASSUME_ITS_TRUE(fossil_math_spatial_grid_rebuild(g) == 0);
+    }
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_assign3d(g, pts, 10) == 0);
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_contains(g, 9) && !fossil_math_spatial_grid_contains(g, 10));
+    ASSUME_ITS_TRUE(fossil_math_spatial_grid_radius3d(g, q[0], 100.0, NULL, 0) == 10);
+    fossil_math_set_threads(1);
+    fossil_math_spatial_grid_destroy(g);
+    free(pts);
+}
+
+FOSSIL_TEST_CASE(c_math_test_bvh_queries_vs_brute_force) {
+    // A bumpy 24 x 24 height field as an indexed mesh.
+    enum { G = 25, T = 2 * (G - 1) * (G - 1) };
+    fossil_math_geom_point3d verts[G * G], tris[3 * T];
+    size_t idx[3 * T], k = 0;
+    for (size_t j = 0; j < G; j++)
+        for (size_t i = 0; i < G; i++)
+            verts[j * G + i] = (fossil_math_geom_point3d){i / (G - 1.0), j / (G - 1.0), 0.1 * spatial_rand()};
+    for (size_t j = 0; j + 1 < G; j++) {
+        for (size_t i = 0; i + 1 < G; i++) {
+            size_t a = j * G + i, quad[6] = {a, a + 1, a + G + 1, a, a + G + 1, a + G};
+            for (size_t c = 0; c < 6; c++)
+                idx[k++] = quad[c];
+        }
+    }
+    for (size_t i = 0; i < 3 * T; i++)
+        tris[i] = verts[idx[i]];
+    fossil_math_spatial_bvh* bvh = fossil_math_spatial_bvh_create(verts, G * G, idx, T);
+    ASSUME_ITS_TRUE(bvh != NULL);
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_size(bvh) == T);
+
+    enum { R = 301 };
+    fossil_math_spatial_ray rays[R];
+    fossil_math_spatial_hit hits[R];
+    for (size_t r = 0; r < R; r++) {
+        fossil_math_geom_point3d o = {spatial_rand() * 1.2 - 0.1, spatial_rand() * 1.2 - 0.1, 1.0};
+        fossil_math_geom_point3d d = {0.2 * (spatial_rand() - 0.5), 0.2 * (spatial_rand() - 0.5), -1.0};
+        if (r % 3 == 0) {
+            // Straight down from a grid line: the slabs of boxes on that line give 0 * inf.
+            o.x = (double)(r % G) / (G - 1.0);
+            d.x = 0.0;
+            d.y = 0.0;
+        }
+        if (r % 7 == 0) {
+            o.z = -1.0;
+            d.z = 1.0;
+        }
+        rays[r] = (fossil_math_spatial_ray){o, d};
+    }
+    size_t hit_count = 0;
+    for (size_t r = 0; r < R; r++) {
+        double t;
+        size_t tri;
+        fossil_math_spatial_hit hit;
+        double t_max = (r % 5 == 0) ? 0.9 : INFINITY;
+        spatial_brute_hit(rays[r], tris, T, &t, &tri);
+        if (t > t_max) {
+            t = INFINITY;
+            tri = SIZE_MAX;
+        }
+        ASSUME_ITS_TRUE(fossil_math_spatial_bvh_intersect(bvh, rays[r], t_max, &hit) == (tri != SIZE_MAX));
+        ASSUME_ITS_TRUE(hit.triangle == tri);
+        ASSUME_ITS_TRUE(hit.t == t);
+        if (t_max == INFINITY)
+            hit_count += tri != SIZE_MAX;
+    }
+    ASSUME_ITS_TRUE(hit_count > R / 2);
+    size_t batch_count = fossil_math_spatial_bvh_intersect_batch(bvh, rays, R, INFINITY, hits);
+    size_t again = 0;
+    for (size_t r = 0; r < R; r++) {
+        fossil_math_spatial_hit hit;
+        again += (size_t)fossil_math_spatial_bvh_intersect(bvh, rays[r], INFINITY, &hit);
+        ASSUME_ITS_TRUE(hit.triangle == hits[r].triangle && hit.t == hits[r].t);
+        ASSUME_ITS_TRUE(hit.u == hits[r].u && hit.v == hits[r].v);
+    }
+    ASSUME_ITS_TRUE(batch_count == again);
+
+    for (int q = 0; q < 60; q++) {
+        fossil_math_geom_point3d p = {spatial_rand() * 2.0 - 0.5, spatial_rand() * 2.0 - 0.5, spatial_rand() - 0.5};
+        fossil_math_spatial_nearest near;
+        double best = INFINITY;
+        for (size_t i = 0; i < T; i++) {
+            double d = spatial_tri_d2(p, tris + 3 * i);
+            best = d < best ? d : best;
+        }
+        ASSUME_ITS_TRUE(fossil_math_spatial_bvh_closest(bvh, p, &near) == 0);
+        ASSUME_ITS_EQUAL_F64(near.dist_sq, best, 1e-12);
+        ASSUME_ITS_EQUAL_F64(spatial_d2_3d(near.point, p), near.dist_sq, 1e-15);
+        ASSUME_ITS_TRUE(spatial_tri_d2(near.point, tris + 3 * near.triangle) < 1e-24);
+    }
+
+    size_t found[T];
+    unsigned char* seen = (unsigned char*)calloc(T, 1);
+    for (int q = 0; q < 30; q++) {
+        double cx = spatial_rand(), cy = spatial_rand(), h = 0.02 + 0.1 * spatial_rand();
+        fossil_math_geom_aabb3d box = {{cx - h, cy - h, 0.02}, {cx + h, cy + h, 0.08}};
+        size_t n = fossil_math_spatial_bvh_overlap(bvh, box, found, T);
+        for (size_t i = 0; i < T; i++)
+            seen[i] = 0;
+        for (size_t i = 0; i < n; i++) {
+            ASSUME_ITS_TRUE(!seen[found[i]]);
+            seen[found[i]] = 1;
+        }
+        // Triangles with a vertex inside must be found; triangles whose
+        // bounds miss the box must not.
+        for (size_t i = 0; i < T; i++) {
+            int vertex_in = 0, bounds_hit = 1;
+            double lo[3] = {INFINITY, INFINITY, INFINITY}, hi[3] = {-INFINITY, -INFINITY, -INFINITY};
+            for (int c = 0; c < 3; c++) {
+                double v[3] = {tris[3 * i + c].x, tris[3 * i + c].y, tris[3 * i + c].z};
+                double b0[3] = {box.lo.x, box.lo.y, box.lo.z}, b1[3] = {box.hi.x, box.hi.y, box.hi.z};
+                int in = 1;
+                for (int a = 0; a < 3; a++) {
+                    in &= v[a] >= b0[a] && v[a] <= b1[a];
+                    lo[a] = v[a] < lo[a] ? v[a] : lo[a];
+                    hi[a] = v[a] > hi[a] ? v[a] : hi[a];
+                    if (c == 2)
+                        bounds_hit &= lo[a] <= b1[a] && hi[a] >= b0[a];
+                }
+                vertex_in |= in;
+            }
+            if (vertex_in)
+                ASSUME_ITS_TRUE(seen[i]);
+            if (!bounds_hit)
+                ASSUME_ITS_TRUE(!seen[i]);
+        }
+    }
+    free(seen);
+    fossil_math_spatial_bvh_destroy(bvh);
+}
+
+FOSSIL_TEST_CASE(c_math_test_bvh_parallel_build_packets) {
+    const size_t n = 20000, m = 2000;
+    fossil_math_geom_point3d* tris = (fossil_math_geom_point3d*)malloc(3 * n * sizeof(*tris));
+    fossil_math_spatial_ray* rays = (fossil_math_spatial_ray*)malloc(m * sizeof(*rays));
+    fossil_math_spatial_hit* a = (fossil_math_spatial_hit*)malloc(m * sizeof(*a));
+    fossil_math_spatial_hit* b = (fossil_math_spatial_hit*)malloc(m * sizeof(*b));
+    for (size_t i = 0; i < n; i++) {
+        fossil_math_geom_point3d c = {spatial_rand(), spatial_rand(), spatial_rand()};
+        for (size_t k = 0; k < 3; k++)
+            tris[3 * i + k] = (fossil_math_geom_point3d){c.x + 0.03 * (spatial_rand() - 0.5),
+                                                        c.y + 0.03 * (spatial_rand() - 0.5),
+                                                        c.z + 0.03 * (spatial_rand() - 0.5)};
+    }
+    // Coherent packets: each group of eight rays fans out from one origin.
+    for (size_t r = 0; r < m; r++) {
+        fossil_math_geom_point3d o = {0.5, 0.5, -1.0};
+        if (r / 8 % 2)
+            o = (fossil_math_geom_point3d){-1.0, 0.5 + 0.01 * (double)(r / 16 % 10), 0.5};
+        rays[r].origin = o;
+        rays[r].dir = (fossil_math_geom_point3d){0.2 + 0.6 * spatial_rand() - o.x, 0.2 + 0.6 * spatial_rand() - o.y,
+                                                 0.2 + 0.6 * spatial_rand() - o.z};
+    }
+
+    fossil_math_spatial_bvh* serial = fossil_math_spatial_bvh_create(tris, 3 * n, NULL, n);
+    fossil_math_set_threads(4);
+    fossil_math_spatial_bvh* parallel = fossil_math_spatial_bvh_create(tris, 3 * n, NULL, n);
+    ASSUME_ITS_TRUE(serial != NULL && parallel != NULL);
+    size_t ha = fossil_math_spatial_bvh_intersect_batch(parallel, rays, m, INFINITY, a);
+    fossil_math_set_threads(1);
+    size_t hb = fossil_math_spatial_bvh_intersect_batch(serial, rays, m, INFINITY, b);
+    ASSUME_ITS_TRUE(ha == hb && ha > m / 2);
+    for (size_t r = 0; r < m; r++)
+        ASSUME_ITS_TRUE(a[r].triangle == b[r].triangle && a[r].t == b[r].t);
+    for (size_t r = 0; r < m; r += 97) {
+        double t;
+        size_t tri;
+        spatial_brute_hit(rays[r], tris, n, &t, &tri);
+        ASSUME_ITS_TRUE(a[r].triangle == tri && a[r].t == t);
+    }
+    fossil_math_spatial_bvh_destroy(serial);
+    fossil_math_spatial_bvh_destroy(parallel);
+    free(tris);
+    free(rays);
+    free(a);
+    free(b);
+}
+
+FOSSIL_TEST_CASE(c_math_test_bvh_edge_cases) {
+    fossil_math_geom_point3d v[6] = {{-1.0, -1.0, 0.5}, {3.0, -1.0, 0.5}, {-1.0, 3.0, 0.5},
+                                     {3.5, 0.0, 0.0}, {0.0, 3.5, 0.0}, {0.0, 0.0, 3.5}};
+    size_t bad[3] = {0, 1, 6};
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_create(v, 6, bad, 1) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_create(v, 5, NULL, 2) == NULL);
+
+    // The first triangle cuts the unit box with no vertex inside; the second
+    // has overlapping bounds but its plane passes beyond the corner (1, 1, 1).
+    fossil_math_spatial_bvh* bvh = fossil_math_spatial_bvh_create(v, 6, NULL, 2);
+    fossil_math_geom_aabb3d box = {{0.0, 0.0, 0.0}, {1.0, 1.0, 1.0}};
+    size_t found[2];
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_overlap(bvh, box, found, 2) == 1 && found[0] == 0);
+
+    // A vertical ray whose origin lies on the face x = -1 of the root box.
+    fossil_math_spatial_ray ray = {{-1.0, 0.0, 2.0}, {0.0, 0.0, -1.0}};
+    fossil_math_spatial_hit hit;
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_intersect(bvh, ray, INFINITY, &hit) == 1);
+    ASSUME_ITS_TRUE(hit.triangle == 0 && hit.t == 1.5);
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_intersect(bvh, ray, 1.0, &hit) == 0);
+    ASSUME_ITS_TRUE(hit.triangle == SIZE_MAX && hit.t == INFINITY);
+
+    fossil_math_spatial_nearest near;
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_closest(bvh, (fossil_math_geom_point3d){0.0, 0.0, 0.0}, &near) == 0);
+    ASSUME_ITS_TRUE(near.triangle == 0);
+    ASSUME_ITS_EQUAL_F64(near.dist_sq, 0.25, 1e-15);
+    fossil_math_spatial_bvh_destroy(bvh);
+
+    fossil_math_spatial_bvh* empty = fossil_math_spatial_bvh_create(NULL, 0, NULL, 0);
+    ASSUME_ITS_TRUE(empty != NULL && fossil_math_spatial_bvh_size(empty) == 0);
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_intersect(empty, ray, INFINITY, &hit) == 0);
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_closest(empty, v[0], &near) == -1);
+    ASSUME_ITS_TRUE(fossil_math_spatial_bvh_overlap(empty, box, found, 2) == 0);
+    fossil_math_spatial_bvh_destroy(empty);
+}
+
+FOSSIL_TEST_CASE(c_math_test_curve_keys) {
+    ASSUME_ITS_TRUE(fossil_math_spatial_morton2d(3, 5) == 39);
+    ASSUME_ITS_TRUE(fossil_math_spatial_morton2d(0xFFFFFFFFu, 0) == 0x5555555555555555ULL);
+    ASSUME_ITS_TRUE(fossil_math_spatial_morton3d(1, 2, 4) == 273);
+    ASSUME_ITS_TRUE(fossil_math_spatial_morton3d(0xFFFFFFFFu, 0, 0) == 0x1249249249249249ULL);
+    ASSUME_ITS_TRUE(fossil_math_spatial_hilbert2d(0, 0) == 0 && fossil_math_spatial_hilbert3d(0, 0, 0) == 0);
+
+    // Walking a Hilbert curve visits every cell once and always steps to a
+    // neighbouring cell, both over the low bits (fine levels) and the high
+    // bits (coarse levels) of the coordinates.
+    int ok = 1;
+    for (unsigned shift = 0; shift <= 26; shift += 26) {
+        uint32_t* cells = (uint32_t*)malloc(2 * 4096 * sizeof(uint32_t));
+        unsigned char* seen = (unsigned char*)calloc(4096, 1);
+        for (uint32_t x = 0; x < 64; x++) {
+            for (uint32_t y = 0; y < 64; y++) {
+                uint64_t h = fossil_math_spatial_hilbert2d(x << shift, y << shift) >> (2 * shift);
+                ok &= h < 4096 && !seen[h];
+                if (h < 4096) {
+                    seen[h] = 1;
+                    cells[2 * h] = x;
+                    cells[2 * h + 1] = y;
+                }
+            }
+        }
+        for (size_t i = 1; ok && i < 4096; i++) {
+            uint32_t dx = cells[2 * i] > cells[2 * i - 2] ? cells[2 * i] - cells[2 * i - 2] : cells[2 * i - 2] - cells[2 * i];
+            uint32_t dy = cells[2 * i + 1] > cells[2 * i - 1] ? cells[2 * i + 1] - cells[2 * i - 1]
+                                                             : cells[2 * i - 1] - cells[2 * i + 1];
+            ok &= dx + dy == 1;
+        }
+        free(cells);
+        free(seen);
+    }
+    for (unsigned shift = 0; shift <= 17; shift += 17) {
+        uint32_t* cells = (uint32_t*)malloc(3 * 4096 * sizeof(uint32_t));
+        unsigned char* seen = (unsigned char*)calloc(4096, 1);
+        for (uint32_t c = 0; c < 4096; c++) {
+            uint32_t v[3] = {c & 15, (c >> 4) & 15, c >> 8};
+            uint64_t h = fossil_math_spatial_hilbert3d(v[0] << shift, v[1] << shift, v[2] << shift) >> (3 * shift);
+            ok &= h < 4096 && !seen[h];
+            if (h < 4096) {
+                seen[h] = 1;
+                memcpy(cells + 3 * h, v, sizeof(v));
+            }
+        }
+        for (size_t i = 1; ok && i < 4096; i++) {
+            uint32_t step = 0;
+            for (size_t d = 0; d < 3; d++) {
+                uint32_t a = cells[3 * i + d], b = cells[3 * i - 3 + d];
+                step += a > b ? a - b : b - a;
+            }
+            ok &= step == 1;
+        }
+        free(cells);
+        free(seen);
+    }
+    ASSUME_ITS_TRUE(ok);
+
+    // Point keys quantize over the box: (i + 0.5, j + 0.5) in a 16 x 16 box
+    // lies at the centre of cell (i, j) of a 2^4 grid.
+    fossil_math_geom_point2d p[19];
+    uint64_t keys[19];
+    fossil_math_geom_aabb2d box = {{0.0, 0.0}, {16.0, 16.0}};
+    for (size_t i = 0; i < 16; i++) {
+        p[i].x = (double)i + 0.5;
+        p[i].y = (double)(15 - i) + 0.5;
+    }
+    p[16].x = NAN;
+    p[16].y = 3.5;
+    p[17].x = -5.0;
+    p[17].y = 99.0;
+    p[18].x = 16.0;
+    p[18].y = 0.0;
+    fossil_math_spatial_curve_keys2d(p, 19, box, FOSSIL_MATH_SPATIAL_MORTON, keys);
+    for (uint32_t i = 0; i < 16; i++)
+        ok &= keys[i] == fossil_math_spatial_morton2d((i << 28) | (1u << 27), ((15 - i) << 28) | (1u << 27));
+    ok &= keys[16] == fossil_math_spatial_morton2d(0, (3u << 28) | (1u << 27));
+    ok &= keys[17] == fossil_math_spatial_morton2d(0, 0xFFFFFFFFu);
+    ok &= keys[18] == fossil_math_spatial_morton2d(0xFFFFFFFFu, 0);
+    fossil_math_spatial_curve_keys2d(p, 19, box, FOSSIL_MATH_SPATIAL_HILBERT, keys);
+    ok &= keys[5] == fossil_math_spatial_hilbert2d((5u << 28) | (1u << 27), (10u << 28) | (1u << 27));
+
+    fossil_math_geom_point3d q[5] = {{0.0, 1.0, 2.0}, {4.0, 1.0, 2.0}, {2.0, 1.0, 0.0}, {1.0, 1.0, 1.0}, {3.0, 1.0, 4.0}};
+    fossil_math_geom_aabb3d box3 = fossil_math_geom_aabb3d_from_points(q, 5);
+    fossil_math_spatial_curve_keys3d(q, 5, box3, FOSSIL_MATH_SPATIAL_MORTON, keys);
+    // y is flat, so every point is in y cell 0; 4.0 is the top cell.
+    ok &= keys[0] == fossil_math_spatial_morton3d(0, 0, 1u << 20);
+    ok &= keys[1] == fossil_math_spatial_morton3d(0x1FFFFF, 0, 1u << 20);
+    ok &= keys[3] == fossil_math_spatial_morton3d(1u << 19, 0, 1u << 19);
+    ASSUME_ITS_TRUE(ok);
+}
+
+FOSSIL_TEST_CASE(c_math_test_radix_sort_parallel) {
+    size_t n = 200003;
+    uint64_t* keys = (uint64_t*)malloc(n * sizeof(uint64_t));
+    uint64_t* serial = (uint64_t*)malloc(n * sizeof(uint64_t));
+    uint64_t* parallel = (uint64_t*)malloc(n * sizeof(uint64_t));
+    size_t* o1 = (size_t*)malloc(n * sizeof(size_t));
+    size_t* o4 = (size_t*)malloc(n * sizeof(size_t));
+    // Few distinct values in the middle bytes and none in the top bytes, so
+    // there are long runs of equal keys and skipped passes.
+    for (size_t i = 0; i < n; i++) {
+        spatial_rand();
+        keys[i] = (spatial_rng_state & 0xFF) | ((spatial_rng_state >> 40) & 0x3) << 24;
+    }
+    memcpy(serial, keys, n * sizeof(uint64_t));
+    memcpy(parallel, keys, n * sizeof(uint64_t));
+    size_t threads = fossil_math_get_threads();
+    fossil_math_set_threads(1);
+    ASSUME_ITS_TRUE(fossil_math_spatial_radix_sort(serial, o1, n) == 0);
+    fossil_math_set_threads(4);
+    ASSUME_ITS_TRUE(fossil_math_spatial_radix_sort(parallel, o4, n) == 0);
+    fossil_math_set_threads(threads);
+    ASSUME_ITS_TRUE(memcmp(serial, parallel, n * sizeof(uint64_t)) == 0);
+    ASSUME_ITS_TRUE(memcmp(o1, o4, n * sizeof(size_t)) == 0);
+
+    int ok = 1;
+    for (size_t i = 0; i < n; i++) {
+        ok &= o1[i] < n && serial[i] == keys[o1[i]];
+        if (i > 0)
+            ok &= serial[i - 1] < serial[i] || (serial[i - 1] == serial[i] && o1[i - 1] < o1[i]);
+    }
+    ASSUME_ITS_TRUE(ok);
+
+    uint64_t few[5] = {~(uint64_t)0, 7, 1ULL << 63, 7, 0};
+    size_t order[5];
+    ASSUME_ITS_TRUE(fossil_math_spatial_radix_sort(few, order, 5) == 0);
+    ASSUME_ITS_TRUE(few[0] == 0 && few[1] == 7 && few[2] == 7 && few[3] == 1ULL << 63 && few[4] == ~(uint64_t)0);
+    ASSUME_ITS_TRUE(order[0] == 4 && order[1] == 1 && order[2] == 3 && order[3] == 2 && order[4] == 0);
+    ASSUME_ITS_TRUE(fossil_math_spatial_radix_sort(few, order, 0) == 0);
+
+    free(keys);
+    free(serial);
+    free(parallel);
+    free(o1);
+    free(o4);
+}
+
+FOSSIL_TEST_CASE(c_math_test_curve_sort_points) {
+    size_t n = 20000;
+    fossil_math_geom_point3d* pts = (fossil_math_geom_point3d*)malloc(n * sizeof(fossil_math_geom_point3d));
+    fossil_math_geom_point3d* orig = (fossil_math_geom_point3d*)malloc(n * sizeof(fossil_math_geom_point3d));
+    double* mass = (double*)malloc(n * sizeof(double));
+    double* sorted_mass = (double*)malloc(n * sizeof(double));
+    uint64_t* keys = (uint64_t*)malloc(n * sizeof(uint64_t));
+    size_t* order = (size_t*)malloc(n * sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {
+        pts[i].x = spatial_rand();
+        pts[i].y = spatial_rand();
+        pts[i].z = spatial_rand();
+        mass[i] = (double)i;
+    }
+    memcpy(orig, pts, n * sizeof(fossil_math_geom_point3d));
+    double before = 0.0, after = 0.0;
+    for (size_t i = 1; i < n; i++)
+        before += sqrt(spatial_d2_3d(pts[i - 1], pts[i]));
+
+    int ok = 1;
+    for (int curve = 0; curve < 2; curve++) {
+        memcpy(pts, orig, n * sizeof(fossil_math_geom_point3d));
+        ASSUME_ITS_TRUE(fossil_math_spatial_curve_sort3d(pts, n, (fossil_math_spatial_curve)curve, order) == 0);
+        fossil_math_spatial_gather(mass, sizeof(double), order, n, sorted_mass);
+        for (size_t i = 0; i < n; i++)
+            ok &= memcmp(&pts[i], &orig[order[i]], sizeof(fossil_math_geom_point3d)) == 0 &&
+                  sorted_mass[i] == (double)order[i];
+        // The bounding box does not change, so the keys come out sorted.
+        fossil_math_spatial_curve_keys3d(pts, n, fossil_math_geom_aabb3d_from_points(pts, n),
+                                         (fossil_math_spatial_curve)curve, keys);
+        for (size_t i = 1; i < n; i++)
+            ok &= keys[i - 1] <= keys[i];
+        after = 0.0;
+        for (size_t i = 1; i < n; i++)
+            after += sqrt(spatial_d2_3d(pts[i - 1], pts[i]));
+        ok &= after < 0.1 * before;
+    }
+    ASSUME_ITS_TRUE(ok);
+
+    fossil_math_geom_point2d p2[3] = {{1.0, 1.0}, {0.0, 0.0}, {1.0, 0.0}};
+    ASSUME_ITS_TRUE(fossil_math_spatial_curve_sort2d(p2, 3, FOSSIL_MATH_SPATIAL_HILBERT, NULL) == 0);
+    ASSUME_ITS_TRUE(p2[0].x == 0.0 && p2[2].x == 1.0 && p2[2].y == 0.0);
+
+    free(pts);
+    free(orig);
+    free(mass);
+    free(sorted_mass);
+    free(keys);
+    free(order);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_spatial_tests) {
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_kdtree_knn_radius_2d);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_kdtree_parallel_build_batch_3d);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_kdtree_small_and_empty);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_grid_updates_2d);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_grid_parallel_rebuild_3d);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_bvh_queries_vs_brute_force);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_bvh_parallel_build_packets);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_bvh_edge_cases);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_curve_keys);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_radix_sort_parallel);
+    FOSSIL_TEST_ADD(c_spatial_fixture, c_math_test_curve_sort_points);
+
+    FOSSIL_TEST_REGISTER(c_spatial_fixture);
+} // end of tests
@@ -0,0 +1,183 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+#include "fossil/math/framework.h"
+#include <algorithm>
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_SUITE(cpp_spatial_fixture);
+
+FOSSIL_SETUP(cpp_spatial_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_spatial_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_CASE(cpp_math_test_kdtree) {
+    std::vector<fossil_math_geom_point2d> pts;
+    for (int i = 0; i < 100; i++)
+        pts.push_back({static_cast<double>(i % 10), static_cast<double>(i / 10)});
+    fossil::math::KdTree tree(pts);
+    ASSUME_ITS_TRUE(tree.size() == 100 && tree.dims() == 2);
+
+    fossil::math::KdTree::Neighbors nn = tree.knn(fossil_math_geom_point2d{4.2, 5.1}, 3);
+    ASSUME_ITS_TRUE(nn.indices.size() == 3);
+    ASSUME_ITS_TRUE(nn.indices[0] == 54);
+    ASSUME_ITS_EQUAL_F64(nn.dist_sq[0], 0.05, 1e-14);
+
+    // 21 lattice points lie within radius 2.5 of a lattice point.
+    ASSUME_ITS_TRUE(tree.radius(fossil_math_geom_point2d{5.0, 5.0}, 2.5).size() == 21);
+
+    std::vector<size_t> rows = tree.knn(std::vector<fossil_math_geom_point2d>{{0.0, 0.0}, {9.0, 9.0}}, 2);
+    ASSUME_ITS_TRUE(rows[0] == 0 && rows[2] == 99);
+
+    bool threw = false;
+    try {
+        tree.knn(fossil_math_geom_point3d{0.0, 0.0, 0.0}, 1);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_spatial_grid) {
+    fossil::math::SpatialGrid grid(2, 1.0, 200);
+    std::vector<fossil_math_geom_point2d> pts;
+    for (int i = 0; i < 100; i++)
+        pts.push_back({static_cast<double>(i % 10), static_cast<double>(i / 10)});
+    grid.assign(pts);
+    ASSUME_ITS_TRUE(grid.size() == 100);
+
+    // 21 lattice points lie within radius 2.5 of a lattice point.
+    ASSUME_ITS_TRUE(grid.radius(fossil_math_geom_point2d{5.0, 5.0}, 2.5).size() == 21);
+
+    grid.move(55, fossil_math_geom_point2d{50.0, 50.0});
+    grid.remove(44);
+    grid.insert(150, fossil_math_geom_point2d{5.5, 5.5});
+    std::vector<size_t> near = grid.radius(fossil_math_geom_point2d{5.0, 5.0}, 2.5);
+    ASSUME_ITS_TRUE(near.size() == 20);
+    ASSUME_ITS_TRUE(std::find(near.begin(), near.end(), 150) != near.end());
+    ASSUME_ITS_TRUE(grid.radius(fossil_math_geom_point2d{50.0, 50.0}, 0.0).size() == 1);
+    ASSUME_ITS_TRUE(!grid.contains(44) && grid.contains(150));
+
+    bool threw = false;
+    try {
+        grid.insert(150, fossil_math_geom_point2d{0.0, 0.0});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_triangle_bvh) {
+    // The unit square in the plane z = 0 as two indexed triangles.
+    std::vector<fossil_math_geom_point3d> verts = {{0.0, 0.0, 0.0}, {1.0, 0.0, 0.0}, {1.0, 1.0, 0.0}, {0.0, 1.0, 0.0}};
+    fossil::math::TriangleBvh bvh(verts, {0, 1, 2, 0, 2, 3});
+    ASSUME_ITS_TRUE(bvh.size() == 2);
+
+    fossil_math_spatial_hit hit = bvh.intersect(fossil_math_spatial_ray{{0.75, 0.25, 2.0}, {0.0, 0.0, -1.0}});
+    ASSUME_ITS_TRUE(hit.triangle == 0);
+    ASSUME_ITS_EQUAL_F64(hit.t, 2.0, 1e-15);
+    ASSUME_ITS_TRUE(bvh.intersect(fossil_math_spatial_ray{{2.0, 2.0, 2.0}, {0.0, 0.0, -1.0}}).triangle == SIZE_MAX);
+
+    std::vector<fossil_math_spatial_ray> rays = {{{0.25, 0.75, -1.0}, {0.0, 0.0, 1.0}}, {{0.5, 0.5, 1.0}, {1.0, 0.0, 0.0}}};
+    std::vector<fossil_math_spatial_hit> hits = bvh.intersect(rays);
+    ASSUME_ITS_TRUE(hits[0].triangle == 1 && hits[1].triangle == SIZE_MAX);
+
+    fossil_math_spatial_nearest near = bvh.closest(fossil_math_geom_point3d{2.0, 0.5, 1.0});
+    ASSUME_ITS_EQUAL_F64(near.dist_sq, 2.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(near.point.x, 1.0, 1e-15);
+
+    std::vector<size_t> found = bvh.overlap(fossil_math_geom_aabb3d{{0.8, 0.1, -0.1}, {0.9, 0.2, 0.1}});
+    ASSUME_ITS_TRUE(found.size() == 1 && found[0] == 0);
+
+    bool threw = false;
+    try {
+        fossil::math::TriangleBvh broken(verts, {0, 1, 4});
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    ASSUME_ITS_TRUE(threw);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_space_filling_curve) {
+    std::vector<fossil_math_geom_point2d> points;
+    std::vector<int> labels;
+    for (int i = 0; i < 100; i++) {
+        points.push_back({(double)((i * 37) % 10), (double)((i * 37) / 10 % 10)});
+        labels.push_back(i);
+    }
+    std::vector<fossil_math_geom_point2d> sorted = points;
+    std::vector<size_t> order = fossil::math::SpaceFillingCurve::sort(sorted);
+    std::vector<int> moved = fossil::math::SpaceFillingCurve::gather(labels, order);
+    for (size_t i = 0; i < points.size(); i++) {
+        ASSUME_ITS_TRUE(moved[i] == (int)order[i]);
+        ASSUME_ITS_TRUE(sorted[i].x == points[order[i]].x && sorted[i].y == points[order[i]].y);
+    }
+    std::vector<uint64_t> keys = fossil::math::SpaceFillingCurve::keys(sorted);
+    ASSUME_ITS_TRUE(std::is_sorted(keys.begin(), keys.end()));
+
+    std::vector<uint64_t> morton = fossil::math::SpaceFillingCurve::keys(points, FOSSIL_MATH_SPATIAL_MORTON);
+    std::vector<size_t> by_key = fossil::math::SpaceFillingCurve::sort_keys(morton);
+    ASSUME_ITS_TRUE(std::is_sorted(morton.begin(), morton.end()));
+    ASSUME_ITS_TRUE(points[by_key[0]].x == 0.0 && points[by_key[0]].y == 0.0);
+
+    bool thrown = false;
+    try {
+        fossil::math::SpaceFillingCurve::gather(labels, std::vector<size_t>{100});
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    ASSUME_ITS_TRUE(thrown);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_spatial_tests) {
+    FOSSIL_TEST_ADD(cpp_spatial_fixture, cpp_math_test_kdtree);
+    FOSSIL_TEST_ADD(cpp_spatial_fixture, cpp_math_test_spatial_grid);
+    FOSSIL_TEST_ADD(cpp_spatial_fixture, cpp_math_test_triangle_bvh);
+    FOSSIL_TEST_ADD(cpp_spatial_fixture, cpp_math_test_space_filling_curve);
+
+    FOSSIL_TEST_REGISTER(cpp_spatial_fixture);
+} // end of tests
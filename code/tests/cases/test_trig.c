@@ -24,6 +24,11 @@
  */
 #include <fossil/pizza/framework.h>
 #include "fossil/math/framework.h"
+#include <float.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 
 
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -44,6 +49,105 @@ FOSSIL_TEARDOWN(c_trig_fixture) {
     // Teardown the test fixture
 }
 
+// Sampled accuracy harness: each tier is checked against a long double
+// reference, or against libm with one extra ULP of slack where long double
+// is no wider than double.
+#define TRIG_SAMPLES 20000
+
+#if LDBL_MANT_DIG > DBL_MANT_DIG
+#define TRIG_REF_SLACK 0.0
+#else
+#define TRIG_REF_SLACK 1.0
+#endif
+
+typedef void (*trig_array_fn)(const double*, double*, size_t, fossil_math_trig_accuracy);
+
+static double trig_ulp_error(double got, long double ref) {
+    if (isnan(got) && isnan((double)ref)) return 0.0;
+    int e;
+    frexpl(ref, &e);
+    long double ulp = ldexpl(1.0L, (e - DBL_MANT_DIG < -1074) ? -1074 : e - DBL_MANT_DIG);
+    return (double)(fabsl((long double)got - ref) / ulp);
+}
+
+// Fills x with samples spread uniformly over [lo, hi] plus log-spaced
+// magnitudes down to 1e-300 in the second half.
+static void trig_samples(double* x, size_t n, double lo, double hi) {
+    uint64_t state = 88172645463325252ULL;
+    for (size_t i = 0; i < n; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double u = (double)(state >> 11) / 9007199254740992.0;
+        if (i < n / 2) {
+            x[i] = lo + u * (hi - lo);
+        } else {
+            double m = exp(log(1e-300) + u * (log(hi) - log(1e-300)));
+            x[i] = (state & 1) ? -m : m;
+            if (x[i] < lo) x[i] = lo;
+        }
+    }
+}
+
+// Returns the largest error over the samples: ULP for the precise and
+// balanced tiers, absolute (relative when rel is set) for the fast tier.
+static double trig_max_error(trig_array_fn fn, long double (*ref)(long double), double lo, double hi,
+                             fossil_math_trig_accuracy accuracy, int rel) {
+    static double x[TRIG_SAMPLES], y[TRIG_SAMPLES];
+    trig_samples(x, TRIG_SAMPLES, lo, hi);
+    fn(x, y, TRIG_SAMPLES, accuracy);
+    double worst = 0.0;
+    for (size_t i = 0; i < TRIG_SAMPLES; i++) {
+        long double r = ref((long double)x[i]);
+        double err;
+        if (accuracy != FOSSIL_MATH_TRIG_FAST)
+            err = trig_ulp_error(y[i], r);
+        else if (rel)
+            err = (double)(fabsl((long double)y[i] - r) / fabsl(r));
+        else
+            err = (double)fabsl((long double)y[i] - r);
+        if (err > worst) worst = err;
+    }
+    return worst;
+}
+
+static void trig_sincos_sin(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    static double c[TRIG_SAMPLES];
+    fossil_math_trig_sincos_array_ex(in, out, c, n, accuracy);
+}
+
+static void trig_sincos_cos(const double* in, double* out, size_t n, fossil_math_trig_accuracy accuracy) {
+    static double s[TRIG_SAMPLES];
+    fossil_math_trig_sincos_array_ex(in, s, out, n, accuracy);
+}
+
+// Checks every function of one tier against its bound.
+static int trig_tier_within(fossil_math_trig_accuracy accuracy, double bound) {
+    int fast = (accuracy == FOSSIL_MATH_TRIG_FAST);
+    double slack = fast ? 0.0 : TRIG_REF_SLACK;
+    return trig_max_error(fossil_math_trig_sin_array_ex, sinl, -800000.0, 800000.0, accuracy, 0) <= bound + slack &&
+           trig_max_error(fossil_math_trig_cos_array_ex, cosl, -800000.0, 800000.0, accuracy, 0) <= bound + slack &&
+           trig_max_error(trig_sincos_sin, sinl, -100.0, 100.0, accuracy, 0) <= bound + slack &&
+           trig_max_error(trig_sincos_cos, cosl, -100.0, 100.0, accuracy, 0) <= bound + slack &&
+           trig_max_error(fossil_math_trig_tan_array_ex, tanl, -100.0, 100.0, accuracy, 1) <= bound + slack &&
+           trig_max_error(fossil_math_trig_asin_array_ex, asinl, -1.0, 1.0, accuracy, 0) <= bound + slack &&
+           trig_max_error(fossil_math_trig_acos_array_ex, acosl, -1.0, 1.0, accuracy, 0) <= bound + slack &&
+           trig_max_error(fossil_math_trig_atan_array_ex, atanl, -1.0e6, 1.0e6, accuracy, 0) <= bound + slack;
+}
+
+// Same check for the hyperbolic arrays; the fast tier is held to a
+// relative bound.
+static int trig_hyperbolic_within(fossil_math_trig_accuracy accuracy, double bound) {
+    int fast = (accuracy == FOSSIL_MATH_TRIG_FAST);
+    double slack = fast ? 0.0 : TRIG_REF_SLACK;
+    return trig_max_error(fossil_math_trig_sinh_array_ex, sinhl, -700.0, 700.0, accuracy, 1) <= bound + slack &&
+           trig_max_error(fossil_math_trig_cosh_array_ex, coshl, -700.0, 700.0, accuracy, 1) <= bound + slack &&
+           trig_max_error(fossil_math_trig_tanh_array_ex, tanhl, -30.0, 30.0, accuracy, 1) <= bound + slack &&
+           trig_max_error(fossil_math_trig_asinh_array_ex, asinhl, -1.0e300, 1.0e300, accuracy, 1) <= bound + slack &&
+           trig_max_error(fossil_math_trig_acosh_array_ex, acoshl, 1.0, 1.0e300, accuracy, 1) <= bound + slack &&
+           trig_max_error(fossil_math_trig_atanh_array_ex, atanhl, -1.0, 1.0, accuracy, 1) <= bound + slack;
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Cases
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -111,6 +215,342 @@ FOSSIL_TEST_CASE(c_math_test_inverse_hyperbolic) {
     ASSUME_ITS_EQUAL_F64(fossil_math_trig_atanh(x), 0.0, FOSSIL_TEST_FLOAT_EPSILON);
 }
 
+FOSSIL_TEST_CASE(c_math_test_trig_arrays) {
+    double x[37], s[37], c[37], t[37];
+    for (size_t i = 0; i < 37; i++)
+        x[i] = -20.0 + (double)i * 1.1;
+    x[36] = 1.0e7; // beyond the vector reduction range
+
+    fossil_math_trig_sin_array(x, s, 37);
+    fossil_math_trig_cos_array(x, c, 37);
+    fossil_math_trig_tan_array(x, t, 37);
+    for (size_t i = 0; i < 37; i++) {
+        ASSUME_ITS_EQUAL_F64(s[i], fossil_math_trig_sin(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(c[i], fossil_math_trig_cos(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(t[i], fossil_math_trig_tan(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+    }
+}
+
+FOSSIL_TEST_CASE(c_math_test_inverse_trig_arrays) {
+    double x[21], y[21];
+    for (size_t i = 0; i < 21; i++)
+        x[i] = y[i] = -1.0 + (double)i * 0.1;
+
+    fossil_math_trig_asin_array(y, y, 21); // in place
+    for (size_t i = 0; i < 21; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_asin(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+
+    fossil_math_trig_acos_array(x, y, 21);
+    for (size_t i = 0; i < 21; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_acos(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+
+    for (size_t i = 0; i < 21; i++)
+        x[i] *= 50.0;
+    fossil_math_trig_atan_array(x, y, 21);
+    for (size_t i = 0; i < 21; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_atan(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST_CASE(c_math_test_sincos) {
+    double s = 0.0, c = 0.0;
+    fossil_math_trig_sincos(FOSSIL_MATH_PI / 6.0, &s, &c);
+    ASSUME_ITS_EQUAL_F64(s, 0.5, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(c, fossil_math_trig_cos(FOSSIL_MATH_PI / 6.0), FOSSIL_TEST_FLOAT_EPSILON);
+
+    double x[13], sa[13], ca[13];
+    for (size_t i = 0; i < 13; i++)
+        x[i] = -50.0 + (double)i * 8.3;
+    fossil_math_trig_sincos_array(x, sa, ca, 13);
+    for (size_t i = 0; i < 13; i++) {
+        fossil_math_trig_sincos(x[i], &s, &c);
+        ASSUME_ITS_EQUAL_F64(sa[i], fossil_math_trig_sin(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(ca[i], fossil_math_trig_cos(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(s, sa[i], FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(c, ca[i], FOSSIL_TEST_FLOAT_EPSILON);
+    }
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_accuracy_default) {
+    ASSUME_ITS_TRUE(fossil_math_trig_get_accuracy() == FOSSIL_MATH_TRIG_PRECISE);
+    ASSUME_ITS_TRUE(fossil_math_trig_set_accuracy((fossil_math_trig_accuracy)7) == -1);
+    ASSUME_ITS_TRUE(fossil_math_trig_get_accuracy() == FOSSIL_MATH_TRIG_PRECISE);
+
+    ASSUME_ITS_TRUE(fossil_math_trig_set_accuracy(FOSSIL_MATH_TRIG_FAST) == 0);
+    ASSUME_ITS_TRUE(fossil_math_trig_get_accuracy() == FOSSIL_MATH_TRIG_FAST);
+    double x = 0.7, s = 0.0, c = 0.0, y = 0.0;
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_sin(x), fossil_math_trig_sin_ex(x, FOSSIL_MATH_TRIG_FAST), 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_atan(x), fossil_math_trig_atan_ex(x, FOSSIL_MATH_TRIG_FAST), 0.0);
+    fossil_math_trig_sin_array(&x, &y, 1);
+    ASSUME_ITS_EQUAL_F64(y, fossil_math_trig_sin_ex(x, FOSSIL_MATH_TRIG_FAST), 0.0);
+    fossil_math_trig_sincos(x, &s, &c);
+    ASSUME_ITS_EQUAL_F64(s, sin(x), 1e-7);
+    ASSUME_ITS_EQUAL_F64(c, cos(x), 1e-7);
+
+    ASSUME_ITS_TRUE(fossil_math_trig_set_accuracy(FOSSIL_MATH_TRIG_PRECISE) == 0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_sin(x), sin(x), 0.0);
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_accuracy_scalar) {
+    const fossil_math_trig_accuracy tiers[] = {FOSSIL_MATH_TRIG_PRECISE, FOSSIL_MATH_TRIG_BALANCED,
+                                               FOSSIL_MATH_TRIG_FAST};
+    for (size_t t = 0; t < 3; t++) {
+        double tol = (tiers[t] == FOSSIL_MATH_TRIG_FAST) ? 1e-7 : 1e-15;
+        for (double x = -7.0; x <= 7.0; x += 0.37) {
+            double s = 0.0, c = 0.0;
+            fossil_math_trig_sincos_ex(x, &s, &c, tiers[t]);
+            ASSUME_ITS_EQUAL_F64(fossil_math_trig_sin_ex(x, tiers[t]), sin(x), tol);
+            ASSUME_ITS_EQUAL_F64(fossil_math_trig_cos_ex(x, tiers[t]), cos(x), tol);
+            ASSUME_ITS_EQUAL_F64(s, sin(x), tol);
+            ASSUME_ITS_EQUAL_F64(c, cos(x), tol);
+            ASSUME_ITS_EQUAL_F64(fossil_math_trig_atan_ex(x, tiers[t]), atan(x), tol);
+            double v = x / 7.0;
+            ASSUME_ITS_EQUAL_F64(fossil_math_trig_asin_ex(v, tiers[t]), asin(v), tol);
+            ASSUME_ITS_EQUAL_F64(fossil_math_trig_acos_ex(v, tiers[t]), acos(v), tol);
+        }
+        // Signed zero, NaN and out-of-range inputs behave as in libm.
+        ASSUME_ITS_TRUE(signbit(fossil_math_trig_sin_ex(-0.0, tiers[t])));
+        ASSUME_ITS_TRUE(signbit(fossil_math_trig_tan_ex(-0.0, tiers[t])));
+        ASSUME_ITS_TRUE(isnan(fossil_math_trig_sin_ex(NAN, tiers[t])));
+        ASSUME_ITS_TRUE(isnan(fossil_math_trig_cos_ex(INFINITY, tiers[t])));
+        ASSUME_ITS_TRUE(isnan(fossil_math_trig_asin_ex(1.5, tiers[t])));
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_sin_ex(1.0e9, tiers[t]), sin(1.0e9), 0.0);
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_atan_ex(INFINITY, tiers[t]), FOSSIL_MATH_PI / 2.0, 1e-15);
+    }
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_accuracy_precise_bound) {
+    ASSUME_ITS_TRUE(trig_tier_within(FOSSIL_MATH_TRIG_PRECISE, 1.0));
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_accuracy_balanced_bound) {
+    ASSUME_ITS_TRUE(trig_tier_within(FOSSIL_MATH_TRIG_BALANCED, 4.0));
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_accuracy_fast_bound) {
+    ASSUME_ITS_TRUE(trig_tier_within(FOSSIL_MATH_TRIG_FAST, 1.0e-7));
+}
+
+FOSSIL_TEST_CASE(c_math_test_degree_trig) {
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_sind(30.0), 0.5, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_cosd(60.0), 0.5, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_sind(90.0), 1.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_cosd(180.0), -1.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_tand(45.0), 1.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_tand(-135.0), 1.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_sind(1.0e20), sin(fmod(1.0e20, 360.0) * (FOSSIL_MATH_PI / 180.0)), 1e-12);
+
+    // Exact zeros at the cardinal angles, even for large multiples.
+    ASSUME_ITS_TRUE(fossil_math_trig_sind(180.0) == 0.0 && !signbit(fossil_math_trig_sind(180.0)));
+    ASSUME_ITS_TRUE(fossil_math_trig_sind(-360.0) == 0.0 && signbit(fossil_math_trig_sind(-360.0)));
+    ASSUME_ITS_TRUE(fossil_math_trig_cosd(90.0) == 0.0 && !signbit(fossil_math_trig_cosd(90.0)));
+    ASSUME_ITS_TRUE(fossil_math_trig_cosd(3600000000090.0) == 0.0);
+    ASSUME_ITS_TRUE(fossil_math_trig_tand(90.0) == INFINITY);
+    ASSUME_ITS_TRUE(fossil_math_trig_tand(270.0) == -INFINITY);
+    ASSUME_ITS_TRUE(isnan(fossil_math_trig_sind(INFINITY)));
+    ASSUME_ITS_TRUE(isnan(fossil_math_trig_tand(NAN)));
+
+    for (double d = -725.0; d <= 725.0; d += 7.3) {
+        double r = d * (FOSSIL_MATH_PI / 180.0);
+        double s = 0.0, c = 0.0;
+        fossil_math_trig_sincosd(d, &s, &c);
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_sind(d), sin(r), 1e-13);
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_cosd(d), cos(r), 1e-13);
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_tand(d), tan(r), 1e-12 * fmax(1.0, fabs(tan(r))));
+        ASSUME_ITS_EQUAL_F64(s, fossil_math_trig_sind(d), 0.0);
+        ASSUME_ITS_EQUAL_F64(c, fossil_math_trig_cosd(d), 0.0);
+    }
+}
+
+FOSSIL_TEST_CASE(c_math_test_degree_conversion_arrays) {
+    double d[11], r[11], back[11];
+    for (size_t i = 0; i < 11; i++)
+        d[i] = -250.0 + (double)i * 47.5;
+    fossil_math_trig_deg_to_rad_array(d, r, 11);
+    fossil_math_trig_rad_to_deg_array(r, back, 11);
+    for (size_t i = 0; i < 11; i++) {
+        ASSUME_ITS_EQUAL_F64(r[i], fossil_math_trig_deg_to_rad(d[i]), 0.0);
+        ASSUME_ITS_EQUAL_F64(back[i], fossil_math_trig_rad_to_deg(r[i]), 0.0);
+    }
+    fossil_math_trig_deg_to_rad_array(d, d, 11); // in place
+    for (size_t i = 0; i < 11; i++)
+        ASSUME_ITS_EQUAL_F64(d[i], r[i], 0.0);
+}
+
+FOSSIL_TEST_CASE(c_math_test_hyperbolic_arrays) {
+    double x[29], y[29];
+    for (size_t i = 0; i < 29; i++)
+        x[i] = y[i] = -7.0 + (double)i * 0.5;
+
+    fossil_math_trig_sinh_array(y, y, 29); // in place
+    for (size_t i = 0; i < 29; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_sinh(x[i]), 1e-15 * fossil_math_trig_cosh(x[i]));
+
+    fossil_math_trig_cosh_array(x, y, 29);
+    for (size_t i = 0; i < 29; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_cosh(x[i]), 1e-15 * y[i]);
+
+    fossil_math_trig_tanh_array(x, y, 29);
+    for (size_t i = 0; i < 29; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_tanh(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+
+    fossil_math_trig_asinh_array(x, y, 29);
+    for (size_t i = 0; i < 29; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_asinh(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+
+    for (size_t i = 0; i < 29; i++)
+        x[i] = 1.0 + (double)i * (double)i;
+    fossil_math_trig_acosh_array(x, y, 29);
+    for (size_t i = 0; i < 29; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_acosh(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+
+    for (size_t i = 0; i < 29; i++)
+        x[i] = -0.98 + (double)i * 0.07;
+    fossil_math_trig_atanh_array(x, y, 29);
+    for (size_t i = 0; i < 29; i++)
+        ASSUME_ITS_EQUAL_F64(y[i], fossil_math_trig_atanh(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST_CASE(c_math_test_hyperbolic_special_values) {
+    double x[5] = {0.0, INFINITY, -INFINITY, NAN, 800.0};
+    double y[5];
+    fossil_math_trig_sinh_array(x, y, 5);
+    ASSUME_ITS_TRUE(y[0] == 0.0 && y[1] == INFINITY && y[2] == -INFINITY && isnan(y[3]) && y[4] == INFINITY);
+    fossil_math_trig_cosh_array(x, y, 5);
+    ASSUME_ITS_TRUE(y[0] == 1.0 && y[1] == INFINITY && y[2] == INFINITY && isnan(y[3]) && y[4] == INFINITY);
+    fossil_math_trig_tanh_array(x, y, 5);
+    ASSUME_ITS_TRUE(y[0] == 0.0 && y[1] == 1.0 && y[2] == -1.0 && isnan(y[3]) && y[4] == 1.0);
+
+    double z[4] = {1.0, -1.0, 2.0, 0.5};
+    fossil_math_trig_atanh_array(z, y, 4);
+    ASSUME_ITS_TRUE(y[0] == INFINITY && y[1] == -INFINITY && isnan(y[2]));
+    fossil_math_trig_acosh_array(z, y, 4);
+    ASSUME_ITS_TRUE(y[0] == 0.0 && isnan(y[1]) && isnan(y[3]));
+}
+
+FOSSIL_TEST_CASE(c_math_test_hyperbolic_accuracy) {
+    ASSUME_ITS_TRUE(trig_hyperbolic_within(FOSSIL_MATH_TRIG_PRECISE, 3.0));
+    ASSUME_ITS_TRUE(trig_hyperbolic_within(FOSSIL_MATH_TRIG_BALANCED, 3.0));
+    ASSUME_ITS_TRUE(trig_hyperbolic_within(FOSSIL_MATH_TRIG_FAST, 1.0e-7));
+}
+
+FOSSIL_TEST_CASE(c_math_test_tanh_deriv_array) {
+    double x[41], y[41], dy[41];
+    for (size_t i = 0; i < 41; i++)
+        x[i] = -20.0 + (double)i;
+
+    for (int tier = FOSSIL_MATH_TRIG_PRECISE; tier <= FOSSIL_MATH_TRIG_FAST; tier++) {
+        double tol = (tier == FOSSIL_MATH_TRIG_FAST) ? 1e-7 : 1e-15;
+        fossil_math_trig_tanh_deriv_array_ex(x, y, dy, 41, (fossil_math_trig_accuracy)tier);
+        for (size_t i = 0; i < 41; i++) {
+            // 1 / cosh^2 keeps full relative accuracy where tanh saturates.
+            double c = cosh(x[i]);
+            double d = 1.0 / (c * c);
+            ASSUME_ITS_EQUAL_F64(y[i], tanh(x[i]), tol);
+            ASSUME_ITS_EQUAL_F64(dy[i], d, tol * d);
+        }
+    }
+
+    // The value may overwrite the input.
+    double t[3] = {-0.5, 0.0, 3.0};
+    fossil_math_trig_tanh_deriv_array(t, t, dy, 3);
+    ASSUME_ITS_EQUAL_F64(t[0], tanh(-0.5), FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(dy[1], 1.0, FOSSIL_TEST_FLOAT_EPSILON);
+    ASSUME_ITS_EQUAL_F64(t[2], tanh(3.0), FOSSIL_TEST_FLOAT_EPSILON);
+}
+
+FOSSIL_TEST_CASE(c_math_test_hyperbolic_threads) {
+    size_t n = 200003;
+    double* x = (double*)malloc(n * sizeof(double));
+    double* serial = (double*)malloc(n * sizeof(double));
+    double* threaded = (double*)malloc(n * sizeof(double));
+    double* dy = (double*)malloc(n * sizeof(double));
+    for (size_t i = 0; i < n; i++)
+        x[i] = -10.0 + 20.0 * (double)i / (double)n;
+
+    ASSUME_ITS_TRUE(fossil_math_get_threads() == 1);
+    fossil_math_trig_tanh_array(x, serial, n);
+
+    ASSUME_ITS_TRUE(fossil_math_set_threads(4) == 0);
+    ASSUME_ITS_TRUE(fossil_math_get_threads() == 4);
+    fossil_math_trig_tanh_array(x, threaded, n);
+    int same = memcmp(serial, threaded, n * sizeof(double)) == 0;
+    fossil_math_trig_tanh_deriv_array(x, threaded, dy, n);
+    same = same && memcmp(serial, threaded, n * sizeof(double)) == 0;
+    ASSUME_ITS_TRUE(fossil_math_set_threads(0) == 0);
+    ASSUME_ITS_TRUE(fossil_math_get_threads() >= 1);
+    fossil_math_set_threads(1);
+    ASSUME_ITS_TRUE(same);
+
+    free(x);
+    free(serial);
+    free(threaded);
+    free(dy);
+}
+
+FOSSIL_TEST_CASE(c_math_test_atan2_array) {
+    // Every combination of signed zeros, finite values, infinities and NaN.
+    double v[8] = {0.0, -0.0, 1.5, -2.0, 1e-310, INFINITY, -INFINITY, NAN};
+    double y[64], x[64], out[64];
+    for (size_t i = 0; i < 64; i++) {
+        y[i] = v[i / 8];
+        x[i] = v[i % 8];
+    }
+    fossil_math_trig_atan2_array(y, x, out, 64);
+    for (size_t i = 0; i < 64; i++) {
+        double r = atan2(y[i], x[i]);
+        ASSUME_ITS_TRUE(isnan(r) ? isnan(out[i]) : (signbit(r) == signbit(out[i]) && fabs(out[i] - r) <= 4e-16 * fabs(r)));
+    }
+
+    static double ys[TRIG_SAMPLES], xs[TRIG_SAMPLES], a[TRIG_SAMPLES];
+    trig_samples(ys, TRIG_SAMPLES, -50.0, 50.0);
+    trig_samples(xs, TRIG_SAMPLES, -30.0, 30.0);
+    for (size_t i = 0; i < TRIG_SAMPLES; i++)
+        xs[i] = xs[TRIG_SAMPLES - 1 - i] - 0.5 * xs[i]; // decorrelate from ys
+    double worst = 0.0;
+    fossil_math_trig_atan2_array(ys, xs, a, TRIG_SAMPLES);
+    for (size_t i = 0; i < TRIG_SAMPLES; i++) {
+        double e = trig_ulp_error(a[i], atan2l(ys[i], xs[i]));
+        if (e > worst) worst = e;
+    }
+    ASSUME_ITS_TRUE(worst <= 2.0 + TRIG_REF_SLACK);
+
+    fossil_math_trig_atan2_array_ex(ys, xs, a, TRIG_SAMPLES, FOSSIL_MATH_TRIG_FAST);
+    worst = 0.0;
+    for (size_t i = 0; i < TRIG_SAMPLES; i++) {
+        double e = fabs(a[i] - atan2(ys[i], xs[i]));
+        if (e > worst) worst = e;
+    }
+    ASSUME_ITS_TRUE(worst <= 1e-7);
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_subnormal_edges) {
+    double denorm = 4.9406564584124654e-324;
+    double y[4] = {0.0, -0.0, denorm, -denorm};
+    double x[4] = {denorm, -denorm, 0.0, -0.0};
+    double out[4];
+    fossil_math_trig_atan2_array(y, x, out, 4);
+    for (int i = 0; i < 4; i++) {
+        ASSUME_ITS_TRUE(out[i] == atan2(y[i], x[i]));
+        ASSUME_ITS_TRUE(signbit(out[i]) == signbit(atan2(y[i], x[i])));
+    }
+
+    ASSUME_ITS_TRUE(signbit(fossil_math_trig_tand(-denorm)));
+
+    // The derivative keeps its relative accuracy as it goes subnormal.
+    double in[3] = {355.0, -360.0, 380.0};
+    double t[3], dy[3];
+    for (int tier = 0; tier < 3; tier++) {
+        fossil_math_trig_tanh_deriv_array_ex(in, t, dy, 3, (fossil_math_trig_accuracy)tier);
+        for (int i = 0; i < 2; i++) {
+            double e = 2.0 * exp(-fabs(in[i]));
+            double ref = e * e;
+            ASSUME_ITS_EQUAL_F64(dy[i] / ref, 1.0, 1e-7);
+            ASSUME_ITS_TRUE(t[i] == (in[i] < 0 ? -1.0 : 1.0));
+        }
+        ASSUME_ITS_TRUE(dy[2] == 0.0);
+    }
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -121,6 +561,23 @@ FOSSIL_TEST_GROUP(c_trig_tests) {
     FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_inverse_trig);
     FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_hyperbolic);
     FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_inverse_hyperbolic);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_trig_arrays);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_inverse_trig_arrays);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_sincos);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_trig_accuracy_default);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_trig_accuracy_scalar);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_trig_accuracy_precise_bound);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_trig_accuracy_balanced_bound);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_trig_accuracy_fast_bound);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_degree_trig);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_degree_conversion_arrays);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_hyperbolic_arrays);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_hyperbolic_special_values);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_hyperbolic_accuracy);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_tanh_deriv_array);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_hyperbolic_threads);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_atan2_array);
+    FOSSIL_TEST_ADD(c_trig_fixture, c_math_test_trig_subnormal_edges);
 
     FOSSIL_TEST_REGISTER(c_trig_fixture);
 } // end of tests
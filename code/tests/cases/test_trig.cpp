@@ -24,6 +24,7 @@
  */
 #include <fossil/pizza/framework.h>
 #include "fossil/math/framework.h"
+#include <cmath>
 
 
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -111,6 +112,140 @@ FOSSIL_TEST_CASE(cpp_math_test_inverse_hyperbolic) {
     ASSUME_ITS_EQUAL_F64(fossil::math::Trigonometry::atanh(x), 0.0, FOSSIL_TEST_FLOAT_EPSILON);
 }
 
+FOSSIL_TEST_CASE(cpp_math_test_trig_arrays) {
+    std::vector<double> x;
+    for (int i = 0; i < 19; i++)
+        x.push_back(-3.0 + i / 3.0);
+
+    std::vector<double> s = fossil::math::Trigonometry::sin(x);
+    std::vector<double> c = fossil::math::Trigonometry::cos(x);
+    std::vector<double> a = fossil::math::Trigonometry::atan(x);
+    ASSUME_ITS_TRUE(s.size() == x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        ASSUME_ITS_EQUAL_F64(s[i], fossil::math::Trigonometry::sin(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(c[i], fossil::math::Trigonometry::cos(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(a[i], fossil::math::Trigonometry::atan(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+    }
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_sincos) {
+    double s = 0.0, c = 0.0;
+    fossil::math::Trigonometry::sincos(FOSSIL_MATH_PI / 3.0, s, c);
+    ASSUME_ITS_EQUAL_F64(c, 0.5, FOSSIL_TEST_FLOAT_EPSILON);
+
+    std::vector<double> x = {-2.0, -1.0, 0.0, 1.0, 2.0};
+    std::vector<double> sv, cv;
+    fossil::math::Trigonometry::sincos(x, sv, cv);
+    ASSUME_ITS_TRUE(sv.size() == x.size() && cv.size() == x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        ASSUME_ITS_EQUAL_F64(sv[i], fossil::math::Trigonometry::sin(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(cv[i], fossil::math::Trigonometry::cos(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+    }
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_trig_accuracy) {
+    using fossil::math::Trigonometry;
+    ASSUME_ITS_TRUE(Trigonometry::accuracy() == FOSSIL_MATH_TRIG_PRECISE);
+
+    bool thrown = false;
+    try {
+        Trigonometry::set_accuracy(static_cast<fossil_math_trig_accuracy>(7));
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    ASSUME_ITS_TRUE(thrown);
+
+    std::vector<double> x = {-3.0, -0.5, 0.0, 0.25, 2.0, 10.0};
+    std::vector<double> fast = Trigonometry::sin(x, FOSSIL_MATH_TRIG_FAST);
+    std::vector<double> balanced = Trigonometry::atan(x, FOSSIL_MATH_TRIG_BALANCED);
+    for (size_t i = 0; i < x.size(); i++) {
+        ASSUME_ITS_EQUAL_F64(fast[i], Trigonometry::sin(x[i], FOSSIL_MATH_TRIG_FAST), 0.0);
+        ASSUME_ITS_EQUAL_F64(fast[i], std::sin(x[i]), 1e-7);
+        ASSUME_ITS_EQUAL_F64(balanced[i], std::atan(x[i]), 1e-15);
+    }
+
+    Trigonometry::set_accuracy(FOSSIL_MATH_TRIG_BALANCED);
+    ASSUME_ITS_EQUAL_F64(Trigonometry::tan(0.5), Trigonometry::tan(0.5, FOSSIL_MATH_TRIG_BALANCED), 0.0);
+    Trigonometry::set_accuracy(FOSSIL_MATH_TRIG_PRECISE);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_degree_trig) {
+    using fossil::math::Trigonometry;
+    ASSUME_ITS_EQUAL_F64(Trigonometry::sind(150.0), 0.5, 0.0);
+    ASSUME_ITS_EQUAL_F64(Trigonometry::cosd(240.0), -0.5, 0.0);
+    ASSUME_ITS_EQUAL_F64(Trigonometry::tand(225.0), 1.0, 0.0);
+    double s = 1.0, c = 1.0;
+    Trigonometry::sincosd(270.0, s, c);
+    ASSUME_ITS_EQUAL_F64(s, -1.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(c, 0.0, 0.0);
+
+    std::vector<double> r = Trigonometry::deg_to_rad(std::vector<double>{0.0, 90.0, 180.0});
+    ASSUME_ITS_EQUAL_F64(r[2], FOSSIL_MATH_PI, 1e-15);
+    std::vector<double> d = Trigonometry::rad_to_deg(r);
+    ASSUME_ITS_EQUAL_F64(d[1], 90.0, 1e-12);
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_hyperbolic_arrays) {
+    using fossil::math::Trigonometry;
+    std::vector<double> x = {-4.0, -1.5, -0.1, 0.0, 0.3, 2.0, 25.0};
+    std::vector<double> s = Trigonometry::sinh(x);
+    std::vector<double> t = Trigonometry::tanh(x, FOSSIL_MATH_TRIG_FAST);
+    std::vector<double> a = Trigonometry::asinh(x);
+    std::vector<double> y, dy;
+    Trigonometry::tanh_deriv(x, y, dy);
+    ASSUME_ITS_TRUE(y.size() == x.size() && dy.size() == x.size());
+    for (size_t i = 0; i < x.size(); i++) {
+        ASSUME_ITS_EQUAL_F64(s[i], std::sinh(x[i]), 1e-15 * std::cosh(x[i]));
+        ASSUME_ITS_EQUAL_F64(t[i], std::tanh(x[i]), 1e-7);
+        ASSUME_ITS_EQUAL_F64(a[i], std::asinh(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        ASSUME_ITS_EQUAL_F64(y[i], std::tanh(x[i]), FOSSIL_TEST_FLOAT_EPSILON);
+        double c = std::cosh(x[i]);
+        ASSUME_ITS_EQUAL_F64(dy[i], 1.0 / (c * c), 1e-15 / (c * c));
+    }
+}
+
+struct trig_sine_table {
+    double v[16];
+};
+
+static constexpr trig_sine_table trig_make_sine_table() {
+    trig_sine_table t{};
+    for (int i = 0; i < 16; i++)
+        t.v[i] = fossil::math::Trigonometry::sin(fossil::math::Trigonometry::deg_to_rad(22.5 * i));
+    return t;
+}
+
+FOSSIL_TEST_CASE(cpp_math_test_constexpr_trig) {
+    using fossil::math::Trigonometry;
+    static_assert(Trigonometry::deg_to_rad(180.0) == FOSSIL_MATH_PI);
+    static_assert(Trigonometry::rad_to_deg(FOSSIL_MATH_PI) == 180.0);
+    static_assert(Trigonometry::sin(0.0) == 0.0);
+    static_assert(Trigonometry::cos(0.0) == 1.0);
+    static_assert(Trigonometry::sind(30.0) == 0.5);
+    static_assert(Trigonometry::cosd(90.0) == 0.0);
+    static_assert(Trigonometry::tand(45.0) == 1.0);
+    static_assert(Trigonometry::acos(-1.0) == FOSSIL_MATH_PI);
+    static_assert(Trigonometry::atan2(1.0, -1.0) == 0.75 * FOSSIL_MATH_PI);
+
+    constexpr trig_sine_table table = trig_make_sine_table();
+    for (int i = 0; i < 16; i++)
+        ASSUME_ITS_EQUAL_F64(table.v[i], std::sin(Trigonometry::deg_to_rad(22.5 * i)), 1e-15);
+
+    // Compile-time values agree with the runtime C functions.
+    constexpr double cs[] = {Trigonometry::sin(2.5), Trigonometry::cos(-40.0), Trigonometry::tan(1.2),
+                             Trigonometry::asin(0.7), Trigonometry::acos(-0.3), Trigonometry::atan(3.0),
+                             Trigonometry::atan2(-2.0, -5.0), Trigonometry::sind(123.0), Trigonometry::cosd(-75.0)};
+    const double rt[] = {Trigonometry::sin(2.5), Trigonometry::cos(-40.0), Trigonometry::tan(1.2),
+                         Trigonometry::asin(0.7), Trigonometry::acos(-0.3), Trigonometry::atan(3.0),
+                         Trigonometry::atan2(-2.0, -5.0), Trigonometry::sind(123.0), Trigonometry::cosd(-75.0)};
+    for (int i = 0; i < 9; i++)
+        ASSUME_ITS_EQUAL_F64(cs[i], rt[i], 1e-15);
+
+    double x = 33.0;
+    ASSUME_ITS_TRUE(Trigonometry::deg_to_rad(x) == fossil_math_trig_deg_to_rad(x));
+    ASSUME_ITS_TRUE(Trigonometry::rad_to_deg(x) == fossil_math_trig_rad_to_deg(x));
+}
+
 // * * * * * * * * * * * * * * * * * * * * * * * *
 // * Fossil Logic Test Pool
 // * * * * * * * * * * * * * * * * * * * * * * * *
@@ -121,6 +256,12 @@ FOSSIL_TEST_GROUP(cpp_trig_tests) {
     FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_inverse_trig);
     FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_hyperbolic);
     FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_inverse_hyperbolic);
+    FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_trig_arrays);
+    FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_sincos);
+    FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_trig_accuracy);
+    FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_degree_trig);
+    FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_hyperbolic_arrays);
+    FOSSIL_TEST_ADD(cpp_trig_fixture, cpp_math_test_constexpr_trig);
 
     FOSSIL_TEST_REGISTER(cpp_trig_fixture);
 } // end of tests
@@ -0,0 +1,145 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+#include "fossil/math/framework.h"
+#include <math.h>
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_SUITE(c_trig_lut_fixture);
+
+FOSSIL_SETUP(c_trig_lut_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(c_trig_lut_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_CASE(c_math_test_trig_lut_create) {
+    ASSUME_ITS_TRUE(fossil_math_trig_lut_create(100, FOSSIL_MATH_TRIG_LUT_LINEAR) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_trig_lut_create(2, FOSSIL_MATH_TRIG_LUT_LINEAR) == NULL);
+    ASSUME_ITS_TRUE(fossil_math_trig_lut_create(256, (fossil_math_trig_lut_interp)2) == NULL);
+
+    fossil_math_trig_lut* lut = fossil_math_trig_lut_create(256, FOSSIL_MATH_TRIG_LUT_CUBIC);
+    ASSUME_ITS_TRUE(lut != NULL);
+    ASSUME_ITS_TRUE(fossil_math_trig_lut_size(lut) == 256);
+    ASSUME_ITS_TRUE(fossil_math_trig_lut_get_interp(lut) == FOSSIL_MATH_TRIG_LUT_CUBIC);
+    ASSUME_ITS_TRUE(fossil_math_trig_lut_bytes(lut) == (256 + 64 + 1) * sizeof(double));
+    fossil_math_trig_lut_destroy(lut);
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_lut_error_report) {
+    // The reported error bounds the error seen anywhere within one period
+    // and follows the h^2 / h^4 behaviour of the interpolation order.
+    fossil_math_trig_lut* lin = fossil_math_trig_lut_create(1024, FOSSIL_MATH_TRIG_LUT_LINEAR);
+    fossil_math_trig_lut* cub = fossil_math_trig_lut_create(1024, FOSSIL_MATH_TRIG_LUT_CUBIC);
+    ASSUME_ITS_TRUE(lin != NULL && cub != NULL);
+    double elin = fossil_math_trig_lut_max_error(lin);
+    double ecub = fossil_math_trig_lut_max_error(cub);
+    ASSUME_ITS_TRUE(elin > 1e-6 && elin < 1e-5);
+    ASSUME_ITS_TRUE(ecub > 0.0 && ecub < 1e-11);
+
+    for (int i = 0; i <= 1000; i++) {
+        double x = -3.2 + 6.4 * i / 1000.0;
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_sin(lin, x), sin(x), 1.01 * elin);
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_cos(lin, x), cos(x), 1.01 * elin);
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_sin(cub, x), sin(x), 1.01 * ecub);
+        ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_cos(cub, x), cos(x), 1.01 * ecub);
+    }
+    fossil_math_trig_lut_destroy(lin);
+    fossil_math_trig_lut_destroy(cub);
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_lut_cardinal) {
+    fossil_math_trig_lut* lut = fossil_math_trig_lut_create(64, FOSSIL_MATH_TRIG_LUT_CUBIC);
+    ASSUME_ITS_TRUE(lut != NULL);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_sin(lut, 0.0), 0.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_cos(lut, 0.0), 1.0, 0.0);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_sin(lut, FOSSIL_MATH_PI / 2.0), 1.0, 1e-15);
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_cos(lut, FOSSIL_MATH_PI), -1.0, 1e-15);
+    // Out-of-reach inputs fall back to libm.
+    ASSUME_ITS_EQUAL_F64(fossil_math_trig_lut_sin(lut, 1.0e300), sin(1.0e300), 0.0);
+    ASSUME_ITS_TRUE(isnan(fossil_math_trig_lut_sin(lut, NAN)));
+    fossil_math_trig_lut_destroy(lut);
+}
+
+FOSSIL_TEST_CASE(c_math_test_trig_lut_arrays) {
+    const fossil_math_trig_lut_interp orders[] = {FOSSIL_MATH_TRIG_LUT_LINEAR, FOSSIL_MATH_TRIG_LUT_CUBIC};
+    for (size_t o = 0; o < 2; o++) {
+        fossil_math_trig_lut* lut = fossil_math_trig_lut_create(512, orders[o]);
+        ASSUME_ITS_TRUE(lut != NULL);
+        double x[23], s[23], c[23], y[23];
+        for (size_t i = 0; i < 23; i++)
+            x[i] = -40.0 + (double)i * 3.7;
+        x[5] = 1.0e300; // scalar fallback inside a block
+
+        fossil_math_trig_lut_sincos_array(lut, x, s, c, 23);
+        for (size_t i = 0; i < 23; i++) {
+            double sv, cv;
+            fossil_math_trig_lut_sincos(lut, x[i], &sv, &cv);
+            ASSUME_ITS_EQUAL_F64(s[i], sv, 1e-15);
+            ASSUME_ITS_EQUAL_F64(c[i], cv, 1e-15);
+            ASSUME_ITS_EQUAL_F64(s[i], fossil_math_trig_lut_sin(lut, x[i]), 1e-15);
+            ASSUME_ITS_EQUAL_F64(c[i], fossil_math_trig_lut_cos(lut, x[i]), 1e-15);
+        }
+
+        for (size_t i = 0; i < 23; i++)
+            y[i] = x[i];
+        fossil_math_trig_lut_cos_array(lut, y, y, 23); // in place
+        for (size_t i = 0; i < 23; i++)
+            ASSUME_ITS_EQUAL_F64(y[i], c[i], 1e-15);
+        fossil_math_trig_lut_sin_array(lut, x, y, 23);
+        for (size_t i = 0; i < 23; i++)
+            ASSUME_ITS_EQUAL_F64(y[i], s[i], 1e-15);
+        fossil_math_trig_lut_destroy(lut);
+    }
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(c_trig_lut_tests) {
+    FOSSIL_TEST_ADD(c_trig_lut_fixture, c_math_test_trig_lut_create);
+    FOSSIL_TEST_ADD(c_trig_lut_fixture, c_math_test_trig_lut_error_report);
+    FOSSIL_TEST_ADD(c_trig_lut_fixture, c_math_test_trig_lut_cardinal);
+    FOSSIL_TEST_ADD(c_trig_lut_fixture, c_math_test_trig_lut_arrays);
+
+    FOSSIL_TEST_REGISTER(c_trig_lut_fixture);
+} // end of tests
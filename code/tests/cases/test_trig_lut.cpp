@@ -0,0 +1,85 @@
+/**
+ * -----------------------------------------------------------------------------
+ * Project: Fossil Logic
+ *
+ * This file is part of the Fossil Logic project, which aims to develop
+ * high-performance, cross-platform applications and libraries. The code
+ * contained herein is licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License. You may obtain
+ * a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations
+ * under the License.
+ *
+ * Author: Michael Gene Brockus (Dreamer)
+ * Date: 04/05/2014
+ *
+ * Copyright (C) 2014-2025 Fossil Logic. All rights reserved.
+ * -----------------------------------------------------------------------------
+ */
+#include <fossil/pizza/framework.h>
+#include "fossil/math/framework.h"
+#include <cmath>
+
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Utilities
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// Setup steps for things like test fixtures and
+// mock objects are set here.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_SUITE(cpp_trig_lut_fixture);
+
+FOSSIL_SETUP(cpp_trig_lut_fixture) {
+    // Setup the test fixture
+}
+
+FOSSIL_TEARDOWN(cpp_trig_lut_fixture) {
+    // Teardown the test fixture
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Cases
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// The test cases below are provided as samples, inspired
+// by the Meson build system's approach of using test cases
+// as samples for library usage.
+// * * * * * * * * * * * * * * * * * * * * * * * *
+
+FOSSIL_TEST_CASE(cpp_math_test_trig_table) {
+    fossil::math::TrigTable table(1024);
+    ASSUME_ITS_TRUE(table.size() == 1024);
+    ASSUME_ITS_TRUE(table.max_error() < 1e-11);
+    ASSUME_ITS_EQUAL_F64(table.sin(0.3), std::sin(0.3), 1e-11);
+
+    std::vector<double> x = {-2.0, -1.0, 0.0, 1.0, 2.0};
+    std::vector<double> c = table.cos(x);
+    for (size_t i = 0; i < x.size(); i++)
+        ASSUME_ITS_EQUAL_F64(c[i], std::cos(x[i]), 1e-11);
+
+    fossil::math::TrigTable moved = std::move(table);
+    ASSUME_ITS_TRUE(moved.handle() != nullptr && table.handle() == nullptr);
+
+    bool thrown = false;
+    try {
+        fossil::math::TrigTable bad(1000);
+    } catch (const std::invalid_argument&) {
+        thrown = true;
+    }
+    ASSUME_ITS_TRUE(thrown);
+}
+
+// * * * * * * * * * * * * * * * * * * * * * * * *
+// * Fossil Logic Test Pool
+// * * * * * * * * * * * * * * * * * * * * * * * *
+FOSSIL_TEST_GROUP(cpp_trig_lut_tests) {
+    FOSSIL_TEST_ADD(cpp_trig_lut_fixture, cpp_math_test_trig_table);
+
+    FOSSIL_TEST_REGISTER(cpp_trig_lut_fixture);
+} // end of tests